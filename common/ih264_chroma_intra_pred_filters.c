@@ -476,3 +476,300 @@ void ih264_intra_pred_chroma_8x8_mode_plane(UWORD8 *pu1_src,
     }
 }
 
+
+/**
+*******************************************************************************
+*
+* ih264_intra_pred_chroma_8x16_mode_dc
+*
+* @brief
+*  Perform Intra prediction for  chroma_8x16 (4:2:2) mode:DC
+*
+* @par Description:
+*  Perform Intra prediction for  chroma_8x16 mode:DC ,described in sec 8.3.4.1
+*  to 8.3.4.3. Each of the eight 4x4 blocks picks its predictors as per its
+*  position in the block
+*
+* @param[in] pu1_src
+*  UWORD8 pointer to the source containing alternate U and V samples, 16 left
+*  pels (bottom first), top left and 8 top pels
+*
+* @param[out] pu1_dst
+*  UWORD8 pointer to the destination with alternate U and V samples
+*
+* @param[in] src_strd
+*  integer source stride
+*
+* @param[in] dst_strd
+*  integer destination stride
+*
+* @param[in] ngbr_avail
+*  availability of neighbouring pixels
+*
+* @returns
+*
+* @remarks
+*  None
+*
+******************************************************************************
+*/
+void ih264_intra_pred_chroma_8x16_mode_dc(UWORD8 *pu1_src,
+                                          UWORD8 *pu1_dst,
+                                          WORD32 src_strd,
+                                          WORD32 dst_strd,
+                                          WORD32 ngbr_avail)
+{
+    WORD32 left_avail, top_avail;
+    UWORD8 *pu1_left = pu1_src + 2 * MB_SIZE - 2;
+    UWORD8 *pu1_top = pu1_src + 2 * MB_SIZE + 2;
+    WORD32 ai4_top[2][2], ai4_left[4][2]; /* 4 pel sums, [blk][u/v] */
+    WORD32 blk_x, blk_y, row, col, i;
+    UNUSED(src_strd);
+
+    left_avail = ngbr_avail & 1;
+    top_avail = (ngbr_avail >> 2) & 1;
+
+    for(blk_x = 0; blk_x < 2; blk_x++)
+    {
+        ai4_top[blk_x][0] = ai4_top[blk_x][1] = 0;
+        for(i = 0; i < 4; i++)
+        {
+            ai4_top[blk_x][0] += pu1_top[8 * blk_x + 2 * i];
+            ai4_top[blk_x][1] += pu1_top[8 * blk_x + 2 * i + 1];
+        }
+    }
+    for(blk_y = 0; blk_y < 4; blk_y++)
+    {
+        ai4_left[blk_y][0] = ai4_left[blk_y][1] = 0;
+        for(i = 0; i < 4; i++)
+        {
+            ai4_left[blk_y][0] += pu1_left[-2 * (4 * blk_y + i)];
+            ai4_left[blk_y][1] += pu1_left[-2 * (4 * blk_y + i) + 1];
+        }
+    }
+
+    for(blk_y = 0; blk_y < 4; blk_y++)
+    {
+        for(blk_x = 0; blk_x < 2; blk_x++)
+        {
+            UWORD8 *pu1_blk = pu1_dst + blk_y * 4 * dst_strd + blk_x * 8;
+            WORD32 use_top = top_avail, use_left = left_avail;
+            WORD32 ai4_val[2];
+
+            /* Blocks on the edges prefer their own edge (8.3.4.3) */
+            if((1 == blk_x) && (0 == blk_y))
+                use_left = left_avail && !top_avail;
+            else if((0 == blk_x) && (0 != blk_y))
+                use_top = top_avail && !left_avail;
+
+            for(i = 0; i < 2; i++)
+            {
+                if(use_top && use_left)
+                    ai4_val[i] = (ai4_top[blk_x][i] + ai4_left[blk_y][i] + 4) >> 3;
+                else if(use_left)
+                    ai4_val[i] = (ai4_left[blk_y][i] + 2) >> 2;
+                else if(use_top)
+                    ai4_val[i] = (ai4_top[blk_x][i] + 2) >> 2;
+                else
+                    ai4_val[i] = 128;
+            }
+
+            for(row = 0; row < 4; row++)
+            {
+                for(col = 0; col < 8; col += 2)
+                {
+                    pu1_blk[row * dst_strd + col] = ai4_val[0];
+                    pu1_blk[row * dst_strd + col + 1] = ai4_val[1];
+                }
+            }
+        }
+    }
+}
+
+/**
+*******************************************************************************
+*
+* ih264_intra_pred_chroma_8x16_mode_horz
+*
+* @brief
+*  Perform Intra prediction for  chroma_8x16 (4:2:2) mode:Horizontal
+*
+* @par Description:
+*  Perform Intra prediction for  chroma_8x16 mode:Horizontal ,described in sec 8.3.4.2
+*
+* @param[in] pu1_src
+*  UWORD8 pointer to the source containing alternate U and V samples
+*
+* @param[out] pu1_dst
+*  UWORD8 pointer to the destination with alternate U and V samples
+*
+* @param[in] src_strd
+*  integer source stride
+*
+* @param[in] dst_strd
+*  integer destination stride
+*
+* @param[in] ngbr_avail
+* availability of neighbouring pixels(Not used in this function)
+*
+* @returns
+*
+* @remarks
+*  None
+*
+******************************************************************************
+*/
+void ih264_intra_pred_chroma_8x16_mode_horz(UWORD8 *pu1_src,
+                                            UWORD8 *pu1_dst,
+                                            WORD32 src_strd,
+                                            WORD32 dst_strd,
+                                            WORD32 ngbr_avail)
+{
+    UWORD8 *pu1_left = pu1_src + 2 * MB_SIZE - 2;
+    WORD32 rows, cols;
+    UNUSED(src_strd);
+    UNUSED(ngbr_avail);
+
+    for(rows = 0; rows < 16; rows++)
+    {
+        for(cols = 0; cols < 16; cols += 2)
+        {
+            *(pu1_dst + rows * dst_strd + cols) = *pu1_left;
+            *(pu1_dst + rows * dst_strd + cols + 1) = *(pu1_left + 1);
+        }
+        pu1_left -= 2;
+    }
+}
+
+/**
+*******************************************************************************
+*
+* ih264_intra_pred_chroma_8x16_mode_vert
+*
+* @brief
+*  Perform Intra prediction for  chroma_8x16 (4:2:2) mode:vertical
+*
+* @par Description:
+*  Perform Intra prediction for  chroma_8x16 mode:vertical ,described in sec 8.3.4.3
+*
+* @param[in] pu1_src
+*  UWORD8 pointer to the source containing alternate U and V samples
+*
+* @param[out] pu1_dst
+*  UWORD8 pointer to the destination with alternate U and V samples
+*
+* @param[in] src_strd
+*  integer source stride
+*
+* @param[in] dst_strd
+*  integer destination stride
+*
+* @param[in] ngbr_avail
+* availability of neighbouring pixels(Not used in this function)
+*
+* @returns
+*
+* @remarks
+*  None
+*
+*******************************************************************************
+*/
+void ih264_intra_pred_chroma_8x16_mode_vert(UWORD8 *pu1_src,
+                                            UWORD8 *pu1_dst,
+                                            WORD32 src_strd,
+                                            WORD32 dst_strd,
+                                            WORD32 ngbr_avail)
+{
+    UWORD8 *pu1_top = pu1_src + 2 * MB_SIZE + 2;
+    WORD32 row;
+    UNUSED(src_strd);
+    UNUSED(ngbr_avail);
+
+    for(row = 0; row < 16; row++)
+    {
+        memcpy(pu1_dst, pu1_top, 16);
+        pu1_dst += dst_strd;
+    }
+}
+
+/**
+*******************************************************************************
+*
+* ih264_intra_pred_chroma_8x16_mode_plane
+*
+* @brief
+*  Perform Intra prediction for  chroma_8x16 (4:2:2) mode:PLANE
+*
+* @par Description:
+*  Perform Intra prediction for  chroma_8x16 mode:PLANE ,described in sec 8.3.4.4
+*  with xCF = 0 and yCF = 4
+*
+* @param[in] pu1_src
+*  UWORD8 pointer to the source containing alternate U and V samples
+*
+* @param[out] pu1_dst
+*  UWORD8 pointer to the destination with alternate U and V samples
+*
+* @param[in] src_strd
+*  integer source stride
+*
+* @param[in] dst_strd
+*  integer destination stride
+*
+* @param[in] ngbr_avail
+* availability of neighbouring pixels(Not used in this function)
+*
+* @returns
+*
+* @remarks
+*  None
+*
+******************************************************************************
+*/
+void ih264_intra_pred_chroma_8x16_mode_plane(UWORD8 *pu1_src,
+                                             UWORD8 *pu1_dst,
+                                             WORD32 src_strd,
+                                             WORD32 dst_strd,
+                                             WORD32 ngbr_avail)
+{
+    UWORD8 *pu1_left = pu1_src + 2 * MB_SIZE - 2;
+    UWORD8 *pu1_top = pu1_src + 2 * MB_SIZE + 2;
+    WORD32 val;
+    WORD32 rows, cols;
+    WORD32 a_u, b_u, c_u, h_u, v_u;
+    WORD32 a_v, b_v, c_v, h_v, v_v;
+    UNUSED(src_strd);
+    UNUSED(ngbr_avail);
+
+    h_u = h_v = v_u = v_v = 0;
+    for(cols = 0; cols < 4; cols++)
+    {
+        h_u += (cols + 1) * (pu1_top[8 + 2 * cols] - pu1_top[4 - 2 * cols]);
+        h_v += (cols + 1) * (pu1_top[8 + 2 * cols + 1] - pu1_top[4 - 2 * cols + 1]);
+    }
+    /* pu1_left[2] is the top left pel, needed when rows = 7 */
+    for(rows = 0; rows < 8; rows++)
+    {
+        v_u += (rows + 1) * (pu1_left[(8 + rows) * (-2)] - pu1_left[(6 - rows) * (-2)]);
+        v_v += (rows + 1) * (pu1_left[(8 + rows) * (-2) + 1] - pu1_left[(6 - rows) * (-2) + 1]);
+    }
+    a_u = 16 * (pu1_left[15 * (-2)] + pu1_top[14]);
+    a_v = 16 * (pu1_left[15 * (-2) + 1] + pu1_top[15]);
+    b_u = (34 * h_u + 32) >> 6;
+    b_v = (34 * h_v + 32) >> 6;
+    c_u = (5 * v_u + 32) >> 6;
+    c_v = (5 * v_v + 32) >> 6;
+
+    for(rows = 0; rows < 16; rows++)
+    {
+        for(cols = 0; cols < 8; cols++)
+        {
+            val = (a_u + b_u * (cols - 3) + c_u * (rows - 7));
+            val = (val + 16) >> 5;
+            *(pu1_dst + rows * dst_strd + 2 * cols) = CLIP_U8(val);
+            val = (a_v + b_v * (cols - 3) + c_v * (rows - 7));
+            val = (val + 16) >> 5;
+            *(pu1_dst + rows * dst_strd + 2 * cols + 1) = CLIP_U8(val);
+        }
+    }
+}
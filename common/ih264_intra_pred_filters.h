@@ -138,6 +138,16 @@ ih264_intra_pred_chroma_ft ih264_intra_pred_chroma_8x8_mode_vert;
 
 ih264_intra_pred_chroma_ft ih264_intra_pred_chroma_8x8_mode_plane;
 
+/* Chroma 8x16 (4:2:2) Intra pred filters */
+
+ih264_intra_pred_chroma_ft ih264_intra_pred_chroma_8x16_mode_dc;
+
+ih264_intra_pred_chroma_ft ih264_intra_pred_chroma_8x16_mode_horz;
+
+ih264_intra_pred_chroma_ft ih264_intra_pred_chroma_8x16_mode_vert;
+
+ih264_intra_pred_chroma_ft ih264_intra_pred_chroma_8x16_mode_plane;
+
 
 ih264_intra_pred_ref_filtering_ft  ih264_intra_pred_luma_8x8_mode_ref_filtering;
 
@@ -267,6 +277,24 @@ ih264_intra_pred_chroma_ft ih264_intra_pred_chroma_8x8_mode_vert_ssse3;
 
 ih264_intra_pred_chroma_ft ih264_intra_pred_chroma_8x8_mode_plane_ssse3;
 
+/* X86 AVX2 Intrinsic Definitions */
+
+/* Luma 8x8 Intra pred filters */
+
+ih264_intra_pred_ref_filtering_ft  ih264_intra_pred_luma_8x8_mode_ref_filtering_avx2;
+
+/* Luma 16x16 Intra pred filters */
+
+ih264_intra_pred_luma_ft  ih264_intra_pred_luma_16x16_mode_dc_avx2;
+
+ih264_intra_pred_luma_ft  ih264_intra_pred_luma_16x16_mode_plane_avx2;
+
+/* Chroma 8x8 Intra pred filters */
+
+ih264_intra_pred_chroma_ft ih264_intra_pred_chroma_8x8_mode_dc_avx2;
+
+ih264_intra_pred_chroma_ft ih264_intra_pred_chroma_8x8_mode_plane_avx2;
+
 /* AV8 Definition */
 
 /* Luma 4x4 Intra pred filters */
@@ -100,8 +100,8 @@
 
 #define SIGN(x)     (((x) >= 0) ? (((x) > 0) ? 1 : 0) : -1)
 
-#define RESET_BIT(x, pos) (x) = (x) & ~(1 << pos);
-#define SET_BIT(x, pos) (x) = (x) | (1 << pos);
+#define RESET_BIT(x, pos) (x) = (x) & ~(1 << (pos));
+#define SET_BIT(x, pos) (x) = (x) | (1 << (pos));
 #define GET_BIT(x, pos) ((x) >> (pos)) & 0x1
 
 #define INSERT_BIT(x, pos, bit) { RESET_BIT(x, pos); (x) = (x) | (bit << pos); }
@@ -129,6 +129,31 @@ typedef void ih264_iquant_itrans_recon_chroma_ft(WORD16 *pi2_src,
                                                  WORD16 *pi2_dc_src);
 
 
+typedef void ih264_iquant_itrans_recon_luma_mb_ft(WORD16 *pi2_src,
+                                                  UWORD8 *pu1_pred,
+                                                  UWORD8 *pu1_out,
+                                                  WORD32 pred_strd,
+                                                  WORD32 out_strd,
+                                                  const UWORD16 *pu2_iscal_mat,
+                                                  const UWORD16 *pu2_weigh_mat,
+                                                  UWORD32 u4_qp_div_6,
+                                                  UWORD32 u4_csbp,
+                                                  UWORD32 u4_dc_csbp,
+                                                  WORD32 iq_start_idx);
+
+typedef void ih264_iquant_itrans_recon_chroma_mb_ft(WORD16 *pi2_src,
+                                                    UWORD8 *pu1_pred,
+                                                    UWORD8 *pu1_out,
+                                                    WORD32 pred_strd,
+                                                    WORD32 out_strd,
+                                                    const UWORD16 *pu2_iscal_mat_u,
+                                                    const UWORD16 *pu2_iscal_mat_v,
+                                                    const UWORD16 *pu2_weigh_mat_u,
+                                                    const UWORD16 *pu2_weigh_mat_v,
+                                                    UWORD32 u4_qp_div_6_u,
+                                                    UWORD32 u4_qp_div_6_v,
+                                                    UWORD32 u4_csbp);
+
 typedef void ih264_luma_16x16_idctrans_iquant_itrans_recon_ft(WORD16 *pi2_src,
                                                               UWORD8 *pu1_pred,
                                                               UWORD8 *pu1_out,
@@ -229,4 +254,9 @@ ih264_ihadamard_scaling_ft ih264_ihadamard_scaling_4x4_sse42;
 ih264_hadamard_quant_ft ih264_hadamard_quant_4x4_sse42;
 ih264_hadamard_quant_ft ih264_hadamard_quant_2x2_uv_sse42;
 
+/*AVX2 Declarations*/
+ih264_iquant_itrans_recon_ft ih264_iquant_itrans_recon_8x8_avx2;
+ih264_iquant_itrans_recon_luma_mb_ft ih264_iquant_itrans_recon_luma_mb_avx2;
+ih264_iquant_itrans_recon_chroma_mb_ft ih264_iquant_itrans_recon_chroma_mb_avx2;
+
 #endif /* IH264_TRANS_QUANT_H_ */
@@ -0,0 +1,351 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/**
+*******************************************************************************
+* @file
+*  ih264_chroma_intra_pred_filters_avx2.c
+*
+* @brief
+*  Contains function definitions for chroma intra prediction filters in x86
+*  AVX2 intrinsics
+*
+* @author
+*  Ittiam
+*
+* @par List of Functions:
+*  -ih264_intra_pred_chroma_8x8_mode_dc_avx2
+*  -ih264_intra_pred_chroma_8x8_mode_plane_avx2
+*
+* @remarks
+*  Horizontal and vertical modes only replicate 16 byte rows and are served
+*  by the SSSE3 versions
+*
+*******************************************************************************
+*/
+
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+/* System include files */
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include <immintrin.h>
+
+/* User include files */
+#include "ih264_defs.h"
+#include "ih264_typedefs.h"
+#include "ih264_macros.h"
+#include "ih264_platform_macros.h"
+#include "ih264_intra_pred_filters.h"
+
+
+/*****************************************************************************/
+/* Chroma Intra prediction 8x8 filters                                       */
+/*****************************************************************************/
+/**
+*******************************************************************************
+*
+* ih264_intra_pred_chroma_8x8_mode_dc_avx2
+*
+* @brief
+*  Perform Intra prediction for chroma_8x8 mode:DC
+*
+* @par Description:
+*  Perform Intra prediction for chroma_8x8 mode:DC ,described in sec 8.3.4.1.
+*  The eight 4-sample sums of left and top neighbours of both planes are
+*  computed together, left in the lower lane and top in the upper lane
+*
+* @param[in] pu1_src
+*  UWORD8 pointer to the source containing alternate U and V samples
+*
+* @param[out] pu1_dst
+*  UWORD8 pointer to the destination with alternate U and V samples
+*
+* @param[in] src_strd
+*  integer source stride
+*
+* @param[in] dst_strd
+*  integer destination stride
+*
+* @param[in] ngbr_avail
+*  availability of neighbouring pixels
+*
+* @returns
+*
+* @remarks
+*  None
+*
+******************************************************************************
+*/
+void ATTRIBUTE_AVX2 ih264_intra_pred_chroma_8x8_mode_dc_avx2(UWORD8 *pu1_src,
+                                                            UWORD8 *pu1_dst,
+                                                            WORD32 src_strd,
+                                                            WORD32 dst_strd,
+                                                            WORD32 ngbr_avail)
+{
+    WORD32 left_avail, left_avail1, left_avail2; /* availability of left predictors (only for DC) */
+    WORD32 top_avail; /* availability of top predictors (only for DC) */
+
+    /* accumulated first left half,second left half, first top half, */
+    /* second top half of U and V values                               */
+    WORD32 val_u_l1 = 0, val_u_l2 = 0, val_u_t1 = 0, val_u_t2 = 0;
+    WORD32 val_v_l1 = 0, val_v_l2 = 0, val_v_t1 = 0, val_v_t2 = 0;
+
+    WORD32 val_u1, val_u2, val_v1, val_v2;
+    WORD32 row;
+
+    __m256i ngbr_32x8b, sum_8x32b;
+    __m128i dst_16x8b;
+
+    UNUSED(src_strd);
+
+    left_avail = ngbr_avail & 0x11;
+    left_avail1 = ngbr_avail & 1;
+    left_avail2 = (ngbr_avail >> 4) & 1;
+    top_avail = (ngbr_avail >> 2) & 1;
+
+    if(0 == (left_avail + top_avail))
+    {
+        /* Both left and top are unavailable, set the block to 128 */
+        dst_16x8b = _mm_set1_epi8((WORD8)128);
+        for(row = 0; row < 8; row++)
+        {
+            _mm_storeu_si128((__m128i *)pu1_dst, dst_16x8b);
+            pu1_dst += dst_strd;
+        }
+        return;
+    }
+
+    /* left samples (bottom most first) in the lower lane, top in the upper */
+    ngbr_32x8b = _mm256_inserti128_si256(
+                    _mm256_castsi128_si256(_mm_loadu_si128((__m128i *)pu1_src)),
+                    _mm_loadu_si128((__m128i *)(pu1_src + 2 * BLK8x8SIZE + 2)), 1);
+
+    /* separate U and V of each half and sum groups of four samples */
+    ngbr_32x8b = _mm256_shuffle_epi8(ngbr_32x8b,
+                                     _mm256_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14,
+                                                      1, 3, 5, 7, 9, 11, 13, 15,
+                                                      0, 2, 4, 6, 8, 10, 12, 14,
+                                                      1, 3, 5, 7, 9, 11, 13, 15));
+    sum_8x32b = _mm256_maddubs_epi16(ngbr_32x8b, _mm256_set1_epi8(1));
+    sum_8x32b = _mm256_madd_epi16(sum_8x32b, _mm256_set1_epi16(1));
+
+    if(left_avail1)
+    {
+        val_u_l1 = _mm256_extract_epi32(sum_8x32b, 1) + 2;
+        val_v_l1 = _mm256_extract_epi32(sum_8x32b, 3) + 2;
+    }
+    if(left_avail2)
+    {
+        val_u_l2 = _mm256_extract_epi32(sum_8x32b, 0) + 2;
+        val_v_l2 = _mm256_extract_epi32(sum_8x32b, 2) + 2;
+    }
+    if(top_avail)
+    {
+        val_u_t1 = _mm256_extract_epi32(sum_8x32b, 4) + 2;
+        val_u_t2 = _mm256_extract_epi32(sum_8x32b, 5) + 2;
+        val_v_t1 = _mm256_extract_epi32(sum_8x32b, 6) + 2;
+        val_v_t2 = _mm256_extract_epi32(sum_8x32b, 7) + 2;
+    }
+
+    val_u1 = (left_avail1 + top_avail) ?
+                    ((val_u_l1 + val_u_t1) >> (1 + left_avail1 + top_avail)) : 128;
+    val_v1 = (left_avail1 + top_avail) ?
+                    ((val_v_l1 + val_v_t1) >> (1 + left_avail1 + top_avail)) : 128;
+    if(top_avail)
+    {
+        val_u2 = val_u_t2 >> 2;
+        val_v2 = val_v_t2 >> 2;
+    }
+    else if(left_avail1)
+    {
+        val_u2 = val_u_l1 >> 2;
+        val_v2 = val_v_l1 >> 2;
+    }
+    else
+    {
+        val_u2 = val_v2 = 128;
+    }
+
+    /*top left and top right 4x4 blocks*/
+    dst_16x8b = _mm_unpacklo_epi64(_mm_set1_epi16(val_u1 | (val_v1 << 8)),
+                                   _mm_set1_epi16(val_u2 | (val_v2 << 8)));
+    for(row = 0; row < 4; row++)
+    {
+        _mm_storeu_si128((__m128i *)pu1_dst, dst_16x8b);
+        pu1_dst += dst_strd;
+    }
+
+    if(left_avail2)
+    {
+        val_u1 = val_u_l2 >> 2;
+        val_v1 = val_v_l2 >> 2;
+    }
+    else if(top_avail)
+    {
+        val_u1 = val_u_t1 >> 2;
+        val_v1 = val_v_t1 >> 2;
+    }
+    else
+    {
+        val_u1 = val_v1 = 128;
+    }
+    val_u2 = (left_avail2 + top_avail) ?
+                    ((val_u_l2 + val_u_t2) >> (1 + left_avail2 + top_avail)) : 128;
+    val_v2 = (left_avail2 + top_avail) ?
+                    ((val_v_l2 + val_v_t2) >> (1 + left_avail2 + top_avail)) : 128;
+
+    /*bottom left and bottom right 4x4 blocks*/
+    dst_16x8b = _mm_unpacklo_epi64(_mm_set1_epi16(val_u1 | (val_v1 << 8)),
+                                   _mm_set1_epi16(val_u2 | (val_v2 << 8)));
+    for(row = 0; row < 4; row++)
+    {
+        _mm_storeu_si128((__m128i *)pu1_dst, dst_16x8b);
+        pu1_dst += dst_strd;
+    }
+}
+
+/**
+*******************************************************************************
+*
+* ih264_intra_pred_chroma_8x8_mode_plane_avx2
+*
+* @brief
+*  Perform Intra prediction for chroma_8x8 mode:PLANE
+*
+* @par Description:
+*  Perform Intra prediction for chroma_8x8 mode:PLANE ,described in sec 8.3.4.4.
+*  H and V of both planes are computed together, and every interleaved row
+*  of the fitted planes is computed in one 256 bit register
+*
+* @param[in] pu1_src
+*  UWORD8 pointer to the source containing alternate U and V samples
+*
+* @param[out] pu1_dst
+*  UWORD8 pointer to the destination with alternate U and V samples
+*
+* @param[in] src_strd
+*  integer source stride
+*
+* @param[in] dst_strd
+*  integer destination stride
+*
+* @param[in] ngbr_avail
+* availability of neighbouring pixels(Not used in this function)
+*
+* @returns
+*
+* @remarks
+*  None
+*
+******************************************************************************
+*/
+void ATTRIBUTE_AVX2 ih264_intra_pred_chroma_8x8_mode_plane_avx2(UWORD8 *pu1_src,
+                                                               UWORD8 *pu1_dst,
+                                                               WORD32 src_strd,
+                                                               WORD32 dst_strd,
+                                                               WORD32 ngbr_avail)
+{
+    UWORD8 *pu1_left, *pu1_top;
+    WORD32 a_u, a_v, b_u, b_v, c_u, c_v;
+    WORD32 rows;
+
+    UNUSED(src_strd);
+    UNUSED(ngbr_avail);
+
+    pu1_top = pu1_src + MB_SIZE + 2;
+    pu1_left = pu1_src + MB_SIZE - 2;
+
+    //calculating a, b and c
+    {
+        WORD32 h_u, h_v, v_u, v_v;
+        __m128i val1_16x8b, val2_16x8b, shuffle_16x8b;
+        __m256i val1_16x16b, val2_16x16b, hv_8x32b, mul_16x16b;
+
+        // separates u and v of the H half and the V half
+        shuffle_16x8b = _mm_setr_epi8(0, 2, 4, 6, 1, 3, 5, 7, 8, 10, 12, 14, 9, 11, 13, 15);
+        mul_16x16b = _mm256_setr_epi16(1, 2, 3, 4, 1, 2, 3, 4, 1, 2, 3, 4, 1, 2, 3, 4);
+
+        // H in the lower 8 bytes and V in the upper 8 bytes, with the
+        // second operand of each difference reversed
+        val1_16x8b = _mm_unpacklo_epi64(_mm_loadl_epi64((__m128i *)(pu1_top + 8)),
+                                        _mm_shufflelo_epi16(_mm_loadl_epi64((__m128i *)(pu1_left - 14)), 0x1b));
+        val2_16x8b = _mm_unpacklo_epi64(_mm_shufflelo_epi16(_mm_loadl_epi64((__m128i *)(pu1_top - 2)), 0x1b),
+                                        _mm_loadl_epi64((__m128i *)(pu1_left - 4)));
+
+        val1_16x16b = _mm256_cvtepu8_epi16(_mm_shuffle_epi8(val1_16x8b, shuffle_16x8b));
+        val2_16x16b = _mm256_cvtepu8_epi16(_mm_shuffle_epi8(val2_16x8b, shuffle_16x8b));
+
+        val1_16x16b = _mm256_sub_epi16(val1_16x16b, val2_16x16b);
+        hv_8x32b = _mm256_madd_epi16(mul_16x16b, val1_16x16b);
+        hv_8x32b = _mm256_hadd_epi32(hv_8x32b, hv_8x32b);
+
+        h_u = _mm256_extract_epi32(hv_8x32b, 0);
+        h_v = _mm256_extract_epi32(hv_8x32b, 1);
+        v_u = _mm256_extract_epi32(hv_8x32b, 4);
+        v_v = _mm256_extract_epi32(hv_8x32b, 5);
+
+        a_u = (pu1_left[7 * (-2)] + pu1_top[14]) << 4;
+        a_v = (pu1_left[7 * (-2) + 1] + pu1_top[15]) << 4;
+
+        b_u = (34 * h_u + 32) >> 6;
+        b_v = (34 * h_v + 32) >> 6;
+        c_u = (34 * v_u + 32) >> 6;
+        c_v = (34 * v_v + 32) >> 6;
+    }
+
+    //using a, b and c to compute the fitted plane values
+    {
+        __m256i row_16x16b, c_16x16b, c2_16x16b;
+        __m256i res1_16x16b, res2_16x16b, res_32x8b;
+        WORD32 const_u, const_v;
+
+        const_u = a_u - 3 * c_u + 16;
+        const_v = a_v - 3 * c_v + 16;
+
+        c_16x16b = _mm256_set1_epi32((c_u & 0xffff) | (c_v << 16));
+        c2_16x16b = _mm256_slli_epi16(c_16x16b, 1);
+
+        //contains {-b*3, -b*2,... b*4} + a - c*3 + 16 for alternate u and v
+        row_16x16b = _mm256_mullo_epi16(_mm256_setr_epi16(-3, -3, -2, -2, -1, -1, 0, 0,
+                                                          1, 1, 2, 2, 3, 3, 4, 4),
+                                        _mm256_set1_epi32((b_u & 0xffff) | (b_v << 16)));
+        row_16x16b = _mm256_add_epi16(row_16x16b,
+                                      _mm256_set1_epi32((const_u & 0xffff) | (const_v << 16)));
+
+        for(rows = 0; rows < 8; rows += 2)
+        {
+            res1_16x16b = _mm256_srai_epi16(row_16x16b, 5);
+            res2_16x16b = _mm256_srai_epi16(_mm256_add_epi16(row_16x16b, c_16x16b), 5);
+
+            res_32x8b = _mm256_packus_epi16(res1_16x16b, res2_16x16b);
+            res_32x8b = _mm256_permute4x64_epi64(res_32x8b, 0xD8);
+
+            _mm_storeu_si128((__m128i *)pu1_dst, _mm256_castsi256_si128(res_32x8b));
+            _mm_storeu_si128((__m128i *)(pu1_dst + dst_strd),
+                             _mm256_extracti128_si256(res_32x8b, 1));
+
+            row_16x16b = _mm256_add_epi16(row_16x16b, c2_16x16b);
+            pu1_dst += dst_strd << 1;
+        }
+    }
+}
@@ -0,0 +1,159 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/**
+*******************************************************************************
+* @file
+*  ih264_cpu_features.c
+*
+* @brief
+*  Contains function to query the x86 instruction set extensions supported by
+*  the processor and the operating system
+*
+* @author
+*  Ittiam
+*
+* @par List of Functions:
+*  - ih264_xgetbv()
+*  - ih264_get_cpu_features()
+*
+* @remarks
+*  None
+*
+*******************************************************************************
+*/
+
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+/* System include files */
+#include <stddef.h>
+#include <cpuid.h>
+
+/* User include files */
+#include "ih264_typedefs.h"
+#include "ih264_cpu_features.h"
+
+/*****************************************************************************/
+/* Constant Macros                                                           */
+/*****************************************************************************/
+
+/* CPUID leaf 1, ECX */
+#define CPUID_1_ECX_SSSE3       (1 << 9)
+#define CPUID_1_ECX_SSE42       (1 << 20)
+#define CPUID_1_ECX_OSXSAVE     (1 << 27)
+#define CPUID_1_ECX_AVX         (1 << 28)
+
+/* CPUID leaf 7 sub leaf 0, EBX */
+#define CPUID_7_EBX_AVX2        (1 << 5)
+#define CPUID_7_EBX_AVX512F     (1 << 16)
+#define CPUID_7_EBX_AVX512BW    (1 << 30)
+
+/* XCR0 state components that the OS must save for the wider registers */
+#define XCR0_YMM_STATE          0x06
+#define XCR0_ZMM_STATE          0xE6
+
+/*****************************************************************************/
+/* Function Definitions                                                      */
+/*****************************************************************************/
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Reads extended control register 0
+*
+* @par Description:
+*  XCR0 tells which register states are saved by the OS on a context switch.
+*  Encoded as raw bytes so that no extra compiler flags are needed.
+*
+* @returns
+*  Lower 32 bits of XCR0
+*
+* @remarks
+*  Must be called only when CPUID reports OSXSAVE
+*
+*******************************************************************************
+*/
+static UWORD32 ih264_xgetbv(void)
+{
+    UWORD32 u4_eax, u4_edx;
+
+    __asm__ volatile(".byte 0x0f, 0x01, 0xd0"
+                     : "=a"(u4_eax), "=d"(u4_edx)
+                     : "c"(0));
+    return u4_eax;
+}
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Returns the x86 instruction set extensions usable by the codec
+*
+* @par Description:
+*  Queries CPUID for SSSE3, SSE4.2, AVX2 and AVX-512BW. AVX2 and AVX-512BW
+*  are reported only when the OS has enabled the corresponding register
+*  state in XCR0.
+*
+* @returns
+*  Bitwise OR of IH264_CPU_* flags
+*
+* @remarks
+*  None
+*
+*******************************************************************************
+*/
+UWORD32 ih264_get_cpu_features(void)
+{
+    UWORD32 u4_eax, u4_ebx, u4_ecx, u4_edx;
+    UWORD32 u4_xcr0 = 0;
+    UWORD32 u4_features = 0;
+
+    if(!__get_cpuid(1, &u4_eax, &u4_ebx, &u4_ecx, &u4_edx))
+        return 0;
+
+    if(u4_ecx & CPUID_1_ECX_SSSE3)
+        u4_features |= IH264_CPU_SSSE3;
+
+    if(u4_ecx & CPUID_1_ECX_SSE42)
+        u4_features |= IH264_CPU_SSE42;
+
+    if((u4_ecx & CPUID_1_ECX_OSXSAVE) && (u4_ecx & CPUID_1_ECX_AVX))
+        u4_xcr0 = ih264_xgetbv();
+
+    if((u4_xcr0 & XCR0_YMM_STATE) != XCR0_YMM_STATE)
+        return u4_features;
+
+    if(__get_cpuid_max(0, NULL) < 7)
+        return u4_features;
+
+    __cpuid_count(7, 0, u4_eax, u4_ebx, u4_ecx, u4_edx);
+
+    if(u4_ebx & CPUID_7_EBX_AVX2)
+        u4_features |= IH264_CPU_AVX2;
+
+    if(((u4_xcr0 & XCR0_ZMM_STATE) == XCR0_ZMM_STATE)
+                    && (u4_ebx & CPUID_7_EBX_AVX512F)
+                    && (u4_ebx & CPUID_7_EBX_AVX512BW))
+        u4_features |= IH264_CPU_AVX512BW;
+
+    return u4_features;
+}
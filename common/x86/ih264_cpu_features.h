@@ -0,0 +1,56 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/**
+*******************************************************************************
+* @file
+*  ih264_cpu_features.h
+*
+* @brief
+*  Run time detection of x86 instruction set extensions
+*
+* @author
+*  Ittiam
+*
+* @remarks
+*  None
+*
+*******************************************************************************
+*/
+
+#ifndef _IH264_CPU_FEATURES_H_
+#define _IH264_CPU_FEATURES_H_
+
+/*****************************************************************************/
+/* Constant Macros                                                           */
+/*****************************************************************************/
+
+/* Feature bits returned by ih264_get_cpu_features() */
+#define IH264_CPU_SSSE3         (1 << 0)
+#define IH264_CPU_SSE42         (1 << 1)
+#define IH264_CPU_AVX2          (1 << 2)
+#define IH264_CPU_AVX512BW      (1 << 3)
+
+/*****************************************************************************/
+/* Function Declarations                                                     */
+/*****************************************************************************/
+
+UWORD32 ih264_get_cpu_features(void);
+
+#endif /* _IH264_CPU_FEATURES_H_ */
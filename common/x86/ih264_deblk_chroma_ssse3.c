@@ -91,6 +91,7 @@
 /*         12 02 2015   Naveen Kumar P  Initial version                      */
 /*                                                                           */
 /*****************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_deblk_chroma_vert_bs4_ssse3(UWORD8 *pu1_src,
                                        WORD32 src_strd,
                                        WORD32 alpha_cb,
@@ -274,6 +275,7 @@ void ih264_deblk_chroma_vert_bs4_ssse3(UWORD8 *pu1_src,
 /*         12 02 2015   Naveen Kumar P  Initial version                      */
 /*                                                                           */
 /*****************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_deblk_chroma_horz_bs4_ssse3(UWORD8 *pu1_src,
                                        WORD32 src_strd,
                                        WORD32 alpha_cb,
@@ -424,6 +426,7 @@ void ih264_deblk_chroma_horz_bs4_ssse3(UWORD8 *pu1_src,
 /*         12 02 2015   Naveen Kumar P  Initial version                      */
 /*                                                                           */
 /*****************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_deblk_chroma_vert_bslt4_ssse3(UWORD8 *pu1_src,
                                          WORD32 src_strd,
                                          WORD32 alpha_cb,
@@ -645,6 +648,7 @@ void ih264_deblk_chroma_vert_bslt4_ssse3(UWORD8 *pu1_src,
 /*         12 02 2015   Naveen Kumar P  Initial version                      */
 /*                                                                           */
 /*****************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_deblk_chroma_horz_bslt4_ssse3(UWORD8 *pu1_src,
                                          WORD32 src_strd,
                                          WORD32 alpha_cb,
@@ -829,6 +833,7 @@ void ih264_deblk_chroma_horz_bslt4_ssse3(UWORD8 *pu1_src,
 /*         12 02 2015   Naveen Kumar P  Initial version                      */
 /*                                                                           */
 /*****************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_deblk_chroma_vert_bs4_mbaff_ssse3(UWORD8 *pu1_src,
                                              WORD32 src_strd,
                                              WORD32 alpha_cb,
@@ -963,6 +968,7 @@ void ih264_deblk_chroma_vert_bs4_mbaff_ssse3(UWORD8 *pu1_src,
 /*         12 02 2015   Naveen Kumar P  Initial version                      */
 /*                                                                           */
 /*****************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_deblk_chroma_vert_bslt4_mbaff_ssse3(UWORD8 *pu1_src,
                                                WORD32 src_strd,
                                                WORD32 alpha_cb,
@@ -87,6 +87,7 @@
 /*         12 02 2015   Naveen Kumar P  Initial version                      */
 /*                                                                           */
 /*****************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_deblk_luma_vert_bs4_ssse3(UWORD8 *pu1_src,
                                      WORD32 src_strd,
                                      WORD32 alpha,
@@ -508,6 +509,7 @@ void ih264_deblk_luma_vert_bs4_ssse3(UWORD8 *pu1_src,
 /*         12 02 2015   Naveen Kumar P  Initial version                      */
 /*                                                                           */
 /*****************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_deblk_luma_horz_bs4_ssse3(UWORD8 *pu1_src,
                                      WORD32 src_strd,
                                      WORD32 alpha,
@@ -847,6 +849,7 @@ void ih264_deblk_luma_horz_bs4_ssse3(UWORD8 *pu1_src,
 /*         12 02 2015   Naveen Kumar P  Initial version                      */
 /*                                                                           */
 /*****************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_deblk_luma_vert_bslt4_ssse3(UWORD8 *pu1_src,
                                        WORD32 src_strd,
                                        WORD32 alpha,
@@ -1142,6 +1145,7 @@ void ih264_deblk_luma_vert_bslt4_ssse3(UWORD8 *pu1_src,
 /*         12 02 2015   Naveen Kumar P  Initial version                      */
 /*                                                                           */
 /*****************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_deblk_luma_horz_bslt4_ssse3(UWORD8 *pu1_src,
                                        WORD32 src_strd,
                                        WORD32 alpha,
@@ -1439,6 +1443,7 @@ void ih264_deblk_luma_horz_bslt4_ssse3(UWORD8 *pu1_src,
 /*         12 02 2015   Naveen Kumar P  Initial version                      */
 /*                                                                           */
 /*****************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_deblk_luma_vert_bs4_mbaff_ssse3(UWORD8 *pu1_src,
                                            WORD32 src_strd,
                                            WORD32 alpha,
@@ -1758,6 +1763,7 @@ void ih264_deblk_luma_vert_bs4_mbaff_ssse3(UWORD8 *pu1_src,
 /*         12 02 2015   Naveen Kumar P  Initial version                      */
 /*                                                                           */
 /*****************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_deblk_luma_vert_bslt4_mbaff_ssse3(UWORD8 *pu1_src,
                                              WORD32 src_strd,
                                              WORD32 alpha,
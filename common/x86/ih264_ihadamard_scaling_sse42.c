@@ -49,6 +49,7 @@
 #include "ih264_size_defs.h"
 #include "ih264_structs.h"
 #include "ih264_trans_quant_itrans_iquant.h"
+#include "ih264_platform_macros.h"
 #include <immintrin.h>
 
 /*
@@ -86,6 +87,7 @@
  *
  *******************************************************************************
  */
+ATTRIBUTE_SSE42
 void ih264_ihadamard_scaling_4x4_sse42(WORD16* pi2_src,
                                        WORD16* pi2_out,
                                        const UWORD16 *pu2_iscal_mat,
@@ -201,6 +203,7 @@ void ih264_ihadamard_scaling_4x4_sse42(WORD16* pi2_src,
     _mm_storeu_si128((__m128i *) (&pi2_out[8]), src_r2_r3);
 }
 
+ATTRIBUTE_SSE42
 void ih264_ihadamard_scaling_2x2_uv_sse42(WORD16* pi2_src,
                                           WORD16* pi2_out,
                                           const UWORD16 *pu2_iscal_mat,
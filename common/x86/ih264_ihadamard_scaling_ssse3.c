@@ -48,6 +48,7 @@
 #include "ih264_size_defs.h"
 #include "ih264_structs.h"
 #include "ih264_trans_quant_itrans_iquant.h"
+#include "ih264_platform_macros.h"
 #include <immintrin.h>
 
 /*
@@ -85,6 +86,7 @@
  *
  *******************************************************************************
  */
+ATTRIBUTE_SSSE3
 void ih264_ihadamard_scaling_4x4_ssse3(WORD16* pi2_src,
                                        WORD16* pi2_out,
                                        const UWORD16 *pu2_iscal_mat,
@@ -87,6 +87,7 @@
 /*                      Senthoor                                             */
 /*                                                                           */
 /*****************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_inter_pred_luma_copy_ssse3(UWORD8 *pu1_src,
                                       UWORD8 *pu1_dst,
                                       WORD32 src_strd,
@@ -213,6 +214,7 @@ void ih264_inter_pred_luma_copy_ssse3(UWORD8 *pu1_src,
 /*                      Senthoor                                             */
 /*                                                                           */
 /*****************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_inter_pred_luma_horz_ssse3(UWORD8 *pu1_src,
                                       UWORD8 *pu1_dst,
                                       WORD32 src_strd,
@@ -478,6 +480,7 @@ void ih264_inter_pred_luma_horz_ssse3(UWORD8 *pu1_src,
 /*                      Senthoor                                             */
 /*                                                                           */
 /*****************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_inter_pred_luma_vert_ssse3(UWORD8 *pu1_src,
                                       UWORD8 *pu1_dst,
                                       WORD32 src_strd,
@@ -764,6 +767,7 @@ void ih264_inter_pred_luma_vert_ssse3(UWORD8 *pu1_src,
 /*                      Senthoor                                             */
 /*                                                                           */
 /*****************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_inter_pred_luma_horz_hpel_vert_hpel_ssse3(UWORD8 *pu1_src,
                                                      UWORD8 *pu1_dst,
                                                      WORD32 src_strd,
@@ -1488,6 +1492,7 @@ void ih264_inter_pred_luma_horz_hpel_vert_hpel_ssse3(UWORD8 *pu1_src,
 /*                      Senthoor                                             */
 /*                                                                           */
 /*****************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_inter_pred_luma_horz_qpel_ssse3(UWORD8 *pu1_src,
                                            UWORD8 *pu1_dst,
                                            WORD32 src_strd,
@@ -1782,6 +1787,7 @@ void ih264_inter_pred_luma_horz_qpel_ssse3(UWORD8 *pu1_src,
 /*                      Senthoor                                             */
 /*                                                                           */
 /*****************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_inter_pred_luma_vert_qpel_ssse3(UWORD8 *pu1_src,
                                            UWORD8 *pu1_dst,
                                            WORD32 src_strd,
@@ -2107,6 +2113,7 @@ void ih264_inter_pred_luma_vert_qpel_ssse3(UWORD8 *pu1_src,
 /*                      Senthoor                                             */
 /*                                                                           */
 /*****************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_inter_pred_luma_horz_qpel_vert_qpel_ssse3(UWORD8 *pu1_src,
                                                      UWORD8 *pu1_dst,
                                                      WORD32 src_strd,
@@ -2675,6 +2682,7 @@ void ih264_inter_pred_luma_horz_qpel_vert_qpel_ssse3(UWORD8 *pu1_src,
 /*                      Senthoor                                             */
 /*                                                                           */
 /*****************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_inter_pred_luma_horz_qpel_vert_hpel_ssse3(UWORD8 *pu1_src,
                                                      UWORD8 *pu1_dst,
                                                      WORD32 src_strd,
@@ -3285,6 +3293,7 @@ void ih264_inter_pred_luma_horz_qpel_vert_hpel_ssse3(UWORD8 *pu1_src,
 /*                      Senthoor                                             */
 /*                                                                           */
 /*****************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_inter_pred_luma_horz_hpel_vert_qpel_ssse3(UWORD8 *pu1_src,
                                                      UWORD8 *pu1_dst,
                                                      WORD32 src_strd,
@@ -3991,6 +4000,7 @@ void ih264_inter_pred_luma_horz_hpel_vert_qpel_ssse3(UWORD8 *pu1_src,
 /*                      Senthoor                                             */
 /*                                                                           */
 /*****************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_inter_pred_chroma_ssse3(UWORD8 *pu1_src,
                                    UWORD8 *pu1_dst,
                                    WORD32 src_strd,
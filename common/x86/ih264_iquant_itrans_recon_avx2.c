@@ -0,0 +1,860 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/**
+ *******************************************************************************
+ * @file
+ *  ih264_iquant_itrans_recon_avx2.c
+ *
+ * @brief
+ *  Contains function definitions for inverse quantization, inverse
+ * transform and reconstruction of a complete macroblock using 256 bit
+ * registers
+ *
+ * @author
+ *  Ittiam
+ *
+ * @par List of Functions:
+ *  - ih264_iquant_itrans_4x4_pair_avx2()
+ *  - ih264_store_4x4_pair_avx2()
+ *  - ih264_iquant_itrans_recon_luma_mb_avx2()
+ *  - ih264_iquant_itrans_recon_chroma_mb_avx2()
+ *  - ih264_iquant_itrans_recon_8x8_avx2()
+ *
+ * @remarks
+ *  The 4x4 kernels work on two horizontally adjacent 4x4 blocks at a time,
+ *  one block per 128 bit lane. Since all the unpack instructions of AVX2
+ *  operate within a lane, the transform is the same sequence of operations
+ *  as the SSE4.2 4x4 kernel.
+ *
+ *******************************************************************************
+ */
+/* User include files */
+#include "ih264_typedefs.h"
+#include "ih264_defs.h"
+#include "ih264_trans_macros.h"
+#include "ih264_macros.h"
+#include "ih264_platform_macros.h"
+#include "ih264_trans_data.h"
+#include "ih264_size_defs.h"
+#include "ih264_structs.h"
+#include "ih264_trans_quant_itrans_iquant.h"
+#include <immintrin.h>
+
+/*
+ ********************************************************************************
+ *
+ * @brief Inverse quantizes and inverse transforms two 4x4 blocks
+ *
+ * @par Description:
+ *  Block 0 is held in the lower lane and block 1 in the upper lane of every
+ *  register. The rounded residue ((x + 32) >> 6) of row i of both blocks is
+ *  returned in pres_r[i] as 32 bit values
+ *
+ * @param[in] src_r0_r1
+ *  rows 0 and 1 of the quantized coefficients of both blocks
+ *
+ * @param[in] src_r2_r3
+ *  rows 2 and 3 of the quantized coefficients of both blocks
+ *
+ * @param[in] scale_r0_r1
+ *  product of inverse scale and weight matrices, rows 0 and 1
+ *
+ * @param[in] scale_r2_r3
+ *  product of inverse scale and weight matrices, rows 2 and 3
+ *
+ * @param[in] u4_qp_div_6
+ *  Floor (qp/6)
+ *
+ * @param[in] dc_sel
+ *  Lanes set in this mask take the dc value from dc_val unscaled
+ *
+ * @param[in] dc_val
+ *  dc values at positions 0 and 4
+ *
+ * @param[out] pres_r
+ *  residue rows 0 to 3
+ *
+ * @returns none
+ *
+ * @remarks none
+ *
+ *******************************************************************************
+ */
+static INLINE ATTRIBUTE_AVX2 void ih264_iquant_itrans_4x4_pair_avx2(__m256i src_r0_r1,
+                                                                   __m256i src_r2_r3,
+                                                                   __m256i scale_r0_r1,
+                                                                   __m256i scale_r2_r3,
+                                                                   UWORD32 u4_qp_div_6,
+                                                                   __m256i dc_sel,
+                                                                   __m256i dc_val,
+                                                                   __m256i *pres_r)
+{
+    __m256i zero_16x16b = _mm256_setzero_si256();
+    __m256i value_32 = _mm256_set1_epi32(32);
+    __m256i temp0, temp1, temp2, temp3, temp4, temp5, temp6, temp7;
+    __m256i resq_r0, resq_r1, resq_r2, resq_r3;
+
+    /*************************************************************/
+    /* Dequantization of coefficients                            */
+    /*************************************************************/
+    temp4 = _mm256_unpacklo_epi16(scale_r0_r1, zero_16x16b);
+    temp5 = _mm256_unpackhi_epi16(scale_r0_r1, zero_16x16b);
+    temp6 = _mm256_unpacklo_epi16(scale_r2_r3, zero_16x16b);
+    temp7 = _mm256_unpackhi_epi16(scale_r2_r3, zero_16x16b);
+
+    temp0 = _mm256_unpacklo_epi16(src_r0_r1, zero_16x16b);
+    temp1 = _mm256_unpackhi_epi16(src_r0_r1, zero_16x16b);
+    temp2 = _mm256_unpacklo_epi16(src_r2_r3, zero_16x16b);
+    temp3 = _mm256_unpackhi_epi16(src_r2_r3, zero_16x16b);
+
+    temp4 = _mm256_madd_epi16(temp0, temp4);
+    temp5 = _mm256_madd_epi16(temp1, temp5);
+    temp6 = _mm256_madd_epi16(temp2, temp6);
+    temp7 = _mm256_madd_epi16(temp3, temp7);
+
+    if(u4_qp_div_6 >= 4)
+    {
+        resq_r0 = _mm256_slli_epi32(temp4, u4_qp_div_6 - 4);
+        resq_r1 = _mm256_slli_epi32(temp5, u4_qp_div_6 - 4);
+        resq_r2 = _mm256_slli_epi32(temp6, u4_qp_div_6 - 4);
+        resq_r3 = _mm256_slli_epi32(temp7, u4_qp_div_6 - 4);
+    }
+    else
+    {
+        __m256i add_rshift = _mm256_set1_epi32((1 << (3 - u4_qp_div_6)));
+
+        temp4 = _mm256_add_epi32(temp4, add_rshift);
+        temp5 = _mm256_add_epi32(temp5, add_rshift);
+        temp6 = _mm256_add_epi32(temp6, add_rshift);
+        temp7 = _mm256_add_epi32(temp7, add_rshift);
+        resq_r0 = _mm256_srai_epi32(temp4, 4 - u4_qp_div_6);
+        resq_r1 = _mm256_srai_epi32(temp5, 4 - u4_qp_div_6);
+        resq_r2 = _mm256_srai_epi32(temp6, 4 - u4_qp_div_6);
+        resq_r3 = _mm256_srai_epi32(temp7, 4 - u4_qp_div_6);
+    }
+
+    resq_r0 = _mm256_blendv_epi8(resq_r0, dc_val, dc_sel);
+
+    /*-------------------------------------------------------------*/
+    /* IDCT [ Horizontal transformation ]                          */
+    /*-------------------------------------------------------------*/
+    temp1 = _mm256_unpacklo_epi32(resq_r0, resq_r1);                //a0 b0 a1 b1
+    temp3 = _mm256_unpacklo_epi32(resq_r2, resq_r3);                //c0 d0 c1 d1
+    temp2 = _mm256_unpackhi_epi32(resq_r0, resq_r1);                //a2 b2 a3 b3
+    temp4 = _mm256_unpackhi_epi32(resq_r2, resq_r3);                //c2 d2 c3 d3
+    resq_r0 = _mm256_unpacklo_epi64(temp1, temp3);                  //a0 b0 c0 d0
+    resq_r1 = _mm256_unpackhi_epi64(temp1, temp3);                  //a1 b1 c1 d1
+    resq_r2 = _mm256_unpacklo_epi64(temp2, temp4);                  //a2 b2 c2 d2
+    resq_r3 = _mm256_unpackhi_epi64(temp2, temp4);                  //a3 b3 c3 d3
+
+    /* z0 = w0 + w2                                             */
+    temp0 = _mm256_add_epi32(resq_r0, resq_r2);
+    /* z1 = w0 - w2                                             */
+    temp1 = _mm256_sub_epi32(resq_r0, resq_r2);
+    /* z2 = (w1 >> 1) - w3                                      */
+    temp2 = _mm256_srai_epi32(resq_r1, 1);
+    temp2 = _mm256_sub_epi32(temp2, resq_r3);
+    /* z3 = w1 + (w3 >> 1)                                      */
+    temp3 = _mm256_srai_epi32(resq_r3, 1);
+    temp3 = _mm256_add_epi32(temp3, resq_r1);
+    /* x0 = z0 + z3                                             */
+    resq_r0 = _mm256_add_epi32(temp0, temp3);
+    /* x1 = z1 + z2                                             */
+    resq_r1 = _mm256_add_epi32(temp1, temp2);
+    /* x2 = z1 - z2                                             */
+    resq_r2 = _mm256_sub_epi32(temp1, temp2);
+    /* x3 = z0 - z3                                             */
+    resq_r3 = _mm256_sub_epi32(temp0, temp3);
+
+    temp1 = _mm256_unpacklo_epi32(resq_r0, resq_r1);                //a0 a1 b0 b1
+    temp3 = _mm256_unpacklo_epi32(resq_r2, resq_r3);                //a2 a3 b2 b3
+    temp2 = _mm256_unpackhi_epi32(resq_r0, resq_r1);                //c0 c1 d0 d1
+    temp4 = _mm256_unpackhi_epi32(resq_r2, resq_r3);                //c2 c3 d2 d3
+    resq_r0 = _mm256_unpacklo_epi64(temp1, temp3);                  //a0 a1 a2 a3
+    resq_r1 = _mm256_unpackhi_epi64(temp1, temp3);                  //b0 b1 b2 b3
+    resq_r2 = _mm256_unpacklo_epi64(temp2, temp4);                  //c0 c1 c2 c3
+    resq_r3 = _mm256_unpackhi_epi64(temp2, temp4);                  //d0 d1 d2 d3
+
+    /*--------------------------------------------------------------*/
+    /* IDCT [ Vertical transformation] and Xij = (xij + 32)>>6      */
+    /*--------------------------------------------------------------*/
+    /* z0j = y0j + y2j                                              */
+    temp0 = _mm256_add_epi32(resq_r0, resq_r2);
+    /* z1j = y0j - y2j                                              */
+    temp1 = _mm256_sub_epi32(resq_r0, resq_r2);
+    /* z2j = (y1j>>1) - y3j                                         */
+    temp2 = _mm256_srai_epi32(resq_r1, 1);
+    temp2 = _mm256_sub_epi32(temp2, resq_r3);
+    /* z3j = y1j + (y3j>>1)                                         */
+    temp3 = _mm256_srai_epi32(resq_r3, 1);
+    temp3 = _mm256_add_epi32(temp3, resq_r1);
+
+    /* x0j = z0j + z3j                                              */
+    temp4 = _mm256_add_epi32(temp0, temp3);
+    pres_r[0] = _mm256_srai_epi32(_mm256_add_epi32(temp4, value_32), 6);
+    /* x1j = z1j + z2j                                              */
+    temp5 = _mm256_add_epi32(temp1, temp2);
+    pres_r[1] = _mm256_srai_epi32(_mm256_add_epi32(temp5, value_32), 6);
+    /* x2j = z1j - z2j                                              */
+    temp6 = _mm256_sub_epi32(temp1, temp2);
+    pres_r[2] = _mm256_srai_epi32(_mm256_add_epi32(temp6, value_32), 6);
+    /* x3j = z0j - z3j                                              */
+    temp7 = _mm256_sub_epi32(temp0, temp3);
+    pres_r[3] = _mm256_srai_epi32(_mm256_add_epi32(temp7, value_32), 6);
+}
+
+/*
+ ********************************************************************************
+ *
+ * @brief Packs four rows of 8 reconstructed pixels to 8 bits with clipping
+ *
+ * @par Description:
+ *  Each input register holds one row of 8 pixels as 32 bit values. The
+ *  clipped rows 0 and 2 are returned in the lower lane and rows 1 and 3 in
+ *  the upper lane of the output
+ *
+ * @param[in] pres_r
+ *  rows 0 to 3
+ *
+ * @returns packed rows
+ *
+ * @remarks none
+ *
+ *******************************************************************************
+ */
+static INLINE ATTRIBUTE_AVX2 __m256i ih264_pack_4x4_pair_avx2(__m256i *pres_r)
+{
+    __m256i temp0, temp1;
+
+    /* r0[0..3] r1[0..3] | r0[4..7] r1[4..7] -> r0[0..7] | r1[0..7] */
+    temp0 = _mm256_packs_epi32(pres_r[0], pres_r[1]);
+    temp0 = _mm256_permute4x64_epi64(temp0, 0xD8);
+    temp1 = _mm256_packs_epi32(pres_r[2], pres_r[3]);
+    temp1 = _mm256_permute4x64_epi64(temp1, 0xD8);
+
+    /* r0 r2 | r1 r3 */
+    return _mm256_packus_epi16(temp0, temp1);
+}
+
+/*
+ ********************************************************************************
+ *
+ * @brief Stores the reconstruction of two horizontally adjacent luma 4x4 blocks
+ *
+ * @par Description:
+ *  Adds the residue of both blocks to the prediction, clips and stores the
+ *  8x4 result
+ *
+ * @param[in] pres_r
+ *  residue rows 0 to 3 as returned by ih264_iquant_itrans_4x4_pair_avx2()
+ *
+ * @param[in] pu1_pred
+ *  prediction 8x4 block
+ *
+ * @param[out] pu1_out
+ *  reconstructed 8x4 block
+ *
+ * @param[in] pred_strd
+ *  Prediction buffer stride
+ *
+ * @param[in] out_strd
+ *  recon buffer Stride
+ *
+ * @returns none
+ *
+ * @remarks none
+ *
+ *******************************************************************************
+ */
+static INLINE ATTRIBUTE_AVX2 void ih264_store_4x4_pair_avx2(__m256i *pres_r,
+                                                           UWORD8 *pu1_pred,
+                                                           UWORD8 *pu1_out,
+                                                           WORD32 pred_strd,
+                                                           WORD32 out_strd)
+{
+    __m256i pred_r, out;
+    __m128i out_lo, out_hi;
+    WORD32 i;
+
+    for(i = 0; i < 4; i++)
+    {
+        pred_r = _mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i *)(pu1_pred + i * pred_strd)));
+        pres_r[i] = _mm256_add_epi32(pres_r[i], pred_r);
+    }
+
+    out = ih264_pack_4x4_pair_avx2(pres_r);
+    out_lo = _mm256_castsi256_si128(out);
+    out_hi = _mm256_extracti128_si256(out, 1);
+
+    _mm_storel_epi64((__m128i *)(pu1_out), out_lo);
+    _mm_storel_epi64((__m128i *)(pu1_out + out_strd), out_hi);
+    _mm_storel_epi64((__m128i *)(pu1_out + 2 * out_strd), _mm_srli_si128(out_lo, 8));
+    _mm_storel_epi64((__m128i *)(pu1_out + 3 * out_strd), _mm_srli_si128(out_hi, 8));
+}
+
+/*
+ ********************************************************************************
+ *
+ * @brief This function reconstructs a 16x16 luma macroblock from the quantized
+ * residue of its 4x4 blocks and the prediction buffer
+ *
+ * @par Description:
+ *  Equivalent to calling ih264_iquant_itrans_recon_4x4() for every 4x4 block
+ *  whose bit is set in u4_csbp and ih264_iquant_itrans_recon_4x4_dc() for every
+ *  block whose bit is set only in u4_dc_csbp. Two horizontally adjacent blocks
+ *  are processed together. Blocks with neither bit set are not written
+ *
+ * @param[in] pi2_src
+ *  quantized coefficients of the 16 4x4 blocks in raster order, 16 each
+ *
+ * @param[in] pu1_pred
+ *  prediction 16x16 block
+ *
+ * @param[out] pu1_out
+ *  reconstructed 16x16 block
+ *
+ * @param[in] pred_strd,
+ *  Prediction buffer stride
+ *
+ * @param[in] out_strd
+ *  recon buffer Stride
+ *
+ * @param[in] pu2_iscal_mat
+ *  pointer to inverse scale matrix
+ *
+ * @param[in] pu2_weigh_mat
+ *  pointer to weight matrix
+ *
+ * @param[in] u4_qp_div_6
+ *  Floor (qp/6)
+ *
+ * @param[in] u4_csbp
+ *  coded sub block pattern, one bit per 4x4 block in raster order
+ *
+ * @param[in] u4_dc_csbp
+ *  blocks that only have a dc coefficient, one bit per 4x4 block
+ *
+ * @param[in] iq_start_idx
+ *  1 if the dc coefficients are already inverse quantized (intra 16x16)
+ *
+ * @returns none
+ *
+ * @remarks none
+ *
+ *******************************************************************************
+ */
+void ATTRIBUTE_AVX2 ih264_iquant_itrans_recon_luma_mb_avx2(WORD16 *pi2_src,
+                                                          UWORD8 *pu1_pred,
+                                                          UWORD8 *pu1_out,
+                                                          WORD32 pred_strd,
+                                                          WORD32 out_strd,
+                                                          const UWORD16 *pu2_iscal_mat,
+                                                          const UWORD16 *pu2_weigh_mat,
+                                                          UWORD32 u4_qp_div_6,
+                                                          UWORD32 u4_csbp,
+                                                          UWORD32 u4_dc_csbp,
+                                                          WORD32 iq_start_idx)
+{
+    __m128i scale_r0_r1, scale_r2_r3;
+    __m256i scale_8x16b_r0_r1, scale_8x16b_r2_r3;
+    __m256i dc_sel;
+    __m256i res_r[4];
+    UWORD32 u4_blk_mask = u4_csbp | u4_dc_csbp;
+    WORD32 i;
+
+    scale_r0_r1 = _mm_mullo_epi16(_mm_loadu_si128((__m128i *)(pu2_iscal_mat)),
+                                  _mm_loadu_si128((__m128i *)(pu2_weigh_mat)));
+    scale_r2_r3 = _mm_mullo_epi16(_mm_loadu_si128((__m128i *)(pu2_iscal_mat + 8)),
+                                  _mm_loadu_si128((__m128i *)(pu2_weigh_mat + 8)));
+    scale_8x16b_r0_r1 = _mm256_broadcastsi128_si256(scale_r0_r1);
+    scale_8x16b_r2_r3 = _mm256_broadcastsi128_si256(scale_r2_r3);
+
+    if(iq_start_idx == 1)
+        dc_sel = _mm256_setr_epi32(-1, 0, 0, 0, -1, 0, 0, 0);
+    else
+        dc_sel = _mm256_setzero_si256();
+
+    for(i = 0; i < 16; i += 2)
+    {
+        __m128i src_a[2], src_b[2];
+        __m256i src_r0_r1, src_r2_r3, dc_val;
+        WORD16 *pi2_blk = pi2_src + (i << 4);
+        WORD32 i4_offset;
+        WORD32 dc_a = 0, dc_b = 0;
+
+        if(0 == ((u4_blk_mask >> i) & 0x3))
+            continue;
+
+        src_a[0] = src_a[1] = _mm_setzero_si128();
+        src_b[0] = src_b[1] = _mm_setzero_si128();
+
+        if((u4_csbp >> i) & 0x1)
+        {
+            src_a[0] = _mm_loadu_si128((__m128i *)(pi2_blk));
+            src_a[1] = _mm_loadu_si128((__m128i *)(pi2_blk + 8));
+            dc_a = pi2_blk[0];
+        }
+        else if((u4_dc_csbp >> i) & 0x1)
+        {
+            src_a[0] = _mm_cvtsi32_si128((UWORD16)pi2_blk[0]);
+            dc_a = pi2_blk[0];
+        }
+
+        if((u4_csbp >> (i + 1)) & 0x1)
+        {
+            src_b[0] = _mm_loadu_si128((__m128i *)(pi2_blk + 16));
+            src_b[1] = _mm_loadu_si128((__m128i *)(pi2_blk + 24));
+            dc_b = pi2_blk[16];
+        }
+        else if((u4_dc_csbp >> (i + 1)) & 0x1)
+        {
+            src_b[0] = _mm_cvtsi32_si128((UWORD16)pi2_blk[16]);
+            dc_b = pi2_blk[16];
+        }
+
+        src_r0_r1 = _mm256_inserti128_si256(_mm256_castsi128_si256(src_a[0]), src_b[0], 1);
+        src_r2_r3 = _mm256_inserti128_si256(_mm256_castsi128_si256(src_a[1]), src_b[1], 1);
+        dc_val = _mm256_setr_epi32(dc_a, 0, 0, 0, dc_b, 0, 0, 0);
+
+        ih264_iquant_itrans_4x4_pair_avx2(src_r0_r1, src_r2_r3,
+                                          scale_8x16b_r0_r1, scale_8x16b_r2_r3,
+                                          u4_qp_div_6, dc_sel, dc_val, res_r);
+
+        i4_offset = ((i & 0x3) * BLK_SIZE);
+        ih264_store_4x4_pair_avx2(res_r,
+                                  pu1_pred + i4_offset + (i >> 2) * (pred_strd << 2),
+                                  pu1_out + i4_offset + (i >> 2) * (out_strd << 2),
+                                  pred_strd, out_strd);
+    }
+}
+
+/*
+ ********************************************************************************
+ *
+ * @brief This function reconstructs the 8x8 Cb and Cr blocks of a macroblock
+ * from their quantized residue and the interleaved prediction buffer
+ *
+ * @par Description:
+ *  Equivalent to calling ih264_iquant_itrans_recon_chroma_4x4() for every
+ *  4x4 block whose bit is set in u4_csbp and
+ *  ih264_iquant_itrans_recon_chroma_4x4_dc() for every other block with a
+ *  non zero dc. The Cb and Cr blocks of a 4x4 block row are reconstructed
+ *  together and stored interleaved without reading back the output
+ *
+ * @param[in] pi2_src
+ *  quantized coefficients of the 4 Cb blocks followed by the 4 Cr blocks.
+ *  The dc of each block is expected to be inverse quantized already
+ *
+ * @param[in] pu1_pred
+ *  interleaved prediction 8x8 block
+ *
+ * @param[out] pu1_out
+ *  interleaved reconstructed 8x8 block
+ *
+ * @param[in] pred_strd,
+ *  Prediction buffer stride
+ *
+ * @param[in] out_strd
+ *  recon buffer Stride
+ *
+ * @param[in] pu2_iscal_mat_u
+ *  pointer to inverse scale matrix for Cb
+ *
+ * @param[in] pu2_iscal_mat_v
+ *  pointer to inverse scale matrix for Cr
+ *
+ * @param[in] pu2_weigh_mat_u
+ *  pointer to weight matrix for Cb
+ *
+ * @param[in] pu2_weigh_mat_v
+ *  pointer to weight matrix for Cr
+ *
+ * @param[in] u4_qp_div_6_u
+ *  Floor (qp/6) for Cb
+ *
+ * @param[in] u4_qp_div_6_v
+ *  Floor (qp/6) for Cr
+ *
+ * @param[in] u4_csbp
+ *  coded sub block pattern, bits 0-3 for Cb and bits 4-7 for Cr
+ *
+ * @returns none
+ *
+ * @remarks none
+ *
+ *******************************************************************************
+ */
+void ATTRIBUTE_AVX2 ih264_iquant_itrans_recon_chroma_mb_avx2(WORD16 *pi2_src,
+                                                            UWORD8 *pu1_pred,
+                                                            UWORD8 *pu1_out,
+                                                            WORD32 pred_strd,
+                                                            WORD32 out_strd,
+                                                            const UWORD16 *pu2_iscal_mat_u,
+                                                            const UWORD16 *pu2_iscal_mat_v,
+                                                            const UWORD16 *pu2_weigh_mat_u,
+                                                            const UWORD16 *pu2_weigh_mat_v,
+                                                            UWORD32 u4_qp_div_6_u,
+                                                            UWORD32 u4_qp_div_6_v,
+                                                            UWORD32 u4_csbp)
+{
+    __m256i scale_u_r0_r1, scale_u_r2_r3, scale_v_r0_r1, scale_v_r2_r3;
+    __m256i dc_sel = _mm256_setr_epi32(-1, 0, 0, 0, -1, 0, 0, 0);
+    __m256i chroma_mask = _mm256_set1_epi16(0xFF);
+    __m256i res_u[4], res_v[4];
+    WORD32 i, j;
+
+    scale_u_r0_r1 = _mm256_broadcastsi128_si256(
+                    _mm_mullo_epi16(_mm_loadu_si128((__m128i *)(pu2_iscal_mat_u)),
+                                    _mm_loadu_si128((__m128i *)(pu2_weigh_mat_u))));
+    scale_u_r2_r3 = _mm256_broadcastsi128_si256(
+                    _mm_mullo_epi16(_mm_loadu_si128((__m128i *)(pu2_iscal_mat_u + 8)),
+                                    _mm_loadu_si128((__m128i *)(pu2_weigh_mat_u + 8))));
+    scale_v_r0_r1 = _mm256_broadcastsi128_si256(
+                    _mm_mullo_epi16(_mm_loadu_si128((__m128i *)(pu2_iscal_mat_v)),
+                                    _mm_loadu_si128((__m128i *)(pu2_weigh_mat_v))));
+    scale_v_r2_r3 = _mm256_broadcastsi128_si256(
+                    _mm_mullo_epi16(_mm_loadu_si128((__m128i *)(pu2_iscal_mat_v + 8)),
+                                    _mm_loadu_si128((__m128i *)(pu2_weigh_mat_v + 8))));
+
+    /* One row of two 4x4 blocks of each plane per iteration */
+    for(i = 0; i < 4; i += 2)
+    {
+        __m128i src[4][2];
+        __m256i dc_u, dc_v, out_u, out_v, out_lo, out_hi;
+        WORD16 *pi2_blk_u = pi2_src + (i << 4);
+        WORD16 *pi2_blk_v = pi2_blk_u + 64;
+        WORD16 *api2_blk[4];
+        WORD32 ai4_bit[4];
+        UWORD8 *pu1_pred_row = pu1_pred + (i >> 1) * (pred_strd << 2);
+        UWORD8 *pu1_out_row = pu1_out + (i >> 1) * (out_strd << 2);
+        WORD32 i4_nz = 0;
+
+        api2_blk[0] = pi2_blk_u;
+        api2_blk[1] = pi2_blk_u + 16;
+        api2_blk[2] = pi2_blk_v;
+        api2_blk[3] = pi2_blk_v + 16;
+        ai4_bit[0] = i;
+        ai4_bit[1] = i + 1;
+        ai4_bit[2] = i + 4;
+        ai4_bit[3] = i + 5;
+
+        for(j = 0; j < 4; j++)
+        {
+            src[j][0] = src[j][1] = _mm_setzero_si128();
+            if((u4_csbp >> (ai4_bit[j])) & 0x1)
+            {
+                src[j][0] = _mm_loadu_si128((__m128i *)(api2_blk[j]));
+                src[j][1] = _mm_loadu_si128((__m128i *)(api2_blk[j] + 8));
+                i4_nz = 1;
+            }
+            else if(api2_blk[j][0] != 0)
+            {
+                i4_nz = 1;
+            }
+        }
+
+        if(0 == i4_nz)
+            continue;
+
+        dc_u = _mm256_setr_epi32(pi2_blk_u[0], 0, 0, 0, pi2_blk_u[16], 0, 0, 0);
+        dc_v = _mm256_setr_epi32(pi2_blk_v[0], 0, 0, 0, pi2_blk_v[16], 0, 0, 0);
+
+        ih264_iquant_itrans_4x4_pair_avx2(
+                        _mm256_inserti128_si256(_mm256_castsi128_si256(src[0][0]), src[1][0], 1),
+                        _mm256_inserti128_si256(_mm256_castsi128_si256(src[0][1]), src[1][1], 1),
+                        scale_u_r0_r1, scale_u_r2_r3, u4_qp_div_6_u,
+                        dc_sel, dc_u, res_u);
+        ih264_iquant_itrans_4x4_pair_avx2(
+                        _mm256_inserti128_si256(_mm256_castsi128_si256(src[2][0]), src[3][0], 1),
+                        _mm256_inserti128_si256(_mm256_castsi128_si256(src[2][1]), src[3][1], 1),
+                        scale_v_r0_r1, scale_v_r2_r3, u4_qp_div_6_v,
+                        dc_sel, dc_v, res_v);
+
+        for(j = 0; j < 4; j++)
+        {
+            __m256i pred_uv = _mm256_castsi128_si256(
+                            _mm_loadu_si128((__m128i *)(pu1_pred_row + j * pred_strd)));
+            __m128i pred_u, pred_v;
+
+            pred_u = _mm256_castsi256_si128(_mm256_and_si256(pred_uv, chroma_mask));
+            pred_v = _mm256_castsi256_si128(_mm256_srli_epi16(pred_uv, 8));
+            res_u[j] = _mm256_add_epi32(res_u[j], _mm256_cvtepu16_epi32(pred_u));
+            res_v[j] = _mm256_add_epi32(res_v[j], _mm256_cvtepu16_epi32(pred_v));
+        }
+
+        /* u0 u2 | u1 u3 and v0 v2 | v1 v3 */
+        out_u = ih264_pack_4x4_pair_avx2(res_u);
+        out_v = ih264_pack_4x4_pair_avx2(res_v);
+
+        /* uv0 | uv1 and uv2 | uv3 */
+        out_lo = _mm256_unpacklo_epi8(out_u, out_v);
+        out_hi = _mm256_unpackhi_epi8(out_u, out_v);
+
+        _mm_storeu_si128((__m128i *)(pu1_out_row), _mm256_castsi256_si128(out_lo));
+        _mm_storeu_si128((__m128i *)(pu1_out_row + out_strd), _mm256_extracti128_si256(out_lo, 1));
+        _mm_storeu_si128((__m128i *)(pu1_out_row + 2 * out_strd), _mm256_castsi256_si128(out_hi));
+        _mm_storeu_si128((__m128i *)(pu1_out_row + 3 * out_strd), _mm256_extracti128_si256(out_hi, 1));
+    }
+}
+
+/*
+ ********************************************************************************
+ *
+ * @brief Transposes an 8x8 block of 32 bit values held one row per register
+ *
+ * @param[in/out] pr
+ *  rows 0 to 7 on input, columns 0 to 7 on output
+ *
+ * @returns none
+ *
+ * @remarks none
+ *
+ *******************************************************************************
+ */
+static INLINE ATTRIBUTE_AVX2 void ih264_transpose_8x8_32b_avx2(__m256i *pr)
+{
+    __m256i t0, t1, t2, t3, t4, t5, t6, t7;
+    __m256i u0, u1, u2, u3, u4, u5, u6, u7;
+
+    t0 = _mm256_unpacklo_epi32(pr[0], pr[1]);   //a0 b0 a1 b1 | a4 b4 a5 b5
+    t1 = _mm256_unpackhi_epi32(pr[0], pr[1]);   //a2 b2 a3 b3 | a6 b6 a7 b7
+    t2 = _mm256_unpacklo_epi32(pr[2], pr[3]);   //c0 d0 c1 d1 | c4 d4 c5 d5
+    t3 = _mm256_unpackhi_epi32(pr[2], pr[3]);   //c2 d2 c3 d3 | c6 d6 c7 d7
+    t4 = _mm256_unpacklo_epi32(pr[4], pr[5]);
+    t5 = _mm256_unpackhi_epi32(pr[4], pr[5]);
+    t6 = _mm256_unpacklo_epi32(pr[6], pr[7]);
+    t7 = _mm256_unpackhi_epi32(pr[6], pr[7]);
+
+    u0 = _mm256_unpacklo_epi64(t0, t2);         //a0 b0 c0 d0 | a4 b4 c4 d4
+    u1 = _mm256_unpackhi_epi64(t0, t2);         //a1 b1 c1 d1 | a5 b5 c5 d5
+    u2 = _mm256_unpacklo_epi64(t1, t3);         //a2 b2 c2 d2 | a6 b6 c6 d6
+    u3 = _mm256_unpackhi_epi64(t1, t3);         //a3 b3 c3 d3 | a7 b7 c7 d7
+    u4 = _mm256_unpacklo_epi64(t4, t6);         //e0 f0 g0 h0 | e4 f4 g4 h4
+    u5 = _mm256_unpackhi_epi64(t4, t6);
+    u6 = _mm256_unpacklo_epi64(t5, t7);
+    u7 = _mm256_unpackhi_epi64(t5, t7);
+
+    pr[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+    pr[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+    pr[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+    pr[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+    pr[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+    pr[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+    pr[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+    pr[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+/*
+ ********************************************************************************
+ *
+ * @brief One dimensional 8 point inverse transform across 8 registers
+ *
+ * @param[in/out] pw
+ *  w0 to w7 on input, x0 to x7 on output
+ *
+ * @returns none
+ *
+ * @remarks none
+ *
+ *******************************************************************************
+ */
+static INLINE ATTRIBUTE_AVX2 void ih264_itrans_8pt_avx2(__m256i *pw)
+{
+    __m256i y0, y1, y2, y3, y4, y5, y6, y7;
+    __m256i z0, z1, z2, z3, z4, z5, z6, z7;
+
+    /* y0 = w0 + w4                                                     */
+    y0 = _mm256_add_epi32(pw[0], pw[4]);
+    /* y1 = -w3 + w5 - w7 - (w7 >> 1)                                   */
+    y1 = _mm256_sub_epi32(pw[5], pw[3]);
+    y1 = _mm256_sub_epi32(y1, pw[7]);
+    y1 = _mm256_sub_epi32(y1, _mm256_srai_epi32(pw[7], 1));
+    /* y2 = w0 - w4                                                     */
+    y2 = _mm256_sub_epi32(pw[0], pw[4]);
+    /* y3 = w1 + w7 - w3 - (w3 >> 1)                                    */
+    y3 = _mm256_add_epi32(pw[1], pw[7]);
+    y3 = _mm256_sub_epi32(y3, pw[3]);
+    y3 = _mm256_sub_epi32(y3, _mm256_srai_epi32(pw[3], 1));
+    /* y4 = (w2 >> 1) - w6                                              */
+    y4 = _mm256_sub_epi32(_mm256_srai_epi32(pw[2], 1), pw[6]);
+    /* y5 = -w1 + w7 + w5 + (w5 >> 1)                                   */
+    y5 = _mm256_sub_epi32(pw[7], pw[1]);
+    y5 = _mm256_add_epi32(y5, pw[5]);
+    y5 = _mm256_add_epi32(y5, _mm256_srai_epi32(pw[5], 1));
+    /* y6 = w2 + (w6 >> 1)                                              */
+    y6 = _mm256_add_epi32(pw[2], _mm256_srai_epi32(pw[6], 1));
+    /* y7 = w3 + w5 + w1 + (w1 >> 1)                                    */
+    y7 = _mm256_add_epi32(pw[3], pw[5]);
+    y7 = _mm256_add_epi32(y7, pw[1]);
+    y7 = _mm256_add_epi32(y7, _mm256_srai_epi32(pw[1], 1));
+
+    /* z0 = y0 + y6                                                     */
+    z0 = _mm256_add_epi32(y0, y6);
+    /* z1 = y1 + (y7 >> 2)                                              */
+    z1 = _mm256_add_epi32(y1, _mm256_srai_epi32(y7, 2));
+    /* z2 = y2 + y4                                                     */
+    z2 = _mm256_add_epi32(y2, y4);
+    /* z3 = y3 + (y5 >> 2)                                              */
+    z3 = _mm256_add_epi32(y3, _mm256_srai_epi32(y5, 2));
+    /* z4 = y2 - y4                                                     */
+    z4 = _mm256_sub_epi32(y2, y4);
+    /* z5 = (y3 >> 2) - y5                                              */
+    z5 = _mm256_sub_epi32(_mm256_srai_epi32(y3, 2), y5);
+    /* z6 = y0 - y6                                                     */
+    z6 = _mm256_sub_epi32(y0, y6);
+    /* z7 = y7 - (y1 >> 2)                                              */
+    z7 = _mm256_sub_epi32(y7, _mm256_srai_epi32(y1, 2));
+
+    pw[0] = _mm256_add_epi32(z0, z7);
+    pw[1] = _mm256_add_epi32(z2, z5);
+    pw[2] = _mm256_add_epi32(z4, z3);
+    pw[3] = _mm256_add_epi32(z6, z1);
+    pw[4] = _mm256_sub_epi32(z6, z1);
+    pw[5] = _mm256_sub_epi32(z4, z3);
+    pw[6] = _mm256_sub_epi32(z2, z5);
+    pw[7] = _mm256_sub_epi32(z0, z7);
+}
+
+/*
+ ********************************************************************************
+ *
+ * @brief This function reconstructs a 8x8 sub block from quantized resiude and
+ * prediction buffer
+ *
+ * @par Description:
+ *  The quantized residue is first inverse quantized, then inverse transformed.
+ *  This inverse transformed content is added to the prediction buffer to recon-
+ *  struct the end output. Every row of the block is held in one register as
+ *  32 bit values, so both transform passes need no packing in between
+ *
+ * @param[in] pi2_src
+ *  quantized 8x8 block
+ *
+ * @param[in] pu1_pred
+ *  prediction 8x8 block
+ *
+ * @param[out] pu1_out
+ *  reconstructed 8x8 block
+ *
+ * @param[in] pred_strd,
+ *  Prediction buffer stride
+ *
+ * @param[in] out_strd
+ *  recon buffer Stride
+ *
+ * @param[in] pu2_iscale_mat
+ *  pointer to inverse scale matrix
+ *
+ * @param[in] pu2_weigh_mat
+ *  pointer to weight matrix
+ *
+ * @param[in] qp_div
+ *  Floor (qp/6)
+ *
+ * @param[in] pi2_tmp
+ *  temporary buffer of size 1*64 (unused)
+ *
+ * @returns none
+ *
+ * @remarks none
+ *
+ *******************************************************************************
+ */
+void ATTRIBUTE_AVX2 ih264_iquant_itrans_recon_8x8_avx2(WORD16 *pi2_src,
+                                                      UWORD8 *pu1_pred,
+                                                      UWORD8 *pu1_out,
+                                                      WORD32 pred_strd,
+                                                      WORD32 out_strd,
+                                                      const UWORD16 *pu2_iscale_mat,
+                                                      const UWORD16 *pu2_weigh_mat,
+                                                      UWORD32 qp_div,
+                                                      WORD16 *pi2_tmp,
+                                                      WORD32 iq_start_idx,
+                                                      WORD16 *pi2_dc_ld_addr)
+{
+    __m256i value_32 = _mm256_set1_epi32(32);
+    __m256i res[8];
+    __m256i out;
+    __m128i out_lo, out_hi;
+    WORD32 i;
+    UNUSED(pi2_tmp);
+    UNUSED(iq_start_idx);
+    UNUSED(pi2_dc_ld_addr);
+
+    /*************************************************************/
+    /* Dequantization of coefficients                            */
+    /*************************************************************/
+    for(i = 0; i < SUB_BLK_WIDTH_8x8; i++)
+    {
+        __m128i scale = _mm_mullo_epi16(_mm_loadu_si128((__m128i *)(pu2_iscale_mat + 8 * i)),
+                                        _mm_loadu_si128((__m128i *)(pu2_weigh_mat + 8 * i)));
+        __m256i src = _mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i *)(pi2_src + 8 * i)));
+
+        /* upper halves of the unsigned scale are zero, so the sign */
+        /* extension of the coefficients does not contribute        */
+        res[i] = _mm256_madd_epi16(src, _mm256_cvtepu16_epi32(scale));
+    }
+
+    if(qp_div >= 6)
+    {
+        for(i = 0; i < SUB_BLK_WIDTH_8x8; i++)
+            res[i] = _mm256_slli_epi32(res[i], qp_div - 6);
+    }
+    else
+    {
+        __m256i add_rshift = _mm256_set1_epi32((1 << (5 - qp_div)));
+
+        for(i = 0; i < SUB_BLK_WIDTH_8x8; i++)
+            res[i] = _mm256_srai_epi32(_mm256_add_epi32(res[i], add_rshift), 6 - qp_div);
+    }
+
+    /*--------------------------------------------------------------------*/
+    /* IDCT [ Horizontal transformation ]                                 */
+    /*--------------------------------------------------------------------*/
+    ih264_transpose_8x8_32b_avx2(res);
+    ih264_itrans_8pt_avx2(res);
+
+    /*--------------------------------------------------------------------*/
+    /* IDCT [ Vertical transformation] and Xij = (xij + 32)>>6            */
+    /*--------------------------------------------------------------------*/
+    ih264_transpose_8x8_32b_avx2(res);
+    ih264_itrans_8pt_avx2(res);
+
+    for(i = 0; i < SUB_BLK_WIDTH_8x8; i++)
+    {
+        __m256i pred_r = _mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i *)(pu1_pred + i * pred_strd)));
+
+        res[i] = _mm256_srai_epi32(_mm256_add_epi32(res[i], value_32), 6);
+        res[i] = _mm256_add_epi32(res[i], pred_r);
+    }
+
+    for(i = 0; i < SUB_BLK_WIDTH_8x8; i += 4)
+    {
+        out = ih264_pack_4x4_pair_avx2(&res[i]);
+        out_lo = _mm256_castsi256_si128(out);
+        out_hi = _mm256_extracti128_si256(out, 1);
+
+        _mm_storel_epi64((__m128i *)(pu1_out), out_lo);
+        _mm_storel_epi64((__m128i *)(pu1_out + out_strd), out_hi);
+        _mm_storel_epi64((__m128i *)(pu1_out + 2 * out_strd), _mm_srli_si128(out_lo, 8));
+        _mm_storel_epi64((__m128i *)(pu1_out + 3 * out_strd), _mm_srli_si128(out_hi, 8));
+        pu1_out += 4 * out_strd;
+    }
+}
@@ -98,6 +98,7 @@
  *
  *******************************************************************************
  */
+ATTRIBUTE_SSSE3
 void ih264_iquant_itrans_recon_4x4_dc_ssse3(WORD16 *pi2_src,
                                    UWORD8 *pu1_pred,
                                    UWORD8 *pu1_out,
@@ -224,6 +225,7 @@ void ih264_iquant_itrans_recon_4x4_dc_ssse3(WORD16 *pi2_src,
  *******************************************************************************
  */
 
+ATTRIBUTE_SSSE3
 void ih264_iquant_itrans_recon_8x8_dc_ssse3 (WORD16 *pi2_src,
                                          UWORD8 *pu1_pred,
                                          UWORD8 *pu1_out,
@@ -385,6 +387,7 @@ void ih264_iquant_itrans_recon_8x8_dc_ssse3 (WORD16 *pi2_src,
  *
  *******************************************************************************
  */
+ATTRIBUTE_SSSE3
 void ih264_iquant_itrans_recon_chroma_4x4_dc_ssse3(WORD16 *pi2_src,
                                    UWORD8 *pu1_pred,
                                    UWORD8 *pu1_out,
@@ -97,6 +97,7 @@
  *
  *******************************************************************************
  */
+ATTRIBUTE_SSE42
 void ih264_iquant_itrans_recon_4x4_sse42(WORD16 *pi2_src,
                                    UWORD8 *pu1_pred,
                                    UWORD8 *pu1_out,
@@ -348,6 +349,7 @@ void ih264_iquant_itrans_recon_4x4_sse42(WORD16 *pi2_src,
  *
  *******************************************************************************
  */
+ATTRIBUTE_SSE42
 void ih264_iquant_itrans_recon_chroma_4x4_sse42(WORD16 *pi2_src,
                                    UWORD8 *pu1_pred,
                                    UWORD8 *pu1_out,
@@ -97,6 +97,7 @@
  *
  *******************************************************************************
  */
+ATTRIBUTE_SSSE3
 void ih264_iquant_itrans_recon_4x4_ssse3(WORD16 *pi2_src,
                                          UWORD8 *pu1_pred,
                                          UWORD8 *pu1_out,
@@ -366,6 +367,7 @@ void ih264_iquant_itrans_recon_4x4_ssse3(WORD16 *pi2_src,
  *******************************************************************************
  */
 
+ATTRIBUTE_SSSE3
 void ih264_iquant_itrans_recon_8x8_ssse3(WORD16 *pi2_src,
                                          UWORD8 *pu1_pred,
                                          UWORD8 *pu1_out,
@@ -0,0 +1,411 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/**
+ *******************************************************************************
+ * @file
+ *  ih264_luma_intra_pred_filters_avx2.c
+ *
+ * @brief
+ *  Contains function definitions for luma intra prediction filters in x86
+ *  AVX2 intrinsics
+ *
+ * @author
+ *  Ittiam
+ *
+ * @par List of Functions:
+ *  - ih264_intra_pred_luma_8x8_mode_ref_filtering_avx2
+ *  - ih264_intra_pred_luma_16x16_mode_dc_avx2
+ *  - ih264_intra_pred_luma_16x16_mode_plane_avx2
+ *
+ * @remarks
+ *  The remaining luma modes only copy or filter rows of at most 16 pixels
+ *  and are served by the SSSE3 versions
+ *
+ ******************************************************************************
+ */
+
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+/* System include files */
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include <immintrin.h>
+
+/* User include files */
+#include "ih264_defs.h"
+#include "ih264_typedefs.h"
+#include "ih264_macros.h"
+#include "ih264_platform_macros.h"
+#include "ih264_intra_pred_filters.h"
+
+
+
+/*******************    LUMA INTRAPREDICTION    *******************/
+
+/*******************    8x8 Modes    *******************/
+
+/**
+ *******************************************************************************
+ *
+ * ih264_intra_pred_luma_8x8_mode_ref_filtering_avx2
+ *
+ * @brief
+ *  Reference sample filtering process for Intra_8x8 sample prediction
+ *
+ * @par Description:
+ *  Perform Reference sample filtering process for Intra_8x8 sample prediction,
+ *  described in sec 8.3.2.2.1. The 16 top and top right samples are filtered
+ *  in one 256 bit register, the 8 left samples in one 128 bit register
+ *
+ * @param[in] pu1_left
+ *  UWORD8 pointer to the left samples
+ *
+ * @param[in] pu1_topleft
+ *  UWORD8 pointer to the top left sample
+ *
+ * @param[in] pu1_top
+ *  UWORD8 pointer to the top samples
+ *
+ * @param[out] pu1_dst
+ *  UWORD8 pointer to the filtered samples
+ *
+ * @param[in] left_strd
+ *  integer stride of the left samples
+ *
+ * @param[in] ngbr_avail
+ * availability of neighbouring pixels
+ *
+ * @returns
+ *
+ * @remarks
+ *  None
+ *
+ *******************************************************************************/
+void ATTRIBUTE_AVX2 ih264_intra_pred_luma_8x8_mode_ref_filtering_avx2(UWORD8 *pu1_left,
+                                                                     UWORD8 *pu1_topleft,
+                                                                     UWORD8 *pu1_top,
+                                                                     UWORD8 *pu1_dst,
+                                                                     WORD32 left_strd,
+                                                                     WORD32 ngbr_avail)
+{
+    WORD32 top_avail, left_avail, top_left_avail, top_right_avail;
+
+    left_avail = BOOLEAN(ngbr_avail & LEFT_MB_AVAILABLE_MASK);
+    top_avail = BOOLEAN(ngbr_avail & TOP_MB_AVAILABLE_MASK);
+    top_left_avail = BOOLEAN(ngbr_avail & TOP_LEFT_MB_AVAILABLE_MASK);
+    top_right_avail = BOOLEAN(ngbr_avail & TOP_RIGHT_MB_AVAILABLE_MASK);
+
+    if(top_avail)
+    {
+        __m128i top_16x8b, top_right_16x8b, prev_16x8b, next_16x8b;
+        __m256i cur_16x16b, prev_16x16b, next_16x16b, res_16x16b;
+        __m256i const_2_16x16b = _mm256_set1_epi16(2);
+        UWORD8 u1_prev, u1_last;
+
+        /* top right samples are replaced by the last top sample if unavailable */
+        top_16x8b = _mm_loadl_epi64((__m128i *)pu1_top);
+        if(top_right_avail)
+        {
+            top_right_16x8b = _mm_loadl_epi64((__m128i *)(pu1_top + 8));
+            u1_last = pu1_top[15];
+        }
+        else
+        {
+            top_right_16x8b = _mm_set1_epi8(pu1_top[7]);
+            u1_last = pu1_top[7];
+        }
+        top_16x8b = _mm_unpacklo_epi64(top_16x8b, top_right_16x8b);
+
+        /* samples at either end are repeated where the neighbour is missing */
+        u1_prev = top_left_avail ? pu1_topleft[0] : pu1_top[0];
+        prev_16x8b = _mm_alignr_epi8(top_16x8b, _mm_set1_epi8(u1_prev), 15);
+        next_16x8b = _mm_alignr_epi8(_mm_set1_epi8(u1_last), top_16x8b, 1);
+
+        cur_16x16b = _mm256_cvtepu8_epi16(top_16x8b);
+        prev_16x16b = _mm256_cvtepu8_epi16(prev_16x8b);
+        next_16x16b = _mm256_cvtepu8_epi16(next_16x8b);
+
+        res_16x16b = _mm256_add_epi16(prev_16x16b, next_16x16b);
+        res_16x16b = _mm256_add_epi16(res_16x16b, _mm256_slli_epi16(cur_16x16b, 1));
+        res_16x16b = _mm256_add_epi16(res_16x16b, const_2_16x16b);
+        res_16x16b = _mm256_srli_epi16(res_16x16b, 2);
+
+        res_16x16b = _mm256_packus_epi16(res_16x16b, res_16x16b);
+        res_16x16b = _mm256_permute4x64_epi64(res_16x16b, 0xD8);
+
+        _mm_storeu_si128((__m128i *)(pu1_dst + 8 + 1), _mm256_castsi256_si128(res_16x16b));
+    }
+
+    /* pu1_topleft is overloaded. It is both: */
+    /* a. A pointer for the top left pixel */
+    /* b. An indicator of availability of top left. */
+    /*    If it is null then top left not available */
+    if(top_left_avail)
+    {
+        if((!top_avail) || (!left_avail))
+        {
+            if(top_avail)
+                pu1_dst[8] = (3 * pu1_topleft[0] + pu1_top[0] + 2) >> 2;
+            else if(left_avail)
+                pu1_dst[8] = (3 * pu1_topleft[0] + pu1_left[0] + 2) >> 2;
+        }
+        else
+        {
+            pu1_dst[8] = FILT121(pu1_top[0], (*pu1_topleft), pu1_left[0]);
+        }
+    }
+
+    if(left_avail)
+    {
+        UWORD8 au1_left[16];
+        __m128i left_16x8b;
+        __m128i cur_8x16b, prev_8x16b, next_8x16b, res_8x16b;
+        WORD32 idx;
+
+        /* left samples in destination order, i.e. bottom most first, with */
+        /* the end samples repeated where the neighbour is missing          */
+        for(idx = 0; idx < 8; idx++)
+            au1_left[8 - idx] = pu1_left[idx * left_strd];
+        au1_left[0] = au1_left[1];
+        au1_left[9] = (0 != pu1_topleft) ? pu1_topleft[0] : au1_left[8];
+
+        left_16x8b = _mm_loadu_si128((__m128i *)au1_left);
+        prev_8x16b = _mm_cvtepu8_epi16(left_16x8b);
+        cur_8x16b = _mm_cvtepu8_epi16(_mm_srli_si128(left_16x8b, 1));
+        next_8x16b = _mm_cvtepu8_epi16(_mm_srli_si128(left_16x8b, 2));
+
+        res_8x16b = _mm_add_epi16(prev_8x16b, next_8x16b);
+        res_8x16b = _mm_add_epi16(res_8x16b, _mm_slli_epi16(cur_8x16b, 1));
+        res_8x16b = _mm_add_epi16(res_8x16b, _mm_set1_epi16(2));
+        res_8x16b = _mm_srli_epi16(res_8x16b, 2);
+
+        _mm_storel_epi64((__m128i *)pu1_dst, _mm_packus_epi16(res_8x16b, res_8x16b));
+    }
+}
+
+/*******************    16x16 Modes    *******************/
+
+/**
+ *******************************************************************************
+ *
+ *ih264_intra_pred_luma_16x16_mode_dc_avx2
+ *
+ * @brief
+ *  Perform Intra prediction for  luma_16x16 mode:DC
+ *
+ * @par Description:
+ *  Perform Intra prediction for  luma_16x16 mode:DC, described in sec 8.3.3.3.
+ *  Left and top neighbours are summed together with a single SAD instruction
+ *
+ * @param[in] pu1_src
+ *  UWORD8 pointer to the source
+ *
+ * @param[out] pu1_dst
+ *  UWORD8 pointer to the destination
+ *
+ * @param[in] src_strd
+ *  integer source stride
+ *
+ * @param[in] dst_strd
+ *  integer destination stride
+ *
+ * @param[in] ngbr_avail
+ *  availability of neighbouring pixels
+ *
+ * @returns
+ *
+ * @remarks
+ *  None
+ *
+ *******************************************************************************/
+void ATTRIBUTE_AVX2 ih264_intra_pred_luma_16x16_mode_dc_avx2(UWORD8 *pu1_src,
+                                                            UWORD8 *pu1_dst,
+                                                            WORD32 src_strd,
+                                                            WORD32 dst_strd,
+                                                            WORD32 ngbr_avail)
+{
+    WORD8 u1_useleft; /* availability of left predictors (only for DC) */
+    UWORD8 u1_usetop; /* availability of top predictors (only for DC) */
+    WORD32 rows;
+    WORD32 val = 0;
+
+    __m256i ngbr_32x8b, sad_4x64b;
+    __m128i dc_val_16x8b;
+
+    UNUSED(src_strd);
+
+    u1_useleft = BOOLEAN(ngbr_avail & LEFT_MB_AVAILABLE_MASK);
+    u1_usetop = BOOLEAN(ngbr_avail & TOP_MB_AVAILABLE_MASK);
+
+    /* left neighbours in the lower lane, top neighbours in the upper lane */
+    ngbr_32x8b = _mm256_inserti128_si256(
+                    _mm256_castsi128_si256(_mm_loadu_si128((__m128i *)pu1_src)),
+                    _mm_loadu_si128((__m128i *)(pu1_src + MB_SIZE + 1)), 1);
+    sad_4x64b = _mm256_sad_epu8(ngbr_32x8b, _mm256_setzero_si256());
+
+    if(u1_useleft)
+    {
+        val += _mm256_extract_epi16(sad_4x64b, 0) + _mm256_extract_epi16(sad_4x64b, 4);
+        val += 8;
+    }
+    if(u1_usetop)
+    {
+        val += _mm256_extract_epi16(sad_4x64b, 8) + _mm256_extract_epi16(sad_4x64b, 12);
+        val += 8;
+    }
+    /* Since 8 is added if either left/top pred is there,
+     val still being zero implies both preds are not there */
+    val = (val) ? (val >> (3 + u1_useleft + u1_usetop)) : 128;
+
+    dc_val_16x8b = _mm_set1_epi8(val);
+
+    for(rows = 0; rows < 16; rows += 4)
+    {
+        _mm_storeu_si128((__m128i *)pu1_dst, dc_val_16x8b);
+        _mm_storeu_si128((__m128i *)(pu1_dst + dst_strd), dc_val_16x8b);
+        _mm_storeu_si128((__m128i *)(pu1_dst + 2 * dst_strd), dc_val_16x8b);
+        _mm_storeu_si128((__m128i *)(pu1_dst + 3 * dst_strd), dc_val_16x8b);
+        pu1_dst += 4 * dst_strd;
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ *ih264_intra_pred_luma_16x16_mode_plane_avx2
+ *
+ * @brief
+ *  Perform Intra prediction for  luma_16x16 mode:PLANE
+ *
+ * @par Description:
+ *  Perform Intra prediction for  luma_16x16 mode:PLANE, described in sec 8.3.3.4.
+ *  H and V are computed together, one per 128 bit lane, and every row of
+ *  the fitted plane is computed in one 256 bit register
+ *
+ * @param[in] pu1_src
+ *  UWORD8 pointer to the source
+ *
+ * @param[out] pu1_dst
+ *  UWORD8 pointer to the destination
+ *
+ * @param[in] src_strd
+ *  integer source stride
+ *
+ * @param[in] dst_strd
+ *  integer destination stride
+ *
+ * @param[in] ngbr_avail
+ * availability of neighbouring pixels(Not used in this function)
+ *
+ * @returns
+ *
+ * @remarks
+ *  None
+ *
+ *******************************************************************************/
+void ATTRIBUTE_AVX2 ih264_intra_pred_luma_16x16_mode_plane_avx2(UWORD8 *pu1_src,
+                                                               UWORD8 *pu1_dst,
+                                                               WORD32 src_strd,
+                                                               WORD32 dst_strd,
+                                                               WORD32 ngbr_avail)
+{
+    UWORD8 *pu1_left, *pu1_top;
+    WORD32 a, b, c;
+    WORD32 rows;
+
+    UNUSED(src_strd);
+    UNUSED(ngbr_avail);
+
+    pu1_top = pu1_src + MB_SIZE + 1;
+    pu1_left = pu1_src + MB_SIZE - 1;
+
+    //calculating a, b and c
+    {
+        WORD32 h, v;
+        __m128i val1_16x8b, val2_16x8b;
+        __m256i val1_16x16b, val2_16x16b, hv_8x32b;
+        __m256i rev_hi_32x8b, rev_lo_32x8b, mul_16x16b;
+
+        //reverse the order of 16-bit values in the upper and lower lane respectively
+        rev_hi_32x8b = _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                                        14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+        rev_lo_32x8b = _mm256_setr_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1,
+                                        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        mul_16x16b = _mm256_setr_epi16(1, 2, 3, 4, 5, 6, 7, 8, 1, 2, 3, 4, 5, 6, 7, 8);
+
+        a = (pu1_top[15] + pu1_left[-15]) << 4;
+
+        // H in the lower lane and V in the upper lane
+        val1_16x8b = _mm_unpacklo_epi64(_mm_loadl_epi64((__m128i *)(pu1_top + 8)),
+                                        _mm_loadl_epi64((__m128i *)(pu1_left - 15)));
+        val2_16x8b = _mm_unpacklo_epi64(_mm_loadl_epi64((__m128i *)(pu1_top - 1)),
+                                        _mm_loadl_epi64((__m128i *)(pu1_left - 6)));
+
+        val1_16x16b = _mm256_cvtepu8_epi16(val1_16x8b);
+        val2_16x16b = _mm256_cvtepu8_epi16(val2_16x8b);
+
+        val1_16x16b = _mm256_shuffle_epi8(val1_16x16b, rev_hi_32x8b);
+        val2_16x16b = _mm256_shuffle_epi8(val2_16x16b, rev_lo_32x8b);
+
+        val1_16x16b = _mm256_sub_epi16(val1_16x16b, val2_16x16b);
+        hv_8x32b = _mm256_madd_epi16(mul_16x16b, val1_16x16b);
+        hv_8x32b = _mm256_hadd_epi32(hv_8x32b, hv_8x32b);
+        hv_8x32b = _mm256_hadd_epi32(hv_8x32b, hv_8x32b);
+
+        h = _mm256_extract_epi32(hv_8x32b, 0);
+        v = _mm256_extract_epi32(hv_8x32b, 4);
+
+        b = ((h << 2) + h + 32) >> 6;
+        c = ((v << 2) + v + 32) >> 6;
+    }
+
+    //using a, b and c to compute the fitted plane values
+    {
+        __m256i row_16x16b, c_16x16b, c2_16x16b;
+        __m256i res1_16x16b, res2_16x16b, res_32x8b;
+
+        c_16x16b = _mm256_set1_epi16(c);
+        c2_16x16b = _mm256_set1_epi16(c << 1);
+
+        //contains {-b*7, -b*6,... b*8} + a - c*7 + 16
+        row_16x16b = _mm256_mullo_epi16(_mm256_setr_epi16(-7, -6, -5, -4, -3, -2, -1, 0,
+                                                          1, 2, 3, 4, 5, 6, 7, 8),
+                                        _mm256_set1_epi16(b));
+        row_16x16b = _mm256_add_epi16(row_16x16b, _mm256_set1_epi16(a - c * 7 + 16));
+
+        for(rows = 0; rows < 16; rows += 2)
+        {
+            res1_16x16b = _mm256_srai_epi16(row_16x16b, 5);
+            res2_16x16b = _mm256_srai_epi16(_mm256_add_epi16(row_16x16b, c_16x16b), 5);
+
+            res_32x8b = _mm256_packus_epi16(res1_16x16b, res2_16x16b);
+            res_32x8b = _mm256_permute4x64_epi64(res_32x8b, 0xD8);
+
+            _mm_storeu_si128((__m128i *)pu1_dst, _mm256_castsi256_si128(res_32x8b));
+            _mm_storeu_si128((__m128i *)(pu1_dst + dst_strd),
+                             _mm256_extracti128_si256(res_32x8b, 1));
+
+            row_16x16b = _mm256_add_epi16(row_16x16b, c2_16x16b);
+            pu1_dst += dst_strd << 1;
+        }
+    }
+}
@@ -114,6 +114,7 @@
  *
  *******************************************************************************
  */
+ATTRIBUTE_SSSE3
 void ih264_intra_pred_luma_4x4_mode_vert_ssse3(UWORD8 *pu1_src,
                                                UWORD8 *pu1_dst,
                                                WORD32 src_strd,
@@ -173,6 +174,7 @@ void ih264_intra_pred_luma_4x4_mode_vert_ssse3(UWORD8 *pu1_src,
  *
  *******************************************************************************
  */
+ATTRIBUTE_SSSE3
 void ih264_intra_pred_luma_4x4_mode_horz_ssse3(UWORD8 *pu1_src,
                                                UWORD8 *pu1_dst,
                                                WORD32 src_strd,
@@ -238,6 +240,7 @@ void ih264_intra_pred_luma_4x4_mode_horz_ssse3(UWORD8 *pu1_src,
  *  None
  *
  *******************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_intra_pred_luma_4x4_mode_dc_ssse3(UWORD8 *pu1_src,
                                              UWORD8 *pu1_dst,
                                              WORD32 src_strd,
@@ -316,6 +319,7 @@ void ih264_intra_pred_luma_4x4_mode_dc_ssse3(UWORD8 *pu1_src,
  *  None
  *
  *******************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_intra_pred_luma_4x4_mode_diag_dl_ssse3(UWORD8 *pu1_src,
                                                   UWORD8 *pu1_dst,
                                                   WORD32 src_strd,
@@ -400,6 +404,7 @@ void ih264_intra_pred_luma_4x4_mode_diag_dl_ssse3(UWORD8 *pu1_src,
  *  None
  *
  *******************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_intra_pred_luma_4x4_mode_diag_dr_ssse3(UWORD8 *pu1_src,
                                                   UWORD8 *pu1_dst,
                                                   WORD32 src_strd,
@@ -487,6 +492,7 @@ void ih264_intra_pred_luma_4x4_mode_diag_dr_ssse3(UWORD8 *pu1_src,
  *  None
  *
  *******************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_intra_pred_luma_4x4_mode_vert_r_ssse3(UWORD8 *pu1_src,
                                                  UWORD8 *pu1_dst,
                                                  WORD32 src_strd,
@@ -579,6 +585,7 @@ void ih264_intra_pred_luma_4x4_mode_vert_r_ssse3(UWORD8 *pu1_src,
  *  None
  *
  *******************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_intra_pred_luma_4x4_mode_horz_d_ssse3(UWORD8 *pu1_src,
                                            UWORD8 *pu1_dst,
                                            WORD32 src_strd,
@@ -675,6 +682,7 @@ void ih264_intra_pred_luma_4x4_mode_horz_d_ssse3(UWORD8 *pu1_src,
  *  None
  *
  *******************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_intra_pred_luma_4x4_mode_vert_l_ssse3(UWORD8 *pu1_src,
                                                  UWORD8 *pu1_dst,
                                                  WORD32 src_strd,
@@ -764,6 +772,7 @@ void ih264_intra_pred_luma_4x4_mode_vert_l_ssse3(UWORD8 *pu1_src,
  *  None
  *
  *******************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_intra_pred_luma_4x4_mode_horz_u_ssse3(UWORD8 *pu1_src,
                                                  UWORD8 *pu1_dst,
                                                  WORD32 src_strd,
@@ -864,6 +873,7 @@ void ih264_intra_pred_luma_4x4_mode_horz_u_ssse3(UWORD8 *pu1_src,
  *
  *******************************************************************************
  */
+ATTRIBUTE_SSSE3
 void ih264_intra_pred_luma_8x8_mode_vert_ssse3(UWORD8 *pu1_src,
                                                UWORD8 *pu1_dst,
                                                WORD32 src_strd,
@@ -921,6 +931,7 @@ void ih264_intra_pred_luma_8x8_mode_vert_ssse3(UWORD8 *pu1_src,
  *
  *******************************************************************************
  */
+ATTRIBUTE_SSSE3
 void ih264_intra_pred_luma_8x8_mode_horz_ssse3(UWORD8 *pu1_src,
                                                UWORD8 *pu1_dst,
                                                WORD32 src_strd,
@@ -985,6 +996,7 @@ void ih264_intra_pred_luma_8x8_mode_horz_ssse3(UWORD8 *pu1_src,
  *  None
  *
  *******************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_intra_pred_luma_8x8_mode_dc_ssse3(UWORD8 *pu1_src,
                                              UWORD8 *pu1_dst,
                                              WORD32 src_strd,
@@ -1078,6 +1090,7 @@ void ih264_intra_pred_luma_8x8_mode_dc_ssse3(UWORD8 *pu1_src,
  *  None
  *
  *******************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_intra_pred_luma_8x8_mode_diag_dl_ssse3(UWORD8 *pu1_src,
                                                   UWORD8 *pu1_dst,
                                                   WORD32 src_strd,
@@ -1176,6 +1189,7 @@ void ih264_intra_pred_luma_8x8_mode_diag_dl_ssse3(UWORD8 *pu1_src,
  *  None
  *
  *******************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_intra_pred_luma_8x8_mode_diag_dr_ssse3(UWORD8 *pu1_src,
                                                   UWORD8 *pu1_dst,
                                                   WORD32 src_strd,
@@ -1278,6 +1292,7 @@ void ih264_intra_pred_luma_8x8_mode_diag_dr_ssse3(UWORD8 *pu1_src,
  *  None
  *
  *******************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_intra_pred_luma_8x8_mode_vert_r_ssse3(UWORD8 *pu1_src,
                                                  UWORD8 *pu1_dst,
                                                  WORD32 src_strd,
@@ -1398,6 +1413,7 @@ void ih264_intra_pred_luma_8x8_mode_vert_r_ssse3(UWORD8 *pu1_src,
  *  None
  *
  *******************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_intra_pred_luma_8x8_mode_horz_d_ssse3(UWORD8 *pu1_src,
                                                  UWORD8 *pu1_dst,
                                                  WORD32 src_strd,
@@ -1502,6 +1518,7 @@ void ih264_intra_pred_luma_8x8_mode_horz_d_ssse3(UWORD8 *pu1_src,
  *
  *******************************************************************************/
 
+ATTRIBUTE_SSSE3
 void ih264_intra_pred_luma_8x8_mode_vert_l_ssse3(UWORD8 *pu1_src,
                                                  UWORD8 *pu1_dst,
                                                  WORD32 src_strd,
@@ -1598,6 +1615,7 @@ void ih264_intra_pred_luma_8x8_mode_vert_l_ssse3(UWORD8 *pu1_src,
  *  None
  *
  *******************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_intra_pred_luma_8x8_mode_horz_u_ssse3(UWORD8 *pu1_src,
                                                  UWORD8 *pu1_dst,
                                                  WORD32 src_strd,
@@ -1699,6 +1717,7 @@ void ih264_intra_pred_luma_8x8_mode_horz_u_ssse3(UWORD8 *pu1_src,
  *  None
  *
  *******************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_intra_pred_luma_16x16_mode_vert_ssse3(UWORD8 *pu1_src,
                                                  UWORD8 *pu1_dst,
                                                  WORD32 src_strd,
@@ -1778,6 +1797,7 @@ void ih264_intra_pred_luma_16x16_mode_vert_ssse3(UWORD8 *pu1_src,
  *  None
  *
  *******************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_intra_pred_luma_16x16_mode_horz_ssse3(UWORD8 *pu1_src,
                                                  UWORD8 *pu1_dst,
                                                  WORD32 src_strd,
@@ -1875,6 +1895,7 @@ void ih264_intra_pred_luma_16x16_mode_horz_ssse3(UWORD8 *pu1_src,
  *  None
  *
  *******************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_intra_pred_luma_16x16_mode_dc_ssse3(UWORD8 *pu1_src,
                                                UWORD8 *pu1_dst,
                                                WORD32 src_strd,
@@ -1998,6 +2019,7 @@ void ih264_intra_pred_luma_16x16_mode_dc_ssse3(UWORD8 *pu1_src,
  *  None
  *
  *******************************************************************************/
+ATTRIBUTE_SSSE3
 void ih264_intra_pred_luma_16x16_mode_plane_ssse3(UWORD8 *pu1_src,
                                                   UWORD8 *pu1_dst,
                                                   WORD32 src_strd,
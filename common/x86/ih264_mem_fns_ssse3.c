@@ -47,6 +47,7 @@
 
 #include "ih264_typedefs.h"
 #include "ih264_mem_fns.h"
+#include "ih264_platform_macros.h"
 
 #include <immintrin.h>
 
@@ -78,6 +79,7 @@
 
 
 
+ATTRIBUTE_SSSE3
 void ih264_memcpy_mul_8_ssse3(UWORD8 *pu1_dst, UWORD8 *pu1_src, UWORD32 num_bytes)
 {
     int col;
@@ -117,6 +119,7 @@ void ih264_memcpy_mul_8_ssse3(UWORD8 *pu1_dst, UWORD8 *pu1_src, UWORD32 num_byte
  */
 
 
+ATTRIBUTE_SSSE3
 void ih264_memset_mul_8_ssse3(UWORD8 *pu1_dst, UWORD8 value, UWORD32 num_bytes)
 {
     int col;
@@ -155,6 +158,7 @@ void ih264_memset_mul_8_ssse3(UWORD8 *pu1_dst, UWORD8 value, UWORD32 num_bytes)
  */
 
 
+ATTRIBUTE_SSSE3
 void ih264_memset_16bit_mul_8_ssse3(UWORD16 *pu2_dst, UWORD16 value, UWORD32 num_words)
 {
     int col;
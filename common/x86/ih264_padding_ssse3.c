@@ -89,6 +89,7 @@
 *******************************************************************************
 */
 
+ATTRIBUTE_SSSE3
 void ih264_pad_left_luma_ssse3(UWORD8 *pu1_src,
                                WORD32 src_strd,
                                WORD32 ht,
@@ -156,6 +157,7 @@ void ih264_pad_left_luma_ssse3(UWORD8 *pu1_src,
 *******************************************************************************
 */
 
+ATTRIBUTE_SSSE3
 void ih264_pad_left_chroma_ssse3(UWORD8 *pu1_src,
                                  WORD32 src_strd,
                                  WORD32 ht,
@@ -222,6 +224,7 @@ void ih264_pad_left_chroma_ssse3(UWORD8 *pu1_src,
 *******************************************************************************
 */
 
+ATTRIBUTE_SSSE3
 void ih264_pad_right_luma_ssse3(UWORD8 *pu1_src,
                                 WORD32 src_strd,
                                 WORD32 ht,
@@ -289,6 +292,7 @@ void ih264_pad_right_luma_ssse3(UWORD8 *pu1_src,
 *******************************************************************************
 */
 
+ATTRIBUTE_SSSE3
 void ih264_pad_right_chroma_ssse3(UWORD8 *pu1_src,
                                   WORD32 src_strd,
                                   WORD32 ht,
@@ -107,4 +107,13 @@ static __inline UWORD32 CTZ(UWORD32 u4_word)
 #define MEM_ALIGN16 __attribute__ ((aligned (16)))
 #define MEM_ALIGN32 __attribute__ ((aligned (32)))
 
+/* SSSE3 and SSE4.2 kernels are compiled per function so that only the */
+/* ISA specific sources require these extensions                       */
+#define ATTRIBUTE_SSSE3 __attribute__ ((target ("ssse3")))
+#define ATTRIBUTE_SSE42 __attribute__ ((target ("sse4.2")))
+
+/* AVX2 kernels are compiled per function so that the library as a whole */
+/* can still run on processors without AVX2 support                      */
+#define ATTRIBUTE_AVX2 __attribute__ ((target ("avx2")))
+
 #endif /* _IH264_PLATFORM_MACROS_H_ */
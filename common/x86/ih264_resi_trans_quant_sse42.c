@@ -50,6 +50,7 @@
 #include "ih264_trans_data.h"
 #include "ih264_structs.h"
 #include "ih264_trans_quant_itrans_iquant.h"
+#include "ih264_platform_macros.h"
 #include <immintrin.h>
 /**
  *******************************************************************************
@@ -103,6 +104,7 @@
  *
  *******************************************************************************
  */
+ATTRIBUTE_SSE42
 void ih264_resi_trans_quant_4x4_sse42(UWORD8 *pu1_src, UWORD8 *pu1_pred,
                                       WORD16 *pi2_out, WORD32 src_strd, WORD32 pred_strd,
                                       const UWORD16 *pu2_scale_matrix, const UWORD16 *pu2_threshold_matrix,
@@ -376,6 +378,7 @@ void ih264_resi_trans_quant_4x4_sse42(UWORD8 *pu1_src, UWORD8 *pu1_pred,
  *
  *******************************************************************************
  */
+ATTRIBUTE_SSE42
 void ih264_resi_trans_quant_chroma_4x4_sse42(UWORD8 *pu1_src,UWORD8 *pu1_pred,WORD16 *pi2_out,
                                             WORD32 src_strd,WORD32 pred_strd,
                                             const UWORD16 *pu2_scale_matrix,
@@ -663,6 +666,7 @@ void ih264_resi_trans_quant_chroma_4x4_sse42(UWORD8 *pu1_src,UWORD8 *pu1_pred,WO
  *
  */
 
+ATTRIBUTE_SSE42
 void ih264_hadamard_quant_4x4_sse42(WORD16 *pi2_src, WORD16 *pi2_dst,
                           const UWORD16 *pu2_scale_matrix,
                           const UWORD16 *pu2_threshold_matrix, UWORD32 u4_qbits,
@@ -892,6 +896,7 @@ void ih264_hadamard_quant_4x4_sse42(WORD16 *pi2_src, WORD16 *pi2_dst,
  *
  */
 
+ATTRIBUTE_SSE42
 void ih264_hadamard_quant_2x2_uv_sse42(WORD16 *pi2_src, WORD16 *pi2_dst,
                             const UWORD16 *pu2_scale_matrix,
                             const UWORD16 *pu2_threshold_matrix, UWORD32 u4_qbits,
@@ -82,6 +82,7 @@
 /*                      Senthoor                                             */
 /*                                                                           */
 /*****************************************************************************/
+ATTRIBUTE_SSE42
 void ih264_default_weighted_pred_luma_sse42(UWORD8 *pu1_src1,
                                             UWORD8 *pu1_src2,
                                             UWORD8 *pu1_dst,
@@ -245,6 +246,7 @@ void ih264_default_weighted_pred_luma_sse42(UWORD8 *pu1_src1,
 /*                      Senthoor                                             */
 /*                                                                           */
 /*****************************************************************************/
+ATTRIBUTE_SSE42
 void ih264_default_weighted_pred_chroma_sse42(UWORD8 *pu1_src1,
                                               UWORD8 *pu1_src2,
                                               UWORD8 *pu1_dst,
@@ -375,6 +377,7 @@ void ih264_default_weighted_pred_chroma_sse42(UWORD8 *pu1_src1,
 /*                      Senthoor                                             */
 /*                                                                           */
 /*****************************************************************************/
+ATTRIBUTE_SSE42
 void ih264_weighted_pred_luma_sse42(UWORD8 *pu1_src,
                                     UWORD8 *pu1_dst,
                                     WORD32 src_strd,
@@ -605,6 +608,7 @@ void ih264_weighted_pred_luma_sse42(UWORD8 *pu1_src,
 /*                      Senthoor                                             */
 /*                                                                           */
 /*****************************************************************************/
+ATTRIBUTE_SSE42
 void ih264_weighted_pred_chroma_sse42(UWORD8 *pu1_src,
                                       UWORD8 *pu1_dst,
                                       WORD32 src_strd,
@@ -814,6 +818,7 @@ void ih264_weighted_pred_chroma_sse42(UWORD8 *pu1_src,
 /*                      Senthoor                                             */
 /*                                                                           */
 /*****************************************************************************/
+ATTRIBUTE_SSE42
 void ih264_weighted_bi_pred_luma_sse42(UWORD8 *pu1_src1,
                                        UWORD8 *pu1_src2,
                                        UWORD8 *pu1_dst,
@@ -1101,6 +1106,7 @@ void ih264_weighted_bi_pred_luma_sse42(UWORD8 *pu1_src1,
 /*                      Senthoor                                             */
 /*                                                                           */
 /*****************************************************************************/
+ATTRIBUTE_SSE42
 void ih264_weighted_bi_pred_chroma_sse42(UWORD8 *pu1_src1,
                                          UWORD8 *pu1_src2,
                                          UWORD8 *pu1_dst,
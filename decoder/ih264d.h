@@ -108,6 +108,38 @@ typedef struct{
 
 typedef struct {
     ivd_create_ip_t                         s_ivd_create_ip_t;
+
+    /**
+     * Size internal buffers for the active SPS and a single decode thread
+     * instead of the worst case. Read only when u4_size covers this field
+     */
+    UWORD32                                 u4_enable_compact_mem;
+
+    /**
+     * Convert to the output format from the deblocking loop while rows are
+     * still in cache. Takes effect in IVD_DECODE_FRAME_OUT mode for frame
+     * pictures. Read only when u4_size covers this field
+     */
+    UWORD32                                 u4_enable_fused_fmt_conv;
+
+    /**
+     * Return IV_YUV_420SP_UV output as a handle to the decoded picture
+     * instead of copying it. Each displayed picture is held by the
+     * application until released with IVD_CMD_REL_DISPLAY_FRAME, further
+     * holders are added with IH264D_CMD_CTL_ADDREF_DISP_HANDLE. Ignored
+     * with shared display buffers. Read only when u4_size covers this field
+     */
+    UWORD32                                 u4_enable_disp_handles;
+
+    /**
+     * Largest resolution expected in the stream. When both are non-zero,
+     * resolution dependent buffers are carved from a pool sized for this
+     * resolution and recycled across resolution changes and resets instead
+     * of being freed and allocated again. Read only when u4_size covers
+     * these fields
+     */
+    UWORD32                                 u4_buf_pool_max_wd;
+    UWORD32                                 u4_buf_pool_max_ht;
 }ih264d_create_ip_t;
 
 
@@ -187,12 +219,30 @@ typedef enum {
     /** Set processor details */
     IH264D_CMD_CTL_SET_PROCESSOR         = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x001,
 
+    /** Set YUV to RGB conversion matrix and range */
+    IH264D_CMD_CTL_SET_COLOR_CONV        = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x002,
+
+    /** Set downscaling applied to the output */
+    IH264D_CMD_CTL_SET_OUTPUT_SCALE      = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x003,
+
+    /** Add a holder to a display handle */
+    IH264D_CMD_CTL_ADDREF_DISP_HANDLE    = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x004,
+
+    /** Drop buffered pictures before decoding from a new position */
+    IH264D_CMD_CTL_SEEK                  = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x005,
+
+    /** Decode a batch of access units in one call */
+    IH264D_CMD_CTL_DECODE_BATCH          = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x006,
+
     /** Get display buffer dimensions */
     IH264D_CMD_CTL_GET_BUFFER_DIMENSIONS = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x100,
 
     /** Get VUI parameters */
     IH264D_CMD_CTL_GET_VUI_PARAMS        = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x101,
 
+    /** Get memory held by the decoder */
+    IH264D_CMD_CTL_GET_MEM_FOOTPRINT     = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x102,
+
     /** Enable/disable GPU, supported on select platforms */
     IH264D_CMD_CTL_GPU_ENABLE_DISABLE    = IVD_CMD_CTL_CODEC_SUBCMD_START + 0x200,
 
@@ -429,6 +479,164 @@ typedef struct{
     UWORD32                                     u4_buffer_ht[3];
 }ih264d_ctl_get_frame_dimensions_op_t;
 
+typedef struct{
+    UWORD32                                     u4_size;
+    IVD_API_COMMAND_TYPE_T                      e_cmd;
+    IVD_CONTROL_API_COMMAND_TYPE_T              e_sub_cmd;
+}ih264d_ctl_get_mem_footprint_ip_t;
+
+
+typedef struct{
+    UWORD32                                     u4_size;
+    UWORD32                                     u4_error_code;
+
+    /**
+     * Bytes allocated at create, independent of the stream
+     */
+    UWORD32                                     u4_static_mem_size;
+
+    /**
+     * Bytes allocated for the active SPS, including picture buffers
+     */
+    UWORD32                                     u4_dynamic_mem_size;
+}ih264d_ctl_get_mem_footprint_op_t;
+
+typedef enum {
+    /** Coefficients used by earlier releases, luma is not range expanded */
+    IH264D_CSC_DEFAULT                          = 0x0,
+
+    /** ITU-R BT.601 */
+    IH264D_CSC_BT601                            = 0x1,
+
+    /** ITU-R BT.709 */
+    IH264D_CSC_BT709                            = 0x2,
+
+    /** Matrix and range signalled in VUI, BT.601 limited range if absent */
+    IH264D_CSC_FROM_VUI                         = 0x3
+}IH264D_CSC_MATRIX_T;
+
+typedef struct{
+    UWORD32                                     u4_size;
+    IVD_API_COMMAND_TYPE_T                      e_cmd;
+    IVD_CONTROL_API_COMMAND_TYPE_T              e_sub_cmd;
+
+    /**
+     * Matrix used for RGB outputs, one of IH264D_CSC_MATRIX_T
+     */
+    UWORD32                                     u4_csc_matrix;
+
+    /**
+     * 1 : YUV samples use the full 0-255 range
+     * 0 : YUV samples use the 16-235 (luma) / 16-240 (chroma) range
+     * Ignored for IH264D_CSC_DEFAULT and IH264D_CSC_FROM_VUI
+     */
+    UWORD32                                     u4_full_range;
+}ih264d_ctl_set_color_conv_ip_t;
+
+typedef struct{
+    UWORD32                                     u4_size;
+    UWORD32                                     u4_error_code;
+}ih264d_ctl_set_color_conv_op_t;
+
+typedef enum {
+    /** Average of all samples in the decimated block */
+    IH264D_SCALE_FILTER_BOX                     = 0x0,
+
+    /** Bilinear sample at the centre of the decimated block */
+    IH264D_SCALE_FILTER_BILINEAR                = 0x1
+}IH264D_SCALE_FILTER_T;
+
+typedef struct{
+    UWORD32                                     u4_size;
+    IVD_API_COMMAND_TYPE_T                      e_cmd;
+    IVD_CONTROL_API_COMMAND_TYPE_T              e_sub_cmd;
+
+    /**
+     * Output width and height are divided by (1 << u4_scale_shift)
+     * 0 : full size, 1 : 1/2, 2 : 1/4, 3 : 1/8
+     * Not supported with shared display buffers
+     */
+    UWORD32                                     u4_scale_shift;
+
+    /**
+     * One of IH264D_SCALE_FILTER_T
+     */
+    UWORD32                                     u4_scale_filter;
+}ih264d_ctl_set_output_scale_ip_t;
+
+typedef struct{
+    UWORD32                                     u4_size;
+    UWORD32                                     u4_error_code;
+}ih264d_ctl_set_output_scale_op_t;
+
+typedef struct{
+    UWORD32                                     u4_size;
+    IVD_API_COMMAND_TYPE_T                      e_cmd;
+    IVD_CONTROL_API_COMMAND_TYPE_T              e_sub_cmd;
+
+    /**
+     * u4_disp_buf_id of a picture returned by the decoder and not yet
+     * released by all its holders
+     */
+    UWORD32                                     u4_disp_buf_id;
+}ih264d_ctl_addref_disp_handle_ip_t;
+
+typedef struct{
+    UWORD32                                     u4_size;
+    UWORD32                                     u4_error_code;
+}ih264d_ctl_addref_disp_handle_op_t;
+
+/**
+ * Drops the DPB and the pictures queued for display, which are not
+ * returned. Parameter sets, buffers and settings are kept, so decoding
+ * resumes from the next IDR without the cost of a reset. Display handles
+ * held by the application stay valid
+ */
+typedef struct{
+    UWORD32                                     u4_size;
+    IVD_API_COMMAND_TYPE_T                      e_cmd;
+    IVD_CONTROL_API_COMMAND_TYPE_T              e_sub_cmd;
+}ih264d_ctl_seek_ip_t;
+
+typedef struct{
+    UWORD32                                     u4_size;
+    UWORD32                                     u4_error_code;
+}ih264d_ctl_seek_op_t;
+
+/**
+ * Decodes u4_num_au access units back to back. Each entry of
+ * ps_decode_ip / ps_decode_op is set up and filled in exactly as for
+ * IVD_CMD_VIDEO_DECODE; the structures are validated once for the whole
+ * batch. An entry after the first one whose pv_stream_buffer is NULL
+ * continues from where the previous entry stopped, with the remaining bytes
+ * of the previous entry; the pointer and size are filled in by the decoder.
+ * Decoding stops early on a fatal error, a resolution change or when a
+ * chained entry has no bytes left, u4_num_au_done tells how many entries
+ * were processed. The decode threads are kept alive across the batch
+ */
+typedef struct{
+    UWORD32                                     u4_size;
+    IVD_API_COMMAND_TYPE_T                      e_cmd;
+    IVD_CONTROL_API_COMMAND_TYPE_T              e_sub_cmd;
+
+    /** Number of entries in ps_decode_ip and ps_decode_op */
+    UWORD32                                     u4_num_au;
+
+    /** Decode inputs, one per access unit */
+    ih264d_video_decode_ip_t                    *ps_decode_ip;
+
+    /** Decode outputs, one per access unit */
+    ih264d_video_decode_op_t                    *ps_decode_op;
+}ih264d_ctl_decode_batch_ip_t;
+
+typedef struct{
+    UWORD32                                     u4_size;
+    UWORD32                                     u4_error_code;
+
+    /** Number of entries of the batch that were decoded */
+    UWORD32                                     u4_num_au_done;
+}ih264d_ctl_decode_batch_op_t;
+
 #ifdef __cplusplus
 } /* closing brace for extern "C" */
 #endif
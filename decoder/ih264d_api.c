@@ -46,6 +46,11 @@
 /*          ih264d_set_degrade                                               */
 /*          ih264d_get_frame_dimensions                                      */
 /*          ih264d_set_num_cores                                             */
+/*          ih264d_set_color_conv                                            */
+/*          ih264d_set_output_scale                                          */
+/*          ih264d_addref_disp_handle                                        */
+/*          ih264d_seek                                                      */
+/*          ih264d_decode_batch                                              */
 /*          ih264d_fill_output_struct_from_context                           */
 /*          ih264d_api_function                                              */
 /*                                                                           */
@@ -119,7 +124,9 @@
 #define MIN_IN_BUFS             1
 #define MIN_OUT_BUFS_420        3
 #define MIN_OUT_BUFS_422ILE     1
+#define MIN_OUT_BUFS_422P       3
 #define MIN_OUT_BUFS_RGB565     1
+#define MIN_OUT_BUFS_RGBA8888   1
 #define MIN_OUT_BUFS_420SP      2
 
 #define NUM_FRAMES_LIMIT_ENABLED 0
@@ -136,12 +143,29 @@ WORD32 ih264d_get_frame_dimensions(iv_obj_t *dec_hdl,
                                    void *pv_api_ip,
                                    void *pv_api_op);
 WORD32 ih264d_set_num_cores(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op);
+WORD32 ih264d_get_mem_footprint(iv_obj_t *dec_hdl,
+                                void *pv_api_ip,
+                                void *pv_api_op);
+WORD32 ih264d_set_color_conv(iv_obj_t *dec_hdl,
+                             void *pv_api_ip,
+                             void *pv_api_op);
+WORD32 ih264d_set_output_scale(iv_obj_t *dec_hdl,
+                               void *pv_api_ip,
+                               void *pv_api_op);
+WORD32 ih264d_addref_disp_handle(iv_obj_t *dec_hdl,
+                                 void *pv_api_ip,
+                                 void *pv_api_op);
+WORD32 ih264d_seek(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op);
+WORD32 ih264d_decode_batch(iv_obj_t *dec_hdl,
+                           void *pv_api_ip,
+                           void *pv_api_op);
 
 WORD32 ih264d_deblock_display(dec_struct_t *ps_dec);
 
 void ih264d_signal_decode_thread(dec_struct_t *ps_dec);
 
 void ih264d_signal_bs_deblk_thread(dec_struct_t *ps_dec);
+void ih264d_stop_threads(dec_struct_t *ps_dec);
 void ih264d_decode_picture_thread(dec_struct_t *ps_dec);
 
 WORD32 ih264d_set_degrade(iv_obj_t *ps_codec_obj,
@@ -252,10 +276,14 @@ static IV_API_CALL_STATUS_T api_check_struct_sanity(iv_obj_t *ps_handle,
 
 
             if((ps_ip->s_ivd_create_ip_t.e_output_format != IV_YUV_420P)
+                            && (ps_ip->s_ivd_create_ip_t.e_output_format
+                                            != IV_YUV_422P)
                             && (ps_ip->s_ivd_create_ip_t.e_output_format
                                             != IV_YUV_422ILE)
                             && (ps_ip->s_ivd_create_ip_t.e_output_format
                                             != IV_RGB_565)
+                            && (ps_ip->s_ivd_create_ip_t.e_output_format
+                                            != IV_RGBA_8888)
                             && (ps_ip->s_ivd_create_ip_t.e_output_format
                                             != IV_YUV_420SP_UV)
                             && (ps_ip->s_ivd_create_ip_t.e_output_format
@@ -744,6 +772,229 @@ static IV_API_CALL_STATUS_T api_check_struct_sanity(iv_obj_t *ps_handle,
                     break;
                 }
 
+                case IH264D_CMD_CTL_GET_MEM_FOOTPRINT:
+                {
+                    ih264d_ctl_get_mem_footprint_ip_t *ps_ip;
+                    ih264d_ctl_get_mem_footprint_op_t *ps_op;
+
+                    ps_ip = (ih264d_ctl_get_mem_footprint_ip_t *)pv_api_ip;
+                    ps_op = (ih264d_ctl_get_mem_footprint_op_t *)pv_api_op;
+
+                    if(ps_ip->u4_size
+                                    != sizeof(ih264d_ctl_get_mem_footprint_ip_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |=
+                                        IVD_IP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    if(ps_op->u4_size
+                                    != sizeof(ih264d_ctl_get_mem_footprint_op_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |=
+                                        IVD_OP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    break;
+                }
+
+                case IH264D_CMD_CTL_SET_COLOR_CONV:
+                {
+                    ih264d_ctl_set_color_conv_ip_t *ps_ip;
+                    ih264d_ctl_set_color_conv_op_t *ps_op;
+
+                    ps_ip = (ih264d_ctl_set_color_conv_ip_t *)pv_api_ip;
+                    ps_op = (ih264d_ctl_set_color_conv_op_t *)pv_api_op;
+
+                    if(ps_ip->u4_size
+                                    != sizeof(ih264d_ctl_set_color_conv_ip_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |=
+                                        IVD_IP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    if(ps_op->u4_size
+                                    != sizeof(ih264d_ctl_set_color_conv_op_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |=
+                                        IVD_OP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    if(ps_ip->u4_csc_matrix > IH264D_CSC_FROM_VUI)
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        return IV_FAIL;
+                    }
+                    break;
+                }
+
+                case IH264D_CMD_CTL_SET_OUTPUT_SCALE:
+                {
+                    ih264d_ctl_set_output_scale_ip_t *ps_ip;
+                    ih264d_ctl_set_output_scale_op_t *ps_op;
+
+                    ps_ip = (ih264d_ctl_set_output_scale_ip_t *)pv_api_ip;
+                    ps_op = (ih264d_ctl_set_output_scale_op_t *)pv_api_op;
+
+                    if(ps_ip->u4_size
+                                    != sizeof(ih264d_ctl_set_output_scale_ip_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |=
+                                        IVD_IP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    if(ps_op->u4_size
+                                    != sizeof(ih264d_ctl_set_output_scale_op_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |=
+                                        IVD_OP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    if((ps_ip->u4_scale_shift > MAX_OUT_SCALE_SHIFT)
+                                    || (ps_ip->u4_scale_filter
+                                                    > IH264D_SCALE_FILTER_BILINEAR))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        return IV_FAIL;
+                    }
+                    break;
+                }
+
+                case IH264D_CMD_CTL_ADDREF_DISP_HANDLE:
+                {
+                    ih264d_ctl_addref_disp_handle_ip_t *ps_ip;
+                    ih264d_ctl_addref_disp_handle_op_t *ps_op;
+
+                    ps_ip = (ih264d_ctl_addref_disp_handle_ip_t *)pv_api_ip;
+                    ps_op = (ih264d_ctl_addref_disp_handle_op_t *)pv_api_op;
+
+                    if(ps_ip->u4_size
+                                    != sizeof(ih264d_ctl_addref_disp_handle_ip_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |=
+                                        IVD_IP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    if(ps_op->u4_size
+                                    != sizeof(ih264d_ctl_addref_disp_handle_op_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |=
+                                        IVD_OP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    if(ps_ip->u4_disp_buf_id >= MAX_DISP_BUFS_NEW)
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        return IV_FAIL;
+                    }
+                    break;
+                }
+
+                case IH264D_CMD_CTL_SEEK:
+                {
+                    ih264d_ctl_seek_ip_t *ps_ip;
+                    ih264d_ctl_seek_op_t *ps_op;
+
+                    ps_ip = (ih264d_ctl_seek_ip_t *)pv_api_ip;
+                    ps_op = (ih264d_ctl_seek_op_t *)pv_api_op;
+
+                    if(ps_ip->u4_size != sizeof(ih264d_ctl_seek_ip_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |=
+                                        IVD_IP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    if(ps_op->u4_size != sizeof(ih264d_ctl_seek_op_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |=
+                                        IVD_OP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+                    break;
+                }
+
+                case IH264D_CMD_CTL_DECODE_BATCH:
+                {
+                    ih264d_ctl_decode_batch_ip_t *ps_ip;
+                    ih264d_ctl_decode_batch_op_t *ps_op;
+                    UWORD32 i;
+
+                    ps_ip = (ih264d_ctl_decode_batch_ip_t *)pv_api_ip;
+                    ps_op = (ih264d_ctl_decode_batch_op_t *)pv_api_op;
+
+                    if(ps_ip->u4_size != sizeof(ih264d_ctl_decode_batch_ip_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |=
+                                        IVD_IP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    if(ps_op->u4_size != sizeof(ih264d_ctl_decode_batch_op_t))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        ps_op->u4_error_code |=
+                                        IVD_OP_API_STRUCT_SIZE_INCORRECT;
+                        return IV_FAIL;
+                    }
+
+                    if((0 == ps_ip->u4_num_au)
+                                    || (NULL == ps_ip->ps_decode_ip)
+                                    || (NULL == ps_ip->ps_decode_op))
+                    {
+                        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                        return IV_FAIL;
+                    }
+
+                    /* Same checks as IVD_CMD_VIDEO_DECODE, done once per batch */
+                    for(i = 0; i < ps_ip->u4_num_au; i++)
+                    {
+                        ivd_video_decode_ip_t *ps_dec_ip =
+                                        &ps_ip->ps_decode_ip[i].s_ivd_video_decode_ip_t;
+                        ivd_video_decode_op_t *ps_dec_op =
+                                        &ps_ip->ps_decode_op[i].s_ivd_video_decode_op_t;
+
+                        if(ps_dec_ip->u4_size != sizeof(ih264d_video_decode_ip_t)
+                                        && ps_dec_ip->u4_size
+                                                        != offsetof(ivd_video_decode_ip_t, s_out_buffer))
+                        {
+                            ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                            ps_op->u4_error_code |=
+                                            IVD_IP_API_STRUCT_SIZE_INCORRECT;
+                            return IV_FAIL;
+                        }
+
+                        if(ps_dec_op->u4_size != sizeof(ih264d_video_decode_op_t)
+                                        && ps_dec_op->u4_size
+                                                        != offsetof(ivd_video_decode_op_t, u4_output_present))
+                        {
+                            ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+                            ps_op->u4_error_code |=
+                                            IVD_OP_API_STRUCT_SIZE_INCORRECT;
+                            return IV_FAIL;
+                        }
+                    }
+                    break;
+                }
+
                 case IH264D_CMD_CTL_SET_NUM_CORES:
                 {
                     ih264d_ctl_set_num_cores_ip_t *ps_ip;
@@ -951,7 +1202,7 @@ void ih264d_init_decoder(void * ps_dec_params)
     ps_dec->u1_pr_sl_type = 0xFF;
     ps_dec->u2_mbx = 0xffff;
     ps_dec->u2_mby = 0;
-    ps_dec->u2_total_mbs_coded = 0;
+    ps_dec->u4_total_mbs_coded = 0;
 
     /* POC initializations */
     ps_prev_poc = &ps_dec->s_prev_pic_poc;
@@ -987,6 +1238,9 @@ void ih264d_init_decoder(void * ps_dec_params)
     ps_dec->u2_crop_offset_y = 0;
     ps_dec->u2_crop_offset_uv = 0;
 
+    /* 4:2:0 until an SPS says otherwise */
+    ps_dec->u1_chroma_ht_shift = 1;
+
     /* The Initial Frame Rate Info is not Present */
     ps_dec->i4_vui_frame_rate = -1;
     ps_dec->i4_pic_type = -1;
@@ -1066,6 +1320,8 @@ void ih264d_init_decoder(void * ps_dec_params)
            (MAX_DISP_BUFS_NEW) * sizeof(UWORD32));
     memset(ps_dec->u4_disp_buf_to_be_freed, 0,
            (MAX_DISP_BUFS_NEW) * sizeof(UWORD32));
+    memset(ps_dec->au4_disp_handle_refs, 0,
+           (MAX_DISP_BUFS_NEW) * sizeof(UWORD32));
 
     ih264d_init_arch(ps_dec);
     ih264d_init_function_ptr(ps_dec);
@@ -1088,6 +1344,18 @@ WORD32 ih264d_free_static_bufs(iv_obj_t *dec_hdl)
     PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->ps_pps);
     PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pv_dec_thread_handle);
     PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pv_bs_deblk_thread_handle);
+    if(ps_dec->pv_dec_thread_start_sem)
+        ithread_sem_destroy(ps_dec->pv_dec_thread_start_sem);
+    if(ps_dec->pv_dec_thread_done_sem)
+        ithread_sem_destroy(ps_dec->pv_dec_thread_done_sem);
+    if(ps_dec->pv_bs_deblk_thread_start_sem)
+        ithread_sem_destroy(ps_dec->pv_bs_deblk_thread_start_sem);
+    if(ps_dec->pv_bs_deblk_thread_done_sem)
+        ithread_sem_destroy(ps_dec->pv_bs_deblk_thread_done_sem);
+    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pv_dec_thread_start_sem);
+    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pv_dec_thread_done_sem);
+    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pv_bs_deblk_thread_start_sem);
+    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pv_bs_deblk_thread_done_sem);
     PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->ps_dpb_mgr);
     PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->ps_pred);
     PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pv_disp_buf_mgr);
@@ -1175,6 +1443,7 @@ WORD32 ih264d_allocate_static_bufs(iv_obj_t **dec_hdl, void *pv_api_ip, void *pv
     ps_dec = (dec_struct_t *)pv_buf;
 
     memset(ps_dec, 0, sizeof(dec_struct_t));
+    ps_dec->u4_static_mem_size = sizeof(iv_obj_t) + sizeof(dec_struct_t);
 
 #ifndef LOGO_EN
     ps_dec->u4_share_disp_buf = ps_create_ip->s_ivd_create_ip_t.u4_share_disp_buf;
@@ -1198,86 +1467,152 @@ WORD32 ih264d_allocate_static_bufs(iv_obj_t **dec_hdl, void *pv_api_ip, void *pv
     ps_dec->pf_aligned_free = pf_aligned_free;
     ps_dec->pv_mem_ctxt = pv_mem_ctxt;
 
+    if(ps_create_ip->s_ivd_create_ip_t.u4_size == sizeof(ih264d_create_ip_t))
+    {
+        ps_dec->u4_compact_mem = ps_create_ip->u4_enable_compact_mem;
+        ps_dec->u4_fused_fmt_conv = ps_create_ip->u4_enable_fused_fmt_conv;
+        ps_dec->u4_disp_handles = ps_create_ip->u4_enable_disp_handles;
+
+        if(ps_create_ip->u4_buf_pool_max_wd && ps_create_ip->u4_buf_pool_max_ht)
+        {
+            ps_dec->u4_buf_pool_max_wd = MIN(ps_create_ip->u4_buf_pool_max_wd,
+                                             H264_MAX_FRAME_WIDTH);
+            ps_dec->u4_buf_pool_max_ht = MIN(ps_create_ip->u4_buf_pool_max_ht,
+                                             H264_MAX_FRAME_HEIGHT);
+        }
+    }
+
+    /* Pictures are reconstructed as 420SP_UV, other formats need a copy */
+    if((1 == ps_dec->u4_share_disp_buf)
+                    || (ps_dec->u1_chroma_format != IV_YUV_420SP_UV))
+    {
+        ps_dec->u4_disp_handles = 0;
+    }
+
 
     size = ((sizeof(dec_seq_params_t)) * MAX_NUM_SEQ_PARAMS);
     pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_static_mem_size += size;
     ps_dec->ps_sps = pv_buf;
 
     size = (sizeof(dec_pic_params_t)) * MAX_NUM_PIC_PARAMS;
     pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_static_mem_size += size;
     ps_dec->ps_pps = pv_buf;
 
     size = ithread_get_handle_size();
     pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_static_mem_size += size;
     ps_dec->pv_dec_thread_handle = pv_buf;
 
     size = ithread_get_handle_size();
     pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_static_mem_size += size;
     ps_dec->pv_bs_deblk_thread_handle = pv_buf;
 
+    size = ithread_get_sem_struct_size();
+    pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
+    RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_static_mem_size += size;
+    ithread_sem_init(pv_buf, 0, 0);
+    ps_dec->pv_dec_thread_start_sem = pv_buf;
+
+    size = ithread_get_sem_struct_size();
+    pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
+    RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_static_mem_size += size;
+    ithread_sem_init(pv_buf, 0, 0);
+    ps_dec->pv_dec_thread_done_sem = pv_buf;
+
+    size = ithread_get_sem_struct_size();
+    pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
+    RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_static_mem_size += size;
+    ithread_sem_init(pv_buf, 0, 0);
+    ps_dec->pv_bs_deblk_thread_start_sem = pv_buf;
+
+    size = ithread_get_sem_struct_size();
+    pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
+    RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_static_mem_size += size;
+    ithread_sem_init(pv_buf, 0, 0);
+    ps_dec->pv_bs_deblk_thread_done_sem = pv_buf;
+
     size = sizeof(dpb_manager_t);
     pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_static_mem_size += size;
     ps_dec->ps_dpb_mgr = pv_buf;
 
     size = sizeof(pred_info_t) * 2 * 32;
     pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_static_mem_size += size;
     ps_dec->ps_pred = pv_buf;
 
     size = sizeof(disp_mgr_t);
     pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_static_mem_size += size;
     ps_dec->pv_disp_buf_mgr = pv_buf;
 
     size = sizeof(buf_mgr_t) + ithread_get_mutex_lock_size();
     pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_static_mem_size += size;
     ps_dec->pv_pic_buf_mgr = pv_buf;
 
     size = sizeof(struct pic_buffer_t) * (H264_MAX_REF_PICS * 2);
     pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_static_mem_size += size;
     ps_dec->ps_pic_buf_base = pv_buf;
 
     size = sizeof(dec_err_status_t);
     pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_static_mem_size += size;
     ps_dec->ps_dec_err_status = (dec_err_status_t *)pv_buf;
 
     size = sizeof(sei);
     pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_static_mem_size += size;
     ps_dec->ps_sei = (sei *)pv_buf;
 
     size = sizeof(dpb_commands_t);
     pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_static_mem_size += size;
     ps_dec->ps_dpb_cmds = (dpb_commands_t *)pv_buf;
 
     size = sizeof(dec_bit_stream_t);
     pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_static_mem_size += size;
     ps_dec->ps_bitstrm = (dec_bit_stream_t *)pv_buf;
 
     size = sizeof(dec_slice_params_t);
     pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_static_mem_size += size;
     ps_dec->ps_cur_slice = (dec_slice_params_t *)pv_buf;
 
     size = MAX(sizeof(dec_seq_params_t), sizeof(dec_pic_params_t));
     pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_static_mem_size += size;
     ps_dec->pv_scratch_sps_pps = pv_buf;
 
 
     ps_dec->u4_static_bits_buf_size = 256000;
     pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, ps_dec->u4_static_bits_buf_size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_static_mem_size += ps_dec->u4_static_bits_buf_size;
     ps_dec->pu1_bits_buf_static = pv_buf;
 
 
@@ -1285,6 +1620,7 @@ WORD32 ih264d_allocate_static_bufs(iv_obj_t **dec_hdl, void *pv_api_ip, void *pv
                         * sizeof(void *));
     pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_static_mem_size += size;
     ps_dec->ppv_map_ref_idx_to_poc_base = pv_buf;
     memset(ps_dec->ppv_map_ref_idx_to_poc_base, 0, size);
 
@@ -1294,6 +1630,7 @@ WORD32 ih264d_allocate_static_bufs(iv_obj_t **dec_hdl, void *pv_api_ip, void *pv
     size = (sizeof(bin_ctxt_model_t) * NUM_CABAC_CTXTS);
     pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_static_mem_size += size;
     ps_dec->p_cabac_ctxt_table_t = pv_buf;
 
 
@@ -1301,6 +1638,7 @@ WORD32 ih264d_allocate_static_bufs(iv_obj_t **dec_hdl, void *pv_api_ip, void *pv
     size = sizeof(ctxt_inc_mb_info_t);
     pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_static_mem_size += size;
     ps_dec->ps_left_mb_ctxt_info = pv_buf;
 
 
@@ -1308,6 +1646,7 @@ WORD32 ih264d_allocate_static_bufs(iv_obj_t **dec_hdl, void *pv_api_ip, void *pv
     size = MAX_REF_BUF_SIZE * 2;
     pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_static_mem_size += size;
     ps_dec->pu1_ref_buff_base = pv_buf;
     ps_dec->pu1_ref_buff = ps_dec->pu1_ref_buff_base + MAX_REF_BUF_SIZE;
 
@@ -1316,12 +1655,14 @@ WORD32 ih264d_allocate_static_bufs(iv_obj_t **dec_hdl, void *pv_api_ip, void *pv
                         * PRED_BUFFER_HEIGHT * 2);
     pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_static_mem_size += size;
     ps_dec->pi2_pred1 = pv_buf;
 
 
     size = sizeof(UWORD8) * (MB_LUM_SIZE);
     pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_static_mem_size += size;
     ps_dec->pu1_temp_mc_buffer = pv_buf;
 
 
@@ -1330,6 +1671,7 @@ WORD32 ih264d_allocate_static_bufs(iv_obj_t **dec_hdl, void *pv_api_ip, void *pv
     size = 8 * MAX_REF_BUFS * sizeof(struct pic_buffer_t);
     pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_static_mem_size += size;
 
     ps_dec->pu1_init_dpb_base = pv_buf;
     pu1_buf = pv_buf;
@@ -1343,30 +1685,35 @@ WORD32 ih264d_allocate_static_bufs(iv_obj_t **dec_hdl, void *pv_api_ip, void *pv
                         << 3;
     pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_static_mem_size += size;
     ps_dec->pu4_mbaff_wt_mat = pv_buf;
 
     size = sizeof(UWORD32) * 2 * 3
                         * (MAX_FRAMES * MAX_FRAMES);
     pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_static_mem_size += size;
     ps_dec->pu4_wts_ofsts_mat = pv_buf;
 
 
     size = (sizeof(neighbouradd_t) << 2);
     pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_static_mem_size += size;
     ps_dec->ps_left_mvpred_addr = pv_buf;
 
 
     size = sizeof(buf_mgr_t) + ithread_get_mutex_lock_size();
     pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_static_mem_size += size;
     ps_dec->pv_mv_buf_mgr = pv_buf;
 
 
     size =  sizeof(col_mv_buf_t) * (H264_MAX_REF_PICS * 2);
     pv_buf = pf_aligned_alloc(pv_mem_ctxt, 128, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_static_mem_size += size;
     ps_dec->ps_col_mv_base = pv_buf;
     memset(ps_dec->ps_col_mv_base, 0, size);
 
@@ -1636,11 +1983,13 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
         ps_dec->ps_out_buffer = &ps_dec_ip->s_out_buffer;
 
     ps_dec->u4_fmt_conv_cur_row = 0;
+    ps_dec->u4_fused_fmt_conv_active = 0;
 
     ps_dec->u4_output_present = 0;
     ps_dec->s_disp_op.u4_error_code = 1;
     ps_dec->u4_fmt_conv_num_rows = FMT_CONV_NUM_ROWS;
     if(0 == ps_dec->u4_share_disp_buf
+                    && 0 == ps_dec->u4_disp_handles
                     && ps_dec->i4_decode_header == 0)
     {
         UWORD32 i;
@@ -1697,6 +2046,27 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
     }
     ps_dec->u4_slice_start_code_found = 0;
 
+    /* Pictures held through display handles come out of the extra buffers */
+    /* allocated for them. Once those are used up, wait for a release      */
+    if(ps_dec->u1_init_dec_flag == 1 && ps_dec->u4_disp_handles == 1
+                    && ps_dec->u1_flushfrm == 0)
+    {
+        UWORD32 i, u4_num_held = 0;
+
+        for(i = 0; i < ps_dec->u1_pic_bufs; i++)
+        {
+            if(ps_dec->au4_disp_handle_refs[i])
+                u4_num_held++;
+        }
+
+        if(u4_num_held > MAX_DISP_HANDLES_HELD)
+        {
+            ps_dec_op->u4_error_code = IVD_DEC_REF_BUF_NULL;
+            ps_dec_op->u4_error_code |= (1 << IVD_UNSUPPORTEDPARAM);
+            return (IV_FAIL);
+        }
+    }
+
     /* In case the deocder is not in flush mode(in shared mode),
      then decoder has to pick up a buffer to write current frame.
      Check if a frame is available in such cases */
@@ -1843,8 +2213,8 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
 
     ps_dec->u4_prev_nal_skipped = 0;
 
-    ps_dec->u2_cur_mb_addr = 0;
-    ps_dec->u2_total_mbs_coded = 0;
+    ps_dec->u4_cur_mb_addr = 0;
+    ps_dec->u4_total_mbs_coded = 0;
     ps_dec->u2_cur_slice_num = 0;
     ps_dec->cur_dec_mb_num = 0;
     ps_dec->cur_recon_mb_num = 0;
@@ -1871,6 +2241,17 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
         u4_max_ofst = ps_dec_ip->u4_num_Bytes
                         - ps_dec_op->u4_num_bytes_consumed;
 
+        /* A buffer kept by the buffer pool from a smaller sequence is
+         * replaced
+         */
+        if((NULL != ps_dec->pu1_bits_buf_dynamic) &&
+           (ps_dec->i4_header_decoded & 1) &&
+           (ps_dec->u4_dynamic_bits_buf_size
+                           < (UWORD32)(ps_dec->u2_pic_wd * ps_dec->u2_pic_ht * 3 / 2)))
+        {
+            PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pu1_bits_buf_dynamic);
+        }
+
         /* If dynamic bitstream buffer is not allocated and
          * header decode is done, then allocate dynamic bitstream buffer
          */
@@ -1882,8 +2263,11 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
             void *pv_buf;
             void *pv_mem_ctxt = ps_dec->pv_mem_ctxt;
             size = MAX(256000, ps_dec->u2_pic_wd * ps_dec->u2_pic_ht * 3 / 2);
+            size = MAX(size, (WORD32)(ps_dec->u4_buf_pool_max_wd
+                            * ps_dec->u4_buf_pool_max_ht * 3 / 2));
             pv_buf = ps_dec->pf_aligned_alloc(pv_mem_ctxt, 128, size);
             RETURN_IF((NULL == pv_buf), IV_FAIL);
+            ps_dec->u4_dynamic_mem_size += size;
             ps_dec->pu1_bits_buf_dynamic = pv_buf;
             ps_dec->u4_dynamic_bits_buf_size = size;
         }
@@ -2074,7 +2458,7 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
 
     if((ps_dec->u4_slice_start_code_found == 1)
             && (ret != IVD_MEM_ALLOC_FAILED)
-            && ps_dec->u2_total_mbs_coded < ps_dec->u2_frm_ht_in_mbs * ps_dec->u2_frm_wd_in_mbs)
+            && ps_dec->u4_total_mbs_coded < ps_dec->u2_frm_ht_in_mbs * ps_dec->u2_frm_wd_in_mbs)
     {
         // last slice - missing/corruption
         WORD32 num_mb_skipped;
@@ -2083,7 +2467,7 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
         WORD32 ret1;
 
         num_mb_skipped = (ps_dec->u2_frm_ht_in_mbs * ps_dec->u2_frm_wd_in_mbs)
-                            - ps_dec->u2_total_mbs_coded;
+                            - ps_dec->u4_total_mbs_coded;
 
         if(ps_dec->u4_first_slice_in_pic && (ps_dec->u4_pic_buf_got == 0))
             prev_slice_err = 1;
@@ -2244,7 +2628,7 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
         /*set to complete ,as we dont support partial frame decode*/
         if(ps_dec->i4_header_decoded == 3)
         {
-            ps_dec->u2_total_mbs_coded = ps_dec->ps_cur_sps->u2_max_mb_addr + 1;
+            ps_dec->u4_total_mbs_coded = ps_dec->ps_cur_sps->u4_max_mb_addr + 1;
         }
 
         /*Update the i4_frametype at the end of picture*/
@@ -2301,7 +2685,20 @@ WORD32 ih264d_video_decode(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
             {
                 ps_dec->u4_fmt_conv_cur_row = 0;
                 ps_dec->u4_output_present = 1;
+
+                /* Rows already written by the deblocking loop need not
+                 * be converted again */
+                if(ps_dec->u4_fused_fmt_conv_active
+                                && (ps_dec->s_disp_op.u4_disp_buf_id
+                                                == ps_dec->u4_fused_fmt_conv_buf_id)
+                                && (ps_dec->s_disp_op.s_disp_frm_buf.u4_y_strd
+                                                == ps_dec->s_fused_disp_op.s_disp_frm_buf.u4_y_strd))
+                {
+                    ps_dec->u4_fmt_conv_cur_row =
+                                    ps_dec->u4_fused_fmt_conv_cur_row;
+                }
             }
+            ps_dec->u4_fused_fmt_conv_active = 0;
         }
 
         ih264d_fill_output_struct_from_context(ps_dec, ps_dec_op);
@@ -2551,6 +2948,7 @@ WORD32 ih264d_get_status(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
     UWORD32 i;
     dec_struct_t * ps_dec;
     UWORD32 pic_wd, pic_ht;
+    UWORD32 in_pic_size;
     ivd_ctl_getstatus_op_t *ps_ctl_op = (ivd_ctl_getstatus_op_t*)pv_api_op;
     UNUSED(pv_api_ip);
     ps_ctl_op->u4_error_code = 0;
@@ -2592,6 +2990,12 @@ WORD32 ih264d_get_status(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
 
     }
 
+    in_pic_size = MAX(pic_wd, ps_dec->u4_app_disp_width) * pic_ht;
+
+    /* Output buffers hold the downscaled picture */
+    pic_wd >>= ps_dec->u4_out_scale_shift;
+    pic_ht >>= ps_dec->u4_out_scale_shift;
+
     if(ps_dec->u4_app_disp_width > pic_wd)
         pic_wd = ps_dec->u4_app_disp_width;
     if(0 == ps_dec->u4_share_disp_buf)
@@ -2638,6 +3042,10 @@ WORD32 ih264d_get_status(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
     {
         ps_ctl_op->u4_min_num_out_bufs = MIN_OUT_BUFS_420;
     }
+    else if(ps_dec->u1_chroma_format == IV_YUV_422P)
+    {
+        ps_ctl_op->u4_min_num_out_bufs = MIN_OUT_BUFS_422P;
+    }
     else if(ps_dec->u1_chroma_format == IV_YUV_422ILE)
     {
         ps_ctl_op->u4_min_num_out_bufs = MIN_OUT_BUFS_422ILE;
@@ -2646,6 +3054,10 @@ WORD32 ih264d_get_status(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
     {
         ps_ctl_op->u4_min_num_out_bufs = MIN_OUT_BUFS_RGB565;
     }
+    else if(ps_dec->u1_chroma_format == IV_RGBA_8888)
+    {
+        ps_ctl_op->u4_min_num_out_bufs = MIN_OUT_BUFS_RGBA8888;
+    }
     else if((ps_dec->u1_chroma_format == IV_YUV_420SP_UV)
                     || (ps_dec->u1_chroma_format == IV_YUV_420SP_VU))
     {
@@ -2661,7 +3073,7 @@ WORD32 ih264d_get_status(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
 
     for(i = 0; i < ps_ctl_op->u4_min_num_in_bufs; i++)
     {
-        ps_ctl_op->u4_min_in_buf_size[i] = MAX(256000, pic_wd * pic_ht * 3 / 2);
+        ps_ctl_op->u4_min_in_buf_size[i] = MAX(256000, in_pic_size * 3 / 2);
     }
 
     /*!*/
@@ -2673,6 +3085,14 @@ WORD32 ih264d_get_status(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
         ps_ctl_op->u4_min_out_buf_size[2] = (pic_wd * pic_ht)
                         >> 2;
     }
+    else if(ps_dec->u1_chroma_format == IV_YUV_422P)
+    {
+        ps_ctl_op->u4_min_out_buf_size[0] = (pic_wd * pic_ht);
+        ps_ctl_op->u4_min_out_buf_size[1] = (pic_wd * pic_ht)
+                        >> 1;
+        ps_ctl_op->u4_min_out_buf_size[2] = (pic_wd * pic_ht)
+                        >> 1;
+    }
     else if(ps_dec->u1_chroma_format == IV_YUV_422ILE)
     {
         ps_ctl_op->u4_min_out_buf_size[0] = (pic_wd * pic_ht)
@@ -2687,6 +3107,13 @@ WORD32 ih264d_get_status(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
         ps_ctl_op->u4_min_out_buf_size[1] =
                         ps_ctl_op->u4_min_out_buf_size[2] = 0;
     }
+    else if(ps_dec->u1_chroma_format == IV_RGBA_8888)
+    {
+        ps_ctl_op->u4_min_out_buf_size[0] = (pic_wd * pic_ht)
+                        * 4;
+        ps_ctl_op->u4_min_out_buf_size[1] =
+                        ps_ctl_op->u4_min_out_buf_size[2] = 0;
+    }
     else if((ps_dec->u1_chroma_format == IV_YUV_420SP_UV)
                     || (ps_dec->u1_chroma_format == IV_YUV_420SP_VU))
     {
@@ -2737,10 +3164,14 @@ WORD32 ih264d_get_buf_info(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
     ps_ctl_op->u4_min_num_in_bufs = MIN_IN_BUFS;
     if(ps_dec->u1_chroma_format == IV_YUV_420P)
         ps_ctl_op->u4_min_num_out_bufs = MIN_OUT_BUFS_420;
+    else if(ps_dec->u1_chroma_format == IV_YUV_422P)
+        ps_ctl_op->u4_min_num_out_bufs = MIN_OUT_BUFS_422P;
     else if(ps_dec->u1_chroma_format == IV_YUV_422ILE)
         ps_ctl_op->u4_min_num_out_bufs = MIN_OUT_BUFS_422ILE;
     else if(ps_dec->u1_chroma_format == IV_RGB_565)
         ps_ctl_op->u4_min_num_out_bufs = MIN_OUT_BUFS_RGB565;
+    else if(ps_dec->u1_chroma_format == IV_RGBA_8888)
+        ps_ctl_op->u4_min_num_out_bufs = MIN_OUT_BUFS_RGBA8888;
     else if((ps_dec->u1_chroma_format == IV_YUV_420SP_UV)
                     || (ps_dec->u1_chroma_format == IV_YUV_420SP_VU))
         ps_ctl_op->u4_min_num_out_bufs = MIN_OUT_BUFS_420SP;
@@ -2778,6 +3209,10 @@ WORD32 ih264d_get_buf_info(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
     {
         ps_ctl_op->u4_min_in_buf_size[i] = MAX(256000, pic_wd * pic_ht * 3 / 2);
     }
+    /* Output buffers hold the downscaled picture */
+    pic_wd >>= ps_dec->u4_out_scale_shift;
+    pic_ht >>= ps_dec->u4_out_scale_shift;
+
     if((WORD32)ps_dec->u4_app_disp_width > pic_wd)
         pic_wd = ps_dec->u4_app_disp_width;
 
@@ -2825,6 +3260,14 @@ WORD32 ih264d_get_buf_info(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
         ps_ctl_op->u4_min_out_buf_size[2] = (pic_wd * pic_ht)
                         >> 2;
     }
+    else if(ps_dec->u1_chroma_format == IV_YUV_422P)
+    {
+        ps_ctl_op->u4_min_out_buf_size[0] = (pic_wd * pic_ht);
+        ps_ctl_op->u4_min_out_buf_size[1] = (pic_wd * pic_ht)
+                        >> 1;
+        ps_ctl_op->u4_min_out_buf_size[2] = (pic_wd * pic_ht)
+                        >> 1;
+    }
     else if(ps_dec->u1_chroma_format == IV_YUV_422ILE)
     {
         ps_ctl_op->u4_min_out_buf_size[0] = (pic_wd * pic_ht)
@@ -2839,6 +3282,13 @@ WORD32 ih264d_get_buf_info(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
         ps_ctl_op->u4_min_out_buf_size[1] =
                         ps_ctl_op->u4_min_out_buf_size[2] = 0;
     }
+    else if(ps_dec->u1_chroma_format == IV_RGBA_8888)
+    {
+        ps_ctl_op->u4_min_out_buf_size[0] = (pic_wd * pic_ht)
+                        * 4;
+        ps_ctl_op->u4_min_out_buf_size[1] =
+                        ps_ctl_op->u4_min_out_buf_size[2] = 0;
+    }
     else if((ps_dec->u1_chroma_format == IV_YUV_420SP_UV)
                     || (ps_dec->u1_chroma_format == IV_YUV_420SP_VU))
     {
@@ -3050,6 +3500,8 @@ WORD32 ih264d_delete(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
     UNUSED(ps_ip);
     ps_op->s_ivd_delete_op_t.u4_error_code = 0;
     ih264d_free_dynamic_bufs(ps_dec);
+    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pu1_bits_buf_dynamic);
+    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pu1_buf_pool);
     ih264d_free_static_bufs(dec_hdl);
     return IV_SUCCESS;
 }
@@ -3177,10 +3629,33 @@ WORD32 ih264d_ctl(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
             ret = ih264d_get_frame_dimensions(dec_hdl, (void *)pv_api_ip,
                                               (void *)pv_api_op);
             break;
+        case IH264D_CMD_CTL_GET_MEM_FOOTPRINT:
+            ret = ih264d_get_mem_footprint(dec_hdl, (void *)pv_api_ip,
+                                           (void *)pv_api_op);
+            break;
         case IH264D_CMD_CTL_SET_PROCESSOR:
             ret = ih264d_set_processor(dec_hdl, (void *)pv_api_ip,
                                        (void *)pv_api_op);
             break;
+        case IH264D_CMD_CTL_SET_COLOR_CONV:
+            ret = ih264d_set_color_conv(dec_hdl, (void *)pv_api_ip,
+                                        (void *)pv_api_op);
+            break;
+        case IH264D_CMD_CTL_SET_OUTPUT_SCALE:
+            ret = ih264d_set_output_scale(dec_hdl, (void *)pv_api_ip,
+                                          (void *)pv_api_op);
+            break;
+        case IH264D_CMD_CTL_ADDREF_DISP_HANDLE:
+            ret = ih264d_addref_disp_handle(dec_hdl, (void *)pv_api_ip,
+                                            (void *)pv_api_op);
+            break;
+        case IH264D_CMD_CTL_SEEK:
+            ret = ih264d_seek(dec_hdl, (void *)pv_api_ip, (void *)pv_api_op);
+            break;
+        case IH264D_CMD_CTL_DECODE_BATCH:
+            ret = ih264d_decode_batch(dec_hdl, (void *)pv_api_ip,
+                                      (void *)pv_api_op);
+            break;
         default:
             H264_DEC_DEBUG_PRINT("\ndo nothing\n")
             ;
@@ -3226,6 +3701,23 @@ WORD32 ih264d_rel_display_frame(iv_obj_t *dec_hdl,
     ps_rel_op->u4_error_code = 0;
     u4_ts = ps_rel_ip->u4_disp_buf_id;
 
+    if(1 == ps_dec->u4_disp_handles)
+    {
+        /* The picture goes back to the decoder with its last holder */
+        H264_MUTEX_LOCK(&ps_dec->process_disp_mutex);
+        if((ps_dec->pv_pic_buf_mgr != NULL)
+                        && ps_dec->au4_disp_handle_refs[u4_ts])
+        {
+            ps_dec->au4_disp_handle_refs[u4_ts]--;
+            if(0 == ps_dec->au4_disp_handle_refs[u4_ts])
+            {
+                ih264_buf_mgr_release((buf_mgr_t *)ps_dec->pv_pic_buf_mgr,
+                                      u4_ts, BUF_MGR_IO);
+            }
+        } H264_MUTEX_UNLOCK(&ps_dec->process_disp_mutex);
+        return IV_SUCCESS;
+    }
+
     if(0 == ps_dec->u4_share_disp_buf)
     {
         ps_dec->u4_disp_buf_mapping[u4_ts] = 0;
@@ -3404,6 +3896,242 @@ WORD32 ih264d_get_frame_dimensions(iv_obj_t *dec_hdl,
 
 }
 
+WORD32 ih264d_get_mem_footprint(iv_obj_t *dec_hdl,
+                                void *pv_api_ip,
+                                void *pv_api_op)
+{
+    ih264d_ctl_get_mem_footprint_ip_t *ps_ip;
+    ih264d_ctl_get_mem_footprint_op_t *ps_op;
+    dec_struct_t *ps_dec = dec_hdl->pv_codec_handle;
+
+    ps_ip = (ih264d_ctl_get_mem_footprint_ip_t *)pv_api_ip;
+    ps_op = (ih264d_ctl_get_mem_footprint_op_t *)pv_api_op;
+    UNUSED(ps_ip);
+
+    ps_op->u4_static_mem_size = ps_dec->u4_static_mem_size;
+    ps_op->u4_dynamic_mem_size = ps_dec->u4_dynamic_mem_size;
+
+    /* Carved buffers are accounted as the whole pool */
+    if(ps_dec->pu1_buf_pool)
+    {
+        ps_op->u4_dynamic_mem_size = ps_dec->u4_buf_pool_size;
+        if(ps_dec->pu1_bits_buf_dynamic)
+            ps_op->u4_dynamic_mem_size += ps_dec->u4_dynamic_bits_buf_size;
+    }
+    ps_op->u4_error_code = 0;
+
+    return IV_SUCCESS;
+}
+
+WORD32 ih264d_set_color_conv(iv_obj_t *dec_hdl,
+                             void *pv_api_ip,
+                             void *pv_api_op)
+{
+    ih264d_ctl_set_color_conv_ip_t *ps_ip;
+    ih264d_ctl_set_color_conv_op_t *ps_op;
+    dec_struct_t *ps_dec = dec_hdl->pv_codec_handle;
+
+    ps_ip = (ih264d_ctl_set_color_conv_ip_t *)pv_api_ip;
+    ps_op = (ih264d_ctl_set_color_conv_op_t *)pv_api_op;
+
+    ps_dec->u4_csc_matrix = ps_ip->u4_csc_matrix;
+    ps_dec->u4_csc_full_range = ps_ip->u4_full_range ? 1 : 0;
+    ps_op->u4_error_code = 0;
+
+    return IV_SUCCESS;
+}
+
+WORD32 ih264d_set_output_scale(iv_obj_t *dec_hdl,
+                               void *pv_api_ip,
+                               void *pv_api_op)
+{
+    ih264d_ctl_set_output_scale_ip_t *ps_ip;
+    ih264d_ctl_set_output_scale_op_t *ps_op;
+    dec_struct_t *ps_dec = dec_hdl->pv_codec_handle;
+
+    ps_ip = (ih264d_ctl_set_output_scale_ip_t *)pv_api_ip;
+    ps_op = (ih264d_ctl_set_output_scale_op_t *)pv_api_op;
+    ps_op->u4_error_code = 0;
+
+    /* Shared display buffers and display handles are handed out as */
+    /* decoded, without a copy. The downscaler produces 4:2:0 only  */
+    if(ps_ip->u4_scale_shift
+                    && (ps_dec->u4_share_disp_buf || ps_dec->u4_disp_handles
+                                    || (ps_dec->u1_chroma_format
+                                                    == IV_YUV_422P)))
+    {
+        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+        return IV_FAIL;
+    }
+
+    ps_dec->u4_out_scale_shift = ps_ip->u4_scale_shift;
+    ps_dec->u4_out_scale_filter = ps_ip->u4_scale_filter;
+
+    return IV_SUCCESS;
+}
+
+WORD32 ih264d_addref_disp_handle(iv_obj_t *dec_hdl,
+                                 void *pv_api_ip,
+                                 void *pv_api_op)
+{
+    ih264d_ctl_addref_disp_handle_ip_t *ps_ip;
+    ih264d_ctl_addref_disp_handle_op_t *ps_op;
+    dec_struct_t *ps_dec = dec_hdl->pv_codec_handle;
+    UWORD32 u4_buf_id;
+
+    ps_ip = (ih264d_ctl_addref_disp_handle_ip_t *)pv_api_ip;
+    ps_op = (ih264d_ctl_addref_disp_handle_op_t *)pv_api_op;
+    ps_op->u4_error_code = 0;
+    u4_buf_id = ps_ip->u4_disp_buf_id;
+
+    /* Only a picture that is still held can gain another holder */
+    H264_MUTEX_LOCK(&ps_dec->process_disp_mutex);
+    if((0 == ps_dec->u4_disp_handles)
+                    || (0 == ps_dec->au4_disp_handle_refs[u4_buf_id]))
+    {
+        H264_MUTEX_UNLOCK(&ps_dec->process_disp_mutex);
+        ps_op->u4_error_code |= 1 << IVD_UNSUPPORTEDPARAM;
+        return IV_FAIL;
+    }
+    ps_dec->au4_disp_handle_refs[u4_buf_id]++;
+    H264_MUTEX_UNLOCK(&ps_dec->process_disp_mutex);
+
+    return IV_SUCCESS;
+}
+
+WORD32 ih264d_seek(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
+{
+    ih264d_ctl_seek_op_t *ps_op;
+    dec_struct_t *ps_dec = dec_hdl->pv_codec_handle;
+    dec_slice_params_t *ps_cur_slice = ps_dec->ps_cur_slice;
+    pocstruct_t *ps_prev_poc, *ps_cur_poc;
+    pic_buffer_t *ps_pic_buf;
+    WORD32 i4_buf_id;
+
+    ps_op = (ih264d_ctl_seek_op_t *)pv_api_op;
+    UNUSED(pv_api_ip);
+    ps_op->u4_error_code = 0;
+
+    if(ps_dec->u1_init_dec_flag == 1)
+    {
+        /* Move the pictures waiting to be bumped to the display queue */
+        /* and hand everything in the queue back to the buffer manager */
+        ih264d_release_pics_in_dpb((void *)ps_dec, ps_dec->u1_pic_bufs);
+        ih264d_release_display_bufs(ps_dec);
+        ih264d_reset_ref_bufs(ps_dec->ps_dpb_mgr);
+
+        H264_MUTEX_LOCK(&ps_dec->process_disp_mutex);
+        while(1)
+        {
+            ps_pic_buf = (pic_buffer_t *)ih264_disp_mgr_get(
+                            (disp_mgr_t *)ps_dec->pv_disp_buf_mgr, &i4_buf_id);
+            if(NULL == ps_pic_buf)
+                break;
+            ih264_buf_mgr_release((buf_mgr_t *)ps_dec->pv_pic_buf_mgr,
+                                  i4_buf_id, BUF_MGR_IO);
+        }
+        H264_MUTEX_UNLOCK(&ps_dec->process_disp_mutex);
+    }
+
+    /* Stream state as after ih264d_init_decoder(), parameter sets and */
+    /* buffers are kept                                                 */
+    ps_dec->u1_first_slice_in_stream = 1;
+    ps_dec->u1_first_pb_nal_in_pic = 1;
+    ps_dec->u1_last_pic_not_decoded = 0;
+    ps_dec->u1_flushfrm = 0;
+    ps_dec->u1_second_field = 0;
+    ps_dec->u1_top_bottom_decoded = 0;
+    ps_dec->u1_dangling_field = 0;
+    ps_dec->u2_prv_frame_num = 0;
+    ps_dec->u1_pr_sl_type = 0xFF;
+    ps_dec->u2_mbx = 0xffff;
+    ps_dec->u2_mby = 0;
+    ps_dec->u4_total_mbs_coded = 0;
+    ps_dec->s_prev_seq_params.u1_eoseq_pending = 0;
+    ps_dec->ps_sei->u1_is_valid = 0;
+
+    ps_dec->ps_dec_err_status->u1_err_flag = ACCEPT_ALL_PICS;
+    ps_dec->ps_dec_err_status->u1_cur_pic_type = PIC_TYPE_UNKNOWN;
+    ps_dec->ps_dec_err_status->u4_frm_sei_sync = SYNC_FRM_DEFAULT;
+    ps_dec->ps_dec_err_status->u4_cur_frm = INIT_FRAME;
+    ps_dec->ps_dec_err_status->u1_pic_aud_i = PIC_TYPE_UNKNOWN;
+
+    ps_prev_poc = &ps_dec->s_prev_pic_poc;
+    ps_cur_poc = &ps_dec->s_cur_pic_poc;
+    memset(ps_prev_poc, 0, sizeof(pocstruct_t));
+    memset(ps_cur_poc, 0, sizeof(pocstruct_t));
+    ps_cur_slice->u1_mmco_equalto5 = 0;
+    ps_cur_slice->u2_frame_num = 0;
+
+    return IV_SUCCESS;
+}
+
+WORD32 ih264d_decode_batch(iv_obj_t *dec_hdl,
+                           void *pv_api_ip,
+                           void *pv_api_op)
+{
+    ih264d_ctl_decode_batch_ip_t *ps_ip;
+    ih264d_ctl_decode_batch_op_t *ps_op;
+    ivd_video_decode_ip_t *ps_dec_ip;
+    ivd_video_decode_op_t *ps_dec_op;
+    dec_struct_t *ps_dec = (dec_struct_t *)(dec_hdl->pv_codec_handle);
+    UWORD32 i;
+    WORD32 ret = IV_SUCCESS;
+
+    ps_ip = (ih264d_ctl_decode_batch_ip_t *)pv_api_ip;
+    ps_op = (ih264d_ctl_decode_batch_op_t *)pv_api_op;
+    ps_op->u4_error_code = 0;
+    ps_op->u4_num_au_done = 0;
+
+    /* Decode and deblock threads are created once and reused for every
+     * picture of the batch instead of being created and joined per picture */
+    ps_dec->u4_keep_threads_active = 1;
+
+    for(i = 0; i < ps_ip->u4_num_au; i++)
+    {
+        ps_dec_ip = &ps_ip->ps_decode_ip[i].s_ivd_video_decode_ip_t;
+        ps_dec_op = &ps_ip->ps_decode_op[i].s_ivd_video_decode_op_t;
+        ps_dec_op->u4_error_code = 0;
+
+        /* Continue from where the previous access unit ended */
+        if((i > 0) && (NULL == ps_dec_ip->pv_stream_buffer))
+        {
+            ivd_video_decode_ip_t *ps_prev_ip =
+                            &ps_ip->ps_decode_ip[i - 1].s_ivd_video_decode_ip_t;
+            ivd_video_decode_op_t *ps_prev_op =
+                            &ps_ip->ps_decode_op[i - 1].s_ivd_video_decode_op_t;
+            UWORD32 u4_consumed = ps_prev_op->u4_num_bytes_consumed;
+
+            if(u4_consumed >= ps_prev_ip->u4_num_Bytes)
+                break;
+
+            ps_dec_ip->pv_stream_buffer =
+                            (UWORD8 *)ps_prev_ip->pv_stream_buffer + u4_consumed;
+            ps_dec_ip->u4_num_Bytes = ps_prev_ip->u4_num_Bytes - u4_consumed;
+        }
+
+        ret = ih264d_video_decode(dec_hdl, (void *)&ps_ip->ps_decode_ip[i],
+                                  (void *)&ps_ip->ps_decode_op[i]);
+        ps_op->u4_num_au_done++;
+
+        /* The application has to act before the rest can be decoded */
+        if((IV_SUCCESS != ret)
+                        && (IS_IVD_FATAL_ERROR(ps_dec_op->u4_error_code)
+                                        || (IVD_RES_CHANGED
+                                                        == (ps_dec_op->u4_error_code
+                                                                        & 0xFF))))
+        {
+            ps_op->u4_error_code = ps_dec_op->u4_error_code;
+            break;
+        }
+    }
+
+    ih264d_stop_threads(ps_dec);
+    ps_dec->u4_keep_threads_active = 0;
+
+    return (0 == ps_op->u4_error_code) ? IV_SUCCESS : IV_FAIL;
+}
+
 WORD32 ih264d_set_num_cores(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
 {
     ih264d_ctl_set_num_cores_ip_t *ps_ip;
@@ -3414,6 +4142,11 @@ WORD32 ih264d_set_num_cores(iv_obj_t *dec_hdl, void *pv_api_ip, void *pv_api_op)
     ps_op = (ih264d_ctl_set_num_cores_op_t *)pv_api_op;
     ps_op->u4_error_code = 0;
     ps_dec->u4_num_cores = ps_ip->u4_num_cores;
+
+    /* Compact buffers are sized for a single decode thread */
+    if(ps_dec->u4_compact_mem)
+        ps_dec->u4_num_cores = 1;
+
     if(ps_dec->u4_num_cores == 1)
     {
         ps_dec->u1_separate_parse = 0;
@@ -1268,7 +1268,7 @@ void ih264d_compute_bs_non_mbaff(dec_struct_t * ps_dec,
     u2_left_csbp = ps_cur_mb_info->ps_left_mb->u2_luma_csbp;
     u2_top_csbp = ps_cur_mb_info->ps_top_mb->u2_luma_csbp;
     /* Compute BS function */
-    if(ps_dec->ps_cur_sps->u1_profile_idc == HIGH_PROFILE_IDC)
+    if(ps_dec->ps_cur_sps->u1_profile_idc >= HIGH_PROFILE_IDC)
     {
         if(ps_cur_mb_info->u1_tran_form8x8 == 1)
         {
@@ -1569,7 +1569,7 @@ void ih264d_compute_bs_mbaff(dec_struct_t * ps_dec,
     u2_left_csbp = ps_cur_mb_info->ps_left_mb->u2_luma_csbp;
     u2_top_csbp = ps_cur_mb_info->ps_top_mb->u2_luma_csbp;
     /* Compute BS function */
-    if(ps_dec->ps_cur_sps->u1_profile_idc == HIGH_PROFILE_IDC)
+    if(ps_dec->ps_cur_sps->u1_profile_idc >= HIGH_PROFILE_IDC)
     {
 
         if(ps_cur_mb_info->u1_tran_form8x8 == 1)
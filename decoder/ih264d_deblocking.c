@@ -63,6 +63,48 @@
  **************************************************************************
  */
 
+/*!
+ **************************************************************************
+ * \if Function name : ih264d_deblk_chroma_vert_bslt4_422 \endif
+ *
+ * \brief
+ *    Filters a vertical chroma edge of a 4:2:2 MB. The edge is 16 rows
+ *    tall, so it is filtered as two 8 row halves with every bS value
+ *    covering 4 chroma rows instead of 2.
+ *
+ * \return
+ *    None
+ **************************************************************************
+ */
+static void ih264d_deblk_chroma_vert_bslt4_422(dec_struct_t *ps_dec,
+                                               UWORD8 *pu1_u,
+                                               WORD32 i4_strd_uv,
+                                               WORD32 alpha_u,
+                                               WORD32 beta_u,
+                                               WORD32 alpha_v,
+                                               WORD32 beta_v,
+                                               UWORD32 u4_bs,
+                                               UWORD8 *pu1_cliptab_u,
+                                               UWORD8 *pu1_cliptab_v)
+{
+    UWORD32 u4_bs_top, u4_bs_bot;
+
+    u4_bs_top = (u4_bs & 0xff000000) | ((u4_bs >> 8) & 0x00ffff00)
+                    | ((u4_bs >> 16) & 0xff);
+    u4_bs_bot = ((u4_bs << 16) & 0xff000000) | ((u4_bs << 8) & 0x00ffff00)
+                    | (u4_bs & 0xff);
+
+    if(u4_bs_top)
+        ps_dec->pf_deblk_chroma_vert_bslt4(pu1_u, i4_strd_uv, alpha_u, beta_u,
+                                           alpha_v, beta_v, u4_bs_top,
+                                           pu1_cliptab_u, pu1_cliptab_v);
+    if(u4_bs_bot)
+        ps_dec->pf_deblk_chroma_vert_bslt4(pu1_u + (i4_strd_uv << 3),
+                                           i4_strd_uv, alpha_u, beta_u,
+                                           alpha_v, beta_v, u4_bs_bot,
+                                           pu1_cliptab_u, pu1_cliptab_v);
+}
+
 /*!
  **************************************************************************
  * \if Function name : FilterBoundaryLeft \endif
@@ -152,6 +194,10 @@ void ih264d_filter_boundary_left_nonmbaff(dec_struct_t *ps_dec,
             ps_dec->pf_deblk_luma_vert_bs4(pu1_y, i4_strd_y, alpha_y, beta_y);
             ps_dec->pf_deblk_chroma_vert_bs4(pu1_u, i4_strd_uv, alpha_u,
                                              beta_u, alpha_v, beta_v);
+            if(0 == ps_dec->u1_chroma_ht_shift)
+                ps_dec->pf_deblk_chroma_vert_bs4(pu1_u + (i4_strd_uv << 3),
+                                                 i4_strd_uv, alpha_u, beta_u,
+                                                 alpha_v, beta_v);
         }
         else
         {
@@ -164,10 +210,17 @@ void ih264d_filter_boundary_left_nonmbaff(dec_struct_t *ps_dec,
                 ps_dec->pf_deblk_luma_vert_bslt4(pu1_y, i4_strd_y, alpha_y,
                                                  beta_y, u4_bs_val,
                                                  pu1_cliptab_y);
-                ps_dec->pf_deblk_chroma_vert_bslt4(pu1_u, i4_strd_uv, alpha_u,
-                                                   beta_u, alpha_v, beta_v,
-                                                   u4_bs_val, pu1_cliptab_u,
-                                                   pu1_cliptab_v);
+                if(0 == ps_dec->u1_chroma_ht_shift)
+                    ih264d_deblk_chroma_vert_bslt4_422(ps_dec, pu1_u, i4_strd_uv,
+                                                       alpha_u, beta_u, alpha_v,
+                                                       beta_v, u4_bs_val,
+                                                       pu1_cliptab_u,
+                                                       pu1_cliptab_v);
+                else
+                    ps_dec->pf_deblk_chroma_vert_bslt4(pu1_u, i4_strd_uv, alpha_u,
+                                                       beta_u, alpha_v, beta_v,
+                                                       u4_bs_val, pu1_cliptab_u,
+                                                       pu1_cliptab_v);
 
             }
         }
@@ -520,10 +573,17 @@ void ih264d_deblock_mb_nonmbaff(dec_struct_t *ps_dec,
         {
             ps_dec->pf_deblk_luma_vert_bslt4(pu1_y + 8, i4_strd_y, alpha, beta,
                                              u4_bs, pu1_cliptab_y);
-            ps_dec->pf_deblk_chroma_vert_bslt4(pu1_u + 4 * YUV420SP_FACTOR,
-                                               i4_strd_uv, alpha_u, beta_u,
-                                               alpha_v, beta_v, u4_bs,
-                                               pu1_cliptab_u, pu1_cliptab_v);
+            if(0 == ps_dec->u1_chroma_ht_shift)
+                ih264d_deblk_chroma_vert_bslt4_422(ps_dec,
+                                                   pu1_u + 4 * YUV420SP_FACTOR,
+                                                   i4_strd_uv, alpha_u, beta_u,
+                                                   alpha_v, beta_v, u4_bs,
+                                                   pu1_cliptab_u, pu1_cliptab_v);
+            else
+                ps_dec->pf_deblk_chroma_vert_bslt4(pu1_u + 4 * YUV420SP_FACTOR,
+                                                   i4_strd_uv, alpha_u, beta_u,
+                                                   alpha_v, beta_v, u4_bs,
+                                                   pu1_cliptab_u, pu1_cliptab_v);
 
         }
         //edge=3
@@ -577,7 +637,7 @@ void ih264d_deblock_mb_nonmbaff(dec_struct_t *ps_dec,
 
             ps_dec->pf_deblk_luma_horz_bslt4(pu1_y + (i4_strd_y << 3), i4_strd_y,
                                              alpha, beta, u4_bs, pu1_cliptab_y);
-            ps_dec->pf_deblk_chroma_horz_bslt4(pu1_u + (i4_strd_uv << 2),
+            ps_dec->pf_deblk_chroma_horz_bslt4(pu1_u + (i4_strd_uv << (3 - ps_dec->u1_chroma_ht_shift)),
                                                i4_strd_uv, alpha_u, beta_u,
                                                alpha_v, beta_v, u4_bs,
                                                pu1_cliptab_u, pu1_cliptab_v);
@@ -592,6 +652,22 @@ void ih264d_deblock_mb_nonmbaff(dec_struct_t *ps_dec,
                             i4_strd_y, alpha, beta, u4_bs, pu1_cliptab_y);
 
         }
+
+        /* 4:2:2 chroma has horizontal edges at 4 and 12 as well. Only intra */
+        /* slices are decoded for 4:2:2, so these edges have bS 3 even when  */
+        /* the luma 8x8 transform leaves them unfiltered                     */
+        if(0 == ps_dec->u1_chroma_ht_shift)
+        {
+            ps_dec->pf_deblk_chroma_horz_bslt4(pu1_u + (i4_strd_uv << 2),
+                                               i4_strd_uv, alpha_u, beta_u,
+                                               alpha_v, beta_v, 0x03030303,
+                                               pu1_cliptab_u, pu1_cliptab_v);
+            ps_dec->pf_deblk_chroma_horz_bslt4(pu1_u + (i4_strd_uv << 3)
+                                                + (i4_strd_uv << 2),
+                                               i4_strd_uv, alpha_u, beta_u,
+                                               alpha_v, beta_v, 0x03030303,
+                                               pu1_cliptab_u, pu1_cliptab_v);
+        }
      }
 
      ps_dec->u4_deblk_mb_x++;
@@ -610,6 +686,9 @@ void ih264d_deblock_mb_nonmbaff(dec_struct_t *ps_dec,
          ps_tfr_cxt->pu1_mb_v += ps_tfr_cxt->u4_uv_inc;
          ps_dec->u4_deblk_mb_y++;
          ps_dec->u4_deblk_mb_x = 0;
+
+         if(ps_dec->u4_fused_fmt_conv_active)
+             ih264d_fused_fmt_conv_row(ps_dec);
      }
 
 }
@@ -653,7 +732,8 @@ void ih264d_init_deblk_tfr_ctxt(dec_struct_t * ps_dec,
     ps_tfr_cxt->u4_y_inc = ((i4_wd_y << u1_mbaff) * 16
                     - (ps_dec->u2_frm_wd_in_mbs << 4));
 
-    ps_tfr_cxt->u4_uv_inc = (i4_wd_uv << u1_mbaff) * 8
+    ps_tfr_cxt->u4_uv_inc = (i4_wd_uv << u1_mbaff)
+                    * (MB_SIZE >> ps_dec->u1_chroma_ht_shift)
                     - (ps_dec->u2_frm_wd_in_mbs << 4);
 
     /* padding related initialisations */
@@ -918,13 +998,15 @@ void ih264d_deblock_picture_mbaff(dec_struct_t * ps_dec)
 
         ps_dec->pf_pad_left_chroma(ps_tfr_cxt->pu1_src_u + 4,
                                    ps_dec->u2_frm_wd_uv << u1_field_pic_flag,
-                                   (ps_dec->u2_pic_ht / 2) >> u1_field_pic_flag,
+                                   (ps_dec->u2_pic_ht >> ps_dec->u1_chroma_ht_shift)
+                                                   >> u1_field_pic_flag,
                                    PAD_LEN_UV_H * YUV420SP_FACTOR);
         ps_dec->pf_pad_right_chroma(
                         ps_tfr_cxt->pu1_src_u + 4
                                         + (ps_dec->u2_frm_wd_in_mbs << 4),
                         ps_dec->u2_frm_wd_uv << u1_field_pic_flag,
-                        (ps_dec->u2_pic_ht / 2) >> u1_field_pic_flag,
+                        (ps_dec->u2_pic_ht >> ps_dec->u1_chroma_ht_shift)
+                                                   >> u1_field_pic_flag,
                         PAD_LEN_UV_H * YUV420SP_FACTOR);
 
     }
@@ -953,7 +1035,8 @@ void ih264d_deblock_picture_mbaff(dec_struct_t * ps_dec)
         ps_dec->pf_pad_bottom(pu1_buf, ps_dec->u2_frm_wd_y, ps_dec->u2_frm_wd_y,
                               ps_pad_mgr->u1_pad_len_y_v);
         pu1_buf = ps_dec->ps_cur_pic->pu1_buf2 - PAD_LEN_UV_H * YUV420SP_FACTOR;
-        pu1_buf += (ps_dec->u2_pic_ht >> 1) * ps_dec->u2_frm_wd_uv;
+        pu1_buf += (ps_dec->u2_pic_ht >> ps_dec->u1_chroma_ht_shift)
+                        * ps_dec->u2_frm_wd_uv;
 
         ps_dec->pf_pad_bottom(pu1_buf, ps_dec->u2_frm_wd_uv,
                               ps_dec->u2_frm_wd_uv,
@@ -1055,13 +1138,15 @@ void ih264d_deblock_picture_non_mbaff(dec_struct_t * ps_dec)
 
         ps_dec->pf_pad_left_chroma(ps_tfr_cxt->pu1_src_u + 4,
                                    ps_dec->u2_frm_wd_uv << u1_field_pic_flag,
-                                   (ps_dec->u2_pic_ht / 2) >> u1_field_pic_flag,
+                                   (ps_dec->u2_pic_ht >> ps_dec->u1_chroma_ht_shift)
+                                                   >> u1_field_pic_flag,
                                    PAD_LEN_UV_H * YUV420SP_FACTOR);
         ps_dec->pf_pad_right_chroma(
                         ps_tfr_cxt->pu1_src_u + 4
                                         + (ps_dec->u2_frm_wd_in_mbs << 4),
                         ps_dec->u2_frm_wd_uv << u1_field_pic_flag,
-                        (ps_dec->u2_pic_ht / 2) >> u1_field_pic_flag,
+                        (ps_dec->u2_pic_ht >> ps_dec->u1_chroma_ht_shift)
+                                                   >> u1_field_pic_flag,
                         PAD_LEN_UV_H * YUV420SP_FACTOR);
 
     }
@@ -1090,7 +1175,8 @@ void ih264d_deblock_picture_non_mbaff(dec_struct_t * ps_dec)
         ps_dec->pf_pad_bottom(pu1_buf, ps_dec->u2_frm_wd_y, ps_dec->u2_frm_wd_y,
                               ps_pad_mgr->u1_pad_len_y_v);
         pu1_buf = ps_dec->ps_cur_pic->pu1_buf2 - PAD_LEN_UV_H * YUV420SP_FACTOR;
-        pu1_buf += (ps_dec->u2_pic_ht >> 1) * ps_dec->u2_frm_wd_uv;
+        pu1_buf += (ps_dec->u2_pic_ht >> ps_dec->u1_chroma_ht_shift)
+                        * ps_dec->u2_frm_wd_uv;
 
         ps_dec->pf_pad_bottom(pu1_buf, ps_dec->u2_frm_wd_uv,
                               ps_dec->u2_frm_wd_uv,
@@ -1169,13 +1255,15 @@ void ih264d_deblock_picture_progressive(dec_struct_t * ps_dec)
 
         ps_dec->pf_pad_left_chroma(ps_tfr_cxt->pu1_src_u + 4,
                                    ps_dec->u2_frm_wd_uv << u1_field_pic_flag,
-                                   (ps_dec->u2_pic_ht / 2) >> u1_field_pic_flag,
+                                   (ps_dec->u2_pic_ht >> ps_dec->u1_chroma_ht_shift)
+                                                   >> u1_field_pic_flag,
                                    PAD_LEN_UV_H * YUV420SP_FACTOR);
         ps_dec->pf_pad_right_chroma(
                         ps_tfr_cxt->pu1_src_u + 4
                                         + (ps_dec->u2_frm_wd_in_mbs << 4),
                         ps_dec->u2_frm_wd_uv << u1_field_pic_flag,
-                        (ps_dec->u2_pic_ht / 2) >> u1_field_pic_flag,
+                        (ps_dec->u2_pic_ht >> ps_dec->u1_chroma_ht_shift)
+                                                   >> u1_field_pic_flag,
                         PAD_LEN_UV_H * YUV420SP_FACTOR);
 
     }
@@ -1204,7 +1292,8 @@ void ih264d_deblock_picture_progressive(dec_struct_t * ps_dec)
         ps_dec->pf_pad_bottom(pu1_buf, ps_dec->u2_frm_wd_y, ps_dec->u2_frm_wd_y,
                               ps_pad_mgr->u1_pad_len_y_v);
         pu1_buf = ps_dec->ps_cur_pic->pu1_buf2 - PAD_LEN_UV_H * YUV420SP_FACTOR;
-        pu1_buf += (ps_dec->u2_pic_ht >> 1) * ps_dec->u2_frm_wd_uv;
+        pu1_buf += (ps_dec->u2_pic_ht >> ps_dec->u1_chroma_ht_shift)
+                        * ps_dec->u2_frm_wd_uv;
 
         ps_dec->pf_pad_bottom(pu1_buf, ps_dec->u2_frm_wd_uv,
                               ps_dec->u2_frm_wd_uv,
@@ -1282,7 +1371,9 @@ void ih264d_copy_intra_pred_line(dec_struct_t *ps_dec,
     MEMCPY_16BYTES(ps_dec->pu1_cur_y_intra_pred_line, pu1_mb_last_row);
 
     pu1_mb_last_row = ps_dec->ps_frame_buf_ip_recon->pu1_dest_u
-                    + (u4_recwidth_cr * (BLK8x8SIZE - 1));
+                    + (u4_recwidth_cr
+                                    * ((MB_SIZE >> ps_dec->u1_chroma_ht_shift)
+                                                    - 1));
     pu1_mb_last_row += BLK8x8SIZE * nmb_index * YUV420SP_FACTOR;
 
     MEMCPY_16BYTES(ps_dec->pu1_cur_u_intra_pred_line, pu1_mb_last_row);
@@ -34,14 +34,24 @@
  *
  ************************************************************************
  */
-#define H264_MAX_FRAME_WIDTH                3840
-#define H264_MAX_FRAME_HEIGHT               2176
+/* Largest dimension allowed by level 6.x, sqrt(8 * MaxFS) MBs */
+#define H264_MAX_FRAME_WIDTH                16880
+#define H264_MAX_FRAME_HEIGHT               16880
 
 #define H264_MIN_FRAME_WIDTH                16
 #define H264_MIN_FRAME_HEIGHT               16
 
 #define FMT_CONV_NUM_ROWS       16
 
+/** Output downscaling, 1/2, 1/4 and 1/8 */
+#define MAX_OUT_SCALE_SHIFT     3
+/** Output rows decimated per pass through the scratch buffer, even */
+#define OUT_SCALE_NUM_ROWS      16
+
+/** Pictures allocated beyond the DPB needs for display handles held by the */
+/** application                                                             */
+#define MAX_DISP_HANDLES_HELD   4
+
 /** Bit manipulation macros */
 #define CHECKBIT(a,i) ((a) &  (1 << i))
 #define CLEARBIT(a,i) ((a) &= ~(1 << i))
@@ -258,6 +268,7 @@ enum
 #define BASE_PROFILE_IDC    66
 #define MAIN_PROFILE_IDC    77
 #define HIGH_PROFILE_IDC   100
+#define HIGH422_PROFILE_IDC 122
 
 
 #define MB_SIZE             16
@@ -285,7 +296,15 @@ enum
 #define H264_LEVEL_4_2     42
 #define H264_LEVEL_5_0     50
 #define H264_LEVEL_5_1     51
-
+#define H264_LEVEL_5_2     52
+#define H264_LEVEL_6_0     60
+#define H264_LEVEL_6_1     61
+#define H264_LEVEL_6_2     62
+
+#define MAX_MBS_LEVEL_62 139264
+#define MAX_MBS_LEVEL_61 139264
+#define MAX_MBS_LEVEL_60 139264
+#define MAX_MBS_LEVEL_52 36864
 #define MAX_MBS_LEVEL_51 36864
 #define MAX_MBS_LEVEL_50 22080
 #define MAX_MBS_LEVEL_42 8704
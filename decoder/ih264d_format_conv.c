@@ -45,6 +45,7 @@
 #include "ih264_macros.h"
 #include "ih264_platform_macros.h"
 #include "ih264d_structs.h"
+#include "ih264d.h"
 #include "ih264d_format_conv.h"
 #include "ih264d_defs.h"
 
@@ -59,6 +60,68 @@
 #define INSERT_LOGO(pu1_buf_y,pu1_buf_u,pu1_buf_v, u4_stride, u4_x_pos, u4_y_pos, u4_yuv_fmt, u4_disp_wd, u4_disp_ht)
 #endif
 
+/* YUV to RGB coefficients in Q13 : Y gain, Y offset, V to R, U to G, V to G, */
+/* U to B. Limited range tables expand luma from 16-235 to 0-255             */
+static const WORD16 gai2_ih264d_csc_coeffs[5][NUM_CSC_COEFFS] =
+{
+    /* IH264D_CSC_DEFAULT */
+    { 8192,  0, COEFF1, COEFF2, COEFF3, COEFF4 },
+    /* IH264D_CSC_BT601, limited range */
+    { 9539, 16, 13075, -3209, -6660, 16525 },
+    /* IH264D_CSC_BT601, full range */
+    { 8192,  0, 11485, -2819, -5850, 14516 },
+    /* IH264D_CSC_BT709, limited range */
+    { 9539, 16, 14686, -1747, -4366, 17305 },
+    /* IH264D_CSC_BT709, full range */
+    { 8192,  0, 12901, -1535, -3835, 15201 },
+};
+
+/**
+ *******************************************************************************
+ *
+ * @brief Returns the YUV to RGB coefficients for the current picture
+ *
+ * @par   Description
+ * Resolves the matrix and range set through IH264D_CMD_CTL_SET_COLOR_CONV.
+ * For IH264D_CSC_FROM_VUI, matrix_coefficients equal to 1 selects BT.709,
+ * any other value selects BT.601 and video_full_range_flag selects the range
+ *
+ * @param[in] ps_dec
+ *   Decoder context
+ *
+ * @returns Pointer to NUM_CSC_COEFFS coefficients
+ *
+ * @remarks None
+ *
+ *******************************************************************************
+ */
+const WORD16 *ih264d_get_csc_coeffs(dec_struct_t *ps_dec)
+{
+    UWORD32 u4_matrix = ps_dec->u4_csc_matrix;
+    UWORD32 u4_full_range = ps_dec->u4_csc_full_range;
+
+    if(IH264D_CSC_FROM_VUI == u4_matrix)
+    {
+        dec_seq_params_t *ps_sps = ps_dec->ps_cur_sps;
+
+        u4_matrix = IH264D_CSC_BT601;
+        u4_full_range = 0;
+        if((NULL != ps_sps) && (1 == ps_sps->u1_vui_parameters_present_flag))
+        {
+            if(1 == ps_sps->s_vui.u1_matrix_coeffs)
+                u4_matrix = IH264D_CSC_BT709;
+            u4_full_range = ps_sps->s_vui.u1_video_full_range_flag;
+        }
+    }
+
+    if(IH264D_CSC_BT601 == u4_matrix)
+        return gai2_ih264d_csc_coeffs[1 + (u4_full_range ? 1 : 0)];
+    if(IH264D_CSC_BT709 == u4_matrix)
+        return gai2_ih264d_csc_coeffs[3 + (u4_full_range ? 1 : 0)];
+
+    return gai2_ih264d_csc_coeffs[0];
+}
+
 /**
  *******************************************************************************
  *
@@ -113,12 +176,20 @@ void ih264d_fmt_conv_420sp_to_rgb565(UWORD8 *pu1_y_src,
                                      WORD32 src_y_strd,
                                      WORD32 src_uv_strd,
                                      WORD32 dst_strd,
-                                     WORD32 is_u_first)
+                                     WORD32 is_u_first,
+                                     const WORD16 *pi2_csc_coeffs)
 {
 
     WORD16 i2_r, i2_g, i2_b;
     UWORD32 u4_r, u4_g, u4_b;
+    WORD32 i4_y;
     WORD16 i2_i, i2_j;
+    WORD32 y_gain = pi2_csc_coeffs[CSC_Y_GAIN];
+    WORD32 y_ofst = pi2_csc_coeffs[CSC_Y_OFFSET];
+    WORD32 v_to_r = pi2_csc_coeffs[CSC_V_TO_R];
+    WORD32 u_to_g = pi2_csc_coeffs[CSC_U_TO_G];
+    WORD32 v_to_g = pi2_csc_coeffs[CSC_V_TO_G];
+    WORD32 u_to_b = pi2_csc_coeffs[CSC_U_TO_B];
     UWORD8 *pu1_y_src_nxt;
     UWORD16 *pu2_rgb_dst_next_row;
 
@@ -142,64 +213,68 @@ void ih264d_fmt_conv_420sp_to_rgb565(UWORD8 *pu1_y_src,
     {
         for(i2_j = (wd >> 1); i2_j > 0; i2_j--)
         {
-            i2_b = ((*pu1_u_src - 128) * COEFF4 >> 13);
-            i2_g = ((*pu1_u_src - 128) * COEFF2 + (*pu1_v_src - 128) * COEFF3)
+            i2_b = ((*pu1_u_src - 128) * u_to_b >> 13);
+            i2_g = ((*pu1_u_src - 128) * u_to_g + (*pu1_v_src - 128) * v_to_g)
                             >> 13;
-            i2_r = ((*pu1_v_src - 128) * COEFF1) >> 13;
+            i2_r = ((*pu1_v_src - 128) * v_to_r) >> 13;
 
             pu1_u_src += 2;
             pu1_v_src += 2;
             /* pixel 0 */
+            i4_y = ((*pu1_y_src - y_ofst) * y_gain) >> 13;
             /* B */
-            u4_b = CLIP_U8(*pu1_y_src + i2_b);
+            u4_b = CLIP_U8(i4_y + i2_b);
             u4_b >>= 3;
             /* G */
-            u4_g = CLIP_U8(*pu1_y_src + i2_g);
+            u4_g = CLIP_U8(i4_y + i2_g);
             u4_g >>= 2;
             /* R */
-            u4_r = CLIP_U8(*pu1_y_src + i2_r);
+            u4_r = CLIP_U8(i4_y + i2_r);
             u4_r >>= 3;
 
             pu1_y_src++;
             *pu2_rgb_dst++ = ((u4_r << 11) | (u4_g << 5) | u4_b);
 
             /* pixel 1 */
+            i4_y = ((*pu1_y_src - y_ofst) * y_gain) >> 13;
             /* B */
-            u4_b = CLIP_U8(*pu1_y_src + i2_b);
+            u4_b = CLIP_U8(i4_y + i2_b);
             u4_b >>= 3;
             /* G */
-            u4_g = CLIP_U8(*pu1_y_src + i2_g);
+            u4_g = CLIP_U8(i4_y + i2_g);
             u4_g >>= 2;
             /* R */
-            u4_r = CLIP_U8(*pu1_y_src + i2_r);
+            u4_r = CLIP_U8(i4_y + i2_r);
             u4_r >>= 3;
 
             pu1_y_src++;
             *pu2_rgb_dst++ = ((u4_r << 11) | (u4_g << 5) | u4_b);
 
             /* pixel 2 */
+            i4_y = ((*pu1_y_src_nxt - y_ofst) * y_gain) >> 13;
             /* B */
-            u4_b = CLIP_U8(*pu1_y_src_nxt + i2_b);
+            u4_b = CLIP_U8(i4_y + i2_b);
             u4_b >>= 3;
             /* G */
-            u4_g = CLIP_U8(*pu1_y_src_nxt + i2_g);
+            u4_g = CLIP_U8(i4_y + i2_g);
             u4_g >>= 2;
             /* R */
-            u4_r = CLIP_U8(*pu1_y_src_nxt + i2_r);
+            u4_r = CLIP_U8(i4_y + i2_r);
             u4_r >>= 3;
 
             pu1_y_src_nxt++;
             *pu2_rgb_dst_next_row++ = ((u4_r << 11) | (u4_g << 5) | u4_b);
 
             /* pixel 3 */
+            i4_y = ((*pu1_y_src_nxt - y_ofst) * y_gain) >> 13;
             /* B */
-            u4_b = CLIP_U8(*pu1_y_src_nxt + i2_b);
+            u4_b = CLIP_U8(i4_y + i2_b);
             u4_b >>= 3;
             /* G */
-            u4_g = CLIP_U8(*pu1_y_src_nxt + i2_g);
+            u4_g = CLIP_U8(i4_y + i2_g);
             u4_g >>= 2;
             /* R */
-            u4_r = CLIP_U8(*pu1_y_src_nxt + i2_r);
+            u4_r = CLIP_U8(i4_y + i2_r);
             u4_r >>= 3;
 
             pu1_y_src_nxt++;
@@ -227,12 +302,20 @@ void ih264d_fmt_conv_420sp_to_rgba8888(UWORD8 *pu1_y_src,
                                        WORD32 src_y_strd,
                                        WORD32 src_uv_strd,
                                        WORD32 dst_strd,
-                                       WORD32 is_u_first)
+                                       WORD32 is_u_first,
+                                       const WORD16 *pi2_csc_coeffs)
 {
 
     WORD16 i2_r, i2_g, i2_b;
     UWORD32 u4_r, u4_g, u4_b;
+    WORD32 i4_y;
     WORD16 i2_i, i2_j;
+    WORD32 y_gain = pi2_csc_coeffs[CSC_Y_GAIN];
+    WORD32 y_ofst = pi2_csc_coeffs[CSC_Y_OFFSET];
+    WORD32 v_to_r = pi2_csc_coeffs[CSC_V_TO_R];
+    WORD32 u_to_g = pi2_csc_coeffs[CSC_U_TO_G];
+    WORD32 v_to_g = pi2_csc_coeffs[CSC_V_TO_G];
+    WORD32 u_to_b = pi2_csc_coeffs[CSC_U_TO_B];
     UWORD8 *pu1_y_src_nxt;
     UWORD32 *pu4_rgba_dst_next_row;
 
@@ -256,54 +339,58 @@ void ih264d_fmt_conv_420sp_to_rgba8888(UWORD8 *pu1_y_src,
     {
         for(i2_j = (wd >> 1); i2_j > 0; i2_j--)
         {
-            i2_b = ((*pu1_u_src - 128) * COEFF4 >> 13);
-            i2_g = ((*pu1_u_src - 128) * COEFF2 + (*pu1_v_src - 128) * COEFF3)
+            i2_b = ((*pu1_u_src - 128) * u_to_b >> 13);
+            i2_g = ((*pu1_u_src - 128) * u_to_g + (*pu1_v_src - 128) * v_to_g)
                             >> 13;
-            i2_r = ((*pu1_v_src - 128) * COEFF1) >> 13;
+            i2_r = ((*pu1_v_src - 128) * v_to_r) >> 13;
 
             pu1_u_src += 2;
             pu1_v_src += 2;
             /* pixel 0 */
+            i4_y = ((*pu1_y_src - y_ofst) * y_gain) >> 13;
             /* B */
-            u4_b = CLIP_U8(*pu1_y_src + i2_b);
+            u4_b = CLIP_U8(i4_y + i2_b);
             /* G */
-            u4_g = CLIP_U8(*pu1_y_src + i2_g);
+            u4_g = CLIP_U8(i4_y + i2_g);
             /* R */
-            u4_r = CLIP_U8(*pu1_y_src + i2_r);
+            u4_r = CLIP_U8(i4_y + i2_r);
 
             pu1_y_src++;
             *pu4_rgba_dst++ = ((u4_r << 16) | (u4_g << 8) | (u4_b << 0));
 
             /* pixel 1 */
+            i4_y = ((*pu1_y_src - y_ofst) * y_gain) >> 13;
             /* B */
-            u4_b = CLIP_U8(*pu1_y_src + i2_b);
+            u4_b = CLIP_U8(i4_y + i2_b);
             /* G */
-            u4_g = CLIP_U8(*pu1_y_src + i2_g);
+            u4_g = CLIP_U8(i4_y + i2_g);
             /* R */
-            u4_r = CLIP_U8(*pu1_y_src + i2_r);
+            u4_r = CLIP_U8(i4_y + i2_r);
 
             pu1_y_src++;
             *pu4_rgba_dst++ = ((u4_r << 16) | (u4_g << 8) | (u4_b << 0));
 
             /* pixel 2 */
+            i4_y = ((*pu1_y_src_nxt - y_ofst) * y_gain) >> 13;
             /* B */
-            u4_b = CLIP_U8(*pu1_y_src_nxt + i2_b);
+            u4_b = CLIP_U8(i4_y + i2_b);
             /* G */
-            u4_g = CLIP_U8(*pu1_y_src_nxt + i2_g);
+            u4_g = CLIP_U8(i4_y + i2_g);
             /* R */
-            u4_r = CLIP_U8(*pu1_y_src_nxt + i2_r);
+            u4_r = CLIP_U8(i4_y + i2_r);
 
             pu1_y_src_nxt++;
             *pu4_rgba_dst_next_row++ =
                             ((u4_r << 16) | (u4_g << 8) | (u4_b << 0));
 
             /* pixel 3 */
+            i4_y = ((*pu1_y_src_nxt - y_ofst) * y_gain) >> 13;
             /* B */
-            u4_b = CLIP_U8(*pu1_y_src_nxt + i2_b);
+            u4_b = CLIP_U8(i4_y + i2_b);
             /* G */
-            u4_g = CLIP_U8(*pu1_y_src_nxt + i2_g);
+            u4_g = CLIP_U8(i4_y + i2_g);
             /* R */
-            u4_r = CLIP_U8(*pu1_y_src_nxt + i2_r);
+            u4_r = CLIP_U8(i4_y + i2_r);
 
             pu1_y_src_nxt++;
             *pu4_rgba_dst_next_row++ =
@@ -648,55 +735,179 @@ void ih264d_fmt_conv_420sp_to_420p(UWORD8 *pu1_y_src,
 }
 
 /*****************************************************************************/
-/*  Function Name : ih264d_format_convert                                    */
+/*  Function Name : ih264d_fmt_conv_sp_to_422p                               */
 /*                                                                           */
-/*  Description   : Implements format conversion/frame copy                  */
-/*  Inputs        : ps_dec - Decoder parameters                              */
+/*  Description   : Copies luma and de-interleaves UV chroma into 4:2:2      */
+/*                  planar output with one chroma row per luma row           */
+/*  Inputs        : wd, ht - Output luma width and height                    */
+/*                  chroma_ht_shift - 0 for 4:2:2 source chroma, 1 for      */
+/*                  4:2:0 source chroma whose rows are then repeated         */
 /*  Globals       : None                                                     */
-/*  Processing    : Refer bumping process in the standard                    */
-/*  Outputs       : Assigns display sequence number.                         */
+/*  Processing    : Output chroma row i is taken from source chroma row      */
+/*                  (i >> chroma_ht_shift)                                   */
+/*  Outputs       : 4:2:2 planar rows                                        */
 /*  Returns       : None                                                     */
 /*                                                                           */
 /*  Issues        : None                                                     */
 /*                                                                           */
-/*  Revision History:                                                        */
-/*                                                                           */
-/*         DD MM YYYY   Author(s)       Changes (Describe the changes made)  */
-/*         27 04 2005   NS              Draft                                */
-/*                                                                           */
 /*****************************************************************************/
-void ih264d_format_convert(dec_struct_t *ps_dec,
-                           ivd_get_display_frame_op_t *pv_disp_op,
-                           UWORD32 u4_start_y,
-                           UWORD32 u4_num_rows_y)
+void ih264d_fmt_conv_sp_to_422p(UWORD8 *pu1_y_src,
+                                UWORD8 *pu1_uv_src,
+                                UWORD8 *pu1_y_dst,
+                                UWORD8 *pu1_u_dst,
+                                UWORD8 *pu1_v_dst,
+                                WORD32 wd,
+                                WORD32 ht,
+                                WORD32 src_y_strd,
+                                WORD32 src_uv_strd,
+                                WORD32 dst_y_strd,
+                                WORD32 dst_uv_strd,
+                                WORD32 chroma_ht_shift)
 {
-    UWORD32 convert_uv_only = 0;
-    iv_yuv_buf_t *ps_op_frm;
-    UWORD8 *pu1_y_src, *pu1_uv_src;
-    UWORD32 start_uv = u4_start_y >> 1;
+    UWORD8 *pu1_uv;
+    WORD32 i, j;
 
-    if(1 == pv_disp_op->u4_error_code)
-        return;
+    for(i = 0; i < ht; i++)
+    {
+        memcpy(pu1_y_dst, pu1_y_src, wd);
+        pu1_y_dst += dst_y_strd;
+        pu1_y_src += src_y_strd;
+    }
 
-    ps_op_frm = &(ps_dec->s_disp_frame_info);
+    for(i = 0; i < ht; i++)
+    {
+        pu1_uv = pu1_uv_src + (i >> chroma_ht_shift) * src_uv_strd;
 
-    /* Requires u4_start_y and u4_num_rows_y to be even */
-    if(u4_start_y & 1)
+        for(j = 0; j < (wd >> 1); j++)
+        {
+            pu1_u_dst[j] = pu1_uv[j * 2];
+            pu1_v_dst[j] = pu1_uv[j * 2 + 1];
+        }
+
+        pu1_u_dst += dst_uv_strd;
+        pu1_v_dst += dst_uv_strd;
+    }
+}
+
+/*****************************************************************************/
+/*  Function Name : ih264d_fmt_conv_420sp_downscale                          */
+/*                                                                           */
+/*  Description   : Decimates 420SP luma and interleaved chroma by           */
+/*                  (1 << shift) in both directions                          */
+/*  Inputs        : wd, ht - Output luma width and height (even)             */
+/*                  shift - log2 of the decimation factor, 1 to 3            */
+/*                  filter - IH264D_SCALE_FILTER_BOX averages each block,    */
+/*                  IH264D_SCALE_FILTER_BILINEAR averages the 2x2 samples    */
+/*                  around the block centre                                  */
+/*  Globals       : None                                                     */
+/*  Processing    : Same filter for luma and for each chroma component       */
+/*  Outputs       : Decimated 420SP rows                                     */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_fmt_conv_420sp_downscale(UWORD8 *pu1_y_src,
+                                     UWORD8 *pu1_uv_src,
+                                     UWORD8 *pu1_y_dst,
+                                     UWORD8 *pu1_uv_dst,
+                                     WORD32 wd,
+                                     WORD32 ht,
+                                     WORD32 src_y_strd,
+                                     WORD32 src_uv_strd,
+                                     WORD32 dst_y_strd,
+                                     WORD32 dst_uv_strd,
+                                     WORD32 shift,
+                                     WORD32 filter)
+{
+    WORD32 i, j, k, l;
+    WORD32 blk = 1 << shift;
+    WORD32 ofst, num, rnd, log2_num;
+    UWORD8 *pu1_src;
+
+    /* Rows and columns of each block that contribute to the output */
+    if(IH264D_SCALE_FILTER_BILINEAR == filter)
     {
-        return;
+        ofst = (blk >> 1) - 1;
+        num = 2;
+        log2_num = 2;
     }
+    else
+    {
+        ofst = 0;
+        num = blk;
+        log2_num = shift << 1;
+    }
+    rnd = (1 << log2_num) >> 1;
 
-    if((1 == ps_dec->u4_share_disp_buf) &&
-       (pv_disp_op->e_output_format == IV_YUV_420SP_UV))
+    for(i = 0; i < ht; i++)
     {
-        return;
+        pu1_src = pu1_y_src + ((i << shift) + ofst) * src_y_strd + ofst;
+        for(j = 0; j < wd; j++)
+        {
+            WORD32 sum = 0;
+            for(k = 0; k < num; k++)
+                for(l = 0; l < num; l++)
+                    sum += pu1_src[k * src_y_strd + l];
+
+            pu1_y_dst[j] = (sum + rnd) >> log2_num;
+            pu1_src += blk;
+        }
+        pu1_y_dst += dst_y_strd;
     }
 
-    pu1_y_src = (UWORD8 *)ps_op_frm->pv_y_buf;
-    pu1_y_src += u4_start_y * ps_op_frm->u4_y_strd,
+    for(i = 0; i < (ht >> 1); i++)
+    {
+        pu1_src = pu1_uv_src + ((i << shift) + ofst) * src_uv_strd + ofst * 2;
+        for(j = 0; j < wd; j += 2)
+        {
+            WORD32 sum_u = 0, sum_v = 0;
+            for(k = 0; k < num; k++)
+            {
+                for(l = 0; l < num; l++)
+                {
+                    sum_u += pu1_src[k * src_uv_strd + l * 2];
+                    sum_v += pu1_src[k * src_uv_strd + l * 2 + 1];
+                }
+            }
+
+            pu1_uv_dst[j] = (sum_u + rnd) >> log2_num;
+            pu1_uv_dst[j + 1] = (sum_v + rnd) >> log2_num;
+            pu1_src += blk * 2;
+        }
+        pu1_uv_dst += dst_uv_strd;
+    }
+}
 
-    pu1_uv_src = (UWORD8 *)ps_op_frm->pv_u_buf;
-    pu1_uv_src += start_uv * ps_op_frm->u4_u_strd;
+/*****************************************************************************/
+/*  Function Name : ih264d_format_convert_rows                               */
+/*                                                                           */
+/*  Description   : Converts u4_num_rows_y 420SP rows at pu1_y_src and       */
+/*                  pu1_uv_src into output rows starting at u4_start_y of    */
+/*                  the buffer in pv_disp_op                                 */
+/*  Inputs        : ps_dec - Decoder parameters                              */
+/*                  pu1_y_src, pu1_uv_src - First source row                 */
+/*                  pv_disp_op - Destination buffer and format               */
+/*  Globals       : None                                                     */
+/*  Processing    : Calls the format specific conversion function            */
+/*  Outputs       : Converted rows in the output buffer                      */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+static void ih264d_format_convert_rows(dec_struct_t *ps_dec,
+                                       UWORD8 *pu1_y_src,
+                                       UWORD8 *pu1_uv_src,
+                                       UWORD32 u4_src_y_strd,
+                                       UWORD32 u4_src_uv_strd,
+                                       UWORD32 u4_wd,
+                                       ivd_get_display_frame_op_t *pv_disp_op,
+                                       UWORD32 u4_start_y,
+                                       UWORD32 u4_num_rows_y)
+{
+    UWORD32 convert_uv_only = 0;
+    UWORD32 start_uv = u4_start_y >> 1;
 
     if(pv_disp_op->e_output_format == IV_YUV_420P)
     {
@@ -721,21 +932,51 @@ void ih264d_format_convert(dec_struct_t *ps_dec,
         pu1_v_dst = (UWORD8 *)pv_disp_op->s_disp_frm_buf.pv_v_buf;
         pu1_v_dst += start_uv * pv_disp_op->s_disp_frm_buf.u4_v_strd;
 
-        ih264d_fmt_conv_420sp_to_420p(pu1_y_src,
-                                      pu1_uv_src,
-                                      pu1_y_dst,
-                                      pu1_u_dst,
-                                      pu1_v_dst,
-                                      ps_op_frm->u4_y_wd,
-                                      u4_num_rows_y,
-                                      ps_op_frm->u4_y_strd,
-                                      ps_op_frm->u4_u_strd,
-                                      pv_disp_op->s_disp_frm_buf.u4_y_strd,
-                                      pv_disp_op->s_disp_frm_buf.u4_u_strd,
-                                      1,
-                                      convert_uv_only);
+        ps_dec->pf_fmt_conv_420sp_to_420p(pu1_y_src,
+                                          pu1_uv_src,
+                                          pu1_y_dst,
+                                          pu1_u_dst,
+                                          pu1_v_dst,
+                                          u4_wd,
+                                          u4_num_rows_y,
+                                          u4_src_y_strd,
+                                          u4_src_uv_strd,
+                                          pv_disp_op->s_disp_frm_buf.u4_y_strd,
+                                          pv_disp_op->s_disp_frm_buf.u4_u_strd,
+                                          1,
+                                          convert_uv_only);
 
     }
+    else if(pv_disp_op->e_output_format == IV_YUV_422P)
+    {
+        UWORD8 *pu1_y_dst, *pu1_u_dst, *pu1_v_dst;
+
+        /* The source chroma stride skips alternate rows of 4:2:2 chroma */
+        /* for the 4:2:0 outputs, undo that to copy every chroma row     */
+        u4_src_uv_strd >>= (1 - ps_dec->u1_chroma_ht_shift);
+
+        pu1_y_dst = (UWORD8 *)pv_disp_op->s_disp_frm_buf.pv_y_buf;
+        pu1_y_dst += u4_start_y * pv_disp_op->s_disp_frm_buf.u4_y_strd;
+
+        pu1_u_dst = (UWORD8 *)pv_disp_op->s_disp_frm_buf.pv_u_buf;
+        pu1_u_dst += u4_start_y * pv_disp_op->s_disp_frm_buf.u4_u_strd;
+
+        pu1_v_dst = (UWORD8 *)pv_disp_op->s_disp_frm_buf.pv_v_buf;
+        pu1_v_dst += u4_start_y * pv_disp_op->s_disp_frm_buf.u4_v_strd;
+
+        ih264d_fmt_conv_sp_to_422p(pu1_y_src,
+                                   pu1_uv_src,
+                                   pu1_y_dst,
+                                   pu1_u_dst,
+                                   pu1_v_dst,
+                                   u4_wd,
+                                   u4_num_rows_y,
+                                   u4_src_y_strd,
+                                   u4_src_uv_strd,
+                                   pv_disp_op->s_disp_frm_buf.u4_y_strd,
+                                   pv_disp_op->s_disp_frm_buf.u4_u_strd,
+                                   ps_dec->u1_chroma_ht_shift);
+    }
     else if((pv_disp_op->e_output_format == IV_YUV_420SP_UV) ||
             (pv_disp_op->e_output_format == IV_YUV_420SP_VU))
     {
@@ -753,25 +994,25 @@ void ih264d_format_convert(dec_struct_t *ps_dec,
                                            pu1_uv_src,
                                            pu1_y_dst,
                                            pu1_uv_dst,
-                                           ps_op_frm->u4_y_wd,
+                                           u4_wd,
                                            u4_num_rows_y,
-                                           ps_op_frm->u4_y_strd,
-                                           ps_op_frm->u4_u_strd,
+                                           u4_src_y_strd,
+                                           u4_src_uv_strd,
                                            pv_disp_op->s_disp_frm_buf.u4_y_strd,
                                            pv_disp_op->s_disp_frm_buf.u4_u_strd);
         }
         else
         {
-            ih264d_fmt_conv_420sp_to_420sp_swap_uv(pu1_y_src,
-                                                   pu1_uv_src,
-                                                   pu1_y_dst,
-                                                   pu1_uv_dst,
-                                                   ps_op_frm->u4_y_wd,
-                                                   u4_num_rows_y,
-                                                   ps_op_frm->u4_y_strd,
-                                                   ps_op_frm->u4_u_strd,
-                                                   pv_disp_op->s_disp_frm_buf.u4_y_strd,
-                                                   pv_disp_op->s_disp_frm_buf.u4_u_strd);
+            ps_dec->pf_fmt_conv_420sp_to_420sp_swap_uv(pu1_y_src,
+                                                       pu1_uv_src,
+                                                       pu1_y_dst,
+                                                       pu1_uv_dst,
+                                                       u4_wd,
+                                                       u4_num_rows_y,
+                                                       u4_src_y_strd,
+                                                       u4_src_uv_strd,
+                                                       pv_disp_op->s_disp_frm_buf.u4_y_strd,
+                                                       pv_disp_op->s_disp_frm_buf.u4_u_strd);
         }
     }
     else if(pv_disp_op->e_output_format == IV_RGB_565)
@@ -781,18 +1022,171 @@ void ih264d_format_convert(dec_struct_t *ps_dec,
         pu2_rgb_dst = (UWORD16 *)pv_disp_op->s_disp_frm_buf.pv_y_buf;
         pu2_rgb_dst += u4_start_y * pv_disp_op->s_disp_frm_buf.u4_y_strd;
 
-        ih264d_fmt_conv_420sp_to_rgb565(pu1_y_src,
-                                        pu1_uv_src,
-                                        pu2_rgb_dst,
-                                        ps_op_frm->u4_y_wd,
-                                        u4_num_rows_y,
+        ps_dec->pf_fmt_conv_420sp_to_rgb565(pu1_y_src,
+                                            pu1_uv_src,
+                                            pu2_rgb_dst,
+                                            u4_wd,
+                                            u4_num_rows_y,
+                                            u4_src_y_strd,
+                                            u4_src_uv_strd,
+                                            pv_disp_op->s_disp_frm_buf.u4_y_strd,
+                                            1,
+                                            ih264d_get_csc_coeffs(ps_dec));
+    }
+    else if(pv_disp_op->e_output_format == IV_RGBA_8888)
+    {
+        UWORD32 *pu4_rgba_dst;
+
+        pu4_rgba_dst = (UWORD32 *)pv_disp_op->s_disp_frm_buf.pv_y_buf;
+        pu4_rgba_dst += u4_start_y * pv_disp_op->s_disp_frm_buf.u4_y_strd;
+
+        ps_dec->pf_fmt_conv_420sp_to_rgba8888(pu1_y_src,
+                                              pu1_uv_src,
+                                              pu4_rgba_dst,
+                                              u4_wd,
+                                              u4_num_rows_y,
+                                              u4_src_y_strd,
+                                              u4_src_uv_strd,
+                                              pv_disp_op->s_disp_frm_buf.u4_y_strd,
+                                              1,
+                                              ih264d_get_csc_coeffs(ps_dec));
+    }
+}
+
+/*****************************************************************************/
+/*  Function Name : ih264d_format_convert_scaled                             */
+/*                                                                           */
+/*  Description   : Decimates the source rows by (1 << u4_out_scale_shift)   */
+/*                  into a small scratch buffer, a few output rows at a      */
+/*                  time, and converts those to the output format            */
+/*  Inputs        : ps_dec - Decoder parameters                              */
+/*                  ps_op_frm - Source picture (cropped, full size)          */
+/*                  pv_disp_op - Destination buffer and format               */
+/*  Globals       : None                                                     */
+/*  Processing    : Each pair of output rows is produced from 2 << shift     */
+/*                  source rows. Pairs whose first source row lies in        */
+/*                  [u4_start_y, u4_start_y + u4_num_rows_y) are converted,  */
+/*                  so the caller must have all their source rows ready      */
+/*  Outputs       : Converted rows in the output buffer                      */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+static void ih264d_format_convert_scaled(dec_struct_t *ps_dec,
+                                         iv_yuv_buf_t *ps_op_frm,
+                                         ivd_get_display_frame_op_t *pv_disp_op,
+                                         UWORD32 u4_start_y,
+                                         UWORD32 u4_num_rows_y)
+{
+    UWORD32 u4_shift = ps_dec->u4_out_scale_shift;
+    UWORD32 u4_pair_rows = 2 << u4_shift;
+    UWORD32 u4_out_wd = (ps_op_frm->u4_y_wd >> u4_shift) & ~1;
+    UWORD32 u4_out_ht = (ps_op_frm->u4_y_ht >> u4_shift) & ~1;
+    UWORD32 u4_out_row, u4_out_end;
+    UWORD8 *pu1_y_scaled = ps_dec->pu1_out_scale_buf;
+    UWORD8 *pu1_uv_scaled = pu1_y_scaled + u4_out_wd * OUT_SCALE_NUM_ROWS;
+
+    u4_out_row = ((u4_start_y + u4_pair_rows - 1) >> (u4_shift + 1)) << 1;
+    u4_out_end = ((u4_start_y + u4_num_rows_y + u4_pair_rows - 1)
+                    >> (u4_shift + 1)) << 1;
+    u4_out_end = MIN(u4_out_end, u4_out_ht);
+
+    while(u4_out_row < u4_out_end)
+    {
+        UWORD32 u4_rows = MIN(OUT_SCALE_NUM_ROWS, u4_out_end - u4_out_row);
+        UWORD8 *pu1_y_src, *pu1_uv_src;
+
+        pu1_y_src = (UWORD8 *)ps_op_frm->pv_y_buf
+                        + ((u4_out_row << u4_shift) * ps_op_frm->u4_y_strd);
+        pu1_uv_src = (UWORD8 *)ps_op_frm->pv_u_buf
+                        + (((u4_out_row >> 1) << u4_shift)
+                                        * ps_op_frm->u4_u_strd);
+
+        ih264d_fmt_conv_420sp_downscale(pu1_y_src, pu1_uv_src,
+                                        pu1_y_scaled, pu1_uv_scaled,
+                                        u4_out_wd, u4_rows,
                                         ps_op_frm->u4_y_strd,
                                         ps_op_frm->u4_u_strd,
-                                        pv_disp_op->s_disp_frm_buf.u4_y_strd,
-                                        1);
+                                        u4_out_wd, u4_out_wd,
+                                        u4_shift,
+                                        ps_dec->u4_out_scale_filter);
+
+        ih264d_format_convert_rows(ps_dec, pu1_y_scaled, pu1_uv_scaled,
+                                   u4_out_wd, u4_out_wd, u4_out_wd,
+                                   pv_disp_op, u4_out_row, u4_rows);
+        u4_out_row += u4_rows;
+    }
+}
+
+/*****************************************************************************/
+/*  Function Name : ih264d_format_convert_frame                              */
+/*                                                                           */
+/*  Description   : Converts u4_num_rows_y rows starting at u4_start_y of    */
+/*                  the 420SP picture described by ps_op_frm into the output */
+/*                  buffer of pv_disp_op                                     */
+/*  Inputs        : ps_dec - Decoder parameters                              */
+/*                  ps_op_frm - Source picture (cropped)                     */
+/*                  pv_disp_op - Destination buffer and format               */
+/*  Globals       : None                                                     */
+/*  Processing    : Calls the format specific conversion function, through  */
+/*                  the downscaler when a scaled output is requested         */
+/*  Outputs       : Converted rows in the output buffer                      */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+static void ih264d_format_convert_frame(dec_struct_t *ps_dec,
+                                        iv_yuv_buf_t *ps_op_frm,
+                                        ivd_get_display_frame_op_t *pv_disp_op,
+                                        UWORD32 u4_start_y,
+                                        UWORD32 u4_num_rows_y)
+{
+    UWORD8 *pu1_y_src, *pu1_uv_src;
+
+    if(1 == pv_disp_op->u4_error_code)
+        return;
+
+    /* Requires u4_start_y and u4_num_rows_y to be even */
+    if(u4_start_y & 1)
+    {
+        return;
+    }
+
+    if((1 == ps_dec->u4_share_disp_buf) &&
+       (pv_disp_op->e_output_format == IV_YUV_420SP_UV))
+    {
+        return;
+    }
+
+    /* Display handles reference the decoded picture in place */
+    if(ps_dec->u4_disp_handles)
+    {
+        return;
+    }
+
+    if(ps_dec->u4_out_scale_shift)
+    {
+        ih264d_format_convert_scaled(ps_dec, ps_op_frm, pv_disp_op,
+                                     u4_start_y, u4_num_rows_y);
+    }
+    else
+    {
+        pu1_y_src = (UWORD8 *)ps_op_frm->pv_y_buf;
+        pu1_y_src += u4_start_y * ps_op_frm->u4_y_strd;
+
+        pu1_uv_src = (UWORD8 *)ps_op_frm->pv_u_buf;
+        pu1_uv_src += (u4_start_y >> 1) * ps_op_frm->u4_u_strd;
+
+        ih264d_format_convert_rows(ps_dec, pu1_y_src, pu1_uv_src,
+                                   ps_op_frm->u4_y_strd,
+                                   ps_op_frm->u4_u_strd,
+                                   ps_op_frm->u4_y_wd,
+                                   pv_disp_op, u4_start_y, u4_num_rows_y);
     }
 
-    if((u4_start_y + u4_num_rows_y) >= ps_dec->s_disp_frame_info.u4_y_ht)
+    if((u4_start_y + u4_num_rows_y) >= ps_op_frm->u4_y_ht)
     {
 
         INSERT_LOGO(pv_disp_op->s_disp_frm_buf.pv_y_buf,
@@ -808,3 +1202,176 @@ void ih264d_format_convert(dec_struct_t *ps_dec,
 
     return;
 }
+
+/*****************************************************************************/
+/*  Function Name : ih264d_format_convert                                    */
+/*                                                                           */
+/*  Description   : Implements format conversion/frame copy                  */
+/*  Inputs        : ps_dec - Decoder parameters                              */
+/*  Globals       : None                                                     */
+/*  Processing    : Refer bumping process in the standard                    */
+/*  Outputs       : Assigns display sequence number.                         */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*  Revision History:                                                        */
+/*                                                                           */
+/*         DD MM YYYY   Author(s)       Changes (Describe the changes made)  */
+/*         27 04 2005   NS              Draft                                */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_format_convert(dec_struct_t *ps_dec,
+                           ivd_get_display_frame_op_t *pv_disp_op,
+                           UWORD32 u4_start_y,
+                           UWORD32 u4_num_rows_y)
+{
+    ih264d_format_convert_frame(ps_dec, &(ps_dec->s_disp_frame_info),
+                                pv_disp_op, u4_start_y, u4_num_rows_y);
+}
+
+/*****************************************************************************/
+/*  Function Name : ih264d_init_fused_fmt_conv                               */
+/*                                                                           */
+/*  Description   : Arms format conversion from the deblocking loop for the  */
+/*                  picture being started. Sets up the source and output     */
+/*                  descriptors the same way ih264d_get_next_display_field() */
+/*                  would for this picture                                   */
+/*  Inputs        : ps_dec - Decoder parameters                              */
+/*  Globals       : None                                                     */
+/*  Processing    : Fused conversion is used only when the current picture   */
+/*                  is displayed by this decode call, i.e. for frame         */
+/*                  pictures in IVD_DECODE_FRAME_OUT mode without shared     */
+/*                  display buffers                                          */
+/*  Outputs       : u4_fused_fmt_conv_active and the fused descriptors       */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_init_fused_fmt_conv(dec_struct_t *ps_dec)
+{
+    iv_yuv_buf_t *ps_op_frm = &(ps_dec->s_fused_frame_info);
+    ivd_get_display_frame_op_t *ps_disp_op = &(ps_dec->s_fused_disp_op);
+    ivd_out_bufdesc_t *ps_out_buffer = ps_dec->ps_out_buffer;
+    pic_buffer_t *ps_cur_pic = ps_dec->ps_cur_pic;
+    UWORD32 u4_y_wd, u4_y_ht, u4_y_strd;
+
+    ps_dec->u4_fused_fmt_conv_active = 0;
+    ps_dec->u4_fused_fmt_conv_cur_row = 0;
+
+    if((0 == ps_dec->u4_fused_fmt_conv)
+                    || (IVD_DECODE_FRAME_OUT != ps_dec->e_frm_out_mode)
+                    || (1 == ps_dec->u4_share_disp_buf)
+                    || ps_dec->u4_disp_handles
+                    || (NULL == ps_out_buffer)
+                    || (NULL == ps_cur_pic)
+                    || ps_dec->ps_cur_slice->u1_field_pic_flag
+                    || ps_dec->ps_cur_slice->u1_mbaff_frame_flag)
+    {
+        return;
+    }
+
+    ps_op_frm->u4_y_ht = (ps_dec->u2_disp_height >> 1) << 1;
+    ps_op_frm->u4_u_ht = ps_op_frm->u4_v_ht = ps_op_frm->u4_y_ht >> 1;
+    ps_op_frm->u4_y_wd = ps_dec->u2_disp_width;
+    ps_op_frm->u4_u_wd = ps_op_frm->u4_v_wd = ps_op_frm->u4_y_wd >> 1;
+    ps_op_frm->u4_y_strd = ps_dec->u2_frm_wd_y;
+    ps_op_frm->u4_u_strd = ps_op_frm->u4_v_strd = ps_dec->u2_frm_wd_uv
+                    << (1 - ps_dec->u1_chroma_ht_shift);
+    ps_op_frm->pv_y_buf = ps_cur_pic->pu1_buf1 + ps_dec->u2_crop_offset_y;
+    ps_op_frm->pv_u_buf = ps_cur_pic->pu1_buf2 + ps_dec->u2_crop_offset_uv;
+    ps_op_frm->pv_v_buf = ps_cur_pic->pu1_buf3 + ps_dec->u2_crop_offset_uv;
+
+    u4_y_wd = MIN(ps_op_frm->u4_y_wd, ps_op_frm->u4_y_strd);
+    u4_y_ht = ps_op_frm->u4_y_ht;
+    if(ps_dec->u4_out_scale_shift)
+    {
+        u4_y_wd = (u4_y_wd >> ps_dec->u4_out_scale_shift) & ~1;
+        u4_y_ht = (u4_y_ht >> ps_dec->u4_out_scale_shift) & ~1;
+    }
+    u4_y_strd = u4_y_wd;
+    if(ps_dec->u4_app_disp_width)
+        u4_y_strd = MAX(ps_dec->u4_app_disp_width, u4_y_strd);
+
+    ps_disp_op->u4_error_code = 0;
+    ps_disp_op->e_output_format = ps_dec->u1_chroma_format;
+    ps_disp_op->u4_disp_buf_id = ps_dec->u1_pic_buf_id;
+    ps_disp_op->s_disp_frm_buf.pv_y_buf = ps_out_buffer->pu1_bufs[0];
+    ps_disp_op->s_disp_frm_buf.pv_u_buf = ps_out_buffer->pu1_bufs[1];
+    ps_disp_op->s_disp_frm_buf.pv_v_buf = ps_out_buffer->pu1_bufs[2];
+    ps_disp_op->s_disp_frm_buf.u4_y_wd = u4_y_wd;
+    ps_disp_op->s_disp_frm_buf.u4_y_ht = u4_y_ht;
+    ps_disp_op->s_disp_frm_buf.u4_y_strd = u4_y_strd;
+
+    if((ps_disp_op->e_output_format == IV_YUV_420P)
+                    || (ps_disp_op->e_output_format == IV_YUV_422P))
+    {
+        ps_disp_op->s_disp_frm_buf.u4_u_strd = u4_y_strd >> 1;
+        ps_disp_op->s_disp_frm_buf.u4_v_strd = u4_y_strd >> 1;
+    }
+    else if((ps_disp_op->e_output_format == IV_YUV_420SP_UV)
+                    || (ps_disp_op->e_output_format == IV_YUV_420SP_VU))
+    {
+        ps_disp_op->s_disp_frm_buf.u4_u_strd = u4_y_strd;
+        ps_disp_op->s_disp_frm_buf.u4_v_strd = 0;
+    }
+    else
+    {
+        ps_disp_op->s_disp_frm_buf.u4_u_strd = 0;
+        ps_disp_op->s_disp_frm_buf.u4_v_strd = 0;
+    }
+
+    ps_dec->u4_fused_fmt_conv_buf_id = ps_dec->u1_pic_buf_id;
+    ps_dec->u4_fused_fmt_conv_active = 1;
+}
+
+/*****************************************************************************/
+/*  Function Name : ih264d_fused_fmt_conv_row                                */
+/*                                                                           */
+/*  Description   : Called by the deblocking loop after each MB row of the   */
+/*                  current picture is filtered. Converts the rows that the  */
+/*                  filtering of later MB rows can no longer modify          */
+/*  Inputs        : ps_dec - Decoder parameters                              */
+/*  Globals       : None                                                     */
+/*  Processing    : Filtering the top edge of MB row n + 1 modifies the last */
+/*                  3 luma rows and the last chroma row of MB row n, so      */
+/*                  conversion trails the deblocked rows by 4 luma rows      */
+/*                  until the last MB row is done                            */
+/*  Outputs       : u4_fused_fmt_conv_cur_row                                */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_fused_fmt_conv_row(dec_struct_t *ps_dec)
+{
+    iv_yuv_buf_t *ps_op_frm = &(ps_dec->s_fused_frame_info);
+    UWORD32 u4_crop_top = ps_dec->u2_crop_offset_y / ps_dec->u2_frm_wd_y;
+    UWORD32 u4_end_row;
+
+    if(ps_dec->u4_deblk_mb_y >= ps_dec->u2_frm_ht_in_mbs)
+    {
+        u4_end_row = ps_op_frm->u4_y_ht;
+    }
+    else
+    {
+        u4_end_row = (ps_dec->u4_deblk_mb_y << 4) - 4;
+        u4_end_row = (u4_end_row > u4_crop_top) ?
+                        ((u4_end_row - u4_crop_top) & ~1) : 0;
+        u4_end_row = MIN(u4_end_row, ps_op_frm->u4_y_ht);
+
+        /* Scaled rows are produced in pairs from 2 << shift source rows */
+        u4_end_row &= ~((2 << ps_dec->u4_out_scale_shift) - 1);
+    }
+
+    if(u4_end_row > ps_dec->u4_fused_fmt_conv_cur_row)
+    {
+        ih264d_format_convert_frame(ps_dec, ps_op_frm,
+                                    &(ps_dec->s_fused_disp_op),
+                                    ps_dec->u4_fused_fmt_conv_cur_row,
+                                    u4_end_row
+                                    - ps_dec->u4_fused_fmt_conv_cur_row);
+        ps_dec->u4_fused_fmt_conv_cur_row = u4_end_row;
+    }
+}
@@ -61,6 +61,31 @@
 #define COF_1U_0U          0XFFB5FFDA
 #define COF_1V_0V          0XFFA20070
 
+void ih264d_fmt_conv_420sp_to_420sp(UWORD8 *pu1_y_src,
+                                    UWORD8 *pu1_uv_src,
+                                    UWORD8 *pu1_y_dst,
+                                    UWORD8 *pu1_uv_dst,
+                                    WORD32 wd,
+                                    WORD32 ht,
+                                    WORD32 src_y_strd,
+                                    WORD32 src_uv_strd,
+                                    WORD32 dst_y_strd,
+                                    WORD32 dst_uv_strd);
+
+#define COEFF1          13073
+#define COEFF2          -3207
+#define COEFF3          -6664
+#define COEFF4          16530
+
+/* YUV to RGB coefficients in Q13, see ih264d_get_csc_coeffs() */
+#define CSC_Y_GAIN      0
+#define CSC_Y_OFFSET    1
+#define CSC_V_TO_R      2
+#define CSC_U_TO_G      3
+#define CSC_V_TO_G      4
+#define CSC_U_TO_B      5
+#define NUM_CSC_COEFFS  6
+
 void ih264d_fmt_conv_420sp_to_420p(UWORD8 *pu1_y_src,
                                    UWORD8 *pu1_uv_src,
                                    UWORD8 *pu1_y_dst,
@@ -86,17 +111,6 @@ void ih264d_fmt_conv_420sp_to_420sp_swap_uv(UWORD8 *pu1_y_src,
                                             WORD32 dst_y_strd,
                                             WORD32 dst_uv_strd);
 
-void ih264d_fmt_conv_420sp_to_420sp(UWORD8 *pu1_y_src,
-                                    UWORD8 *pu1_uv_src,
-                                    UWORD8 *pu1_y_dst,
-                                    UWORD8 *pu1_uv_dst,
-                                    WORD32 wd,
-                                    WORD32 ht,
-                                    WORD32 src_y_strd,
-                                    WORD32 src_uv_strd,
-                                    WORD32 dst_y_strd,
-                                    WORD32 dst_uv_strd);
-
 void ih264d_fmt_conv_420sp_to_rgb565(UWORD8 *pu1_y_src,
                                      UWORD8 *pu1_uv_src,
                                      UWORD16 *pu2_rgb_dst,
@@ -105,16 +119,151 @@ void ih264d_fmt_conv_420sp_to_rgb565(UWORD8 *pu1_y_src,
                                      WORD32 src_y_strd,
                                      WORD32 src_uv_strd,
                                      WORD32 dst_strd,
-                                     WORD32 is_u_first);
-#define COEFF1          13073
-#define COEFF2          -3207
-#define COEFF3          -6664
-#define COEFF4          16530
+                                     WORD32 is_u_first,
+                                     const WORD16 *pi2_csc_coeffs);
+
+void ih264d_fmt_conv_420sp_to_rgba8888(UWORD8 *pu1_y_src,
+                                       UWORD8 *pu1_uv_src,
+                                       UWORD32 *pu4_rgba_dst,
+                                       WORD32 wd,
+                                       WORD32 ht,
+                                       WORD32 src_y_strd,
+                                       WORD32 src_uv_strd,
+                                       WORD32 dst_strd,
+                                       WORD32 is_u_first,
+                                       const WORD16 *pi2_csc_coeffs);
+
+/* SSSE3 Declarations */
+void ih264d_fmt_conv_420sp_to_420p_ssse3(UWORD8 *pu1_y_src,
+                                         UWORD8 *pu1_uv_src,
+                                         UWORD8 *pu1_y_dst,
+                                         UWORD8 *pu1_u_dst,
+                                         UWORD8 *pu1_v_dst,
+                                         WORD32 wd,
+                                         WORD32 ht,
+                                         WORD32 src_y_strd,
+                                         WORD32 src_uv_strd,
+                                         WORD32 dst_y_strd,
+                                         WORD32 dst_uv_strd,
+                                         WORD32 is_u_first,
+                                         WORD32 disable_luma_copy);
+
+void ih264d_fmt_conv_420sp_to_420sp_swap_uv_ssse3(UWORD8 *pu1_y_src,
+                                                  UWORD8 *pu1_uv_src,
+                                                  UWORD8 *pu1_y_dst,
+                                                  UWORD8 *pu1_uv_dst,
+                                                  WORD32 wd,
+                                                  WORD32 ht,
+                                                  WORD32 src_y_strd,
+                                                  WORD32 src_uv_strd,
+                                                  WORD32 dst_y_strd,
+                                                  WORD32 dst_uv_strd);
+
+void ih264d_fmt_conv_420sp_to_rgb565_ssse3(UWORD8 *pu1_y_src,
+                                           UWORD8 *pu1_uv_src,
+                                           UWORD16 *pu2_rgb_dst,
+                                           WORD32 wd,
+                                           WORD32 ht,
+                                           WORD32 src_y_strd,
+                                           WORD32 src_uv_strd,
+                                           WORD32 dst_strd,
+                                           WORD32 is_u_first,
+                                           const WORD16 *pi2_csc_coeffs);
+
+void ih264d_fmt_conv_420sp_to_rgba8888_ssse3(UWORD8 *pu1_y_src,
+                                             UWORD8 *pu1_uv_src,
+                                             UWORD32 *pu4_rgba_dst,
+                                             WORD32 wd,
+                                             WORD32 ht,
+                                             WORD32 src_y_strd,
+                                             WORD32 src_uv_strd,
+                                             WORD32 dst_strd,
+                                             WORD32 is_u_first,
+                                             const WORD16 *pi2_csc_coeffs);
+
+/* AVX2 Declarations */
+void ih264d_fmt_conv_420sp_to_420p_avx2(UWORD8 *pu1_y_src,
+                                        UWORD8 *pu1_uv_src,
+                                        UWORD8 *pu1_y_dst,
+                                        UWORD8 *pu1_u_dst,
+                                        UWORD8 *pu1_v_dst,
+                                        WORD32 wd,
+                                        WORD32 ht,
+                                        WORD32 src_y_strd,
+                                        WORD32 src_uv_strd,
+                                        WORD32 dst_y_strd,
+                                        WORD32 dst_uv_strd,
+                                        WORD32 is_u_first,
+                                        WORD32 disable_luma_copy);
+
+void ih264d_fmt_conv_420sp_to_420sp_swap_uv_avx2(UWORD8 *pu1_y_src,
+                                                 UWORD8 *pu1_uv_src,
+                                                 UWORD8 *pu1_y_dst,
+                                                 UWORD8 *pu1_uv_dst,
+                                                 WORD32 wd,
+                                                 WORD32 ht,
+                                                 WORD32 src_y_strd,
+                                                 WORD32 src_uv_strd,
+                                                 WORD32 dst_y_strd,
+                                                 WORD32 dst_uv_strd);
+
+void ih264d_fmt_conv_420sp_to_rgb565_avx2(UWORD8 *pu1_y_src,
+                                          UWORD8 *pu1_uv_src,
+                                          UWORD16 *pu2_rgb_dst,
+                                          WORD32 wd,
+                                          WORD32 ht,
+                                          WORD32 src_y_strd,
+                                          WORD32 src_uv_strd,
+                                          WORD32 dst_strd,
+                                          WORD32 is_u_first,
+                                          const WORD16 *pi2_csc_coeffs);
+
+void ih264d_fmt_conv_420sp_to_rgba8888_avx2(UWORD8 *pu1_y_src,
+                                            UWORD8 *pu1_uv_src,
+                                            UWORD32 *pu4_rgba_dst,
+                                            WORD32 wd,
+                                            WORD32 ht,
+                                            WORD32 src_y_strd,
+                                            WORD32 src_uv_strd,
+                                            WORD32 dst_strd,
+                                            WORD32 is_u_first,
+                                            const WORD16 *pi2_csc_coeffs);
+
+void ih264d_fmt_conv_420sp_downscale(UWORD8 *pu1_y_src,
+                                     UWORD8 *pu1_uv_src,
+                                     UWORD8 *pu1_y_dst,
+                                     UWORD8 *pu1_uv_dst,
+                                     WORD32 wd,
+                                     WORD32 ht,
+                                     WORD32 src_y_strd,
+                                     WORD32 src_uv_strd,
+                                     WORD32 dst_y_strd,
+                                     WORD32 dst_uv_strd,
+                                     WORD32 shift,
+                                     WORD32 filter);
+
+void ih264d_fmt_conv_sp_to_422p(UWORD8 *pu1_y_src,
+                                UWORD8 *pu1_uv_src,
+                                UWORD8 *pu1_y_dst,
+                                UWORD8 *pu1_u_dst,
+                                UWORD8 *pu1_v_dst,
+                                WORD32 wd,
+                                WORD32 ht,
+                                WORD32 src_y_strd,
+                                WORD32 src_uv_strd,
+                                WORD32 dst_y_strd,
+                                WORD32 dst_uv_strd,
+                                WORD32 chroma_ht_shift);
+
+const WORD16 *ih264d_get_csc_coeffs(dec_struct_t *ps_dec);
 
 void ih264d_format_convert(dec_struct_t *ps_dec,
                            ivd_get_display_frame_op_t *pv_disp_op,
                            UWORD32 u4_start_y,
                            UWORD32 u4_num_rows_y);
 
+void ih264d_init_fused_fmt_conv(dec_struct_t *ps_dec);
+
+void ih264d_fused_fmt_conv_row(dec_struct_t *ps_dec);
 
 #endif /* _IH264D_FORMAT_CONV_H_ */
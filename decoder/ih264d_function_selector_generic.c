@@ -58,6 +58,7 @@
 #include "ih264_inter_pred_filters.h"
 
 #include "ih264d_structs.h"
+#include "ih264d_format_conv.h"
 #include "ih264d_function_selector.h"
 
 /**
@@ -139,6 +140,10 @@ void ih264d_init_function_ptr_generic(dec_struct_t *ps_codec)
     ps_codec->apf_intra_pred_chroma[1] = ih264_intra_pred_chroma_8x8_mode_horz;
     ps_codec->apf_intra_pred_chroma[2] = ih264_intra_pred_chroma_8x8_mode_dc;
     ps_codec->apf_intra_pred_chroma[3] = ih264_intra_pred_chroma_8x8_mode_plane;
+    ps_codec->apf_intra_pred_chroma_422[0] = ih264_intra_pred_chroma_8x16_mode_vert;
+    ps_codec->apf_intra_pred_chroma_422[1] = ih264_intra_pred_chroma_8x16_mode_horz;
+    ps_codec->apf_intra_pred_chroma_422[2] = ih264_intra_pred_chroma_8x16_mode_dc;
+    ps_codec->apf_intra_pred_chroma_422[3] = ih264_intra_pred_chroma_8x16_mode_plane;
 
     ps_codec->pf_default_weighted_pred_luma = ih264_default_weighted_pred_luma;
     ps_codec->pf_default_weighted_pred_chroma =
@@ -166,6 +171,9 @@ void ih264d_init_function_ptr_generic(dec_struct_t *ps_codec)
                     ih264_iquant_itrans_recon_chroma_4x4;
     ps_codec->pf_iquant_itrans_recon_chroma_4x4_dc =
                     ih264_iquant_itrans_recon_chroma_4x4_dc;
+    /* Per macroblock recon is used only when a SIMD variant is available */
+    ps_codec->pf_iquant_itrans_recon_luma_mb = NULL;
+    ps_codec->pf_iquant_itrans_recon_chroma_mb = NULL;
     ps_codec->pf_ihadamard_scaling_4x4 = ih264_ihadamard_scaling_4x4;
 
     /* Init fn ptr luma deblocking */
@@ -218,5 +226,13 @@ void ih264d_init_function_ptr_generic(dec_struct_t *ps_codec)
 
     ps_codec->pf_inter_pred_chroma = ih264_inter_pred_chroma;
 
+    /* Output format conversion */
+    ps_codec->pf_fmt_conv_420sp_to_420p = ih264d_fmt_conv_420sp_to_420p;
+    ps_codec->pf_fmt_conv_420sp_to_420sp_swap_uv =
+                    ih264d_fmt_conv_420sp_to_420sp_swap_uv;
+    ps_codec->pf_fmt_conv_420sp_to_rgb565 = ih264d_fmt_conv_420sp_to_rgb565;
+    ps_codec->pf_fmt_conv_420sp_to_rgba8888 =
+                    ih264d_fmt_conv_420sp_to_rgba8888;
+
     return;
 }
@@ -78,7 +78,7 @@
 /*****************************************************************************/
 
 UWORD32 ih264d_get_mb_info_cavlc_nonmbaff(dec_struct_t *ps_dec,
-                                          const UWORD16 u2_cur_mb_address,
+                                          const UWORD32 u4_cur_mb_address,
                                           dec_mb_info_t * ps_cur_mb_info,
                                           UWORD32 u4_mbskip_run)
 {
@@ -96,7 +96,7 @@ UWORD32 ih264d_get_mb_info_cavlc_nonmbaff(dec_struct_t *ps_dec,
     mb_x = (WORD16)ps_dec->u2_mbx;
     mb_y = (WORD16)ps_dec->u2_mby;
 
-    ps_dec->u2_cur_mb_addr = u2_cur_mb_address;
+    ps_dec->u4_cur_mb_addr = u4_cur_mb_address;
 
     mb_x++;
 
@@ -208,7 +208,7 @@ UWORD32 ih264d_get_mb_info_cavlc_nonmbaff(dec_struct_t *ps_dec,
 /*****************************************************************************/
 
 UWORD32 ih264d_get_mb_info_cavlc_mbaff(dec_struct_t *ps_dec,
-                                       const UWORD16 u2_cur_mb_address,
+                                       const UWORD32 u4_cur_mb_address,
                                        dec_mb_info_t * ps_cur_mb_info,
                                        UWORD32 u4_mbskip_run)
 {
@@ -217,7 +217,7 @@ UWORD32 ih264d_get_mb_info_cavlc_mbaff(dec_struct_t *ps_dec,
     UWORD8 u1_mb_ngbr_avail = 0;
     UWORD16 u2_frm_width_in_mb = ps_dec->u2_frm_wd_in_mbs;
 
-    UWORD8 u1_top_mb = 1 - (u2_cur_mb_address & 0x01);
+    UWORD8 u1_top_mb = 1 - (u4_cur_mb_address & 0x01);
     WORD16 i2_prev_slice_mbx = ps_dec->i2_prev_slice_mbx;
     UWORD8 u1_cur_mb_field = 0;
     UWORD16 u2_top_right_mask = TOP_RIGHT_DEFAULT_AVAILABLE;
@@ -229,7 +229,7 @@ UWORD32 ih264d_get_mb_info_cavlc_mbaff(dec_struct_t *ps_dec,
     u2_mb_x = ps_dec->u2_mbx;
     u2_mb_y = ps_dec->u2_mby;
 
-    ps_dec->u2_cur_mb_addr = u2_cur_mb_address;
+    ps_dec->u4_cur_mb_addr = u4_cur_mb_address;
 
 
     if(u1_top_mb)
@@ -360,7 +360,7 @@ UWORD32 ih264d_get_mb_info_cavlc_mbaff(dec_struct_t *ps_dec,
 /*                                                                           */
 /*****************************************************************************/
 UWORD32 ih264d_get_mb_info_cabac_nonmbaff(dec_struct_t *ps_dec,
-                                          const UWORD16 u2_cur_mb_address,
+                                          const UWORD32 u4_cur_mb_address,
                                           dec_mb_info_t * ps_cur_mb_info,
                                           UWORD32 u4_mbskip)
 {
@@ -380,7 +380,7 @@ UWORD32 ih264d_get_mb_info_cabac_nonmbaff(dec_struct_t *ps_dec,
     mb_x = (WORD16)ps_dec->u2_mbx;
     mb_y = (WORD16)ps_dec->u2_mby;
 
-    ps_dec->u2_cur_mb_addr = u2_cur_mb_address;
+    ps_dec->u4_cur_mb_addr = u4_cur_mb_address;
 
     mb_x++;
     if((UWORD32)mb_x == u2_frm_width_in_mb)
@@ -490,6 +490,7 @@ UWORD32 ih264d_get_mb_info_cabac_nonmbaff(dec_struct_t *ps_dec,
                 pu1_buf = ps_dec->pu1_left_nnz_uv;
                 pu4_buf = (UWORD32 *)pu1_buf;
                 *pu4_buf = 0;
+                pu4_buf[1] = 0;
 
 
                 *(ps_dec->pu1_left_yuv_dc_csbp) = 0;
@@ -542,7 +543,7 @@ UWORD32 ih264d_get_mb_info_cabac_nonmbaff(dec_struct_t *ps_dec,
 /*****************************************************************************/
 
 UWORD32 ih264d_get_mb_info_cabac_mbaff(dec_struct_t *ps_dec,
-                                       const UWORD16 u2_cur_mb_address,
+                                       const UWORD32 u4_cur_mb_address,
                                        dec_mb_info_t * ps_cur_mb_info,
                                        UWORD32 u4_mbskip)
 {
@@ -557,7 +558,7 @@ UWORD32 ih264d_get_mb_info_cabac_mbaff(dec_struct_t *ps_dec,
     UWORD32 u4_left_mb_pair_fld = 0;
     UWORD32 u4_top_mb_pair_fld = 0;
     UWORD8 u1_cur_mb_field = 0;
-    UWORD8 u1_top_mb = 1 - (u2_cur_mb_address & 0x01);
+    UWORD8 u1_top_mb = 1 - (u4_cur_mb_address & 0x01);
     WORD16 i2_prev_slice_mbx = ps_dec->i2_prev_slice_mbx;
     UWORD16 u2_top_right_mask = TOP_RIGHT_DEFAULT_AVAILABLE;
     UWORD16 u2_top_left_mask = TOP_LEFT_DEFAULT_AVAILABLE;
@@ -568,7 +569,7 @@ UWORD32 ih264d_get_mb_info_cabac_mbaff(dec_struct_t *ps_dec,
     mb_x = (WORD16)ps_dec->u2_mbx;
     mb_y = (WORD16)ps_dec->u2_mby;
 
-    ps_dec->u2_cur_mb_addr = u2_cur_mb_address;
+    ps_dec->u4_cur_mb_addr = u4_cur_mb_address;
 
     ps_top_ctxt = ps_left_ctxt = p_ctx_inc_mb_map - 1;
 
@@ -1430,7 +1431,8 @@ void ih264d_transfer_mb_group_data(dec_struct_t * ps_dec,
 
         u4_frame_stride = ps_dec->u2_frm_wd_uv
                         << ps_dec->ps_cur_slice->u1_field_pic_flag;
-        y_offset = (u2_mb_y * u4_frame_stride) << 3;
+        y_offset = (u2_mb_y * u4_frame_stride)
+                        << (4 - ps_dec->u1_chroma_ht_shift);
         ps_trns_addr->pu1_dest_u = ps_dec->s_cur_pic.pu1_buf2 + y_offset;
         ps_trns_addr->pu1_dest_v = ps_dec->s_cur_pic.pu1_buf3 + y_offset;
 
@@ -73,7 +73,7 @@
 typedef struct
 {
   mv_pred_t *ps_mv;     /** Ptr to the Mv bank */
-  UWORD16 u2_mb_addr_col;       /** Addr of the co-located MB */
+  UWORD32 u4_mb_addr_col;       /** Addr of the co-located MB */
   WORD16 i2_mv[2];      /** Mv of the colocated MB */
   WORD8 i1_ref_idx_col;     /** Ref idx of the co-located picture */
   UWORD8 u1_col_pic;        /** Idx of the colocated pic */
@@ -1345,7 +1345,7 @@ void ih264d_get_implicit_weights(dec_struct_t *ps_dec)
  *    0 on Success and Error code otherwise
  **************************************************************************
  */
-WORD32 ih264d_parse_bslice(dec_struct_t * ps_dec, UWORD16 u2_first_mb_in_slice)
+WORD32 ih264d_parse_bslice(dec_struct_t * ps_dec, UWORD32 u4_first_mb_in_slice)
 {
     dec_pic_params_t * ps_pps = ps_dec->ps_cur_pps;
     dec_slice_params_t * ps_slice = ps_dec->ps_cur_slice;
@@ -1692,7 +1692,7 @@ WORD32 ih264d_parse_bslice(dec_struct_t * ps_dec, UWORD16 u2_first_mb_in_slice)
         return ret;
     ps_dec->u1_B = 1;
     ps_dec->pf_mvpred_ref_tfr_nby2mb = ih264d_mv_pred_ref_tfr_nby2_bmb;
-    ret = ps_dec->pf_parse_inter_slice(ps_dec, ps_slice, u2_first_mb_in_slice);
+    ret = ps_dec->pf_parse_inter_slice(ps_dec, ps_slice, u4_first_mb_in_slice);
     if(ret != OK)
         return ret;
     return OK;
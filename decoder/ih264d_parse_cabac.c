@@ -1024,6 +1024,113 @@ void ih264d_read_coeff8x8_cabac(dec_bit_stream_t *ps_bitstrm,
     ps_bitstrm->u4_ofst = u4_offset;
 }
 
+/*!
+ **************************************************************************
+ * \if Function name : ih264d_read_coeff_chroma_dc_422_cabac \endif
+ *
+ * \brief
+ *    This function decodes the 2x4 chroma DC block of a 4:2:2 MB in CABAC
+ *    (7.3.5.3.3 with maxNumCoeff = 8). The coded_block_flag is decoded here
+ *    from ps_ctxt_coded; levels are stored in the TU layout used by
+ *    ih264d_read_coeff4x4_cabac.
+ *
+ * \return
+ *    Returns the coded_block_flag.
+ *
+ **************************************************************************
+ */
+UWORD8 ih264d_read_coeff_chroma_dc_422_cabac(dec_bit_stream_t *ps_bitstrm,
+                                             dec_struct_t *ps_dec,
+                                             bin_ctxt_model_t *ps_ctxt_coded)
+{
+    decoding_envirnoment_t *ps_cab_env = &ps_dec->s_cab_dec_env;
+    bin_ctxt_model_t *ps_ctxt_sig =
+                    ps_dec->p_significant_coeff_flag_t[CHROMA_DC_CTXCAT];
+    bin_ctxt_model_t *ps_ctxt_last = ps_ctxt_sig
+                    + LAST_COEFF_CTXT_MINUS_SIG_COEFF_CTXT;
+    bin_ctxt_model_t *ps_ctxt_abs =
+                    ps_dec->p_coeff_abs_level_minus1_t[CHROMA_DC_CTXCAT];
+    tu_sblk4x4_coeff_data_t *ps_tu_4x4;
+    WORD16 *pi2_coeff_data;
+    UWORD32 u4_num_sig = 0, u4_num_eq1 = 0, u4_num_gt1 = 0;
+    UWORD32 i;
+    WORD32 offset;
+
+    if(!ih264d_decode_bin(0, ps_ctxt_coded, ps_bitstrm, ps_cab_env))
+        return 0;
+
+    ps_tu_4x4 = (tu_sblk4x4_coeff_data_t *)ps_dec->pv_parse_tu_coeff_data;
+    ps_tu_4x4->u2_sig_coeff_map = 0;
+    pi2_coeff_data = &ps_tu_4x4->ai2_level[0];
+
+    /* Significance map, ctxIdxInc = Min(numDecodAbsLevel / NumC8x8, 2) */
+    for(i = 0; i < 7; i++)
+    {
+        UWORD32 u4_ctx_inc = MIN((i >> 1), 2);
+
+        if(ih264d_decode_bin(u4_ctx_inc, ps_ctxt_sig, ps_bitstrm, ps_cab_env))
+        {
+            SET_BIT(ps_tu_4x4->u2_sig_coeff_map, i);
+            u4_num_sig++;
+            if(ih264d_decode_bin(u4_ctx_inc, ps_ctxt_last, ps_bitstrm,
+                                 ps_cab_env))
+                break;
+        }
+    }
+    /* Last position is significant when no last flag was decoded */
+    if(7 == i)
+    {
+        SET_BIT(ps_tu_4x4->u2_sig_coeff_map, 7);
+        u4_num_sig++;
+    }
+
+    /* Levels in reverse scan order */
+    while(u4_num_sig--)
+    {
+        UWORD32 u4_ctx_inc = u4_num_gt1 ? 0 : MIN(4, (1 + u4_num_eq1));
+        UWORD32 u4_prefix = 0;
+        WORD32 i4_abs_lvl;
+
+        if(ih264d_decode_bin(u4_ctx_inc, ps_ctxt_abs, ps_bitstrm, ps_cab_env))
+        {
+            u4_ctx_inc = 5 + MIN(3, u4_num_gt1);
+            u4_prefix = 1;
+            while((u4_prefix < UCOFF_LEVEL)
+                            && ih264d_decode_bin(u4_ctx_inc, ps_ctxt_abs,
+                                                 ps_bitstrm, ps_cab_env))
+                u4_prefix++;
+        }
+        i4_abs_lvl = 1 + u4_prefix;
+
+        if(UCOFF_LEVEL == u4_prefix)
+        {
+            /* Exp-Golomb (k = 0) suffix */
+            UWORD32 u4_k = ih264d_decode_bypass_bins_unary(ps_cab_env,
+                                                           ps_bitstrm);
+            i4_abs_lvl += (1 << u4_k) - 1;
+            if(u4_k)
+                i4_abs_lvl += ih264d_decode_bypass_bins(ps_cab_env, u4_k,
+                                                        ps_bitstrm);
+        }
+
+        if(1 == i4_abs_lvl)
+            u4_num_eq1++;
+        else
+            u4_num_gt1++;
+
+        if(ih264d_decode_bypass_bins(ps_cab_env, 1, ps_bitstrm))
+            i4_abs_lvl = -i4_abs_lvl;
+
+        *pi2_coeff_data++ = i4_abs_lvl;
+    }
+
+    offset = (UWORD8 *)pi2_coeff_data - (UWORD8 *)ps_tu_4x4;
+    offset = ALIGN4(offset);
+    ps_dec->pv_parse_tu_coeff_data = (void *)((UWORD8 *)ps_dec->pv_parse_tu_coeff_data + offset);
+
+    return 1;
+}
+
 /*****************************************************************************/
 /*                                                                           */
 /*  Function Name : ih264d_cabac_parse_8x8block                                     */
@@ -1220,6 +1327,7 @@ WORD32 ih264d_parse_residual4x4_cabac(dec_struct_t * ps_dec,
             pu1_buf = ps_dec->pu1_left_nnz_uv;
             pu4_buf = (UWORD32 *)pu1_buf;
             *pu4_buf = 0;
+            pu4_buf[1] = 0;
         }
         else
         {
@@ -1230,6 +1338,7 @@ WORD32 ih264d_parse_residual4x4_cabac(dec_struct_t * ps_dec,
             pu1_buf = ps_dec->pu1_left_nnz_uv;
             pu4_buf = (UWORD32 *)pu1_buf;
             *pu4_buf = 0x01010101;
+            pu4_buf[1] = 0x01010101;
         }
     }
 
@@ -1460,6 +1569,7 @@ WORD32 ih264d_parse_residual4x4_cabac(dec_struct_t * ps_dec,
             ps_dec->pu1_left_yuv_dc_csbp[0] &= 0x1;
             *(UWORD32 *)(pu1_top_nnz) = 0;
             *(UWORD32 *)(pu1_left_nnz) = 0;
+            *(UWORD32 *)(pu1_left_nnz + 4) = 0;
             p_curr_ctxt->u1_yuv_dc_csbp &= 0x1;
             return (0);
         }
@@ -1498,11 +1608,16 @@ WORD32 ih264d_parse_residual4x4_cabac(dec_struct_t * ps_dec,
 
             ps_src_bin_ctxt = (ps_dec->p_cbf_t[CHROMA_DC_CTXCAT]) + u4_ctx_inc;
 
-            uc_codedBlockFlag =
-                            ih264d_read_coeff4x4_cabac(ps_bitstrm,
-                                            CHROMA_DC_CTXCAT,
-                                            ps_dec->p_significant_coeff_flag_t[CHROMA_DC_CTXCAT],
-                                            ps_dec, ps_src_bin_ctxt);
+            if(0 == ps_dec->u1_chroma_ht_shift)
+                uc_codedBlockFlag =
+                                ih264d_read_coeff_chroma_dc_422_cabac(ps_bitstrm,
+                                                ps_dec, ps_src_bin_ctxt);
+            else
+                uc_codedBlockFlag =
+                                ih264d_read_coeff4x4_cabac(ps_bitstrm,
+                                                CHROMA_DC_CTXCAT,
+                                                ps_dec->p_significant_coeff_flag_t[CHROMA_DC_CTXCAT],
+                                                ps_dec, ps_src_bin_ctxt);
 
             i4_mb_inter_inc = (!((ps_cur_mb_info->ps_curmb->u1_mb_type == I_4x4_MB)
                             || (ps_cur_mb_info->ps_curmb->u1_mb_type == I_16x16_MB)))
@@ -1528,26 +1643,55 @@ WORD32 ih264d_parse_residual4x4_cabac(dec_struct_t * ps_dec,
                 SET_BIT(u1_top_dc_csbp, i);
                 SET_BIT(u1_left_dc_csbp, i);
 
-                ai2_dc_coef[0] = 0;
-                ai2_dc_coef[1] = 0;
-                ai2_dc_coef[2] = 0;
-                ai2_dc_coef[3] = 0;
-
-                ih264d_unpack_coeff4x4_dc_4x4blk(ps_tu_4x4,
-                                                 ai2_dc_coef,
-                                                 pu1_inv_scan);
-                i_z0 = (ai2_dc_coef[0] + ai2_dc_coef[2]);
-                i_z1 = (ai2_dc_coef[0] - ai2_dc_coef[2]);
-                i_z2 = (ai2_dc_coef[1] - ai2_dc_coef[3]);
-                i_z3 = (ai2_dc_coef[1] + ai2_dc_coef[3]);
-
-                /*-----------------------------------------------------------*/
-                /* Scaling and storing the values back                       */
-                /*-----------------------------------------------------------*/
-                *pi2_coeff_data++ = ((i_z0 + i_z3) * u4_scale) >> 5;
-                *pi2_coeff_data++ = ((i_z0 - i_z3) * u4_scale) >> 5;
-                *pi2_coeff_data++ = ((i_z1 + i_z2) * u4_scale) >> 5;
-                *pi2_coeff_data++ = ((i_z1 - i_z2) * u4_scale) >> 5;
+                if(0 == ps_dec->u1_chroma_ht_shift)
+                {
+                    WORD16 ai2_dc_coef_422[8];
+                    WORD32 i4_qp, i4_weight, k;
+
+                    for(k = 0; k < 8; k++)
+                        ai2_dc_coef_422[k] = 0;
+
+                    ih264d_unpack_coeff4x4_dc_4x4blk(
+                                    ps_tu_4x4, ai2_dc_coef_422,
+                                    (UWORD8 *)gau1_ih264d_inv_scan_chroma_dc_422);
+
+                    i4_qp = (i) ?
+                                    (ps_dec->u1_qp_v_div6 * 6 + ps_dec->u1_qp_v_rem6) :
+                                    (ps_dec->u1_qp_u_div6 * 6 + ps_dec->u1_qp_u_rem6);
+                    i4_weight = 16;
+                    if(ps_dec->s_high_profile.u1_scaling_present)
+                        i4_weight = ps_dec->s_high_profile.i2_scalinglist4x4[i4_mb_inter_inc
+                                        + 1 + i][0];
+
+                    /* DC values overwrite the parsed TU, which has been consumed */
+                    ih264d_iquant_itrans_chroma_dc_422(ai2_dc_coef_422,
+                                                       pi2_coeff_data,
+                                                       i4_qp, i4_weight);
+                    pi2_coeff_data += 8;
+                }
+                else
+                {
+                    ai2_dc_coef[0] = 0;
+                    ai2_dc_coef[1] = 0;
+                    ai2_dc_coef[2] = 0;
+                    ai2_dc_coef[3] = 0;
+
+                    ih264d_unpack_coeff4x4_dc_4x4blk(ps_tu_4x4,
+                                                     ai2_dc_coef,
+                                                     pu1_inv_scan);
+                    i_z0 = (ai2_dc_coef[0] + ai2_dc_coef[2]);
+                    i_z1 = (ai2_dc_coef[0] - ai2_dc_coef[2]);
+                    i_z2 = (ai2_dc_coef[1] - ai2_dc_coef[3]);
+                    i_z3 = (ai2_dc_coef[1] + ai2_dc_coef[3]);
+
+                    /*-------------------------------------------------------*/
+                    /* Scaling and storing the values back                   */
+                    /*-------------------------------------------------------*/
+                    *pi2_coeff_data++ = ((i_z0 + i_z3) * u4_scale) >> 5;
+                    *pi2_coeff_data++ = ((i_z0 - i_z3) * u4_scale) >> 5;
+                    *pi2_coeff_data++ = ((i_z1 + i_z2) * u4_scale) >> 5;
+                    *pi2_coeff_data++ = ((i_z1 - i_z2) * u4_scale) >> 5;
+                }
 
                 ps_dec->pv_parse_tu_coeff_data = (void *)pi2_coeff_data;
 
@@ -1571,11 +1715,38 @@ WORD32 ih264d_parse_residual4x4_cabac(dec_struct_t * ps_dec,
         {
             *(UWORD32 *)(pu1_top_nnz) = 0;
             *(UWORD32 *)(pu1_left_nnz) = 0;
+            *(UWORD32 *)(pu1_left_nnz + 4) = 0;
             return (0);
         }
         /*--------------------------------------------------------------------*/
         /* Decode Chroma AC values                                            */
         /*--------------------------------------------------------------------*/
+        if(0 == ps_dec->u1_chroma_ht_shift)
+        {
+            /*****************************************************************/
+            /* 4:2:2 - two 8x8 blocks per component, top nnz carries over    */
+            /* from the upper to the lower 8x8                               */
+            /*****************************************************************/
+            UWORD32 u4_temp, u4_comp;
+
+            for(u4_comp = 0; u4_comp < 2; u4_comp++)
+            {
+                u4_temp = ih264d_cabac_parse_8x8block(pi2_coeff_block, 2,
+                                                      CHROMA_AC_CTXCAT, ps_dec,
+                                                      pu1_top_nnz + 2 * u4_comp,
+                                                      pu1_left_nnz + 2 * u4_comp);
+                u2_chroma_csbp |= (u4_temp << (8 * u4_comp));
+                pi2_coeff_block += MB_CHROM_SIZE;
+
+                u4_temp = ih264d_cabac_parse_8x8block(pi2_coeff_block, 2,
+                                                      CHROMA_AC_CTXCAT, ps_dec,
+                                                      pu1_top_nnz + 2 * u4_comp,
+                                                      pu1_left_nnz + 4 + 2 * u4_comp);
+                u2_chroma_csbp |= (u4_temp << (8 * u4_comp + 4));
+                pi2_coeff_block += MB_CHROM_SIZE;
+            }
+        }
+        else
         {
             UWORD32 u4_temp;
             /*****************************************************************/
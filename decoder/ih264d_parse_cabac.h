@@ -47,6 +47,10 @@ UWORD8 ih264d_read_coeff4x4_cabac(dec_bit_stream_t *ps_bitstrm,
                                   dec_struct_t *ps_dec,
                                   bin_ctxt_model_t *ps_ctxt_coded);
 
+UWORD8 ih264d_read_coeff_chroma_dc_422_cabac(dec_bit_stream_t *ps_bitstrm,
+                                             dec_struct_t *ps_dec,
+                                             bin_ctxt_model_t *ps_ctxt_coded);
+
 void ih264d_read_coeff8x8_cabac(dec_bit_stream_t *ps_bitstrm,
                                 dec_struct_t *ps_dec,
                                 dec_mb_info_t *ps_cur_mb_info);
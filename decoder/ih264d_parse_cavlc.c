@@ -48,6 +48,10 @@
 void ih264d_unpack_coeff4x4_dc_4x4blk(tu_sblk4x4_coeff_data_t *ps_tu_4x4,
                                       WORD16 *pi2_out_coeff_data,
                                       UWORD8 *pu1_inv_scan);
+void ih264d_iquant_itrans_chroma_dc_422(WORD16 *pi2_src,
+                                        WORD16 *pi2_out,
+                                        WORD32 i4_qp,
+                                        WORD32 i4_weight);
 
 /*****************************************************************************/
 /*                                                                           */
@@ -1001,10 +1005,10 @@ void ih264d_rest_of_residual_cav_chroma_dc_block(UWORD32 u4_total_coeff_trail_on
     UWORD32 u4_bitstream_offset = ps_bitstrm->u4_ofst;
     UWORD32 u4_trailing_ones = u4_total_coeff_trail_one & 0xFFFF;
     UWORD32 u4_total_coeff = u4_total_coeff_trail_one >> 16;
-    // To avoid error check at 4x4 level, allocating for 3 extra levels(4+3)
+    // To avoid error check at 4x4 level, allocating for 3 extra levels(8+3)
     // since u4_trailing_ones can at the max be 3. This will be required when
-    // u4_total_coeff is less than u4_trailing_ones
-    WORD16 ai2_level_arr[7];//
+    // u4_total_coeff is less than u4_trailing_ones. 4:2:2 blocks have 8 coeffs
+    WORD16 ai2_level_arr[11];//
     WORD16 *i2_level_arr = &ai2_level_arr[3];
 
     tu_sblk4x4_coeff_data_t *ps_tu_4x4;
@@ -1139,7 +1143,21 @@ void ih264d_rest_of_residual_cav_chroma_dc_block(UWORD32 u4_total_coeff_trail_on
         /****************************************************************/
     }
 
-    if(u4_total_coeff < 4)
+    if(0 == ps_dec->u1_chroma_ht_shift)
+    {
+        /* 4:2:2 ChromaDC, total zeros as per Table 9-9(b) */
+        if(u4_total_coeff < 8)
+        {
+            UWORD32 u4_code;
+            NEXTBITS(u4_code, u4_bitstream_offset, pu4_bitstrm_buf, 5);
+            u4_code = gau1_ih264d_table_total_zero_422_dc[u4_total_coeff - 1][u4_code];
+            FLUSHBITS(u4_bitstream_offset, (u4_code >> 4));
+            u4_total_zeroes = u4_code & 0xf;
+        }
+        else
+            u4_total_zeroes = 0;
+    }
+    else if(u4_total_coeff < 4)
     {
         UWORD32 u4_max_ldz = (4 - u4_total_coeff);
         FIND_ONE_IN_STREAM_LEN(u4_total_zeroes, u4_bitstream_offset,
@@ -1452,6 +1470,89 @@ void ih264d_cavlc_parse_chroma_dc(dec_mb_info_t *ps_cur_mb_info,
     }
 }
 
+/*!
+ **************************************************************************
+ * \if Function name : ih264d_cavlc_parse_chroma_dc_422 \endif
+ *
+ * \brief
+ *    This function does cavlc parsing of the 2x4 chromDc blocks of a 4:2:2
+ *    MB (nC = -2), followed by their inverse transform and scaling.
+ *
+ * \return
+ *    Returns 0 on success, error code for an invalid coeff_token.
+ *
+ **************************************************************************
+ */
+
+WORD32 ih264d_cavlc_parse_chroma_dc_422(dec_mb_info_t *ps_cur_mb_info,
+                                        dec_bit_stream_t *ps_bitstrm,
+                                        WORD32 i4_mb_inter_inc)
+{
+    dec_struct_t *ps_dec = (dec_struct_t *)ps_bitstrm->pv_codec_handle;
+    UWORD32 *pu4_bitstrm_buf = ps_bitstrm->pu4_buffer;
+    WORD32 i4_comp;
+
+    for(i4_comp = 0; i4_comp < 2; i4_comp++)
+    {
+        UWORD32 u4_bitstream_offset = ps_bitstrm->u4_ofst;
+        UWORD32 u4_ldz, u4_code, u4_total_coeff;
+
+        FIND_ONE_IN_STREAM_LEN(u4_ldz, u4_bitstream_offset, pu4_bitstrm_buf,
+                               11);
+        if(u4_ldz >= 11)
+            return ERROR_CAVLC_NUM_COEFF_T;
+
+        NEXTBITS(u4_code, u4_bitstream_offset, pu4_bitstrm_buf, 3);
+        u4_code = gau1_ih264d_cav_chromdc422_vld[u4_ldz][u4_code];
+        if(0xFF == u4_code)
+            return ERROR_CAVLC_NUM_COEFF_T;
+
+        FLUSHBITS(u4_bitstream_offset, (u4_code & 0x3));
+        ps_bitstrm->u4_ofst = u4_bitstream_offset;
+
+        u4_total_coeff = (u4_code >> 4);
+
+        if(u4_total_coeff)
+        {
+            tu_sblk4x4_coeff_data_t *ps_tu_4x4;
+            WORD16 ai2_dc_coef[8];
+            WORD16 *pi2_coeff_data =
+                            (WORD16 *)ps_dec->pv_parse_tu_coeff_data;
+            WORD32 i4_qp, i4_weight;
+
+            ps_tu_4x4 = (tu_sblk4x4_coeff_data_t *)ps_dec->pv_parse_tu_coeff_data;
+
+            ih264d_rest_of_residual_cav_chroma_dc_block(
+                            (u4_total_coeff << 16) | ((u4_code >> 2) & 0x3),
+                            ps_bitstrm);
+
+            memset(ai2_dc_coef, 0, sizeof(ai2_dc_coef));
+            ih264d_unpack_coeff4x4_dc_4x4blk(
+                            ps_tu_4x4, ai2_dc_coef,
+                            (UWORD8 *)gau1_ih264d_inv_scan_chroma_dc_422);
+
+            if(0 == i4_comp)
+                i4_qp = ps_dec->u1_qp_u_div6 * 6 + ps_dec->u1_qp_u_rem6;
+            else
+                i4_qp = ps_dec->u1_qp_v_div6 * 6 + ps_dec->u1_qp_v_rem6;
+
+            i4_weight = 16;
+            if(ps_dec->s_high_profile.u1_scaling_present)
+                i4_weight = ps_dec->s_high_profile.i2_scalinglist4x4[i4_mb_inter_inc
+                                + 1 + i4_comp][0];
+
+            /* DC values overwrite the parsed TU, which has been consumed */
+            ih264d_iquant_itrans_chroma_dc_422(ai2_dc_coef, pi2_coeff_data,
+                                               i4_qp, i4_weight);
+
+            ps_dec->pv_parse_tu_coeff_data = (void *)(pi2_coeff_data + 8);
+
+            SET_BIT(ps_cur_mb_info->u1_yuv_dc_block_flag, 1 + i4_comp);
+        }
+    }
+    return OK;
+}
+
 /*****************************************************************************/
 /*                                                                           */
 /*  Function Name : ih264d_parse_pmb_ref_index_cavlc_range1                         */
@@ -2624,6 +2725,7 @@ WORD32 ih264d_parse_residual4x4_cavlc(dec_struct_t * ps_dec,
         {
             *(UWORD32 *)(pu1_top_nnz) = 0;
             *(UWORD32 *)(pu1_left_nnz) = 0;
+            *(UWORD32 *)(pu1_left_nnz + 4) = 0;
         }
 
         if(u1_cbp == CBPC_ALLZERO)
@@ -2633,6 +2735,19 @@ WORD32 ih264d_parse_residual4x4_cavlc(dec_struct_t * ps_dec,
         /*--------------------------------------------------------------------*/
         /* Decode Chroma DC values                                            */
         /*--------------------------------------------------------------------*/
+        if(0 == ps_dec->u1_chroma_ht_shift)
+        {
+            WORD32 i4_mb_inter_inc;
+            i4_mb_inter_inc = (!((ps_cur_mb_info->ps_curmb->u1_mb_type == I_4x4_MB)
+                            || (ps_cur_mb_info->ps_curmb->u1_mb_type == I_16x16_MB)))
+                            * 3;
+            ret = ih264d_cavlc_parse_chroma_dc_422(ps_cur_mb_info,
+                                                   ps_dec->ps_bitstrm,
+                                                   i4_mb_inter_inc);
+            if(ret != OK)
+                return ret;
+        }
+        else
         {
             WORD32 u4_scale_u;
             WORD32 u4_scale_v;
@@ -2674,6 +2789,38 @@ WORD32 ih264d_parse_residual4x4_cavlc(dec_struct_t * ps_dec,
         /*--------------------------------------------------------------------*/
         /* Decode Chroma AC values                                            */
         /*--------------------------------------------------------------------*/
+        if(0 == ps_dec->u1_chroma_ht_shift)
+        {
+            /*****************************************************************/
+            /* 4:2:2: two 8x8 blocks per component. The bottom block uses    */
+            /* the top block's last row nnz (left in pu1_top_nnz by the      */
+            /* first call) and the bottom half of the left nnz               */
+            /*****************************************************************/
+            UWORD32 u4_temp, i;
+
+            for(i = 0; i < 2; i++)
+            {
+                ret = pf_cavlc_parse_8x8block[u4_nbr_avl](
+                            pi2_coeff_block, 2, 1, ps_dec,
+                            (pu1_top_nnz + 2 * i), (pu1_left_nnz + 2 * i),
+                            0, 0, &u4_temp);
+                if(ret != OK)
+                    return ret;
+                u2_chroma_csbp |= (u4_temp << (8 * i));
+
+                pi2_coeff_block += MB_CHROM_SIZE;
+                ret = pf_cavlc_parse_8x8block[u4_nbr_avl | 0x2](
+                            pi2_coeff_block, 2, 1, ps_dec,
+                            (pu1_top_nnz + 2 * i), (pu1_left_nnz + 4 + 2 * i),
+                            0, 0, &u4_temp);
+                if(ret != OK)
+                    return ret;
+                u2_chroma_csbp |= (u4_temp << (8 * i + 4));
+
+                pi2_coeff_block += MB_CHROM_SIZE;
+            }
+        }
+        else
         {
             UWORD32 u4_temp;
             /*****************************************************************/
@@ -100,6 +100,10 @@ void ih264d_cavlc_parse_chroma_dc(dec_mb_info_t *ps_cur_mb_info,
                                   UWORD32 u4_scale_v,
                                   WORD32 i4_mb_inter_inc);
 
+WORD32 ih264d_cavlc_parse_chroma_dc_422(dec_mb_info_t *ps_cur_mb_info,
+                                        dec_bit_stream_t *ps_bitstrm,
+                                        WORD32 i4_mb_inter_inc);
+
 WORD32 ih264d_cavlc_parse_8x8block_none_available(WORD16 *pi2_coeff_block,
                                                   UWORD32 u4_sub_block_strd,
                                                   UWORD32 u4_isdc,
@@ -320,7 +320,7 @@ WORD32 ih264d_parse_pps(dec_struct_t * ps_dec, dec_bit_stream_t * ps_bitstrm)
 
     /* High profile related syntax elements */
     u1_more_data_flag = MORE_RBSP_DATA(ps_bitstrm);
-    if(u1_more_data_flag && (ps_pps->ps_sps->u1_profile_idc == HIGH_PROFILE_IDC))
+    if(u1_more_data_flag && (ps_pps->ps_sps->u1_profile_idc >= HIGH_PROFILE_IDC))
     {
         /* read transform_8x8_mode_flag  */
         ps_pps->i4_transform_8x8_mode_flag = (WORD32)ih264d_get_bit_h264(
@@ -442,13 +442,27 @@ UWORD32 ih264d_correct_level_idc(UWORD32 u4_level_idc, UWORD32 u4_total_mbs)
         default:
             u4_max_mbs_allowed = MAX_MBS_LEVEL_51;
             break;
+        case H264_LEVEL_5_2:
+            u4_max_mbs_allowed = MAX_MBS_LEVEL_52;
+            break;
+        case H264_LEVEL_6_0:
+            u4_max_mbs_allowed = MAX_MBS_LEVEL_60;
+            break;
+        case H264_LEVEL_6_1:
+            u4_max_mbs_allowed = MAX_MBS_LEVEL_61;
+            break;
+        case H264_LEVEL_6_2:
+            u4_max_mbs_allowed = MAX_MBS_LEVEL_62;
+            break;
 
     }
 
     /*correct of the level is incorrect*/
     if(u4_total_mbs > u4_max_mbs_allowed)
     {
-        if(u4_total_mbs > MAX_MBS_LEVEL_50)
+        if(u4_total_mbs > MAX_MBS_LEVEL_52)
+            u4_level_idc = H264_LEVEL_6_0;
+        else if(u4_total_mbs > MAX_MBS_LEVEL_50)
             u4_level_idc = H264_LEVEL_5_1;
         else if(u4_total_mbs > MAX_MBS_LEVEL_42)
             u4_level_idc = H264_LEVEL_5_0;
@@ -493,6 +507,7 @@ WORD32 ih264d_parse_sps(dec_struct_t *ps_dec, dec_bit_stream_t *ps_bitstrm)
     UWORD32 u2_frm_ht_uv = 0;
     UWORD32 u2_crop_offset_y = 0;
     UWORD32 u2_crop_offset_uv = 0;
+    UWORD8 u1_chroma_ht_shift;
     WORD32 ret;
 
     /* High profile related syntax element */
@@ -528,7 +543,9 @@ WORD32 ih264d_parse_sps(dec_struct_t *ps_dec, dec_bit_stream_t *ps_bitstrm)
 
     (u1_profile_idc != BASE_PROFILE_IDC) &&
 
-    (u1_profile_idc != HIGH_PROFILE_IDC)
+    (u1_profile_idc != HIGH_PROFILE_IDC) &&
+
+    (u1_profile_idc != HIGH422_PROFILE_IDC)
 
     )
     {
@@ -583,15 +600,16 @@ WORD32 ih264d_parse_sps(dec_struct_t *ps_dec, dec_bit_stream_t *ps_bitstrm)
     ps_seq->i4_bit_depth_chroma_minus8 = 0;
     ps_seq->i4_qpprime_y_zero_transform_bypass_flag = 0;
     ps_seq->i4_seq_scaling_matrix_present_flag = 0;
-    if(u1_profile_idc == HIGH_PROFILE_IDC)
+    if(u1_profile_idc >= HIGH_PROFILE_IDC)
     {
 
         /* reading chroma_format_idc   */
         ps_seq->i4_chroma_format_idc = ih264d_uev(pu4_bitstrm_ofst,
                                                   pu4_bitstrm_buf);
 
-        /* Monochrome is not supported */
-        if(ps_seq->i4_chroma_format_idc != 1)
+        /* Only 4:2:0 and (8 bit, intra) 4:2:2 are supported */
+        if((ps_seq->i4_chroma_format_idc != 1)
+                        && (ps_seq->i4_chroma_format_idc != 2))
         {
             return ERROR_INV_SPS_PPS_T;
         }
@@ -763,13 +781,13 @@ WORD32 ih264d_parse_sps(dec_struct_t *ps_dec, dec_bit_stream_t *ps_bitstrm)
     /*--------------------------------------------------------------------*/
     /* Get the value of MaxMbAddress and Number of bits needed for it     */
     /*--------------------------------------------------------------------*/
-    ps_seq->u2_max_mb_addr = (ps_seq->u2_frm_wd_in_mbs
+    ps_seq->u4_max_mb_addr = (ps_seq->u2_frm_wd_in_mbs
                     * ps_seq->u2_frm_ht_in_mbs) - 1;
 
-    ps_seq->u2_total_num_of_mbs = ps_seq->u2_max_mb_addr + 1;
+    ps_seq->u4_total_num_of_mbs = ps_seq->u4_max_mb_addr + 1;
 
     ps_seq->u1_level_idc = ih264d_correct_level_idc(
-                    u1_level_idc, ps_seq->u2_total_num_of_mbs);
+                    u1_level_idc, ps_seq->u4_total_num_of_mbs);
 
     u1_frm = ih264d_get_bit_h264(ps_bitstrm);
     ps_seq->u1_frame_mbs_only_flag = u1_frm;
@@ -787,6 +805,15 @@ WORD32 ih264d_parse_sps(dec_struct_t *ps_dec, dec_bit_stream_t *ps_bitstrm)
     else
         ps_seq->u1_mb_aff_flag = 0;
 
+    /* 4:2:2 is supported for progressive frames only, and needs chroma   */
+    /* buffers larger than the 4:2:0 display buffers an application shares */
+    if((2 == ps_seq->i4_chroma_format_idc)
+                    && ((!u1_frm) || (1 == ps_dec->u4_share_disp_buf)))
+    {
+        return ERROR_FEATURE_UNAVAIL;
+    }
+    u1_chroma_ht_shift = (2 == ps_seq->i4_chroma_format_idc) ? 0 : 1;
+
     ps_seq->u1_direct_8x8_inference_flag = ih264d_get_bit_h264(ps_bitstrm);
 
     COPYTHECONTEXT("SPS: direct_8x8_inference_flag",
@@ -832,8 +859,9 @@ WORD32 ih264d_parse_sps(dec_struct_t *ps_dec, dec_bit_stream_t *ps_bitstrm)
     u2_frm_wd_uv = u2_pic_wd + (UWORD8)(PAD_LEN_UV_H << 2);
     u2_frm_wd_uv = MAX(u2_frm_wd_uv, u2_frm_wd_y);
 
-    u2_frm_ht_uv = (u2_pic_ht >> 1) + (UWORD8)(PAD_LEN_UV_V << 2);
-    u2_frm_ht_uv = MAX(u2_frm_ht_uv, (u2_frm_ht_y >> 1));
+    u2_frm_ht_uv = (u2_pic_ht >> u1_chroma_ht_shift)
+                    + (UWORD8)(PAD_LEN_UV_V << 2);
+    u2_frm_ht_uv = MAX(u2_frm_ht_uv, (u2_frm_ht_y >> u1_chroma_ht_shift));
 
 
     /* Calculate display picture width, height and start u4_ofst from YUV420 */
@@ -857,7 +885,8 @@ WORD32 ih264d_parse_sps(dec_struct_t *ps_dec, dec_bit_stream_t *ps_bitstrm)
             u1_frm_mbs_flag = (1 == ps_seq->u1_frame_mbs_only_flag);
 
             /* Simplify the vertical u4_ofst calculation from field/frame     */
-            u1_vert_mult_factor = (2 - u1_frm_mbs_flag);
+            /* and chroma format (CropUnitY is 1 for 4:2:2 frames)            */
+            u1_vert_mult_factor = (1 + u1_chroma_ht_shift - u1_frm_mbs_flag);
 
             /* Calculate bottom and top u4_ofst for cropped  picture          */
             u2_btm_ofst = (u1_frame_cropping_rect_bottom_ofst
@@ -869,7 +898,8 @@ WORD32 ih264d_parse_sps(dec_struct_t *ps_dec, dec_bit_stream_t *ps_bitstrm)
         /* Calculate u4_ofst from start of YUV 420 picture buffer to start of*/
         /* cropped picture buffer                                           */
         u2_crop_offset_y = (u2_frm_wd_y * u2_top_ofst) + (u2_lft_ofst);
-        u2_crop_offset_uv = (u2_frm_wd_uv * (u2_top_ofst >> 1))
+        u2_crop_offset_uv = (u2_frm_wd_uv
+                        * (u2_top_ofst >> u1_chroma_ht_shift))
                         + (u2_lft_ofst >> 1) * YUV420SP_FACTOR;
         /* Calculate the display picture width and height based on crop      */
         /* information                                                       */
@@ -891,9 +921,18 @@ WORD32 ih264d_parse_sps(dec_struct_t *ps_dec, dec_bit_stream_t *ps_bitstrm)
             ps_dec->u1_res_changed = 1;
             return IVD_RES_CHANGED;
         }
+        /* Chroma buffers are sized per chroma format */
+        if((3 == ps_dec->i4_header_decoded)
+                        && (ps_dec->u1_chroma_ht_shift != u1_chroma_ht_shift))
+        {
+            ps_dec->u1_res_changed = 1;
+            return IVD_RES_CHANGED;
+        }
 
         /* Check for unsupported resolutions */
-        if((u2_pic_wd > H264_MAX_FRAME_WIDTH) || (u2_pic_ht > H264_MAX_FRAME_HEIGHT))
+        if((u2_pic_wd > H264_MAX_FRAME_WIDTH) || (u2_pic_ht > H264_MAX_FRAME_HEIGHT)
+                        || ((ps_seq->u4_total_num_of_mbs << (1 - u1_frm))
+                                        > MAX_MBS_LEVEL_62))
         {
             return IVD_STREAM_WIDTH_HEIGHT_NOT_SUPPORTED;
         }
@@ -920,6 +959,7 @@ WORD32 ih264d_parse_sps(dec_struct_t *ps_dec, dec_bit_stream_t *ps_bitstrm)
 
     ps_dec->u2_frm_wd_uv = u2_frm_wd_uv;
     ps_dec->u2_frm_ht_uv = u2_frm_ht_uv;
+    ps_dec->u1_chroma_ht_shift = u1_chroma_ht_shift;
     ps_dec->s_pad_mgr.u1_pad_len_y_v = (UWORD8)(PAD_LEN_Y_V << (1 - u1_frm));
     ps_dec->s_pad_mgr.u1_pad_len_cr_v = (UWORD8)(PAD_LEN_UV_V << (1 - u1_frm));
 
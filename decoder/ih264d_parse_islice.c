@@ -754,7 +754,7 @@ WORD32 ih264d_parse_imb_cabac(dec_struct_t * ps_dec,
 /*****************************************************************************/
 WORD32 ih264d_parse_islice_data_cavlc(dec_struct_t * ps_dec,
                                       dec_slice_params_t * ps_slice,
-                                      UWORD16 u2_first_mb_in_slice)
+                                      UWORD32 u4_first_mb_in_slice)
 {
     UWORD8 uc_more_data_flag;
     UWORD8 u1_num_mbs, u1_mb_idx;
@@ -764,9 +764,10 @@ WORD32 ih264d_parse_islice_data_cavlc(dec_struct_t * ps_dec,
     UWORD32 *pu4_bitstrm_ofst = &ps_bitstrm->u4_ofst;
     UWORD32 *pu4_bitstrm_buf = ps_bitstrm->pu4_buffer;
     UWORD16 i2_pic_wdin_mbs = ps_dec->u2_frm_wd_in_mbs;
-    WORD16 i2_cur_mb_addr;
+    WORD32 i4_cur_mb_addr;
     UWORD8 u1_mbaff;
-    UWORD8 u1_num_mbs_next, u1_end_of_row, u1_tfr_n_mb;
+    UWORD32 u4_num_mbs_next, u4_end_of_row;
+    UWORD8 u1_tfr_n_mb;
     WORD32 ret = OK;
 
     ps_dec->u1_qp = ps_slice->u1_slice_qp;
@@ -778,7 +779,7 @@ WORD32 ih264d_parse_islice_data_cavlc(dec_struct_t * ps_dec,
     u1_num_mbs = u1_mb_idx;
 
     uc_more_data_flag = 1;
-    i2_cur_mb_addr = u2_first_mb_in_slice << u1_mbaff;
+    i4_cur_mb_addr = u4_first_mb_in_slice << u1_mbaff;
 
     do
     {
@@ -786,7 +787,7 @@ WORD32 ih264d_parse_islice_data_cavlc(dec_struct_t * ps_dec,
 
         ps_dec->pv_prev_mb_parse_tu_coeff_data = ps_dec->pv_parse_tu_coeff_data;
 
-        if(i2_cur_mb_addr > ps_dec->ps_cur_sps->u2_max_mb_addr)
+        if(i4_cur_mb_addr > (WORD32)ps_dec->ps_cur_sps->u4_max_mb_addr)
         {
             break;
         }
@@ -801,7 +802,7 @@ WORD32 ih264d_parse_islice_data_cavlc(dec_struct_t * ps_dec,
         /* Get the required information for decoding of MB             */
         /* mb_x, mb_y , neighbour availablity,                         */
         /***************************************************************/
-        ps_dec->pf_get_mb_info(ps_dec, i2_cur_mb_addr, ps_cur_mb_info, 0);
+        ps_dec->pf_get_mb_info(ps_dec, i4_cur_mb_addr, ps_cur_mb_info, 0);
 
         /***************************************************************/
         /* Set the deblocking parameters for this MB                   */
@@ -874,7 +875,7 @@ WORD32 ih264d_parse_islice_data_cavlc(dec_struct_t * ps_dec,
         /* Get next Macroblock address                                */
         /**************************************************************/
 
-        i2_cur_mb_addr++;
+        i4_cur_mb_addr++;
         uc_more_data_flag = MORE_RBSP_DATA(ps_bitstrm);
 
         /* Store the colocated information */
@@ -902,9 +903,9 @@ WORD32 ih264d_parse_islice_data_cavlc(dec_struct_t * ps_dec,
         /****************************************************************/
         /* Check for End Of Row                                         */
         /****************************************************************/
-        u1_num_mbs_next = i2_pic_wdin_mbs - ps_dec->u2_mbx - 1;
-        u1_end_of_row = (!u1_num_mbs_next) && (!(u1_mbaff && (u1_num_mbs & 0x01)));
-        u1_tfr_n_mb = (u1_num_mbs == ps_dec->u1_recon_mb_grp) || u1_end_of_row
+        u4_num_mbs_next = i2_pic_wdin_mbs - ps_dec->u2_mbx - 1;
+        u4_end_of_row = (!u4_num_mbs_next) && (!(u1_mbaff && (u1_num_mbs & 0x01)));
+        u1_tfr_n_mb = (u1_num_mbs == ps_dec->u1_recon_mb_grp) || u4_end_of_row
                         || (!uc_more_data_flag);
         ps_cur_mb_info->u1_end_of_slice = (!uc_more_data_flag);
 
@@ -918,16 +919,16 @@ WORD32 ih264d_parse_islice_data_cavlc(dec_struct_t * ps_dec,
             if(ps_dec->u1_separate_parse)
             {
                 ih264d_parse_tfr_nmb(ps_dec, u1_mb_idx, u1_num_mbs,
-                                     u1_num_mbs_next, u1_tfr_n_mb, u1_end_of_row);
+                                     u4_num_mbs_next, u1_tfr_n_mb, u4_end_of_row);
                 ps_dec->ps_nmb_info +=  u1_num_mbs;
             }
             else
             {
                 ih264d_decode_recon_tfr_nmb(ps_dec, u1_mb_idx, u1_num_mbs,
-                                            u1_num_mbs_next, u1_tfr_n_mb,
-                                            u1_end_of_row);
+                                            u4_num_mbs_next, u1_tfr_n_mb,
+                                            u4_end_of_row);
             }
-            ps_dec->u2_total_mbs_coded += u1_num_mbs;
+            ps_dec->u4_total_mbs_coded += u1_num_mbs;
             if(u1_tfr_n_mb)
                 u1_num_mbs = 0;
             u1_mb_idx = u1_num_mbs;
@@ -938,9 +939,9 @@ WORD32 ih264d_parse_islice_data_cavlc(dec_struct_t * ps_dec,
     while(uc_more_data_flag);
 
     ps_dec->u4_num_mbs_cur_nmb = 0;
-    ps_dec->ps_cur_slice->u4_mbs_in_slice = i2_cur_mb_addr
+    ps_dec->ps_cur_slice->u4_mbs_in_slice = i4_cur_mb_addr
 
-                        - (u2_first_mb_in_slice << u1_mbaff);
+                        - (u4_first_mb_in_slice << u1_mbaff);
 
     return ret;
 }
@@ -971,7 +972,7 @@ WORD32 ih264d_parse_islice_data_cavlc(dec_struct_t * ps_dec,
 /*****************************************************************************/
 WORD32 ih264d_parse_islice_data_cabac(dec_struct_t * ps_dec,
                                       dec_slice_params_t * ps_slice,
-                                      UWORD16 u2_first_mb_in_slice)
+                                      UWORD32 u4_first_mb_in_slice)
 {
     UWORD8 uc_more_data_flag;
     UWORD8 u1_num_mbs, u1_mb_idx;
@@ -980,9 +981,10 @@ WORD32 ih264d_parse_islice_data_cabac(dec_struct_t * ps_dec,
 
     dec_bit_stream_t * const ps_bitstrm = ps_dec->ps_bitstrm;
     UWORD16 i2_pic_wdin_mbs = ps_dec->u2_frm_wd_in_mbs;
-    WORD16 i2_cur_mb_addr;
+    WORD32 i4_cur_mb_addr;
     UWORD8 u1_mbaff;
-    UWORD8 u1_num_mbs_next, u1_end_of_row, u1_tfr_n_mb;
+    UWORD32 u4_num_mbs_next, u4_end_of_row;
+    UWORD8 u1_tfr_n_mb;
     WORD32 ret = OK;
 
     ps_dec->u1_qp = ps_slice->u1_slice_qp;
@@ -1006,14 +1008,14 @@ WORD32 ih264d_parse_islice_data_cabac(dec_struct_t * ps_dec,
     u1_num_mbs = u1_mb_idx;
 
     uc_more_data_flag = 1;
-    i2_cur_mb_addr = u2_first_mb_in_slice << u1_mbaff;
+    i4_cur_mb_addr = u4_first_mb_in_slice << u1_mbaff;
     do
     {
         UWORD16 u2_mbx;
 
         ps_dec->pv_prev_mb_parse_tu_coeff_data = ps_dec->pv_parse_tu_coeff_data;
 
-        if(i2_cur_mb_addr > ps_dec->ps_cur_sps->u2_max_mb_addr)
+        if(i4_cur_mb_addr > (WORD32)ps_dec->ps_cur_sps->u4_max_mb_addr)
         {
             break;
         }
@@ -1031,7 +1033,7 @@ WORD32 ih264d_parse_islice_data_cabac(dec_struct_t * ps_dec,
             /* Get the required information for decoding of MB                  */
             /* mb_x, mb_y , neighbour availablity,                              */
             /***************************************************************/
-            ps_dec->pf_get_mb_info(ps_dec, i2_cur_mb_addr, ps_cur_mb_info, 0);
+            ps_dec->pf_get_mb_info(ps_dec, i4_cur_mb_addr, ps_cur_mb_info, 0);
             u2_mbx = ps_dec->u2_mbx;
 
             /*********************************************************************/
@@ -1084,7 +1086,7 @@ WORD32 ih264d_parse_islice_data_cabac(dec_struct_t * ps_dec,
                 ih264d_update_mbaff_left_nnz(ps_dec, ps_cur_mb_info);
             }
             /* Next macroblock information */
-            i2_cur_mb_addr++;
+            i4_cur_mb_addr++;
 
             if(ps_cur_mb_info->u1_topmb && u1_mbaff)
                 uc_more_data_flag = 1;
@@ -1122,9 +1124,9 @@ WORD32 ih264d_parse_islice_data_cabac(dec_struct_t * ps_dec,
         /****************************************************************/
         /* Check for End Of Row                                         */
         /****************************************************************/
-        u1_num_mbs_next = i2_pic_wdin_mbs - u2_mbx - 1;
-        u1_end_of_row = (!u1_num_mbs_next) && (!(u1_mbaff && (u1_num_mbs & 0x01)));
-        u1_tfr_n_mb = (u1_num_mbs == ps_dec->u1_recon_mb_grp) || u1_end_of_row
+        u4_num_mbs_next = i2_pic_wdin_mbs - u2_mbx - 1;
+        u4_end_of_row = (!u4_num_mbs_next) && (!(u1_mbaff && (u1_num_mbs & 0x01)));
+        u1_tfr_n_mb = (u1_num_mbs == ps_dec->u1_recon_mb_grp) || u4_end_of_row
                         || (!uc_more_data_flag);
         ps_cur_mb_info->u1_end_of_slice = (!uc_more_data_flag);
 
@@ -1135,16 +1137,16 @@ WORD32 ih264d_parse_islice_data_cabac(dec_struct_t * ps_dec,
             if(ps_dec->u1_separate_parse)
             {
                 ih264d_parse_tfr_nmb(ps_dec, u1_mb_idx, u1_num_mbs,
-                                     u1_num_mbs_next, u1_tfr_n_mb, u1_end_of_row);
+                                     u4_num_mbs_next, u1_tfr_n_mb, u4_end_of_row);
                 ps_dec->ps_nmb_info +=  u1_num_mbs;
             }
             else
             {
                 ih264d_decode_recon_tfr_nmb(ps_dec, u1_mb_idx, u1_num_mbs,
-                                            u1_num_mbs_next, u1_tfr_n_mb,
-                                            u1_end_of_row);
+                                            u4_num_mbs_next, u1_tfr_n_mb,
+                                            u4_end_of_row);
             }
-            ps_dec->u2_total_mbs_coded += u1_num_mbs;
+            ps_dec->u4_total_mbs_coded += u1_num_mbs;
             if(u1_tfr_n_mb)
                 u1_num_mbs = 0;
             u1_mb_idx = u1_num_mbs;
@@ -1155,9 +1157,9 @@ WORD32 ih264d_parse_islice_data_cabac(dec_struct_t * ps_dec,
     while(uc_more_data_flag);
 
     ps_dec->u4_num_mbs_cur_nmb = 0;
-    ps_dec->ps_cur_slice->u4_mbs_in_slice = i2_cur_mb_addr
+    ps_dec->ps_cur_slice->u4_mbs_in_slice = i4_cur_mb_addr
 
-                        - (u2_first_mb_in_slice << u1_mbaff);
+                        - (u4_first_mb_in_slice << u1_mbaff);
 
     return ret;
 }
@@ -1233,6 +1235,7 @@ WORD32 ih264d_parse_ipcm_mb(dec_struct_t * ps_dec,
     pu1_buf = ps_dec->pu1_left_nnz_uv;
     pu4_buf = (UWORD32 *)pu1_buf;
     *pu4_buf = 0x10101010;
+    pu4_buf[1] = 0x10101010;
     ps_cur_mb_info->u1_cbp = 0xff;
 
     ps_dec->i1_prev_mb_qp_delta = 0;
@@ -1277,8 +1280,8 @@ WORD32 ih264d_parse_ipcm_mb(dec_struct_t * ps_dec,
         pu1_y += u4_rec_width_y;
     }
 
-    /* Read Chroma samples */
-    for(u1_y = 0; u1_y < 8; u1_y++)
+    /* Read Chroma samples, 16 rows per component for 4:2:2 */
+    for(u1_y = 0; u1_y < (MB_SIZE >> ps_dec->u1_chroma_ht_shift); u1_y++)
     {
         for(u1_x = 0; u1_x < 8; u1_x++)
             pu1_u[u1_x * YUV420SP_FACTOR] = ih264d_get_bits_h264(ps_bitstrm, 8);
@@ -1286,7 +1289,7 @@ WORD32 ih264d_parse_ipcm_mb(dec_struct_t * ps_dec,
         pu1_u += u4_rec_width_uv;
     }
 
-    for(u1_y = 0; u1_y < 8; u1_y++)
+    for(u1_y = 0; u1_y < (MB_SIZE >> ps_dec->u1_chroma_ht_shift); u1_y++)
     {
         for(u1_x = 0; u1_x < 8; u1_x++)
             pu1_v[u1_x * YUV420SP_FACTOR] = ih264d_get_bits_h264(ps_bitstrm, 8);
@@ -1325,6 +1328,7 @@ WORD32 ih264d_parse_ipcm_mb(dec_struct_t * ps_dec,
         pu1_buf = ps_dec->pu1_left_nnz_uv;
         pu4_buf = (UWORD32 *)pu1_buf;
         *pu4_buf = 0x01010101;
+        pu4_buf[1] = 0x01010101;
 
         p_curr_ctxt->u1_yuv_dc_csbp = 0x7;
         ps_dec->pu1_left_yuv_dc_csbp[0] = 0x7;
@@ -1354,7 +1358,7 @@ WORD32 ih264d_parse_ipcm_mb(dec_struct_t * ps_dec,
  **************************************************************************
  */
 WORD32 ih264d_parse_islice(dec_struct_t *ps_dec,
-                            UWORD16 u2_first_mb_in_slice)
+                            UWORD32 u4_first_mb_in_slice)
 {
     dec_pic_params_t * ps_pps = ps_dec->ps_cur_pps;
     dec_slice_params_t * ps_slice = ps_dec->ps_cur_slice;
@@ -1454,7 +1458,7 @@ WORD32 ih264d_parse_islice(dec_struct_t *ps_dec,
             ps_dec->pf_get_mb_info = ih264d_get_mb_info_cabac_nonmbaff;
 
         ret = ih264d_parse_islice_data_cabac(ps_dec, ps_slice,
-                                             u2_first_mb_in_slice);
+                                             u4_first_mb_in_slice);
         if(ret != OK)
             return ret;
         SWITCHONTRACE; SWITCHOFFTRACECABAC;
@@ -1468,7 +1472,7 @@ WORD32 ih264d_parse_islice(dec_struct_t *ps_dec,
         else
             ps_dec->pf_get_mb_info = ih264d_get_mb_info_cavlc_nonmbaff;
         ret = ih264d_parse_islice_data_cavlc(ps_dec, ps_slice,
-                                       u2_first_mb_in_slice);
+                                       u4_first_mb_in_slice);
         if(ret != OK)
             return ret;
     }
@@ -759,6 +759,7 @@ void ih264d_update_nnz_for_skipmb(dec_struct_t * ps_dec,
     pu1_buf = ps_dec->pu1_left_nnz_uv;
     pu4_buf = (UWORD32 *)pu1_buf;
     *pu4_buf = 0;
+    pu4_buf[1] = 0;
     pu1_buf = ps_cur_mb_info->ps_curmb->pu1_nnz_y;
     pu4_buf = (UWORD32 *)pu1_buf;
     *pu4_buf = 0;
@@ -799,13 +800,13 @@ void ih264d_update_nnz_for_skipmb(dec_struct_t * ps_dec,
 /*****************************************************************************/
 WORD32 ih264d_parse_inter_slice_data_cabac(dec_struct_t * ps_dec,
                                            dec_slice_params_t * ps_slice,
-                                           UWORD16 u2_first_mb_in_slice)
+                                           UWORD32 u4_first_mb_in_slice)
 {
     UWORD32 uc_more_data_flag;
-    WORD32 i2_cur_mb_addr;
+    WORD32 i4_cur_mb_addr;
     UWORD32 u1_num_mbs, u1_num_mbsNby2, u1_mb_idx;
     UWORD32 u1_mbaff;
-    UWORD32 u1_num_mbs_next, u1_end_of_row;
+    UWORD32 u4_num_mbs_next, u4_end_of_row;
     const UWORD16 i2_pic_wdin_mbs = ps_dec->u2_frm_wd_in_mbs;
     UWORD32 u1_slice_end = 0;
     UWORD32 u1_tfr_n_mb = 0;
@@ -844,14 +845,14 @@ WORD32 ih264d_parse_inter_slice_data_cabac(dec_struct_t * ps_dec,
     /******************************************************/
     /* Slice Level Initialisations                        */
     /******************************************************/
-    i2_cur_mb_addr = u2_first_mb_in_slice;
+    i4_cur_mb_addr = u4_first_mb_in_slice;
     ps_dec->u1_qp = ps_slice->u1_slice_qp;
     ih264d_update_qp(ps_dec, 0);
     u1_mb_idx = ps_dec->u1_mb_idx;
     u1_num_mbs = u1_mb_idx;
     u1_num_mbsNby2 = 0;
     u1_mbaff = ps_slice->u1_mbaff_frame_flag;
-    i2_cur_mb_addr = u2_first_mb_in_slice << u1_mbaff;
+    i4_cur_mb_addr = u4_first_mb_in_slice << u1_mbaff;
     uc_more_data_flag = 1;
 
     /* Initialisations specific to cabac */
@@ -874,7 +875,7 @@ WORD32 ih264d_parse_inter_slice_data_cabac(dec_struct_t * ps_dec,
 
         ps_dec->pv_prev_mb_parse_tu_coeff_data = ps_dec->pv_parse_tu_coeff_data;
 
-        if(i2_cur_mb_addr > ps_dec->ps_cur_sps->u2_max_mb_addr)
+        if(i4_cur_mb_addr > (WORD32)ps_dec->ps_cur_sps->u4_max_mb_addr)
         {
             break;
         }
@@ -896,7 +897,7 @@ WORD32 ih264d_parse_inter_slice_data_cabac(dec_struct_t * ps_dec,
         /* Get the required information for decoding of MB             */
         /* mb_x, mb_y , neighbour availablity,                         */
         /***************************************************************/
-        u4_mb_skip = ps_dec->pf_get_mb_info(ps_dec, i2_cur_mb_addr, ps_cur_mb_info, 1);
+        u4_mb_skip = ps_dec->pf_get_mb_info(ps_dec, i4_cur_mb_addr, ps_cur_mb_info, 1);
 
         /*********************************************************************/
         /* initialize u1_tran_form8x8 to zero to aviod uninitialized accesses */
@@ -1007,7 +1008,7 @@ WORD32 ih264d_parse_inter_slice_data_cabac(dec_struct_t * ps_dec,
             ih264d_update_mbaff_left_nnz(ps_dec, ps_cur_mb_info);
         }
         /* Next macroblock information */
-        i2_cur_mb_addr++;
+        i4_cur_mb_addr++;
 
         if(ps_cur_mb_info->u1_topmb && u1_mbaff)
             uc_more_data_flag = 1;
@@ -1028,10 +1029,10 @@ WORD32 ih264d_parse_inter_slice_data_cabac(dec_struct_t * ps_dec,
         /* do DMA setup for N/2-Mb, Decode for N-Mb, and Transfer for   */
         /* N-Mb                                                         */
         /****************************************************************/
-        u1_num_mbs_next = i2_pic_wdin_mbs - ps_dec->u2_mbx - 1;
-        u1_end_of_row = (!u1_num_mbs_next) && (!(u1_mbaff && (u1_num_mbs & 0x01)));
+        u4_num_mbs_next = i2_pic_wdin_mbs - ps_dec->u2_mbx - 1;
+        u4_end_of_row = (!u4_num_mbs_next) && (!(u1_mbaff && (u1_num_mbs & 0x01)));
         u1_slice_end = !uc_more_data_flag;
-        u1_tfr_n_mb = (u1_num_mbs == ps_dec->u1_recon_mb_grp) || u1_end_of_row
+        u1_tfr_n_mb = (u1_num_mbs == ps_dec->u1_recon_mb_grp) || u4_end_of_row
                         || u1_slice_end;
         u1_decode_nmb = u1_tfr_n_mb || u1_slice_end;
         ps_cur_mb_info->u1_end_of_slice = u1_slice_end;
@@ -1061,16 +1062,16 @@ WORD32 ih264d_parse_inter_slice_data_cabac(dec_struct_t * ps_dec,
             if(ps_dec->u1_separate_parse)
             {
                 ih264d_parse_tfr_nmb(ps_dec, u1_mb_idx, u1_num_mbs,
-                                     u1_num_mbs_next, u1_tfr_n_mb, u1_end_of_row);
+                                     u4_num_mbs_next, u1_tfr_n_mb, u4_end_of_row);
                 ps_dec->ps_nmb_info +=  u1_num_mbs;
             }
             else
             {
                 ih264d_decode_recon_tfr_nmb(ps_dec, u1_mb_idx, u1_num_mbs,
-                                            u1_num_mbs_next, u1_tfr_n_mb,
-                                            u1_end_of_row);
+                                            u4_num_mbs_next, u1_tfr_n_mb,
+                                            u4_end_of_row);
             }
-            ps_dec->u2_total_mbs_coded += u1_num_mbs;
+            ps_dec->u4_total_mbs_coded += u1_num_mbs;
             if(u1_tfr_n_mb)
                 u1_num_mbs = 0;
             u1_mb_idx = u1_num_mbs;
@@ -1081,9 +1082,9 @@ WORD32 ih264d_parse_inter_slice_data_cabac(dec_struct_t * ps_dec,
 
 
     ps_dec->u4_num_mbs_cur_nmb = 0;
-    ps_dec->ps_cur_slice->u4_mbs_in_slice = i2_cur_mb_addr
+    ps_dec->ps_cur_slice->u4_mbs_in_slice = i4_cur_mb_addr
 
-                        - (u2_first_mb_in_slice << u1_mbaff);
+                        - (u4_first_mb_in_slice << u1_mbaff);
 
     return ret;
 }
@@ -1116,16 +1117,16 @@ WORD32 ih264d_parse_inter_slice_data_cabac(dec_struct_t * ps_dec,
 
 WORD32 ih264d_parse_inter_slice_data_cavlc(dec_struct_t * ps_dec,
                                            dec_slice_params_t * ps_slice,
-                                           UWORD16 u2_first_mb_in_slice)
+                                           UWORD32 u4_first_mb_in_slice)
 {
     UWORD32 uc_more_data_flag;
-    WORD32 i2_cur_mb_addr;
+    WORD32 i4_cur_mb_addr;
     UWORD32 u1_num_mbs, u1_num_mbsNby2, u1_mb_idx;
     UWORD32 i2_mb_skip_run;
     UWORD32 u1_read_mb_type;
 
     UWORD32 u1_mbaff;
-    UWORD32 u1_num_mbs_next, u1_end_of_row;
+    UWORD32 u4_num_mbs_next, u4_end_of_row;
     const UWORD32 i2_pic_wdin_mbs = ps_dec->u2_frm_wd_in_mbs;
     UWORD32 u1_slice_end = 0;
     UWORD32 u1_tfr_n_mb = 0;
@@ -1168,7 +1169,7 @@ WORD32 ih264d_parse_inter_slice_data_cavlc(dec_struct_t * ps_dec,
 
     u1_num_mbsNby2 = 0;
     u1_mbaff = ps_slice->u1_mbaff_frame_flag;
-    i2_cur_mb_addr = u2_first_mb_in_slice << u1_mbaff;
+    i4_cur_mb_addr = u4_first_mb_in_slice << u1_mbaff;
     i2_mb_skip_run = 0;
     uc_more_data_flag = 1;
     u1_read_mb_type = 0;
@@ -1179,7 +1180,7 @@ WORD32 ih264d_parse_inter_slice_data_cavlc(dec_struct_t * ps_dec,
 
         ps_dec->pv_prev_mb_parse_tu_coeff_data = ps_dec->pv_parse_tu_coeff_data;
 
-        if(i2_cur_mb_addr > ps_dec->ps_cur_sps->u2_max_mb_addr)
+        if(i4_cur_mb_addr > (WORD32)ps_dec->ps_cur_sps->u4_max_mb_addr)
         {
             break;
         }
@@ -1233,7 +1234,7 @@ WORD32 ih264d_parse_inter_slice_data_cavlc(dec_struct_t * ps_dec,
         /* Get the required information for decoding of MB                  */
         /* mb_x, mb_y , neighbour availablity,                              */
         /***************************************************************/
-        ps_dec->pf_get_mb_info(ps_dec, i2_cur_mb_addr, ps_cur_mb_info, i2_mb_skip_run);
+        ps_dec->pf_get_mb_info(ps_dec, i4_cur_mb_addr, ps_cur_mb_info, i2_mb_skip_run);
 
         /***************************************************************/
         /* Set the deblocking parameters for this MB                   */
@@ -1352,7 +1353,7 @@ WORD32 ih264d_parse_inter_slice_data_cavlc(dec_struct_t * ps_dec,
         /**************************************************************/
         /* Get next Macroblock address                                */
         /**************************************************************/
-        i2_cur_mb_addr++;
+        i4_cur_mb_addr++;
 
         u1_num_mbs++;
         u1_num_mbsNby2++;
@@ -1363,10 +1364,10 @@ WORD32 ih264d_parse_inter_slice_data_cavlc(dec_struct_t * ps_dec,
         /* do DMA setup for N/2-Mb, Decode for N-Mb, and Transfer for   */
         /* N-Mb                                                         */
         /****************************************************************/
-        u1_num_mbs_next = i2_pic_wdin_mbs - ps_dec->u2_mbx - 1;
-        u1_end_of_row = (!u1_num_mbs_next) && (!(u1_mbaff && (u1_num_mbs & 0x01)));
+        u4_num_mbs_next = i2_pic_wdin_mbs - ps_dec->u2_mbx - 1;
+        u4_end_of_row = (!u4_num_mbs_next) && (!(u1_mbaff && (u1_num_mbs & 0x01)));
         u1_slice_end = (!(uc_more_data_flag || i2_mb_skip_run));
-        u1_tfr_n_mb = (u1_num_mbs == ps_dec->u1_recon_mb_grp) || u1_end_of_row
+        u1_tfr_n_mb = (u1_num_mbs == ps_dec->u1_recon_mb_grp) || u4_end_of_row
                         || u1_slice_end;
         u1_decode_nmb = u1_tfr_n_mb || u1_slice_end;
         ps_cur_mb_info->u1_end_of_slice = u1_slice_end;
@@ -1398,16 +1399,16 @@ WORD32 ih264d_parse_inter_slice_data_cavlc(dec_struct_t * ps_dec,
             if(ps_dec->u1_separate_parse)
             {
                 ih264d_parse_tfr_nmb(ps_dec, u1_mb_idx, u1_num_mbs,
-                                     u1_num_mbs_next, u1_tfr_n_mb, u1_end_of_row);
+                                     u4_num_mbs_next, u1_tfr_n_mb, u4_end_of_row);
                 ps_dec->ps_nmb_info +=  u1_num_mbs;
             }
             else
             {
                 ih264d_decode_recon_tfr_nmb(ps_dec, u1_mb_idx, u1_num_mbs,
-                                            u1_num_mbs_next, u1_tfr_n_mb,
-                                            u1_end_of_row);
+                                            u4_num_mbs_next, u1_tfr_n_mb,
+                                            u4_end_of_row);
             }
-            ps_dec->u2_total_mbs_coded += u1_num_mbs;
+            ps_dec->u4_total_mbs_coded += u1_num_mbs;
             if(u1_tfr_n_mb)
                 u1_num_mbs = 0;
             u1_mb_idx = u1_num_mbs;
@@ -1418,8 +1419,8 @@ WORD32 ih264d_parse_inter_slice_data_cavlc(dec_struct_t * ps_dec,
     }
 
     ps_dec->u4_num_mbs_cur_nmb = 0;
-    ps_dec->ps_cur_slice->u4_mbs_in_slice = i2_cur_mb_addr
-                        - (u2_first_mb_in_slice << u1_mbaff);
+    ps_dec->ps_cur_slice->u4_mbs_in_slice = i4_cur_mb_addr
+                        - (u4_first_mb_in_slice << u1_mbaff);
 
 
     return ret;
@@ -1432,12 +1433,12 @@ WORD32 ih264d_mark_err_slice_skip(dec_struct_t * ps_dec,
                                 pocstruct_t *ps_cur_poc,
                                 WORD32 prev_slice_err)
 {
-    WORD32 i2_cur_mb_addr;
+    WORD32 i4_cur_mb_addr;
     UWORD32 u1_num_mbs, u1_num_mbsNby2;
     UWORD32 u1_mb_idx = ps_dec->u1_mb_idx;
     UWORD32 i2_mb_skip_run;
 
-    UWORD32 u1_num_mbs_next, u1_end_of_row;
+    UWORD32 u4_num_mbs_next, u4_end_of_row;
     const UWORD32 i2_pic_wdin_mbs = ps_dec->u2_frm_wd_in_mbs;
     UWORD32 u1_slice_end;
     UWORD32 u1_tfr_n_mb;
@@ -1451,7 +1452,6 @@ WORD32 ih264d_mark_err_slice_skip(dec_struct_t * ps_dec,
     parse_pmbarams_t *ps_parse_mb_data;
     UWORD32 u1_inter_mb_type;
     UWORD32 u1_deblk_mb_type;
-    UWORD16 u2_total_mbs_coded;
     UWORD32 u1_mbaff = ps_slice->u1_mbaff_frame_flag;
     parse_part_params_t *ps_part_info;
     WORD32 ret;
@@ -1480,7 +1480,7 @@ WORD32 ih264d_mark_err_slice_skip(dec_struct_t * ps_dec,
         {
             WORD32 i, j, poc = 0;
 
-            ps_dec->ps_cur_slice->u2_first_mb_in_slice = 0;
+            ps_dec->ps_cur_slice->u4_first_mb_in_slice = 0;
 
             ps_dec->pf_mvpred = ih264d_mvpred_nonmbaff;
             ps_dec->p_form_mb_part_info = ih264d_form_mb_part_info_bp;
@@ -1527,22 +1527,14 @@ WORD32 ih264d_mark_err_slice_skip(dec_struct_t * ps_dec,
             {
                 if(ps_dec->u4_dec_thread_created == 0)
                 {
-                    ithread_create(ps_dec->pv_dec_thread_handle, NULL,
-                                   (void *)ih264d_decode_picture_thread,
-                                   (void *)ps_dec);
-
-                    ps_dec->u4_dec_thread_created = 1;
+                    ih264d_start_decode_thread(ps_dec);
                 }
 
                 if((ps_dec->u4_num_cores == 3) &&
                                 ((ps_dec->u4_app_disable_deblk_frm == 0) || ps_dec->i1_recon_in_thread3_flag)
                                 && (ps_dec->u4_bs_deblk_thread_created == 0))
                 {
-                    ps_dec->u4_start_recon_deblk = 0;
-                    ithread_create(ps_dec->pv_bs_deblk_thread_handle, NULL,
-                                   (void *)ih264d_recon_deblk_thread,
-                                   (void *)ps_dec);
-                    ps_dec->u4_bs_deblk_thread_created = 1;
+                    ih264d_start_bs_deblk_thread(ps_dec);
                 }
             }
         }
@@ -1585,7 +1577,7 @@ WORD32 ih264d_mark_err_slice_skip(dec_struct_t * ps_dec,
 
             // Going back 1 mb
             ps_dec->pv_parse_tu_coeff_data = ps_dec->pv_prev_mb_parse_tu_coeff_data;
-            ps_dec->u2_cur_mb_addr--;
+            ps_dec->u4_cur_mb_addr--;
             ps_dec->i4_submb_ofst -= SUB_BLK_SIZE;
 
             if(u1_num_mbs)
@@ -1598,8 +1590,8 @@ WORD32 ih264d_mark_err_slice_skip(dec_struct_t * ps_dec,
                     ps_dec->ps_part = ps_dec->ps_parse_part_params;
                 }
 
-                u1_num_mbs_next = i2_pic_wdin_mbs - ps_dec->u2_mbx - 1;
-                u1_end_of_row = (!u1_num_mbs_next)
+                u4_num_mbs_next = i2_pic_wdin_mbs - ps_dec->u2_mbx - 1;
+                u4_end_of_row = (!u4_num_mbs_next)
                         && (!(u1_mbaff && (u1_num_mbs & 0x01)));
                 u1_slice_end = 1;
                 u1_tfr_n_mb = 1;
@@ -1608,20 +1600,20 @@ WORD32 ih264d_mark_err_slice_skip(dec_struct_t * ps_dec,
                 if(ps_dec->u1_separate_parse)
                 {
                     ih264d_parse_tfr_nmb(ps_dec, u1_mb_idx, u1_num_mbs,
-                            u1_num_mbs_next, u1_tfr_n_mb, u1_end_of_row);
+                            u4_num_mbs_next, u1_tfr_n_mb, u4_end_of_row);
                     ps_dec->ps_nmb_info += u1_num_mbs;
                 }
                 else
                 {
                     ih264d_decode_recon_tfr_nmb(ps_dec, u1_mb_idx, u1_num_mbs,
-                            u1_num_mbs_next, u1_tfr_n_mb, u1_end_of_row);
+                            u4_num_mbs_next, u1_tfr_n_mb, u4_end_of_row);
                 }
-                ps_dec->u2_total_mbs_coded += u1_num_mbs;
+                ps_dec->u4_total_mbs_coded += u1_num_mbs;
                 ps_dec->u1_mb_idx = 0;
                 ps_dec->u4_num_mbs_cur_nmb = 0;
             }
 
-            if(ps_dec->u2_total_mbs_coded
+            if(ps_dec->u4_total_mbs_coded
                     >= ps_dec->u2_frm_ht_in_mbs * ps_dec->u2_frm_wd_in_mbs)
             {
                 ps_dec->u1_pic_decode_done = 1;
@@ -1670,11 +1662,11 @@ WORD32 ih264d_mark_err_slice_skip(dec_struct_t * ps_dec,
         ps_dec->ps_parse_cur_slice->ppv_map_ref_idx_to_poc = (volatile void **)pu1_buf;
     }
 
-    ps_dec->ps_cur_slice->u2_first_mb_in_slice = ps_dec->u2_total_mbs_coded << u1_mbaff;
+    ps_dec->ps_cur_slice->u4_first_mb_in_slice = ps_dec->u4_total_mbs_coded << u1_mbaff;
     if(ps_dec->ps_cur_slice->u1_field_pic_flag)
         ps_dec->u2_prv_frame_num = ps_dec->ps_cur_slice->u2_frame_num;
 
-    ps_dec->ps_parse_cur_slice->u4_first_mb_in_slice = ps_dec->u2_total_mbs_coded << u1_mbaff;
+    ps_dec->ps_parse_cur_slice->u4_first_mb_in_slice = ps_dec->u4_total_mbs_coded << u1_mbaff;
     ps_dec->ps_parse_cur_slice->u2_log2Y_crwd =    ps_dec->ps_cur_slice->u2_log2Y_crwd;
 
 
@@ -1712,14 +1704,16 @@ WORD32 ih264d_mark_err_slice_skip(dec_struct_t * ps_dec,
     u1_tfr_n_mb = 0;
     u1_decode_nmb = 0;
     u1_num_mbsNby2 = 0;
-    i2_cur_mb_addr = ps_dec->u2_total_mbs_coded;
+    i4_cur_mb_addr = ps_dec->u4_total_mbs_coded;
     i2_mb_skip_run = num_mb_skip;
+    ps_dec->u1_conceal_slice = (0 == u1_mbaff)
+                    && (0 == ps_slice->u1_field_pic_flag);
 
     while(!u1_slice_end)
     {
         UWORD8 u1_mb_type;
 
-        if(i2_cur_mb_addr > ps_dec->ps_cur_sps->u2_max_mb_addr)
+        if(i4_cur_mb_addr > (WORD32)ps_dec->ps_cur_sps->u4_max_mb_addr)
             break;
 
         ps_cur_mb_info = ps_dec->ps_nmb_info + u1_num_mbs;
@@ -1740,9 +1734,9 @@ WORD32 ih264d_mark_err_slice_skip(dec_struct_t * ps_dec,
         /**************************************************************/
         /* mb_x, mb_y, neighbor availablity, */
         if (u1_mbaff)
-            ih264d_get_mb_info_cavlc_mbaff(ps_dec, i2_cur_mb_addr, ps_cur_mb_info, i2_mb_skip_run);
+            ih264d_get_mb_info_cavlc_mbaff(ps_dec, i4_cur_mb_addr, ps_cur_mb_info, i2_mb_skip_run);
         else
-            ih264d_get_mb_info_cavlc_nonmbaff(ps_dec, i2_cur_mb_addr, ps_cur_mb_info, i2_mb_skip_run);
+            ih264d_get_mb_info_cavlc_nonmbaff(ps_dec, i4_cur_mb_addr, ps_cur_mb_info, i2_mb_skip_run);
 
         /* Set the deblocking parameters for this MB */
         if(ps_dec->u4_app_disable_deblk_frm == 0)
@@ -1783,7 +1777,7 @@ WORD32 ih264d_mark_err_slice_skip(dec_struct_t * ps_dec,
         /**************************************************************/
         /* Get next Macroblock address                                */
         /**************************************************************/
-        i2_cur_mb_addr++;
+        i4_cur_mb_addr++;
 
         u1_num_mbs++;
         u1_num_mbsNby2++;
@@ -1794,10 +1788,10 @@ WORD32 ih264d_mark_err_slice_skip(dec_struct_t * ps_dec,
         /* do DMA setup for N/2-Mb, Decode for N-Mb, and Transfer for   */
         /* N-Mb                                                         */
         /****************************************************************/
-        u1_num_mbs_next = i2_pic_wdin_mbs - ps_dec->u2_mbx - 1;
-        u1_end_of_row = (!u1_num_mbs_next) && (!(u1_mbaff && (u1_num_mbs & 0x01)));
+        u4_num_mbs_next = i2_pic_wdin_mbs - ps_dec->u2_mbx - 1;
+        u4_end_of_row = (!u4_num_mbs_next) && (!(u1_mbaff && (u1_num_mbs & 0x01)));
         u1_slice_end = !i2_mb_skip_run;
-        u1_tfr_n_mb = (u1_num_mbs == ps_dec->u1_recon_mb_grp) || u1_end_of_row
+        u1_tfr_n_mb = (u1_num_mbs == ps_dec->u1_recon_mb_grp) || u4_end_of_row
                         || u1_slice_end;
         u1_decode_nmb = u1_tfr_n_mb || u1_slice_end;
         ps_cur_mb_info->u1_end_of_slice = u1_slice_end;
@@ -1813,15 +1807,15 @@ WORD32 ih264d_mark_err_slice_skip(dec_struct_t * ps_dec,
             if(ps_dec->u1_separate_parse)
             {
                 ih264d_parse_tfr_nmb(ps_dec, u1_mb_idx, u1_num_mbs,
-                                     u1_num_mbs_next, u1_tfr_n_mb, u1_end_of_row);
+                                     u4_num_mbs_next, u1_tfr_n_mb, u4_end_of_row);
                 ps_dec->ps_nmb_info +=  u1_num_mbs;
             }
             else
             {
-                ih264d_decode_recon_tfr_nmb(ps_dec, u1_mb_idx, u1_num_mbs, u1_num_mbs_next,
-                                            u1_tfr_n_mb, u1_end_of_row);
+                ih264d_decode_recon_tfr_nmb(ps_dec, u1_mb_idx, u1_num_mbs, u4_num_mbs_next,
+                                            u1_tfr_n_mb, u4_end_of_row);
             }
-            ps_dec->u2_total_mbs_coded += u1_num_mbs;
+            ps_dec->u4_total_mbs_coded += u1_num_mbs;
             if(u1_tfr_n_mb)
                 u1_num_mbs = 0;
             u1_mb_idx = u1_num_mbs;
@@ -1829,8 +1823,9 @@ WORD32 ih264d_mark_err_slice_skip(dec_struct_t * ps_dec,
         }
     }
 
+    ps_dec->u1_conceal_slice = 0;
     ps_dec->u4_num_mbs_cur_nmb = 0;
-    ps_dec->ps_cur_slice->u4_mbs_in_slice = i2_cur_mb_addr
+    ps_dec->ps_cur_slice->u4_mbs_in_slice = i4_cur_mb_addr
                         - ps_dec->ps_parse_cur_slice->u4_first_mb_in_slice;
 
     H264_DEC_DEBUG_PRINT("Mbs in slice: %d\n", ps_dec->ps_cur_slice->u4_mbs_in_slice);
@@ -1844,7 +1839,7 @@ WORD32 ih264d_mark_err_slice_skip(dec_struct_t * ps_dec,
     ps_dec->i2_prev_slice_mbx = ps_dec->u2_mbx;
     ps_dec->i2_prev_slice_mby = ps_dec->u2_mby;
 
-    if(ps_dec->u2_total_mbs_coded
+    if(ps_dec->u4_total_mbs_coded
             >= ps_dec->u2_frm_ht_in_mbs * ps_dec->u2_frm_wd_in_mbs)
     {
         ps_dec->u1_pic_decode_done = 1;
@@ -1866,7 +1861,7 @@ WORD32 ih264d_mark_err_slice_skip(dec_struct_t * ps_dec,
  *    0 on Success and Error code otherwise
  **************************************************************************
  */
-WORD32 ih264d_parse_pslice(dec_struct_t *ps_dec, UWORD16 u2_first_mb_in_slice)
+WORD32 ih264d_parse_pslice(dec_struct_t *ps_dec, UWORD32 u4_first_mb_in_slice)
 {
     dec_pic_params_t * ps_pps = ps_dec->ps_cur_pps;
     dec_slice_params_t * ps_cur_slice = ps_dec->ps_cur_slice;
@@ -2176,7 +2171,7 @@ WORD32 ih264d_parse_pslice(dec_struct_t *ps_dec, UWORD16 u2_first_mb_in_slice)
 
     ps_dec->u1_B = 0;
     ps_dec->pf_mvpred_ref_tfr_nby2mb = ih264d_mv_pred_ref_tfr_nby2_pmb;
-    ret = ps_dec->pf_parse_inter_slice(ps_dec, ps_cur_slice, u2_first_mb_in_slice);
+    ret = ps_dec->pf_parse_inter_slice(ps_dec, ps_cur_slice, u4_first_mb_in_slice);
     if(ret != OK)
         return ret;
 //    ps_dec->curr_slice_in_error = 0 ;
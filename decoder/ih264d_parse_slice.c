@@ -68,6 +68,7 @@
 #include "ih264d_thread_parse_decode.h"
 #include "ih264d_thread_compute_bs.h"
 #include "ih264d_dpb_manager.h"
+#include "ih264d_format_conv.h"
 #include <assert.h>
 #include "ih264d_parse_islice.h"
 #define RET_LAST_SKIP  0x80000000
@@ -558,7 +559,7 @@ WORD32 ih264d_start_of_pic(dec_struct_t *ps_dec,
     ps_dec->u1_mb_idx = 0;
     /* CHANGED CODE */
     ps_dec->ps_mv_left = ps_dec->s_cur_pic.ps_mv;
-    ps_dec->u2_total_mbs_coded = 0;
+    ps_dec->u4_total_mbs_coded = 0;
     ps_dec->i4_submb_ofst = -(SUB_BLK_SIZE);
     ps_dec->u4_pred_info_idx = 0;
     ps_dec->u4_pred_info_pkd_idx = 0;
@@ -668,7 +669,7 @@ WORD32 ih264d_start_of_pic(dec_struct_t *ps_dec,
     /**********************************************************************/
     /* High profile related initialization at pictrue level               */
     /**********************************************************************/
-    if(ps_seq->u1_profile_idc == HIGH_PROFILE_IDC)
+    if(ps_seq->u1_profile_idc >= HIGH_PROFILE_IDC)
     {
         if((ps_seq->i4_seq_scaling_matrix_present_flag)
                         || (ps_pps->i4_pic_scaling_matrix_present_flag))
@@ -720,6 +721,7 @@ WORD32 ih264d_start_of_pic(dec_struct_t *ps_dec,
     ps_dec->u4_deblk_mb_x = 0;
     ps_dec->u4_deblk_mb_y = 0;
 
+    ih264d_init_fused_fmt_conv(ps_dec);
 
     H264_MUTEX_UNLOCK(&ps_dec->process_disp_mutex);
     return OK;
@@ -751,8 +753,8 @@ WORD32 ih264d_end_of_pic_dispbuf_mgr(dec_struct_t * ps_dec)
                             || (ps_cur_slice->u1_nal_unit_type == IDR_SLICE_NAL))
             {
                 ps_dec->ps_cur_pic->i4_poc = 0;
-                if(ps_dec->u2_total_mbs_coded
-                                == (ps_dec->ps_cur_sps->u2_max_mb_addr + 1))
+                if(ps_dec->u4_total_mbs_coded
+                                == (ps_dec->ps_cur_sps->u4_max_mb_addr + 1))
                     ih264d_reset_ref_bufs(ps_dec->ps_dpb_mgr);
                 ih264d_release_display_bufs(ps_dec);
             }
@@ -956,7 +958,7 @@ WORD32 ih264d_end_of_pic(dec_struct_t *ps_dec,
     ret = ih264d_end_of_pic_processing(ps_dec);
     if(ret != OK)
         return ret;
-    ps_dec->u2_total_mbs_coded = 0;
+    ps_dec->u4_total_mbs_coded = 0;
     /*--------------------------------------------------------------------*/
     /* ih264d_decode_pic_order_cnt - calculate the Pic Order Cnt                    */
     /* Needed to detect end of picture                                    */
@@ -1023,7 +1025,8 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
     pocstruct_t s_tmp_poc;
     WORD32 i_delta_poc[2];
     WORD32 i4_poc = 0;
-    UWORD16 u2_first_mb_in_slice, u2_frame_num;
+    UWORD32 u4_first_mb_in_slice;
+    UWORD16 u2_frame_num;
     UWORD8 u1_field_pic_flag, u1_redundant_pic_cnt = 0, u1_slice_type;
     UWORD32 u4_idr_pic_id = 0;
     UWORD8 u1_bottom_field_flag, u1_pic_order_cnt_type;
@@ -1044,9 +1047,9 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
 
     /* read FirstMbInSlice  and slice type*/
     ps_dec->ps_dpb_cmds->u1_dpb_commands_read_slc = 0;
-    u2_first_mb_in_slice = ih264d_uev(pu4_bitstrm_ofst,
+    u4_first_mb_in_slice = ih264d_uev(pu4_bitstrm_ofst,
                                      pu4_bitstrm_buf);
-    if(u2_first_mb_in_slice
+    if(u4_first_mb_in_slice
                     > (ps_dec->u2_frm_ht_in_mbs * ps_dec->u2_frm_wd_in_mbs))
     {
 
@@ -1054,14 +1057,14 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
     }
 
     /*we currently don not support ASO*/
-    if(((u2_first_mb_in_slice << ps_cur_slice->u1_mbaff_frame_flag)
-                    <= ps_dec->u2_cur_mb_addr) && (ps_dec->u2_cur_mb_addr != 0)
+    if(((u4_first_mb_in_slice << ps_cur_slice->u1_mbaff_frame_flag)
+                    <= ps_dec->u4_cur_mb_addr) && (ps_dec->u4_cur_mb_addr != 0)
                     && (ps_dec->u4_first_slice_in_pic != 0))
     {
         return ERROR_CORRUPTED_SLICE;
     }
 
-    COPYTHECONTEXT("SH: first_mb_in_slice",u2_first_mb_in_slice);
+    COPYTHECONTEXT("SH: first_mb_in_slice",u4_first_mb_in_slice);
 
     u4_temp = ih264d_uev(pu4_bitstrm_ofst, pu4_bitstrm_buf);
 
@@ -1107,7 +1110,7 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
             }
 
             /* If one frame worth of data is already skipped, do not skip the next one */
-            if((0 == u2_first_mb_in_slice) && (1 == ps_dec->u4_prev_nal_skipped))
+            if((0 == u4_first_mb_in_slice) && (1 == ps_dec->u4_prev_nal_skipped))
             {
                 skip = 0;
             }
@@ -1152,10 +1155,15 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
     if(FALSE == ps_seq->u1_is_valid)
         return ERROR_INV_SPS_PPS_T;
 
+    /* 4:2:2 is supported for I slices only, P and B slices of such a */
+    /* sequence are reported as unsupported instead of being parsed   */
+    if((2 == ps_seq->i4_chroma_format_idc) && (I_SLICE != u1_slice_type))
+        return ERROR_FEATURE_UNAVAIL;
+
     /* Get the frame num */
     u2_frame_num = ih264d_get_bits_h264(ps_bitstrm,
                                          ps_seq->u1_bits_in_frm_num);
-//    H264_DEC_DEBUG_PRINT("FRAME %d First MB in slice: %d\n", u2_frame_num, u2_first_mb_in_slice);
+//    H264_DEC_DEBUG_PRINT("FRAME %d First MB in slice: %d\n", u2_frame_num, u4_first_mb_in_slice);
 
     COPYTHECONTEXT("SH: frame_num", u2_frame_num);
 //    H264_DEC_DEBUG_PRINT("Second field: %d frame num: %d prv_frame_num: %d \n", ps_dec->u1_second_field, u2_frame_num, ps_dec->u2_prv_frame_num);
@@ -1319,18 +1327,18 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
                 ps_cur_slice->u1_bottom_field_flag = 0;
 
             num_mb_skipped = (ps_dec->u2_frm_ht_in_mbs * ps_dec->u2_frm_wd_in_mbs)
-                    - ps_dec->u2_total_mbs_coded;
+                    - ps_dec->u4_total_mbs_coded;
             ps_cur_poc = &ps_dec->s_cur_pic_poc;
 
             u1_is_idr_slice = ps_cur_slice->u1_nal_unit_type == IDR_SLICE_NAL;
         }
         else if(ps_dec->u4_first_slice_in_pic == 2)
         {
-            if(u2_first_mb_in_slice > 0)
+            if(u4_first_mb_in_slice > 0)
             {
                 // first slice - missing/header corruption
                 prev_slice_err = 1;
-                num_mb_skipped = u2_first_mb_in_slice << u1_mbaff;
+                num_mb_skipped = u4_first_mb_in_slice << u1_mbaff;
                 ps_cur_poc = &s_tmp_poc;
 
                 // initializing slice parameters
@@ -1356,7 +1364,7 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
                  * although i1_is_end_of_poc is set there could be  more slices in the frame,
                  * so conceal only till cur slice */
                 prev_slice_err = 1;
-                num_mb_skipped = u2_first_mb_in_slice << u1_mbaff;
+                num_mb_skipped = u4_first_mb_in_slice << u1_mbaff;
             }
             else
             {
@@ -1364,22 +1372,22 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
                  * completely */
                 prev_slice_err = 2;
                 num_mb_skipped = (ps_dec->u2_frm_ht_in_mbs * ps_dec->u2_frm_wd_in_mbs)
-                        - ps_dec->u2_total_mbs_coded;
+                        - ps_dec->u4_total_mbs_coded;
             }
             ps_cur_poc = &s_tmp_poc;
         }
     }
     else
     {
-        if((u2_first_mb_in_slice << u1_mbaff) > ps_dec->u2_total_mbs_coded)
+        if((u4_first_mb_in_slice << u1_mbaff) > ps_dec->u4_total_mbs_coded)
         {
             // previous slice - missing/corruption
             prev_slice_err = 2;
-            num_mb_skipped = (u2_first_mb_in_slice << u1_mbaff)
-                    - ps_dec->u2_total_mbs_coded;
+            num_mb_skipped = (u4_first_mb_in_slice << u1_mbaff)
+                    - ps_dec->u4_total_mbs_coded;
             ps_cur_poc = &s_tmp_poc;
         }
-        else if((u2_first_mb_in_slice << u1_mbaff) < ps_dec->u2_total_mbs_coded)
+        else if((u4_first_mb_in_slice << u1_mbaff) < ps_dec->u4_total_mbs_coded)
         {
             return ERROR_CORRUPTED_SLICE;
         }
@@ -1404,7 +1412,7 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
             return ERROR_INCOMPLETE_FRAME;
         }
 
-        if(ps_dec->u2_total_mbs_coded
+        if(ps_dec->u4_total_mbs_coded
                 >= ps_dec->u2_frm_ht_in_mbs * ps_dec->u2_frm_wd_in_mbs)
         {
             /* return if all MBs in frame are parsed*/
@@ -1436,11 +1444,11 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
     {
         UWORD8 uc_mbs_exceed = 0;
 
-        if(ps_dec->u2_total_mbs_coded
-                        == (ps_dec->ps_cur_sps->u2_max_mb_addr + 1))
+        if(ps_dec->u4_total_mbs_coded
+                        == (ps_dec->ps_cur_sps->u4_max_mb_addr + 1))
         {
-            /*u2_total_mbs_coded is forced  to u2_max_mb_addr+ 1 at the end of decode ,so
-             ,if it is first slice in pic dont consider u2_total_mbs_coded to detect new picture */
+            /*u4_total_mbs_coded is forced  to u4_max_mb_addr+ 1 at the end of decode ,so
+             ,if it is first slice in pic dont consider u4_total_mbs_coded to detect new picture */
             if(ps_dec->u4_first_slice_in_pic == 0)
                 uc_mbs_exceed = 1;
         }
@@ -1534,7 +1542,7 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
     ps_cur_slice->i4_delta_pic_order_cnt[0] = i_delta_poc[0];
     ps_cur_slice->i4_delta_pic_order_cnt[1] = i_delta_poc[1];
     ps_cur_slice->u4_idr_pic_id = u4_idr_pic_id;
-    ps_cur_slice->u2_first_mb_in_slice = u2_first_mb_in_slice;
+    ps_cur_slice->u4_first_mb_in_slice = u4_first_mb_in_slice;
     ps_cur_slice->u1_field_pic_flag = u1_field_pic_flag;
     ps_cur_slice->u1_bottom_field_flag = u1_bottom_field_flag;
     ps_cur_slice->u1_slice_type = u1_slice_type;
@@ -1573,7 +1581,7 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
 
     if(ps_dec->u4_first_slice_in_pic == 2)
     {
-        if(u2_first_mb_in_slice == 0)
+        if(u4_first_mb_in_slice == 0)
         {
             ret = ih264d_start_of_pic(ps_dec, i4_poc, &s_tmp_poc, u2_frame_num, ps_pps);
             if(ret != OK)
@@ -1600,22 +1608,14 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
         {
             if(ps_dec->u4_dec_thread_created == 0)
             {
-                ithread_create(ps_dec->pv_dec_thread_handle, NULL,
-                               (void *)ih264d_decode_picture_thread,
-                               (void *)ps_dec);
-
-                ps_dec->u4_dec_thread_created = 1;
+                ih264d_start_decode_thread(ps_dec);
             }
 
             if((ps_dec->u4_num_cores == 3) &&
                             ((ps_dec->u4_app_disable_deblk_frm == 0) || ps_dec->i1_recon_in_thread3_flag)
                             && (ps_dec->u4_bs_deblk_thread_created == 0))
             {
-                ps_dec->u4_start_recon_deblk = 0;
-                ithread_create(ps_dec->pv_bs_deblk_thread_handle, NULL,
-                               (void *)ih264d_recon_deblk_thread,
-                               (void *)ps_dec);
-                ps_dec->u4_bs_deblk_thread_created = 1;
+                ih264d_start_bs_deblk_thread(ps_dec);
             }
         }
 
@@ -1704,10 +1704,10 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
     {
         UWORD16 u2_mb_x, u2_mb_y;
 
-        ps_dec->i4_submb_ofst = ((u2_first_mb_in_slice
+        ps_dec->i4_submb_ofst = ((u4_first_mb_in_slice
                         << ps_cur_slice->u1_mbaff_frame_flag) * SUB_BLK_SIZE)
                         - SUB_BLK_SIZE;
-        if(u2_first_mb_in_slice)
+        if(u4_first_mb_in_slice)
         {
             UWORD8 u1_mb_aff;
             UWORD8 u1_field_pic;
@@ -1730,8 +1730,8 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
                 {
                     ps_trns_addr = &ps_dec->s_tran_addrecon;
                 }
-                u2_mb_x = MOD(u2_first_mb_in_slice, u2_frm_wd_in_mbs);
-                u2_mb_y = DIV(u2_first_mb_in_slice, u2_frm_wd_in_mbs);
+                u2_mb_x = MOD(u4_first_mb_in_slice, u2_frm_wd_in_mbs);
+                u2_mb_y = DIV(u4_first_mb_in_slice, u2_frm_wd_in_mbs);
 
                 u2_mb_y <<= u1_mb_aff;
 
@@ -1750,7 +1750,8 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
 
                 u4_frame_stride = ps_dec->u2_frm_wd_uv << u1_field_pic;
                 x_offset >>= 1;
-                y_offset = (u2_mb_y * u4_frame_stride) << 3;
+                y_offset = (u2_mb_y * u4_frame_stride)
+                                << (4 - ps_dec->u1_chroma_ht_shift);
 
                 x_offset *= YUV420SP_FACTOR;
 
@@ -1768,18 +1769,18 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
                 if(ps_dec->u1_separate_parse == 1)
                 {
                     ps_dec->ps_deblk_mbn = ps_dec->ps_deblk_pic
-                                    + (u2_first_mb_in_slice << u1_mb_aff);
+                                    + (u4_first_mb_in_slice << u1_mb_aff);
                 }
                 else
                 {
                         ps_dec->ps_deblk_mbn = ps_dec->ps_deblk_pic
-                                        + (u2_first_mb_in_slice << u1_mb_aff);
+                                        + (u4_first_mb_in_slice << u1_mb_aff);
                 }
 
-                ps_dec->u2_cur_mb_addr = (u2_first_mb_in_slice << u1_mb_aff);
+                ps_dec->u4_cur_mb_addr = (u4_first_mb_in_slice << u1_mb_aff);
 
                 ps_dec->ps_mv_cur = ps_dec->s_cur_pic.ps_mv
-                                + ((u2_first_mb_in_slice << u1_mb_aff) << 4);
+                                + ((u4_first_mb_in_slice << u1_mb_aff) << 4);
             }
         }
         else
@@ -1798,7 +1799,7 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
             u2_mb_x = 0xffff;
             u2_mb_y = 0;
             // assign the deblock structure pointers to start of slice
-            ps_dec->u2_cur_mb_addr = 0;
+            ps_dec->u4_cur_mb_addr = 0;
             ps_dec->ps_deblk_mbn = ps_dec->ps_deblk_pic;
             ps_dec->ps_mv_cur = ps_dec->s_cur_pic.ps_mv;
             ps_trns_addr->pu1_dest_y = ps_dec->s_cur_pic.pu1_buf1;
@@ -1814,9 +1815,9 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
         ps_dec->ps_part = ps_dec->ps_parse_part_params;
 
         ps_dec->u2_mbx =
-                        (MOD(u2_first_mb_in_slice - 1, ps_seq->u2_frm_wd_in_mbs));
+                        (MOD((WORD32)u4_first_mb_in_slice - 1, ps_seq->u2_frm_wd_in_mbs));
         ps_dec->u2_mby =
-                        (DIV(u2_first_mb_in_slice - 1, ps_seq->u2_frm_wd_in_mbs));
+                        (DIV((WORD32)u4_first_mb_in_slice - 1, ps_seq->u2_frm_wd_in_mbs));
         ps_dec->u2_mby <<= ps_cur_slice->u1_mbaff_frame_flag;
         ps_dec->i2_prev_slice_mbx = ps_dec->u2_mbx;
         ps_dec->i2_prev_slice_mby = ps_dec->u2_mby;
@@ -1829,7 +1830,7 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
     ps_dec->u4_next_mb_skip = 0;
 
     ps_dec->ps_parse_cur_slice->u4_first_mb_in_slice =
-                    ps_dec->ps_cur_slice->u2_first_mb_in_slice;
+                    ps_dec->ps_cur_slice->u4_first_mb_in_slice;
     ps_dec->ps_parse_cur_slice->slice_type =
                     ps_dec->ps_cur_slice->u1_slice_type;
 
@@ -1874,7 +1875,7 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
     {
         ps_dec->ps_cur_pic->u4_pack_slc_typ |= I_SLC_BIT;
 
-        ret = ih264d_parse_islice(ps_dec, u2_first_mb_in_slice);
+        ret = ih264d_parse_islice(ps_dec, u4_first_mb_in_slice);
 
         if(ps_dec->i4_pic_type != B_SLICE && ps_dec->i4_pic_type != P_SLICE)
             ps_dec->i4_pic_type = I_SLICE;
@@ -1883,7 +1884,7 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
     else if(u1_slice_type == P_SLICE)
     {
         ps_dec->ps_cur_pic->u4_pack_slc_typ |= P_SLC_BIT;
-        ret = ih264d_parse_pslice(ps_dec, u2_first_mb_in_slice);
+        ret = ih264d_parse_pslice(ps_dec, u4_first_mb_in_slice);
         ps_dec->u1_pr_sl_type = u1_slice_type;
         if(ps_dec->i4_pic_type != B_SLICE)
             ps_dec->i4_pic_type = P_SLICE;
@@ -1891,7 +1892,7 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
     else if(u1_slice_type == B_SLICE)
     {
         ps_dec->ps_cur_pic->u4_pack_slc_typ |= B_SLC_BIT;
-        ret = ih264d_parse_bslice(ps_dec, u2_first_mb_in_slice);
+        ret = ih264d_parse_bslice(ps_dec, u4_first_mb_in_slice);
         ps_dec->u1_pr_sl_type = u1_slice_type;
         ps_dec->i4_pic_type = B_SLICE;
     }
@@ -1916,7 +1917,7 @@ WORD32 ih264d_parse_decode_slice(UWORD8 u1_is_idr_slice,
 
     /* End of Picture detection */
 
-    if(ps_dec->u2_total_mbs_coded >= (ps_seq->u2_max_mb_addr + 1))
+    if(ps_dec->u4_total_mbs_coded >= (ps_seq->u4_max_mb_addr + 1))
     {
         ps_dec->u1_pic_decode_done = 1;
 
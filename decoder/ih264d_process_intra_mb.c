@@ -546,6 +546,8 @@ void ih264d_unpack_chroma_coeff4x4_mb(dec_struct_t * ps_dec,
     WORD32 i;
     WORD16 *pi2_dc_val_u = NULL;
     WORD16 *pi2_dc_val_v = NULL;
+    /* 4:2:2 has 8 DC values and two 8x8 blocks per component */
+    WORD32 i4_num_dc = 8 >> ps_dec->u1_chroma_ht_shift;
 
     PROFILE_DISABLE_UNPACK_CHROMA()
     if((ps_cur_mb_info->u1_cbp >> 4) == CBPC_ALLZERO)
@@ -559,61 +561,40 @@ void ih264d_unpack_chroma_coeff4x4_mb(dec_struct_t * ps_dec,
     {
         pi2_dc_val_u = (WORD16 *)ps_dec->pv_proc_tu_coeff_data;
 
-        ps_dec->pv_proc_tu_coeff_data = (void *)(pi2_dc_val_u + 4);
+        ps_dec->pv_proc_tu_coeff_data = (void *)(pi2_dc_val_u + i4_num_dc);
     }
     if(CHECKBIT(ps_cur_mb_info->u1_yuv_dc_block_flag,2))
     {
         pi2_dc_val_v = (WORD16 *)ps_dec->pv_proc_tu_coeff_data;
 
-        ps_dec->pv_proc_tu_coeff_data = (void *)(pi2_dc_val_v + 4);
+        ps_dec->pv_proc_tu_coeff_data = (void *)(pi2_dc_val_v + i4_num_dc);
     }
 
     if((ps_cur_mb_info->u1_cbp >> 4) == CBPC_NONZERO)
     {
         pi2_coeff_data = ps_dec->pi2_coeff_data;
-        ih264d_unpack_coeff4x4_8x8blk_chroma(ps_dec,
-                                             ps_cur_mb_info,
-                                             ui2_chroma_csbp,
-                                             pi2_coeff_data);
-
-        pi2_coeff_data += 64;
-        ui2_chroma_csbp = ui2_chroma_csbp >> 4;
-        ih264d_unpack_coeff4x4_8x8blk_chroma(ps_dec,
-                                             ps_cur_mb_info,
-                                             ui2_chroma_csbp,
-                                             pi2_coeff_data);
+        for(i = 0; i < (i4_num_dc >> 1); i++)
+        {
+            ih264d_unpack_coeff4x4_8x8blk_chroma(ps_dec,
+                                                 ps_cur_mb_info,
+                                                 ui2_chroma_csbp,
+                                                 pi2_coeff_data);
+
+            pi2_coeff_data += 64;
+            ui2_chroma_csbp = ui2_chroma_csbp >> 4;
+        }
 
     }
 
     pi2_coeff_data = ps_dec->pi2_coeff_data;
-    if(pi2_dc_val_u != NULL)
-    {
-        pi2_coeff_data[0] = *pi2_dc_val_u++;
-        pi2_coeff_data[1 * 16] = *pi2_dc_val_u++;
-        pi2_coeff_data[2 * 16] = *pi2_dc_val_u++;
-        pi2_coeff_data[3 * 16] = *pi2_dc_val_u++;
-    }
-    else
+    for(i = 0; i < i4_num_dc; i++)
     {
-        pi2_coeff_data[0] = 0;
-        pi2_coeff_data[1 * 16] = 0;
-        pi2_coeff_data[2 * 16] = 0;
-        pi2_coeff_data[3 * 16] = 0;
+        pi2_coeff_data[i * 16] = (pi2_dc_val_u != NULL) ? pi2_dc_val_u[i] : 0;
     }
-    pi2_coeff_data += 64;
-    if(pi2_dc_val_v != NULL)
+    pi2_coeff_data += (i4_num_dc << 4);
+    for(i = 0; i < i4_num_dc; i++)
     {
-        pi2_coeff_data[0] = *pi2_dc_val_v++;
-        pi2_coeff_data[1 * 16] = *pi2_dc_val_v++;
-        pi2_coeff_data[2 * 16] = *pi2_dc_val_v++;
-        pi2_coeff_data[3 * 16] = *pi2_dc_val_v++;
-    }
-    else
-    {
-        pi2_coeff_data[0] = 0;
-        pi2_coeff_data[1 * 16] = 0;
-        pi2_coeff_data[2 * 16] = 0;
-        pi2_coeff_data[3 * 16] = 0;
+        pi2_coeff_data[i * 16] = (pi2_dc_val_v != NULL) ? pi2_dc_val_v[i] : 0;
     }
 }
 UWORD32 ih264d_unpack_luma_coeff8x8_mb(dec_struct_t * ps_dec,
@@ -961,6 +942,25 @@ WORD32 ih264d_process_intra_mb(dec_struct_t * ps_dec,
                             au1_ngbr_pels, pu1_luma_rec_buffer, 1, ui_rec_width,
                             ((uc_useTopMB << 2) | u2_use_left_mb));
         }
+        if(NULL != ps_dec->pf_iquant_itrans_recon_luma_mb)
+        {
+            PROFILE_DISABLE_IQ_IT_RECON()
+            {
+                ps_dec->pf_iquant_itrans_recon_luma_mb(
+                                pi2_y_coeff,
+                                pu1_luma_rec_buffer,
+                                pu1_luma_rec_buffer,
+                                ui_rec_width,
+                                ui_rec_width,
+                                gau2_ih264_iquant_scale_4x4[ps_cur_mb_info->u1_qp_rem6],
+                                (UWORD16 *)ps_dec->s_high_profile.i2_scalinglist4x4[0],
+                                ps_cur_mb_info->u1_qp_div6,
+                                ps_cur_mb_info->u2_luma_csbp,
+                                u4_luma_dc_only_csbp,
+                                1);
+            }
+        }
+        else
         {
             UWORD32 i;
             WORD16 ai2_tmp[16];
@@ -1775,6 +1775,99 @@ WORD32 ih264d_process_intra_mb(dec_struct_t * ps_dec,
             }
         }
 
+        if(0 == ps_dec->u1_chroma_ht_shift)
+        {
+            /*----------------------------------------------------------------*/
+            /* 4:2:2 - 8x16 prediction and eight 4x4 blocks per component     */
+            /*----------------------------------------------------------------*/
+            UWORD16 au2_ngbr_pels[33];
+            UWORD16 *pu2_left_uv = (UWORD16 *)pu1_uleft;
+            UWORD16 u2_chroma_csbp =
+                            (u1_chroma_cbp == CBPC_NONZERO) ?
+                                            ps_cur_mb_info->u2_chroma_csbp : 0;
+            WORD32 i, i4_comp;
+
+            /* Field and MBAFF are not supported, so the left pack is uniform */
+            if(u2_use_left_mb)
+            {
+                for(i = 0; i < 16; i++)
+                    au2_ngbr_pels[16 - 1 - i] = pu2_left_uv[i
+                                    * u4_recwidth_cr / YUV420SP_FACTOR];
+            }
+            else
+            {
+                memset(au2_ngbr_pels, 0, 16 * sizeof(UWORD16));
+            }
+            au2_ngbr_pels[16] = *(UWORD16 *)pu1_u_top_left;
+            if(uc_useTopMB)
+            {
+                memcpy(au2_ngbr_pels + 16 + 1, pu1_top_u,
+                       8 * sizeof(UWORD16));
+            }
+            else
+            {
+                memset(au2_ngbr_pels + 16 + 1, 0, 8 * sizeof(UWORD16));
+            }
+
+            PROFILE_DISABLE_INTRA_PRED()
+            ps_dec->apf_intra_pred_chroma_422[u1_intra_chrom_pred_mode](
+                            (UWORD8 *)au2_ngbr_pels,
+                            pu1_mb_cb_rei1_buffer,
+                            1,
+                            u4_recwidth_cr,
+                            ((uc_useTopMB << 2) | (u2_use_left_mb << 4)
+                                            | u2_use_left_mb));
+
+            if(u1_chroma_cbp == CBPC_ALLZERO)
+                return OK;
+
+            pi2_y_coeff = ps_dec->pi2_coeff_data;
+            for(i4_comp = 0; i4_comp < 2; i4_comp++)
+            {
+                UWORD8 u1_qp_rem6 = i4_comp ? ps_cur_mb_info->u1_qpcr_rem6 :
+                                              ps_cur_mb_info->u1_qpc_rem6;
+                UWORD32 u4_scale = i4_comp ? ps_cur_mb_info->u1_qpcr_div6 :
+                                             ps_cur_mb_info->u1_qpc_div6;
+                UWORD16 *pu2_weigh_mat =
+                                (UWORD16 *)ps_dec->s_high_profile.i2_scalinglist4x4[1 + i4_comp];
+                WORD16 ai2_tmp[16];
+
+                for(i = 0; i < 8; i++)
+                {
+                    WORD16 *pi2_level = pi2_y_coeff + (i << 4);
+                    UWORD8 *pu1_pred_sblk = pu1_mb_cb_rei1_buffer + i4_comp
+                                    + ((i & 0x1) * BLK_SIZE * YUV420SP_FACTOR)
+                                    + (i >> 1) * (u4_recwidth_cr << 2);
+                    PROFILE_DISABLE_IQ_IT_RECON()
+                    {
+                        if(CHECKBIT(u2_chroma_csbp, i))
+                        {
+                            ps_dec->pf_iquant_itrans_recon_chroma_4x4(
+                                            pi2_level, pu1_pred_sblk,
+                                            pu1_pred_sblk, u4_recwidth_cr,
+                                            u4_recwidth_cr,
+                                            gau2_ih264_iquant_scale_4x4[u1_qp_rem6],
+                                            pu2_weigh_mat, u4_scale, ai2_tmp,
+                                            pi2_level);
+                        }
+                        else if(pi2_level[0] != 0)
+                        {
+                            ps_dec->pf_iquant_itrans_recon_chroma_4x4_dc(
+                                            pi2_level, pu1_pred_sblk,
+                                            pu1_pred_sblk, u4_recwidth_cr,
+                                            u4_recwidth_cr,
+                                            gau2_ih264_iquant_scale_4x4[u1_qp_rem6],
+                                            pu2_weigh_mat, u4_scale, ai2_tmp,
+                                            pi2_level);
+                        }
+                    }
+                }
+                pi2_y_coeff += (MB_CHROM_SIZE << 1);
+                u2_chroma_csbp = u2_chroma_csbp >> 8;
+            }
+            return OK;
+        }
+
         /* CHANGED CODE */
         if(u1_chroma_cbp != CBPC_ALLZERO)
         {
@@ -1853,82 +1946,102 @@ WORD32 ih264d_process_intra_mb(dec_struct_t * ps_dec,
             u4_scale_v = ps_cur_mb_info->u1_qpcr_div6;
             pi2_y_coeff = ps_dec->pi2_coeff_data;
 
+            if(NULL != ps_dec->pf_iquant_itrans_recon_chroma_mb)
             {
-                UWORD32 i;
-                WORD16 ai2_tmp[16];
-                for(i = 0; i < 4; i++)
+                PROFILE_DISABLE_IQ_IT_RECON()
                 {
-                    WORD16 *pi2_level = pi2_y_coeff + (i << 4);
-                    UWORD8 *pu1_pred_sblk = pu1_mb_cb_rei1_buffer
-                                    + ((i & 0x1) * BLK_SIZE * YUV420SP_FACTOR)
-                                    + (i >> 1) * (u4_recwidth_cr << 2);
-                    PROFILE_DISABLE_IQ_IT_RECON()
+                    ps_dec->pf_iquant_itrans_recon_chroma_mb(
+                                    pi2_y_coeff,
+                                    pu1_mb_cb_rei1_buffer,
+                                    pu1_mb_cb_rei1_buffer,
+                                    u4_recwidth_cr,
+                                    u4_recwidth_cr,
+                                    gau2_ih264_iquant_scale_4x4[ps_cur_mb_info->u1_qpc_rem6],
+                                    gau2_ih264_iquant_scale_4x4[ps_cur_mb_info->u1_qpcr_rem6],
+                                    (UWORD16 *)ps_dec->s_high_profile.i2_scalinglist4x4[1],
+                                    (UWORD16 *)ps_dec->s_high_profile.i2_scalinglist4x4[2],
+                                    u4_scale_u, u4_scale_v, u2_chroma_csbp);
+                }
+            }
+            else
+            {
+                {
+                    UWORD32 i;
+                    WORD16 ai2_tmp[16];
+                    for(i = 0; i < 4; i++)
                     {
-                        if(CHECKBIT(u2_chroma_csbp, i))
-                        {
-                            ps_dec->pf_iquant_itrans_recon_chroma_4x4(
-                                            pi2_level,
-                                            pu1_pred_sblk,
-                                            pu1_pred_sblk,
-                                            u4_recwidth_cr,
-                                            u4_recwidth_cr,
-                                            gau2_ih264_iquant_scale_4x4[ps_cur_mb_info->u1_qpc_rem6],
-                                            (UWORD16 *)ps_dec->s_high_profile.i2_scalinglist4x4[1],
-                                            u4_scale_u, ai2_tmp, pi2_level);
-                        }
-                        else if(pi2_level[0] != 0)
+                        WORD16 *pi2_level = pi2_y_coeff + (i << 4);
+                        UWORD8 *pu1_pred_sblk = pu1_mb_cb_rei1_buffer
+                                        + ((i & 0x1) * BLK_SIZE * YUV420SP_FACTOR)
+                                        + (i >> 1) * (u4_recwidth_cr << 2);
+                        PROFILE_DISABLE_IQ_IT_RECON()
                         {
-                            ps_dec->pf_iquant_itrans_recon_chroma_4x4_dc(
-                                            pi2_level,
-                                            pu1_pred_sblk,
-                                            pu1_pred_sblk,
-                                            u4_recwidth_cr,
-                                            u4_recwidth_cr,
-                                            gau2_ih264_iquant_scale_4x4[ps_cur_mb_info->u1_qpc_rem6],
-                                            (UWORD16 *)ps_dec->s_high_profile.i2_scalinglist4x4[1],
-                                            u4_scale_u, ai2_tmp, pi2_level);
+                            if(CHECKBIT(u2_chroma_csbp, i))
+                            {
+                                ps_dec->pf_iquant_itrans_recon_chroma_4x4(
+                                                pi2_level,
+                                                pu1_pred_sblk,
+                                                pu1_pred_sblk,
+                                                u4_recwidth_cr,
+                                                u4_recwidth_cr,
+                                                gau2_ih264_iquant_scale_4x4[ps_cur_mb_info->u1_qpc_rem6],
+                                                (UWORD16 *)ps_dec->s_high_profile.i2_scalinglist4x4[1],
+                                                u4_scale_u, ai2_tmp, pi2_level);
+                            }
+                            else if(pi2_level[0] != 0)
+                            {
+                                ps_dec->pf_iquant_itrans_recon_chroma_4x4_dc(
+                                                pi2_level,
+                                                pu1_pred_sblk,
+                                                pu1_pred_sblk,
+                                                u4_recwidth_cr,
+                                                u4_recwidth_cr,
+                                                gau2_ih264_iquant_scale_4x4[ps_cur_mb_info->u1_qpc_rem6],
+                                                (UWORD16 *)ps_dec->s_high_profile.i2_scalinglist4x4[1],
+                                                u4_scale_u, ai2_tmp, pi2_level);
+                            }
                         }
-                    }
 
+                    }
                 }
-            }
 
-            pi2_y_coeff += MB_CHROM_SIZE;
-            u2_chroma_csbp = u2_chroma_csbp >> 4;
-            {
-                UWORD32 i;
-                WORD16 ai2_tmp[16];
-                for(i = 0; i < 4; i++)
+                pi2_y_coeff += MB_CHROM_SIZE;
+                u2_chroma_csbp = u2_chroma_csbp >> 4;
                 {
-                    WORD16 *pi2_level = pi2_y_coeff + (i << 4);
-                    UWORD8 *pu1_pred_sblk = pu1_mb_cb_rei1_buffer + 1
-                                    + ((i & 0x1) * BLK_SIZE * YUV420SP_FACTOR)
-                                    + (i >> 1) * (u4_recwidth_cr << 2);
-                    PROFILE_DISABLE_IQ_IT_RECON()
+                    UWORD32 i;
+                    WORD16 ai2_tmp[16];
+                    for(i = 0; i < 4; i++)
                     {
-                        if(CHECKBIT(u2_chroma_csbp, i))
+                        WORD16 *pi2_level = pi2_y_coeff + (i << 4);
+                        UWORD8 *pu1_pred_sblk = pu1_mb_cb_rei1_buffer + 1
+                                        + ((i & 0x1) * BLK_SIZE * YUV420SP_FACTOR)
+                                        + (i >> 1) * (u4_recwidth_cr << 2);
+                        PROFILE_DISABLE_IQ_IT_RECON()
                         {
-                            ps_dec->pf_iquant_itrans_recon_chroma_4x4(
-                                            pi2_level,
-                                            pu1_pred_sblk,
-                                            pu1_pred_sblk,
-                                            u4_recwidth_cr,
-                                            u4_recwidth_cr,
-                                            gau2_ih264_iquant_scale_4x4[ps_cur_mb_info->u1_qpcr_rem6],
-                                            (UWORD16 *)ps_dec->s_high_profile.i2_scalinglist4x4[2],
-                                            u4_scale_v, ai2_tmp, pi2_level);
-                        }
-                        else if(pi2_level[0] != 0)
-                        {
-                            ps_dec->pf_iquant_itrans_recon_chroma_4x4_dc(
-                                            pi2_level,
-                                            pu1_pred_sblk,
-                                            pu1_pred_sblk,
-                                            u4_recwidth_cr,
-                                            u4_recwidth_cr,
-                                            gau2_ih264_iquant_scale_4x4[ps_cur_mb_info->u1_qpcr_rem6],
-                                            (UWORD16 *)ps_dec->s_high_profile.i2_scalinglist4x4[2],
-                                            u4_scale_v, ai2_tmp, pi2_level);
+                            if(CHECKBIT(u2_chroma_csbp, i))
+                            {
+                                ps_dec->pf_iquant_itrans_recon_chroma_4x4(
+                                                pi2_level,
+                                                pu1_pred_sblk,
+                                                pu1_pred_sblk,
+                                                u4_recwidth_cr,
+                                                u4_recwidth_cr,
+                                                gau2_ih264_iquant_scale_4x4[ps_cur_mb_info->u1_qpcr_rem6],
+                                                (UWORD16 *)ps_dec->s_high_profile.i2_scalinglist4x4[2],
+                                                u4_scale_v, ai2_tmp, pi2_level);
+                            }
+                            else if(pi2_level[0] != 0)
+                            {
+                                ps_dec->pf_iquant_itrans_recon_chroma_4x4_dc(
+                                                pi2_level,
+                                                pu1_pred_sblk,
+                                                pu1_pred_sblk,
+                                                u4_recwidth_cr,
+                                                u4_recwidth_cr,
+                                                gau2_ih264_iquant_scale_4x4[ps_cur_mb_info->u1_qpcr_rem6],
+                                                (UWORD16 *)ps_dec->s_high_profile.i2_scalinglist4x4[2],
+                                                u4_scale_v, ai2_tmp, pi2_level);
+                            }
                         }
                     }
                 }
@@ -67,6 +67,71 @@ void ih264d_insert_pic_in_ref_pic_listx(struct pic_buffer_t *ps_ref_pic_buf_lx,
     *ps_ref_pic_buf_lx = *ps_pic;
 }
 
+/*!
+ **************************************************************************
+ * \if Function name : ih264d_conceal_mv \endif
+ *
+ * \brief
+ *    Picks the MV of a skip MB that fills in for a missing slice. The
+ *    ref_idx 0 MVs along the bottom edge of the MB above are averaged, or
+ *    failing that the ref_idx 0 MVs of the co-located MB of the first
+ *    reference, so that the motion of the surrounding picture carries
+ *    into the lost rows instead of a zero MV copy. The predicted MV is
+ *    kept when neither is available
+ *
+ * \return
+ *    None
+ **************************************************************************
+ */
+static void ih264d_conceal_mv(dec_struct_t * ps_dec,
+                              dec_mb_info_t * ps_cur_mb_info,
+                              mv_pred_t *ps_mv_ntop,
+                              pic_buffer_t *ps_ref_frame,
+                              mv_pred_t *ps_mv_pred)
+{
+    WORD32 i4_sum_x = 0, i4_sum_y = 0, i4_cnt = 0;
+    WORD32 i;
+
+    if(ps_cur_mb_info->u2_mby > 0)
+    {
+        for(i = 0; i < 4; i++)
+        {
+            if(0 == ps_mv_ntop[i].i1_ref_frame[0])
+            {
+                i4_sum_x += ps_mv_ntop[i].i2_mv[0];
+                i4_sum_y += ps_mv_ntop[i].i2_mv[1];
+                i4_cnt++;
+            }
+        }
+    }
+
+    /* Co-located MVs are usable only if the reference is a plain frame */
+    if((0 == i4_cnt) && (NULL != ps_ref_frame->ps_mv)
+                    && (FRM_PIC == ps_ref_frame->u1_picturetype))
+    {
+        mv_pred_t *ps_mv_col;
+
+        ps_mv_col = ps_ref_frame->ps_mv
+                        + ((ps_cur_mb_info->u2_mby * ps_dec->u2_frm_wd_in_mbs
+                                        + ps_cur_mb_info->u2_mbx) << 4);
+        for(i = 0; i < 16; i++)
+        {
+            if(0 == ps_mv_col[i].i1_ref_frame[0])
+            {
+                i4_sum_x += ps_mv_col[i].i2_mv[0];
+                i4_sum_y += ps_mv_col[i].i2_mv[1];
+                i4_cnt++;
+            }
+        }
+    }
+
+    if(i4_cnt)
+    {
+        ps_mv_pred->i2_mv[0] = i4_sum_x / i4_cnt;
+        ps_mv_pred->i2_mv[1] = i4_sum_y / i4_cnt;
+    }
+}
+
 WORD32 ih264d_mv_pred_ref_tfr_nby2_pmb(dec_struct_t * ps_dec,
                                      UWORD8 u1_mb_idx,
                                      UWORD8 u1_num_mbs)
@@ -191,6 +256,13 @@ WORD32 ih264d_mv_pred_ref_tfr_nby2_pmb(dec_struct_t * ps_dec,
                                       ps_mv_ntop_start, &s_mvPred, 0, 4, 0, 1,
                                       MB_SKIP);
 
+                    if(ps_dec->u1_conceal_slice)
+                    {
+                        ih264d_conceal_mv(ps_dec, ps_cur_mb_info,
+                                          ps_mv_ntop_start, ps_ref_frame,
+                                          &s_mvPred);
+                    }
+
 
 
 
@@ -332,7 +404,7 @@ WORD32 ih264d_mv_pred_ref_tfr_nby2_pmb(dec_struct_t * ps_dec,
 WORD32 ih264d_decode_recon_tfr_nmb(dec_struct_t * ps_dec,
                                    UWORD8 u1_mb_idx,
                                    UWORD8 u1_num_mbs,
-                                   UWORD8 u1_num_mbs_next,
+                                   UWORD32 u1_num_mbs_next,
                                    UWORD8 u1_tfr_n_mb,
                                    UWORD8 u1_end_of_row)
 {
@@ -491,7 +563,7 @@ WORD32 ih264d_decode_recon_tfr_nmb(dec_struct_t * ps_dec,
         u1_end_of_row_next =
                         u1_num_mbs_next
                                         && (u1_num_mbs_next
-                                                        <= (ps_dec->u1_recon_mb_grp
+                                                        <= (UWORD32)(ps_dec->u1_recon_mb_grp
                                                                         >> u1_mbaff));
 
         /****************************************************************/
@@ -509,6 +581,16 @@ WORD32 ih264d_decode_recon_tfr_nmb(dec_struct_t * ps_dec,
         ps_dec->u4_pred_info_idx = 0;
         ps_dec->u4_dma_buf_idx = 0;
 
+        /* Coeff and packed pred data of this N-MB are consumed, */
+        /* so the next N-MB reuses the buffers from the start    */
+        if(ps_dec->u4_compact_mem)
+        {
+            ps_dec->pv_parse_tu_coeff_data = ps_dec->pv_pic_tu_coeff_data;
+            ps_dec->pv_proc_tu_coeff_data = ps_dec->pv_pic_tu_coeff_data;
+            ps_dec->pv_prev_mb_parse_tu_coeff_data = ps_dec->pv_pic_tu_coeff_data;
+            ps_dec->u4_pred_info_pkd_idx = 0;
+        }
+
 
     }
     return OK;
@@ -601,7 +683,26 @@ WORD32 ih264d_process_inter_mb(dec_struct_t * ps_dec,
     if(ps_cur_mb_info->u1_cbp & 0x0f)
     {
         /* CHANGED CODE */
-        if(!ps_cur_mb_info->u1_tran_form8x8)
+        if(!ps_cur_mb_info->u1_tran_form8x8
+                        && (NULL != ps_dec->pf_iquant_itrans_recon_luma_mb))
+        {
+            PROFILE_DISABLE_IQ_IT_RECON()
+            {
+                ps_dec->pf_iquant_itrans_recon_luma_mb(
+                                pi2_y_coeff,
+                                pu1_rec_y,
+                                pu1_rec_y,
+                                ui_rec_width,
+                                ui_rec_width,
+                                gau2_ih264_iquant_scale_4x4[ps_cur_mb_info->u1_qp_rem6],
+                                (UWORD16 *)ps_dec->s_high_profile.i2_scalinglist4x4[3],
+                                ps_cur_mb_info->u1_qp_div6,
+                                ps_cur_mb_info->u2_luma_csbp & ~u4_luma_dc_only_csbp,
+                                ps_cur_mb_info->u2_luma_csbp & u4_luma_dc_only_csbp,
+                                0);
+            }
+        }
+        else if(!ps_cur_mb_info->u1_tran_form8x8)
         {
             UWORD32 i;
             WORD16 ai2_tmp[16];
@@ -713,6 +814,25 @@ WORD32 ih264d_process_inter_mb(dec_struct_t * ps_dec,
 
             pi2_y_coeff = ps_dec->pi2_coeff_data;
 
+            if(NULL != ps_dec->pf_iquant_itrans_recon_chroma_mb)
+            {
+                PROFILE_DISABLE_IQ_IT_RECON()
+                {
+                    ps_dec->pf_iquant_itrans_recon_chroma_mb(
+                                    pi2_y_coeff,
+                                    pu1_rec_u,
+                                    pu1_rec_u,
+                                    u4_recwidth_cr,
+                                    u4_recwidth_cr,
+                                    gau2_ih264_iquant_scale_4x4[ps_cur_mb_info->u1_qpc_rem6],
+                                    gau2_ih264_iquant_scale_4x4[ps_cur_mb_info->u1_qpcr_rem6],
+                                    (UWORD16 *)ps_dec->s_high_profile.i2_scalinglist4x4[4],
+                                    (UWORD16 *)ps_dec->s_high_profile.i2_scalinglist4x4[5],
+                                    u4_scale_u, u4_scale_v, u2_chroma_csbp);
+                }
+                return (0);
+            }
+
             {
                 UWORD32 i;
                 WORD16 ai2_tmp[16];
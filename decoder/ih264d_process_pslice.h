@@ -39,13 +39,13 @@
 #include "ih264_platform_macros.h"
 #include "ih264d_structs.h"
 WORD32 ih264d_parse_pslice(dec_struct_t *ps_dec,
-                            UWORD16 u2_first_mb_in_slice);
+                            UWORD32 u4_first_mb_in_slice);
 WORD32 ih264d_parse_pred_weight_table(dec_slice_params_t * ps_cur_slice,
                                     dec_bit_stream_t * ps_bitstrm);
 
 WORD32 parsePSliceData(dec_struct_t * ps_dec,
                        dec_slice_params_t * ps_slice,
-                       UWORD16 u2_first_mb_in_slice);
+                       UWORD32 u4_first_mb_in_slice);
 
 WORD32 ih264d_process_inter_mb(dec_struct_t * ps_dec,
                                dec_mb_info_t * ps_cur_mb_info,
@@ -60,7 +60,7 @@ WORD32 ih264d_mv_pred_ref_tfr_nby2_pmb(dec_struct_t * ps_dec,
 WORD32 ih264d_decode_recon_tfr_nmb(dec_struct_t * ps_dec,
                                  UWORD8 u1_mb_idx,
                                  UWORD8 u1_num_mbs,
-                                 UWORD8 u1_num_mbs_next,
+                                 UWORD32 u1_num_mbs_next,
                                  UWORD8 u1_tfr_n_mb,
                                  UWORD8 u1_end_of_row);
 
@@ -58,6 +58,8 @@
 /* MB_GROUP should be a multiple of 2                       */
 /************************************************************/
 #define PARSE_MB_GROUP_4            4
+/* Largest MB group, NMB counters are 8 bit */
+#define MAX_RECON_MB_GRP            254
 
 /* MV_SCRATCH_BUFS assumed to be pow(2) */
 #define MV_SCRATCH_BUFS             4
@@ -309,8 +311,8 @@ typedef struct
 
     /* Following are derived from the above two */
     UWORD16 u2_fld_ht_in_mbs; /** Field height expressed in MB units */
-    UWORD16 u2_max_mb_addr; /** Total number of macroblocks in a coded picture */
-    UWORD16 u2_total_num_of_mbs; /** Total number of macroblocks in a coded picture */
+    UWORD32 u4_max_mb_addr; /** Total number of macroblocks in a coded picture */
+    UWORD32 u4_total_num_of_mbs; /** Total number of macroblocks in a coded picture */
     UWORD32 u4_fld_ht; /** field height */
     UWORD32 u4_cwidth; /** chroma width */
     UWORD32 u4_chr_frm_ht; /** chroma height */
@@ -486,7 +488,7 @@ typedef struct
     WORD32 i4_delta_pic_order_cnt[2];
     WORD32 i4_poc; /** Pic order cnt of picture to which slice belongs*/
     UWORD32 u4_idr_pic_id; /** IDR pic ID */
-    UWORD16 u2_first_mb_in_slice; /** Address of first MB in slice*/
+    UWORD32 u4_first_mb_in_slice; /** Address of first MB in slice*/
     UWORD16 u2_frame_num; /** Frame number from prev IDR pic */
 
     UWORD8 u1_mbaff_frame_flag; /** Mb adaptive frame field u4_flag */
@@ -726,6 +728,7 @@ typedef struct _DecStruct
     UWORD16 u2_frm_ht_y; /** Height for luma buff */
     UWORD16 u2_frm_wd_uv; /** Width for chroma buff */
     UWORD16 u2_frm_ht_uv; /** Height for chroma buff */
+    UWORD8 u1_chroma_ht_shift; /** log2 of SubHeightC: 1 for 4:2:0, 0 for 4:2:2 */
     UWORD16 u2_frm_wd_in_mbs; /** Frame width expressed in MB units */
     UWORD16 u2_frm_ht_in_mbs; /** Frame height expressed in MB units */
     WORD32 i4_submb_ofst; /** Offset in subMbs from the top left edge */
@@ -828,7 +831,8 @@ typedef struct _DecStruct
     UWORD32 u4_n_left_temp_y;
 
     UWORD8 pu1_left_nnz_y[4];
-    UWORD8 pu1_left_nnz_uv[4];
+    /* 4:2:2 uses all 8 entries: [4..7] hold the bottom half of the MB */
+    UWORD8 pu1_left_nnz_uv[8];
     UWORD32 u4_n_left_temp_uv;
     /***************************************************************************/
     /*          Base pointer to all the cabac contexts                         */
@@ -960,10 +964,10 @@ typedef struct _DecStruct
 
     WORD32 (*pf_parse_inter_slice)(struct _DecStruct * ps_dec,
                                    dec_slice_params_t * ps_slice,
-                                   UWORD16 u2_first_mb_in_slice);
+                                   UWORD32 u4_first_mb_in_slice);
 
     UWORD32 (*pf_get_mb_info)(struct _DecStruct * ps_dec,
-                              const UWORD16 u2_cur_mb_address,
+                              const UWORD32 u4_cur_mb_address,
                               dec_mb_info_t * ps_cur_mb_info,
                               UWORD32 u4_mbskip_run);
 
@@ -1073,7 +1077,7 @@ typedef struct _DecStruct
     UWORD32 u4_skip_frm_mask;
 
     /* variable for finding the no.of mbs decoded in the current picture */
-    UWORD16 u2_total_mbs_coded;
+    UWORD32 u4_total_mbs_coded;
     /* member added for supporting fragmented annex - B */
 //  frg_annex_read_t s_frag_annex_read;
     /* added for vui_t, sei support*/
@@ -1195,6 +1199,10 @@ typedef struct _DecStruct
     UWORD8 u1_chroma_format;
     UWORD8 u1_pic_decode_done;
     UWORD8 u1_slice_header_done;
+
+    /* Set while skip MBs are inserted for a missing slice, their MVs */
+    /* are then taken from the neighbouring and co-located MBs        */
+    UWORD8 u1_conceal_slice;
     WORD32 init_done;
 
     /******************************************/
@@ -1238,6 +1246,64 @@ typedef struct _DecStruct
     UWORD32 u4_disp_buf_to_be_freed[MAX_DISP_BUFS_NEW];
     UWORD32 u4_share_disp_buf;
     UWORD32 u4_num_disp_bufs;
+
+    /**
+     * Buffers are sized for the active SPS and a single decode thread
+     */
+    UWORD32 u4_compact_mem;
+
+    /**
+     * Bytes held in buffers allocated at create and per SPS
+     */
+    UWORD32 u4_static_mem_size;
+    UWORD32 u4_dynamic_mem_size;
+
+    /**
+     * YUV to RGB matrix (IH264D_CSC_MATRIX_T) and range used for RGB outputs
+     */
+    UWORD32 u4_csc_matrix;
+    UWORD32 u4_csc_full_range;
+
+    /**
+     * Convert the current picture to the output format from the deblocking
+     * loop, one MB row at a time. Only armed for frame pictures in
+     * IVD_DECODE_FRAME_OUT mode, where the picture being decoded is the one
+     * returned for display by the same call
+     */
+    UWORD32 u4_fused_fmt_conv;
+    UWORD32 u4_fused_fmt_conv_active;
+    UWORD32 u4_fused_fmt_conv_cur_row;
+    UWORD32 u4_fused_fmt_conv_buf_id;
+    iv_yuv_buf_t s_fused_frame_info;
+    ivd_get_display_frame_op_t s_fused_disp_op;
+
+    /**
+     * Output downscaling set through IH264D_CMD_CTL_SET_OUTPUT_SCALE and the
+     * scratch holding OUT_SCALE_NUM_ROWS decimated 420SP rows
+     */
+    UWORD32 u4_out_scale_shift;
+    UWORD32 u4_out_scale_filter;
+    UWORD8 *pu1_out_scale_buf;
+
+    /**
+     * Displayed pictures are returned in place as handles, see
+     * u4_enable_disp_handles. au4_disp_handle_refs counts the holders of each
+     * picture; its BUF_MGR_IO status is released when the count drops to 0
+     */
+    UWORD32 u4_disp_handles;
+    UWORD32 au4_disp_handle_refs[MAX_DISP_BUFS_NEW];
+
+    /**
+     * Pool the dynamic buffers are carved from when u4_buf_pool_max_wd/ht
+     * are set. u4_buf_pool_reqd is what the last allocation needed, the pool
+     * is regrown only when that exceeds u4_buf_pool_size
+     */
+    UWORD32 u4_buf_pool_max_wd;
+    UWORD32 u4_buf_pool_max_ht;
+    UWORD8 *pu1_buf_pool;
+    UWORD32 u4_buf_pool_size;
+    UWORD32 u4_buf_pool_used;
+    UWORD32 u4_buf_pool_reqd;
     UWORD32 u4_prev_nal_skipped;
     UWORD32 u4_return_to_app;
     WORD32 i4_dec_skip_mode;
@@ -1263,15 +1329,41 @@ typedef struct _DecStruct
     ivd_get_display_frame_op_t s_disp_op;
     UWORD32 u4_output_present;
 
-    volatile UWORD16 cur_dec_mb_num;
-    volatile UWORD16 cur_recon_mb_num;
-    volatile UWORD16 u2_cur_mb_addr;
+    volatile UWORD32 cur_dec_mb_num;
+    volatile UWORD32 cur_recon_mb_num;
+    volatile UWORD32 u4_cur_mb_addr;
     WORD16 i2_dec_thread_mb_y;
     WORD16 i2_recon_thread_mb_y;
 
     UWORD8 u1_separate_parse;
     UWORD32 u4_dec_thread_created;
     void *pv_dec_thread_handle;
+
+    /**
+     * Set during a batch decode, the decode and bs / deblock threads are then
+     * kept alive across pictures and woken up through the start semaphores
+     */
+    UWORD32 u4_keep_threads_active;
+
+    /**
+     * Asks the persistent threads to exit when they are woken up next
+     */
+    volatile UWORD32 u4_break_threads;
+
+    /**
+     * Flags indicating that the persistent threads have been created
+     */
+    UWORD32 u4_dec_thread_alive;
+    UWORD32 u4_bs_deblk_thread_alive;
+
+    /**
+     * Semaphores used to hand a picture to a persistent thread and to wait
+     * for it to be done
+     */
+    void *pv_dec_thread_start_sem;
+    void *pv_dec_thread_done_sem;
+    void *pv_bs_deblk_thread_start_sem;
+    void *pv_bs_deblk_thread_done_sem;
     volatile UWORD8 *pu1_dec_mb_map;
     volatile UWORD8 *pu1_recon_mb_map;
     volatile UWORD16 *pu2_slice_num_map;
@@ -1386,6 +1478,9 @@ typedef struct _DecStruct
 
     ih264_intra_pred_chroma_ft *apf_intra_pred_chroma[4];
 
+    /** 8x16 chroma predictors used for 4:2:2 */
+    ih264_intra_pred_chroma_ft *apf_intra_pred_chroma_422[4];
+
     ih264_iquant_itrans_recon_ft *pf_iquant_itrans_recon_luma_4x4;
 
     ih264_iquant_itrans_recon_ft *pf_iquant_itrans_recon_luma_4x4_dc;
@@ -1398,8 +1493,62 @@ typedef struct _DecStruct
 
     ih264_iquant_itrans_recon_chroma_ft *pf_iquant_itrans_recon_chroma_4x4_dc;
 
+    ih264_iquant_itrans_recon_luma_mb_ft *pf_iquant_itrans_recon_luma_mb;
+
+    ih264_iquant_itrans_recon_chroma_mb_ft *pf_iquant_itrans_recon_chroma_mb;
+
     ih264_ihadamard_scaling_ft *pf_ihadamard_scaling_4x4;
 
+    /**
+     * Output format conversion from the 420SP display buffer
+     */
+    void (*pf_fmt_conv_420sp_to_420p)(UWORD8 *pu1_y_src,
+                                      UWORD8 *pu1_uv_src,
+                                      UWORD8 *pu1_y_dst,
+                                      UWORD8 *pu1_u_dst,
+                                      UWORD8 *pu1_v_dst,
+                                      WORD32 wd,
+                                      WORD32 ht,
+                                      WORD32 src_y_strd,
+                                      WORD32 src_uv_strd,
+                                      WORD32 dst_y_strd,
+                                      WORD32 dst_uv_strd,
+                                      WORD32 is_u_first,
+                                      WORD32 disable_luma_copy);
+
+    void (*pf_fmt_conv_420sp_to_420sp_swap_uv)(UWORD8 *pu1_y_src,
+                                               UWORD8 *pu1_uv_src,
+                                               UWORD8 *pu1_y_dst,
+                                               UWORD8 *pu1_uv_dst,
+                                               WORD32 wd,
+                                               WORD32 ht,
+                                               WORD32 src_y_strd,
+                                               WORD32 src_uv_strd,
+                                               WORD32 dst_y_strd,
+                                               WORD32 dst_uv_strd);
+
+    void (*pf_fmt_conv_420sp_to_rgb565)(UWORD8 *pu1_y_src,
+                                        UWORD8 *pu1_uv_src,
+                                        UWORD16 *pu2_rgb_dst,
+                                        WORD32 wd,
+                                        WORD32 ht,
+                                        WORD32 src_y_strd,
+                                        WORD32 src_uv_strd,
+                                        WORD32 dst_strd,
+                                        WORD32 is_u_first,
+                                        const WORD16 *pi2_csc_coeffs);
+
+    void (*pf_fmt_conv_420sp_to_rgba8888)(UWORD8 *pu1_y_src,
+                                          UWORD8 *pu1_uv_src,
+                                          UWORD32 *pu4_rgba_dst,
+                                          WORD32 wd,
+                                          WORD32 ht,
+                                          WORD32 src_y_strd,
+                                          WORD32 src_uv_strd,
+                                          WORD32 dst_strd,
+                                          WORD32 is_u_first,
+                                          const WORD16 *pi2_csc_coeffs);
+
     /**
      * deblock vertical luma edge with blocking strength 4
      */
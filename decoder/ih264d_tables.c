@@ -757,6 +757,77 @@ const UWORD8 gau1_ih264d_cav_chromdc_vld[256] =
       0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28,
       0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, };
 
+/*****************************************************************************/
+/* Lookup table for CAVLC 4:2:2 ChromaDC total_coeff,trailing_ones parsing   */
+/* (nC = -2 in Table 9-5), indexed by the number of leading zeros and the 3  */
+/* bits following the first one. Starting from msb, First 4bits=total_coeff, */
+/* next 2bits=trailing_ones and last 2bits=suffix bits to flush. 0xFF marks  */
+/* an invalid code                                                           */
+/*****************************************************************************/
+const UWORD8 gau1_ih264d_cav_chromdc422_vld[11][8] =
+    {
+        { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, },
+        { 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, },
+        { 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, },
+        { 0x6F, 0x5F, 0x4B, 0x3B, 0x37, 0x27, 0x23, 0x13, },
+        { 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, },
+        { 0x4C, 0x4C, 0x4C, 0x4C, 0x4C, 0x4C, 0x4C, 0x4C, },
+        { 0x5A, 0x5A, 0x46, 0x46, 0x42, 0x42, 0x32, 0x32, },
+        { 0x7E, 0x7E, 0x6A, 0x6A, 0x56, 0x56, 0x52, 0x52, },
+        { 0x8E, 0x8E, 0x7A, 0x7A, 0x66, 0x66, 0x62, 0x62, },
+        { 0x8A, 0x8A, 0x86, 0x86, 0x76, 0x76, 0x72, 0x72, },
+        { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x82, 0x82, }, };
+
+/*****************************************************************************/
+/* Lookup table for total zeros of 4:2:2 ChromaDC blocks as per Table 9-9(b) */
+/* indexed by total coeff - 1 and the next 5 bits. In each table entry,      */
+/* lower 4 bits represent total zeros decoded while upper 4 bits represent   */
+/* the bits to be flushed from ps_bitstrm                                    */
+/*****************************************************************************/
+const UWORD8 gau1_ih264d_table_total_zero_422_dc[7][32] =
+    {
+    /* For total coeff = 1 */
+        { 0x57, 0x56, 0x45, 0x45, 0x43, 0x43, 0x44, 0x44, 0x31, 0x31, 0x31,
+          0x31, 0x32, 0x32, 0x32, 0x32, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+          0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, },
+
+      /* For total coeff = 2 */
+          { 0x30, 0x30, 0x30, 0x30, 0x32, 0x32, 0x32, 0x32, 0x21, 0x21, 0x21,
+            0x21, 0x21, 0x21, 0x21, 0x21, 0x33, 0x33, 0x33, 0x33, 0x34, 0x34,
+            0x34, 0x34, 0x35, 0x35, 0x35, 0x35, 0x36, 0x36, 0x36, 0x36, },
+
+      /* For total coeff = 3 */
+          { 0x30, 0x30, 0x30, 0x30, 0x31, 0x31, 0x31, 0x31, 0x22, 0x22, 0x22,
+            0x22, 0x22, 0x22, 0x22, 0x22, 0x23, 0x23, 0x23, 0x23, 0x23, 0x23,
+            0x23, 0x23, 0x34, 0x34, 0x34, 0x34, 0x35, 0x35, 0x35, 0x35, },
+
+      /* For total coeff = 4 */
+          { 0x21, 0x21, 0x21, 0x21, 0x21, 0x21, 0x21, 0x21, 0x22, 0x22, 0x22,
+            0x22, 0x22, 0x22, 0x22, 0x22, 0x23, 0x23, 0x23, 0x23, 0x23, 0x23,
+            0x23, 0x23, 0x30, 0x30, 0x30, 0x30, 0x34, 0x34, 0x34, 0x34, },
+
+      /* For total coeff = 5 */
+          { 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x21, 0x21, 0x21,
+            0x21, 0x21, 0x21, 0x21, 0x21, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22,
+            0x22, 0x22, 0x23, 0x23, 0x23, 0x23, 0x23, 0x23, 0x23, 0x23, },
+
+      /* For total coeff = 6 */
+          { 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x21, 0x21, 0x21,
+            0x21, 0x21, 0x21, 0x21, 0x21, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+            0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, },
+
+      /* For total coeff = 7 */
+          { 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+            0x10, 0x10, 0x10, 0x10, 0x10, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+            0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, }, };
+
+/*****************************************************************************/
+/* Inverse scan of 4:2:2 ChromaDC coefficients to the raster order of the    */
+/* 2x4 array of chroma 4x4 blocks                                            */
+/*****************************************************************************/
+const UWORD8 gau1_ih264d_inv_scan_chroma_dc_422[8] =
+    { 0, 2, 1, 4, 6, 3, 5, 7 };
+
 const UWORD16 gau2_ih264d_offset_num_vlc_tab[9] =
     { 0, 0, 120, 120, 224, 224, 224, 224, 224 };
 
@@ -127,6 +127,9 @@ extern const UWORD8 gau1_ih264d_table_total_zero_11to15[5][16];
 extern const UWORD8 gau1_ih264d_table_run_before[64];
 extern const UWORD16 gau2_ih264d_code_gx[304];
 extern const UWORD8 gau1_ih264d_cav_chromdc_vld[256];
+extern const UWORD8 gau1_ih264d_cav_chromdc422_vld[11][8];
+extern const UWORD8 gau1_ih264d_table_total_zero_422_dc[7][32];
+extern const UWORD8 gau1_ih264d_inv_scan_chroma_dc_422[8];
 extern const UWORD16 gau2_ih264d_offset_num_vlc_tab[9];
 extern const UWORD8 gau1_ih264d_total_coeff_fn_ptr_offset[16];
 extern const WORD16 gai2_ih264d_trailing_one_level[14][3];
@@ -211,7 +211,7 @@ void ih264d_compute_bs_non_mbaff_thread(dec_struct_t * ps_dec,
     u2_top_csbp = ps_cur_mb_info->ps_top_mb->u2_luma_csbp;
 
     /* Compute BS function */
-    if(ps_dec->ps_cur_sps->u1_profile_idc == HIGH_PROFILE_IDC)
+    if(ps_dec->ps_cur_sps->u1_profile_idc >= HIGH_PROFILE_IDC)
     {
         if(ps_cur_mb_info->u1_tran_form8x8 == 1)
         {
@@ -383,9 +383,9 @@ void ih264d_recon_deblk_slice(dec_struct_t *ps_dec, tfr_ctxt_t *ps_tfr_cxt)
     UWORD32 u1_mb_aff;
     UWORD16 u2_slice_num;
     UWORD32 u4_mb_num;
-    UWORD16 u2_first_mb_in_slice;
+    UWORD32 u4_first_mb_in_slice;
     UWORD32 i2_pic_wdin_mbs;
-    UWORD8 u1_num_mbsleft, u1_end_of_row;
+    UWORD32 u1_num_mbsleft, u1_end_of_row;
     UWORD8 u1_mbaff;
     UWORD16 i16_mb_x, i16_mb_y;
     WORD32 j;
@@ -439,26 +439,26 @@ void ih264d_recon_deblk_slice(dec_struct_t *ps_dec, tfr_ctxt_t *ps_tfr_cxt)
                     ithread_yield();
                 }
             }
-            DEBUG_THREADS_PRINTF("waiting for mb mapcur_dec_mb_num = %d,ps_dec->u2_cur_mb_addr  = %d\n",u2_cur_dec_mb_num,
-                            ps_dec->u2_cur_mb_addr);
+            DEBUG_THREADS_PRINTF("waiting for mb mapcur_dec_mb_num = %d,ps_dec->u4_cur_mb_addr  = %d\n",u2_cur_dec_mb_num,
+                            ps_dec->u4_cur_mb_addr);
 
         }
     }
 
-    u4_max_addr = ps_dec->ps_cur_sps->u2_max_mb_addr;
+    u4_max_addr = ps_dec->ps_cur_sps->u4_max_mb_addr;
     u1_mb_aff = ps_dec->ps_cur_slice->u1_mbaff_frame_flag;
-    u2_first_mb_in_slice = ps_dec->ps_computebs_cur_slice->u4_first_mb_in_slice;
+    u4_first_mb_in_slice = ps_dec->ps_computebs_cur_slice->u4_first_mb_in_slice;
     i2_pic_wdin_mbs = ps_dec->u2_frm_wd_in_mbs;
     u1_mbaff = ps_dec->ps_cur_slice->u1_mbaff_frame_flag;
     ps_pad_mgr = &ps_dec->s_pad_mgr;
 
-    if(u2_first_mb_in_slice == 0)
+    if(u4_first_mb_in_slice == 0)
     ih264d_init_deblk_tfr_ctxt(ps_dec, ps_pad_mgr, ps_tfr_cxt,
                                ps_dec->u2_frm_wd_in_mbs, 0);
 
 
-    i16_mb_x = MOD(u2_first_mb_in_slice, i2_pic_wdin_mbs);
-    i16_mb_y = DIV(u2_first_mb_in_slice, i2_pic_wdin_mbs);
+    i16_mb_x = MOD(u4_first_mb_in_slice, i2_pic_wdin_mbs);
+    i16_mb_y = DIV(u4_first_mb_in_slice, i2_pic_wdin_mbs);
     i16_mb_y <<= u1_mbaff;
     ps_dec->i2_recon_thread_mb_y = i16_mb_y;
     u4_frame_stride = ps_dec->u2_frm_wd_y
@@ -473,7 +473,8 @@ void ih264d_recon_deblk_slice(dec_struct_t *ps_dec, tfr_ctxt_t *ps_tfr_cxt)
     u4_frame_stride = ps_dec->u2_frm_wd_uv
                     << ps_dec->ps_cur_slice->u1_field_pic_flag;
     x_offset >>= 1;
-    y_offset = (i16_mb_y * u4_frame_stride) << 3;
+    y_offset = (i16_mb_y * u4_frame_stride)
+                    << (4 - ps_dec->u1_chroma_ht_shift);
 
     x_offset *= YUV420SP_FACTOR;
 
@@ -484,7 +485,7 @@ void ih264d_recon_deblk_slice(dec_struct_t *ps_dec, tfr_ctxt_t *ps_tfr_cxt)
     ps_trns_addr->pu1_mb_u = ps_trns_addr->pu1_dest_u;
     ps_trns_addr->pu1_mb_v = ps_trns_addr->pu1_dest_v;
 
-    ps_dec->cur_recon_mb_num = u2_first_mb_in_slice << u1_mbaff;
+    ps_dec->cur_recon_mb_num = u4_first_mb_in_slice << u1_mbaff;
 
     u4_slice_end = 0;
     ps_dec->u4_bs_cur_slice_num_mbs = 0;
@@ -629,7 +630,8 @@ void ih264d_recon_deblk_slice(dec_struct_t *ps_dec, tfr_ctxt_t *ps_tfr_cxt)
 
                 u4_frame_stride = ps_dec->u2_frm_wd_uv
                                 << ps_dec->ps_cur_slice->u1_field_pic_flag;
-                y_offset = (u2_mb_y * u4_frame_stride) << 3;
+                y_offset = (u2_mb_y * u4_frame_stride)
+                                << (4 - ps_dec->u1_chroma_ht_shift);
                 ps_trns_addr->pu1_dest_u = ps_dec->s_cur_pic.pu1_buf2 + y_offset;
                 ps_trns_addr->pu1_dest_v = ps_dec->s_cur_pic.pu1_buf3 + y_offset;
 
@@ -685,16 +687,11 @@ void ih264d_recon_deblk_slice(dec_struct_t *ps_dec, tfr_ctxt_t *ps_tfr_cxt)
     }
 }
 
-void ih264d_recon_deblk_thread(dec_struct_t *ps_dec)
+static void ih264d_recon_deblk_picture(dec_struct_t *ps_dec)
 {
     tfr_ctxt_t s_tfr_ctxt;
     tfr_ctxt_t *ps_tfr_cxt = &s_tfr_ctxt; // = &ps_dec->s_tran_addrecon;
 
-
-    UWORD32 yield_cnt = 0;
-
-    ithread_set_name("ih264d_recon_deblk_thread");
-
     while(1)
     {
 
@@ -703,7 +700,7 @@ void ih264d_recon_deblk_thread(dec_struct_t *ps_dec)
 
         DEBUG_THREADS_PRINTF(" Exit  compute bs slice \n");
 
-        if(ps_dec->cur_recon_mb_num > ps_dec->ps_cur_sps->u2_max_mb_addr)
+        if(ps_dec->cur_recon_mb_num > ps_dec->ps_cur_sps->u4_max_mb_addr)
         {
                 break;
         }
@@ -729,9 +726,29 @@ void ih264d_recon_deblk_thread(dec_struct_t *ps_dec)
         ps_dec->u4_fmt_conv_cur_row += ps_dec->u4_fmt_conv_num_rows;
 
     }
+}
+
+void ih264d_recon_deblk_thread(dec_struct_t *ps_dec)
+{
+    ithread_set_name("ih264d_recon_deblk_thread");
 
+    while(1)
+    {
+        /* Persistent during a batch decode, see ih264d_decode_picture_thread */
+        if(ps_dec->u4_keep_threads_active)
+        {
+            ithread_sem_wait(ps_dec->pv_bs_deblk_thread_start_sem);
+            if(ps_dec->u4_break_threads)
+                break;
+        }
+
+        ih264d_recon_deblk_picture(ps_dec);
 
+        if(0 == ps_dec->u4_keep_threads_active)
+            break;
 
+        ithread_sem_post(ps_dec->pv_bs_deblk_thread_done_sem);
+    }
 }
 
 
@@ -44,6 +44,7 @@
 #include "ih264d_defs.h"
 #include "ih264d_mb_utils.h"
 #include "ih264d_thread_parse_decode.h"
+#include "ih264d_thread_compute_bs.h"
 #include "ih264d_inter_pred.h"
 
 #include "ih264d_process_pslice.h"
@@ -62,7 +63,7 @@ void ih264d_copy_intra_pred_line(dec_struct_t *ps_dec,
 void ih264d_parse_tfr_nmb(dec_struct_t * ps_dec,
                           UWORD8 u1_mb_idx,
                           UWORD8 u1_num_mbs,
-                          UWORD8 u1_num_mbs_next,
+                          UWORD32 u1_num_mbs_next,
                           UWORD8 u1_tfr_n_mb,
                           UWORD8 u1_end_of_row)
 {
@@ -77,12 +78,12 @@ void ih264d_parse_tfr_nmb(dec_struct_t * ps_dec,
     {
 
 
-        u4_n_mb_start = (ps_dec->u2_cur_mb_addr + 1) - u1_num_mbs;
+        u4_n_mb_start = (ps_dec->u4_cur_mb_addr + 1) - u1_num_mbs;
 
         // copy into s_frmMbInfo
 
         u4_mb_num = u4_n_mb_start;
-        u4_mb_num = (ps_dec->u2_cur_mb_addr + 1) - u1_num_mbs;
+        u4_mb_num = (ps_dec->u4_cur_mb_addr + 1) - u1_num_mbs;
 
         for(i = 0; i < u1_num_mbs; i++)
         {
@@ -133,7 +134,8 @@ void ih264d_parse_tfr_nmb(dec_struct_t * ps_dec,
 
             u4_frame_stride = ps_dec->u2_frm_wd_uv
                             << ps_dec->ps_cur_slice->u1_field_pic_flag;
-            y_offset = (u2_mb_y * u4_frame_stride) << 3;
+            y_offset = (u2_mb_y * u4_frame_stride)
+                            << (4 - ps_dec->u1_chroma_ht_shift);
             ps_dec->s_tran_addrecon_parse.pu1_dest_u =
                             ps_dec->s_cur_pic.pu1_buf2 + y_offset;
             ps_dec->s_tran_addrecon_parse.pu1_dest_v =
@@ -166,7 +168,7 @@ void ih264d_parse_tfr_nmb(dec_struct_t * ps_dec,
 
 void ih264d_decode_tfr_nmb(dec_struct_t * ps_dec,
                            UWORD8 u1_num_mbs,
-                           UWORD8 u1_num_mbs_next,
+                           UWORD32 u1_num_mbs_next,
                            UWORD8 u1_end_of_row)
 {
 
@@ -178,7 +180,7 @@ void ih264d_decode_tfr_nmb(dec_struct_t * ps_dec,
     /* Check for End Of Row in Next iteration                       */
     /****************************************************************/
     u1_end_of_row_next = u1_num_mbs_next &&
-                        ((u1_num_mbs_next) <= (ps_dec->u1_recon_mb_grp >> u1_mbaff));
+                        ((u1_num_mbs_next) <= (UWORD32)(ps_dec->u1_recon_mb_grp >> u1_mbaff));
 
     /****************************************************************/
     /* Transfer the Following things                                */
@@ -199,7 +201,7 @@ void ih264d_decode_tfr_nmb(dec_struct_t * ps_dec,
 
 WORD32 ih264d_decode_recon_tfr_nmb_thread(dec_struct_t * ps_dec,
                                           UWORD8 u1_num_mbs,
-                                          UWORD8 u1_num_mbs_next,
+                                          UWORD32 u1_num_mbs_next,
                                           UWORD8 u1_end_of_row)
 {
     WORD32 i,j;
@@ -210,7 +212,8 @@ WORD32 ih264d_decode_recon_tfr_nmb_thread(dec_struct_t * ps_dec,
     WORD32 u1_skip_th;
     UWORD32 u1_ipcm_th;
     UWORD32 u4_cond;
-    UWORD16 u2_slice_num,u2_cur_dec_mb_num;
+    UWORD16 u2_slice_num;
+    UWORD32 u4_cur_dec_mb_num;
     WORD32 ret;
     UWORD32 u4_mb_num;
     WORD32 nop_cnt = 8*128;
@@ -223,13 +226,13 @@ WORD32 ih264d_decode_recon_tfr_nmb_thread(dec_struct_t * ps_dec,
 
     u1_ipcm_th = ((u1_slice_type != I_SLICE) ? (u1_B ? 23 : 5) : 0);
 
-    u2_cur_dec_mb_num = ps_dec->cur_dec_mb_num;
+    u4_cur_dec_mb_num = ps_dec->cur_dec_mb_num;
 
     while(1)
     {
 
         UWORD32 u4_max_mb = (UWORD32)(ps_dec->i2_dec_thread_mb_y + (1 << u1_mbaff)) * ps_dec->u2_frm_wd_in_mbs - 1;
-        u4_mb_num = u2_cur_dec_mb_num;
+        u4_mb_num = u4_cur_dec_mb_num;
         /*introducing 1 MB delay*/
         u4_mb_num = MIN(u4_mb_num + u1_num_mbs + 1, u4_max_mb);
 
@@ -270,9 +273,9 @@ WORD32 ih264d_decode_recon_tfr_nmb_thread(dec_struct_t * ps_dec,
     /* N Mb MC Loop */
     for(i = 0; i < u1_num_mbs; i++)
     {
-        u4_mb_num = u2_cur_dec_mb_num;
+        u4_mb_num = u4_cur_dec_mb_num;
 
-        GET_SLICE_NUM_MAP(ps_dec->pu2_slice_num_map, u2_cur_dec_mb_num,
+        GET_SLICE_NUM_MAP(ps_dec->pu2_slice_num_map, u4_cur_dec_mb_num,
                           u2_slice_num);
 
         if(u2_slice_num != ps_dec->u2_cur_slice_num_dec_thread)
@@ -281,7 +284,7 @@ WORD32 ih264d_decode_recon_tfr_nmb_thread(dec_struct_t * ps_dec,
             break;
         }
 
-        ps_cur_mb_info = &ps_dec->ps_frm_mb_info[u2_cur_dec_mb_num];
+        ps_cur_mb_info = &ps_dec->ps_frm_mb_info[u4_cur_dec_mb_num];
 
         ps_dec->u4_dma_buf_idx = 0;
         ps_dec->u4_pred_info_idx = 0;
@@ -336,7 +339,7 @@ WORD32 ih264d_decode_recon_tfr_nmb_thread(dec_struct_t * ps_dec,
             ps_dec->p_mc_dec_thread(ps_dec, ps_cur_mb_info);
         }
 
-        u2_cur_dec_mb_num++;
+        u4_cur_dec_mb_num++;
     }
 
     /* N Mb IQ IT RECON  Loop */
@@ -420,7 +423,7 @@ WORD32 ih264d_decode_recon_tfr_nmb_thread(dec_struct_t * ps_dec,
     }
 
     /*handle the last mb in picture case*/
-    if(ps_dec->cur_dec_mb_num > ps_dec->ps_cur_sps->u2_max_mb_addr)
+    if(ps_dec->cur_dec_mb_num > ps_dec->ps_cur_sps->u4_max_mb_addr)
         ps_dec->u4_cur_slice_decode_done = 1;
 
     if(i != u1_num_mbs)
@@ -437,11 +440,11 @@ WORD32 ih264d_decode_recon_tfr_nmb_thread(dec_struct_t * ps_dec,
 
 WORD32 ih264d_decode_slice_thread(dec_struct_t *ps_dec)
 {
-    UWORD8 u1_num_mbs_next, u1_num_mbsleft, u1_end_of_row = 0;
+    UWORD32 u1_num_mbs_next, u1_num_mbsleft, u1_end_of_row = 0;
     const UWORD32 i2_pic_wdin_mbs = ps_dec->u2_frm_wd_in_mbs;
     UWORD8 u1_mbaff, u1_num_mbs;
 
-    UWORD16 u2_first_mb_in_slice;
+    UWORD32 u4_first_mb_in_slice;
     UWORD16 i16_mb_x, i16_mb_y;
     UWORD8 u1_field_pic;
     UWORD32 u4_frame_stride, x_offset, y_offset;
@@ -484,8 +487,8 @@ WORD32 ih264d_decode_slice_thread(dec_struct_t *ps_dec)
                 nop_cnt = 8*128;
                 ithread_yield();
             }
-            DEBUG_THREADS_PRINTF("waiting for mb mapcur_dec_mb_num = %d,ps_dec->u2_cur_mb_addr  = %d\n",u2_cur_dec_mb_num,
-                            ps_dec->u2_cur_mb_addr);
+            DEBUG_THREADS_PRINTF("waiting for mb mapcur_dec_mb_num = %d,ps_dec->u4_cur_mb_addr  = %d\n",u4_cur_dec_mb_num,
+                            ps_dec->u4_cur_mb_addr);
 
         }
     }
@@ -494,15 +497,15 @@ WORD32 ih264d_decode_slice_thread(dec_struct_t *ps_dec)
 
     u1_mbaff = ps_dec->ps_cur_slice->u1_mbaff_frame_flag;
 
-    u2_first_mb_in_slice = ps_dec->ps_decode_cur_slice->u4_first_mb_in_slice;
+    u4_first_mb_in_slice = ps_dec->ps_decode_cur_slice->u4_first_mb_in_slice;
 
-    i16_mb_x = MOD(u2_first_mb_in_slice, i2_pic_wdin_mbs);
-    i16_mb_y = DIV(u2_first_mb_in_slice, i2_pic_wdin_mbs);
+    i16_mb_x = MOD(u4_first_mb_in_slice, i2_pic_wdin_mbs);
+    i16_mb_y = DIV(u4_first_mb_in_slice, i2_pic_wdin_mbs);
     i16_mb_y <<= u1_mbaff;
     ps_dec->i2_dec_thread_mb_y = i16_mb_y;
 
 
-    ps_dec->cur_dec_mb_num = u2_first_mb_in_slice << u1_mbaff;
+    ps_dec->cur_dec_mb_num = u4_first_mb_in_slice << u1_mbaff;
 
     if((ps_dec->u4_num_cores == 2) || !ps_dec->i1_recon_in_thread3_flag)
     {
@@ -522,7 +525,8 @@ WORD32 ih264d_decode_slice_thread(dec_struct_t *ps_dec)
 
     u4_frame_stride = ps_dec->u2_frm_wd_uv << u1_field_pic;
     x_offset >>= 1;
-    y_offset = (i16_mb_y * u4_frame_stride) << 3;
+    y_offset = (i16_mb_y * u4_frame_stride)
+                    << (4 - ps_dec->u1_chroma_ht_shift);
 
     x_offset *= YUV420SP_FACTOR;
 
@@ -590,9 +594,8 @@ WORD32 ih264d_decode_slice_thread(dec_struct_t *ps_dec)
     return OK;
 }
 
-void ih264d_decode_picture_thread(dec_struct_t *ps_dec )
+static void ih264d_decode_picture(dec_struct_t *ps_dec)
 {
-    ithread_set_name("ih264d_decode_picture_thread");
     while(1)
     {
         /*Complete all writes before processing next slice*/
@@ -604,7 +607,7 @@ void ih264d_decode_picture_thread(dec_struct_t *ps_dec )
 
 
         if(ps_dec->cur_dec_mb_num
-                        > ps_dec->ps_cur_sps->u2_max_mb_addr)
+                        > ps_dec->ps_cur_sps->u4_max_mb_addr)
         {
             /*Last slice in frame*/
             break;
@@ -629,11 +632,106 @@ void ih264d_decode_picture_thread(dec_struct_t *ps_dec )
     }
 }
 
+void ih264d_decode_picture_thread(dec_struct_t *ps_dec )
+{
+    ithread_set_name("ih264d_decode_picture_thread");
+    while(1)
+    {
+        /* A persistent thread waits for each picture of the batch to be
+         * handed over and reports completion instead of exiting */
+        if(ps_dec->u4_keep_threads_active)
+        {
+            ithread_sem_wait(ps_dec->pv_dec_thread_start_sem);
+            if(ps_dec->u4_break_threads)
+                break;
+        }
+
+        ih264d_decode_picture(ps_dec);
+
+        if(0 == ps_dec->u4_keep_threads_active)
+            break;
+
+        ithread_sem_post(ps_dec->pv_dec_thread_done_sem);
+    }
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_start_decode_thread                               */
+/*                                                                           */
+/*  Description   : Hands the current picture over to the decode thread.     */
+/*                  Outside a batch decode a new thread is created for every */
+/*                  picture. During a batch decode the thread is created     */
+/*                  once and then woken up for each picture                  */
+/*                                                                           */
+/*  Inputs        : ps_dec - Decoder context                                 */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_start_decode_thread(dec_struct_t *ps_dec)
+{
+    if(ps_dec->u4_keep_threads_active)
+    {
+        if(0 == ps_dec->u4_dec_thread_alive)
+        {
+            ithread_create(ps_dec->pv_dec_thread_handle, NULL,
+                           (void *)ih264d_decode_picture_thread,
+                           (void *)ps_dec);
+            ps_dec->u4_dec_thread_alive = 1;
+        }
+        ithread_sem_post(ps_dec->pv_dec_thread_start_sem);
+    }
+    else
+    {
+        ithread_create(ps_dec->pv_dec_thread_handle, NULL,
+                       (void *)ih264d_decode_picture_thread,
+                       (void *)ps_dec);
+    }
+    ps_dec->u4_dec_thread_created = 1;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_start_bs_deblk_thread                             */
+/*                                                                           */
+/*  Description   : Same as ih264d_start_decode_thread for the bs / deblock  */
+/*                  thread                                                   */
+/*                                                                           */
+/*  Inputs        : ps_dec - Decoder context                                 */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_start_bs_deblk_thread(dec_struct_t *ps_dec)
+{
+    ps_dec->u4_start_recon_deblk = 0;
+    if(ps_dec->u4_keep_threads_active)
+    {
+        if(0 == ps_dec->u4_bs_deblk_thread_alive)
+        {
+            ithread_create(ps_dec->pv_bs_deblk_thread_handle, NULL,
+                           (void *)ih264d_recon_deblk_thread,
+                           (void *)ps_dec);
+            ps_dec->u4_bs_deblk_thread_alive = 1;
+        }
+        ithread_sem_post(ps_dec->pv_bs_deblk_thread_start_sem);
+    }
+    else
+    {
+        ithread_create(ps_dec->pv_bs_deblk_thread_handle, NULL,
+                       (void *)ih264d_recon_deblk_thread,
+                       (void *)ps_dec);
+    }
+    ps_dec->u4_bs_deblk_thread_created = 1;
+}
+
 void ih264d_signal_decode_thread(dec_struct_t *ps_dec)
 {
     if(ps_dec->u4_dec_thread_created == 1)
     {
-        ithread_join(ps_dec->pv_dec_thread_handle, NULL);
+        if(ps_dec->u4_dec_thread_alive)
+            ithread_sem_wait(ps_dec->pv_dec_thread_done_sem);
+        else
+            ithread_join(ps_dec->pv_dec_thread_handle, NULL);
         ps_dec->u4_dec_thread_created = 0;
     }
 }
@@ -641,8 +739,43 @@ void ih264d_signal_bs_deblk_thread(dec_struct_t *ps_dec)
 {
     if(ps_dec->u4_bs_deblk_thread_created)
     {
-        ithread_join(ps_dec->pv_bs_deblk_thread_handle, NULL);
+        if(ps_dec->u4_bs_deblk_thread_alive)
+            ithread_sem_wait(ps_dec->pv_bs_deblk_thread_done_sem);
+        else
+            ithread_join(ps_dec->pv_bs_deblk_thread_handle, NULL);
         ps_dec->u4_bs_deblk_thread_created = 0;
     }
 
 }
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_stop_threads                                      */
+/*                                                                           */
+/*  Description   : Waits for the picture in flight and then terminates the  */
+/*                  persistent threads started during a batch decode         */
+/*                                                                           */
+/*  Inputs        : ps_dec - Decoder context                                 */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_stop_threads(dec_struct_t *ps_dec)
+{
+    ih264d_signal_decode_thread(ps_dec);
+    ih264d_signal_bs_deblk_thread(ps_dec);
+
+    ps_dec->u4_break_threads = 1;
+    if(ps_dec->u4_dec_thread_alive)
+    {
+        ithread_sem_post(ps_dec->pv_dec_thread_start_sem);
+        ithread_join(ps_dec->pv_dec_thread_handle, NULL);
+        ps_dec->u4_dec_thread_alive = 0;
+    }
+    if(ps_dec->u4_bs_deblk_thread_alive)
+    {
+        ithread_sem_post(ps_dec->pv_bs_deblk_thread_start_sem);
+        ithread_join(ps_dec->pv_bs_deblk_thread_handle, NULL);
+        ps_dec->u4_bs_deblk_thread_alive = 0;
+    }
+    ps_dec->u4_break_threads = 0;
+}
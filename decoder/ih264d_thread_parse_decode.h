@@ -29,18 +29,21 @@
 void ih264d_parse_tfr_nmb(dec_struct_t *ps_dec,
                           UWORD8 u1_mb_idx,
                           UWORD8 u1_num_mbs,
-                          UWORD8 u1_num_mbs_next,
+                          UWORD32 u1_num_mbs_next,
                           UWORD8 u1_tfr_n_mb,
                           UWORD8 u1_end_of_row);
 void ih264d_decode_tfr_nmb(dec_struct_t *ps_dec,
                            UWORD8 u1_num_mbs,
-                           UWORD8 u1_num_mbs_next,
+                           UWORD32 u1_num_mbs_next,
                            UWORD8 u1_end_of_row);
 WORD32 ih264d_decode_recon_tfr_nmb_thread(dec_struct_t * ps_dec,
                                           UWORD8 u1_num_mbs,
-                                          UWORD8 u1_num_mbs_next,
+                                          UWORD32 u1_num_mbs_next,
                                           UWORD8 u1_end_of_row);
 void ih264d_decode_picture_thread(dec_struct_t *ps_dec);
+void ih264d_start_decode_thread(dec_struct_t *ps_dec);
+void ih264d_start_bs_deblk_thread(dec_struct_t *ps_dec);
+void ih264d_stop_threads(dec_struct_t *ps_dec);
 WORD32 ih264d_decode_slice_thread(dec_struct_t *ps_dec);
 
 
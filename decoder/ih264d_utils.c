@@ -638,6 +638,11 @@ WORD32 ih264d_get_dpb_size(dec_seq_params_t *ps_seq)
         case 52:
             i4_size = 70778880;
             break;
+        case 60:
+        case 61:
+        case 62:
+            i4_size = 267386880;
+            break;
         default:
             i4_size = 70778880;
             break;
@@ -689,7 +694,21 @@ WORD32 ih264d_init_dec_mb_grp(dec_struct_t *ps_dec)
 
     //NMB set to width in MBs for non-mbaff cases
     if(0 == ps_seq->u1_mb_aff_flag)
-        ps_dec->u1_recon_mb_grp = ps_dec->u2_frm_wd_in_mbs;
+    {
+        if(ps_dec->u2_frm_wd_in_mbs <= MAX_RECON_MB_GRP)
+        {
+            ps_dec->u1_recon_mb_grp = ps_dec->u2_frm_wd_in_mbs;
+        }
+        else
+        {
+            /* Rows wider than the 8 bit MB counters allow are split */
+            /* into equal, even sized groups                         */
+            UWORD32 u4_num_grps = (ps_dec->u2_frm_wd_in_mbs
+                            + MAX_RECON_MB_GRP - 1) / MAX_RECON_MB_GRP;
+            ps_dec->u1_recon_mb_grp = ALIGN2((ps_dec->u2_frm_wd_in_mbs
+                            + u4_num_grps - 1) / u4_num_grps);
+        }
+    }
 
     ps_dec->u1_recon_mb_grp_pair = ps_dec->u1_recon_mb_grp >> 1;
 
@@ -747,7 +766,7 @@ WORD32 ih264d_init_pic(dec_struct_t *ps_dec,
     /*--------------------------------------------------------------------*/
     /* Get the value of MaxMbAddress and frmheight in Mbs                 */
     /*--------------------------------------------------------------------*/
-    ps_seq->u2_max_mb_addr =
+    ps_seq->u4_max_mb_addr =
                     (ps_seq->u2_frm_wd_in_mbs
                                     * (ps_dec->u2_pic_ht
                                                     >> (4
@@ -775,6 +794,22 @@ WORD32 ih264d_init_pic(dec_struct_t *ps_dec,
                 ps_dec->i4_display_delay = ps_seq->s_vui.u4_num_reorder_frames * 2 + 2;
         }
 
+        if(ps_dec->u4_compact_mem)
+        {
+            /* Bound the DPB fullness by what the stream signals rather   */
+            /* than by the level limit. The picture buffers and the MV    */
+            /* bank are sized below from num_reorder_frames and           */
+            /* num_ref_frames, which max_dec_frame_buffering bounds, as   */
+            /* pictures awaiting display are held apart from references   */
+            if((1 == ps_seq->u1_vui_parameters_present_flag) &&
+               (1 == ps_seq->s_vui.u1_bitstream_restriction_flag))
+            {
+                ps_dec->u1_max_dec_frame_buffering = MIN(
+                                ps_dec->u1_max_dec_frame_buffering,
+                                MAX(1, ps_seq->s_vui.u4_max_dec_frame_buffering));
+            }
+        }
+
         if(IVD_DECODE_FRAME_OUT == ps_dec->e_frm_out_mode)
             ps_dec->i4_display_delay = 0;
 
@@ -790,6 +825,10 @@ WORD32 ih264d_init_pic(dec_struct_t *ps_dec,
             ps_dec->u1_pic_bufs = (WORD32)ps_dec->u4_num_disp_bufs;
         }
 
+        /* Pictures held by the application through display handles */
+        if(ps_dec->u4_disp_handles)
+            ps_dec->u1_pic_bufs += MAX_DISP_HANDLES_HELD;
+
         /* Ensure at least two buffers are allocated */
         ps_dec->u1_pic_bufs = MAX(ps_dec->u1_pic_bufs, 2);
 
@@ -808,6 +847,10 @@ WORD32 ih264d_init_pic(dec_struct_t *ps_dec,
                                        ps_dec->u1_pic_bufs);
             ih264d_release_display_bufs(ps_dec);
             ih264d_reset_ref_bufs(ps_dec->ps_dpb_mgr);
+
+            /* Handles to pictures of the previous sequence are dropped */
+            memset(ps_dec->au4_disp_handle_refs, 0,
+                   (MAX_DISP_BUFS_NEW) * sizeof(UWORD32));
         }
 
         /*********************************************************************/
@@ -962,7 +1005,10 @@ WORD32 ih264d_get_next_display_field(dec_struct_t * ps_dec,
         ps_op_frm->u4_u_wd = ps_op_frm->u4_v_wd = ps_op_frm->u4_y_wd >> 1;
 
         ps_op_frm->u4_y_strd = pic_buf->u2_frm_wd_y;
-        ps_op_frm->u4_u_strd = ps_op_frm->u4_v_strd = pic_buf->u2_frm_wd_uv;
+        /* 4:2:2 pictures are output in the 4:2:0 formats using alternate */
+        /* chroma rows, IV_YUV_422P output copies every row               */
+        ps_op_frm->u4_u_strd = ps_op_frm->u4_v_strd = pic_buf->u2_frm_wd_uv
+                        << (1 - ps_dec->u1_chroma_ht_shift);
 
         /* ! */
         pv_disp_op->u4_ts = pic_buf->u4_ts;
@@ -997,12 +1043,22 @@ WORD32 ih264d_get_next_display_field(dec_struct_t * ps_dec,
 
         pv_disp_op->s_disp_frm_buf.u4_y_wd = temp = MIN(ps_op_frm->u4_y_wd,
                                                         ps_op_frm->u4_y_strd);
+        pv_disp_op->s_disp_frm_buf.u4_y_ht = ps_op_frm->u4_y_ht;
+
+        /* Downscaled output, see ih264d_format_convert() */
+        if(ps_dec->u4_out_scale_shift)
+        {
+            pv_disp_op->s_disp_frm_buf.u4_y_wd = (temp
+                            >> ps_dec->u4_out_scale_shift) & ~1;
+            pv_disp_op->s_disp_frm_buf.u4_y_ht = (ps_op_frm->u4_y_ht
+                            >> ps_dec->u4_out_scale_shift) & ~1;
+        }
+
         pv_disp_op->s_disp_frm_buf.u4_u_wd = pv_disp_op->s_disp_frm_buf.u4_y_wd
                         >> 1;
         pv_disp_op->s_disp_frm_buf.u4_v_wd = pv_disp_op->s_disp_frm_buf.u4_y_wd
                         >> 1;
 
-        pv_disp_op->s_disp_frm_buf.u4_y_ht = ps_op_frm->u4_y_ht;
         pv_disp_op->s_disp_frm_buf.u4_u_ht = pv_disp_op->s_disp_frm_buf.u4_y_ht
                         >> 1;
         pv_disp_op->s_disp_frm_buf.u4_v_ht = pv_disp_op->s_disp_frm_buf.u4_y_ht
@@ -1022,7 +1078,13 @@ WORD32 ih264d_get_next_display_field(dec_struct_t * ps_dec,
             pv_disp_op->s_disp_frm_buf.u4_y_strd = ps_op_frm->u4_y_strd;
         }
 
-        if(ps_dec->u4_app_disp_width)
+        /* Display handles point into the padded picture itself */
+        if(ps_dec->u4_disp_handles)
+        {
+            pv_disp_op->s_disp_frm_buf.u4_y_strd = ps_op_frm->u4_y_strd;
+        }
+
+        if(ps_dec->u4_app_disp_width && (0 == ps_dec->u4_disp_handles))
         {
             pv_disp_op->s_disp_frm_buf.u4_y_strd = MAX(
                             ps_dec->u4_app_disp_width,
@@ -1038,8 +1100,10 @@ WORD32 ih264d_get_next_display_field(dec_struct_t * ps_dec,
             pv_disp_op->s_disp_frm_buf.u4_v_strd =
                             pv_disp_op->s_disp_frm_buf.u4_y_strd >> 1;
 
-            pv_disp_op->s_disp_frm_buf.u4_u_wd = ps_op_frm->u4_y_wd >> 1;
-            pv_disp_op->s_disp_frm_buf.u4_v_wd = ps_op_frm->u4_y_wd >> 1;
+            pv_disp_op->s_disp_frm_buf.u4_u_wd =
+                            pv_disp_op->s_disp_frm_buf.u4_y_wd >> 1;
+            pv_disp_op->s_disp_frm_buf.u4_v_wd =
+                            pv_disp_op->s_disp_frm_buf.u4_y_wd >> 1;
 
             if(1 == ps_dec->u4_share_disp_buf)
             {
@@ -1066,6 +1130,23 @@ WORD32 ih264d_get_next_display_field(dec_struct_t * ps_dec,
             }
 
         }
+        else if(pv_disp_op->e_output_format == IV_YUV_422P)
+        {
+            pv_disp_op->s_disp_frm_buf.u4_u_strd =
+                            pv_disp_op->s_disp_frm_buf.u4_y_strd >> 1;
+            pv_disp_op->s_disp_frm_buf.u4_v_strd =
+                            pv_disp_op->s_disp_frm_buf.u4_y_strd >> 1;
+
+            pv_disp_op->s_disp_frm_buf.u4_u_wd =
+                            pv_disp_op->s_disp_frm_buf.u4_y_wd >> 1;
+            pv_disp_op->s_disp_frm_buf.u4_v_wd =
+                            pv_disp_op->s_disp_frm_buf.u4_y_wd >> 1;
+
+            pv_disp_op->s_disp_frm_buf.u4_u_ht =
+                            pv_disp_op->s_disp_frm_buf.u4_y_ht;
+            pv_disp_op->s_disp_frm_buf.u4_v_ht =
+                            pv_disp_op->s_disp_frm_buf.u4_y_ht;
+        }
         else if((pv_disp_op->e_output_format == IV_YUV_420SP_UV)
                         || (pv_disp_op->e_output_format == IV_YUV_420SP_VU))
         {
@@ -1073,7 +1154,14 @@ WORD32 ih264d_get_next_display_field(dec_struct_t * ps_dec,
                             pv_disp_op->s_disp_frm_buf.u4_y_strd;
             pv_disp_op->s_disp_frm_buf.u4_v_strd = 0;
 
-            if(1 == ps_dec->u4_share_disp_buf)
+            if(ps_dec->u4_disp_handles)
+            {
+                pv_disp_op->s_disp_frm_buf.pv_y_buf = ps_op_frm->pv_y_buf;
+                pv_disp_op->s_disp_frm_buf.pv_u_buf = ps_op_frm->pv_u_buf;
+                pv_disp_op->s_disp_frm_buf.pv_v_buf = NULL;
+                pv_disp_op->s_disp_frm_buf.u4_u_strd = ps_op_frm->u4_u_strd;
+            }
+            else if(1 == ps_dec->u4_share_disp_buf)
             {
                 UWORD32 i;
 
@@ -1106,6 +1194,7 @@ WORD32 ih264d_get_next_display_field(dec_struct_t * ps_dec,
 
         }
         else if((pv_disp_op->e_output_format == IV_RGB_565)
+                        || (pv_disp_op->e_output_format == IV_RGBA_8888)
                         || (pv_disp_op->e_output_format == IV_YUV_422ILE))
         {
 
@@ -1180,7 +1269,13 @@ void ih264d_release_display_field(dec_struct_t *ps_dec,
     {
         H264_MUTEX_LOCK(&ps_dec->process_disp_mutex);
 
-        if(0 == ps_dec->u4_share_disp_buf)
+        if(ps_dec->u4_disp_handles)
+        {
+            /* The application is the first holder, BUF_MGR_IO is */
+            /* released in ih264d_rel_display_frame()              */
+            ps_dec->au4_disp_handle_refs[pv_disp_op->u4_disp_buf_id] = 1;
+        }
+        else if(0 == ps_dec->u4_share_disp_buf)
         {
             ih264_buf_mgr_release((buf_mgr_t *)ps_dec->pv_pic_buf_mgr,
                                   pv_disp_op->u4_disp_buf_id,
@@ -1816,10 +1911,46 @@ WORD32 ih264d_create_pic_buffers(UWORD8 u1_num_of_buf,
 
 /*!
  **************************************************************************
- * \if Function name : ih264d_allocate_dynamic_bufs \endif
+ * \if Function name : ih264d_buf_pool_alloc \endif
  *
  * \brief
- *    This function allocates memory required by Decoder.
+ *    Returns the next 128 byte aligned chunk of the buffer pool. Falls back
+ *    to a separate allocation when there is no pool or it is exhausted,
+ *    the shortfall is accounted in u4_buf_pool_reqd.
+ *
+ * \param ps_dec: Pointer to dec_struct_t.
+ * \param size: Bytes required.
+ *
+ * \return
+ *    Pointer to the buffer, NULL on allocation failure.
+ *
+ **************************************************************************
+ */
+static void *ih264d_buf_pool_alloc(dec_struct_t *ps_dec, WORD32 size)
+{
+    UWORD32 u4_size = ALIGN128(size);
+    void *pv_buf;
+
+    ps_dec->u4_buf_pool_reqd += u4_size;
+    if((NULL != ps_dec->pu1_buf_pool)
+                    && (ps_dec->u4_buf_pool_used + u4_size
+                                    <= ps_dec->u4_buf_pool_size))
+    {
+        pv_buf = ps_dec->pu1_buf_pool + ps_dec->u4_buf_pool_used;
+        ps_dec->u4_buf_pool_used += u4_size;
+        return pv_buf;
+    }
+
+    return ps_dec->pf_aligned_alloc(ps_dec->pv_mem_ctxt, 128, size);
+}
+
+/*!
+ **************************************************************************
+ * \if Function name : ih264d_carve_dynamic_bufs \endif
+ *
+ * \brief
+ *    This function allocates memory required by Decoder, from the buffer
+ *    pool when one is configured.
  *
  * \param ps_dec: Pointer to dec_struct_t.
  *
@@ -1828,7 +1959,7 @@ WORD32 ih264d_create_pic_buffers(UWORD8 u1_num_of_buf,
  *
  **************************************************************************
  */
-WORD16 ih264d_allocate_dynamic_bufs(dec_struct_t * ps_dec)
+static WORD16 ih264d_carve_dynamic_bufs(dec_struct_t * ps_dec)
 {
     struct MemReq s_MemReq;
     struct MemBlock *p_MemBlock;
@@ -1846,9 +1977,10 @@ WORD16 ih264d_allocate_dynamic_bufs(dec_struct_t * ps_dec)
     UWORD16 u4_chroma_wd = ps_dec->u2_frm_wd_uv;
     WORD8 c_i = 0;
     dec_seq_params_t *ps_sps = ps_dec->ps_cur_sps;
-    UWORD32 u4_total_mbs = ps_sps->u2_total_num_of_mbs << uc_frmOrFld;
+    UWORD32 u4_total_mbs = ps_sps->u4_total_num_of_mbs << uc_frmOrFld;
     UWORD32 u4_wd_mbs = ps_dec->u2_frm_wd_in_mbs;
     UWORD32 u4_ht_mbs = ps_dec->u2_frm_ht_in_mbs;
+    UWORD32 u4_nmb_mbs;
     UWORD32 u4_blk_wd;
     UWORD32 ui_size = 0;
     UWORD32 u4_int_scratch_size = 0, u4_ref_pred_size = 0;
@@ -1858,23 +1990,39 @@ WORD16 ih264d_allocate_dynamic_bufs(dec_struct_t * ps_dec)
     void *pv_buf;
     UWORD32 u4_num_bufs;
     UWORD32 u4_luma_size, u4_chroma_size;
-    void *pv_mem_ctxt = ps_dec->pv_mem_ctxt;
+
+    /* MBs whose MB info, packed pred info and coeff data are held between */
+    /* parse and decode. With a single decode thread these are consumed at */
+    /* every N-MB transfer, which never spans more than one MB pair row     */
+    u4_nmb_mbs = u4_total_mbs;
+    if(ps_dec->u4_compact_mem)
+        u4_nmb_mbs = MIN(u4_total_mbs, (u4_wd_mbs << 1));
 
     size = u4_total_mbs;
-    pv_buf = ps_dec->pf_aligned_alloc(pv_mem_ctxt, 128, size);
+    pv_buf = ih264d_buf_pool_alloc(ps_dec, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_dynamic_mem_size += size;
     ps_dec->pu1_dec_mb_map = pv_buf;
 
     size = u4_total_mbs;
-    pv_buf = ps_dec->pf_aligned_alloc(pv_mem_ctxt, 128, size);
+    pv_buf = ih264d_buf_pool_alloc(ps_dec, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_dynamic_mem_size += size;
     ps_dec->pu1_recon_mb_map = pv_buf;
 
     size = u4_total_mbs * sizeof(UWORD16);
-    pv_buf = ps_dec->pf_aligned_alloc(pv_mem_ctxt, 128, size);
+    pv_buf = ih264d_buf_pool_alloc(ps_dec, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_dynamic_mem_size += size;
     ps_dec->pu2_slice_num_map = pv_buf;
 
+    /* Decimated rows for downscaled output, at most half the width */
+    size = (u4_luma_wd >> 1) * OUT_SCALE_NUM_ROWS * 3 / 2;
+    pv_buf = ih264d_buf_pool_alloc(ps_dec, size);
+    RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_dynamic_mem_size += size;
+    ps_dec->pu1_out_scale_buf = pv_buf;
+
     /************************************************************/
     /* Post allocation Initialisations                          */
     /************************************************************/
@@ -1885,37 +2033,43 @@ WORD16 ih264d_allocate_dynamic_bufs(dec_struct_t * ps_dec)
     ps_dec->ps_pred_start = ps_dec->ps_pred;
 
     size = sizeof(parse_pmbarams_t) * (ps_dec->u1_recon_mb_grp);
-    pv_buf = ps_dec->pf_aligned_alloc(pv_mem_ctxt, 128, size);
+    pv_buf = ih264d_buf_pool_alloc(ps_dec, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_dynamic_mem_size += size;
     ps_dec->ps_parse_mb_data = pv_buf;
 
     size = sizeof(parse_part_params_t)
                         * ((ps_dec->u1_recon_mb_grp) << 4);
-    pv_buf = ps_dec->pf_aligned_alloc(pv_mem_ctxt, 128, size);
+    pv_buf = ih264d_buf_pool_alloc(ps_dec, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_dynamic_mem_size += size;
     ps_dec->ps_parse_part_params = pv_buf;
 
     size = ((u4_wd_mbs * sizeof(deblkmb_neighbour_t)) << uc_frmOrFld);
-    pv_buf = ps_dec->pf_aligned_alloc(pv_mem_ctxt, 128, size);
+    pv_buf = ih264d_buf_pool_alloc(ps_dec, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_dynamic_mem_size += size;
     ps_dec->ps_deblk_top_mb = pv_buf;
 
     size = ((sizeof(ctxt_inc_mb_info_t))
                         * (((u4_wd_mbs + 1) << uc_frmOrFld) + 1));
-    pv_buf = ps_dec->pf_aligned_alloc(pv_mem_ctxt, 128, size);
+    pv_buf = ih264d_buf_pool_alloc(ps_dec, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_dynamic_mem_size += size;
     ps_dec->p_ctxt_inc_mb_map = pv_buf;
 
     size = (sizeof(mv_pred_t) * ps_dec->u1_recon_mb_grp
                         * 16);
-    pv_buf = ps_dec->pf_aligned_alloc(pv_mem_ctxt, 128, size);
+    pv_buf = ih264d_buf_pool_alloc(ps_dec, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_dynamic_mem_size += size;
     ps_dec->ps_mv_p[0] = pv_buf;
 
     size = (sizeof(mv_pred_t) * ps_dec->u1_recon_mb_grp
                         * 16);
-    pv_buf = ps_dec->pf_aligned_alloc(pv_mem_ctxt, 128, size);
+    pv_buf = ih264d_buf_pool_alloc(ps_dec, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_dynamic_mem_size += size;
     ps_dec->ps_mv_p[1] = pv_buf;
 
     {
@@ -1924,29 +2078,33 @@ WORD16 ih264d_allocate_dynamic_bufs(dec_struct_t * ps_dec)
         {
             size = (sizeof(mv_pred_t)
                             * ps_dec->u1_recon_mb_grp * 4);
-            pv_buf = ps_dec->pf_aligned_alloc(pv_mem_ctxt, 128, size);
+            pv_buf = ih264d_buf_pool_alloc(ps_dec, size);
             RETURN_IF((NULL == pv_buf), IV_FAIL);
+            ps_dec->u4_dynamic_mem_size += size;
             ps_dec->ps_mv_top_p[i] = pv_buf;
         }
     }
 
     size = sizeof(UWORD8) * ((u4_wd_mbs + 2) * MB_SIZE) * 2;
-    pv_buf = ps_dec->pf_aligned_alloc(pv_mem_ctxt, 128, size);
+    pv_buf = ih264d_buf_pool_alloc(ps_dec, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_dynamic_mem_size += size;
     ps_dec->pu1_y_intra_pred_line = pv_buf;
     memset(ps_dec->pu1_y_intra_pred_line, 0, size);
     ps_dec->pu1_y_intra_pred_line += MB_SIZE;
 
     size = sizeof(UWORD8) * ((u4_wd_mbs + 2) * MB_SIZE) * 2;
-    pv_buf = ps_dec->pf_aligned_alloc(pv_mem_ctxt, 128, size);
+    pv_buf = ih264d_buf_pool_alloc(ps_dec, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_dynamic_mem_size += size;
     ps_dec->pu1_u_intra_pred_line = pv_buf;
     memset(ps_dec->pu1_u_intra_pred_line, 0, size);
     ps_dec->pu1_u_intra_pred_line += MB_SIZE;
 
     size = sizeof(UWORD8) * ((u4_wd_mbs + 2) * MB_SIZE) * 2;
-    pv_buf = ps_dec->pf_aligned_alloc(pv_mem_ctxt, 128, size);
+    pv_buf = ih264d_buf_pool_alloc(ps_dec, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_dynamic_mem_size += size;
     ps_dec->pu1_v_intra_pred_line = pv_buf;
     memset(ps_dec->pu1_v_intra_pred_line, 0, size);
     ps_dec->pu1_v_intra_pred_line += MB_SIZE;
@@ -1961,8 +2119,9 @@ WORD16 ih264d_allocate_dynamic_bufs(dec_struct_t * ps_dec)
         size = sizeof(mb_neigbour_params_t)
                         * 2 * ((u4_wd_mbs + 2) << uc_frmOrFld);
     }
-    pv_buf = ps_dec->pf_aligned_alloc(pv_mem_ctxt, 128, size);
+    pv_buf = ih264d_buf_pool_alloc(ps_dec, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_dynamic_mem_size += size;
 
     ps_dec->ps_nbr_mb_row = pv_buf;
     memset(ps_dec->ps_nbr_mb_row, 0, size);
@@ -1970,16 +2129,18 @@ WORD16 ih264d_allocate_dynamic_bufs(dec_struct_t * ps_dec)
     /* Allocate deblock MB info */
     size = (u4_total_mbs + u4_wd_mbs) * sizeof(deblk_mb_t);
 
-    pv_buf = ps_dec->pf_aligned_alloc(pv_mem_ctxt, 128, size);
+    pv_buf = ih264d_buf_pool_alloc(ps_dec, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_dynamic_mem_size += size;
     ps_dec->ps_deblk_pic = pv_buf;
 
     memset(ps_dec->ps_deblk_pic, 0, size);
 
     /* Allocate frame level mb info */
-    size = sizeof(dec_mb_info_t) * u4_total_mbs;
-    pv_buf = ps_dec->pf_aligned_alloc(pv_mem_ctxt, 128, size);
+    size = sizeof(dec_mb_info_t) * u4_nmb_mbs;
+    pv_buf = ih264d_buf_pool_alloc(ps_dec, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_dynamic_mem_size += size;
     ps_dec->ps_frm_mb_info = pv_buf;
     memset(ps_dec->ps_frm_mb_info, 0, size);
 
@@ -2000,8 +2161,9 @@ WORD16 ih264d_allocate_dynamic_bufs(dec_struct_t * ps_dec)
     size += PAD_MAP_IDX_POC * sizeof(void *);
     size *= u4_total_mbs;
     size += sizeof(dec_slice_struct_t) * u4_total_mbs;
-    pv_buf = ps_dec->pf_aligned_alloc(pv_mem_ctxt, 128, size);
+    pv_buf = ih264d_buf_pool_alloc(ps_dec, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_dynamic_mem_size += size;
 
     ps_dec->ps_dec_slice_buf = pv_buf;
     memset(ps_dec->ps_dec_slice_buf, 0, size);
@@ -2010,28 +2172,32 @@ WORD16 ih264d_allocate_dynamic_bufs(dec_struct_t * ps_dec)
     ps_dec->pv_map_ref_idx_to_poc_buf = (void *)pu1_buf;
 
     /* Allocate memory for packed pred info */
-    num_entries = u4_total_mbs;
+    num_entries = u4_nmb_mbs;
     if(1 == ps_dec->ps_cur_sps->u1_num_ref_frames)
         num_entries *= 16;
     else
         num_entries *= 16 * 2;
 
     size = sizeof(pred_info_pkd_t) * num_entries;
-    pv_buf = ps_dec->pf_aligned_alloc(pv_mem_ctxt, 128, size);
+    pv_buf = ih264d_buf_pool_alloc(ps_dec, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_dynamic_mem_size += size;
     ps_dec->ps_pred_pkd = pv_buf;
 
     /* Allocate memory for coeff data */
     size = MB_LUM_SIZE * sizeof(WORD16);
     /*For I16x16 MBs, 16 4x4 AC coeffs and 1 4x4 DC coeff TU blocks will be sent
     For all MBs along with 8 4x4 AC coeffs 2 2x2 DC coeff TU blocks will be sent
-    So use 17 4x4 TU blocks for luma and 9 4x4 TU blocks for chroma */
-    size += u4_total_mbs * (MAX(17 * sizeof(tu_sblk4x4_coeff_data_t),4 * sizeof(tu_blk8x8_coeff_data_t))
-                                            + 9 * sizeof(tu_sblk4x4_coeff_data_t));
+    So use 17 4x4 TU blocks for luma and 9 4x4 TU blocks for chroma.
+    4:2:2 has 16 4x4 AC coeff and 2 2x4 DC coeff TU blocks, so use 17 */
+    size += u4_nmb_mbs * (MAX(17 * sizeof(tu_sblk4x4_coeff_data_t),4 * sizeof(tu_blk8x8_coeff_data_t))
+                                            + (ps_dec->u1_chroma_ht_shift ? 9 : 17)
+                                                            * sizeof(tu_sblk4x4_coeff_data_t));
     //32 bytes for each mb to store u1_prev_intra4x4_pred_mode and u1_rem_intra4x4_pred_mode data
-    size += u4_total_mbs * 32;
-    pv_buf = ps_dec->pf_aligned_alloc(pv_mem_ctxt, 128, size);
+    size += u4_nmb_mbs * 32;
+    pv_buf = ih264d_buf_pool_alloc(ps_dec, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_dynamic_mem_size += size;
 
     ps_dec->pi2_coeff_data = pv_buf;
 
@@ -2051,8 +2217,9 @@ WORD16 ih264d_allocate_dynamic_bufs(dec_struct_t * ps_dec)
         u4_num_bufs = MAX(u4_num_bufs, 2);
         size = ALIGN64(mvpred_buffer_size) + ALIGN64(col_flag_buffer_size);
         size *= u4_num_bufs;
-        pv_buf = ps_dec->pf_aligned_alloc(pv_mem_ctxt, 128, size);
+        pv_buf = ih264d_buf_pool_alloc(ps_dec, size);
         RETURN_IF((NULL == pv_buf), IV_FAIL);
+        ps_dec->u4_dynamic_mem_size += size;
         ps_dec->pu1_mv_bank_buf_base = pv_buf;
     }
 
@@ -2084,8 +2251,9 @@ WORD16 ih264d_allocate_dynamic_bufs(dec_struct_t * ps_dec)
 
     size = ALIGN64(u4_luma_size) + ALIGN64(u4_chroma_size);
     size *= ps_dec->u1_pic_bufs;
-    pv_buf = ps_dec->pf_aligned_alloc(pv_mem_ctxt, 128, size);
+    pv_buf = ih264d_buf_pool_alloc(ps_dec, size);
     RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->u4_dynamic_mem_size += size;
     ps_dec->pu1_pic_buf_base = pv_buf;
 
     /* 0th entry of CtxtIncMbMap will be always be containing default values
@@ -2172,6 +2340,61 @@ WORD16 ih264d_allocate_dynamic_bufs(dec_struct_t * ps_dec)
     return (i16_status);
 }
 
+/*!
+ **************************************************************************
+ * \if Function name : ih264d_allocate_dynamic_bufs \endif
+ *
+ * \brief
+ *    This function allocates memory required by Decoder. With a buffer
+ *    pool, the buffers of the current sequence are carved from the pool.
+ *    If they do not fit, the pool is regrown once to fit them and
+ *    u4_buf_pool_max_wd x u4_buf_pool_max_ht, so that later sequences up
+ *    to that resolution are carved without any allocation.
+ *
+ * \param ps_dec: Pointer to dec_struct_t.
+ *
+ * \return
+ *    Returns i4_status as returned by MemManager.
+ *
+ **************************************************************************
+ */
+WORD16 ih264d_allocate_dynamic_bufs(dec_struct_t * ps_dec)
+{
+    WORD16 ret;
+    UWORD32 u4_cur_mbs, u4_max_mbs;
+    UWORD64 u8_size;
+    void *pv_buf;
+
+    ps_dec->u4_buf_pool_used = 0;
+    ps_dec->u4_buf_pool_reqd = 0;
+    ret = ih264d_carve_dynamic_bufs(ps_dec);
+    if((0 == ps_dec->u4_buf_pool_max_wd) || (OK != ret)
+                    || (ps_dec->u4_buf_pool_reqd <= ps_dec->u4_buf_pool_size))
+        return ret;
+
+    /* Scale what this sequence needs to the configured maximum resolution */
+    u4_cur_mbs = ps_dec->u2_frm_wd_in_mbs * ps_dec->u2_frm_ht_in_mbs;
+    u4_max_mbs = ((ps_dec->u4_buf_pool_max_wd + 15) >> 4)
+                    * ((ps_dec->u4_buf_pool_max_ht + 15) >> 4);
+    u8_size = (UWORD64)ps_dec->u4_buf_pool_reqd * MAX(u4_cur_mbs, u4_max_mbs)
+                    / u4_cur_mbs;
+    u8_size = MIN(u8_size, 0x7FFFFFFF);
+
+    ih264d_free_dynamic_bufs(ps_dec);
+    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pu1_buf_pool);
+    ps_dec->u4_buf_pool_size = 0;
+
+    pv_buf = ps_dec->pf_aligned_alloc(ps_dec->pv_mem_ctxt, 128,
+                                      (WORD32)u8_size);
+    RETURN_IF((NULL == pv_buf), IV_FAIL);
+    ps_dec->pu1_buf_pool = pv_buf;
+    ps_dec->u4_buf_pool_size = (UWORD32)u8_size;
+
+    ps_dec->u4_buf_pool_used = 0;
+    ps_dec->u4_buf_pool_reqd = 0;
+    return ih264d_carve_dynamic_bufs(ps_dec);
+}
+
 /*!
  **************************************************************************
  * \if Function name : ih264d_free_dynamic_bufs \endif
@@ -2188,33 +2411,41 @@ WORD16 ih264d_allocate_dynamic_bufs(dec_struct_t * ps_dec)
  */
 WORD16 ih264d_free_dynamic_bufs(dec_struct_t * ps_dec)
 {
-    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pu1_bits_buf_dynamic);
-
-    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->ps_deblk_pic);
-    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pu1_dec_mb_map);
-    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pu1_recon_mb_map);
-    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pu2_slice_num_map);
-    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->ps_dec_slice_buf);
-    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->ps_frm_mb_info);
-    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pi2_coeff_data);
-    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->ps_parse_mb_data);
-    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->ps_parse_part_params);
-    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->ps_deblk_top_mb);
+    ps_dec->u4_dynamic_mem_size = 0;
+
+    /* With a buffer pool the bitstream buffer is kept for the next */
+    /* sequence, it is freed in ih264d_delete()                      */
+    if(0 == ps_dec->u4_buf_pool_max_wd)
+    {
+        PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pu1_bits_buf_dynamic);
+    }
+
+    PS_DEC_POOL_FREE(ps_dec, ps_dec->ps_deblk_pic);
+    PS_DEC_POOL_FREE(ps_dec, ps_dec->pu1_dec_mb_map);
+    PS_DEC_POOL_FREE(ps_dec, ps_dec->pu1_recon_mb_map);
+    PS_DEC_POOL_FREE(ps_dec, ps_dec->pu2_slice_num_map);
+    PS_DEC_POOL_FREE(ps_dec, ps_dec->pu1_out_scale_buf);
+    PS_DEC_POOL_FREE(ps_dec, ps_dec->ps_dec_slice_buf);
+    PS_DEC_POOL_FREE(ps_dec, ps_dec->ps_frm_mb_info);
+    PS_DEC_POOL_FREE(ps_dec, ps_dec->pi2_coeff_data);
+    PS_DEC_POOL_FREE(ps_dec, ps_dec->ps_parse_mb_data);
+    PS_DEC_POOL_FREE(ps_dec, ps_dec->ps_parse_part_params);
+    PS_DEC_POOL_FREE(ps_dec, ps_dec->ps_deblk_top_mb);
 
     if(ps_dec->p_ctxt_inc_mb_map)
     {
         ps_dec->p_ctxt_inc_mb_map -= 1;
-        PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->p_ctxt_inc_mb_map);
+        PS_DEC_POOL_FREE(ps_dec, ps_dec->p_ctxt_inc_mb_map);
     }
 
-    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->ps_mv_p[0]);
-    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->ps_mv_p[1]);
-    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->ps_pred_pkd);
+    PS_DEC_POOL_FREE(ps_dec, ps_dec->ps_mv_p[0]);
+    PS_DEC_POOL_FREE(ps_dec, ps_dec->ps_mv_p[1]);
+    PS_DEC_POOL_FREE(ps_dec, ps_dec->ps_pred_pkd);
     {
         UWORD8 i;
         for(i = 0; i < MV_SCRATCH_BUFS; i++)
         {
-            PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->ps_mv_top_p[i]);
+            PS_DEC_POOL_FREE(ps_dec, ps_dec->ps_mv_top_p[i]);
         }
     }
 
@@ -2222,22 +2453,22 @@ WORD16 ih264d_free_dynamic_bufs(dec_struct_t * ps_dec)
     {
         ps_dec->pu1_y_intra_pred_line -= MB_SIZE;
     }
-    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pu1_y_intra_pred_line);
+    PS_DEC_POOL_FREE(ps_dec, ps_dec->pu1_y_intra_pred_line);
 
     if(ps_dec->pu1_u_intra_pred_line)
     {
         ps_dec->pu1_u_intra_pred_line -= MB_SIZE;
     }
-    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pu1_u_intra_pred_line);
+    PS_DEC_POOL_FREE(ps_dec, ps_dec->pu1_u_intra_pred_line);
 
     if(ps_dec->pu1_v_intra_pred_line)
     {
         ps_dec->pu1_v_intra_pred_line -= MB_SIZE;
     }
-    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pu1_v_intra_pred_line);
-    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->ps_nbr_mb_row);
-    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pu1_mv_bank_buf_base);
-    PS_DEC_ALIGNED_FREE(ps_dec, ps_dec->pu1_pic_buf_base);
+    PS_DEC_POOL_FREE(ps_dec, ps_dec->pu1_v_intra_pred_line);
+    PS_DEC_POOL_FREE(ps_dec, ps_dec->ps_nbr_mb_row);
+    PS_DEC_POOL_FREE(ps_dec, ps_dec->pu1_mv_bank_buf_base);
+    PS_DEC_POOL_FREE(ps_dec, ps_dec->pu1_pic_buf_base);
     return 0;
 }
 
@@ -2337,3 +2568,68 @@ void ih264d_unpack_coeff4x4_dc_4x4blk(tu_sblk4x4_coeff_data_t *ps_tu_4x4,
 
     }
 }
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : ih264d_iquant_itrans_chroma_dc_422                       */
+/*                                                                           */
+/*  Description   : Inverse transform and scaling of a 4:2:2 chroma DC block */
+/*                  as per section 8.5.11.2 of the standard                  */
+/*  Inputs        : pi2_src    - 8 DC coefficients in raster order of the    */
+/*                               2x4 array of chroma 4x4 blocks              */
+/*                  pi2_out    - DC values in chroma4x4BlkIdx order          */
+/*                  i4_qp      - QP'c of the component                       */
+/*                  i4_weight  - Scaling list weight for the DC position     */
+/*  Globals       : None                                                     */
+/*  Processing    : 4 point vertical and 2 point horizontal Hadamard         */
+/*                  followed by scaling with QP'c,dc = QP'c + 3              */
+/*  Outputs       : pi2_out                                                  */
+/*  Returns       : None                                                     */
+/*                                                                           */
+/*  Issues        : None                                                     */
+/*                                                                           */
+/*****************************************************************************/
+void ih264d_iquant_itrans_chroma_dc_422(WORD16 *pi2_src,
+                                        WORD16 *pi2_out,
+                                        WORD32 i4_qp,
+                                        WORD32 i4_weight)
+{
+    WORD32 ai4_tmp[8];
+    WORD32 i, i4_scale, i4_qp_div6;
+
+    for(i = 0; i < 2; i++)
+    {
+        WORD32 i4_x0 = pi2_src[i] + pi2_src[2 + i];
+        WORD32 i4_x1 = pi2_src[i] - pi2_src[2 + i];
+        WORD32 i4_x2 = pi2_src[4 + i] + pi2_src[6 + i];
+        WORD32 i4_x3 = pi2_src[4 + i] - pi2_src[6 + i];
+
+        ai4_tmp[i] = i4_x0 + i4_x2;
+        ai4_tmp[2 + i] = i4_x0 - i4_x2;
+        ai4_tmp[4 + i] = i4_x1 - i4_x3;
+        ai4_tmp[6 + i] = i4_x1 + i4_x3;
+    }
+
+    i4_qp += 3;
+    i4_qp_div6 = i4_qp / 6;
+    i4_scale = i4_weight * gau2_ih264_iquant_scale_4x4[i4_qp % 6][0];
+
+    for(i = 0; i < 4; i++)
+    {
+        WORD32 i4_f0 = ai4_tmp[2 * i] + ai4_tmp[2 * i + 1];
+        WORD32 i4_f1 = ai4_tmp[2 * i] - ai4_tmp[2 * i + 1];
+
+        if(i4_qp_div6 >= 6)
+        {
+            pi2_out[2 * i] = (i4_f0 * i4_scale) << (i4_qp_div6 - 6);
+            pi2_out[2 * i + 1] = (i4_f1 * i4_scale) << (i4_qp_div6 - 6);
+        }
+        else
+        {
+            WORD32 i4_rnd = 1 << (5 - i4_qp_div6);
+            pi2_out[2 * i] = (i4_f0 * i4_scale + i4_rnd) >> (6 - i4_qp_div6);
+            pi2_out[2 * i + 1] = (i4_f1 * i4_scale + i4_rnd)
+                            >> (6 - i4_qp_div6);
+        }
+    }
+}
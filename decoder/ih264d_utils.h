@@ -42,6 +42,22 @@
 
 #define PS_DEC_ALIGNED_FREE(ps_dec, y) \
 if(y) {ps_dec->pf_aligned_free(ps_dec->pv_mem_ctxt, ((void *)y)); (y) = NULL;}
+
+/* Buffers carved from pu1_buf_pool are only dropped, the pool is kept */
+#define IS_IN_BUF_POOL(ps_dec, y) \
+(((UWORD8 *)(y) >= (ps_dec)->pu1_buf_pool) && \
+ ((UWORD8 *)(y) < (ps_dec)->pu1_buf_pool + (ps_dec)->u4_buf_pool_size))
+
+#define PS_DEC_POOL_FREE(ps_dec, y) \
+do { \
+    if(y) \
+    { \
+        if(!IS_IN_BUF_POOL(ps_dec, y)) \
+            (ps_dec)->pf_aligned_free((ps_dec)->pv_mem_ctxt, ((void *)(y))); \
+        (y) = NULL; \
+    } \
+} while(0)
+
 void pad_frm_buff_vert(dec_struct_t *ps_dec);
 
 UWORD8 ih264d_is_end_of_pic(UWORD16 u2_frame_num,
@@ -80,6 +96,10 @@ void ih264d_assign_pic_num(dec_struct_t *ps_dec);
 void ih264d_unpack_coeff4x4_dc_4x4blk(tu_sblk4x4_coeff_data_t *ps_tu_4x4,
                                       WORD16 *pi2_out_coeff_data,
                                       UWORD8 *pu1_inv_scan);
+void ih264d_iquant_itrans_chroma_dc_422(WORD16 *pi2_src,
+                                        WORD16 *pi2_out,
+                                        WORD32 i4_qp,
+                                        WORD32 i4_weight);
 
 WORD32 ih264d_update_qp(dec_struct_t * ps_dec, const WORD8 i1_qp);
 WORD32 ih264d_decode_gaps_in_frame_num(dec_struct_t *ps_dec,
@@ -0,0 +1,643 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/**
+ *******************************************************************************
+ * @file
+ *  ih264d_format_conv_avx2.c
+ *
+ * @brief
+ *  Contains function definitions for converting the 420SP display buffer to
+ * the output formats requested by the application using 256 bit registers
+ *
+ * @author
+ *  Ittiam
+ *
+ * @par List of Functions:
+ *  - ih264d_fmt_conv_420sp_to_420p_avx2()
+ *  - ih264d_fmt_conv_420sp_to_420sp_swap_uv_avx2()
+ *  - ih264d_yuv_to_rgb_32x2_avx2()
+ *  - ih264d_fmt_conv_420sp_to_rgb565_avx2()
+ *  - ih264d_fmt_conv_420sp_to_rgba8888_avx2()
+ *
+ * @remarks
+ *  Columns left over after the last full vector are handed to the SSSE3
+ *  functions
+ *
+ *******************************************************************************
+ */
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+/* System include files */
+#include <string.h>
+
+/* User include files */
+#include "ih264_typedefs.h"
+#include "iv.h"
+#include "ih264_macros.h"
+#include "ih264_platform_macros.h"
+#include "ih264d_structs.h"
+#include "ih264d_format_conv.h"
+#include <immintrin.h>
+
+/**
+ *******************************************************************************
+ *
+ * @brief Deinterleaves a 420SP buffer to 420P
+ *
+ * @par   Description
+ *  AVX2 variant of ih264d_fmt_conv_420sp_to_420p(). 32 samples each of U
+ *  and V are separated per iteration
+ *
+ * @param[in] pu1_y_src
+ *   Input Y pointer
+ *
+ * @param[in] pu1_uv_src
+ *   Input UV pointer (UV is interleaved either in UV or VU format)
+ *
+ * @param[in] pu1_y_dst
+ *   Output Y pointer
+ *
+ * @param[in] pu1_u_dst
+ *   Output U pointer
+ *
+ * @param[in] pu1_v_dst
+ *   Output V pointer
+ *
+ * @param[in] wd
+ *   Width
+ *
+ * @param[in] ht
+ *   Height
+ *
+ * @param[in] src_y_strd
+ *   Input Y Stride
+ *
+ * @param[in] src_uv_strd
+ *   Input UV stride
+ *
+ * @param[in] dst_y_strd
+ *   Output Y stride
+ *
+ * @param[in] dst_uv_strd
+ *   Output UV stride
+ *
+ * @param[in] is_u_first
+ *   Flag to indicate if U is the first byte in input chroma part
+ *
+ * @param[in] disable_luma_copy
+ *   Flag to skip the luma copy
+ *
+ * @returns none
+ *
+ * @remarks none
+ *
+ *******************************************************************************
+ */
+ATTRIBUTE_AVX2
+void ih264d_fmt_conv_420sp_to_420p_avx2(UWORD8 *pu1_y_src,
+                                        UWORD8 *pu1_uv_src,
+                                        UWORD8 *pu1_y_dst,
+                                        UWORD8 *pu1_u_dst,
+                                        UWORD8 *pu1_v_dst,
+                                        WORD32 wd,
+                                        WORD32 ht,
+                                        WORD32 src_y_strd,
+                                        WORD32 src_uv_strd,
+                                        WORD32 dst_y_strd,
+                                        WORD32 dst_uv_strd,
+                                        WORD32 is_u_first,
+                                        WORD32 disable_luma_copy)
+{
+    UWORD8 *pu1_first_dst, *pu1_second_dst;
+    WORD32 num_cols, num_cols_simd;
+    WORD32 i, j;
+    __m256i deinterleave_mask;
+
+    if(0 == disable_luma_copy)
+    {
+        for(i = 0; i < ht; i++)
+        {
+            memcpy(pu1_y_dst, pu1_y_src, wd);
+            pu1_y_dst += dst_y_strd;
+            pu1_y_src += src_y_strd;
+        }
+    }
+
+    /* Even bytes of the source go to the first plane, odd to the second */
+    if(is_u_first)
+    {
+        pu1_first_dst = pu1_u_dst;
+        pu1_second_dst = pu1_v_dst;
+    }
+    else
+    {
+        pu1_first_dst = pu1_v_dst;
+        pu1_second_dst = pu1_u_dst;
+    }
+
+    deinterleave_mask = _mm256_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14,
+                                         1, 3, 5, 7, 9, 11, 13, 15,
+                                         0, 2, 4, 6, 8, 10, 12, 14,
+                                         1, 3, 5, 7, 9, 11, 13, 15);
+    num_cols = wd >> 1;
+    num_cols_simd = num_cols & ~31;
+
+    for(i = 0; i < (ht >> 1); i++)
+    {
+        UWORD8 *pu1_uv = pu1_uv_src + i * src_uv_strd;
+
+        for(j = 0; j < num_cols_simd; j += 32)
+        {
+            __m256i src_0, src_1;
+
+            src_0 = _mm256_loadu_si256((__m256i *)(pu1_uv + 2 * j));
+            src_1 = _mm256_loadu_si256((__m256i *)(pu1_uv + 2 * j + 32));
+
+            /* Each lane holds 8 first and 8 second samples, gather the */
+            /* first samples in the lower lane and the second in upper  */
+            src_0 = _mm256_shuffle_epi8(src_0, deinterleave_mask);
+            src_1 = _mm256_shuffle_epi8(src_1, deinterleave_mask);
+            src_0 = _mm256_permute4x64_epi64(src_0, 0xD8);
+            src_1 = _mm256_permute4x64_epi64(src_1, 0xD8);
+
+            _mm256_storeu_si256((__m256i *)(pu1_first_dst + j),
+                                _mm256_permute2x128_si256(src_0, src_1, 0x20));
+            _mm256_storeu_si256((__m256i *)(pu1_second_dst + j),
+                                _mm256_permute2x128_si256(src_0, src_1, 0x31));
+        }
+        pu1_first_dst += dst_uv_strd;
+        pu1_second_dst += dst_uv_strd;
+    }
+
+    if(num_cols > num_cols_simd)
+    {
+        ih264d_fmt_conv_420sp_to_420p_ssse3(NULL,
+                                            pu1_uv_src + 2 * num_cols_simd,
+                                            NULL,
+                                            pu1_u_dst + num_cols_simd,
+                                            pu1_v_dst + num_cols_simd,
+                                            wd - 2 * num_cols_simd,
+                                            ht,
+                                            src_y_strd,
+                                            src_uv_strd,
+                                            dst_y_strd,
+                                            dst_uv_strd,
+                                            is_u_first,
+                                            1);
+    }
+    return;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Copies a 420SP buffer swapping the order of U and V
+ *
+ * @par   Description
+ *  AVX2 variant of ih264d_fmt_conv_420sp_to_420sp_swap_uv()
+ *
+ * @param[in] pu1_y_src
+ *   Input Y pointer
+ *
+ * @param[in] pu1_uv_src
+ *   Input UV pointer (UV is interleaved either in UV or VU format)
+ *
+ * @param[in] pu1_y_dst
+ *   Output Y pointer
+ *
+ * @param[in] pu1_uv_dst
+ *   Output UV pointer
+ *
+ * @param[in] wd
+ *   Width
+ *
+ * @param[in] ht
+ *   Height
+ *
+ * @param[in] src_y_strd
+ *   Input Y Stride
+ *
+ * @param[in] src_uv_strd
+ *   Input UV stride
+ *
+ * @param[in] dst_y_strd
+ *   Output Y stride
+ *
+ * @param[in] dst_uv_strd
+ *   Output UV stride
+ *
+ * @returns None
+ *
+ * @remarks None
+ *
+ *******************************************************************************
+ */
+ATTRIBUTE_AVX2
+void ih264d_fmt_conv_420sp_to_420sp_swap_uv_avx2(UWORD8 *pu1_y_src,
+                                                 UWORD8 *pu1_uv_src,
+                                                 UWORD8 *pu1_y_dst,
+                                                 UWORD8 *pu1_uv_dst,
+                                                 WORD32 wd,
+                                                 WORD32 ht,
+                                                 WORD32 src_y_strd,
+                                                 WORD32 src_uv_strd,
+                                                 WORD32 dst_y_strd,
+                                                 WORD32 dst_uv_strd)
+{
+    WORD32 num_cols_simd;
+    WORD32 i, j;
+    __m256i swap_mask;
+
+    for(i = 0; i < ht; i++)
+    {
+        memcpy(pu1_y_dst, pu1_y_src, wd);
+        pu1_y_dst += dst_y_strd;
+        pu1_y_src += src_y_strd;
+    }
+
+    swap_mask = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6,
+                                 9, 8, 11, 10, 13, 12, 15, 14,
+                                 1, 0, 3, 2, 5, 4, 7, 6,
+                                 9, 8, 11, 10, 13, 12, 15, 14);
+    num_cols_simd = wd & ~31;
+
+    for(i = 0; i < (ht >> 1); i++)
+    {
+        for(j = 0; j < num_cols_simd; j += 32)
+        {
+            __m256i src;
+
+            src = _mm256_loadu_si256((__m256i *)(pu1_uv_src + j));
+            src = _mm256_shuffle_epi8(src, swap_mask);
+            _mm256_storeu_si256((__m256i *)(pu1_uv_dst + j), src);
+        }
+        for(; j < wd; j += 2)
+        {
+            pu1_uv_dst[j + 0] = pu1_uv_src[j + 1];
+            pu1_uv_dst[j + 1] = pu1_uv_src[j + 0];
+        }
+
+        pu1_uv_dst += dst_uv_strd;
+        pu1_uv_src += src_uv_strd;
+    }
+    return;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Converts 32x2 pixels of 420SP to unclipped R, G and B
+ *
+ * @par   Description
+ *  Same arithmetic as ih264d_yuv_to_rgb_16x2_ssse3(). The in-lane packs and
+ *  unpacks leave the chroma terms in pixel order when the luma of pixels
+ *  0-15 and 16-31 is widened with vpmovzxbw. [0] holds pixels 0-15 and [1]
+ *  pixels 16-31 of a row
+ *
+ * @param[in] pu1_y_src
+ *   Input Y pointer of the first row
+ *
+ * @param[in] src_y_strd
+ *   Input Y stride
+ *
+ * @param[in] uv
+ *   16 chroma pairs ordered U, V
+ *
+ * @param[in] pi2_csc_coeffs
+ *   YUV to RGB coefficients
+ *
+ * @param[out] pr, pg, pb
+ *   R, G and B of both rows, 4 registers each
+ *
+ * @returns None
+ *
+ * @remarks None
+ *
+ *******************************************************************************
+ */
+ATTRIBUTE_AVX2
+static void ih264d_yuv_to_rgb_32x2_avx2(UWORD8 *pu1_y_src,
+                                        WORD32 src_y_strd,
+                                        __m256i uv,
+                                        const WORD16 *pi2_csc_coeffs,
+                                        __m256i *pr,
+                                        __m256i *pg,
+                                        __m256i *pb)
+{
+    WORD32 v_to_r = (UWORD16)pi2_csc_coeffs[CSC_V_TO_R];
+    WORD32 u_to_g = (UWORD16)pi2_csc_coeffs[CSC_U_TO_G];
+    WORD32 v_to_g = (UWORD16)pi2_csc_coeffs[CSC_V_TO_G];
+    WORD32 u_to_b = (UWORD16)pi2_csc_coeffs[CSC_U_TO_B];
+    __m256i const_128 = _mm256_set1_epi16(128);
+    __m256i y_gain = _mm256_set1_epi16(pi2_csc_coeffs[CSC_Y_GAIN]);
+    __m256i y_ofst = _mm256_set1_epi16(pi2_csc_coeffs[CSC_Y_OFFSET]);
+    __m256i coeff_r = _mm256_set1_epi32(v_to_r << 16);
+    __m256i coeff_g = _mm256_set1_epi32((v_to_g << 16) | u_to_g);
+    __m256i coeff_b = _mm256_set1_epi32(u_to_b);
+    __m256i uv_lo, uv_hi, r, g, b;
+    WORD32 row;
+
+    uv_lo = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(uv));
+    uv_hi = _mm256_cvtepu8_epi16(_mm256_extracti128_si256(uv, 1));
+    uv_lo = _mm256_sub_epi16(uv_lo, const_128);
+    uv_hi = _mm256_sub_epi16(uv_hi, const_128);
+
+    r = _mm256_packs_epi32(_mm256_srai_epi32(_mm256_madd_epi16(uv_lo, coeff_r), 13),
+                           _mm256_srai_epi32(_mm256_madd_epi16(uv_hi, coeff_r), 13));
+    g = _mm256_packs_epi32(_mm256_srai_epi32(_mm256_madd_epi16(uv_lo, coeff_g), 13),
+                           _mm256_srai_epi32(_mm256_madd_epi16(uv_hi, coeff_g), 13));
+    b = _mm256_packs_epi32(_mm256_srai_epi32(_mm256_madd_epi16(uv_lo, coeff_b), 13),
+                           _mm256_srai_epi32(_mm256_madd_epi16(uv_hi, coeff_b), 13));
+
+    for(row = 0; row < 2; row++)
+    {
+        UWORD8 *pu1_y = pu1_y_src + row * src_y_strd;
+        __m256i y_lo, y_hi;
+
+        y_lo = _mm256_cvtepu8_epi16(_mm_loadu_si128((__m128i *)pu1_y));
+        y_hi = _mm256_cvtepu8_epi16(_mm_loadu_si128((__m128i *)(pu1_y + 16)));
+        y_lo = _mm256_sub_epi16(y_lo, y_ofst);
+        y_hi = _mm256_sub_epi16(y_hi, y_ofst);
+        y_lo = _mm256_mulhi_epi16(_mm256_slli_epi16(y_lo, 3), y_gain);
+        y_hi = _mm256_mulhi_epi16(_mm256_slli_epi16(y_hi, 3), y_gain);
+
+        pr[2 * row + 0] = _mm256_add_epi16(y_lo, _mm256_unpacklo_epi16(r, r));
+        pr[2 * row + 1] = _mm256_add_epi16(y_hi, _mm256_unpackhi_epi16(r, r));
+        pg[2 * row + 0] = _mm256_add_epi16(y_lo, _mm256_unpacklo_epi16(g, g));
+        pg[2 * row + 1] = _mm256_add_epi16(y_hi, _mm256_unpackhi_epi16(g, g));
+        pb[2 * row + 0] = _mm256_add_epi16(y_lo, _mm256_unpacklo_epi16(b, b));
+        pb[2 * row + 1] = _mm256_add_epi16(y_hi, _mm256_unpackhi_epi16(b, b));
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Converts a 420SP buffer to RGB565
+ *
+ * @par   Description
+ *  AVX2 variant of ih264d_fmt_conv_420sp_to_rgb565(). Converts 32x2 pixels
+ *  per iteration
+ *
+ * @param[in] pu1_y_src
+ *   Input Y pointer
+ *
+ * @param[in] pu1_uv_src
+ *   Input UV pointer (UV is interleaved either in UV or VU format)
+ *
+ * @param[in] pu2_rgb_dst
+ *   Output RGB pointer
+ *
+ * @param[in] wd
+ *   Width
+ *
+ * @param[in] ht
+ *   Height
+ *
+ * @param[in] src_y_strd
+ *   Input Y Stride
+ *
+ * @param[in] src_uv_strd
+ *   Input UV stride
+ *
+ * @param[in] dst_strd
+ *   Output stride in pixels
+ *
+ * @param[in] is_u_first
+ *   Flag to indicate if U is the first byte in input chroma part
+ *
+ * @param[in] pi2_csc_coeffs
+ *   YUV to RGB coefficients
+ *
+ * @returns None
+ *
+ * @remarks None
+ *
+ *******************************************************************************
+ */
+ATTRIBUTE_AVX2
+void ih264d_fmt_conv_420sp_to_rgb565_avx2(UWORD8 *pu1_y_src,
+                                          UWORD8 *pu1_uv_src,
+                                          UWORD16 *pu2_rgb_dst,
+                                          WORD32 wd,
+                                          WORD32 ht,
+                                          WORD32 src_y_strd,
+                                          WORD32 src_uv_strd,
+                                          WORD32 dst_strd,
+                                          WORD32 is_u_first,
+                                          const WORD16 *pi2_csc_coeffs)
+{
+    WORD32 wd_simd = wd & ~31;
+    WORD32 i, j, k;
+    __m256i uv_mask, zero, const_255, mask_r, mask_g;
+
+    if(is_u_first)
+        uv_mask = _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7,
+                                   8, 9, 10, 11, 12, 13, 14, 15,
+                                   0, 1, 2, 3, 4, 5, 6, 7,
+                                   8, 9, 10, 11, 12, 13, 14, 15);
+    else
+        uv_mask = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6,
+                                   9, 8, 11, 10, 13, 12, 15, 14,
+                                   1, 0, 3, 2, 5, 4, 7, 6,
+                                   9, 8, 11, 10, 13, 12, 15, 14);
+
+    zero = _mm256_setzero_si256();
+    const_255 = _mm256_set1_epi16(255);
+    mask_r = _mm256_set1_epi16(0xF8);
+    mask_g = _mm256_set1_epi16(0xFC);
+
+    for(i = 0; i < (ht >> 1); i++)
+    {
+        UWORD8 *pu1_y = pu1_y_src + 2 * i * src_y_strd;
+        UWORD8 *pu1_uv = pu1_uv_src + i * src_uv_strd;
+        UWORD16 *pu2_dst = pu2_rgb_dst + 2 * i * dst_strd;
+
+        for(j = 0; j < wd_simd; j += 32)
+        {
+            __m256i uv, r[4], g[4], b[4];
+
+            uv = _mm256_loadu_si256((__m256i *)(pu1_uv + j));
+            uv = _mm256_shuffle_epi8(uv, uv_mask);
+
+            ih264d_yuv_to_rgb_32x2_avx2(pu1_y + j, src_y_strd, uv,
+                                        pi2_csc_coeffs, r, g, b);
+
+            for(k = 0; k < 4; k++)
+            {
+                __m256i rgb;
+
+                r[k] = _mm256_max_epi16(_mm256_min_epi16(r[k], const_255), zero);
+                g[k] = _mm256_max_epi16(_mm256_min_epi16(g[k], const_255), zero);
+                b[k] = _mm256_max_epi16(_mm256_min_epi16(b[k], const_255), zero);
+
+                rgb = _mm256_slli_epi16(_mm256_and_si256(r[k], mask_r), 8);
+                rgb = _mm256_or_si256(rgb, _mm256_slli_epi16(_mm256_and_si256(g[k], mask_g), 3));
+                rgb = _mm256_or_si256(rgb, _mm256_srli_epi16(b[k], 3));
+
+                _mm256_storeu_si256((__m256i *)(pu2_dst + (k >> 1) * dst_strd
+                                                + j + (k & 1) * 16), rgb);
+            }
+        }
+    }
+
+    if(wd > wd_simd)
+    {
+        ih264d_fmt_conv_420sp_to_rgb565_ssse3(pu1_y_src + wd_simd,
+                                              pu1_uv_src + wd_simd,
+                                              pu2_rgb_dst + wd_simd,
+                                              wd - wd_simd,
+                                              ht,
+                                              src_y_strd,
+                                              src_uv_strd,
+                                              dst_strd,
+                                              is_u_first,
+                                              pi2_csc_coeffs);
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Converts a 420SP buffer to RGBA8888
+ *
+ * @par   Description
+ *  AVX2 variant of ih264d_fmt_conv_420sp_to_rgba8888(). Converts 32x2
+ *  pixels per iteration
+ *
+ * @param[in] pu1_y_src
+ *   Input Y pointer
+ *
+ * @param[in] pu1_uv_src
+ *   Input UV pointer (UV is interleaved either in UV or VU format)
+ *
+ * @param[in] pu4_rgba_dst
+ *   Output RGBA pointer
+ *
+ * @param[in] wd
+ *   Width
+ *
+ * @param[in] ht
+ *   Height
+ *
+ * @param[in] src_y_strd
+ *   Input Y Stride
+ *
+ * @param[in] src_uv_strd
+ *   Input UV stride
+ *
+ * @param[in] dst_strd
+ *   Output stride in pixels
+ *
+ * @param[in] is_u_first
+ *   Flag to indicate if U is the first byte in input chroma part
+ *
+ * @param[in] pi2_csc_coeffs
+ *   YUV to RGB coefficients
+ *
+ * @returns None
+ *
+ * @remarks None
+ *
+ *******************************************************************************
+ */
+ATTRIBUTE_AVX2
+void ih264d_fmt_conv_420sp_to_rgba8888_avx2(UWORD8 *pu1_y_src,
+                                            UWORD8 *pu1_uv_src,
+                                            UWORD32 *pu4_rgba_dst,
+                                            WORD32 wd,
+                                            WORD32 ht,
+                                            WORD32 src_y_strd,
+                                            WORD32 src_uv_strd,
+                                            WORD32 dst_strd,
+                                            WORD32 is_u_first,
+                                            const WORD16 *pi2_csc_coeffs)
+{
+    WORD32 wd_simd = wd & ~31;
+    WORD32 i, j, k;
+    __m256i uv_mask, zero, const_255;
+
+    if(is_u_first)
+        uv_mask = _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7,
+                                   8, 9, 10, 11, 12, 13, 14, 15,
+                                   0, 1, 2, 3, 4, 5, 6, 7,
+                                   8, 9, 10, 11, 12, 13, 14, 15);
+    else
+        uv_mask = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6,
+                                   9, 8, 11, 10, 13, 12, 15, 14,
+                                   1, 0, 3, 2, 5, 4, 7, 6,
+                                   9, 8, 11, 10, 13, 12, 15, 14);
+
+    zero = _mm256_setzero_si256();
+    const_255 = _mm256_set1_epi16(255);
+
+    for(i = 0; i < (ht >> 1); i++)
+    {
+        UWORD8 *pu1_y = pu1_y_src + 2 * i * src_y_strd;
+        UWORD8 *pu1_uv = pu1_uv_src + i * src_uv_strd;
+        UWORD32 *pu4_dst = pu4_rgba_dst + 2 * i * dst_strd;
+
+        for(j = 0; j < wd_simd; j += 32)
+        {
+            __m256i uv, r[4], g[4], b[4];
+
+            uv = _mm256_loadu_si256((__m256i *)(pu1_uv + j));
+            uv = _mm256_shuffle_epi8(uv, uv_mask);
+
+            ih264d_yuv_to_rgb_32x2_avx2(pu1_y + j, src_y_strd, uv,
+                                        pi2_csc_coeffs, r, g, b);
+
+            for(k = 0; k < 4; k++)
+            {
+                __m256i bg, lo, hi;
+                UWORD32 *pu4_out = pu4_dst + (k >> 1) * dst_strd + j + (k & 1) * 16;
+
+                r[k] = _mm256_max_epi16(_mm256_min_epi16(r[k], const_255), zero);
+                g[k] = _mm256_max_epi16(_mm256_min_epi16(g[k], const_255), zero);
+                b[k] = _mm256_max_epi16(_mm256_min_epi16(b[k], const_255), zero);
+
+                /* Byte order in memory is B, G, R, 0 */
+                bg = _mm256_or_si256(b[k], _mm256_slli_epi16(g[k], 8));
+                lo = _mm256_unpacklo_epi16(bg, r[k]);
+                hi = _mm256_unpackhi_epi16(bg, r[k]);
+
+                _mm256_storeu_si256((__m256i *)(pu4_out + 0),
+                                    _mm256_permute2x128_si256(lo, hi, 0x20));
+                _mm256_storeu_si256((__m256i *)(pu4_out + 8),
+                                    _mm256_permute2x128_si256(lo, hi, 0x31));
+            }
+        }
+    }
+
+    if(wd > wd_simd)
+    {
+        ih264d_fmt_conv_420sp_to_rgba8888_ssse3(pu1_y_src + wd_simd,
+                                                pu1_uv_src + wd_simd,
+                                                pu4_rgba_dst + wd_simd,
+                                                wd - wd_simd,
+                                                ht,
+                                                src_y_strd,
+                                                src_uv_strd,
+                                                dst_strd,
+                                                is_u_first,
+                                                pi2_csc_coeffs);
+    }
+}
@@ -0,0 +1,619 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/**
+ *******************************************************************************
+ * @file
+ *  ih264d_format_conv_ssse3.c
+ *
+ * @brief
+ *  Contains function definitions for converting the 420SP display buffer to
+ * the output formats requested by the application
+ *
+ * @author
+ *  Ittiam
+ *
+ * @par List of Functions:
+ *  - ih264d_fmt_conv_420sp_to_420p_ssse3()
+ *  - ih264d_fmt_conv_420sp_to_420sp_swap_uv_ssse3()
+ *  - ih264d_yuv_to_rgb_16x2_ssse3()
+ *  - ih264d_fmt_conv_420sp_to_rgb565_ssse3()
+ *  - ih264d_fmt_conv_420sp_to_rgba8888_ssse3()
+ *
+ * @remarks
+ *  Columns left over after the last full vector are converted by the C
+ *  functions, so the outputs match them exactly
+ *
+ *******************************************************************************
+ */
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+/* System include files */
+#include <string.h>
+
+/* User include files */
+#include "ih264_typedefs.h"
+#include "iv.h"
+#include "ih264_macros.h"
+#include "ih264_platform_macros.h"
+#include "ih264d_structs.h"
+#include "ih264d_format_conv.h"
+#include <immintrin.h>
+
+/**
+ *******************************************************************************
+ *
+ * @brief Deinterleaves a 420SP buffer to 420P
+ *
+ * @par   Description
+ *  SSSE3 variant of ih264d_fmt_conv_420sp_to_420p(). 16 samples each of U
+ *  and V are separated per iteration using a byte shuffle
+ *
+ * @param[in] pu1_y_src
+ *   Input Y pointer
+ *
+ * @param[in] pu1_uv_src
+ *   Input UV pointer (UV is interleaved either in UV or VU format)
+ *
+ * @param[in] pu1_y_dst
+ *   Output Y pointer
+ *
+ * @param[in] pu1_u_dst
+ *   Output U pointer
+ *
+ * @param[in] pu1_v_dst
+ *   Output V pointer
+ *
+ * @param[in] wd
+ *   Width
+ *
+ * @param[in] ht
+ *   Height
+ *
+ * @param[in] src_y_strd
+ *   Input Y Stride
+ *
+ * @param[in] src_uv_strd
+ *   Input UV stride
+ *
+ * @param[in] dst_y_strd
+ *   Output Y stride
+ *
+ * @param[in] dst_uv_strd
+ *   Output UV stride
+ *
+ * @param[in] is_u_first
+ *   Flag to indicate if U is the first byte in input chroma part
+ *
+ * @param[in] disable_luma_copy
+ *   Flag to skip the luma copy
+ *
+ * @returns none
+ *
+ * @remarks none
+ *
+ *******************************************************************************
+ */
+ATTRIBUTE_SSSE3
+void ih264d_fmt_conv_420sp_to_420p_ssse3(UWORD8 *pu1_y_src,
+                                         UWORD8 *pu1_uv_src,
+                                         UWORD8 *pu1_y_dst,
+                                         UWORD8 *pu1_u_dst,
+                                         UWORD8 *pu1_v_dst,
+                                         WORD32 wd,
+                                         WORD32 ht,
+                                         WORD32 src_y_strd,
+                                         WORD32 src_uv_strd,
+                                         WORD32 dst_y_strd,
+                                         WORD32 dst_uv_strd,
+                                         WORD32 is_u_first,
+                                         WORD32 disable_luma_copy)
+{
+    UWORD8 *pu1_first_dst, *pu1_second_dst;
+    WORD32 num_cols, num_cols_simd;
+    WORD32 i, j;
+    __m128i deinterleave_mask;
+
+    if(0 == disable_luma_copy)
+    {
+        for(i = 0; i < ht; i++)
+        {
+            memcpy(pu1_y_dst, pu1_y_src, wd);
+            pu1_y_dst += dst_y_strd;
+            pu1_y_src += src_y_strd;
+        }
+    }
+
+    /* Even bytes of the source go to the first plane, odd to the second */
+    if(is_u_first)
+    {
+        pu1_first_dst = pu1_u_dst;
+        pu1_second_dst = pu1_v_dst;
+    }
+    else
+    {
+        pu1_first_dst = pu1_v_dst;
+        pu1_second_dst = pu1_u_dst;
+    }
+
+    deinterleave_mask = _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14,
+                                      1, 3, 5, 7, 9, 11, 13, 15);
+    num_cols = wd >> 1;
+    num_cols_simd = num_cols & ~15;
+
+    for(i = 0; i < (ht >> 1); i++)
+    {
+        for(j = 0; j < num_cols_simd; j += 16)
+        {
+            __m128i src_0, src_1;
+
+            src_0 = _mm_loadu_si128((__m128i *)(pu1_uv_src + 2 * j));
+            src_1 = _mm_loadu_si128((__m128i *)(pu1_uv_src + 2 * j + 16));
+
+            src_0 = _mm_shuffle_epi8(src_0, deinterleave_mask);
+            src_1 = _mm_shuffle_epi8(src_1, deinterleave_mask);
+
+            _mm_storeu_si128((__m128i *)(pu1_first_dst + j),
+                             _mm_unpacklo_epi64(src_0, src_1));
+            _mm_storeu_si128((__m128i *)(pu1_second_dst + j),
+                             _mm_unpackhi_epi64(src_0, src_1));
+        }
+        for(; j < num_cols; j++)
+        {
+            pu1_first_dst[j] = pu1_uv_src[j * 2];
+            pu1_second_dst[j] = pu1_uv_src[j * 2 + 1];
+        }
+
+        pu1_first_dst += dst_uv_strd;
+        pu1_second_dst += dst_uv_strd;
+        pu1_uv_src += src_uv_strd;
+    }
+    return;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Copies a 420SP buffer swapping the order of U and V
+ *
+ * @par   Description
+ *  SSSE3 variant of ih264d_fmt_conv_420sp_to_420sp_swap_uv()
+ *
+ * @param[in] pu1_y_src
+ *   Input Y pointer
+ *
+ * @param[in] pu1_uv_src
+ *   Input UV pointer (UV is interleaved either in UV or VU format)
+ *
+ * @param[in] pu1_y_dst
+ *   Output Y pointer
+ *
+ * @param[in] pu1_uv_dst
+ *   Output UV pointer
+ *
+ * @param[in] wd
+ *   Width
+ *
+ * @param[in] ht
+ *   Height
+ *
+ * @param[in] src_y_strd
+ *   Input Y Stride
+ *
+ * @param[in] src_uv_strd
+ *   Input UV stride
+ *
+ * @param[in] dst_y_strd
+ *   Output Y stride
+ *
+ * @param[in] dst_uv_strd
+ *   Output UV stride
+ *
+ * @returns None
+ *
+ * @remarks None
+ *
+ *******************************************************************************
+ */
+ATTRIBUTE_SSSE3
+void ih264d_fmt_conv_420sp_to_420sp_swap_uv_ssse3(UWORD8 *pu1_y_src,
+                                                  UWORD8 *pu1_uv_src,
+                                                  UWORD8 *pu1_y_dst,
+                                                  UWORD8 *pu1_uv_dst,
+                                                  WORD32 wd,
+                                                  WORD32 ht,
+                                                  WORD32 src_y_strd,
+                                                  WORD32 src_uv_strd,
+                                                  WORD32 dst_y_strd,
+                                                  WORD32 dst_uv_strd)
+{
+    WORD32 num_cols_simd;
+    WORD32 i, j;
+    __m128i swap_mask;
+
+    for(i = 0; i < ht; i++)
+    {
+        memcpy(pu1_y_dst, pu1_y_src, wd);
+        pu1_y_dst += dst_y_strd;
+        pu1_y_src += src_y_strd;
+    }
+
+    swap_mask = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6,
+                              9, 8, 11, 10, 13, 12, 15, 14);
+    num_cols_simd = wd & ~15;
+
+    for(i = 0; i < (ht >> 1); i++)
+    {
+        for(j = 0; j < num_cols_simd; j += 16)
+        {
+            __m128i src;
+
+            src = _mm_loadu_si128((__m128i *)(pu1_uv_src + j));
+            src = _mm_shuffle_epi8(src, swap_mask);
+            _mm_storeu_si128((__m128i *)(pu1_uv_dst + j), src);
+        }
+        for(; j < wd; j += 2)
+        {
+            pu1_uv_dst[j + 0] = pu1_uv_src[j + 1];
+            pu1_uv_dst[j + 1] = pu1_uv_src[j + 0];
+        }
+
+        pu1_uv_dst += dst_uv_strd;
+        pu1_uv_src += src_uv_strd;
+    }
+    return;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Converts 16x2 pixels of 420SP to unclipped R, G and B
+ *
+ * @par   Description
+ *  The 8 chroma pairs are turned in to R, G and B offsets with pmaddwd, so
+ *  that the sum of the U and V terms is shifted once, as in the C code. Luma
+ *  is scaled as ((y - offset) << 3) * gain >> 16, which equals
+ *  ((y - offset) * gain) >> 13. Outputs are 16 bit, [0] holding pixels 0-7
+ *  and [1] pixels 8-15 of the row
+ *
+ * @param[in] pu1_y_src
+ *   Input Y pointer of the first row
+ *
+ * @param[in] src_y_strd
+ *   Input Y stride
+ *
+ * @param[in] uv
+ *   8 chroma pairs ordered U, V
+ *
+ * @param[in] pi2_csc_coeffs
+ *   YUV to RGB coefficients
+ *
+ * @param[out] pr, pg, pb
+ *   R, G and B of both rows, 4 registers each
+ *
+ * @returns None
+ *
+ * @remarks None
+ *
+ *******************************************************************************
+ */
+ATTRIBUTE_SSSE3
+static void ih264d_yuv_to_rgb_16x2_ssse3(UWORD8 *pu1_y_src,
+                                         WORD32 src_y_strd,
+                                         __m128i uv,
+                                         const WORD16 *pi2_csc_coeffs,
+                                         __m128i *pr,
+                                         __m128i *pg,
+                                         __m128i *pb)
+{
+    WORD16 v_to_r = pi2_csc_coeffs[CSC_V_TO_R];
+    WORD16 u_to_g = pi2_csc_coeffs[CSC_U_TO_G];
+    WORD16 v_to_g = pi2_csc_coeffs[CSC_V_TO_G];
+    WORD16 u_to_b = pi2_csc_coeffs[CSC_U_TO_B];
+    __m128i zero = _mm_setzero_si128();
+    __m128i const_128 = _mm_set1_epi16(128);
+    __m128i y_gain = _mm_set1_epi16(pi2_csc_coeffs[CSC_Y_GAIN]);
+    __m128i y_ofst = _mm_set1_epi16(pi2_csc_coeffs[CSC_Y_OFFSET]);
+    __m128i coeff_r = _mm_setr_epi16(0, v_to_r, 0, v_to_r,
+                                     0, v_to_r, 0, v_to_r);
+    __m128i coeff_g = _mm_setr_epi16(u_to_g, v_to_g, u_to_g, v_to_g,
+                                     u_to_g, v_to_g, u_to_g, v_to_g);
+    __m128i coeff_b = _mm_setr_epi16(u_to_b, 0, u_to_b, 0,
+                                     u_to_b, 0, u_to_b, 0);
+    __m128i uv_lo, uv_hi, r, g, b;
+    WORD32 row;
+
+    uv_lo = _mm_sub_epi16(_mm_unpacklo_epi8(uv, zero), const_128);
+    uv_hi = _mm_sub_epi16(_mm_unpackhi_epi8(uv, zero), const_128);
+
+    r = _mm_packs_epi32(_mm_srai_epi32(_mm_madd_epi16(uv_lo, coeff_r), 13),
+                        _mm_srai_epi32(_mm_madd_epi16(uv_hi, coeff_r), 13));
+    g = _mm_packs_epi32(_mm_srai_epi32(_mm_madd_epi16(uv_lo, coeff_g), 13),
+                        _mm_srai_epi32(_mm_madd_epi16(uv_hi, coeff_g), 13));
+    b = _mm_packs_epi32(_mm_srai_epi32(_mm_madd_epi16(uv_lo, coeff_b), 13),
+                        _mm_srai_epi32(_mm_madd_epi16(uv_hi, coeff_b), 13));
+
+    for(row = 0; row < 2; row++)
+    {
+        __m128i y, y_lo, y_hi;
+
+        y = _mm_loadu_si128((__m128i *)(pu1_y_src + row * src_y_strd));
+        y_lo = _mm_sub_epi16(_mm_unpacklo_epi8(y, zero), y_ofst);
+        y_hi = _mm_sub_epi16(_mm_unpackhi_epi8(y, zero), y_ofst);
+        y_lo = _mm_mulhi_epi16(_mm_slli_epi16(y_lo, 3), y_gain);
+        y_hi = _mm_mulhi_epi16(_mm_slli_epi16(y_hi, 3), y_gain);
+
+        /* Each chroma sample covers two horizontally adjacent pixels */
+        pr[2 * row + 0] = _mm_add_epi16(y_lo, _mm_unpacklo_epi16(r, r));
+        pr[2 * row + 1] = _mm_add_epi16(y_hi, _mm_unpackhi_epi16(r, r));
+        pg[2 * row + 0] = _mm_add_epi16(y_lo, _mm_unpacklo_epi16(g, g));
+        pg[2 * row + 1] = _mm_add_epi16(y_hi, _mm_unpackhi_epi16(g, g));
+        pb[2 * row + 0] = _mm_add_epi16(y_lo, _mm_unpacklo_epi16(b, b));
+        pb[2 * row + 1] = _mm_add_epi16(y_hi, _mm_unpackhi_epi16(b, b));
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Converts a 420SP buffer to RGB565
+ *
+ * @par   Description
+ *  SSSE3 variant of ih264d_fmt_conv_420sp_to_rgb565(). Converts 16x2 pixels
+ *  per iteration
+ *
+ * @param[in] pu1_y_src
+ *   Input Y pointer
+ *
+ * @param[in] pu1_uv_src
+ *   Input UV pointer (UV is interleaved either in UV or VU format)
+ *
+ * @param[in] pu2_rgb_dst
+ *   Output RGB pointer
+ *
+ * @param[in] wd
+ *   Width
+ *
+ * @param[in] ht
+ *   Height
+ *
+ * @param[in] src_y_strd
+ *   Input Y Stride
+ *
+ * @param[in] src_uv_strd
+ *   Input UV stride
+ *
+ * @param[in] dst_strd
+ *   Output stride in pixels
+ *
+ * @param[in] is_u_first
+ *   Flag to indicate if U is the first byte in input chroma part
+ *
+ * @param[in] pi2_csc_coeffs
+ *   YUV to RGB coefficients
+ *
+ * @returns None
+ *
+ * @remarks None
+ *
+ *******************************************************************************
+ */
+ATTRIBUTE_SSSE3
+void ih264d_fmt_conv_420sp_to_rgb565_ssse3(UWORD8 *pu1_y_src,
+                                           UWORD8 *pu1_uv_src,
+                                           UWORD16 *pu2_rgb_dst,
+                                           WORD32 wd,
+                                           WORD32 ht,
+                                           WORD32 src_y_strd,
+                                           WORD32 src_uv_strd,
+                                           WORD32 dst_strd,
+                                           WORD32 is_u_first,
+                                           const WORD16 *pi2_csc_coeffs)
+{
+    WORD32 wd_simd = wd & ~15;
+    WORD32 i, j, k;
+    __m128i uv_mask, zero, const_255, mask_r, mask_g;
+
+    if(is_u_first)
+        uv_mask = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7,
+                                8, 9, 10, 11, 12, 13, 14, 15);
+    else
+        uv_mask = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6,
+                                9, 8, 11, 10, 13, 12, 15, 14);
+
+    zero = _mm_setzero_si128();
+    const_255 = _mm_set1_epi16(255);
+    mask_r = _mm_set1_epi16(0xF8);
+    mask_g = _mm_set1_epi16(0xFC);
+
+    for(i = 0; i < (ht >> 1); i++)
+    {
+        UWORD8 *pu1_y = pu1_y_src + 2 * i * src_y_strd;
+        UWORD8 *pu1_uv = pu1_uv_src + i * src_uv_strd;
+        UWORD16 *pu2_dst = pu2_rgb_dst + 2 * i * dst_strd;
+
+        for(j = 0; j < wd_simd; j += 16)
+        {
+            __m128i uv, r[4], g[4], b[4];
+
+            uv = _mm_loadu_si128((__m128i *)(pu1_uv + j));
+            uv = _mm_shuffle_epi8(uv, uv_mask);
+
+            ih264d_yuv_to_rgb_16x2_ssse3(pu1_y + j, src_y_strd, uv,
+                                         pi2_csc_coeffs, r, g, b);
+
+            for(k = 0; k < 4; k++)
+            {
+                __m128i rgb;
+
+                r[k] = _mm_max_epi16(_mm_min_epi16(r[k], const_255), zero);
+                g[k] = _mm_max_epi16(_mm_min_epi16(g[k], const_255), zero);
+                b[k] = _mm_max_epi16(_mm_min_epi16(b[k], const_255), zero);
+
+                /* ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3) */
+                rgb = _mm_slli_epi16(_mm_and_si128(r[k], mask_r), 8);
+                rgb = _mm_or_si128(rgb, _mm_slli_epi16(_mm_and_si128(g[k], mask_g), 3));
+                rgb = _mm_or_si128(rgb, _mm_srli_epi16(b[k], 3));
+
+                _mm_storeu_si128((__m128i *)(pu2_dst + (k >> 1) * dst_strd
+                                             + j + (k & 1) * 8), rgb);
+            }
+        }
+    }
+
+    if(wd > wd_simd)
+    {
+        ih264d_fmt_conv_420sp_to_rgb565(pu1_y_src + wd_simd,
+                                        pu1_uv_src + wd_simd,
+                                        pu2_rgb_dst + wd_simd,
+                                        wd - wd_simd,
+                                        ht,
+                                        src_y_strd,
+                                        src_uv_strd,
+                                        dst_strd,
+                                        is_u_first,
+                                        pi2_csc_coeffs);
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Converts a 420SP buffer to RGBA8888
+ *
+ * @par   Description
+ *  SSSE3 variant of ih264d_fmt_conv_420sp_to_rgba8888(). Converts 16x2
+ *  pixels per iteration
+ *
+ * @param[in] pu1_y_src
+ *   Input Y pointer
+ *
+ * @param[in] pu1_uv_src
+ *   Input UV pointer (UV is interleaved either in UV or VU format)
+ *
+ * @param[in] pu4_rgba_dst
+ *   Output RGBA pointer
+ *
+ * @param[in] wd
+ *   Width
+ *
+ * @param[in] ht
+ *   Height
+ *
+ * @param[in] src_y_strd
+ *   Input Y Stride
+ *
+ * @param[in] src_uv_strd
+ *   Input UV stride
+ *
+ * @param[in] dst_strd
+ *   Output stride in pixels
+ *
+ * @param[in] is_u_first
+ *   Flag to indicate if U is the first byte in input chroma part
+ *
+ * @param[in] pi2_csc_coeffs
+ *   YUV to RGB coefficients
+ *
+ * @returns None
+ *
+ * @remarks None
+ *
+ *******************************************************************************
+ */
+ATTRIBUTE_SSSE3
+void ih264d_fmt_conv_420sp_to_rgba8888_ssse3(UWORD8 *pu1_y_src,
+                                             UWORD8 *pu1_uv_src,
+                                             UWORD32 *pu4_rgba_dst,
+                                             WORD32 wd,
+                                             WORD32 ht,
+                                             WORD32 src_y_strd,
+                                             WORD32 src_uv_strd,
+                                             WORD32 dst_strd,
+                                             WORD32 is_u_first,
+                                             const WORD16 *pi2_csc_coeffs)
+{
+    WORD32 wd_simd = wd & ~15;
+    WORD32 i, j, row;
+    __m128i uv_mask, zero;
+
+    if(is_u_first)
+        uv_mask = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7,
+                                8, 9, 10, 11, 12, 13, 14, 15);
+    else
+        uv_mask = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6,
+                                9, 8, 11, 10, 13, 12, 15, 14);
+
+    zero = _mm_setzero_si128();
+
+    for(i = 0; i < (ht >> 1); i++)
+    {
+        UWORD8 *pu1_y = pu1_y_src + 2 * i * src_y_strd;
+        UWORD8 *pu1_uv = pu1_uv_src + i * src_uv_strd;
+        UWORD32 *pu4_dst = pu4_rgba_dst + 2 * i * dst_strd;
+
+        for(j = 0; j < wd_simd; j += 16)
+        {
+            __m128i uv, r[4], g[4], b[4];
+
+            uv = _mm_loadu_si128((__m128i *)(pu1_uv + j));
+            uv = _mm_shuffle_epi8(uv, uv_mask);
+
+            ih264d_yuv_to_rgb_16x2_ssse3(pu1_y + j, src_y_strd, uv,
+                                         pi2_csc_coeffs, r, g, b);
+
+            for(row = 0; row < 2; row++)
+            {
+                __m128i r8, g8, b8, bg, r0;
+                UWORD32 *pu4_out = pu4_dst + row * dst_strd + j;
+
+                /* Saturating packs clip to [0, 255] */
+                r8 = _mm_packus_epi16(r[2 * row], r[2 * row + 1]);
+                g8 = _mm_packus_epi16(g[2 * row], g[2 * row + 1]);
+                b8 = _mm_packus_epi16(b[2 * row], b[2 * row + 1]);
+
+                /* Byte order in memory is B, G, R, 0 */
+                bg = _mm_unpacklo_epi8(b8, g8);
+                r0 = _mm_unpacklo_epi8(r8, zero);
+                _mm_storeu_si128((__m128i *)(pu4_out + 0), _mm_unpacklo_epi16(bg, r0));
+                _mm_storeu_si128((__m128i *)(pu4_out + 4), _mm_unpackhi_epi16(bg, r0));
+
+                bg = _mm_unpackhi_epi8(b8, g8);
+                r0 = _mm_unpackhi_epi8(r8, zero);
+                _mm_storeu_si128((__m128i *)(pu4_out + 8), _mm_unpacklo_epi16(bg, r0));
+                _mm_storeu_si128((__m128i *)(pu4_out + 12), _mm_unpackhi_epi16(bg, r0));
+            }
+        }
+    }
+
+    if(wd > wd_simd)
+    {
+        ih264d_fmt_conv_420sp_to_rgba8888(pu1_y_src + wd_simd,
+                                          pu1_uv_src + wd_simd,
+                                          pu4_rgba_dst + wd_simd,
+                                          wd - wd_simd,
+                                          ht,
+                                          src_y_strd,
+                                          src_uv_strd,
+                                          dst_strd,
+                                          is_u_first,
+                                          pi2_csc_coeffs);
+    }
+}
@@ -52,12 +52,81 @@
 #include "ih264_error.h"
 #include "ih264_trans_quant_itrans_iquant.h"
 #include "ih264_inter_pred_filters.h"
+#include "ih264_cpu_features.h"
 
 #include "ih264d_structs.h"
 #include "ih264d_function_selector.h"
 
+/**
+*******************************************************************************
+*
+* @brief Returns the highest architecture supported by the processor
+*
+* @par Description: Maps the instruction set extensions reported at run time
+* to the best kernel table available in the decoder
+*
+* @returns  IVD_ARCH_T
+*  architecture
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static IVD_ARCH_T ih264d_get_cpu_arch(void)
+{
+    UWORD32 u4_features = ih264_get_cpu_features();
+
+    if(u4_features & IH264_CPU_AVX2)
+        return ARCH_X86_AVX2;
+    if(u4_features & IH264_CPU_SSE42)
+        return ARCH_X86_SSE42;
+    if(u4_features & IH264_CPU_SSSE3)
+        return ARCH_X86_SSSE3;
+    return ARCH_X86_GENERIC;
+}
+
+/**
+*******************************************************************************
+*
+* @brief Limits the requested architecture to what the processor supports
+*
+* @par Description: An application may ask for any x86 architecture through
+* set processor. Requests beyond the capability of the processor are lowered
+* to the best supported one, and non x86 requests select the best supported
+* one as well
+*
+* @param[in] e_arch
+*  Requested architecture
+*
+* @returns  IVD_ARCH_T
+*  architecture
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static IVD_ARCH_T ih264d_get_supported_arch(IVD_ARCH_T e_arch)
+{
+    IVD_ARCH_T e_cpu_arch = ih264d_get_cpu_arch();
+
+    switch(e_arch)
+    {
+        case ARCH_X86_GENERIC:
+            return ARCH_X86_GENERIC;
+        case ARCH_X86_SSSE3:
+        case ARCH_X86_SSE42:
+        case ARCH_X86_AVX2:
+            /* x86 architectures are enumerated in increasing capability */
+            return (e_arch < e_cpu_arch) ? e_arch : e_cpu_arch;
+        default:
+            return e_cpu_arch;
+    }
+}
+
 void ih264d_init_function_ptr(dec_struct_t *ps_codec)
 {
+    ps_codec->e_processor_arch =
+                    ih264d_get_supported_arch(ps_codec->e_processor_arch);
 
     ih264d_init_function_ptr_generic(ps_codec);
     switch(ps_codec->e_processor_arch)
@@ -68,6 +137,11 @@ void ih264d_init_function_ptr(dec_struct_t *ps_codec)
         case ARCH_X86_SSSE3:
             ih264d_init_function_ptr_ssse3(ps_codec);
             break;
+        case ARCH_X86_AVX2:
+            ih264d_init_function_ptr_ssse3(ps_codec);
+            ih264d_init_function_ptr_sse42(ps_codec);
+            ih264d_init_function_ptr_avx2(ps_codec);
+            break;
         case ARCH_X86_SSE42:
         default:
             ih264d_init_function_ptr_ssse3(ps_codec);
@@ -77,18 +151,5 @@ void ih264d_init_function_ptr(dec_struct_t *ps_codec)
 }
 void ih264d_init_arch(dec_struct_t *ps_codec)
 {
-#ifdef DEFAULT_ARCH
-#if DEFAULT_ARCH == D_ARCH_X86_SSE42
-    ps_codec->e_processor_arch = ARCH_X86_SSE42;
-#elif DEFAULT_ARCH == D_ARCH_X86_SSSE3
-    ps_codec->e_processor_arch = ARCH_X86_SSSE3;
-#elif DEFAULT_ARCH == D_ARCH_X86_AVX2
-    ps_codec->e_processor_arch = D_ARCH_X86_AVX2;
-#else
-    ps_codec->e_processor_arch = ARCH_X86_GENERIC;
-#endif
-#else
-    ps_codec->e_processor_arch = ARCH_X86_SSE42;
-#endif
-
+    ps_codec->e_processor_arch = ih264d_get_cpu_arch();
 }
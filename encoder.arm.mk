@@ -23,6 +23,12 @@ libavce_srcs_asm_arm    +=  common/arm/ih264_inter_pred_filters_luma_horz_a9q.s
 libavce_srcs_asm_arm    +=  common/arm/ih264_inter_pred_filters_luma_vert_a9q.s
 libavce_srcs_asm_arm    +=  common/arm/ih264_inter_pred_luma_bilinear_a9q.s
 libavce_srcs_asm_arm    +=  common/arm/ih264_inter_pred_luma_copy_a9q.s
+libavce_srcs_asm_arm    +=  common/arm/ih264_inter_pred_luma_horz_qpel_a9q.s
+libavce_srcs_asm_arm    +=  common/arm/ih264_inter_pred_luma_vert_qpel_a9q.s
+libavce_srcs_asm_arm    +=  common/arm/ih264_inter_pred_luma_horz_hpel_vert_hpel_a9q.s
+libavce_srcs_asm_arm    +=  common/arm/ih264_inter_pred_luma_horz_qpel_vert_qpel_a9q.s
+libavce_srcs_asm_arm    +=  common/arm/ih264_inter_pred_luma_horz_qpel_vert_hpel_a9q.s
+libavce_srcs_asm_arm    +=  common/arm/ih264_inter_pred_luma_horz_hpel_vert_qpel_a9q.s
 libavce_srcs_asm_arm    +=  common/arm/ih264_padding_neon.s
 libavce_srcs_asm_arm    +=  common/arm/ih264_mem_fns_neon.s
 
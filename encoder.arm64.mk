@@ -23,6 +23,12 @@ libavce_srcs_asm_arm64    +=  common/armv8/ih264_inter_pred_luma_copy_av8.s
 libavce_srcs_asm_arm64    +=  common/armv8/ih264_inter_pred_chroma_av8.s
 libavce_srcs_asm_arm64    +=  common/armv8/ih264_inter_pred_filters_luma_horz_av8.s
 libavce_srcs_asm_arm64    +=  common/armv8/ih264_inter_pred_filters_luma_vert_av8.s
+libavce_srcs_asm_arm64    +=  common/armv8/ih264_inter_pred_luma_horz_qpel_av8.s
+libavce_srcs_asm_arm64    +=  common/armv8/ih264_inter_pred_luma_vert_qpel_av8.s
+libavce_srcs_asm_arm64    +=  common/armv8/ih264_inter_pred_luma_horz_hpel_vert_hpel_av8.s
+libavce_srcs_asm_arm64    +=  common/armv8/ih264_inter_pred_luma_horz_qpel_vert_qpel_av8.s
+libavce_srcs_asm_arm64    +=  common/armv8/ih264_inter_pred_luma_horz_qpel_vert_hpel_av8.s
+libavce_srcs_asm_arm64    +=  common/armv8/ih264_inter_pred_luma_horz_hpel_vert_qpel_av8.s
 libavce_srcs_asm_arm64    +=  common/armv8/ih264_padding_neon_av8.s
 libavce_srcs_asm_arm64    +=  common/armv8/ih264_mem_fns_neon_av8.s
 libavce_srcs_asm_arm64    +=  common/armv8/ih264_deblk_luma_av8.s
@@ -43,6 +43,7 @@ libavce_srcs_c  += encoder/ih264e_me.c
 libavce_srcs_c  += encoder/ih264e_rc_mem_interface.c
 libavce_srcs_c  += encoder/ih264e_time_stamp.c
 libavce_srcs_c  += encoder/ih264e_modify_frm_rate.c
+libavce_srcs_c  += encoder/ih264e_lookahead.c
 libavce_srcs_c  += encoder/ih264e_rate_control.c
 libavce_srcs_c  += encoder/ih264e_core_coding.c
 libavce_srcs_c  += encoder/ih264e_deblk.c
@@ -204,6 +204,23 @@ void ih264e_init_function_ptr_neon_a9q(codec_t *ps_codec)
     ps_codec->pf_inter_pred_luma_bilinear = ih264_inter_pred_luma_bilinear_a9q;
     ps_codec->pf_inter_pred_chroma = ih264_inter_pred_chroma_a9q;
 
+    ps_codec->apf_inter_pred_luma[0] = ih264_inter_pred_luma_copy_a9q;
+    ps_codec->apf_inter_pred_luma[1] = ih264_inter_pred_luma_horz_qpel_a9q;
+    ps_codec->apf_inter_pred_luma[2] = ih264_inter_pred_luma_horz_a9q;
+    ps_codec->apf_inter_pred_luma[3] = ih264_inter_pred_luma_horz_qpel_a9q;
+    ps_codec->apf_inter_pred_luma[4] = ih264_inter_pred_luma_vert_qpel_a9q;
+    ps_codec->apf_inter_pred_luma[5] = ih264_inter_pred_luma_horz_qpel_vert_qpel_a9q;
+    ps_codec->apf_inter_pred_luma[6] = ih264_inter_pred_luma_horz_hpel_vert_qpel_a9q;
+    ps_codec->apf_inter_pred_luma[7] = ih264_inter_pred_luma_horz_qpel_vert_qpel_a9q;
+    ps_codec->apf_inter_pred_luma[8] = ih264_inter_pred_luma_vert_a9q;
+    ps_codec->apf_inter_pred_luma[9] = ih264_inter_pred_luma_horz_qpel_vert_hpel_a9q;
+    ps_codec->apf_inter_pred_luma[10] = ih264_inter_pred_luma_horz_hpel_vert_hpel_a9q;
+    ps_codec->apf_inter_pred_luma[11] = ih264_inter_pred_luma_horz_qpel_vert_hpel_a9q;
+    ps_codec->apf_inter_pred_luma[12] = ih264_inter_pred_luma_vert_qpel_a9q;
+    ps_codec->apf_inter_pred_luma[13] = ih264_inter_pred_luma_horz_qpel_vert_qpel_a9q;
+    ps_codec->apf_inter_pred_luma[14] = ih264_inter_pred_luma_horz_hpel_vert_qpel_a9q;
+    ps_codec->apf_inter_pred_luma[15] = ih264_inter_pred_luma_horz_qpel_vert_qpel_a9q;
+
     /* sad me level functions */
     ps_codec->apf_compute_sad_16x16[0] = ime_compute_sad_16x16_a9q;
     ps_codec->apf_compute_sad_16x16[1] = ime_compute_sad_16x16_fast_a9q;
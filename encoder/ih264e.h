@@ -437,6 +437,18 @@ typedef struct
 typedef struct
 {
     ive_ctl_set_gop_params_ip_t     s_ive_ip;
+
+    /**
+     * Place B frames adaptively, using up to u4_num_bframes B frames per sub
+     * gop. Read only when u4_size covers this field
+     */
+    UWORD32                         u4_enable_adaptive_bframes;
+
+    /**
+     * Frame type inserted at detected scene cuts: IV_I_FRAME, IV_IDR_FRAME or
+     * IV_NA_FRAME to disable detection. Read only when u4_size covers this field
+     */
+    IV_PICTURE_CODING_TYPE_T        e_scene_cut_frm_type;
 }ih264e_ctl_set_gop_params_ip_t;
 
 typedef struct
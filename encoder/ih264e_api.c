@@ -114,6 +114,7 @@
 #include "ih264e_structs.h"
 #include "ih264e_utils.h"
 #include "ih264e_core_coding.h"
+#include "ih264e_lookahead.h"
 #include "ih264_platform_macros.h"
 #include "ih264e_platform_macros.h"
 #include "ih264_list.h"
@@ -1323,6 +1324,16 @@ static IV_STATUS_T api_check_struct_sanity(iv_obj_t *ps_handle,
                         return IV_FAIL;
                     }
 
+                    if ((ps_ip->s_ive_ip.u4_pre_enc_me != 0)
+                                    && (ps_ip->s_ive_ip.u4_pre_enc_me != 1))
+                    {
+                        ps_op->s_ive_op.u4_error_code |= 1
+                                        << IVE_UNSUPPORTEDPARAM;
+                        ps_op->s_ive_op.u4_error_code |=
+                                        IH264E_INVALID_PRE_ENC_ME_OPTION;
+                        return IV_FAIL;
+                    }
+
                     if ((ps_ip->s_ive_ip.u4_enable_hpel != 0)
                                     && (ps_ip->s_ive_ip.u4_enable_hpel != 1))
                     {
@@ -1442,8 +1453,10 @@ static IV_STATUS_T api_check_struct_sanity(iv_obj_t *ps_handle,
                     ih264e_ctl_set_gop_params_ip_t *ps_ip = pv_api_ip;
                     ih264e_ctl_set_gop_params_op_t *ps_op = pv_api_op;
 
-                    if (ps_ip->s_ive_ip.u4_size
+                    if ((ps_ip->s_ive_ip.u4_size
                                     != sizeof(ih264e_ctl_set_gop_params_ip_t))
+                                    && (ps_ip->s_ive_ip.u4_size
+                                                    != sizeof(ive_ctl_set_gop_params_ip_t)))
                     {
                         ps_op->s_ive_op.u4_error_code |= 1
                                         << IVE_UNSUPPORTEDPARAM;
@@ -1482,6 +1495,31 @@ static IV_STATUS_T api_check_struct_sanity(iv_obj_t *ps_handle,
                         return IV_FAIL;
                     }
 
+                    if (ps_ip->s_ive_ip.u4_size
+                                    == sizeof(ih264e_ctl_set_gop_params_ip_t))
+                    {
+                        if ((ps_ip->u4_enable_adaptive_bframes != 0)
+                                        && (ps_ip->u4_enable_adaptive_bframes != 1))
+                        {
+                            ps_op->s_ive_op.u4_error_code |= 1
+                                            << IVE_UNSUPPORTEDPARAM;
+                            ps_op->s_ive_op.u4_error_code |=
+                                            IH264E_INVALID_ADAPTIVE_BFRAMES_OPTION;
+                            return IV_FAIL;
+                        }
+
+                        if ((ps_ip->e_scene_cut_frm_type != IV_NA_FRAME)
+                                        && (ps_ip->e_scene_cut_frm_type != IV_I_FRAME)
+                                        && (ps_ip->e_scene_cut_frm_type != IV_IDR_FRAME))
+                        {
+                            ps_op->s_ive_op.u4_error_code |= 1
+                                            << IVE_UNSUPPORTEDPARAM;
+                            ps_op->s_ive_op.u4_error_code |=
+                                            IH264E_INVALID_SCENE_CUT_FRAME_TYPE;
+                            return IV_FAIL;
+                        }
+                    }
+
                     break;
                 }
 
@@ -1967,6 +2005,7 @@ IH264E_ERROR_T ih264e_codec_update_config(codec_t *ps_codec,
         {
             ps_codec->s_cfg.u4_enable_fast_sad = ps_cfg->u4_enable_fast_sad;
         }
+        ps_codec->s_cfg.u4_pre_enc_me = ps_cfg->u4_pre_enc_me;
         ps_codec->s_cfg.u4_srch_rng_x = ps_cfg->u4_srch_rng_x;
         ps_codec->s_cfg.u4_srch_rng_y = ps_cfg->u4_srch_rng_y;
 
@@ -1993,12 +2032,22 @@ IH264E_ERROR_T ih264e_codec_update_config(codec_t *ps_codec,
 
             /* sub pel off */
             ps_curr_cfg->u4_enable_hpel = 1;
+            ps_curr_cfg->u4_enable_qpel = 1;
 
             /* deblocking off */
             ps_curr_cfg->u4_disable_deblock_level = DISABLE_DEBLK_LEVEL_0;
 
             /* disabled intra inter gating in Inter slices */
             ps_codec->u4_inter_gate = 0;
+
+            /* 16x8, 8x16 and 8x8 partitions in P mbs */
+            ps_codec->u4_enable_mb_part = 1;
+
+            /* joint L0/L1 refinement of bipred in B mbs */
+            ps_codec->u4_enable_bipred_refine = 1;
+
+            /* active L0 references of P slices */
+            ps_codec->u4_max_num_ref_l0_active = 1;
         }
         else if (ps_curr_cfg->u4_enc_speed_preset == IVE_NORMAL)
         {/* normal */
@@ -2011,12 +2060,22 @@ IH264E_ERROR_T ih264e_codec_update_config(codec_t *ps_codec,
 
             /* sub pel off */
             ps_curr_cfg->u4_enable_hpel = 1;
+            ps_curr_cfg->u4_enable_qpel = 1;
 
             /* deblocking off */
             ps_curr_cfg->u4_disable_deblock_level = DISABLE_DEBLK_LEVEL_0;
 
             /* disabled intra inter gating in Inter slices */
             ps_codec->u4_inter_gate = 0;
+
+            /* 16x8, 8x16 and 8x8 partitions in P mbs */
+            ps_codec->u4_enable_mb_part = 1;
+
+            /* joint L0/L1 refinement of bipred in B mbs */
+            ps_codec->u4_enable_bipred_refine = 1;
+
+            /* active L0 references of P slices */
+            ps_codec->u4_max_num_ref_l0_active = 1;
         }
         else if (ps_curr_cfg->u4_enc_speed_preset == IVE_FAST)
         {/* normal */
@@ -2029,12 +2088,23 @@ IH264E_ERROR_T ih264e_codec_update_config(codec_t *ps_codec,
 
             /* sub pel off */
             ps_curr_cfg->u4_enable_hpel = 1;
+            ps_curr_cfg->u4_enable_qpel = 0;
 
             /* deblocking off */
             ps_curr_cfg->u4_disable_deblock_level = DISABLE_DEBLK_LEVEL_0;
 
             /* disabled intra inter gating in Inter slices */
             ps_codec->u4_inter_gate = 1;
+
+            /* 16x8, 8x16 and 8x8 partitions in P mbs */
+            ps_codec->u4_enable_mb_part = 0;
+
+            /* joint L0/L1 refinement of bipred in B mbs. Off, with B frames */
+            /* it saves about 1.5% of the bits for 30 to 60% more encode time */
+            ps_codec->u4_enable_bipred_refine = 0;
+
+            /* active L0 references of P slices */
+            ps_codec->u4_max_num_ref_l0_active = 1;
         }
         else if (ps_curr_cfg->u4_enc_speed_preset == IVE_HIGH_SPEED)
         {/* fast */
@@ -2047,12 +2117,22 @@ IH264E_ERROR_T ih264e_codec_update_config(codec_t *ps_codec,
 
             /* sub pel off */
             ps_curr_cfg->u4_enable_hpel = 0;
+            ps_curr_cfg->u4_enable_qpel = 0;
 
             /* deblocking off */
             ps_curr_cfg->u4_disable_deblock_level = DISABLE_DEBLK_LEVEL_4;
 
             /* disabled intra inter gating in Inter slices */
             ps_codec->u4_inter_gate = 0;
+
+            /* 16x8, 8x16 and 8x8 partitions in P mbs */
+            ps_codec->u4_enable_mb_part = 0;
+
+            /* joint L0/L1 refinement of bipred in B mbs */
+            ps_codec->u4_enable_bipred_refine = 0;
+
+            /* active L0 references of P slices */
+            ps_codec->u4_max_num_ref_l0_active = 1;
         }
         else if (ps_curr_cfg->u4_enc_speed_preset == IVE_FASTEST)
         {/* fastest */
@@ -2065,16 +2145,29 @@ IH264E_ERROR_T ih264e_codec_update_config(codec_t *ps_codec,
 
             /* sub pel off */
             ps_curr_cfg->u4_enable_hpel = 0;
+            ps_curr_cfg->u4_enable_qpel = 0;
 
             /* deblocking off */
             ps_curr_cfg->u4_disable_deblock_level = DISABLE_DEBLK_LEVEL_4;
 
             /* disabled intra inter gating in Inter slices */
             ps_codec->u4_inter_gate = 1;
+
+            /* 16x8, 8x16 and 8x8 partitions in P mbs */
+            ps_codec->u4_enable_mb_part = 0;
+
+            /* joint L0/L1 refinement of bipred in B mbs */
+            ps_codec->u4_enable_bipred_refine = 0;
+
+            /* active L0 references of P slices */
+            ps_codec->u4_max_num_ref_l0_active = 1;
         }
         else if (ps_curr_cfg->u4_enc_speed_preset == IVE_CONFIG)
         {
             ps_curr_cfg->u4_enable_intra_4x4 = ps_cfg->u4_enable_intra_4x4;
+
+            /* active L0 references of P slices */
+            ps_codec->u4_max_num_ref_l0_active = MAX_NUM_REF_IDX_L0_ACTIVE;
         }
     }
     else if (ps_cfg->e_cmd == IVE_CMD_CTL_SET_GOP_PARAMS)
@@ -2098,6 +2191,10 @@ IH264E_ERROR_T ih264e_codec_update_config(codec_t *ps_codec,
 
         ps_curr_cfg->u4_idr_frm_interval = ps_cfg->u4_idr_frm_interval;
 
+        ps_curr_cfg->u4_enable_adaptive_bframes = ps_cfg->u4_enable_adaptive_bframes;
+
+        ps_curr_cfg->e_scene_cut_frm_type = ps_cfg->e_scene_cut_frm_type;
+
     }
     else if (ps_cfg->e_cmd == IVE_CMD_CTL_SET_DEBLOCK_PARAMS)
     {
@@ -2342,6 +2439,7 @@ static WORD32 ih264e_set_default_params(cfg_params_t *ps_cfg)
     ps_cfg->u4_vbv_buf_size = DEFAULT_VBV_SIZE;
     ps_cfg->u4_num_cores = DEFAULT_NUM_CORES;
     ps_cfg->u4_me_speed_preset = DEFAULT_ME_SPEED_PRESET;
+    ps_cfg->u4_pre_enc_me = DEFAULT_PRE_ENC_ME;
     ps_cfg->u4_enable_hpel = DEFAULT_HPEL;
     ps_cfg->u4_enable_qpel = DEFAULT_QPEL;
     ps_cfg->u4_enable_intra_4x4 = DEFAULT_I4;
@@ -2357,6 +2455,8 @@ static WORD32 ih264e_set_default_params(cfg_params_t *ps_cfg)
     ps_cfg->u4_srch_rng_y = DEFAULT_SRCH_RNG_Y;
     ps_cfg->u4_i_frm_interval = DEFAULT_I_INTERVAL;
     ps_cfg->u4_idr_frm_interval = DEFAULT_IDR_INTERVAL;
+    ps_cfg->u4_enable_adaptive_bframes = DEFAULT_ADAPTIVE_BFRAMES;
+    ps_cfg->e_scene_cut_frm_type = DEFAULT_SCENE_CUT_FRM_TYPE;
     ps_cfg->u4_disable_deblock_level = DEFAULT_DISABLE_DEBLK_LEVEL;
     ps_cfg->e_profile = DEFAULT_PROFILE;
     ps_cfg->u4_timestamp_low = 0;
@@ -2463,6 +2563,15 @@ static WORD32 ih264e_init(codec_t *ps_codec)
     /* inter gating enable */
     ps_codec->u4_inter_gate = 0;
 
+    /* sub mb partitions disable */
+    ps_codec->u4_enable_mb_part = 0;
+
+    /* bipred refinement disable */
+    ps_codec->u4_enable_bipred_refine = 0;
+
+    /* multiple L0 references of P slices */
+    ps_codec->u4_max_num_ref_l0_active = MAX_NUM_REF_IDX_L0_ACTIVE;
+
     /* entropy mutex init */
     ithread_mutex_init(ps_codec->pv_entropy_mutex);
 
@@ -2487,6 +2596,9 @@ static WORD32 ih264e_init(codec_t *ps_codec)
     /* max Previous POC lsb */
     ps_codec->i4_max_prev_poc_lsb = -1;
 
+    /* lookahead holds no pictures */
+    ih264e_lookahead_init(ps_codec);
+
     /* sps, pps status */
     {
         sps_t *ps_sps = ps_codec->ps_sps_base;
@@ -3478,6 +3590,17 @@ static WORD32 ih264e_fill_num_mem_rec(void *pv_api_ip, void *pv_api_op)
     }
     DEBUG("\nMemory record Id %d = %d \n", MEM_REC_MB_INFO_NMB, ps_mem_rec->u4_mem_size);
 
+    /************************************************************************
+     * Request memory for the 1/16 resolution planes of the lookahead       *
+     ************************************************************************/
+    ps_mem_rec = &ps_mem_rec_base[MEM_REC_LOOKAHEAD];
+    {
+        /* a MB is a 4x4 block at 1/16 resolution */
+        ps_mem_rec->u4_mem_size = LOOKAHEAD_BUF_CNT * max_mb_cnt
+                        * (MB_SIZE >> 2) * (MB_SIZE >> 2);
+    }
+    DEBUG("\nMemory record Id %d = %d \n", MEM_REC_LOOKAHEAD, ps_mem_rec->u4_mem_size);
+
     /************************************************************************
      * RC mem records                                                       *
      ************************************************************************/
@@ -4409,6 +4532,19 @@ static WORD32 ih264e_init_mem_rec(iv_obj_t *ps_codec_obj,
         }
     }
 
+    ps_mem_rec = &ps_mem_rec_base[MEM_REC_LOOKAHEAD];
+    {
+        /* temp var */
+        UWORD8 *pu1_buf = ps_mem_rec->pv_base;
+
+        for (i = 0; i < LOOKAHEAD_BUF_CNT; i++)
+        {
+            ps_codec->s_lookahead.as_pics[i].pu1_luma = pu1_buf;
+
+            pu1_buf += max_mb_cnt * (MB_SIZE >> 2) * (MB_SIZE >> 2);
+        }
+    }
+
     ps_mem_rec = &ps_mem_rec_base[MEM_REC_RC];
     {
         ih264e_get_rate_control_mem_tab(&ps_codec->s_rate_control, ps_mem_rec,
@@ -5018,6 +5154,7 @@ static IV_STATUS_T ih264_set_me_params(void *pv_api_ip,
 
     ps_op->s_ive_op.u4_error_code = 0;
 
+    ps_cfg->u4_pre_enc_me = ps_ip->s_ive_ip.u4_pre_enc_me;
     ps_cfg->u4_enable_hpel = ps_ip->s_ive_ip.u4_enable_hpel;
     ps_cfg->u4_enable_qpel = ps_ip->s_ive_ip.u4_enable_qpel;
     ps_cfg->u4_enable_fast_sad = ps_ip->s_ive_ip.u4_enable_fast_sad;
@@ -5112,6 +5249,17 @@ static IV_STATUS_T ih264_set_gop_params(void *pv_api_ip,
     ps_cfg->u4_i_frm_interval = ps_ip->s_ive_ip.u4_i_frm_interval;
     ps_cfg->u4_idr_frm_interval = ps_ip->s_ive_ip.u4_idr_frm_interval;
 
+    if (ps_ip->s_ive_ip.u4_size == sizeof(ih264e_ctl_set_gop_params_ip_t))
+    {
+        ps_cfg->u4_enable_adaptive_bframes = ps_ip->u4_enable_adaptive_bframes;
+        ps_cfg->e_scene_cut_frm_type = ps_ip->e_scene_cut_frm_type;
+    }
+    else
+    {
+        ps_cfg->u4_enable_adaptive_bframes = DEFAULT_ADAPTIVE_BFRAMES;
+        ps_cfg->e_scene_cut_frm_type = DEFAULT_SCENE_CUT_FRM_TYPE;
+    }
+
     ps_cfg->u4_timestamp_high = ps_ip->s_ive_ip.u4_timestamp_high;
     ps_cfg->u4_timestamp_low = ps_ip->s_ive_ip.u4_timestamp_low;
 
@@ -1495,10 +1495,200 @@ static void ih264e_cabac_enc_mvds_p16x16(cabac_ctxt_t *ps_cabac_ctxt,
         /***************************************************************/
         pu1_top_mv_ctxt[0] = pu1_lft_mv_ctxt[0] = u1_abs_mvd_x;
         pu1_top_mv_ctxt[1] = pu1_lft_mv_ctxt[1] = u1_abs_mvd_y;
+
+        /* replicate for all the 4x4 columns and rows of the mb, as they
+         * are used by partitioned neighbors */
+        {
+            WORD32 i;
+
+            for (i = 1; i < 4; i++)
+            {
+                ps_cabac_ctxt->ps_curr_ctxt_mb_info->u1_mv[i][0] = u1_abs_mvd_x;
+                ps_cabac_ctxt->ps_curr_ctxt_mb_info->u1_mv[i][1] = u1_abs_mvd_y;
+                ps_cabac_ctxt->pu1_left_mv_ctxt_inc[i][0] = u1_abs_mvd_x;
+                ps_cabac_ctxt->pu1_left_mv_ctxt_inc[i][1] = u1_abs_mvd_y;
+            }
+        }
+    }
+}
+
+/**
+ *******************************************************************************
+ * @brief
+ * Encodes all motion vectors for a P16x8, P8x16 or P8x8 MB
+ *
+ * @param[in] ps_cabac_ctxt
+ *  Pointer to cabac context structure
+ *
+ * @param[in] pi2_mv_ptr
+ * Pointer to array of motion vectors
+ *
+ * @param[in] i4_mb_type
+ * mb type of the current mb
+ *
+ * @returns
+ *
+ * @remarks
+ *  The partitions are coded in decoding order, the mvd contexts of the 4x4
+ *  blocks inside the mb are updated as each partition is coded
+ *
+ *******************************************************************************
+ */
+static void ih264e_cabac_enc_mvds_p_mb_part(cabac_ctxt_t *ps_cabac_ctxt,
+                                            WORD16 *pi2_mv_ptr,
+                                            WORD32 i4_mb_type)
+{
+    /* partition geometry in 4x4 blocks, indexed by mb type - P16x8 */
+    static const UWORD8 au1_part_cnt[3] = { 2, 2, 4 };
+    static const UWORD8 au1_part_wd[3] = { 4, 2, 2 };
+    static const UWORD8 au1_part_ht[3] = { 2, 4, 2 };
+    static const UWORD8 au1_part_x[3][4] = { { 0, 0 }, { 0, 2 }, { 0, 2, 0, 2 } };
+    static const UWORD8 au1_part_y[3][4] = { { 0, 2 }, { 0, 0 }, { 0, 0, 2, 2 } };
+
+    UWORD8 (*pu1_top_mv_ctxt)[4] = ps_cabac_ctxt->ps_curr_ctxt_mb_info->u1_mv;
+    UWORD8 (*pu1_lft_mv_ctxt)[4] = ps_cabac_ctxt->pu1_left_mv_ctxt_inc;
+
+    /* abs mvds of the row of 4x4 blocks above the mb and of the mb */
+    UWORD8 au1_abs_mvd[5][4][2];
+
+    WORD32 i4_part = i4_mb_type - P16x8;
+    WORD32 i, j, k, x, y;
+    WORD16 i2_mvd_x, i2_mvd_y;
+    UWORD8 u1_abs_mvd_x, u1_abs_mvd_y;
+
+    for (j = 0; j < 4; j++)
+    {
+        au1_abs_mvd[0][j][0] = pu1_top_mv_ctxt[j][0];
+        au1_abs_mvd[0][j][1] = pu1_top_mv_ctxt[j][1];
+    }
+
+    for (k = 0; k < au1_part_cnt[i4_part]; k++)
+    {
+        UWORD16 u2_abs_mvd_x_a, u2_abs_mvd_x_b, u2_abs_mvd_y_a, u2_abs_mvd_y_b;
+
+        x = au1_part_x[i4_part][k];
+        y = au1_part_y[i4_part][k];
+
+        /* left neighbor of the top left 4x4 block of the partition */
+        if (x == 0)
+        {
+            u2_abs_mvd_x_a = pu1_lft_mv_ctxt[y][0];
+            u2_abs_mvd_y_a = pu1_lft_mv_ctxt[y][1];
+        }
+        else
+        {
+            u2_abs_mvd_x_a = au1_abs_mvd[y + 1][x - 1][0];
+            u2_abs_mvd_y_a = au1_abs_mvd[y + 1][x - 1][1];
+        }
+
+        /* top neighbor of the top left 4x4 block of the partition */
+        u2_abs_mvd_x_b = au1_abs_mvd[y][x][0];
+        u2_abs_mvd_y_b = au1_abs_mvd[y][x][1];
+
+        i2_mvd_x = *(pi2_mv_ptr++);
+        i2_mvd_y = *(pi2_mv_ptr++);
+
+        ih264e_cabac_enc_ctx_mvd(i2_mvd_x, MVD_X,
+                                 (UWORD16) (u2_abs_mvd_x_a + u2_abs_mvd_x_b),
+                                 ps_cabac_ctxt);
+
+        ih264e_cabac_enc_ctx_mvd(i2_mvd_y, MVD_Y,
+                                 (UWORD16) (u2_abs_mvd_y_a + u2_abs_mvd_y_b),
+                                 ps_cabac_ctxt);
+
+        u1_abs_mvd_x = CLIP3(0, 127, ABS(i2_mvd_x));
+        u1_abs_mvd_y = CLIP3(0, 127, ABS(i2_mvd_y));
+
+        for (i = y; i < y + au1_part_ht[i4_part]; i++)
+        {
+            for (j = x; j < x + au1_part_wd[i4_part]; j++)
+            {
+                au1_abs_mvd[i + 1][j][0] = u1_abs_mvd_x;
+                au1_abs_mvd[i + 1][j][1] = u1_abs_mvd_y;
+            }
+        }
+    }
+
+    /***************************************************************/
+    /* Store abs_mvd_values cabac contexts                         */
+    /***************************************************************/
+    for (j = 0; j < 4; j++)
+    {
+        pu1_top_mv_ctxt[j][0] = au1_abs_mvd[4][j][0];
+        pu1_top_mv_ctxt[j][1] = au1_abs_mvd[4][j][1];
+        pu1_lft_mv_ctxt[j][0] = au1_abs_mvd[j + 1][3][0];
+        pu1_lft_mv_ctxt[j][1] = au1_abs_mvd[j + 1][3][1];
     }
 }
 
 
+/**
+ *******************************************************************************
+ * @brief
+ * Encodes the L0 reference indices of all partitions of a P MB
+ *
+ * @param[in] ps_cabac_ctxt
+ *  Pointer to cabac context structure
+ *
+ * @param[in] i4_ref_idx
+ *  reference index shared by all partitions of the mb
+ *
+ * @param[in] i4_mb_type
+ *  mb type of the current mb
+ *
+ * @returns
+ *
+ * @remarks
+ *  ref_idx is unary binarized. The context of the first bin depends on the
+ *  left and top 8x8 neighbors having a non zero reference index (9.3.3.1.1.6)
+ *
+ *******************************************************************************
+ */
+static void ih264e_cabac_enc_ref_idx_p(cabac_ctxt_t *ps_cabac_ctxt,
+                                       WORD32 i4_ref_idx,
+                                       WORD32 i4_mb_type)
+{
+    /* partition geometry in 8x8 blocks, indexed by mb type - P16x16 */
+    static const UWORD8 au1_part_cnt[4] = { 1, 2, 2, 4 };
+    static const UWORD8 au1_part_x[4][4] = { { 0 }, { 0, 0 }, { 0, 1 }, { 0, 1, 0, 1 } };
+    static const UWORD8 au1_part_y[4][4] = { { 0 }, { 0, 1 }, { 0, 0 }, { 0, 0, 1, 1 } };
+
+    WORD8 *pi1_top_ref_ctxt = ps_cabac_ctxt->ps_curr_ctxt_mb_info->i1_ref_idx;
+    WORD8 *pi1_lft_ref_ctxt = ps_cabac_ctxt->pi1_left_ref_idx_ctxt_inc;
+
+    /* bins (lsb first) of the unary binarization and their ctxIdxIncs */
+    UWORD32 u4_bins = (1 << i4_ref_idx) - 1;
+    WORD8 i1_bins_len = (WORD8) (i4_ref_idx + 1);
+    WORD8 i1_ref_gt0 = (i4_ref_idx > 0);
+
+    WORD32 i4_part = i4_mb_type - P16x16;
+    WORD32 k, x, y;
+
+    for (k = 0; k < au1_part_cnt[i4_part]; k++)
+    {
+        UWORD32 u4_cond_a, u4_cond_b;
+
+        x = au1_part_x[i4_part][k];
+        y = au1_part_y[i4_part][k];
+
+        /* partitions inside the mb share the reference of the mb */
+        u4_cond_a = (x == 0) ? (pi1_lft_ref_ctxt[y] > 0) : i1_ref_gt0;
+        u4_cond_b = (y == 0) ? (pi1_top_ref_ctxt[x] > 0) : i1_ref_gt0;
+
+        ih264e_encode_decision_bins(u4_bins, i1_bins_len,
+                                    (u4_cond_a + 2 * u4_cond_b) | 0x540, 2,
+                                    ps_cabac_ctxt->au1_cabac_ctxt_table + REF_IDX,
+                                    ps_cabac_ctxt);
+    }
+
+    /***************************************************************/
+    /* Store ref_idx cabac contexts                                */
+    /***************************************************************/
+    pi1_top_ref_ctxt[0] = pi1_top_ref_ctxt[1] = i1_ref_gt0;
+    pi1_lft_ref_ctxt[0] = pi1_lft_ref_ctxt[1] = i1_ref_gt0;
+}
+
+
 /**
  *******************************************************************************
  * @brief
@@ -1896,6 +2086,8 @@ IH264E_ERROR_T ih264e_write_pslice_mb_cabac(entropy_ctxt_t *ps_ent_ctxt)
 
         memset(ps_curr_ctxt->u1_mv, 0, 16);
         memset(ps_cabac_ctxt->pu1_left_mv_ctxt_inc, 0, 16);
+        ps_curr_ctxt->i1_ref_idx[0] = ps_curr_ctxt->i1_ref_idx[1] = 0;
+        *((UWORD16 *) ps_cabac_ctxt->pi1_left_ref_idx_ctxt_inc) = 0;
         ps_cabac_ctxt->ps_curr_ctxt_mb_info->u1_cbp = (UWORD8) cbp;
 
         if (mb_type == I16x16)
@@ -1926,23 +2118,57 @@ IH264E_ERROR_T ih264e_write_pslice_mb_cabac(entropy_ctxt_t *ps_ent_ctxt)
             /* Encoding mb_skip */
             ih264e_cabac_enc_mb_skip(0, ps_cabac_ctxt, MB_SKIP_FLAG_P_SLICE);
 
-            /* Encoding mb_type as P16x16 */
+            /* Encoding mb_type */
             {
-                UWORD32 u4_ctx_inc_p;
-                u4_ctx_inc_p = (0x010 + ((2) << 8));
+                /* bins (lsb first) and ctxIdxIncs of P16x16, P16x8, P8x16 and P8x8 */
+                static const UWORD8 au1_mb_type_bins[4] = { 0, 6, 2, 4 };
+                static const UWORD16 au2_mb_type_ctx_inc[4] = { 0x210, 0x310, 0x310, 0x210 };
 
-                ih264e_encode_decision_bins(0, 3, u4_ctx_inc_p, 3,
+                ih264e_encode_decision_bins(au1_mb_type_bins[mb_type - P16x16], 3,
+                                            au2_mb_type_ctx_inc[mb_type - P16x16], 3,
                                             &(ps_cabac_ctxt->au1_cabac_ctxt_table[MB_TYPE_P_SLICE]),
                                             ps_cabac_ctxt);
             }
+
+            /* Encoding sub_mb_type as P_L0_8x8 */
+            if (mb_type == P8x8)
+            {
+                WORD32 i;
+
+                for (i = 0; i < 4; i++)
+                {
+                    ih264e_cabac_encode_bin(ps_cabac_ctxt, 1,
+                                            ps_cabac_ctxt->au1_cabac_ctxt_table
+                                                + SUB_MB_TYPE_P_SLICE);
+                }
+            }
+            /* Encoding ref_idx of the partitions */
+            if (ps_ent_ctxt->i4_num_ref_idx_l0_active > 1)
+            {
+                ih264e_cabac_enc_ref_idx_p(ps_cabac_ctxt, mb_tpm >> 4, mb_type);
+            }
+            else
+            {
+                ps_curr_ctxt->i1_ref_idx[0] = ps_curr_ctxt->i1_ref_idx[1] = 0;
+                *((UWORD16 *) ps_cabac_ctxt->pi1_left_ref_idx_ctxt_inc) = 0;
+            }
             ps_curr_ctxt->u1_mb_type = CAB_P;
             {
                 WORD16 *pi2_mv_ptr = (WORD16 *) pu1_byte;
-                byte_count += 4;
                 ps_curr_ctxt->u1_mb_type = (ps_curr_ctxt->u1_mb_type
                                             | CAB_NON_BD16x16);
-                 /* Encoding motion vector for P16x16 */
-                ih264e_cabac_enc_mvds_p16x16(ps_cabac_ctxt, pi2_mv_ptr);
+                if (mb_type == P16x16)
+                {
+                    byte_count += 4;
+                    /* Encoding motion vector for P16x16 */
+                    ih264e_cabac_enc_mvds_p16x16(ps_cabac_ctxt, pi2_mv_ptr);
+                }
+                else
+                {
+                    byte_count += (mb_type == P8x8) ? 16 : 8;
+                    /* Encoding motion vectors of the partitions */
+                    ih264e_cabac_enc_mvds_p_mb_part(ps_cabac_ctxt, pi2_mv_ptr, mb_type);
+                }
             }
             /* Encode CBP */
             ih264e_cabac_enc_cbp(cbp, ps_cabac_ctxt);
@@ -1970,6 +2196,8 @@ IH264E_ERROR_T ih264e_write_pslice_mb_cabac(entropy_ctxt_t *ps_ent_ctxt)
 
             memset(ps_curr_ctxt->u1_mv, 0, 16);
             memset(ps_cabac_ctxt->pu1_left_mv_ctxt_inc, 0, 16);
+            ps_curr_ctxt->i1_ref_idx[0] = ps_curr_ctxt->i1_ref_idx[1] = 0;
+            *((UWORD16 *) ps_cabac_ctxt->pi1_left_ref_idx_ctxt_inc) = 0;
             cbp = 0;
 
             /* Ending bitstream offset for header in bits */
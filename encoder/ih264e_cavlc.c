@@ -1404,6 +1404,33 @@ IH264E_ERROR_T ih264e_write_pslice_mb_cavlc(entropy_ctxt_t *ps_ent_ctxt)
         /* write mb type */
         PUT_BITS_UEV(ps_bitstream, mb_type - 3, error_status, "mb type");
 
+        /* sub mb types, all sub mbs are coded as P_L0_8x8 */
+        if (mb_type == P8x8)
+        {
+            for (i = 0; i < 4; i++)
+            {
+                PUT_BITS_UEV(ps_bitstream, 0, error_status, "sub mb type");
+            }
+        }
+
+        /* ref idx l0 of the partitions, te(v) coded */
+        if (ps_ent_ctxt->i4_num_ref_idx_l0_active > 1)
+        {
+            WORD32 ref_idx = mb_tpm >> 4;
+
+            for (i = 0; i < (WORD32)u4_part_cnt; i++)
+            {
+                if (ps_ent_ctxt->i4_num_ref_idx_l0_active == 2)
+                {
+                    PUT_BITS(ps_bitstream, !ref_idx, 1, error_status, "ref idx l0");
+                }
+                else
+                {
+                    PUT_BITS_UEV(ps_bitstream, ref_idx, error_status, "ref idx l0");
+                }
+            }
+        }
+
         for (i = 0; i < (WORD32)u4_part_cnt; i++)
         {
             PUT_BITS_SEV(ps_bitstream, *pi2_mv_ptr++, error_status, "mv x");
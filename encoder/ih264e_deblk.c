@@ -81,6 +81,7 @@
 #include "ih264_trans_data.h"
 #include "ih264_deblk_tables.h"
 #include "ih264e_deblk.h"
+#include "ih264e_me.h"
 
 
 /*****************************************************************************/
@@ -333,6 +334,135 @@ static void ih264e_fill_bs_1mv_1ref_non_mbaff(UWORD32 *pu4_horz_bs,
     }
 }
 
+/**
+*******************************************************************************
+*
+* @brief updates the bs of an edge segment with the mv difference across it
+*
+* @par Description:
+*  The bs of an edge segment without coded coefficients is set to 1 if the
+*  blocks on either side of it use different reference pictures or if their
+*  mvs differ by 4 or more in units of quarter pel, else 0
+*
+* @param[in] u4_bs
+*  bs of the edge
+*
+* @param[in] i4_seg
+*  index of the 4 pel segment of the edge
+*
+* @param[in] ps_p_pu
+*  pu on the left / top side of the segment
+*
+* @param[in] ps_q_pu
+*  pu on the right / bottom side of the segment
+*
+* @returns  updated bs of the edge
+*
+* @remarks  Assumes a P slice, the pus are predicted from list 0
+*
+*******************************************************************************
+*/
+static UWORD32 ih264e_update_bs_mv(UWORD32 u4_bs,
+                                   WORD32 i4_seg,
+                                   enc_pu_t *ps_p_pu,
+                                   enc_pu_t *ps_q_pu)
+{
+    WORD32 i4_shift = 24 - (i4_seg << 3);
+
+    if (((u4_bs >> i4_shift) & 0xFF) < 2)
+    {
+        mv_t *ps_p_mv = &ps_p_pu->s_me_info[PRED_L0].s_mv;
+        mv_t *ps_q_mv = &ps_q_pu->s_me_info[PRED_L0].s_mv;
+
+        UWORD32 u4_flag = (ABS(ps_p_mv->i2_mvx - ps_q_mv->i2_mvx) >= 4)
+                        | (ABS(ps_p_mv->i2_mvy - ps_q_mv->i2_mvy) >= 4)
+                        | (ps_p_pu->s_me_info[PRED_L0].i1_ref_idx
+                                        != ps_q_pu->s_me_info[PRED_L0].i1_ref_idx);
+
+        u4_bs &= ~(0xFFu << i4_shift);
+        u4_bs |= u4_flag << i4_shift;
+    }
+
+    return u4_bs;
+}
+
+/**
+*******************************************************************************
+*
+* @brief computes the mv based bs of a P mb with sub mb partitions
+*
+* @par Description:
+*  ih264e_fill_bs_1mv_1ref_non_mbaff() uses a single pu per mb. For the mb
+*  edges, the segments that border other 8x8 blocks of the neighbors and the
+*  internal 8x8 edges are updated here with the pus covering them
+*
+* @param[in] ps_proc
+*  process context
+*
+* @param[out] pu4_horz_bs
+*  horizontal bs of the mb
+*
+* @param[out] pu4_vert_bs
+*  vertical bs of the mb
+*
+* @param[in] i4_left_inter
+*  left mb is available and inter coded
+*
+* @param[in] i4_top_inter
+*  top mb is available and inter coded
+*
+* @returns  none
+*
+* @remarks  none
+*
+*******************************************************************************
+*/
+static void ih264e_fill_bs_mb_part(process_ctxt_t *ps_proc,
+                                   UWORD32 *pu4_horz_bs,
+                                   UWORD32 *pu4_vert_bs,
+                                   WORD32 i4_left_inter,
+                                   WORD32 i4_top_inter)
+{
+    /* pus of the current, left and top mbs */
+    enc_pu_t *ps_cur_pu = ps_proc->ps_pu;
+    enc_pu_t *ps_left_pu = ps_proc->ps_pu - ENC_MAX_PU_IN_MB;
+    enc_pu_t *ps_top_pu = ps_proc->ps_top_row_pu_ME
+                    + ps_proc->s_deblk_ctxt.s_bs_ctxt.i4_mb_x * ENC_MAX_PU_IN_MB;
+
+    /* temp var */
+    WORD32 i4_seg, i4_blk;
+
+    for (i4_seg = 0; i4_seg < 4; i4_seg++)
+    {
+        i4_blk = i4_seg >> 1;
+
+        /* top mb edge */
+        if (i4_top_inter)
+        {
+            pu4_horz_bs[0] = ih264e_update_bs_mv(pu4_horz_bs[0], i4_seg,
+                                                 ih264e_get_8x8_blk_pu(ps_top_pu, i4_blk, 1),
+                                                 ih264e_get_8x8_blk_pu(ps_cur_pu, i4_blk, 0));
+        }
+
+        /* left mb edge */
+        if (i4_left_inter)
+        {
+            pu4_vert_bs[0] = ih264e_update_bs_mv(pu4_vert_bs[0], i4_seg,
+                                                 ih264e_get_8x8_blk_pu(ps_left_pu, 1, i4_blk),
+                                                 ih264e_get_8x8_blk_pu(ps_cur_pu, 0, i4_blk));
+        }
+
+        /* internal 8x8 edges */
+        pu4_horz_bs[2] = ih264e_update_bs_mv(pu4_horz_bs[2], i4_seg,
+                                             ih264e_get_8x8_blk_pu(ps_cur_pu, i4_blk, 0),
+                                             ih264e_get_8x8_blk_pu(ps_cur_pu, i4_blk, 1));
+
+        pu4_vert_bs[2] = ih264e_update_bs_mv(pu4_vert_bs[2], i4_seg,
+                                             ih264e_get_8x8_blk_pu(ps_cur_pu, 0, i4_blk),
+                                             ih264e_get_8x8_blk_pu(ps_cur_pu, 1, i4_blk));
+    }
+}
+
 /**
 *******************************************************************************
 *
@@ -470,6 +600,14 @@ void ih264e_compute_bs(process_ctxt_t * ps_proc)
                                           &ps_proc->s_left_mb_pu,
                                           ps_top_row_pu,
                                           ps_proc->ps_pu);
+
+        /* bs of the edges between the 8x8 blocks of sub mb partitions */
+        if (ps_proc->i4_slice_type == PSLICE)
+        {
+            ih264e_fill_bs_mb_part(ps_proc, pu4_pic_horz_bs, pu4_pic_vert_bs,
+                                   (i4_mb_x > 0) && !ps_left_mb_syntax_ele->u2_is_intra,
+                                   (i4_mb_y > 0) && !ps_top_mb_syntax_ele->u2_is_intra);
+        }
     }
 
     return ;
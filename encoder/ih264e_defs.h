@@ -116,13 +116,32 @@
 #define HP_BUFF_WD  24
 #define HP_BUFF_HT  18
 
+/*
+ * number of buffers used by the joint L0/L1 refinement of bipred
+ */
+#define BIPRED_BUFF_CNT  7
+
+/*
+ * number of alternating L1/L0 passes of the bipred refinement
+ */
+#define BIPRED_REFINE_ITERS  2
+
 /*****************************************************************************/
 /* Number of frame restrictions                                              */
 /*****************************************************************************/
 /**
- *  Maximum number of reference pictures
+ *  Maximum number of reference pictures, limited by the level's dpb size
+ */
+#define MAX_REF_PIC_CNT  16
+
+/**
+ *  Maximum number of active L0 references of a P slice with the CONFIG
+ *  preset. The other presets use one, with their mb partitions and qpel
+ *  the additional references cost more in ref_idx bits than they save.
+ *  The reference pictures beyond the active count are retained in the dpb
+ *  but not searched
  */
-#define MAX_REF_PIC_CNT  2
+#define MAX_NUM_REF_IDX_L0_ACTIVE  4
 
 /**
  *  Minimum number of reference pictures
@@ -142,7 +161,13 @@
 /*****************************************************************************/
 /* Minimum size of inter prediction unit supported by encoder                */
 /*****************************************************************************/
-#define ENC_MIN_PU_SIZE     16
+#define ENC_MIN_PU_SIZE     8
+
+/*****************************************************************************/
+/* Maximum number of inter prediction units in a macroblock. The mv bank      */
+/* reserves these many entries per MB irrespective of the partition chosen   */
+/*****************************************************************************/
+#define ENC_MAX_PU_IN_MB    ((MB_SIZE * MB_SIZE) / (ENC_MIN_PU_SIZE * ENC_MIN_PU_SIZE))
 
 /*****************************************************************************/
 /* Num cores releated defs                                                   */
@@ -244,6 +269,8 @@
 #define DEFAULT_PRE_ENC_ME              0
 #define DEFAULT_PRE_ENC_IPE             0
 #define DEFAULT_ENTROPY_CODING_MODE     0
+#define DEFAULT_ADAPTIVE_BFRAMES        0
+#define DEFAULT_SCENE_CUT_FRM_TYPE      IV_NA_FRAME
 
 /** Maximum number of entries in input buffer list */
 #define MAX_INP_BUF_LIST_ENTRIES         32
@@ -257,9 +284,46 @@
 /** Number of buffers created to hold half-pel planes for every reference buffer */
 #define HPEL_PLANES_CNT                 1
 
+/** Number of downsampled luma planes (1/4 and 1/16 resolution) used by pre-enc ME */
+#define PYR_LEVELS_CNT                  2
+
+/** Weight of the MV deviation from the MV predictor in the 1/16 and 1/4 resolution searches of pre-enc ME */
+#define PYR_ME_MV_COST_WT_L2            24
+#define PYR_ME_MV_COST_WT_L1            16
+
 /** Number of buffers Needed for SUBPEL and BIPRED computation */
 #define SUBPEL_BUFF_CNT                 4
 
+/** Number of pictures held by the lookahead: a sub gop and the reference before it */
+#define LOOKAHEAD_BUF_CNT               (MAX_NUM_BFRAMES + 2)
+
+/** Search range of the lookahead cost estimation (in 1/16 resolution pels) per frame of distance, and its cap */
+#define LOOKAHEAD_SRCH_RNG              4
+#define LOOKAHEAD_MAX_SRCH_RNG          8
+
+/** Floor of the intra cost of a MB (a 4x4 block at 1/16 resolution) in the lookahead */
+#define LOOKAHEAD_MIN_INTRA_COST        16
+
+/**
+ * Rise of the inter cost of a picture above the running average, in percent
+ * of the headroom left up to the intra cost, above which the picture is a
+ * scene cut, and below which detection resumes after a scene cut
+ */
+#define LOOKAHEAD_SCENE_CUT_PCT         40
+#define LOOKAHEAD_SCENE_CUT_RELEASE_PCT 20
+
+/** Weight of the history in the running average of the inter cost, as a power of 2 */
+#define LOOKAHEAD_AVG_WT_SHIFT          2
+
+/**
+ * Rise of the inter cost across a run of B pictures above the inter cost from
+ * the adjacent picture, in percent of the headroom left up to the intra cost,
+ * above which the run is ended by a P picture, and its decrease per B picture
+ * in the run
+ */
+#define LOOKAHEAD_BFRAME_PCT            40
+#define LOOKAHEAD_BFRAME_BIAS_PCT       5
+
 /**
  *****************************************************************************
  * Macro to compute total size required to hold on set of scaling matrices
@@ -459,6 +523,11 @@ enum
      */
     MEM_REC_MB_INFO_NMB,
 
+    /**
+     * Holds the 1/16 resolution luma planes of the lookahead
+     */
+    MEM_REC_LOOKAHEAD,
+
     /**
      * Rate control of memory records.
      */
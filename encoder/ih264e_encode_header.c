@@ -904,14 +904,18 @@ IH264E_ERROR_T ih264e_populate_sps(codec_t *ps_codec, sps_t *ps_sps)
     }
 
     /* num_ref_frames */
-    /* TODO : Should we have a flexible num ref frames */
-    if (ps_codec->s_cfg.u4_num_bframes > 0)
+    /* honour the configured reference count within the dpb size of the level */
     {
-        ps_sps->u1_max_num_ref_frames = 2;
-    }
-    else
-    {
-        ps_sps->u1_max_num_ref_frames = 1;
+        WORD32 i4_num_ref_frames = ps_cfg->u4_max_ref_cnt;
+        WORD32 i4_min_ref_frames = (ps_cfg->u4_num_bframes > 0) ? 2 : 1;
+        WORD32 i4_dpb_size = ih264e_get_dpb_size(ps_sps->u1_level_idc,
+                                                 ps_cfg->u4_max_wd * ps_cfg->u4_max_ht);
+
+        i4_num_ref_frames = MIN(i4_num_ref_frames, i4_dpb_size);
+        i4_num_ref_frames = MIN(i4_num_ref_frames, MAX_REF_PIC_CNT);
+        i4_num_ref_frames = MAX(i4_num_ref_frames, i4_min_ref_frames);
+
+        ps_sps->u1_max_num_ref_frames = i4_num_ref_frames;
     }
 
     /* gaps_in_frame_num_value_allowed_flag */
@@ -1158,10 +1162,19 @@ WORD32 ih264e_populate_slice_header(process_ctxt_t *ps_proc,
     {
         /* num_ref_idx_active_override_flag */
         ps_slice_hdr->u1_num_ref_idx_active_override_flag = 0;
+        ps_slice_hdr->i1_num_ref_idx_l0_active = ps_pps->i1_num_ref_idx_l0_default_active;
+        ps_slice_hdr->i1_num_ref_idx_l1_active = ps_pps->i1_num_ref_idx_l1_default_active;
+
+        if (ps_proc->i4_slice_type != BSLICE &&
+            ps_proc->i4_num_ref_idx_l0_active != ps_pps->i1_num_ref_idx_l0_default_active)
+        {
+            ps_slice_hdr->u1_num_ref_idx_active_override_flag = 1;
+        }
 
         if (ps_slice_hdr->u1_num_ref_idx_active_override_flag)
         {
             /* num_ref_idx_l0_active_minus1 */
+            ps_slice_hdr->i1_num_ref_idx_l0_active = ps_proc->i4_num_ref_idx_l0_active;
 
             if (ps_proc->i4_slice_type == BSLICE)
             {
@@ -226,6 +226,15 @@ typedef enum
     /**Invalid entropy coding mode */
     IH264E_INVALID_ENTROPY_CODING_MODE                              = IH264E_CODEC_ERROR_START + 0x31,
 
+    /**Invalid pre-enc motion estimation option */
+    IH264E_INVALID_PRE_ENC_ME_OPTION                                = IH264E_CODEC_ERROR_START + 0x32,
+
+    /**Invalid adaptive B frame placement option */
+    IH264E_INVALID_ADAPTIVE_BFRAMES_OPTION                          = IH264E_CODEC_ERROR_START + 0x33,
+
+    /**Invalid frame type for scene cuts */
+    IH264E_INVALID_SCENE_CUT_FRAME_TYPE                             = IH264E_CODEC_ERROR_START + 0x34,
+
     /**max failure error code to ensure enum is 32 bits wide */
     IH264E_FAIL                                                     = -1,
 
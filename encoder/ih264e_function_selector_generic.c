@@ -216,6 +216,23 @@ void ih264e_init_function_ptr_generic(codec_t *ps_codec)
     ps_codec->pf_inter_pred_luma_bilinear = ih264_inter_pred_luma_bilinear;
     ps_codec->pf_inter_pred_chroma = ih264_inter_pred_chroma;
 
+    ps_codec->apf_inter_pred_luma[0] = ih264_inter_pred_luma_copy;
+    ps_codec->apf_inter_pred_luma[1] = ih264_inter_pred_luma_horz_qpel;
+    ps_codec->apf_inter_pred_luma[2] = ih264_inter_pred_luma_horz;
+    ps_codec->apf_inter_pred_luma[3] = ih264_inter_pred_luma_horz_qpel;
+    ps_codec->apf_inter_pred_luma[4] = ih264_inter_pred_luma_vert_qpel;
+    ps_codec->apf_inter_pred_luma[5] = ih264_inter_pred_luma_horz_qpel_vert_qpel;
+    ps_codec->apf_inter_pred_luma[6] = ih264_inter_pred_luma_horz_hpel_vert_qpel;
+    ps_codec->apf_inter_pred_luma[7] = ih264_inter_pred_luma_horz_qpel_vert_qpel;
+    ps_codec->apf_inter_pred_luma[8] = ih264_inter_pred_luma_vert;
+    ps_codec->apf_inter_pred_luma[9] = ih264_inter_pred_luma_horz_qpel_vert_hpel;
+    ps_codec->apf_inter_pred_luma[10] = ih264_inter_pred_luma_horz_hpel_vert_hpel;
+    ps_codec->apf_inter_pred_luma[11] = ih264_inter_pred_luma_horz_qpel_vert_hpel;
+    ps_codec->apf_inter_pred_luma[12] = ih264_inter_pred_luma_vert_qpel;
+    ps_codec->apf_inter_pred_luma[13] = ih264_inter_pred_luma_horz_qpel_vert_qpel;
+    ps_codec->apf_inter_pred_luma[14] = ih264_inter_pred_luma_horz_hpel_vert_qpel;
+    ps_codec->apf_inter_pred_luma[15] = ih264_inter_pred_luma_horz_qpel_vert_qpel;
+
     /* sad me level functions */
     ps_codec->apf_compute_sad_16x16[0] = ime_compute_sad_16x16;
     ps_codec->apf_compute_sad_16x16[1] = ime_compute_sad_16x16_fast;
@@ -236,9 +253,11 @@ void ih264e_init_function_ptr_generic(codec_t *ps_codec)
         ps_me_ctxt->pf_ime_compute_sad_16x16[0] = ime_compute_sad_16x16;
         ps_me_ctxt->pf_ime_compute_sad_16x16[1] = ime_compute_sad_16x16_fast;
         ps_me_ctxt->pf_ime_compute_sad_16x8 = ime_compute_sad_16x8;
+        ps_me_ctxt->pf_ime_compute_sad_8x8 = ime_compute_sad_8x8;
         ps_me_ctxt->pf_ime_compute_sad4_diamond = ime_calculate_sad4_prog;
         ps_me_ctxt->pf_ime_compute_sad3_diamond = ime_calculate_sad3_prog;
         ps_me_ctxt->pf_ime_compute_sad2_diamond = ime_calculate_sad2_prog;
+        ps_me_ctxt->pf_ime_compute_sad8_horz = ime_calculate_sad8_horz;
         ps_me_ctxt->pf_ime_sub_pel_compute_sad_16x16 = ime_sub_pel_compute_sad_16x16;
         ps_me_ctxt->pf_ime_compute_sad_stat_luma_16x16 = ime_compute_satqd_16x16_lumainter;
     }
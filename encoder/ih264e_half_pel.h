@@ -94,6 +94,7 @@ ih264e_sixtapfilter_horz_ft ih264e_sixtapfilter_horz_av8;
 
 /* x86 intrinsics*/
 ih264e_sixtapfilter_horz_ft ih264e_sixtapfilter_horz_ssse3;
+ih264e_sixtapfilter_horz_ft ih264e_sixtapfilter_horz_avx2;
 
 /**
 *******************************************************************************
@@ -158,5 +159,6 @@ ih264e_sixtap_filter_2dvh_vert_ft ih264e_sixtap_filter_2dvh_vert_av8;
 
 /* x86 intrinsics */
 ih264e_sixtap_filter_2dvh_vert_ft ih264e_sixtap_filter_2dvh_vert_ssse3;
+ih264e_sixtap_filter_2dvh_vert_ft ih264e_sixtap_filter_2dvh_vert_avx2;
 
 #endif /* IH264E_HALF_PEL_H_ */
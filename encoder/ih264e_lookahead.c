@@ -0,0 +1,887 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+
+/**
+*******************************************************************************
+* @file
+*  ih264e_lookahead.c
+*
+* @brief
+*  Contains the lookahead used for adaptive B frame placement and scene cut
+*  detection
+*
+* @author
+*  ittiam
+*
+* @par List of Functions:
+*  - ih264e_lookahead_get_pic()
+*  - ih264e_lookahead_downsample()
+*  - ih264e_lookahead_blk_intra_cost()
+*  - ih264e_lookahead_intra_cost()
+*  - ih264e_lookahead_subpel_sad()
+*  - ih264e_lookahead_inter_cost()
+*  - ih264e_lookahead_init()
+*  - ih264e_lookahead_add_pic()
+*  - ih264e_lookahead_place_b_pics()
+*  - ih264e_lookahead_decide_pic_types()
+*  - ih264e_lookahead_update_pic_type()
+*
+* @remarks
+*  The lookahead works on the pictures buffered in the input queue for B frame
+*  reordering. When a sub gop is about to be dequeued, all of its pictures are
+*  in the queue, so the restructuring of the sub gop adds no delay.
+*
+*******************************************************************************
+*/
+
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+/* system include files */
+#include <stdio.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+/* user include files */
+#include "ih264_typedefs.h"
+#include "iv2.h"
+#include "ive2.h"
+#include "ih264e.h"
+#include "ithread.h"
+#include "ih264_defs.h"
+#include "ih264_size_defs.h"
+#include "ime_distortion_metrics.h"
+#include "ime_defs.h"
+#include "ime_structs.h"
+#include "ih264_error.h"
+#include "ih264_structs.h"
+#include "ih264_trans_quant_itrans_iquant.h"
+#include "ih264_inter_pred_filters.h"
+#include "ih264_mem_fns.h"
+#include "ih264_padding.h"
+#include "ih264_intra_pred_filters.h"
+#include "ih264_deblk_edge_filters.h"
+#include "ih264_cabac_tables.h"
+#include "ih264_macros.h"
+#include "ih264e_defs.h"
+#include "ih264e_error.h"
+#include "ih264e_bitstream.h"
+#include "irc_cntrl_param.h"
+#include "irc_frame_info_collector.h"
+#include "ih264e_rate_control.h"
+#include "ih264e_cabac_structs.h"
+#include "ih264e_structs.h"
+#include "irc_mem_req_and_acq.h"
+#include "irc_rate_control_api.h"
+#include "ih264e_lookahead.h"
+
+/*****************************************************************************/
+/* Function Definitions                                                      */
+/*****************************************************************************/
+
+/**
+*******************************************************************************
+*
+* @brief Returns the lookahead entry of a picture
+*
+* @param[in] ps_lookahead
+*  Pointer to lookahead context
+*
+* @param[in] i4_pic_id
+*  Id of the picture
+*
+* @returns  Pointer to the entry, NULL if the picture is not in the lookahead
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static lookahead_pic_t *ih264e_lookahead_get_pic(lookahead_ctxt_t *ps_lookahead,
+                                                 WORD32 i4_pic_id)
+{
+    WORD32 i;
+
+    if (i4_pic_id < 0)
+        return NULL;
+
+    for (i = 0; i < LOOKAHEAD_BUF_CNT; i++)
+    {
+        if (ps_lookahead->as_pics[i].i4_pic_id == i4_pic_id)
+            return &ps_lookahead->as_pics[i];
+    }
+
+    return NULL;
+}
+
+/**
+*******************************************************************************
+*
+* @brief Forms the 1/16 resolution luma plane of an input picture
+*
+* @par Description:
+*  Each output pel is the rounded average of a 4x4 block of the input. Pels
+*  outside the display area are replicated from its right and bottom edges.
+*
+* @param[in] ps_codec
+*  Pointer to codec context
+*
+* @param[in] ps_inp_buf
+*  Pointer to the input buffer
+*
+* @param[out] pu1_dst
+*  Pointer to the 1/16 resolution plane
+*
+* @returns  none
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static void ih264e_lookahead_downsample(codec_t *ps_codec,
+                                        inp_buf_t *ps_inp_buf,
+                                        UWORD8 *pu1_dst)
+{
+    lookahead_ctxt_t *ps_lookahead = &ps_codec->s_lookahead;
+    UWORD8 *pu1_src = ps_inp_buf->s_raw_buf.apv_bufs[0];
+    WORD32 i4_src_strd = ps_inp_buf->s_raw_buf.au4_strd[0];
+    WORD32 i4_disp_wd = ps_codec->s_cfg.u4_disp_wd;
+    WORD32 i4_disp_ht = ps_codec->s_cfg.u4_disp_ht;
+    UWORD8 *apu1_src_row[4];
+    WORD32 i, j, k, l;
+
+    for (i = 0; i < ps_lookahead->i4_ht; i++)
+    {
+        for (k = 0; k < 4; k++)
+        {
+            apu1_src_row[k] = pu1_src
+                            + MIN(4 * i + k, i4_disp_ht - 1) * i4_src_strd;
+        }
+
+        for (j = 0; j < ps_lookahead->i4_wd; j++)
+        {
+            WORD32 i4_sum = 8;
+
+            for (l = 0; l < 4; l++)
+            {
+                WORD32 i4_x = MIN(4 * j + l, i4_disp_wd - 1);
+
+                for (k = 0; k < 4; k++)
+                {
+                    i4_sum += apu1_src_row[k][i4_x];
+                }
+            }
+
+            pu1_dst[j] = i4_sum >> 4;
+        }
+
+        pu1_dst += ps_lookahead->i4_wd;
+    }
+}
+
+/**
+*******************************************************************************
+*
+* @brief Intra cost estimate of a 4x4 block of a 1/16 resolution plane
+*
+* @par Description:
+*  Sum of absolute deviations of the block from its mean, floored to
+*  LOOKAHEAD_MIN_INTRA_COST so that flat blocks do not dominate the ratios
+*
+* @param[in] pu1_blk
+*  Pointer to the block
+*
+* @param[in] i4_strd
+*  Stride of the plane
+*
+* @returns  intra cost of the block
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static WORD32 ih264e_lookahead_blk_intra_cost(UWORD8 *pu1_blk, WORD32 i4_strd)
+{
+    WORD32 i4_blk_size = MB_SIZE >> 2;
+    WORD32 i4_sum = 0, i4_cost = 0, i4_mean;
+    WORD32 i, j;
+
+    for (i = 0; i < i4_blk_size; i++)
+    {
+        for (j = 0; j < i4_blk_size; j++)
+        {
+            i4_sum += pu1_blk[i * i4_strd + j];
+        }
+    }
+
+    i4_mean = (i4_sum + ((i4_blk_size * i4_blk_size) >> 1))
+                    / (i4_blk_size * i4_blk_size);
+
+    for (i = 0; i < i4_blk_size; i++)
+    {
+        for (j = 0; j < i4_blk_size; j++)
+        {
+            i4_cost += ABS(pu1_blk[i * i4_strd + j] - i4_mean);
+        }
+    }
+
+    return MAX(i4_cost, LOOKAHEAD_MIN_INTRA_COST);
+}
+
+/**
+*******************************************************************************
+*
+* @brief Intra cost estimate of a picture in the lookahead
+*
+* @param[in] ps_lookahead
+*  Pointer to lookahead context
+*
+* @param[in] ps_pic
+*  Picture whose cost is estimated
+*
+* @returns  intra cost of the picture
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static WORD32 ih264e_lookahead_intra_cost(lookahead_ctxt_t *ps_lookahead,
+                                          lookahead_pic_t *ps_pic)
+{
+    WORD32 i4_blk_size = MB_SIZE >> 2;
+    WORD32 i4_wd = ps_lookahead->i4_wd;
+    WORD32 i4_cost = 0;
+    WORD32 x, y;
+
+    for (y = 0; y < ps_lookahead->i4_ht; y += i4_blk_size)
+    {
+        for (x = 0; x < i4_wd; x += i4_blk_size)
+        {
+            i4_cost += ih264e_lookahead_blk_intra_cost(
+                            ps_pic->pu1_luma + y * i4_wd + x, i4_wd);
+        }
+    }
+
+    return i4_cost;
+}
+
+/**
+*******************************************************************************
+*
+* @brief SAD of a 4x4 block of a 1/16 resolution plane against a quarter pel
+* position of a reference plane
+*
+* @par Description:
+*  The reference block is interpolated bilinearly from the 5x5 block of full
+*  pels at its top left corner
+*
+* @param[in] pu1_cur
+*  Pointer to the block
+*
+* @param[in] pu1_ref
+*  Pointer to the full pel of the reference at the top left of the position
+*
+* @param[in] i4_strd
+*  Stride of the planes
+*
+* @param[in] i4_frac_x
+*  Horizontal quarter pel offset of the position, 0 to 3
+*
+* @param[in] i4_frac_y
+*  Vertical quarter pel offset of the position, 0 to 3
+*
+* @returns  SAD of the block
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static WORD32 ih264e_lookahead_subpel_sad(UWORD8 *pu1_cur,
+                                          UWORD8 *pu1_ref,
+                                          WORD32 i4_strd,
+                                          WORD32 i4_frac_x,
+                                          WORD32 i4_frac_y)
+{
+    WORD32 i4_blk_size = MB_SIZE >> 2;
+    WORD32 i4_wt_a = (4 - i4_frac_x) * (4 - i4_frac_y);
+    WORD32 i4_wt_b = i4_frac_x * (4 - i4_frac_y);
+    WORD32 i4_wt_c = (4 - i4_frac_x) * i4_frac_y;
+    WORD32 i4_wt_d = i4_frac_x * i4_frac_y;
+    WORD32 i4_sad = 0;
+    WORD32 i, j;
+
+    for (i = 0; i < i4_blk_size; i++)
+    {
+        for (j = 0; j < i4_blk_size; j++)
+        {
+            UWORD8 *pu1_pel = pu1_ref + i * i4_strd + j;
+            WORD32 i4_pred = (i4_wt_a * pu1_pel[0] + i4_wt_b * pu1_pel[1]
+                            + i4_wt_c * pu1_pel[i4_strd]
+                            + i4_wt_d * pu1_pel[i4_strd + 1] + 8) >> 4;
+
+            i4_sad += ABS(pu1_cur[i * i4_strd + j] - i4_pred);
+        }
+    }
+
+    return i4_sad;
+}
+
+/**
+*******************************************************************************
+*
+* @brief Inter cost estimate of a picture predicted from another picture of
+* the lookahead
+*
+* @par Description:
+*  Every 4x4 block (one MB at full resolution) is searched exhaustively in the
+*  given range of the reference plane, and the best full pel is refined to
+*  half and then quarter pel. A pel of the plane spans four pels of the
+*  picture, so without the refinement any motion that is not a multiple of
+*  four pels is costed as a mismatch, and a pan looks almost as expensive as
+*  a new scene. The cost of a block is the smaller of its best SAD and its
+*  intra cost, as the encoder would code it intra otherwise.
+*
+* @param[in] ps_lookahead
+*  Pointer to lookahead context
+*
+* @param[in] ps_ref
+*  Reference picture
+*
+* @param[in] ps_cur
+*  Picture whose cost is estimated
+*
+* @param[in] i4_srch_rng
+*  Search range in 1/16 resolution pels
+*
+* @returns  inter cost of the picture
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static WORD32 ih264e_lookahead_inter_cost(lookahead_ctxt_t *ps_lookahead,
+                                          lookahead_pic_t *ps_ref,
+                                          lookahead_pic_t *ps_cur,
+                                          WORD32 i4_srch_rng)
+{
+    WORD32 i4_blk_size = MB_SIZE >> 2;
+    WORD32 i4_wd = ps_lookahead->i4_wd;
+    WORD32 i4_ht = ps_lookahead->i4_ht;
+    WORD32 i4_cost = 0;
+    WORD32 x, y, i4_ref_x, i4_ref_y, i, j;
+    WORD32 i4_best_x, i4_best_y, i4_step, i4_qpel_x, i4_qpel_y, i4_sad;
+
+    for (y = 0; y < i4_ht; y += i4_blk_size)
+    {
+        WORD32 i4_y0 = MAX(y - i4_srch_rng, 0);
+        WORD32 i4_y1 = MIN(y + i4_srch_rng, i4_ht - i4_blk_size);
+
+        for (x = 0; x < i4_wd; x += i4_blk_size)
+        {
+            WORD32 i4_x0 = MAX(x - i4_srch_rng, 0);
+            WORD32 i4_x1 = MIN(x + i4_srch_rng, i4_wd - i4_blk_size);
+            UWORD8 *pu1_cur = ps_cur->pu1_luma + y * i4_wd + x;
+            WORD32 i4_min_sad = INT_MAX;
+
+            i4_best_x = x;
+            i4_best_y = y;
+
+            for (i4_ref_y = i4_y0; i4_ref_y <= i4_y1; i4_ref_y++)
+            {
+                for (i4_ref_x = i4_x0; i4_ref_x <= i4_x1; i4_ref_x++)
+                {
+                    UWORD8 *pu1_ref = ps_ref->pu1_luma + i4_ref_y * i4_wd
+                                    + i4_ref_x;
+
+                    i4_sad = 0;
+                    for (i = 0; i < i4_blk_size; i++)
+                    {
+                        for (j = 0; j < i4_blk_size; j++)
+                        {
+                            i4_sad += ABS(pu1_cur[i * i4_wd + j]
+                                          - pu1_ref[i * i4_wd + j]);
+                        }
+                    }
+
+                    if (i4_sad < i4_min_sad)
+                    {
+                        i4_min_sad = i4_sad;
+                        i4_best_x = i4_ref_x;
+                        i4_best_y = i4_ref_y;
+                    }
+                }
+            }
+
+            /* half and quarter pel refinement, positions in quarter pels */
+            i4_best_x <<= 2;
+            i4_best_y <<= 2;
+            for (i4_step = 2; i4_step >= 1; i4_step >>= 1)
+            {
+                WORD32 i4_ctr_x = i4_best_x;
+                WORD32 i4_ctr_y = i4_best_y;
+
+                for (i = -i4_step; i <= i4_step; i += i4_step)
+                {
+                    for (j = -i4_step; j <= i4_step; j += i4_step)
+                    {
+                        i4_qpel_x = i4_ctr_x + j;
+                        i4_qpel_y = i4_ctr_y + i;
+
+                        /* the interpolation reads one more full pel to the right and below */
+                        if ((i == 0 && j == 0) || (i4_qpel_x < 0) || (i4_qpel_y < 0)
+                                        || (i4_qpel_x >> 2) + i4_blk_size >= i4_wd
+                                        || (i4_qpel_y >> 2) + i4_blk_size >= i4_ht)
+                        {
+                            continue;
+                        }
+
+                        i4_sad = ih264e_lookahead_subpel_sad(
+                                        pu1_cur,
+                                        ps_ref->pu1_luma + (i4_qpel_y >> 2) * i4_wd
+                                                        + (i4_qpel_x >> 2),
+                                        i4_wd, i4_qpel_x & 3, i4_qpel_y & 3);
+
+                        if (i4_sad < i4_min_sad)
+                        {
+                            i4_min_sad = i4_sad;
+                            i4_best_x = i4_qpel_x;
+                            i4_best_y = i4_qpel_y;
+                        }
+                    }
+                }
+            }
+
+            i4_cost += MIN(i4_min_sad,
+                           ih264e_lookahead_blk_intra_cost(pu1_cur, i4_wd));
+        }
+    }
+
+    return i4_cost;
+}
+
+/**
+*******************************************************************************
+*
+* @brief Resets the lookahead
+*
+* @par Description:
+*  Marks all the pictures of the lookahead unused
+*
+* @param[in] ps_codec
+*  Pointer to codec context
+*
+* @returns  none
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+void ih264e_lookahead_init(codec_t *ps_codec)
+{
+    lookahead_ctxt_t *ps_lookahead = &ps_codec->s_lookahead;
+    WORD32 i;
+
+    for (i = 0; i < LOOKAHEAD_BUF_CNT; i++)
+    {
+        ps_lookahead->as_pics[i].i4_pic_id = -1;
+        ps_lookahead->as_pics[i].i4_seq_no = -1;
+        ps_lookahead->as_pics[i].i4_intra_cost = 0;
+        ps_lookahead->as_pics[i].i4_inter_cost = -1;
+        ps_lookahead->as_pics[i].i4_is_scene_cut = 0;
+    }
+
+    ps_lookahead->i4_wd = 0;
+    ps_lookahead->i4_ht = 0;
+    ps_lookahead->i4_num_pics = 0;
+    ps_lookahead->i4_last_decided_pic_id = -1;
+    ps_lookahead->i4_last_ref_pic_id = -1;
+    ps_lookahead->i4_avg_inter_pct = -1;
+    ps_lookahead->i4_scene_cut_hold = 0;
+}
+
+/**
+*******************************************************************************
+*
+* @brief Adds an input picture to the lookahead
+*
+* @par Description:
+*  Forms the 1/16 resolution luma plane of the picture and estimates its intra
+*  cost and its inter cost from the previous input picture. The picture is a
+*  scene cut when its inter cost rises well above the running average of the
+*  previous pictures, relative to the headroom left up to its intra cost. Noisy
+*  or fast moving content keeps the inter cost high on every picture, so a
+*  fixed share of the intra cost would flag a cut on each of them. After a
+*  cut, detection resumes once the inter cost is back close to the average,
+*  which keeps flashes and fades from flagging a cut on consecutive pictures.
+*
+* @param[in] ps_codec
+*  Pointer to codec context
+*
+* @param[in] ps_inp_buf
+*  Pointer to the input buffer
+*
+* @param[in] i4_pic_id
+*  Id of the picture given to rate control
+*
+* @returns  none
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+void ih264e_lookahead_add_pic(codec_t *ps_codec,
+                              inp_buf_t *ps_inp_buf,
+                              WORD32 i4_pic_id)
+{
+    lookahead_ctxt_t *ps_lookahead = &ps_codec->s_lookahead;
+    cfg_params_t *ps_cfg = &ps_codec->s_cfg;
+    lookahead_pic_t *ps_cur, *ps_prev;
+    WORD32 i4_wd = ps_cfg->i4_wd_mbs * (MB_SIZE >> 2);
+    WORD32 i4_ht = ps_cfg->i4_ht_mbs * (MB_SIZE >> 2);
+    WORD32 i4_scene_cut = (ps_cfg->e_scene_cut_frm_type != IV_NA_FRAME);
+    WORD32 i4_adaptive_b = ps_cfg->u4_enable_adaptive_bframes
+                    && ps_cfg->u4_num_bframes;
+
+    /* no planar luma to work on for interleaved input */
+    if ((!i4_scene_cut && !i4_adaptive_b)
+                    || (ps_cfg->e_inp_color_fmt == IV_YUV_422ILE))
+    {
+        return;
+    }
+
+    /* pictures of different resolutions can not be compared */
+    if ((i4_wd != ps_lookahead->i4_wd) || (i4_ht != ps_lookahead->i4_ht))
+    {
+        ih264e_lookahead_init(ps_codec);
+        ps_lookahead->i4_wd = i4_wd;
+        ps_lookahead->i4_ht = i4_ht;
+    }
+
+    ps_cur = &ps_lookahead->as_pics[ps_lookahead->i4_num_pics
+                    % LOOKAHEAD_BUF_CNT];
+    ps_prev = &ps_lookahead->as_pics[(ps_lookahead->i4_num_pics
+                    + LOOKAHEAD_BUF_CNT - 1) % LOOKAHEAD_BUF_CNT];
+
+    ih264e_lookahead_downsample(ps_codec, ps_inp_buf, ps_cur->pu1_luma);
+
+    ps_cur->i4_pic_id = i4_pic_id;
+    ps_cur->i4_seq_no = ps_lookahead->i4_num_pics;
+    ps_cur->i4_intra_cost = ih264e_lookahead_intra_cost(ps_lookahead, ps_cur);
+    ps_cur->i4_inter_cost = -1;
+    ps_cur->i4_is_scene_cut = 0;
+
+    if ((ps_prev->i4_pic_id >= 0)
+                    && (ps_prev->i4_seq_no == ps_cur->i4_seq_no - 1))
+    {
+        WORD32 i4_avg = ps_lookahead->i4_avg_inter_pct;
+        WORD32 i4_pct;
+
+        ps_cur->i4_inter_cost = ih264e_lookahead_inter_cost(ps_lookahead,
+                                                            ps_prev, ps_cur,
+                                                            LOOKAHEAD_SRCH_RNG);
+
+        /* inter cost never exceeds the intra cost */
+        i4_pct = (WORD32)((UWORD64)ps_cur->i4_inter_cost * 100
+                        / ps_cur->i4_intra_cost);
+
+        if (i4_avg < 0)
+        {
+            /* the first estimate seeds the average */
+            i4_avg = i4_pct;
+        }
+        else if (ps_lookahead->i4_scene_cut_hold)
+        {
+            ps_lookahead->i4_scene_cut_hold = (i4_pct * 100 > i4_avg * 100
+                            + (100 - i4_avg) * LOOKAHEAD_SCENE_CUT_RELEASE_PCT);
+        }
+        else if (i4_scene_cut && (i4_pct * 100 > i4_avg * 100
+                        + (100 - i4_avg) * LOOKAHEAD_SCENE_CUT_PCT))
+        {
+            ps_cur->i4_is_scene_cut = 1;
+            ps_lookahead->i4_scene_cut_hold = 1;
+        }
+
+        /* the cut itself does not belong to either scene */
+        if (!ps_cur->i4_is_scene_cut)
+        {
+            ps_lookahead->i4_avg_inter_pct = ((i4_avg << LOOKAHEAD_AVG_WT_SHIFT)
+                            - i4_avg + i4_pct
+                            + (1 << (LOOKAHEAD_AVG_WT_SHIFT - 1)))
+                            >> LOOKAHEAD_AVG_WT_SHIFT;
+        }
+    }
+
+    ps_lookahead->i4_num_pics++;
+}
+
+/**
+*******************************************************************************
+*
+* @brief Ends runs of B pictures where prediction across the run gets
+* expensive
+*
+* @par Description:
+*  Follows the fast adaptive B frame decision of common encoders: B picture j
+*  is turned into a P when the cost of predicting picture j+1 from the
+*  reference before the run rises above its cost from picture j by more than
+*  a share of the headroom left up to its intra cost. The share shrinks as
+*  the run grows. Comparing against the cost from the adjacent picture rather
+*  than the intra cost alone keeps B pictures in motion and noise that
+*  adjacent pictures predict no better than the run.
+*
+* @param[in] ps_lookahead
+*  Pointer to lookahead context
+*
+* @param[in] aps_pics
+*  Pictures in display order, starting with the reference before the run
+*
+* @param[in,out] ae_pic_type
+*  Types of the pictures, indexed as aps_pics
+*
+* @param[in] i4_num_pics
+*  Number of pictures after the reference
+*
+* @returns  none
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+void ih264e_lookahead_place_b_pics(lookahead_ctxt_t *ps_lookahead,
+                                   lookahead_pic_t **aps_pics,
+                                   picture_type_e *ae_pic_type,
+                                   WORD32 i4_num_pics)
+{
+    WORD32 i4_ref = 0;
+    WORD32 i;
+
+    for (i = 1; i < i4_num_pics; i++)
+    {
+        WORD32 i4_thresh, i4_srch_rng, i4_cost, i4_adj_cost;
+
+        if (ae_pic_type[i] != B_PIC)
+        {
+            i4_ref = i;
+            continue;
+        }
+
+        i4_thresh = MAX(LOOKAHEAD_BFRAME_PCT
+                        - LOOKAHEAD_BFRAME_BIAS_PCT * (i - i4_ref - 1),
+                        LOOKAHEAD_BFRAME_PCT / 4);
+        i4_srch_rng = MIN(LOOKAHEAD_SRCH_RNG * (i + 1 - i4_ref),
+                          LOOKAHEAD_MAX_SRCH_RNG);
+        i4_cost = ih264e_lookahead_inter_cost(ps_lookahead,
+                                              aps_pics[i4_ref],
+                                              aps_pics[i + 1],
+                                              i4_srch_rng);
+
+        i4_adj_cost = MAX(aps_pics[i + 1]->i4_inter_cost, 0);
+
+        if ((UWORD64)i4_cost * 100 > (UWORD64)i4_adj_cost * 100
+                        + (UWORD64)i4_thresh
+                        * (aps_pics[i + 1]->i4_intra_cost - i4_adj_cost))
+        {
+            ae_pic_type[i] = P_PIC;
+            i4_ref = i;
+        }
+    }
+}
+
+/**
+*******************************************************************************
+*
+* @brief Decides the picture types of the sub gop to be encoded next
+*
+* @par Description:
+*  When the next picture to be dequeued from rate control ends a sub gop, all
+*  the pictures of the sub gop are in the input queue. The sub gop is then
+*  restructured: a scene cut picture is coded as I with a P before it, and a
+*  run of B pictures is ended by a P picture when the cost of predicting
+*  across the run gets high
+*
+* @param[in] ps_codec
+*  Pointer to codec context
+*
+* @returns  none
+*
+* @remarks
+*  none
+*
+*******************************************************************************
+*/
+void ih264e_lookahead_decide_pic_types(codec_t *ps_codec)
+{
+    lookahead_ctxt_t *ps_lookahead = &ps_codec->s_lookahead;
+    cfg_params_t *ps_cfg = &ps_codec->s_cfg;
+
+    /* pictures of the sub gop in encode order */
+    WORD32 ai4_pic_id[MAX_NUM_BFRAMES + 1];
+    picture_type_e ae_pic_type[MAX_NUM_BFRAMES + 1];
+
+    /* pictures of the sub gop in display order, after the last reference */
+    lookahead_pic_t *aps_pics[MAX_NUM_BFRAMES + 2];
+    picture_type_e ae_disp_pic_type[MAX_NUM_BFRAMES + 2];
+
+    WORD32 i4_scene_cut = (ps_cfg->e_scene_cut_frm_type != IV_NA_FRAME);
+    WORD32 i4_adaptive_b = ps_cfg->u4_enable_adaptive_bframes
+                    && ps_cfg->u4_num_bframes;
+    WORD32 i4_num_pics, i4_num_bpics, i, j, k;
+
+    /* the trailing pictures and alt ref gops keep their structure */
+    if ((!i4_scene_cut && !i4_adaptive_b) || ps_cfg->u4_enable_alt_ref
+                    || ps_codec->i4_last_inp_buff_received)
+    {
+        return;
+    }
+
+    i4_num_pics = irc_get_subgop_details(
+                    ps_codec->s_rate_control.pps_rate_control_api, ai4_pic_id,
+                    ae_pic_type);
+
+    if ((i4_num_pics == 0)
+                    || (ai4_pic_id[0] <= ps_lookahead->i4_last_decided_pic_id))
+    {
+        return;
+    }
+    ps_lookahead->i4_last_decided_pic_id = ai4_pic_id[0];
+
+    /* B pictures left in the stack from before the last reference do not belong here */
+    i4_num_bpics = 0;
+    while ((i4_num_bpics + 1 < i4_num_pics)
+                    && (ai4_pic_id[i4_num_bpics + 1] > ps_lookahead->i4_last_ref_pic_id))
+    {
+        i4_num_bpics++;
+    }
+    i4_num_pics = i4_num_bpics + 1;
+
+    /*
+     * The last reference and the sub gop have to be in the lookahead, one
+     * after the other in the order of arrival
+     */
+    aps_pics[0] = ih264e_lookahead_get_pic(ps_lookahead,
+                                           ps_lookahead->i4_last_ref_pic_id);
+    for (i = 1; i <= i4_num_bpics; i++)
+    {
+        aps_pics[i] = ih264e_lookahead_get_pic(ps_lookahead, ai4_pic_id[i]);
+    }
+    aps_pics[i4_num_pics] = ih264e_lookahead_get_pic(ps_lookahead, ai4_pic_id[0]);
+
+    for (i = 0; i <= i4_num_pics; i++)
+    {
+        if (NULL == aps_pics[i])
+            return;
+
+        if (i && (aps_pics[i]->i4_seq_no != aps_pics[i - 1]->i4_seq_no + 1))
+            return;
+    }
+
+    for (i = 1; i < i4_num_pics; i++)
+    {
+        ae_disp_pic_type[i] = B_PIC;
+    }
+    ae_disp_pic_type[i4_num_pics] = ae_pic_type[0];
+
+    /* code the first scene cut as I, and end the B pictures before it with a P */
+    if (i4_scene_cut)
+    {
+        for (i = 1; i <= i4_num_pics; i++)
+        {
+            if (aps_pics[i]->i4_is_scene_cut)
+            {
+                ae_disp_pic_type[i] = I_PIC;
+                if (i > 1)
+                {
+                    ae_disp_pic_type[i - 1] = P_PIC;
+                }
+                break;
+            }
+        }
+    }
+
+    /* end a run of B pictures once prediction across it gets expensive */
+    if (i4_adaptive_b)
+    {
+        ih264e_lookahead_place_b_pics(ps_lookahead, aps_pics, ae_disp_pic_type,
+                                      i4_num_pics);
+    }
+
+    /* every reference is followed by the B pictures before it */
+    k = 0;
+    j = 1;
+    for (i = 1; i <= i4_num_pics; i++)
+    {
+        if (ae_disp_pic_type[i] == B_PIC)
+            continue;
+
+        ai4_pic_id[k] = aps_pics[i]->i4_pic_id;
+        ae_pic_type[k++] = ae_disp_pic_type[i];
+
+        for (; j < i; j++)
+        {
+            ai4_pic_id[k] = aps_pics[j]->i4_pic_id;
+            ae_pic_type[k++] = B_PIC;
+        }
+        j = i + 1;
+    }
+
+    irc_set_subgop_details(ps_codec->s_rate_control.pps_rate_control_api,
+                           i4_num_pics, ai4_pic_id, ae_pic_type);
+}
+
+/**
+*******************************************************************************
+*
+* @brief Updates the lookahead with the type of the dequeued picture
+*
+* @par Description:
+*  Codes scene cut I pictures as IDR when requested and tracks the latest
+*  reference picture
+*
+* @param[in] ps_codec
+*  Pointer to codec context
+*
+* @param[in] i4_pic_id
+*  Id of the dequeued picture
+*
+* @returns  none
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+void ih264e_lookahead_update_pic_type(codec_t *ps_codec, WORD32 i4_pic_id)
+{
+    lookahead_ctxt_t *ps_lookahead = &ps_codec->s_lookahead;
+    lookahead_pic_t *ps_pic = ih264e_lookahead_get_pic(ps_lookahead, i4_pic_id);
+
+    if ((ps_codec->pic_type == PIC_I) && (NULL != ps_pic)
+                    && ps_pic->i4_is_scene_cut
+                    && (ps_codec->s_cfg.e_scene_cut_frm_type == IV_IDR_FRAME))
+    {
+        ps_codec->pic_type = PIC_IDR;
+    }
+
+    if (ps_codec->pic_type != PIC_B)
+    {
+        ps_lookahead->i4_last_ref_pic_id = i4_pic_id;
+    }
+}
@@ -0,0 +1,169 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+
+/**
+*******************************************************************************
+* @file
+*  ih264e_lookahead.h
+*
+* @brief
+*  Contains declarations of the lookahead used for adaptive B frame placement
+*  and scene cut detection
+*
+* @author
+*  ittiam
+*
+* @remarks
+*  None
+*
+*******************************************************************************
+*/
+
+#ifndef IH264E_LOOKAHEAD_H_
+#define IH264E_LOOKAHEAD_H_
+
+/*****************************************************************************/
+/* Function Declarations                                                     */
+/*****************************************************************************/
+
+/**
+*******************************************************************************
+*
+* @brief Resets the lookahead
+*
+* @par Description:
+*  Marks all the pictures of the lookahead unused
+*
+* @param[in] ps_codec
+*  Pointer to codec context
+*
+* @returns  none
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+void ih264e_lookahead_init(codec_t *ps_codec);
+
+/**
+*******************************************************************************
+*
+* @brief Adds an input picture to the lookahead
+*
+* @par Description:
+*  Forms the 1/16 resolution luma plane of the picture, estimates its intra
+*  cost and its inter cost from the previous input picture, and flags a scene
+*  cut when the inter cost rises well above its running average
+*
+* @param[in] ps_codec
+*  Pointer to codec context
+*
+* @param[in] ps_inp_buf
+*  Pointer to the input buffer
+*
+* @param[in] i4_pic_id
+*  Id of the picture given to rate control
+*
+* @returns  none
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+void ih264e_lookahead_add_pic(codec_t *ps_codec,
+                              inp_buf_t *ps_inp_buf,
+                              WORD32 i4_pic_id);
+
+/**
+*******************************************************************************
+*
+* @brief Ends runs of B pictures where prediction across the run gets
+* expensive
+*
+* @param[in] ps_lookahead
+*  Pointer to lookahead context
+*
+* @param[in] aps_pics
+*  Pictures in display order, starting with the reference before the run
+*
+* @param[in,out] ae_pic_type
+*  Types of the pictures, indexed as aps_pics
+*
+* @param[in] i4_num_pics
+*  Number of pictures after the reference
+*
+* @returns  none
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+void ih264e_lookahead_place_b_pics(lookahead_ctxt_t *ps_lookahead,
+                                   lookahead_pic_t **aps_pics,
+                                   picture_type_e *ae_pic_type,
+                                   WORD32 i4_num_pics);
+
+/**
+*******************************************************************************
+*
+* @brief Decides the picture types of the sub gop to be encoded next
+*
+* @par Description:
+*  When the next picture to be dequeued from rate control ends a sub gop, all
+*  the pictures of the sub gop are in the input queue. The sub gop is then
+*  restructured: a scene cut picture is coded as I with a P before it, and a
+*  run of B pictures is ended by a P picture when the cost of predicting
+*  across the run gets high
+*
+* @param[in] ps_codec
+*  Pointer to codec context
+*
+* @returns  none
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+void ih264e_lookahead_decide_pic_types(codec_t *ps_codec);
+
+/**
+*******************************************************************************
+*
+* @brief Updates the lookahead with the type of the dequeued picture
+*
+* @par Description:
+*  Codes scene cut I pictures as IDR when requested and tracks the latest
+*  reference picture
+*
+* @param[in] ps_codec
+*  Pointer to codec context
+*
+* @param[in] i4_pic_id
+*  Id of the dequeued picture
+*
+* @returns  none
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+void ih264e_lookahead_update_pic_type(codec_t *ps_codec, WORD32 i4_pic_id);
+
+#endif /* IH264E_LOOKAHEAD_H_ */
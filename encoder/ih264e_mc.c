@@ -139,6 +139,9 @@ void ih264e_motion_comp_luma(process_ctxt_t *ps_proc, UWORD8 **pu1_pseudo_pred,
     /* quarter pel motion vectors */
     WORD32 u4_mv_x_qpel, u4_mv_y_qpel;
 
+    /* L0 reference of the partition */
+    WORD32 i4_ref_idx;
+
     /* width & height of the partition */
     UWORD32 wd, ht;
 
@@ -176,6 +179,15 @@ void ih264e_motion_comp_luma(process_ctxt_t *ps_proc, UWORD8 **pu1_pseudo_pred,
             case PRED_L0:
                 ps_curr_mv = &ps_curr_pu->s_me_info[0].s_mv;
                 pu1_ref[0] = ps_proc->apu1_ref_buf_luma[0];
+
+                /* L0 references other than the first */
+                i4_ref_idx = -1 - ps_curr_pu->s_me_info[0].i1_ref_idx;
+                if (i4_ref_idx > 0)
+                {
+                    pu1_ref[0] = ps_proc->apu1_ref_l0_luma_base[i4_ref_idx]
+                                    + (ps_proc->apu1_ref_buf_luma[0]
+                                    - ps_proc->apu1_ref_buf_luma_base[0]);
+                }
                 break;
 
             case PRED_L1:
@@ -236,8 +248,8 @@ void ih264e_motion_comp_luma(process_ctxt_t *ps_proc, UWORD8 **pu1_pseudo_pred,
                         + 4 * ps_curr_pu->b4_pos_y * i4_pred_strd
                         + 4 * ps_curr_pu->b4_pos_x;
 
-        /* u4_lkup_idx1 will be non zero for half pel and bipred */
-        u4_lkup_idx1 = ((u4_subpel_factor >> 2) != 0) || i4_bipred_flag;
+        /* u4_lkup_idx1 will be non zero for sub pel and bipred */
+        u4_lkup_idx1 = (u4_subpel_factor != 0) || i4_bipred_flag;
 
         {
             /********************************************************************/
@@ -254,16 +266,22 @@ void ih264e_motion_comp_luma(process_ctxt_t *ps_proc, UWORD8 **pu1_pseudo_pred,
 
             }
             /*
-             * Copying half pel or full pel to prediction buffer
-             * Currently ps_proc->u4_num_sub_partitions will always be 1 as we only support 16x16 in P mbs
+             * Sub mb partitions are interpolated from the full pel reference
+             * as the half pel buffers hold the prediction of the 16x16 mv
              */
             else
             {
-                ps_codec->pf_inter_pred_luma_copy(pu1_ref[u4_lkup_idx1],
-                                                  pu1_pred,
-                                                  i4_ref_strd[u4_lkup_idx1],
-                                                  i4_pred_strd, ht, wd, NULL,
-                                                  0);
+                UWORD32 u4_dydx = ((ps_curr_mv->i2_mvy & 3) << 2)
+                                + (ps_curr_mv->i2_mvx & 3);
+
+                ps_codec->apf_inter_pred_luma[u4_dydx](pu1_ref[0]
+                                                       + 4 * ps_curr_pu->b4_pos_y * i4_ref_strd[0]
+                                                       + 4 * ps_curr_pu->b4_pos_x,
+                                                       pu1_pred,
+                                                       i4_ref_strd[0],
+                                                       i4_pred_strd, ht, wd,
+                                                       (UWORD8 *)ps_proc->ai16_pred1,
+                                                       u4_dydx);
             }
 
         }
@@ -318,6 +336,9 @@ void ih264e_motion_comp_chroma(process_ctxt_t *ps_proc)
     /* quarter pel motion vectors */
     WORD32 u4_mv_x_qpel, u4_mv_y_qpel;
 
+    /* L0 reference of the partition */
+    WORD32 i4_ref_idx;
+
     /* width & height of the partition */
     UWORD32 wd, ht;
 
@@ -340,6 +361,15 @@ void ih264e_motion_comp_chroma(process_ctxt_t *ps_proc)
             ps_curr_mv = &ps_curr_pu->s_me_info[ps_curr_pu->b2_pred_mode].s_mv;
             pu1_ref = ps_proc->apu1_ref_buf_chroma[ps_curr_pu->b2_pred_mode];
 
+            /* L0 references other than the first */
+            i4_ref_idx = -1 - ps_curr_pu->s_me_info[PRED_L0].i1_ref_idx;
+            if ((ps_curr_pu->b2_pred_mode == PRED_L0) && (i4_ref_idx > 0))
+            {
+                pu1_ref = ps_proc->apu1_ref_l0_chroma_base[i4_ref_idx]
+                                + (ps_proc->apu1_ref_buf_chroma[0]
+                                - ps_proc->apu1_ref_buf_chroma_base[0]);
+            }
+
             u4_mv_x = ps_curr_mv->i2_mvx >> 3;
             u4_mv_y = ps_curr_mv->i2_mvy >> 3;
 
@@ -362,9 +392,13 @@ void ih264e_motion_comp_chroma(process_ctxt_t *ps_proc)
             /* move the pointers so that they point to the motion compensated locations */
             pu1_ref += ((u4_mv_y * i4_ref_strd) + (u4_mv_x << 1));
 
+            /* chroma is interleaved and subsampled by 2 in both directions */
+            pu1_ref += 2 * ps_curr_pu->b4_pos_y * i4_ref_strd
+                            + 4 * ps_curr_pu->b4_pos_x;
+
             pu1_pred = ps_proc->pu1_pred_mb
-                            + 4 * ps_curr_pu->b4_pos_y * i4_pred_strd
-                            + 2 * ps_curr_pu->b4_pos_x;
+                            + 2 * ps_curr_pu->b4_pos_y * i4_pred_strd
+                            + 4 * ps_curr_pu->b4_pos_x;
 
             u1_dx = (u4_mv_x_full << 2) + (u4_mv_x_hpel << 1) + (u4_mv_x_qpel);
             u1_dy = (u4_mv_y_full << 2) + (u4_mv_y_hpel << 1) + (u4_mv_y_qpel);
@@ -423,10 +457,12 @@ void ih264e_motion_comp_chroma(process_ctxt_t *ps_proc)
 
                 /* move the pointers so that they point to the motion compensated locations */
                 pu1_ref += ((u4_mv_y * i4_ref_strd) + (u4_mv_x << 1));
+                pu1_ref += 2 * ps_curr_pu->b4_pos_y * i4_ref_strd
+                                + 4 * ps_curr_pu->b4_pos_x;
 
                 pu1_pred = ps_proc->pu1_pred_mb
-                                + 4 * ps_curr_pu->b4_pos_y * i4_pred_strd
-                                + 2 * ps_curr_pu->b4_pos_x;
+                                + 2 * ps_curr_pu->b4_pos_y * i4_pred_strd
+                                + 4 * ps_curr_pu->b4_pos_x;
 
                 u1_dx = (u4_mv_x_full << 2) + (u4_mv_x_hpel << 1)
                                 + (u4_mv_x_qpel);
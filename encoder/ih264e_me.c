@@ -34,12 +34,14 @@
  *  - ih264e_skip_analysis_chroma()
  *  - ih264e_skip_analysis_luma()
  *  - ih264e_analyse_skip()
+ *  - ih264e_get_pred_and_skip_mv()
  *  - ih264e_get_search_candidates()
  *  - ih264e_find_skip_motion_vector()
  *  - ih264e_get_mv_predictor()
  *  - ih264e_mv_pred()
  *  - ih264e_mv_pred_me()
  *  - ih264e_init_me()
+ *  - ih264e_compute_subpel_skip_cost()
  *  - ih264e_compute_me()
  *  - ih264e_compute_me_nmb()
  *
@@ -55,6 +57,7 @@
 
 /* System include files */
 #include <stdio.h>
+#include <string.h>
 #include <assert.h>
 #include <limits.h>
 
@@ -166,6 +169,402 @@ void ih264e_init_mv_bits(me_ctxt_t *ps_me_ctxt)
 
 
 
+/**
+*******************************************************************************
+*
+* @brief Builds the downsampled luma planes of a picture for pre-enc ME
+*
+* @par Description:
+*  The 1/4 resolution plane is formed by averaging every 2x2 block of the input
+*  luma and the 1/16 resolution plane is formed likewise from the 1/4 plane.
+*  Samples lying outside the display area are replicated from the nearest
+*  edge. The planes are stored along with the MV bank of the picture so that
+*  they remain available as long as the picture is used as a reference.
+*
+* @param[in] ps_codec
+*  Pointer to codec context
+*
+* @param[in] ps_inp_buf
+*  Pointer to current input buffer
+*
+* @param[out] ps_mv_buf
+*  MV bank of the current picture
+*
+* @returns  none
+*
+* @remarks
+*  Interleaved 422 input is not supported, the planes are marked invalid for
+*  such inputs.
+*
+*******************************************************************************
+*/
+void ih264e_build_me_pyramid(codec_t *ps_codec,
+                             inp_buf_t *ps_inp_buf,
+                             mv_buf_t *ps_mv_buf)
+{
+    /* input luma */
+    UWORD8 *pu1_src = ps_inp_buf->s_raw_buf.apv_bufs[0];
+    WORD32 i4_src_strd = ps_inp_buf->s_raw_buf.au4_strd[0];
+
+    /* display dimensions */
+    WORD32 i4_disp_wd = ps_codec->s_cfg.u4_disp_wd;
+    WORD32 i4_disp_ht = ps_codec->s_cfg.u4_disp_ht;
+
+    /* plane dimensions */
+    WORD32 i4_wd = ps_codec->s_cfg.i4_wd_mbs * (MB_SIZE >> 1);
+    WORD32 i4_ht = ps_codec->s_cfg.i4_ht_mbs * (MB_SIZE >> 1);
+
+    /* downsampled planes */
+    UWORD8 *pu1_dst = ps_mv_buf->apu1_pyr_luma[0];
+    UWORD8 *pu1_dst2 = ps_mv_buf->apu1_pyr_luma[1];
+
+    /* temp var */
+    WORD32 i, j;
+
+    ps_mv_buf->i4_pyr_valid = 0;
+
+    if (ps_codec->s_cfg.e_inp_color_fmt == IV_YUV_422ILE)
+    {
+        return;
+    }
+
+    /* 1/4 resolution plane */
+    for (i = 0; i < i4_ht; i++)
+    {
+        UWORD8 *pu1_row0 = pu1_src + MIN(2 * i, i4_disp_ht - 1) * i4_src_strd;
+        UWORD8 *pu1_row1 = pu1_src + MIN(2 * i + 1, i4_disp_ht - 1) * i4_src_strd;
+
+        for (j = 0; j < i4_wd; j++)
+        {
+            WORD32 x0 = MIN(2 * j, i4_disp_wd - 1);
+            WORD32 x1 = MIN(2 * j + 1, i4_disp_wd - 1);
+
+            pu1_dst[j] = (pu1_row0[x0] + pu1_row0[x1] + pu1_row1[x0]
+                            + pu1_row1[x1] + 2) >> 2;
+        }
+        pu1_dst += i4_wd;
+    }
+
+    /* 1/16 resolution plane */
+    pu1_dst = ps_mv_buf->apu1_pyr_luma[0];
+
+    for (i = 0; i < (i4_ht >> 1); i++)
+    {
+        UWORD8 *pu1_row0 = pu1_dst + (2 * i) * i4_wd;
+        UWORD8 *pu1_row1 = pu1_row0 + i4_wd;
+
+        for (j = 0; j < (i4_wd >> 1); j++)
+        {
+            pu1_dst2[j] = (pu1_row0[2 * j] + pu1_row0[2 * j + 1]
+                            + pu1_row1[2 * j] + pu1_row1[2 * j + 1] + 2) >> 2;
+        }
+        pu1_dst2 += (i4_wd >> 1);
+    }
+
+    ps_mv_buf->i4_pyr_valid = 1;
+}
+
+/**
+*******************************************************************************
+*
+* @brief Computes the SADs of a square block of a downsampled plane at a row of
+* consecutive horizontal positions in the reference
+*
+* @par Description:
+*  The loops are arranged so that the innermost one runs across the search
+*  positions, which lets the compiler vectorize it.
+*
+* @param[in] pu1_src
+*  Pointer to source block
+*
+* @param[in] pu1_ref
+*  Pointer to reference block at the first search position
+*
+* @param[in] i4_strd
+*  Stride of source and reference planes
+*
+* @param[in] i4_blk_size
+*  Block width and height
+*
+* @param[in] i4_num_pos
+*  Number of search positions
+*
+* @param[out] pu2_sad
+*  SADs at each of the search positions
+*
+* @returns  none
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static void ih264e_pyr_sad_row(UWORD8 *pu1_src,
+                               UWORD8 *pu1_ref,
+                               WORD32 i4_strd,
+                               WORD32 i4_blk_size,
+                               WORD32 i4_num_pos,
+                               UWORD16 *pu2_sad)
+{
+    WORD32 i, j, k;
+
+    memset(pu2_sad, 0, i4_num_pos * sizeof(UWORD16));
+
+    for (i = 0; i < i4_blk_size; i++)
+    {
+        for (j = 0; j < i4_blk_size; j++)
+        {
+            WORD32 i4_src = pu1_src[j];
+            UWORD8 *pu1_ref_pos = pu1_ref + j;
+
+            for (k = 0; k < i4_num_pos; k++)
+            {
+                pu2_sad[k] += ABS(i4_src - pu1_ref_pos[k]);
+            }
+        }
+        pu1_src += i4_strd;
+        pu1_ref += i4_strd;
+    }
+}
+
+/**
+*******************************************************************************
+*
+* @brief Coarse to fine search of the current MB on the downsampled planes
+*
+* @par Description:
+*  The MB is first searched exhaustively as a 4x4 block on the 1/16 resolution
+*  planes over the search range scaled down by 4. The best match is scaled up
+*  and refined as an 8x8 block on the 1/4 resolution planes within +/-1
+*  sample. The refined vector, in full pel units, is returned.
+*
+* @param[in] ps_proc
+*  Process context corresponding to the job
+*
+* @param[in] i4_reflist
+*  Current active reference list
+*
+* @param[out] pi4_mvx
+*  Horizontal full pel motion vector
+*
+* @param[out] pi4_mvy
+*  Vertical full pel motion vector
+*
+* @returns  none
+*
+* @remarks
+*  The distortion is biased by the distance of the vector from the MV
+*  predictor. Without this, periodic textures tend to alias onto a wrong
+*  match at the coarse levels.
+*
+*******************************************************************************
+*/
+static void ih264e_pyramid_search(process_ctxt_t *ps_proc,
+                                  WORD32 i4_reflist,
+                                  WORD32 *pi4_mvx,
+                                  WORD32 *pi4_mvy)
+{
+    /* me ctxt */
+    me_ctxt_t *ps_me_ctxt = &ps_proc->s_me_ctxt;
+
+    /* mv predictor in qpel units */
+    ime_mv_t *ps_mv_pred = &ps_me_ctxt->as_mb_part[i4_reflist].s_mv_pred;
+
+    /* 1/16 resolution plane */
+    WORD32 i4_wd = ps_proc->i4_wd_mbs * (MB_SIZE >> 2);
+    WORD32 i4_ht = ps_proc->i4_ht_mbs * (MB_SIZE >> 2);
+    WORD32 i4_blk = MB_SIZE >> 2;
+    WORD32 i4_x = ps_proc->i4_mb_x * i4_blk;
+    WORD32 i4_y = ps_proc->i4_mb_y * i4_blk;
+
+    UWORD8 *pu1_src = ps_proc->apu1_pyr_src_luma[1] + i4_y * i4_wd + i4_x;
+    UWORD8 *pu1_ref = ps_proc->apu1_pyr_ref_luma[i4_reflist][1] + i4_y * i4_wd + i4_x;
+
+    /* search window */
+    WORD32 i4_w = -MIN(i4_x, ps_me_ctxt->ai2_srch_boundaries[0] >> 2);
+    WORD32 i4_e = MIN(i4_wd - i4_blk - i4_x, ps_me_ctxt->ai2_srch_boundaries[0] >> 2);
+    WORD32 i4_n = -MIN(i4_y, ps_me_ctxt->ai2_srch_boundaries[1] >> 2);
+    WORD32 i4_s = MIN(i4_ht - i4_blk - i4_y, ps_me_ctxt->ai2_srch_boundaries[1] >> 2);
+
+    /* mv predictor at the current level */
+    WORD32 i4_pred_x = (ps_mv_pred->i2_mvx + 8) >> 4;
+    WORD32 i4_pred_y = (ps_mv_pred->i2_mvy + 8) >> 4;
+
+    /* cost */
+    WORD32 i4_cost, i4_cost_least = INT_MAX;
+
+    /* best mv */
+    WORD32 i4_mvx = 0, i4_mvy = 0;
+
+    /* sads of a row of search positions */
+    UWORD16 au2_sad[(DEFAULT_MAX_SRCH_RANGE_X >> 1) + 1];
+
+    /* temp var */
+    WORD32 i, j, cx, cy;
+
+    /* exhaustive search on the 1/16 resolution plane */
+    for (i = i4_n; i <= i4_s; i++)
+    {
+        ih264e_pyr_sad_row(pu1_src, pu1_ref + i * i4_wd + i4_w, i4_wd, i4_blk,
+                           i4_e - i4_w + 1, au2_sad);
+
+        for (j = i4_w; j <= i4_e; j++)
+        {
+            i4_cost = au2_sad[j - i4_w]
+                            + PYR_ME_MV_COST_WT_L2 * (ABS(j - i4_pred_x) + ABS(i - i4_pred_y));
+
+            if (i4_cost < i4_cost_least)
+            {
+                i4_cost_least = i4_cost;
+                i4_mvx = j;
+                i4_mvy = i;
+            }
+        }
+    }
+
+    /* refine on the 1/4 resolution plane */
+    i4_wd <<= 1;
+    i4_ht <<= 1;
+    i4_blk <<= 1;
+    i4_x <<= 1;
+    i4_y <<= 1;
+
+    pu1_src = ps_proc->apu1_pyr_src_luma[0] + i4_y * i4_wd + i4_x;
+    pu1_ref = ps_proc->apu1_pyr_ref_luma[i4_reflist][0] + i4_y * i4_wd + i4_x;
+
+    i4_w = -MIN(i4_x, ps_me_ctxt->ai2_srch_boundaries[0] >> 1);
+    i4_e = MIN(i4_wd - i4_blk - i4_x, ps_me_ctxt->ai2_srch_boundaries[0] >> 1);
+    i4_n = -MIN(i4_y, ps_me_ctxt->ai2_srch_boundaries[1] >> 1);
+    i4_s = MIN(i4_ht - i4_blk - i4_y, ps_me_ctxt->ai2_srch_boundaries[1] >> 1);
+
+    i4_pred_x = (ps_mv_pred->i2_mvx + 4) >> 3;
+    i4_pred_y = (ps_mv_pred->i2_mvy + 4) >> 3;
+
+    cx = i4_mvx << 1;
+    cy = i4_mvy << 1;
+    i4_cost_least = INT_MAX;
+
+    i4_w = MAX(cx - 1, i4_w);
+    i4_e = MIN(cx + 1, i4_e);
+
+    for (i = MAX(cy - 1, i4_n); i <= MIN(cy + 1, i4_s); i++)
+    {
+        ih264e_pyr_sad_row(pu1_src, pu1_ref + i * i4_wd + i4_w, i4_wd, i4_blk,
+                           i4_e - i4_w + 1, au2_sad);
+
+        for (j = i4_w; j <= i4_e; j++)
+        {
+            i4_cost = au2_sad[j - i4_w]
+                            + PYR_ME_MV_COST_WT_L1 * (ABS(j - i4_pred_x) + ABS(i - i4_pred_y));
+
+            if (i4_cost < i4_cost_least)
+            {
+                i4_cost_least = i4_cost;
+                i4_mvx = j;
+                i4_mvy = i;
+            }
+        }
+    }
+
+    *pi4_mvx = i4_mvx << 1;
+    *pi4_mvy = i4_mvy << 1;
+}
+
+/**
+*******************************************************************************
+*
+* @brief Returns the mv of a neighbor pu to be used as a search candidate
+*
+* @par Description:
+*  In P slices, the mv of a neighbor predicted from an L0 reference other than
+*  the first one is scaled by the ratio of the poc distances of the first
+*  reference and its reference, so that it points to the first reference
+*
+* @param[in] ps_proc
+*  Process context corresponding to the job
+*
+* @param[in] ps_pu
+*  pu of the neighbor
+*
+* @param[in] i4_reflist
+*  reference list
+*
+* @param[out] ps_mv
+*  candidate mv
+*
+* @returns  none
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static void ih264e_get_ngbr_srch_mv(process_ctxt_t *ps_proc,
+                                    enc_pu_t *ps_pu,
+                                    WORD32 i4_reflist,
+                                    mv_t *ps_mv)
+{
+    WORD32 i4_ref_idx = -1 - ps_pu->s_me_info[i4_reflist].i1_ref_idx;
+    WORD32 i4_poc_dist;
+
+    *ps_mv = ps_pu->s_me_info[i4_reflist].s_mv;
+
+    if ((i4_reflist == PRED_L0) && (i4_ref_idx > 0))
+    {
+        i4_poc_dist = ps_proc->ai4_ref_l0_poc_dist[i4_ref_idx];
+
+        if (i4_poc_dist > 0)
+        {
+            ps_mv->i2_mvx = ps_mv->i2_mvx * ps_proc->ai4_ref_l0_poc_dist[0] / i4_poc_dist;
+            ps_mv->i2_mvy = ps_mv->i2_mvy * ps_proc->ai4_ref_l0_poc_dist[0] / i4_poc_dist;
+        }
+    }
+}
+
+/**
+*******************************************************************************
+*
+* @brief Computes the mv predictor and the skip mv of the current mb
+*
+* @par Description:
+*  The mv predictor used for the mv cost of the search and the skip mv with
+*  its prediction type are derived for the given reference list. These do not
+*  depend on the search candidates and are computed ahead of them, so that the
+*  skip mv can be evaluated before any search is started.
+*
+* @param[in] ps_proc
+*  Process context corresponding to the job
+*
+* @param[in] ps_me_ctxt
+*  Pointer to me context
+*
+* @param[in] i4_reflist
+*  Reference list
+*
+* @returns  none
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static void ih264e_get_pred_and_skip_mv(process_ctxt_t *ps_proc,
+                                        me_ctxt_t *ps_me_ctxt,
+                                        WORD32 i4_reflist)
+{
+    /* mb part info */
+    mb_part_ctxt *ps_mb_part = &ps_me_ctxt->as_mb_part[i4_reflist];
+
+    /********************************************************************/
+    /*                            MV Prediction                         */
+    /********************************************************************/
+    ih264e_mv_pred_me(ps_proc, i4_reflist, 0);
+
+    ps_mb_part->s_mv_pred.i2_mvx = ps_proc->ps_pred_mv[i4_reflist].s_mv.i2_mvx;
+    ps_mb_part->s_mv_pred.i2_mvy = ps_proc->ps_pred_mv[i4_reflist].s_mv.i2_mvy;
+
+    /* Get the skip motion vector                               */
+    ps_me_ctxt->i4_skip_type = ps_proc->ps_codec->apf_find_skip_params_me
+                                [ps_proc->i4_slice_type](ps_proc, i4_reflist);
+}
+
 /**
 *******************************************************************************
 *
@@ -176,7 +575,11 @@ void ih264e_init_mv_bits(me_ctxt_t *ps_me_ctxt)
 * neighbouring MBs MVs. The left, top and top-right MBs MVs are used because
 * these are the same MVs that are used to form the MV predictor. This initial MV
 * search candidates need not take care of slice boundaries and hence neighbor
-* availability checks are not made here.
+* availability checks are not made here. In P slices the MVs of the co-located,
+* right and bottom MBs in the MV bank of the first reference are sent as well,
+* so that on smooth motion the search starts close to the converged MV. When
+* pre-enc ME is enabled, the result of the coarse to fine search on the
+* downsampled planes is sent as well.
 *
 * @param[in] ps_left_mb_pu
 *  pointer to left mb motion vector info
@@ -207,6 +610,7 @@ void ih264e_init_mv_bits(me_ctxt_t *ps_me_ctxt)
 *
 * @remarks
 *   Assumptions : 1. Assumes Only partition of size 16x16
+*                 2. The skip mv is computed by ih264e_get_pred_and_skip_mv
 *
 *******************************************************************************
 */
@@ -218,14 +622,15 @@ static void ih264e_get_search_candidates(process_ctxt_t *ps_proc,
     WORD32 i4_mb_x = ps_proc->i4_mb_x;
 
     /* Motion vector */
-    mv_t *ps_left_mv, *ps_top_mv, *ps_top_left_mv, *ps_top_right_mv;
+    mv_t s_left_mv, s_top_mv, s_top_left_mv, s_top_right_mv;
+    mv_t *ps_left_mv = &s_left_mv;
+    mv_t *ps_top_mv = &s_top_mv;
+    mv_t *ps_top_left_mv = &s_top_left_mv;
+    mv_t *ps_top_right_mv = &s_top_right_mv;
 
     /* Pred modes */
     WORD32 i4_left_mode, i4_top_mode, i4_top_left_mode, i4_top_right_mode;
 
-    /* mb part info */
-    mb_part_ctxt *ps_mb_part = &ps_me_ctxt->as_mb_part[i4_reflist];
-
     /* mvs */
     WORD32 mvx, mvy;
 
@@ -244,15 +649,19 @@ static void ih264e_get_search_candidates(process_ctxt_t *ps_proc,
     /* num of candidate search candidates */
     UWORD32 u4_num_candidates = 0;
 
-    ps_left_mv = &ps_proc->s_left_mb_pu_ME.s_me_info[i4_reflist].s_mv;
-    ps_top_mv = &(ps_proc->ps_top_row_pu_ME + i4_mb_x)->s_me_info[i4_reflist].s_mv;
-    ps_top_left_mv = &ps_proc->s_top_left_mb_pu_ME.s_me_info[i4_reflist].s_mv;
-    ps_top_right_mv = &(ps_proc->ps_top_row_pu_ME + i4_mb_x + 1)->s_me_info[i4_reflist].s_mv;
+    /* bottom left 8x8 blk of top mb and top right mb */
+    enc_pu_t *ps_top_pu = ih264e_get_8x8_blk_pu(ps_proc->ps_top_row_pu_ME + i4_mb_x * ENC_MAX_PU_IN_MB, 0, 1);
+    enc_pu_t *ps_top_right_pu = ih264e_get_8x8_blk_pu(ps_proc->ps_top_row_pu_ME + (i4_mb_x + 1) * ENC_MAX_PU_IN_MB, 0, 1);
+
+    ih264e_get_ngbr_srch_mv(ps_proc, &ps_proc->s_left_mb_pu_ME, i4_reflist, ps_left_mv);
+    ih264e_get_ngbr_srch_mv(ps_proc, ps_top_pu, i4_reflist, ps_top_mv);
+    ih264e_get_ngbr_srch_mv(ps_proc, &ps_proc->s_top_left_mb_pu_ME, i4_reflist, ps_top_left_mv);
+    ih264e_get_ngbr_srch_mv(ps_proc, ps_top_right_pu, i4_reflist, ps_top_right_mv);
 
     i4_left_mode = ps_proc->s_left_mb_pu_ME.b2_pred_mode != i4_cmpl_predmode;
-    i4_top_mode = (ps_proc->ps_top_row_pu_ME + i4_mb_x)->b2_pred_mode != i4_cmpl_predmode;
+    i4_top_mode = ps_top_pu->b2_pred_mode != i4_cmpl_predmode;
     i4_top_left_mode = ps_proc->s_top_left_mb_pu_ME.b2_pred_mode != i4_cmpl_predmode;
-    i4_top_right_mode = (ps_proc->ps_top_row_pu_ME + i4_mb_x + 1)->b2_pred_mode != i4_cmpl_predmode;
+    i4_top_right_mode = ps_top_right_pu->b2_pred_mode != i4_cmpl_predmode;
 
     /* Taking the Zero motion vector as one of the candidates   */
     ps_me_ctxt->as_mv_init_search[i4_reflist][u4_num_candidates].i2_mvx = 0;
@@ -320,20 +729,76 @@ static void ih264e_get_search_candidates(process_ctxt_t *ps_proc,
     }
 
 
-    /********************************************************************/
-    /*                            MV Prediction                         */
-    /********************************************************************/
-    ih264e_mv_pred_me(ps_proc, i4_reflist);
+    /* Taking the co-located, right and bottom MB MVs of the first
+     * reference as candidates. The spatial neighbours of these MBs are not
+     * yet coded in the current picture */
+    if (ps_proc->i4_slice_type == PSLICE)
+    {
+        WORD32 i4_mb_y = ps_proc->i4_mb_y;
+        WORD32 i4_wd_mbs = ps_proc->i4_wd_mbs;
+        enc_pu_t *aps_col_pu[3];
+        WORD32 i4_num_col = 0, i;
+        mv_t s_col_mv;
 
-    ps_mb_part->s_mv_pred.i2_mvx = ps_proc->ps_pred_mv[i4_reflist].s_mv.i2_mvx;
-    ps_mb_part->s_mv_pred.i2_mvy = ps_proc->ps_pred_mv[i4_reflist].s_mv.i2_mvy;
+        /* co-located mb in the mv bank of the first reference */
+        enc_pu_t *ps_col_pu = ps_proc->aps_mv_buf[PRED_L0]->ps_pic_pu
+                        + (i4_mb_y * i4_wd_mbs + i4_mb_x) * ENC_MAX_PU_IN_MB;
 
-    /* Get the skip motion vector                               */
+        aps_col_pu[i4_num_col++] = ps_col_pu;
+
+        if (i4_mb_x + 1 < i4_wd_mbs)
+        {
+            aps_col_pu[i4_num_col++] = ps_col_pu + ENC_MAX_PU_IN_MB;
+        }
+
+        if (i4_mb_y + 1 < ps_proc->i4_ht_mbs)
+        {
+            aps_col_pu[i4_num_col++] = ps_col_pu + i4_wd_mbs * ENC_MAX_PU_IN_MB;
+        }
+
+        for (i = 0; i < i4_num_col; i++)
+        {
+            if (aps_col_pu[i]->b1_intra_flag || aps_col_pu[i]->b2_pred_mode == PRED_L1)
+            {
+                continue;
+            }
+
+            ih264e_get_ngbr_srch_mv(ps_proc, aps_col_pu[i], PRED_L0, &s_col_mv);
+
+            mvx      = (s_col_mv.i2_mvx + 2) >> 2;
+            mvy      = (s_col_mv.i2_mvy + 2) >> 2;
+
+            mvx = CLIP3(i4_srch_range_w, i4_srch_range_e, mvx);
+            mvy = CLIP3(i4_srch_range_n, i4_srch_range_s, mvy);
+
+            ps_me_ctxt->as_mv_init_search[i4_reflist][u4_num_candidates].i2_mvx = mvx;
+            ps_me_ctxt->as_mv_init_search[i4_reflist][u4_num_candidates].i2_mvy = mvy;
+
+            u4_num_candidates ++;
+        }
+    }
+
+    /* Taking the pre-enc (pyramid) ME result as one of the candidates. It
+     * is added ahead of the skip candidates, which have to stay last in the
+     * list: in B slices ih264e_compute_me_multi_reflist reads the spatial
+     * and temporal skip mvs at u4_num_candidates - 2 and - 1. When the
+     * pyramid candidate followed them, the temporal skip mv was read as
+     * the spatial one and the pyramid candidate as the temporal one */
+    if (ps_proc->apu1_pyr_ref_luma[i4_reflist][0] != NULL)
     {
-        ps_me_ctxt->i4_skip_type = ps_proc->ps_codec->apf_find_skip_params_me
-                                    [ps_proc->i4_slice_type](ps_proc, i4_reflist);
+        ih264e_pyramid_search(ps_proc, i4_reflist, &mvx, &mvy);
+
+        mvx = CLIP3(i4_srch_range_w, i4_srch_range_e, mvx);
+        mvy = CLIP3(i4_srch_range_n, i4_srch_range_s, mvy);
+
+        ps_me_ctxt->as_mv_init_search[i4_reflist][u4_num_candidates].i2_mvx = mvx;
+        ps_me_ctxt->as_mv_init_search[i4_reflist][u4_num_candidates].i2_mvy = mvy;
+        u4_num_candidates++;
+    }
 
-        /* Taking the Skip motion vector as one of the candidates   */
+    /* Taking the Skip motion vector as one of the candidates. The skip
+     * candidates are kept last, bipred picks them from the end of the list */
+    {
         mvx = (ps_proc->ps_skip_mv[i4_reflist].s_mv.i2_mvx + 2) >> 2;
         mvy = (ps_proc->ps_skip_mv[i4_reflist].s_mv.i2_mvy + 2) >> 2;
 
@@ -359,7 +824,7 @@ static void ih264e_get_search_candidates(process_ctxt_t *ps_proc,
         }
     }
 
-    ASSERT(u4_num_candidates <= 6);
+    ASSERT(u4_num_candidates <= MAX_NUM_INIT_SRCH_CANDS);
 
     ps_me_ctxt->u4_num_candidates[i4_reflist] = u4_num_candidates;
 }
@@ -402,6 +867,12 @@ WORD32 ih264e_find_pskip_params(process_ctxt_t *ps_proc, WORD32 i4_reflist)
 
     UNUSED(i4_reflist);
 
+    /* skip mbs are predicted from the first reference */
+    if (ps_proc->ps_pu->s_me_info[PRED_L0].i1_ref_idx != -1)
+    {
+        return 0;
+    }
+
     ps_left_mb_pu = &ps_proc->s_left_mb_pu ;
     ps_top_mb_pu = ps_proc->ps_top_row_pu + ps_proc->i4_mb_x;
 
@@ -477,7 +948,7 @@ WORD32 ih264e_find_pskip_params_me(process_ctxt_t *ps_proc, WORD32 i4_reflist)
     UNUSED(i4_reflist);
 
     ps_left_mb_pu = &ps_proc->s_left_mb_pu_ME;
-    ps_top_mb_pu = ps_proc->ps_top_row_pu_ME + ps_proc->i4_mb_x;
+    ps_top_mb_pu = ih264e_get_8x8_blk_pu(ps_proc->ps_top_row_pu_ME + ps_proc->i4_mb_x * ENC_MAX_PU_IN_MB, 0, 1);
 
     if ((!ps_proc->ps_ngbr_avbl->u1_mb_a) ||
         (!ps_proc->ps_ngbr_avbl->u1_mb_b) ||
@@ -510,41 +981,92 @@ WORD32 ih264e_find_pskip_params_me(process_ctxt_t *ps_proc, WORD32 i4_reflist)
 /**
 *******************************************************************************
 *
-* @brief motion vector predictor
+* @brief Returns the pu covering an 8x8 block of an mb
 *
 * @par Description:
-*  The routine calculates the motion vector predictor for a given block,
-*  given the candidate MV predictors.
+*  The pus of an mb are stored in partition order in its mv bank slot. The
+*  index of the pu covering the requested 8x8 block is derived from the
+*  dimensions of the first pu of the mb.
 *
-* @param[in] ps_left_mb_pu
-*  pointer to left mb motion vector info
+* @param[in] ps_mb_pu
+*  Pointer to the first pu of the mb
 *
-* @param[in] ps_top_row_pu
-*  pointer to top & top right mb motion vector info
+* @param[in] i4_blk_x
+*  Horizontal index of the 8x8 block (0 or 1)
 *
-* @param[out] ps_pred_mv
-*  pointer to candidate predictors for the current block
+* @param[in] i4_blk_y
+*  Vertical index of the 8x8 block (0 or 1)
 *
-* @returns  The x & y components of the MV predictor.
+* @returns  Pointer to the pu covering the block
 *
-* @remarks The code implements the logic as described in sec 8.4.1.3 in H264
-*   specification.
-*   Assumptions : 1. Assumes Single reference frame
-*                 2. Assumes Only partition of size 16x16
+* @remarks none
 *
 *******************************************************************************
 */
-void ih264e_get_mv_predictor(enc_pu_t *ps_left_mb_pu,
-                             enc_pu_t *ps_top_row_pu,
-                             enc_pu_mv_t *ps_pred_mv,
-                             WORD32 i4_ref_list)
+enc_pu_t *ih264e_get_8x8_blk_pu(enc_pu_t *ps_mb_pu,
+                                WORD32 i4_blk_x,
+                                WORD32 i4_blk_y)
 {
+    WORD32 i4_idx = 0;
 
-    /* Indicated the current ref */
-    WORD8 i1_ref_idx;
-
-    /* For pred L0 */
-    i1_ref_idx = -1;
+    /* 16x8 and 8x8 have two rows of partitions */
+    if (ps_mb_pu->b4_ht != 3)
+    {
+        i4_idx = i4_blk_y * ((ps_mb_pu->b4_wd == 3) ? 1 : 2);
+    }
+
+    /* 8x16 and 8x8 have two columns of partitions */
+    if (ps_mb_pu->b4_wd != 3)
+    {
+        i4_idx += i4_blk_x;
+    }
+
+    return ps_mb_pu + i4_idx;
+}
+
+/**
+*******************************************************************************
+*
+* @brief motion vector predictor
+*
+* @par Description:
+*  The routine calculates the motion vector predictor for a given block,
+*  given the candidate MV predictors.
+*
+* @param[in] ps_left_mb_pu
+*  pointer to left mb motion vector info
+*
+* @param[in] ps_top_row_pu
+*  pointer to top & top right mb motion vector info
+*
+* @param[out] ps_pred_mv
+*  pointer to candidate predictors for the current block
+*
+* @param[in] i4_ref_list
+*  reference list of the prediction
+*
+* @param[in] i4_ref_idx
+*  reference index of the current block in the reference list
+*
+* @returns  The x & y components of the MV predictor.
+*
+* @remarks The code implements the logic as described in sec 8.4.1.3 in H264
+*   specification.
+*   Assumptions : 1. Assumes Only partition of size 16x16
+*
+*******************************************************************************
+*/
+void ih264e_get_mv_predictor(enc_pu_t *ps_left_mb_pu,
+                             enc_pu_t *ps_top_row_pu,
+                             enc_pu_mv_t *ps_pred_mv,
+                             WORD32 i4_ref_list,
+                             WORD32 i4_ref_idx)
+{
+
+    /* Indicated the current ref, ref idx are stored as their complement */
+    WORD8 i1_ref_idx;
+
+    i1_ref_idx = -1 - i4_ref_idx;
     {
         /* temp var */
         WORD32 pred_algo = 3, a, b, c;
@@ -644,6 +1166,14 @@ void ih264e_mv_pred(process_ctxt_t *ps_proc, WORD32 i4_slice_type)
     /* Temp var */
     WORD32 i4_reflist, max_reflist, i4_cmpl_predmode;
 
+    /* ref idx of a P mb, B mbs use the first ref of each list */
+    WORD32 i4_ref_idx = 0;
+
+    if ((i4_slice_type == PSLICE) && !ps_proc->u4_is_intra)
+    {
+        i4_ref_idx = MAX(0, -1 - ps_proc->ps_pu->s_me_info[PRED_L0].i1_ref_idx);
+    }
+
     ps_top_left_syn = &(ps_proc->s_top_left_mb_syntax_ele);
     u4_left_is_intra = ps_proc->s_left_mb_syntax_ele.u2_is_intra;
     ps_left_mb_pu = &ps_proc->s_left_mb_pu;
@@ -699,7 +1229,16 @@ void ih264e_mv_pred(process_ctxt_t *ps_proc, WORD32 i4_slice_type)
             ps_top_row_pu[1].s_me_info[i4_reflist].s_mv = zero_mv;
         }
 
-        ih264e_get_mv_predictor(ps_left_mb_pu, ps_top_row_pu, &ps_pred_mv[i4_reflist], i4_reflist);
+        /* top and top right not available : left is used for all */
+        if (!ps_ngbr_avbl->u1_mb_b && !ps_ngbr_avbl->u1_mb_c && !ps_ngbr_avbl->u1_mb_d
+                        && ps_left_mb_pu->s_me_info[i4_reflist].i1_ref_idx)
+        {
+            ps_top_row_pu[0].s_me_info[i4_reflist] = ps_left_mb_pu->s_me_info[i4_reflist];
+            ps_top_row_pu[1].s_me_info[i4_reflist] = ps_left_mb_pu->s_me_info[i4_reflist];
+        }
+
+        ih264e_get_mv_predictor(ps_left_mb_pu, ps_top_row_pu,
+                                &ps_pred_mv[i4_reflist], i4_reflist, i4_ref_idx);
     }
 
 }
@@ -722,7 +1261,8 @@ void ih264e_mv_pred(process_ctxt_t *ps_proc, WORD32 i4_slice_type)
 *
 *******************************************************************************
 */
-void ih264e_mv_pred_me(process_ctxt_t *ps_proc, WORD32 i4_ref_list)
+void ih264e_mv_pred_me(process_ctxt_t *ps_proc, WORD32 i4_ref_list,
+                       WORD32 i4_ref_idx)
 {
     /* left mb motion vector */
     enc_pu_t *ps_left_mb_pu ;
@@ -733,6 +1273,9 @@ void ih264e_mv_pred_me(process_ctxt_t *ps_proc, WORD32 i4_ref_list)
     /* top row motion vector info */
     enc_pu_t *ps_top_row_pu;
 
+    /* top right mb motion vector */
+    enc_pu_t *ps_top_right_mb_pu;
+
     enc_pu_t s_top_row_pu[2];
 
     /* predicted motion vector */
@@ -749,10 +1292,11 @@ void ih264e_mv_pred_me(process_ctxt_t *ps_proc, WORD32 i4_ref_list)
 
     ps_left_mb_pu = &ps_proc->s_left_mb_pu_ME;
     ps_top_left_mb_pu = &ps_proc->s_top_left_mb_pu_ME;
-    ps_top_row_pu = (ps_proc->ps_top_row_pu_ME + ps_proc->i4_mb_x);
+    ps_top_row_pu = ps_proc->ps_top_row_pu_ME + ps_proc->i4_mb_x * ENC_MAX_PU_IN_MB;
+    ps_top_right_mb_pu = ih264e_get_8x8_blk_pu(ps_top_row_pu + ENC_MAX_PU_IN_MB, 0, 1);
 
-    s_top_row_pu[0] = ps_top_row_pu[0];
-    s_top_row_pu[1] = ps_top_row_pu[1];
+    s_top_row_pu[0] = *ih264e_get_8x8_blk_pu(ps_top_row_pu, 0, 1);
+    s_top_row_pu[1] = *ps_top_right_mb_pu;
 
     /*
      * Before performing mv prediction prepare the ngbr information and
@@ -783,76 +1327,1471 @@ void ih264e_mv_pred_me(process_ctxt_t *ps_proc, WORD32 i4_ref_list)
             s_top_row_pu[1].s_me_info[i4_ref_list].i1_ref_idx = 0;
             s_top_row_pu[1].s_me_info[i4_ref_list].s_mv = zero_mv;
 
-            s_top_row_pu[1].s_me_info[i4_ref_list].i1_ref_idx = 0;
-            s_top_row_pu[1].s_me_info[i4_ref_list].s_mv = zero_mv;
+            s_top_row_pu[1].s_me_info[i4_ref_list].i1_ref_idx = 0;
+            s_top_row_pu[1].s_me_info[i4_ref_list].s_mv = zero_mv;
+        }
+        else
+        {
+            s_top_row_pu[1].s_me_info[i4_ref_list].i1_ref_idx = ps_top_left_mb_pu->s_me_info[0].i1_ref_idx;
+            s_top_row_pu[1].s_me_info[i4_ref_list].s_mv = ps_top_left_mb_pu->s_me_info[0].s_mv;
+        }
+    }
+    else if (ps_top_right_mb_pu->b2_pred_mode == i4_cmpl_predmode)
+    {
+        ps_top_right_mb_pu->s_me_info[i4_ref_list].i1_ref_idx = 0;
+        ps_top_right_mb_pu->s_me_info[i4_ref_list].s_mv = zero_mv;
+    }
+
+    /* top and top right not available : left is used for all */
+    if (!ps_ngbr_avbl->u1_mb_b && !ps_ngbr_avbl->u1_mb_c && !ps_ngbr_avbl->u1_mb_d
+                    && ps_left_mb_pu->s_me_info[i4_ref_list].i1_ref_idx)
+    {
+        s_top_row_pu[0].s_me_info[i4_ref_list] = ps_left_mb_pu->s_me_info[i4_ref_list];
+        s_top_row_pu[1].s_me_info[i4_ref_list] = ps_left_mb_pu->s_me_info[i4_ref_list];
+    }
+
+    ih264e_get_mv_predictor(ps_left_mb_pu, &(s_top_row_pu[0]),
+                            &ps_pred_mv[i4_ref_list], i4_ref_list, i4_ref_idx);
+}
+
+/**
+*******************************************************************************
+*
+* @brief This function performs MV prediction of the sub mb partitions
+*
+* @par Description:
+*  The mvs of the neighboring 8x8 blocks are gathered in a grid that covers
+*  the left, top left, top and top right neighbors of the current mb. The
+*  partitions of the current mb are predicted in decoding order and the grid
+*  is filled with their mvs so that the later partitions can use them.
+*
+* @param[in] ps_proc
+*  Process context corresponding to the job
+*
+* @returns  none
+*
+* @remarks The code implements the logic as described in sec 8.4.1.3 in H264
+*   specification. Only P mbs are supported
+*
+*******************************************************************************
+*/
+void ih264e_mv_pred_mb_part(process_ctxt_t *ps_proc)
+{
+    /* mb neighbor availability */
+    block_neighbors_t *ps_ngbr_avbl = ps_proc->ps_ngbr_avbl;
+
+    /* mb syntax elements of neighbors */
+    mb_info_t *ps_top_syn = ps_proc->ps_top_row_mb_syntax_ele + ps_proc->i4_mb_x;
+
+    /* mvs of the neighbors */
+    enc_pu_t *ps_left_mb_pu = ps_proc->ps_pu - ENC_MAX_PU_IN_MB;
+    enc_pu_t *ps_top_mb_pu = ps_proc->ps_top_row_pu_ME + ps_proc->i4_mb_x * ENC_MAX_PU_IN_MB;
+
+    /* grid of 8x8 blocks, rows -1 to 1 and columns -1 to 2 of the mb. The
+     * refs are stored as their complement, 0 for intra or unavailable */
+    WORD32 ai4_avail[3][4];
+    WORD8 ai1_ref[3][4];
+    mv_t as_mv[3][4];
+
+    /* partition geometry in 8x8 blocks, indexed by mb type - P16x8 */
+    static const UWORD8 au1_part_wd[3] = { 2, 1, 1 };
+    static const UWORD8 au1_part_ht[3] = { 1, 2, 1 };
+
+    /* temp var */
+    WORD32 i4_mb_part = ps_proc->u4_mb_type - P16x8;
+    WORD32 i4_wd = au1_part_wd[i4_mb_part];
+    WORD32 i4_ht = au1_part_ht[i4_mb_part];
+    WORD32 i, j, k, i4_x, i4_y;
+    WORD32 i4_ax, i4_ay, i4_bx, i4_by, i4_cx, i4_cy;
+    WORD32 i4_dir;
+    WORD8 i1_ref_idx;
+    enc_pu_t *ps_pu;
+
+    memset(ai4_avail, 0, sizeof(ai4_avail));
+    memset(ai1_ref, 0, sizeof(ai1_ref));
+    memset(as_mv, 0, sizeof(as_mv));
+
+    /* left */
+    if (ps_ngbr_avbl->u1_mb_a)
+    {
+        for (i = 0; i < 2; i++)
+        {
+            ai4_avail[i + 1][0] = 1;
+            if (!ps_proc->s_left_mb_syntax_ele.u2_is_intra)
+            {
+                ps_pu = ih264e_get_8x8_blk_pu(ps_left_mb_pu, 1, i);
+                ai1_ref[i + 1][0] = ps_pu->s_me_info[PRED_L0].i1_ref_idx;
+                as_mv[i + 1][0] = ps_pu->s_me_info[PRED_L0].s_mv;
+            }
+        }
+    }
+
+    /* top */
+    if (ps_ngbr_avbl->u1_mb_b)
+    {
+        for (j = 0; j < 2; j++)
+        {
+            ai4_avail[0][j + 1] = 1;
+            if (!ps_top_syn->u2_is_intra)
+            {
+                ps_pu = ih264e_get_8x8_blk_pu(ps_top_mb_pu, j, 1);
+                ai1_ref[0][j + 1] = ps_pu->s_me_info[PRED_L0].i1_ref_idx;
+                as_mv[0][j + 1] = ps_pu->s_me_info[PRED_L0].s_mv;
+            }
+        }
+    }
+
+    /* top left */
+    if (ps_ngbr_avbl->u1_mb_d)
+    {
+        ai4_avail[0][0] = 1;
+        if (!ps_proc->s_top_left_mb_syntax_ele.u2_is_intra)
+        {
+            ps_pu = ih264e_get_8x8_blk_pu(ps_top_mb_pu - ENC_MAX_PU_IN_MB, 1, 1);
+            ai1_ref[0][0] = ps_pu->s_me_info[PRED_L0].i1_ref_idx;
+            as_mv[0][0] = ps_pu->s_me_info[PRED_L0].s_mv;
+        }
+    }
+
+    /* top right */
+    if (ps_ngbr_avbl->u1_mb_c)
+    {
+        ai4_avail[0][3] = 1;
+        if (!ps_top_syn[1].u2_is_intra)
+        {
+            ps_pu = ih264e_get_8x8_blk_pu(ps_top_mb_pu + ENC_MAX_PU_IN_MB, 0, 1);
+            ai1_ref[0][3] = ps_pu->s_me_info[PRED_L0].i1_ref_idx;
+            as_mv[0][3] = ps_pu->s_me_info[PRED_L0].s_mv;
+        }
+    }
+
+    for (k = 0; k < (WORD32)ps_proc->u4_num_sub_partitions; k++)
+    {
+        mv_t *ps_mv_pred = &ps_proc->as_part_pred_mv[k];
+
+        ps_pu = ps_proc->ps_pu + k;
+        i1_ref_idx = ps_pu->s_me_info[PRED_L0].i1_ref_idx;
+
+        /* partition position in the grid */
+        i4_x = (ps_pu->b4_pos_x >> 1) + 1;
+        i4_y = (ps_pu->b4_pos_y >> 1) + 1;
+
+        /* neighbors A, B and C (or D) */
+        i4_ax = i4_x - 1;
+        i4_ay = i4_y;
+        i4_bx = i4_x;
+        i4_by = i4_y - 1;
+        i4_cx = i4_x + i4_wd;
+        i4_cy = i4_y - 1;
+
+        if (!ai4_avail[i4_cy][i4_cx])
+        {
+            i4_cx = i4_x - 1;
+        }
+
+        /* directional prediction of 16x8 and 8x16 */
+        i4_dir = -1;
+        if (ps_proc->u4_mb_type == P16x8)
+        {
+            if (k == 0 && ai1_ref[i4_by][i4_bx] == i1_ref_idx)
+                i4_dir = 1;
+            else if (k == 1 && ai1_ref[i4_ay][i4_ax] == i1_ref_idx)
+                i4_dir = 0;
+        }
+        else if (ps_proc->u4_mb_type == P8x16)
+        {
+            if (k == 0 && ai1_ref[i4_ay][i4_ax] == i1_ref_idx)
+                i4_dir = 0;
+            else if (k == 1 && ai1_ref[i4_cy][i4_cx] == i1_ref_idx)
+                i4_dir = 2;
+        }
+
+        if (i4_dir == 0)
+        {
+            *ps_mv_pred = as_mv[i4_ay][i4_ax];
+        }
+        else if (i4_dir == 1)
+        {
+            *ps_mv_pred = as_mv[i4_by][i4_bx];
+        }
+        else if (i4_dir == 2)
+        {
+            *ps_mv_pred = as_mv[i4_cy][i4_cx];
+        }
+        else
+        {
+            /* neighbors in the order A, B, C */
+            WORD32 ai4_m[3];
+            mv_t as_n[3];
+
+            ai4_m[0] = (ai1_ref[i4_ay][i4_ax] == i1_ref_idx);
+            ai4_m[1] = (ai1_ref[i4_by][i4_bx] == i1_ref_idx);
+            ai4_m[2] = (ai1_ref[i4_cy][i4_cx] == i1_ref_idx);
+            as_n[0] = as_mv[i4_ay][i4_ax];
+            as_n[1] = as_mv[i4_by][i4_bx];
+            as_n[2] = as_mv[i4_cy][i4_cx];
+
+            /* B and C not available, A available : use A for all */
+            if (!ai4_avail[i4_by][i4_bx] && !ai4_avail[i4_cy][i4_cx]
+                            && ai4_avail[i4_ay][i4_ax])
+            {
+                ai4_m[1] = ai4_m[2] = ai4_m[0];
+                as_n[1] = as_n[2] = as_n[0];
+            }
+
+            if (ai4_m[0] + ai4_m[1] + ai4_m[2] == 1)
+            {
+                *ps_mv_pred = ai4_m[0] ? as_n[0] : (ai4_m[1] ? as_n[1] : as_n[2]);
+            }
+            else
+            {
+                MEDIAN(as_n[0].i2_mvx, as_n[1].i2_mvx, as_n[2].i2_mvx, ps_mv_pred->i2_mvx);
+                MEDIAN(as_n[0].i2_mvy, as_n[1].i2_mvy, as_n[2].i2_mvy, ps_mv_pred->i2_mvy);
+            }
+        }
+
+        /* fill the grid with the mv of the partition */
+        for (i = i4_y; i < i4_y + i4_ht; i++)
+        {
+            for (j = i4_x; j < i4_x + i4_wd; j++)
+            {
+                ai4_avail[i][j] = 1;
+                ai1_ref[i][j] = i1_ref_idx;
+                as_mv[i][j] = ps_pu->s_me_info[PRED_L0].s_mv;
+            }
+        }
+    }
+}
+
+/**
+*******************************************************************************
+*
+* @brief This function initializes me ctxt
+*
+* @par Description:
+*  Before dispatching the current job to me thread, the me context associated
+*  with the job is initialized.
+*
+* @param[in] ps_proc
+*  Process context corresponding to the job
+*
+* @returns  none
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+void ih264e_init_me(process_ctxt_t *ps_proc)
+{
+    /* me ctxt */
+    me_ctxt_t *ps_me_ctxt = &ps_proc->s_me_ctxt;
+
+    /* codec context */
+    codec_t *ps_codec = ps_proc->ps_codec;
+
+    ps_me_ctxt->i4_skip_bias[BSLICE] = SKIP_BIAS_B;
+
+    if (ps_codec->s_cfg.u4_num_bframes == 0)
+    {
+       ps_me_ctxt->i4_skip_bias[PSLICE] = 4 * SKIP_BIAS_P;
+    }
+    else
+    {
+       ps_me_ctxt->i4_skip_bias[PSLICE] =  SKIP_BIAS_P;
+    }
+
+    /* src ptr */
+    ps_me_ctxt->pu1_src_buf_luma = ps_proc->pu1_src_buf_luma;
+    /* src stride */
+    ps_me_ctxt->i4_src_strd = ps_proc->i4_src_strd;
+
+    /* ref ptrs and corresponding lagrange params */
+    ps_me_ctxt->apu1_ref_buf_luma[0] = ps_proc->apu1_ref_buf_luma[0];
+    ps_me_ctxt->apu1_ref_buf_luma[1] = ps_proc->apu1_ref_buf_luma[1];
+
+    ps_me_ctxt->u4_lambda_motion = gu1_qp0[ps_me_ctxt->u1_mb_qp];
+
+
+}
+
+
+/**
+*******************************************************************************
+*
+* @brief Computes the sad of a sub mb partition
+*
+* @par Description:
+*  Computes the sad of a 16x8, 8x16 or 8x8 block using the 16x8 and 8x8 sad
+*  kernels of the me context. The computation exits early once the sad
+*  exceeds the maximum allowed sad.
+*
+* @param[in] ps_me_ctxt
+*  Pointer to me context
+*
+* @param[in] pu1_src
+*  Pointer to the source block
+*
+* @param[in] pu1_ref
+*  Pointer to the reference block
+*
+* @param[in] i4_src_strd
+*  Source stride
+*
+* @param[in] i4_ref_strd
+*  Reference stride
+*
+* @param[in] i4_wd
+*  Width of the partition
+*
+* @param[in] i4_ht
+*  Height of the partition
+*
+* @param[in] i4_max_sad
+*  Maximum allowed sad
+*
+* @param[out] pi4_sad
+*  Sad of the partition
+*
+* @returns  none
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static void ih264e_compute_sad_mb_part(me_ctxt_t *ps_me_ctxt,
+                                       UWORD8 *pu1_src,
+                                       UWORD8 *pu1_ref,
+                                       WORD32 i4_src_strd,
+                                       WORD32 i4_ref_strd,
+                                       WORD32 i4_wd,
+                                       WORD32 i4_ht,
+                                       WORD32 i4_max_sad,
+                                       WORD32 *pi4_sad)
+{
+    /* sad of the bottom half of a 8x16 partition */
+    WORD32 i4_sad_bot;
+
+    if (i4_wd == MB_SIZE)
+    {
+        ps_me_ctxt->pf_ime_compute_sad_16x8(pu1_src, pu1_ref, i4_src_strd,
+                                            i4_ref_strd, i4_max_sad, pi4_sad);
+        return;
+    }
+
+    ps_me_ctxt->pf_ime_compute_sad_8x8(pu1_src, pu1_ref, i4_src_strd,
+                                       i4_ref_strd, i4_max_sad, pi4_sad);
+
+    if ((i4_ht == MB_SIZE) && (*pi4_sad <= i4_max_sad))
+    {
+        ps_me_ctxt->pf_ime_compute_sad_8x8(pu1_src + 8 * i4_src_strd,
+                                           pu1_ref + 8 * i4_ref_strd,
+                                           i4_src_strd, i4_ref_strd,
+                                           i4_max_sad - *pi4_sad, &i4_sad_bot);
+        *pi4_sad += i4_sad_bot;
+    }
+}
+
+/**
+*******************************************************************************
+*
+* @brief Evaluates a full pel motion vector for a sub mb partition
+*
+* @par Description:
+*  Computes the cost of the given full pel mv for the partition and updates
+*  the partition context if it is lower than the least cost found so far
+*
+* @param[in] ps_me_ctxt
+*  Pointer to me context
+*
+* @param[in] pu1_src
+*  Pointer to the source partition
+*
+* @param[in] pu1_ref
+*  Pointer to the co-located reference partition
+*
+* @param[in] i4_wd
+*  Width of the partition
+*
+* @param[in] i4_ht
+*  Height of the partition
+*
+* @param[in] i2_mvx
+*  Horizontal mv in full pel units
+*
+* @param[in] i2_mvy
+*  Vertical mv in full pel units
+*
+* @param[out] ps_part
+*  Partition context holding the best mv, cost and distortion
+*
+* @returns  none
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static void ih264e_eval_mb_part_fpel(me_ctxt_t *ps_me_ctxt,
+                                     UWORD8 *pu1_src,
+                                     UWORD8 *pu1_ref,
+                                     WORD32 i4_wd,
+                                     WORD32 i4_ht,
+                                     WORD16 i2_mvx,
+                                     WORD16 i2_mvy,
+                                     mb_part_ctxt *ps_part)
+{
+    /* mv bits */
+    UWORD8 *pu1_mv_bits = ps_me_ctxt->pu1_mv_bits;
+
+    /* temp var */
+    WORD32 i4_sad, i4_cost;
+
+    ih264e_compute_sad_mb_part(ps_me_ctxt, pu1_src,
+                               pu1_ref + i2_mvx + i2_mvy * ps_me_ctxt->i4_rec_strd,
+                               ps_me_ctxt->i4_src_strd, ps_me_ctxt->i4_rec_strd,
+                               i4_wd, i4_ht, ps_part->i4_mb_cost, &i4_sad);
+
+    i4_cost = i4_sad + ps_me_ctxt->u4_lambda_motion * (pu1_mv_bits[(i2_mvx << 2) - ps_part->s_mv_pred.i2_mvx]
+                                                     + pu1_mv_bits[(i2_mvy << 2) - ps_part->s_mv_pred.i2_mvy]);
+
+    if (i4_cost < ps_part->i4_mb_cost)
+    {
+        ps_part->i4_mb_cost = i4_cost;
+        ps_part->i4_mb_distortion = i4_sad;
+        ps_part->s_mv_curr.i2_mvx = i2_mvx;
+        ps_part->s_mv_curr.i2_mvy = i2_mvy;
+    }
+}
+
+/**
+*******************************************************************************
+*
+* @brief Full pel search for a sub mb partition
+*
+* @par Description:
+*  The candidates are clipped to the search window of the 16x16 search and
+*  evaluated. The best of them is refined with a small diamond search.
+*
+* @param[in] ps_me_ctxt
+*  Pointer to me context
+*
+* @param[in] i4_blk_x
+*  Horizontal offset of the partition in the mb in pels
+*
+* @param[in] i4_blk_y
+*  Vertical offset of the partition in the mb in pels
+*
+* @param[in] i4_wd
+*  Width of the partition
+*
+* @param[in] i4_ht
+*  Height of the partition
+*
+* @param[in] ps_cands
+*  Full pel search candidates
+*
+* @param[in] i4_num_cands
+*  Number of search candidates
+*
+* @param[in/out] ps_part
+*  Partition context. The mv predictor is to be set by the caller. Returns
+*  the best full pel mv, its cost and distortion
+*
+* @returns  none
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static void ih264e_mb_part_fpel_search(me_ctxt_t *ps_me_ctxt,
+                                       WORD32 i4_blk_x,
+                                       WORD32 i4_blk_y,
+                                       WORD32 i4_wd,
+                                       WORD32 i4_ht,
+                                       ime_mv_t *ps_cands,
+                                       WORD32 i4_num_cands,
+                                       mb_part_ctxt *ps_part)
+{
+    /* pointers to the partition */
+    UWORD8 *pu1_src = ps_me_ctxt->pu1_src_buf_luma
+                    + i4_blk_y * ps_me_ctxt->i4_src_strd + i4_blk_x;
+    UWORD8 *pu1_ref = ps_me_ctxt->apu1_ref_buf_luma[PRED_L0]
+                    + i4_blk_y * ps_me_ctxt->i4_rec_strd + i4_blk_x;
+
+    /* Diamond search Iteration Max Cnt */
+    UWORD32 u4_num_layers = ps_me_ctxt->u4_num_layers;
+
+    /* temp var */
+    WORD16 i2_mvx, i2_mvy;
+    WORD32 i;
+
+    ps_part->i4_mb_cost = INT_MAX;
+    ps_part->i4_mb_distortion = INT_MAX;
+    ps_part->s_mv_curr.i2_mvx = 0;
+    ps_part->s_mv_curr.i2_mvy = 0;
+
+    for (i = 0; i < i4_num_cands; i++)
+    {
+        i2_mvx = CLIP3(ps_me_ctxt->i4_srch_range_w, ps_me_ctxt->i4_srch_range_e, ps_cands[i].i2_mvx);
+        i2_mvy = CLIP3(ps_me_ctxt->i4_srch_range_n, ps_me_ctxt->i4_srch_range_s, ps_cands[i].i2_mvy);
+
+        ih264e_eval_mb_part_fpel(ps_me_ctxt, pu1_src, pu1_ref, i4_wd, i4_ht,
+                                 i2_mvx, i2_mvy, ps_part);
+    }
+
+    while (u4_num_layers--)
+    {
+        i2_mvx = ps_part->s_mv_curr.i2_mvx;
+        i2_mvy = ps_part->s_mv_curr.i2_mvy;
+
+        if ((i2_mvx - 1 < ps_me_ctxt->i4_srch_range_w) ||
+                        (i2_mvx + 1 > ps_me_ctxt->i4_srch_range_e) ||
+                        (i2_mvy - 1 < ps_me_ctxt->i4_srch_range_n) ||
+                        (i2_mvy + 1 > ps_me_ctxt->i4_srch_range_s))
+        {
+            break;
+        }
+
+        ih264e_eval_mb_part_fpel(ps_me_ctxt, pu1_src, pu1_ref, i4_wd, i4_ht, i2_mvx - 1, i2_mvy, ps_part);
+        ih264e_eval_mb_part_fpel(ps_me_ctxt, pu1_src, pu1_ref, i4_wd, i4_ht, i2_mvx + 1, i2_mvy, ps_part);
+        ih264e_eval_mb_part_fpel(ps_me_ctxt, pu1_src, pu1_ref, i4_wd, i4_ht, i2_mvx, i2_mvy - 1, ps_part);
+        ih264e_eval_mb_part_fpel(ps_me_ctxt, pu1_src, pu1_ref, i4_wd, i4_ht, i2_mvx, i2_mvy + 1, ps_part);
+
+        /* converged */
+        if ((i2_mvx == ps_part->s_mv_curr.i2_mvx) && (i2_mvy == ps_part->s_mv_curr.i2_mvy))
+        {
+            break;
+        }
+    }
+}
+
+/**
+*******************************************************************************
+*
+* @brief Sub pel refinement for a sub mb partition
+*
+* @par Description:
+*  The eight positions at the given sub pel step around the current mv of the
+*  partition are interpolated with the inter pred leaf level functions and
+*  evaluated. A step of 2 refines a full pel mv to half pel and a step of 1
+*  refines a half pel mv to quarter pel.
+*
+* @param[in] ps_proc
+*  Process context corresponding to the job
+*
+* @param[in] i4_blk_x
+*  Horizontal offset of the partition in the mb in pels
+*
+* @param[in] i4_blk_y
+*  Vertical offset of the partition in the mb in pels
+*
+* @param[in] i4_wd
+*  Width of the partition
+*
+* @param[in] i4_ht
+*  Height of the partition
+*
+* @param[in] i4_step
+*  Sub pel step in qpel units
+*
+* @param[in/out] ps_part
+*  Partition context with the mv in qpel units
+*
+* @returns  none
+*
+* @remarks The prediction buffer of the process context is used as scratch
+*
+*******************************************************************************
+*/
+static void ih264e_mb_part_subpel_search(process_ctxt_t *ps_proc,
+                                         WORD32 i4_blk_x,
+                                         WORD32 i4_blk_y,
+                                         WORD32 i4_wd,
+                                         WORD32 i4_ht,
+                                         WORD32 i4_step,
+                                         mb_part_ctxt *ps_part)
+{
+    /* codec context */
+    codec_t *ps_codec = ps_proc->ps_codec;
+
+    /* me ctxt */
+    me_ctxt_t *ps_me_ctxt = &ps_proc->s_me_ctxt;
+
+    /* strides */
+    WORD32 i4_rec_strd = ps_me_ctxt->i4_rec_strd;
+    WORD32 i4_pred_strd = ps_proc->i4_pred_strd;
+
+    /* pointers to the partition */
+    UWORD8 *pu1_src = ps_me_ctxt->pu1_src_buf_luma
+                    + i4_blk_y * ps_me_ctxt->i4_src_strd + i4_blk_x;
+    UWORD8 *pu1_ref = ps_me_ctxt->apu1_ref_buf_luma[PRED_L0]
+                    + i4_blk_y * i4_rec_strd + i4_blk_x;
+    UWORD8 *pu1_pred = ps_proc->pu1_pred_mb + i4_blk_y * i4_pred_strd + i4_blk_x;
+
+    /* mv bits */
+    UWORD8 *pu1_mv_bits = ps_me_ctxt->pu1_mv_bits;
+
+    /* mv being refined */
+    WORD16 i2_mvx_ctr = ps_part->s_mv_curr.i2_mvx;
+    WORD16 i2_mvy_ctr = ps_part->s_mv_curr.i2_mvy;
+
+    /* temp var */
+    WORD32 i4_sad, i4_cost, i4_dydx, i, j;
+    WORD16 i2_mvx, i2_mvy;
+
+    for (i = -i4_step; i <= i4_step; i += i4_step)
+    {
+        for (j = -i4_step; j <= i4_step; j += i4_step)
+        {
+            if (i == 0 && j == 0)
+                continue;
+
+            i2_mvx = i2_mvx_ctr + j;
+            i2_mvy = i2_mvy_ctr + i;
+
+            if ((i2_mvx < (ps_me_ctxt->i4_srch_range_w << 2)) ||
+                            (i2_mvx > (ps_me_ctxt->i4_srch_range_e << 2)) ||
+                            (i2_mvy < (ps_me_ctxt->i4_srch_range_n << 2)) ||
+                            (i2_mvy > (ps_me_ctxt->i4_srch_range_s << 2)))
+            {
+                continue;
+            }
+
+            i4_dydx = ((i2_mvy & 3) << 2) | (i2_mvx & 3);
+
+            ps_codec->apf_inter_pred_luma[i4_dydx](pu1_ref + (i2_mvy >> 2) * i4_rec_strd + (i2_mvx >> 2),
+                                                   pu1_pred, i4_rec_strd, i4_pred_strd,
+                                                   i4_ht, i4_wd,
+                                                   (UWORD8 *)ps_proc->ai16_pred1, i4_dydx);
+
+            ih264e_compute_sad_mb_part(ps_me_ctxt, pu1_src, pu1_pred,
+                                       ps_me_ctxt->i4_src_strd, i4_pred_strd,
+                                       i4_wd, i4_ht, ps_part->i4_mb_cost, &i4_sad);
+
+            i4_cost = i4_sad + ps_me_ctxt->u4_lambda_motion * (pu1_mv_bits[i2_mvx - ps_part->s_mv_pred.i2_mvx]
+                                                             + pu1_mv_bits[i2_mvy - ps_part->s_mv_pred.i2_mvy]);
+
+            if (i4_cost < ps_part->i4_mb_cost)
+            {
+                ps_part->i4_mb_cost = i4_cost;
+                ps_part->i4_mb_distortion = i4_sad;
+                ps_part->s_mv_curr.i2_mvx = i2_mvx;
+                ps_part->s_mv_curr.i2_mvy = i2_mvy;
+            }
+        }
+    }
+}
+
+/**
+*******************************************************************************
+*
+* @brief Returns the number of bits of a ref_idx_l0 syntax element
+*
+* @par Description:
+*  ref_idx is coded as te(v). It takes one bit when there are two active
+*  references, the length of its ue(v) code otherwise and none when there is
+*  a single reference
+*
+* @param[in] i4_ref_idx
+*  Reference index
+*
+* @param[in] i4_num_ref
+*  Number of active references
+*
+* @returns  Number of bits
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static WORD32 ih264e_get_ref_idx_bits(WORD32 i4_ref_idx, WORD32 i4_num_ref)
+{
+    WORD32 i4_bits = 1;
+
+    if (i4_num_ref <= 1)
+    {
+        return 0;
+    }
+
+    if (i4_num_ref == 2)
+    {
+        return 1;
+    }
+
+    i4_ref_idx++;
+    while (i4_ref_idx >>= 1)
+    {
+        i4_bits += 2;
+    }
+
+    return i4_bits;
+}
+
+/**
+*******************************************************************************
+*
+* @brief Quarter pel refinement of the 16x16 half pel mv of a reference list
+*
+* @par Description:
+*  The eight quarter pel positions around the best half pel mv are
+*  interpolated from the full pel reference only when they are evaluated, no
+*  quarter pel planes are generated. The predictions alternate between two sub
+*  pel buffers that do not hold the best half pel prediction, so the buffer of
+*  the best mv remains valid for the copy to the best sub pel buffer.
+*
+* @param[in] ps_proc
+*  Process context corresponding to the job
+*
+* @param[in] i4_reflist
+*  Reference list
+*
+* @returns  none
+*
+* @remarks The mv of the mb part ctxt is expected in qpel units
+*
+*******************************************************************************
+*/
+static void ih264e_qpel_search_16x16(process_ctxt_t *ps_proc, WORD32 i4_reflist)
+{
+    /* codec context */
+    codec_t *ps_codec = ps_proc->ps_codec;
+
+    /* me ctxt */
+    me_ctxt_t *ps_me_ctxt = &ps_proc->s_me_ctxt;
+
+    /* mb part ctxt */
+    mb_part_ctxt *ps_mb_part = &ps_me_ctxt->as_mb_part[i4_reflist];
+
+    /* strides */
+    WORD32 i4_rec_strd = ps_me_ctxt->i4_rec_strd;
+    WORD32 i4_buf_strd = ps_me_ctxt->u4_subpel_buf_strd;
+
+    /* reference of the mb */
+    UWORD8 *pu1_ref = ps_me_ctxt->apu1_ref_buf_luma[i4_reflist];
+
+    /* mv bits */
+    UWORD8 *pu1_mv_bits = ps_me_ctxt->pu1_mv_bits;
+
+    /* prediction buffers of the quarter pel positions */
+    UWORD8 *apu1_qpel_buf[2];
+    WORD32 i4_buf_idx = 0;
+
+    /* best half pel mv */
+    WORD16 i2_mvx_hpel = ps_mb_part->s_mv_curr.i2_mvx;
+    WORD16 i2_mvy_hpel = ps_mb_part->s_mv_curr.i2_mvy;
+
+    /* temp var */
+    WORD32 i4_sad, i4_cost, i4_dydx, i, j;
+    WORD16 i2_mvx, i2_mvy;
+
+    apu1_qpel_buf[0] = ps_proc->apu1_subpel_buffs[SUBPEL_BUFF_CNT - 1];
+    apu1_qpel_buf[1] = ps_proc->apu1_subpel_buffs[0];
+    if (ps_mb_part->pu1_best_hpel_buf)
+    {
+        apu1_qpel_buf[1] = ps_proc->apu1_subpel_buffs[(ps_mb_part->i4_srch_pos_idx + 1) % 3];
+    }
+
+    for (i = -1; i <= 1; i++)
+    {
+        for (j = -1; j <= 1; j++)
+        {
+            if (i == 0 && j == 0)
+                continue;
+
+            i2_mvx = i2_mvx_hpel + j;
+            i2_mvy = i2_mvy_hpel + i;
+
+            if ((i2_mvx < (ps_me_ctxt->i4_srch_range_w << 2)) ||
+                            (i2_mvx > (ps_me_ctxt->i4_srch_range_e << 2)) ||
+                            (i2_mvy < (ps_me_ctxt->i4_srch_range_n << 2)) ||
+                            (i2_mvy > (ps_me_ctxt->i4_srch_range_s << 2)))
+            {
+                continue;
+            }
+
+            i4_dydx = ((i2_mvy & 3) << 2) | (i2_mvx & 3);
+
+            ps_codec->apf_inter_pred_luma[i4_dydx](pu1_ref + (i2_mvy >> 2) * i4_rec_strd + (i2_mvx >> 2),
+                                                   apu1_qpel_buf[i4_buf_idx], i4_rec_strd, i4_buf_strd,
+                                                   MB_SIZE, MB_SIZE,
+                                                   (UWORD8 *)ps_proc->ai16_pred1, i4_dydx);
+
+            ps_me_ctxt->pf_ime_compute_sad_16x16[ps_me_ctxt->u4_enable_fast_sad](
+                            ps_me_ctxt->pu1_src_buf_luma, apu1_qpel_buf[i4_buf_idx],
+                            ps_me_ctxt->i4_src_strd, i4_buf_strd,
+                            ps_mb_part->i4_mb_cost, &i4_sad);
+
+            i4_cost = i4_sad + ps_me_ctxt->u4_lambda_motion * (pu1_mv_bits[i2_mvx - ps_mb_part->s_mv_pred.i2_mvx]
+                                                             + pu1_mv_bits[i2_mvy - ps_mb_part->s_mv_pred.i2_mvy]);
+
+            if (i4_cost < ps_mb_part->i4_mb_cost)
+            {
+                ps_mb_part->i4_mb_cost = i4_cost;
+                ps_mb_part->i4_mb_distortion = i4_sad;
+                ps_mb_part->s_mv_curr.i2_mvx = i2_mvx;
+                ps_mb_part->s_mv_curr.i2_mvy = i2_mvy;
+                ps_mb_part->pu1_best_hpel_buf = apu1_qpel_buf[i4_buf_idx];
+
+                /* keep the best prediction, predict into the other buffer */
+                i4_buf_idx = !i4_buf_idx;
+            }
+        }
+    }
+}
+
+/**
+*******************************************************************************
+*
+* @brief Half pel refinement of the 16x16 full pel mv of a reference list
+*
+* @par Description:
+*  The half pel planes around the converged full pel mv are generated in the
+*  sub pel buffers of the process context and the half pel positions are
+*  evaluated
+*
+* @param[in] ps_proc
+*  Process context corresponding to the job
+*
+* @param[in] i4_reflist
+*  Reference list
+*
+* @returns  none
+*
+* @remarks The mv of the mb part ctxt is expected in qpel units
+*
+*******************************************************************************
+*/
+static void ih264e_hpel_search_16x16(process_ctxt_t *ps_proc, WORD32 i4_reflist)
+{
+    /* me ctxt */
+    me_ctxt_t *ps_me_ctxt = &ps_proc->s_me_ctxt;
+
+    /* codec context */
+    codec_t *ps_codec = ps_proc->ps_codec;
+
+    /* recon stride */
+    WORD32 i4_rec_strd = ps_proc->i4_rec_strd;
+
+    /* source buffer for halp pel generation functions */
+    UWORD8 *pu1_hpel_src;
+
+    /* moving src pointer to the converged motion vector location*/
+    pu1_hpel_src =   ps_me_ctxt->apu1_ref_buf_luma[i4_reflist]
+                     + (ps_me_ctxt->as_mb_part[i4_reflist].s_mv_curr.i2_mvx >> 2)
+                     + (ps_me_ctxt->as_mb_part[i4_reflist].s_mv_curr.i2_mvy >> 2)* i4_rec_strd;
+
+    ps_me_ctxt->apu1_subpel_buffs[0] = ps_proc->apu1_subpel_buffs[0];
+    ps_me_ctxt->apu1_subpel_buffs[1] = ps_proc->apu1_subpel_buffs[1];
+    ps_me_ctxt->apu1_subpel_buffs[2] = ps_proc->apu1_subpel_buffs[2];
+
+    ps_me_ctxt->u4_subpel_buf_strd = HP_BUFF_WD;
+
+    /* half  pel search is done for both sides of full pel,
+     * hence half_x of width x height = 17x16 is created
+     * starting from left half_x of converged full pel */
+    pu1_hpel_src -= 1;
+
+    /* computing half_x */
+    ps_codec->pf_ih264e_sixtapfilter_horz(pu1_hpel_src,
+                                          ps_me_ctxt->apu1_subpel_buffs[0],
+                                          i4_rec_strd,
+                                          ps_me_ctxt->u4_subpel_buf_strd);
+
+    /*
+     * Halfpel search is done for both sides of full pel,
+     * hence half_y of width x height = 16x17 is created
+     * starting from top half_y of converged full pel
+     * for half_xy top_left is required
+     * hence it starts from pu1_hpel_src = full_pel_converged_point - i4_rec_strd - 1
+     */
+    pu1_hpel_src -= i4_rec_strd;
+
+    /* computing half_y , and half_xy*/
+    ps_codec->pf_ih264e_sixtap_filter_2dvh_vert(
+                    pu1_hpel_src, ps_me_ctxt->apu1_subpel_buffs[1],
+                    ps_me_ctxt->apu1_subpel_buffs[2], i4_rec_strd,
+                    ps_me_ctxt->u4_subpel_buf_strd, ps_proc->ai16_pred1 + 3,
+                    ps_me_ctxt->u4_subpel_buf_strd);
+
+    ime_sub_pel_motion_estimation_16x16(ps_me_ctxt, i4_reflist);
+
+    if (ps_me_ctxt->u4_enable_qpel)
+    {
+        ih264e_qpel_search_16x16(ps_proc, i4_reflist);
+    }
+}
+
+/**
+*******************************************************************************
+*
+* @brief Searches the L0 references other than the first one for a P mb
+*
+* @par Description:
+*  Each additional reference is first evaluated only at a few candidates, the
+*  zero mv, its mv predictor, the mvs of the neighbors using the same
+*  reference and the mv of the first reference scaled by the poc distance.
+*  The full pel and half pel searches are then run only for the (at most) two
+*  references with the least candidate cost and only if that cost is close
+*  to the cost of the first reference or of the skip. Hence the cost of the
+*  search grows slowly with the number of references. Each reference is costed
+*  with the mvd against its own mv predictor and its ref_idx bits. The best of
+*  the searched references replaces the result of the first reference only if
+*  it is cheaper than both the first reference (with its ref_idx bits) and the
+*  skip, which codes neither a ref_idx nor an mvd.
+*
+* @param[in] ps_proc
+*  Process context corresponding to the job
+*
+* @param[in] pi4_srch_range
+*  Search range (w, e, n, s) before the full pel search of the first reference
+*
+* @param[in/out] ps_mv_16x16
+*  Full pel mv of the best reference
+*
+* @param[in/out] pi4_cost_16x16
+*  Full pel cost of the best reference
+*
+* @param[in] i4_skip_cost
+*  Cost of the skip mv of the first reference, INT_MAX if not evaluated
+*
+* @param[out] pi4_ref_idx
+*  Best reference
+*
+* @returns  none
+*
+* @remarks The mb part ctxt of L0 is expected to hold the result of the first
+*  reference. The me ctxt ref pointer of L0 is left pointing to the best
+*  reference
+*
+*******************************************************************************
+*/
+static void ih264e_search_l0_refs(process_ctxt_t *ps_proc,
+                                  WORD32 *pi4_srch_range,
+                                  ime_mv_t *ps_mv_16x16,
+                                  WORD32 *pi4_cost_16x16,
+                                  WORD32 i4_skip_cost,
+                                  WORD32 *pi4_ref_idx)
+{
+    /* me ctxt */
+    me_ctxt_t *ps_me_ctxt = &ps_proc->s_me_ctxt;
+
+    /* codec context */
+    codec_t *ps_codec = ps_proc->ps_codec;
+
+    /* mb part ctxt of L0 */
+    mb_part_ctxt *ps_mb_part = &ps_me_ctxt->as_mb_part[PRED_L0];
+
+    /* number of active refs */
+    WORD32 i4_num_ref = ps_proc->i4_num_ref_idx_l0_active;
+
+    /* offset of the current mb in the reference planes */
+    WORD32 i4_mb_ofst = ps_proc->apu1_ref_buf_luma[PRED_L0]
+                    - ps_proc->apu1_ref_buf_luma_base[PRED_L0];
+
+    /* neighbors of the mb */
+    block_neighbors_t *ps_ngbr_avbl = ps_proc->ps_ngbr_avbl;
+    enc_pu_t *ps_top_row_pu = ps_proc->ps_top_row_pu_ME + ps_proc->i4_mb_x * ENC_MAX_PU_IN_MB;
+    enc_pu_t *aps_ngbr_pu[3];
+
+    /* predictor of the first reference */
+    enc_pu_mv_t s_pred_mv_ref0 = ps_proc->ps_pred_mv[PRED_L0];
+
+    /* best result and its predictor, search range and ref pointer */
+    mb_part_ctxt s_best = *ps_mb_part;
+    WORD32 ai4_best_range[4];
+    UWORD8 *pu1_best_ref = ps_me_ctxt->apu1_ref_buf_luma[PRED_L0];
+
+    /* candidate result of each reference */
+    mb_part_ctxt as_cand[MAX_REF_PIC_CNT];
+
+    /* two references with least candidate cost */
+    WORD32 ai4_sel_ref[2] = { -1, -1 };
+    WORD32 ai4_sel_cost[2] = { INT_MAX, INT_MAX };
+
+    /* full pel result of the first reference and its poc distance */
+    ime_mv_t s_mv_ref0 = *ps_mv_16x16;
+    WORD32 i4_poc_dist0 = ps_proc->ai4_ref_l0_poc_dist[0];
+
+    /* lambda and ref idx bits of the first reference */
+    WORD32 i4_lambda = ps_me_ctxt->u4_lambda_motion;
+    WORD32 i4_ref_bits0 = ih264e_get_ref_idx_bits(0, i4_num_ref);
+
+    /* cost to beat, the first reference with its ref_idx bits or the skip */
+    WORD32 i4_best_cost = MIN(s_best.i4_mb_cost + i4_lambda * i4_ref_bits0, i4_skip_cost);
+
+    /* full pel cost below which a reference is searched */
+    WORD32 i4_prune_cost = MIN(*pi4_cost_16x16 + i4_lambda * i4_ref_bits0, i4_skip_cost);
+
+    /* temp var */
+    WORD32 i, k, i4_cost, i4_num_cands, i4_num_ngbr = 0;
+    ime_mv_t *ps_cands = ps_me_ctxt->as_mv_init_search[PRED_L0];
+
+    ai4_best_range[0] = ps_me_ctxt->i4_srch_range_w;
+    ai4_best_range[1] = ps_me_ctxt->i4_srch_range_e;
+    ai4_best_range[2] = ps_me_ctxt->i4_srch_range_n;
+    ai4_best_range[3] = ps_me_ctxt->i4_srch_range_s;
+
+    if (ps_ngbr_avbl->u1_mb_a)
+    {
+        aps_ngbr_pu[i4_num_ngbr++] = &ps_proc->s_left_mb_pu_ME;
+    }
+    if (ps_ngbr_avbl->u1_mb_b)
+    {
+        aps_ngbr_pu[i4_num_ngbr++] = ih264e_get_8x8_blk_pu(ps_top_row_pu, 0, 1);
+    }
+    if (ps_ngbr_avbl->u1_mb_c)
+    {
+        aps_ngbr_pu[i4_num_ngbr++] = ih264e_get_8x8_blk_pu(ps_top_row_pu + ENC_MAX_PU_IN_MB, 0, 1);
+    }
+
+    /* evaluate the candidates of each reference */
+    for (k = 1; k < i4_num_ref; k++)
+    {
+        ps_me_ctxt->apu1_ref_buf_luma[PRED_L0] = ps_proc->apu1_ref_l0_luma_base[k] + i4_mb_ofst;
+
+        ih264e_mv_pred_me(ps_proc, PRED_L0, k);
+        ps_mb_part->s_mv_pred.i2_mvx = ps_proc->ps_pred_mv[PRED_L0].s_mv.i2_mvx;
+        ps_mb_part->s_mv_pred.i2_mvy = ps_proc->ps_pred_mv[PRED_L0].s_mv.i2_mvy;
+
+        /* zero mv */
+        i4_num_cands = 0;
+        ps_cands[i4_num_cands].i2_mvx = 0;
+        ps_cands[i4_num_cands].i2_mvy = 0;
+        i4_num_cands++;
+
+        /* mv predictor */
+        ps_cands[i4_num_cands].i2_mvx = (ps_mb_part->s_mv_pred.i2_mvx + 2) >> 2;
+        ps_cands[i4_num_cands].i2_mvy = (ps_mb_part->s_mv_pred.i2_mvy + 2) >> 2;
+        i4_num_cands++;
+
+        /* mv of the first reference scaled to the poc distance */
+        if (i4_poc_dist0 > 0)
+        {
+            ps_cands[i4_num_cands].i2_mvx = s_mv_ref0.i2_mvx
+                            * ps_proc->ai4_ref_l0_poc_dist[k] / i4_poc_dist0;
+            ps_cands[i4_num_cands].i2_mvy = s_mv_ref0.i2_mvy
+                            * ps_proc->ai4_ref_l0_poc_dist[k] / i4_poc_dist0;
+            i4_num_cands++;
+        }
+
+        /* neighbors using the same reference */
+        for (i = 0; i < i4_num_ngbr; i++)
+        {
+            if (aps_ngbr_pu[i]->s_me_info[PRED_L0].i1_ref_idx == -1 - k)
+            {
+                ps_cands[i4_num_cands].i2_mvx = (aps_ngbr_pu[i]->s_me_info[PRED_L0].s_mv.i2_mvx + 2) >> 2;
+                ps_cands[i4_num_cands].i2_mvy = (aps_ngbr_pu[i]->s_me_info[PRED_L0].s_mv.i2_mvy + 2) >> 2;
+                i4_num_cands++;
+            }
+        }
+
+        for (i = 0; i < i4_num_cands; i++)
+        {
+            ps_cands[i].i2_mvx = CLIP3(pi4_srch_range[0], pi4_srch_range[1], ps_cands[i].i2_mvx);
+            ps_cands[i].i2_mvy = CLIP3(pi4_srch_range[2], pi4_srch_range[3], ps_cands[i].i2_mvy);
+        }
+
+        ps_me_ctxt->u4_num_candidates[PRED_L0] = i4_num_cands;
+
+        ps_mb_part->s_mv_curr.i2_mvx = 0;
+        ps_mb_part->s_mv_curr.i2_mvy = 0;
+        ps_mb_part->i4_mb_cost = INT_MAX;
+        ps_mb_part->i4_mb_distortion = INT_MAX;
+        ps_mb_part->pu1_best_hpel_buf = NULL;
+
+        ime_evaluate_init_srchposn_16x16(ps_me_ctxt, PRED_L0);
+
+        as_cand[k] = *ps_mb_part;
+
+        /* keep the two cheapest references */
+        i4_cost = ps_mb_part->i4_mb_cost + i4_lambda * ih264e_get_ref_idx_bits(k, i4_num_ref);
+
+        if (i4_cost < ai4_sel_cost[0])
+        {
+            ai4_sel_ref[1] = ai4_sel_ref[0];
+            ai4_sel_cost[1] = ai4_sel_cost[0];
+            ai4_sel_ref[0] = k;
+            ai4_sel_cost[0] = i4_cost;
+        }
+        else if (i4_cost < ai4_sel_cost[1])
+        {
+            ai4_sel_ref[1] = k;
+            ai4_sel_cost[1] = i4_cost;
+        }
+    }
+
+    /* full and sub pel search of the selected references */
+    for (i = 0; i < 2; i++)
+    {
+        WORD32 i4_ref_cost;
+        ime_mv_t s_mv_fpel;
+
+        k = ai4_sel_ref[i];
+
+        /* prune the references that are unlikely to beat the first one or skip */
+        if ((k < 0) || (ai4_sel_cost[i] >= i4_prune_cost + (i4_prune_cost >> 3)))
+        {
+            break;
+        }
+
+        i4_ref_cost = i4_lambda * ih264e_get_ref_idx_bits(k, i4_num_ref);
+
+        ps_me_ctxt->i4_srch_range_w = pi4_srch_range[0];
+        ps_me_ctxt->i4_srch_range_e = pi4_srch_range[1];
+        ps_me_ctxt->i4_srch_range_n = pi4_srch_range[2];
+        ps_me_ctxt->i4_srch_range_s = pi4_srch_range[3];
+
+        ps_me_ctxt->apu1_ref_buf_luma[PRED_L0] = ps_proc->apu1_ref_l0_luma_base[k] + i4_mb_ofst;
+        *ps_mb_part = as_cand[k];
+
+        ime_full_pel_motion_estimation_16x16(ps_me_ctxt, PRED_L0);
+
+        s_mv_fpel = ps_mb_part->s_mv_curr;
+        i4_cost = ps_mb_part->i4_mb_cost + i4_lambda * (ih264e_get_ref_idx_bits(k, i4_num_ref)
+                        - i4_ref_bits0);
+
+        /* Scale the MV to qpel resolution */
+        ps_mb_part->s_mv_curr.i2_mvx <<= 2;
+        ps_mb_part->s_mv_curr.i2_mvy <<= 2;
+
+        if (ps_me_ctxt->u4_enable_hpel)
+        {
+            ih264e_hpel_search_16x16(ps_proc, PRED_L0);
+        }
+
+        if (ps_mb_part->i4_mb_cost + i4_ref_cost < i4_best_cost)
+        {
+            /* the cost of the mb remains relative to the first reference */
+            i4_best_cost = ps_mb_part->i4_mb_cost + i4_ref_cost;
+
+            s_best = *ps_mb_part;
+            s_best.i4_mb_cost = i4_best_cost - i4_lambda * i4_ref_bits0;
+
+            *ps_mv_16x16 = s_mv_fpel;
+            *pi4_cost_16x16 = i4_cost;
+            *pi4_ref_idx = k;
+
+            pu1_best_ref = ps_me_ctxt->apu1_ref_buf_luma[PRED_L0];
+            ai4_best_range[0] = ps_me_ctxt->i4_srch_range_w;
+            ai4_best_range[1] = ps_me_ctxt->i4_srch_range_e;
+            ai4_best_range[2] = ps_me_ctxt->i4_srch_range_n;
+            ai4_best_range[3] = ps_me_ctxt->i4_srch_range_s;
+
+            if (ps_mb_part->pu1_best_hpel_buf)
+            {
+                ps_codec->pf_inter_pred_luma_copy(ps_mb_part->pu1_best_hpel_buf,
+                                                  ps_proc->pu1_best_subpel_buf,
+                                                  ps_me_ctxt->u4_subpel_buf_strd,
+                                                  ps_proc->u4_bst_spel_buf_strd,
+                                                  MB_SIZE, MB_SIZE, NULL, 0);
+            }
+        }
+    }
+
+    *ps_mb_part = s_best;
+
+    ps_me_ctxt->apu1_ref_buf_luma[PRED_L0] = pu1_best_ref;
+    ps_me_ctxt->i4_srch_range_w = ai4_best_range[0];
+    ps_me_ctxt->i4_srch_range_e = ai4_best_range[1];
+    ps_me_ctxt->i4_srch_range_n = ai4_best_range[2];
+    ps_me_ctxt->i4_srch_range_s = ai4_best_range[3];
+
+    ps_proc->ps_pred_mv[PRED_L0] = s_pred_mv_ref0;
+}
+
+/**
+*******************************************************************************
+*
+* @brief Evaluates 16x8, 8x16 and 8x8 partitions of a P mb
+*
+* @par Description:
+*  The quadrants of the mb are searched first, seeded by the 16x16 full pel
+*  mv, the mv predictor and the zero mv. The 16x8 and 8x16 halves are then
+*  searched seeded by the 16x16 mv and the mvs of the quadrants they cover.
+*  The best partitioning is refined to half pel and replaces the 16x16 mode
+*  decision if it is cheaper including the additional mb type bits.
+*
+* @param[in] ps_proc
+*  Process context corresponding to the job
+*
+* @param[in] ps_mv_16x16
+*  Converged full pel mv of the 16x16 search
+*
+* @param[in] i4_cost_16x16
+*  Full pel cost of the 16x16 search
+*
+* @param[in] i4_ref_idx
+*  L0 reference of the 16x16 search, shared by all the partitions
+*
+* @returns  none
+*
+* @remarks The partition costs use the 16x16 mv predictor
+*
+*******************************************************************************
+*/
+static void ih264e_evaluate_mb_part(process_ctxt_t *ps_proc,
+                                    ime_mv_t *ps_mv_16x16,
+                                    WORD32 i4_cost_16x16,
+                                    WORD32 i4_ref_idx)
+{
+    /* me ctxt */
+    me_ctxt_t *ps_me_ctxt = &ps_proc->s_me_ctxt;
+
+    /* partition geometry in pels, indexed by mb type - P16x8 */
+    static const UWORD8 au1_part_cnt[3] = { 2, 2, 4 };
+    static const UWORD8 au1_part_wd[3] = { 16, 8, 8 };
+    static const UWORD8 au1_part_ht[3] = { 8, 16, 8 };
+    static const UWORD8 au1_part_x[3][4] = { { 0, 0 }, { 0, 8 }, { 0, 8, 0, 8 } };
+    static const UWORD8 au1_part_y[3][4] = { { 0, 8 }, { 0, 0 }, { 0, 0, 8, 8 } };
+
+    /* additional mb type and mvd bits relative to P16x16. The mvd part is a
+     * bias, partition mvds are costed against the 16x16 predictor */
+    static const UWORD8 au1_part_bits[3] = { 6, 6, 14 };
+
+    /* partition ctxts, indexed by mb type - P16x8 */
+    mb_part_ctxt as_part[3][4];
+
+    /* search candidates */
+    ime_mv_t as_cands[3];
+
+    /* mv predictor of the mb */
+    ime_mv_t s_mv_pred = ps_me_ctxt->as_mb_part[PRED_L0].s_mv_pred;
+
+    /* ref idx bits of the partitions relative to the 16x16 mb of first ref */
+    WORD32 i4_ref_bits = ih264e_get_ref_idx_bits(i4_ref_idx, ps_proc->i4_num_ref_idx_l0_active);
+    WORD32 i4_ref_bits_16x16 = ih264e_get_ref_idx_bits(0, ps_proc->i4_num_ref_idx_l0_active);
+
+    /* temp var */
+    WORD32 ai4_cost[3], i4_best, i4_cost, i4_distortion, i, j;
+    enc_pu_t *ps_pu;
+
+    /* quadrants */
+    as_cands[0] = *ps_mv_16x16;
+    as_cands[1].i2_mvx = (s_mv_pred.i2_mvx + 2) >> 2;
+    as_cands[1].i2_mvy = (s_mv_pred.i2_mvy + 2) >> 2;
+    as_cands[2].i2_mvx = 0;
+    as_cands[2].i2_mvy = 0;
+
+    for (i = 0; i < 4; i++)
+    {
+        as_part[2][i].s_mv_pred = s_mv_pred;
+        ih264e_mb_part_fpel_search(ps_me_ctxt, au1_part_x[2][i], au1_part_y[2][i],
+                                   8, 8, as_cands, 3, &as_part[2][i]);
+    }
+
+    /* 16x8 and 8x16 halves */
+    for (i = 0; i < 2; i++)
+    {
+        as_cands[1] = as_part[2][2 * i].s_mv_curr;
+        as_cands[2] = as_part[2][2 * i + 1].s_mv_curr;
+        as_part[0][i].s_mv_pred = s_mv_pred;
+        ih264e_mb_part_fpel_search(ps_me_ctxt, 0, 8 * i, 16, 8, as_cands, 3,
+                                   &as_part[0][i]);
+
+        as_cands[1] = as_part[2][i].s_mv_curr;
+        as_cands[2] = as_part[2][i + 2].s_mv_curr;
+        as_part[1][i].s_mv_pred = s_mv_pred;
+        ih264e_mb_part_fpel_search(ps_me_ctxt, 8 * i, 0, 8, 16, as_cands, 3,
+                                   &as_part[1][i]);
+    }
+
+    /* pick the cheapest partitioning */
+    i4_best = 0;
+    for (i = 0; i < 3; i++)
+    {
+        ai4_cost[i] = ps_me_ctxt->u4_lambda_motion * (au1_part_bits[i]
+                        + au1_part_cnt[i] * i4_ref_bits - i4_ref_bits_16x16);
+        for (j = 0; j < au1_part_cnt[i]; j++)
+        {
+            ai4_cost[i] += as_part[i][j].i4_mb_cost;
+        }
+        if (ai4_cost[i] < ai4_cost[i4_best])
+        {
+            i4_best = i;
+        }
+    }
+
+    if (ai4_cost[i4_best] >= i4_cost_16x16)
+    {
+        return;
+    }
+
+    /* sub pel refinement */
+    i4_cost = ps_me_ctxt->u4_lambda_motion * (au1_part_bits[i4_best]
+                    + au1_part_cnt[i4_best] * i4_ref_bits - i4_ref_bits_16x16);
+    i4_distortion = 0;
+    for (j = 0; j < au1_part_cnt[i4_best]; j++)
+    {
+        mb_part_ctxt *ps_part = &as_part[i4_best][j];
+
+        ps_part->s_mv_curr.i2_mvx <<= 2;
+        ps_part->s_mv_curr.i2_mvy <<= 2;
+
+        if (ps_me_ctxt->u4_enable_hpel)
+        {
+            ih264e_mb_part_subpel_search(ps_proc, au1_part_x[i4_best][j],
+                                         au1_part_y[i4_best][j],
+                                         au1_part_wd[i4_best],
+                                         au1_part_ht[i4_best], 2, ps_part);
         }
-        else
+
+        if (ps_me_ctxt->u4_enable_qpel)
         {
-            s_top_row_pu[1].s_me_info[i4_ref_list].i1_ref_idx = ps_top_left_mb_pu->s_me_info[0].i1_ref_idx;
-            s_top_row_pu[1].s_me_info[i4_ref_list].s_mv = ps_top_left_mb_pu->s_me_info[0].s_mv;
+            ih264e_mb_part_subpel_search(ps_proc, au1_part_x[i4_best][j],
+                                         au1_part_y[i4_best][j],
+                                         au1_part_wd[i4_best],
+                                         au1_part_ht[i4_best], 1, ps_part);
         }
+
+        i4_cost += ps_part->i4_mb_cost;
+        i4_distortion += ps_part->i4_mb_distortion;
+    }
+
+    if (i4_cost >= ps_me_ctxt->as_mb_part[PRED_L0].i4_mb_cost)
+    {
+        return;
     }
-    else if (ps_top_row_pu[1].b2_pred_mode == i4_cmpl_predmode)
+
+    /* store the partitions */
+    for (j = 0; j < au1_part_cnt[i4_best]; j++)
     {
-        ps_top_row_pu[1].s_me_info[i4_ref_list].i1_ref_idx = 0;
-        ps_top_row_pu[1].s_me_info[i4_ref_list].s_mv = zero_mv;
+        ps_pu = ps_proc->ps_pu + j;
+
+        ps_pu->s_me_info[PRED_L0].s_mv.i2_mvx = as_part[i4_best][j].s_mv_curr.i2_mvx;
+        ps_pu->s_me_info[PRED_L0].s_mv.i2_mvy = as_part[i4_best][j].s_mv_curr.i2_mvy;
+        ps_pu->s_me_info[PRED_L1].s_mv.i2_mvx = 0;
+        ps_pu->s_me_info[PRED_L1].s_mv.i2_mvy = 0;
+        ps_pu->s_me_info[0].i1_ref_idx = -1 - i4_ref_idx;
+        ps_pu->s_me_info[1].i1_ref_idx = 0;
+        ps_pu->b2_pred_mode = PRED_L0;
+        ps_pu->b1_intra_flag = 0;
+
+        /* position and size in-terms of 4x4 blocks */
+        ps_pu->b4_pos_x = au1_part_x[i4_best][j] >> 2;
+        ps_pu->b4_pos_y = au1_part_y[i4_best][j] >> 2;
+        ps_pu->b4_wd = (au1_part_wd[i4_best] >> 2) - 1;
+        ps_pu->b4_ht = (au1_part_ht[i4_best] >> 2) - 1;
     }
 
-    ih264e_get_mv_predictor(ps_left_mb_pu, &(s_top_row_pu[0]),
-                            &ps_pred_mv[i4_ref_list], i4_ref_list);
+    ps_proc->ps_cur_mb->u4_mb_type = P16x8 + i4_best;
+    ps_proc->ps_cur_mb->i4_mb_cost = i4_cost;
+    ps_proc->ps_cur_mb->i4_mb_distortion = i4_distortion;
+
+    /* number of partitions */
+    ps_proc->u4_num_sub_partitions = au1_part_cnt[i4_best];
+    *(ps_proc->pu4_mb_pu_cnt) = au1_part_cnt[i4_best];
 }
 
 /**
 *******************************************************************************
 *
-* @brief This function initializes me ctxt
+* @brief This function evaluates the skip mv of list L0 when it points to a
+*   sub pel position
 *
 * @par Description:
-*  Before dispatching the current job to me thread, the me context associated
-*  with the job is initialized.
+*  ime_compute_skip_cost() only evaluates full pel skip mvs. For a sub pel skip
+*  mv, the 16x16 prediction is interpolated into the best sub pel buffer and
+*  compared against the source, with the same SATQD (or min sad) exit and the
+*  same skip bias. If the skip wins, the prediction is left in the buffer for
+*  motion compensation. If the search or another reference wins instead, it
+*  overwrites the buffer.
 *
 * @param[in] ps_proc
 *  Process context corresponding to the job
 *
+* @param[out] ps_skip_mbpart
+*  Skip mb part ctxt, updated if the skip costs less
+*
 * @returns  none
 *
 * @remarks none
 *
 *******************************************************************************
 */
-void ih264e_init_me(process_ctxt_t *ps_proc)
+static void ih264e_compute_subpel_skip_cost(process_ctxt_t *ps_proc,
+                                            mb_part_ctxt *ps_skip_mbpart)
 {
     /* me ctxt */
     me_ctxt_t *ps_me_ctxt = &ps_proc->s_me_ctxt;
 
-    /* codec context */
-    codec_t *ps_codec = ps_proc->ps_codec;
+    /* skip mv in qpel units */
+    ime_mv_t s_skip_mv;
 
-    ps_me_ctxt->i4_skip_bias[BSLICE] = SKIP_BIAS_B;
+    /* full pel part and fraction of the skip mv */
+    WORD32 i4_mvx, i4_mvy, i4_dydx;
 
-    if (ps_codec->s_cfg.u4_num_bframes == 0)
+    /* SAD(distortion metric) and cost of the mb */
+    WORD32 i4_mb_distortion;
+    WORD32 i4_mb_cost;
+
+    UWORD8 *pu1_ref;
+
+    s_skip_mv.i2_mvx = ps_proc->ps_skip_mv[PRED_L0].s_mv.i2_mvx;
+    s_skip_mv.i2_mvy = ps_proc->ps_skip_mv[PRED_L0].s_mv.i2_mvy;
+
+    i4_mvx = s_skip_mv.i2_mvx >> 2;
+    i4_mvy = s_skip_mv.i2_mvy >> 2;
+    i4_dydx = ((s_skip_mv.i2_mvy & 3) << 2) + (s_skip_mv.i2_mvx & 3);
+
+    /* full pel skip mvs are evaluated by ime_compute_skip_cost() */
+    if (i4_dydx == 0)
     {
-       ps_me_ctxt->i4_skip_bias[PSLICE] = 4 * SKIP_BIAS_P;
+        return;
     }
-    else
+
+    /* the skip mv should lie inside the sub pel search area */
+    if ((i4_mvx < ps_me_ctxt->i4_srch_range_w) || (i4_mvx > ps_me_ctxt->i4_srch_range_e) ||
+        (i4_mvy < ps_me_ctxt->i4_srch_range_n) || (i4_mvy > ps_me_ctxt->i4_srch_range_s))
     {
-       ps_me_ctxt->i4_skip_bias[PSLICE] =  SKIP_BIAS_P;
+        return;
     }
 
-    /* src ptr */
-    ps_me_ctxt->pu1_src_buf_luma = ps_proc->pu1_src_buf_luma;
-    /* src stride */
-    ps_me_ctxt->i4_src_strd = ps_proc->i4_src_strd;
+    pu1_ref = ps_me_ctxt->apu1_ref_buf_luma[PRED_L0] + i4_mvx
+                    + (i4_mvy * ps_me_ctxt->i4_rec_strd);
 
-    /* ref ptrs and corresponding lagrange params */
-    ps_me_ctxt->apu1_ref_buf_luma[0] = ps_proc->apu1_ref_buf_luma[0];
-    ps_me_ctxt->apu1_ref_buf_luma[1] = ps_proc->apu1_ref_buf_luma[1];
+    ps_proc->ps_codec->apf_inter_pred_luma[i4_dydx](
+                    pu1_ref, ps_proc->pu1_best_subpel_buf,
+                    ps_me_ctxt->i4_rec_strd, ps_proc->u4_bst_spel_buf_strd,
+                    MB_SIZE, MB_SIZE, (UWORD8 *)ps_proc->ai16_pred1, i4_dydx);
 
-    ps_me_ctxt->u4_lambda_motion = gu1_qp0[ps_me_ctxt->u1_mb_qp];
+    if (ps_proc->ps_codec->s_cfg.u4_enable_satqd)
+    {
+        UWORD32 u4_is_nonzero;
 
+        ps_me_ctxt->pf_ime_compute_sad_stat_luma_16x16(
+                        ps_me_ctxt->pu1_src_buf_luma, ps_proc->pu1_best_subpel_buf,
+                        ps_me_ctxt->i4_src_strd, ps_proc->u4_bst_spel_buf_strd,
+                        ps_me_ctxt->pu2_sad_thrsh, &i4_mb_distortion, &u4_is_nonzero);
 
-}
+        if (u4_is_nonzero == 0 || i4_mb_distortion <= ps_me_ctxt->i4_min_sad)
+        {
+            ps_me_ctxt->u4_min_sad_reached = 1;
+            ps_me_ctxt->i4_min_sad = (u4_is_nonzero == 0) ? 0 : i4_mb_distortion;
+        }
+    }
+    else
+    {
+        ps_me_ctxt->pf_ime_compute_sad_16x16[ps_me_ctxt->u4_enable_fast_sad](
+                        ps_me_ctxt->pu1_src_buf_luma, ps_proc->pu1_best_subpel_buf,
+                        ps_me_ctxt->i4_src_strd, ps_proc->u4_bst_spel_buf_strd,
+                        INT_MAX, &i4_mb_distortion);
+
+        if (i4_mb_distortion <= ps_me_ctxt->i4_min_sad)
+        {
+            ps_me_ctxt->u4_min_sad_reached = 1;
+            ps_me_ctxt->i4_min_sad = i4_mb_distortion;
+        }
+    }
+
+    /* same skip bias as the full pel skip */
+    i4_mb_cost = i4_mb_distortion - (ps_me_ctxt->u4_lambda_motion * ps_me_ctxt->i4_skip_bias[PSLICE]);
 
+    if (i4_mb_cost <= ps_skip_mbpart->i4_mb_cost)
+    {
+        ps_skip_mbpart->i4_mb_cost = i4_mb_cost;
+        ps_skip_mbpart->i4_mb_distortion = i4_mb_distortion;
+        ps_skip_mbpart->s_mv_curr = s_skip_mv;
+    }
+}
 
 /**
 *******************************************************************************
@@ -884,18 +2823,23 @@ void ih264e_compute_me_single_reflist(process_ctxt_t *ps_proc)
     /* codec context */
     codec_t *ps_codec = ps_proc->ps_codec;
 
-    /* recon stride */
-    WORD32 i4_rec_strd = ps_proc->i4_rec_strd;
-
-    /* source buffer for halp pel generation functions */
-    UWORD8 *pu1_hpel_src;
-
     /* quantization parameters */
     quant_params_t *ps_qp_params = ps_proc->ps_qp_params[0];
 
     /* Mb part ctxts for SKIP */
     mb_part_ctxt s_skip_mbpart;
 
+    /* full pel mv, cost and reference of the 16x16 search */
+    ime_mv_t s_mv_16x16 = {0, 0};
+    WORD32 i4_cost_16x16 = INT_MAX;
+    WORD32 i4_ref_idx = 0;
+
+    /* search range before the full pel search */
+    WORD32 ai4_srch_range[4];
+
+    /* ref pointer of the first reference */
+    UWORD8 *pu1_ref_buf_luma = ps_me_ctxt->apu1_ref_buf_luma[PRED_L0];
+
     /* Sad therholds */
     ps_me_ctxt->pu2_sad_thrsh = ps_qp_params->pu2_sad_thrsh;
 
@@ -910,19 +2854,22 @@ void ih264e_compute_me_single_reflist(process_ctxt_t *ps_proc)
         columns_right = (ps_proc->i4_wd_mbs - ps_proc->i4_mb_x) * MB_SIZE;
 
         /* init srch range */
-        /* NOTE : For now, lets limit the search range by DEFAULT_MAX_SRCH_RANGE_X / 2
-         * on all sides.
-         */
-        ps_me_ctxt->i4_srch_range_w = -MIN(columns_left, DEFAULT_MAX_SRCH_RANGE_X >> 1);
-        ps_me_ctxt->i4_srch_range_e = MIN(columns_right, DEFAULT_MAX_SRCH_RANGE_X >> 1);
-        ps_me_ctxt->i4_srch_range_n = -MIN(rows_above, DEFAULT_MAX_SRCH_RANGE_Y >> 1);
-        ps_me_ctxt->i4_srch_range_s = MIN(rows_below, DEFAULT_MAX_SRCH_RANGE_Y >> 1);
+        /* limit the search range to the configured search range on all sides */
+        ps_me_ctxt->i4_srch_range_w = -MIN(columns_left, ps_me_ctxt->ai2_srch_boundaries[0]);
+        ps_me_ctxt->i4_srch_range_e = MIN(columns_right, ps_me_ctxt->ai2_srch_boundaries[0]);
+        ps_me_ctxt->i4_srch_range_n = -MIN(rows_above, ps_me_ctxt->ai2_srch_boundaries[1]);
+        ps_me_ctxt->i4_srch_range_s = MIN(rows_below, ps_me_ctxt->ai2_srch_boundaries[1]);
 
         /* this is to facilitate fast sub pel computation with minimal loads */
         ps_me_ctxt->i4_srch_range_w += 1;
         ps_me_ctxt->i4_srch_range_e -= 1;
         ps_me_ctxt->i4_srch_range_n += 1;
         ps_me_ctxt->i4_srch_range_s -= 1;
+
+        ai4_srch_range[0] = ps_me_ctxt->i4_srch_range_w;
+        ai4_srch_range[1] = ps_me_ctxt->i4_srch_range_e;
+        ai4_srch_range[2] = ps_me_ctxt->i4_srch_range_n;
+        ai4_srch_range[3] = ps_me_ctxt->i4_srch_range_s;
     }
 
     /* Compute ME and store the MVs */
@@ -935,11 +2882,13 @@ void ih264e_compute_me_single_reflist(process_ctxt_t *ps_proc)
     ps_me_ctxt->u4_min_sad_reached  = 0;
     ps_me_ctxt->i4_min_sad = ps_proc->ps_cur_mb->u4_min_sad;
 
-    /* Get the seed motion vector candidates                    */
-    ih264e_get_search_candidates(ps_proc, ps_me_ctxt, PRED_L0);
+    /* Get the mv predictor and the skip motion vector          */
+    ih264e_get_pred_and_skip_mv(ps_proc, ps_me_ctxt, PRED_L0);
 
     /* ****************************************************************
-     *Evaluate the SKIP for current list
+     * Evaluate the SKIP for current list ahead of the search candidates.
+     * If the skip mv reaches the min sad (SATQD), the candidates are not
+     * built, as the search below is bypassed in that case anyway
      * ****************************************************************/
     s_skip_mbpart.s_mv_curr.i2_mvx = 0;
     s_skip_mbpart.s_mv_curr.i2_mvy = 0;
@@ -956,6 +2905,15 @@ void ih264e_compute_me_single_reflist(process_ctxt_t *ps_proc)
     s_skip_mbpart.s_mv_curr.i2_mvx <<= 2;
     s_skip_mbpart.s_mv_curr.i2_mvy <<= 2;
 
+    /* a sub pel skip mv is not evaluated above, do it here */
+    ih264e_compute_subpel_skip_cost(ps_proc, &s_skip_mbpart);
+
+    /* Get the seed motion vector candidates                    */
+    if (!ps_me_ctxt->u4_min_sad_reached)
+    {
+        ih264e_get_search_candidates(ps_proc, ps_me_ctxt, PRED_L0);
+    }
+
     /******************************************************************
      * Evaluate ME For current list
      *****************************************************************/
@@ -978,51 +2936,17 @@ void ih264e_compute_me_single_reflist(process_ctxt_t *ps_proc)
         /********************************************************************/
         ime_full_pel_motion_estimation_16x16(ps_me_ctxt, PRED_L0);
 
+        /* full pel result of 16x16, seeds the sub mb partition search */
+        s_mv_16x16 = ps_me_ctxt->as_mb_part[PRED_L0].s_mv_curr;
+        i4_cost_16x16 = ps_me_ctxt->as_mb_part[PRED_L0].i4_mb_cost;
+
         /* Scale the MV to qpel resolution */
         ps_me_ctxt->as_mb_part[PRED_L0].s_mv_curr.i2_mvx <<= 2;
         ps_me_ctxt->as_mb_part[PRED_L0].s_mv_curr.i2_mvy <<= 2;
 
         if (ps_me_ctxt->u4_enable_hpel)
         {
-            /* moving src pointer to the converged motion vector location*/
-            pu1_hpel_src =   ps_me_ctxt->apu1_ref_buf_luma[PRED_L0]
-                             + (ps_me_ctxt->as_mb_part[PRED_L0].s_mv_curr.i2_mvx >> 2)
-                             + (ps_me_ctxt->as_mb_part[PRED_L0].s_mv_curr.i2_mvy >> 2)* i4_rec_strd;
-
-            ps_me_ctxt->apu1_subpel_buffs[0] = ps_proc->apu1_subpel_buffs[0];
-            ps_me_ctxt->apu1_subpel_buffs[1] = ps_proc->apu1_subpel_buffs[1];
-            ps_me_ctxt->apu1_subpel_buffs[2] = ps_proc->apu1_subpel_buffs[2];
-
-            ps_me_ctxt->u4_subpel_buf_strd = HP_BUFF_WD;
-
-            /* half  pel search is done for both sides of full pel,
-             * hence half_x of width x height = 17x16 is created
-             * starting from left half_x of converged full pel */
-            pu1_hpel_src -= 1;
-
-            /* computing half_x */
-            ps_codec->pf_ih264e_sixtapfilter_horz(pu1_hpel_src,
-                                                  ps_me_ctxt->apu1_subpel_buffs[0],
-                                                  i4_rec_strd,
-                                                  ps_me_ctxt->u4_subpel_buf_strd);
-
-            /*
-             * Halfpel search is done for both sides of full pel,
-             * hence half_y of width x height = 16x17 is created
-             * starting from top half_y of converged full pel
-             * for half_xy top_left is required
-             * hence it starts from pu1_hpel_src = full_pel_converged_point - i4_rec_strd - 1
-             */
-            pu1_hpel_src -= i4_rec_strd;
-
-            /* computing half_y , and half_xy*/
-            ps_codec->pf_ih264e_sixtap_filter_2dvh_vert(
-                            pu1_hpel_src, ps_me_ctxt->apu1_subpel_buffs[1],
-                            ps_me_ctxt->apu1_subpel_buffs[2], i4_rec_strd,
-                            ps_me_ctxt->u4_subpel_buf_strd, ps_proc->ai16_pred1 + 3,
-                            ps_me_ctxt->u4_subpel_buf_strd);
-
-            ime_sub_pel_motion_estimation_16x16(ps_me_ctxt, PRED_L0);
+            ih264e_hpel_search_16x16(ps_proc, PRED_L0);
         }
     }
 
@@ -1051,6 +2975,16 @@ void ih264e_compute_me_single_reflist(process_ctxt_t *ps_proc)
                         NULL, 0);
     }
 
+    /**********************************************************************
+     * Search the remaining L0 references
+     **********************************************************************/
+    if ((ps_proc->i4_num_ref_idx_l0_active > 1) && !ps_me_ctxt->u4_min_sad_reached
+                    && (i4_cost_16x16 != INT_MAX))
+    {
+        ih264e_search_l0_refs(ps_proc, ai4_srch_range, &s_mv_16x16,
+                              &i4_cost_16x16, s_skip_mbpart.i4_mb_cost, &i4_ref_idx);
+    }
+
     /**********************************************************************
      * Now get the minimum of MB part sads by searching over all ref lists
      **********************************************************************/
@@ -1062,7 +2996,7 @@ void ih264e_compute_me_single_reflist(process_ctxt_t *ps_proc)
     ps_proc->ps_pu->b2_pred_mode = PRED_L0 ;
 
     /* Mark the reflists */
-    ps_proc->ps_pu->s_me_info[0].i1_ref_idx = -1;
+    ps_proc->ps_pu->s_me_info[0].i1_ref_idx = -1 - i4_ref_idx;
     ps_proc->ps_pu->s_me_info[1].i1_ref_idx =  0;
 
     /* number of partitions */
@@ -1077,6 +3011,15 @@ void ih264e_compute_me_single_reflist(process_ctxt_t *ps_proc)
     ps_proc->ps_pu->b4_wd = 3;
     ps_proc->ps_pu->b4_ht = 3;
 
+    /* evaluate sub mb partitions */
+    if (ps_codec->u4_enable_mb_part && !ps_me_ctxt->u4_min_sad_reached
+                    && (i4_cost_16x16 != INT_MAX))
+    {
+        ih264e_evaluate_mb_part(ps_proc, &s_mv_16x16, i4_cost_16x16, i4_ref_idx);
+    }
+
+    ps_me_ctxt->apu1_ref_buf_luma[PRED_L0] = pu1_ref_buf_luma;
+
     /* Update min sad conditions */
     if (ps_me_ctxt->u4_min_sad_reached == 1)
     {
@@ -1174,15 +3117,15 @@ void ih264e_compute_me_nmb(process_ctxt_t *ps_proc, UWORD32 u4_nmb_count)
             mb_info_t *ps_top_left_syn = &(ps_proc->s_top_left_mb_syntax_ME);
             enc_pu_t *ps_left_mb_pu = &ps_proc->s_left_mb_pu_ME;
             enc_pu_t *ps_top_left_mb_pu = &ps_proc->s_top_left_mb_pu_ME;
-            enc_pu_t *ps_top_mv = ps_proc->ps_top_row_pu_ME + ps_proc->i4_mb_x;
+            enc_pu_t *ps_top_mv = ps_proc->ps_top_row_pu_ME + ps_proc->i4_mb_x * ENC_MAX_PU_IN_MB;
 
             *ps_top_left_syn = *ps_top_syn;
 
-            *ps_top_left_mb_pu = *ps_top_mv;
-            *ps_left_mb_pu = *ps_proc->ps_pu;
+            *ps_top_left_mb_pu = *ih264e_get_8x8_blk_pu(ps_top_mv, 1, 1);
+            *ps_left_mb_pu = *ih264e_get_8x8_blk_pu(ps_proc->ps_pu, 1, 0);
         }
 
-        ps_proc->ps_pu += *ps_proc->pu4_mb_pu_cnt;
+        ps_proc->ps_pu += ENC_MAX_PU_IN_MB;
 
         /* Copy the min sad reached info */
         ps_proc->ps_nmb_info[u4_i].u4_min_sad_reached = ps_proc->ps_cur_mb->u4_min_sad_reached;
@@ -1326,7 +3269,7 @@ WORD32 ih264e_find_bskip_params_me(process_ctxt_t *ps_proc, WORD32 i4_reflist)
             if (ps_proc->ps_colpu->b2_pred_mode != PRED_L1)
             {
                 s_mvcol = ps_proc->ps_colpu->s_me_info[PRED_L0].s_mv;
-                i4_refidxcol = 0;
+                i4_refidxcol = -1 - ps_proc->ps_colpu->s_me_info[PRED_L0].i1_ref_idx;
             }
             else // if(ps_proc->ps_colpu->b2_pred_mode != PRED_L0)
             {
@@ -1347,12 +3290,12 @@ WORD32 ih264e_find_bskip_params_me(process_ctxt_t *ps_proc, WORD32 i4_reflist)
     {
     /* Get the neighbouring MBS according to Section 8.4.1.2.2 */
     ps_a_pu = &ps_proc->s_left_mb_pu_ME;
-    ps_b_pu = (ps_proc->ps_top_row_pu_ME + ps_proc->i4_mb_x);
+    ps_b_pu = ih264e_get_8x8_blk_pu(ps_proc->ps_top_row_pu_ME + ps_proc->i4_mb_x * ENC_MAX_PU_IN_MB, 0, 1);
 
     i4_c_avail = 0;
     if (ps_ngbr_avbl->u1_mb_c)
     {
-        ps_c_pu = &((ps_proc->ps_top_row_pu_ME + ps_proc->i4_mb_x)[1]);
+        ps_c_pu = ih264e_get_8x8_blk_pu(ps_proc->ps_top_row_pu_ME + (ps_proc->i4_mb_x + 1) * ENC_MAX_PU_IN_MB, 0, 1);
         i4_c_avail = 1;
     }
     else
@@ -1419,7 +3362,7 @@ WORD32 ih264e_find_bskip_params_me(process_ctxt_t *ps_proc, WORD32 i4_reflist)
      * Evaluating skip params : Temporal skip
      **************************************************************************/
     {
-        pic_buf_t *  ps_ref_pic[MAX_REF_PIC_CNT];
+        pic_buf_t *  ps_ref_pic[MAX_NUM_REFLIST];
         WORD32 i4_td, i4_tx, i4_tb, i4_dist_scale_factor;
         enc_pu_mv_t *ps_skip_mv = &ps_proc->ps_skip_mv[2];
 
@@ -1435,12 +3378,17 @@ WORD32 ih264e_find_bskip_params_me(process_ctxt_t *ps_proc, WORD32 i4_reflist)
         i4_tx = ( 16384 + ABS( i4_td / 2 ) ) / i4_td ;
         i4_dist_scale_factor =  CLIP3( -1024, 1023, ( i4_tb * i4_tx + 32 ) >> 6 );
 
-        /* Motion vectors taken in full pel resolution , hence  -> (& 0xfffc) operation */
-        ps_skip_mv[PRED_L0].s_mv.i2_mvx = (( i4_dist_scale_factor * s_mvcol.i2_mvx + 128 ) >> 8) & 0xfffc;
-        ps_skip_mv[PRED_L0].s_mv.i2_mvy = (( i4_dist_scale_factor * s_mvcol.i2_mvy + 128 ) >> 8) & 0xfffc;
+        /* Motion vectors are kept in qpel resolution. They used to be
+         * truncated to full pel (& 0xfffc) as they were only used as full pel
+         * search candidates, but ih264e_refine_bipred evaluates the exact
+         * scaled co-located pair, and a truncated pair is neither that pair
+         * nor the nearest full pel. The search candidates round them to full
+         * pel. The skip cost is computed from the spatial skip mvs only */
+        ps_skip_mv[PRED_L0].s_mv.i2_mvx = ( i4_dist_scale_factor * s_mvcol.i2_mvx + 128 ) >> 8;
+        ps_skip_mv[PRED_L0].s_mv.i2_mvy = ( i4_dist_scale_factor * s_mvcol.i2_mvy + 128 ) >> 8;
 
-        ps_skip_mv[PRED_L1].s_mv.i2_mvx = (ps_skip_mv[PRED_L0].s_mv.i2_mvx - s_mvcol.i2_mvx) & 0xfffc;
-        ps_skip_mv[PRED_L1].s_mv.i2_mvy = (ps_skip_mv[PRED_L0].s_mv.i2_mvy - s_mvcol.i2_mvy) & 0xfffc;
+        ps_skip_mv[PRED_L1].s_mv.i2_mvx = ps_skip_mv[PRED_L0].s_mv.i2_mvx - s_mvcol.i2_mvx;
+        ps_skip_mv[PRED_L1].s_mv.i2_mvy = ps_skip_mv[PRED_L0].s_mv.i2_mvy - s_mvcol.i2_mvy;
 
     }
 
@@ -1520,7 +3468,7 @@ WORD32 ih264e_find_bskip_params(process_ctxt_t *ps_proc, WORD32 i4_reflist)
             if (ps_proc->ps_colpu->b2_pred_mode != PRED_L1)
             {
                 s_mvcol = ps_proc->ps_colpu->s_me_info[PRED_L0].s_mv;
-                i4_refidxcol = 0;
+                i4_refidxcol = -1 - ps_proc->ps_colpu->s_me_info[PRED_L0].i1_ref_idx;
             }
             else // if(ps_proc->ps_colpu->b2_pred_mode != PRED_L0)
             {
@@ -1533,6 +3481,28 @@ WORD32 ih264e_find_bskip_params(process_ctxt_t *ps_proc, WORD32 i4_reflist)
         i4_colzeroflag = (!i4_refidxcol && (ABS(s_mvcol.i2_mvx) <= 1)
                         && (ABS(s_mvcol.i2_mvy) <= 1));
 
+        /*
+         * The 8x8 blocks of a partitioned co-located mb can have different
+         * colZeroFlags, the direct prediction of the mb is then not a single
+         * 16x16 prediction and is not considered for skip
+         */
+        if (!ps_proc->ps_colpu->b1_intra_flag
+                        && ((ps_proc->ps_colpu->b4_wd != 3) || (ps_proc->ps_colpu->b4_ht != 3)))
+        {
+            for (i = 1; i < 4; i++)
+            {
+                enc_pu_t *ps_blk_pu = ih264e_get_8x8_blk_pu(ps_proc->ps_colpu, i & 1, i >> 1);
+
+                s_mvcol = ps_blk_pu->s_me_info[(ps_blk_pu->b2_pred_mode == PRED_L1) ? PRED_L1 : PRED_L0].s_mv;
+                i4_refidxcol = -1 - ps_blk_pu->s_me_info[PRED_L0].i1_ref_idx;
+
+                if (i4_colzeroflag != (!i4_refidxcol && (ABS(s_mvcol.i2_mvx) <= 1)
+                                && (ABS(s_mvcol.i2_mvy) <= 1)))
+                {
+                    return 0;
+                }
+            }
+        }
     }
 
     /***************************************************************************
@@ -1759,6 +3729,383 @@ void ih264e_evaluate_bipred(me_ctxt_t *ps_me_ctxt,
 
 }
 
+/**
+*******************************************************************************
+*
+* @brief Returns the 16x16 luma prediction of a reference list at a qpel mv
+*
+* @par Description:
+*  At a full pel mv the prediction is read in place from the reference. Else
+*  it is interpolated from the full pel reference of the list with the inter
+*  pred leaf level functions into the given buffer of stride HP_BUFF_WD
+*
+* @param[in] ps_proc
+*  Process context corresponding to the job
+*
+* @param[in] i4_reflist
+*  Reference list
+*
+* @param[in] ps_mv
+*  mv in qpel units
+*
+* @param[in] pu1_buf
+*  Buffer for the interpolated prediction
+*
+* @param[out] pi4_strd
+*  Stride of the prediction
+*
+* @returns  Pointer to the prediction
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static UWORD8 *ih264e_get_pred_luma_16x16(process_ctxt_t *ps_proc,
+                                          WORD32 i4_reflist,
+                                          ime_mv_t *ps_mv,
+                                          UWORD8 *pu1_buf,
+                                          WORD32 *pi4_strd)
+{
+    /* me ctxt */
+    me_ctxt_t *ps_me_ctxt = &ps_proc->s_me_ctxt;
+
+    /* recon stride */
+    WORD32 i4_rec_strd = ps_me_ctxt->i4_rec_strd;
+
+    /* sub pel position */
+    WORD32 i4_dydx = ((ps_mv->i2_mvy & 3) << 2) | (ps_mv->i2_mvx & 3);
+
+    /* full pel position */
+    UWORD8 *pu1_ref = ps_me_ctxt->apu1_ref_buf_luma[i4_reflist]
+                    + (ps_mv->i2_mvy >> 2) * i4_rec_strd + (ps_mv->i2_mvx >> 2);
+
+    if (i4_dydx == 0)
+    {
+        *pi4_strd = i4_rec_strd;
+        return pu1_ref;
+    }
+
+    ps_proc->ps_codec->apf_inter_pred_luma[i4_dydx](pu1_ref, pu1_buf,
+                                                    i4_rec_strd, HP_BUFF_WD,
+                                                    MB_SIZE, MB_SIZE,
+                                                    (UWORD8 *)ps_proc->ai16_pred1,
+                                                    i4_dydx);
+    *pi4_strd = HP_BUFF_WD;
+    return pu1_buf;
+}
+
+/**
+*******************************************************************************
+*
+* @brief Computes the cost of a bipred mv pair from the predictions of the two
+* lists
+*
+* @par Description:
+*  The L0 and L1 predictions are averaged into the destination buffer and the
+*  sad of the average against the source is added to the mv cost of the pair
+*
+* @param[in] ps_proc
+*  Process context corresponding to the job
+*
+* @param[in] apu1_pred
+*  L0 and L1 predictions
+*
+* @param[in] ai4_pred_strd
+*  Strides of the L0 and L1 predictions
+*
+* @param[in] ps_mv_pair
+*  L0 and L1 mvs in qpel units
+*
+* @param[out] pu1_dst
+*  Bipred buffer of stride HP_BUFF_WD
+*
+* @param[out] pi4_distortion
+*  Distortion of the pair
+*
+* @returns  Cost of the pair
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static WORD32 ih264e_compute_bipred_cost(process_ctxt_t *ps_proc,
+                                         UWORD8 **apu1_pred,
+                                         WORD32 *ai4_pred_strd,
+                                         ime_mv_t *ps_mv_pair,
+                                         UWORD8 *pu1_dst,
+                                         WORD32 *pi4_distortion)
+{
+    /* me ctxt */
+    me_ctxt_t *ps_me_ctxt = &ps_proc->s_me_ctxt;
+
+    /* mv bits */
+    UWORD8 *pu1_mv_bits = ps_me_ctxt->pu1_mv_bits;
+
+    /* mv predictors */
+    mv_t *ps_l0_pred_mv = &ps_proc->ps_pred_mv[PRED_L0].s_mv;
+    mv_t *ps_l1_pred_mv = &ps_proc->ps_pred_mv[PRED_L1].s_mv;
+
+    WORD32 i4_mb_cost;
+
+    ps_proc->ps_codec->pf_inter_pred_luma_bilinear(apu1_pred[PRED_L0], apu1_pred[PRED_L1],
+                                                   pu1_dst, ai4_pred_strd[PRED_L0],
+                                                   ai4_pred_strd[PRED_L1], HP_BUFF_WD,
+                                                   MB_SIZE, MB_SIZE);
+
+    ps_me_ctxt->pf_ime_compute_sad_16x16[ps_me_ctxt->u4_enable_fast_sad](
+                    ps_me_ctxt->pu1_src_buf_luma, pu1_dst,
+                    ps_me_ctxt->i4_src_strd, HP_BUFF_WD,
+                    INT_MAX, pi4_distortion);
+
+    i4_mb_cost =  pu1_mv_bits[ps_mv_pair[PRED_L0].i2_mvx - ps_l0_pred_mv->i2_mvx];
+    i4_mb_cost += pu1_mv_bits[ps_mv_pair[PRED_L0].i2_mvy - ps_l0_pred_mv->i2_mvy];
+    i4_mb_cost += pu1_mv_bits[ps_mv_pair[PRED_L1].i2_mvx - ps_l1_pred_mv->i2_mvx];
+    i4_mb_cost += pu1_mv_bits[ps_mv_pair[PRED_L1].i2_mvy - ps_l1_pred_mv->i2_mvy];
+
+    return *pi4_distortion + i4_mb_cost * ps_me_ctxt->u4_lambda_motion;
+}
+
+/**
+*******************************************************************************
+*
+* @brief Joint refinement of the best bipred mv pair
+*
+* @par Description:
+*  The co-located mv scaled by the poc distances, as temporal direct would
+*  derive it, is evaluated as an mv pair at its qpel precision first and
+*  replaces the best pair of ih264e_evaluate_bipred if it is cheaper. The pair
+*  is then refined iteratively, the L1 mv is searched holding the L0
+*  prediction fixed, then the L0 mv holding the L1 prediction fixed. Each
+*  search evaluates the full pel grid around the mv and, when half pel is
+*  enabled, the eight half pel neighbours of the best full pel. Full pel
+*  predictions are read in place from the reference and half pel ones from
+*  the half pel planes generated once around the best full pel, so no
+*  position is interpolated on its own. The refinement stops at the first
+*  pass that does not improve the pair and is bounded by BIPRED_REFINE_ITERS
+*  passes.
+*
+* @param[in] ps_proc
+*  Process context corresponding to the job
+*
+* @param[in/out] ps_mb_ctxt_bi
+*  Bipred mb part ctxt, holds the best pair on return
+*
+* @returns  none
+*
+* @remarks The best pair is written back to its position in the bipred
+*  candidate list. It is coded as a B16x16 bipred with explicit mvds, the
+*  slices signal spatial direct prediction, so the scaled co-located pair is
+*  a search candidate and not a direct mode
+*
+*******************************************************************************
+*/
+static void ih264e_refine_bipred(process_ctxt_t *ps_proc,
+                                 mb_part_ctxt *ps_mb_ctxt_bi)
+{
+    /* me ctxt */
+    me_ctxt_t *ps_me_ctxt = &ps_proc->s_me_ctxt;
+
+    /* codec context */
+    codec_t *ps_codec = ps_proc->ps_codec;
+
+    /* recon stride */
+    WORD32 i4_rec_strd = ps_me_ctxt->i4_rec_strd;
+
+    /* best pair of ih264e_evaluate_bipred */
+    ime_mv_t *ps_best_pair = &ps_me_ctxt->as_mv_init_search[PRED_BI][ps_mb_ctxt_bi->i4_srch_pos_idx << 1];
+
+    /* predictions of the lists and their strides */
+    UWORD8 *apu1_pred[MAX_NUM_REFLIST];
+    WORD32 ai4_pred_strd[MAX_NUM_REFLIST];
+
+    /* prediction buffers of the fixed and the searched list and the average */
+    UWORD8 *pu1_fixed_buf = ps_proc->au1_bipred_buf[0];
+    UWORD8 *pu1_srch_buf = ps_proc->au1_bipred_buf[1];
+    UWORD8 *apu1_bi_buf[2];
+    WORD32 i4_buf_idx = 0;
+
+    /* half pel planes of the searched list, half x, half y and half xy */
+    UWORD8 *apu1_hpel_buf[3];
+
+    /* search range in qpel units */
+    WORD32 i4_srch_range_w = ps_me_ctxt->i4_srch_range_w << 2;
+    WORD32 i4_srch_range_e = ps_me_ctxt->i4_srch_range_e << 2;
+    WORD32 i4_srch_range_n = ps_me_ctxt->i4_srch_range_n << 2;
+    WORD32 i4_srch_range_s = ps_me_ctxt->i4_srch_range_s << 2;
+
+    /* temp var */
+    ime_mv_t as_mv[MAX_NUM_REFLIST], s_ctr;
+    WORD32 i4_cost, i4_distortion, i4_improved;
+    WORD32 i4_iter, i4_srch_list, i4_step, k, i, j;
+    UWORD8 *pu1_hpel_src;
+
+    if (ps_mb_ctxt_bi->i4_mb_cost == INT_MAX)
+    {
+        return;
+    }
+
+    apu1_hpel_buf[0] = ps_proc->au1_bipred_buf[2];
+    apu1_hpel_buf[1] = ps_proc->au1_bipred_buf[3];
+    apu1_hpel_buf[2] = ps_proc->au1_bipred_buf[4];
+    apu1_bi_buf[0] = ps_proc->au1_bipred_buf[5];
+    apu1_bi_buf[1] = ps_proc->au1_bipred_buf[6];
+
+    /* co-located mv pair scaled by the poc distances */
+    as_mv[PRED_L0].i2_mvx = ps_proc->ps_skip_mv[2 + PRED_L0].s_mv.i2_mvx;
+    as_mv[PRED_L0].i2_mvy = ps_proc->ps_skip_mv[2 + PRED_L0].s_mv.i2_mvy;
+    as_mv[PRED_L1].i2_mvx = ps_proc->ps_skip_mv[2 + PRED_L1].s_mv.i2_mvx;
+    as_mv[PRED_L1].i2_mvy = ps_proc->ps_skip_mv[2 + PRED_L1].s_mv.i2_mvy;
+
+    for (k = PRED_L0; k <= PRED_L1; k++)
+    {
+        if ((as_mv[k].i2_mvx < i4_srch_range_w) || (as_mv[k].i2_mvx > i4_srch_range_e) ||
+            (as_mv[k].i2_mvy < i4_srch_range_n) || (as_mv[k].i2_mvy > i4_srch_range_s))
+        {
+            break;
+        }
+    }
+
+    if (k > PRED_L1)
+    {
+        apu1_pred[PRED_L0] = ih264e_get_pred_luma_16x16(ps_proc, PRED_L0, &as_mv[PRED_L0],
+                                                        pu1_fixed_buf, &ai4_pred_strd[PRED_L0]);
+        apu1_pred[PRED_L1] = ih264e_get_pred_luma_16x16(ps_proc, PRED_L1, &as_mv[PRED_L1],
+                                                        pu1_srch_buf, &ai4_pred_strd[PRED_L1]);
+
+        i4_cost = ih264e_compute_bipred_cost(ps_proc, apu1_pred, ai4_pred_strd, as_mv,
+                                             apu1_bi_buf[i4_buf_idx], &i4_distortion);
+
+        if (i4_cost < ps_mb_ctxt_bi->i4_mb_cost)
+        {
+            ps_mb_ctxt_bi->i4_mb_cost = i4_cost;
+            ps_mb_ctxt_bi->i4_mb_distortion = i4_distortion;
+            ps_mb_ctxt_bi->pu1_best_hpel_buf = apu1_bi_buf[i4_buf_idx];
+            ps_best_pair[PRED_L0] = as_mv[PRED_L0];
+            ps_best_pair[PRED_L1] = as_mv[PRED_L1];
+
+            i4_buf_idx = !i4_buf_idx;
+        }
+    }
+
+    /* search L1 holding L0 fixed, then the reverse */
+    for (i4_iter = 0; i4_iter < BIPRED_REFINE_ITERS; i4_iter++)
+    {
+        WORD32 i4_fixed_list;
+
+        i4_srch_list = (i4_iter & 1) ? PRED_L0 : PRED_L1;
+        i4_fixed_list = !i4_srch_list;
+        i4_improved = 0;
+
+        as_mv[i4_fixed_list] = ps_best_pair[i4_fixed_list];
+
+        apu1_pred[i4_fixed_list] = ih264e_get_pred_luma_16x16(ps_proc, i4_fixed_list,
+                                                              &as_mv[i4_fixed_list],
+                                                              pu1_fixed_buf,
+                                                              &ai4_pred_strd[i4_fixed_list]);
+
+        for (i4_step = 4; i4_step >= 2; i4_step >>= 1)
+        {
+            if ((i4_step == 2) && !ps_me_ctxt->u4_enable_hpel)
+            {
+                break;
+            }
+
+            /* both steps are centred on the full pel nearest to the best mv */
+            s_ctr = ps_best_pair[i4_srch_list];
+            s_ctr.i2_mvx = (s_ctr.i2_mvx + 2) & ~3;
+            s_ctr.i2_mvy = (s_ctr.i2_mvy + 2) & ~3;
+
+            if (i4_step == 2)
+            {
+                /* half pel planes around the full pel centre, laid out as
+                 * in ime_sub_pel_motion_estimation_16x16 */
+                pu1_hpel_src = ps_me_ctxt->apu1_ref_buf_luma[i4_srch_list]
+                                + (s_ctr.i2_mvy >> 2) * i4_rec_strd + (s_ctr.i2_mvx >> 2) - 1;
+
+                ps_codec->pf_ih264e_sixtapfilter_horz(pu1_hpel_src, apu1_hpel_buf[0],
+                                                      i4_rec_strd, HP_BUFF_WD);
+
+                pu1_hpel_src -= i4_rec_strd;
+
+                ps_codec->pf_ih264e_sixtap_filter_2dvh_vert(pu1_hpel_src, apu1_hpel_buf[1],
+                                                            apu1_hpel_buf[2], i4_rec_strd,
+                                                            HP_BUFF_WD, ps_proc->ai16_pred1 + 3,
+                                                            HP_BUFF_WD);
+            }
+
+            for (i = -i4_step; i <= i4_step; i += i4_step)
+            {
+                for (j = -i4_step; j <= i4_step; j += i4_step)
+                {
+                    as_mv[i4_srch_list].i2_mvx = s_ctr.i2_mvx + j;
+                    as_mv[i4_srch_list].i2_mvy = s_ctr.i2_mvy + i;
+
+                    if ((as_mv[i4_srch_list].i2_mvx == ps_best_pair[i4_srch_list].i2_mvx) &&
+                                    (as_mv[i4_srch_list].i2_mvy == ps_best_pair[i4_srch_list].i2_mvy))
+                    {
+                        continue;
+                    }
+
+                    if ((as_mv[i4_srch_list].i2_mvx < i4_srch_range_w) ||
+                                    (as_mv[i4_srch_list].i2_mvx > i4_srch_range_e) ||
+                                    (as_mv[i4_srch_list].i2_mvy < i4_srch_range_n) ||
+                                    (as_mv[i4_srch_list].i2_mvy > i4_srch_range_s))
+                    {
+                        continue;
+                    }
+
+                    if ((i4_step == 2) && (i || j))
+                    {
+                        /* half pel position in the planes */
+                        if (i == 0)
+                        {
+                            apu1_pred[i4_srch_list] = apu1_hpel_buf[0] + (j > 0);
+                        }
+                        else if (j == 0)
+                        {
+                            apu1_pred[i4_srch_list] = apu1_hpel_buf[1] + 1 + (i > 0) * HP_BUFF_WD;
+                        }
+                        else
+                        {
+                            apu1_pred[i4_srch_list] = apu1_hpel_buf[2] + (j > 0) + (i > 0) * HP_BUFF_WD;
+                        }
+                        ai4_pred_strd[i4_srch_list] = HP_BUFF_WD;
+                    }
+                    else
+                    {
+                        apu1_pred[i4_srch_list] = ih264e_get_pred_luma_16x16(ps_proc, i4_srch_list,
+                                                                             &as_mv[i4_srch_list],
+                                                                             pu1_srch_buf,
+                                                                             &ai4_pred_strd[i4_srch_list]);
+                    }
+
+                    i4_cost = ih264e_compute_bipred_cost(ps_proc, apu1_pred, ai4_pred_strd, as_mv,
+                                                         apu1_bi_buf[i4_buf_idx],
+                                                         &i4_distortion);
+
+                    if (i4_cost < ps_mb_ctxt_bi->i4_mb_cost)
+                    {
+                        ps_mb_ctxt_bi->i4_mb_cost = i4_cost;
+                        ps_mb_ctxt_bi->i4_mb_distortion = i4_distortion;
+                        ps_mb_ctxt_bi->pu1_best_hpel_buf = apu1_bi_buf[i4_buf_idx];
+                        ps_best_pair[i4_srch_list] = as_mv[i4_srch_list];
+                        i4_improved = 1;
+
+                        /* keep the best prediction, average into the other buffer */
+                        i4_buf_idx = !i4_buf_idx;
+                    }
+                }
+            }
+        }
+
+        /* no neighbour improved the pair, it is a local minimum of both lists */
+        if (!i4_improved)
+        {
+            break;
+        }
+    }
+}
+
 /**
 *******************************************************************************
 *
@@ -1817,13 +4164,11 @@ void ih264e_compute_me_multi_reflist(process_ctxt_t *ps_proc)
         columns_right = (ps_proc->i4_wd_mbs - ps_proc->i4_mb_x) * MB_SIZE;
 
         /* init srch range */
-        /* NOTE : For now, lets limit the search range by DEFAULT_MAX_SRCH_RANGE_X / 2
-         * on all sides.
-         */
-        ps_me_ctxt->i4_srch_range_w = -MIN(columns_left, DEFAULT_MAX_SRCH_RANGE_X >> 1);
-        ps_me_ctxt->i4_srch_range_e = MIN(columns_right, DEFAULT_MAX_SRCH_RANGE_X >> 1);
-        ps_me_ctxt->i4_srch_range_n = -MIN(rows_above, DEFAULT_MAX_SRCH_RANGE_Y >> 1);
-        ps_me_ctxt->i4_srch_range_s = MIN(rows_below, DEFAULT_MAX_SRCH_RANGE_Y >> 1);
+        /* limit the search range to the configured search range on all sides */
+        ps_me_ctxt->i4_srch_range_w = -MIN(columns_left, ps_me_ctxt->ai2_srch_boundaries[0]);
+        ps_me_ctxt->i4_srch_range_e = MIN(columns_right, ps_me_ctxt->ai2_srch_boundaries[0]);
+        ps_me_ctxt->i4_srch_range_n = -MIN(rows_above, ps_me_ctxt->ai2_srch_boundaries[1]);
+        ps_me_ctxt->i4_srch_range_s = MIN(rows_below, ps_me_ctxt->ai2_srch_boundaries[1]);
 
         /* this is to facilitate fast sub pel computation with minimal loads */
         if (ps_me_ctxt->u4_enable_hpel)
@@ -1851,6 +4196,9 @@ void ih264e_compute_me_multi_reflist(process_ctxt_t *ps_proc)
         for (i4_reflist = PRED_L0; i4_reflist <= i4_max_reflist; i4_reflist++)
         {
 
+            /* Get the mv predictor and the skip motion vector          */
+            ih264e_get_pred_and_skip_mv(ps_proc, ps_me_ctxt, i4_reflist);
+
             /* Get the seed motion vector candidates                    */
             ih264e_get_search_candidates(ps_proc, ps_me_ctxt, i4_reflist);
 
@@ -2011,7 +4359,8 @@ void ih264e_compute_me_multi_reflist(process_ctxt_t *ps_proc)
             }
             ps_me_ctxt->u4_subpel_buf_strd = HP_BUFF_WD;
 
-            /* Copy the statial SKIP MV of each list */
+            /* Copy the statial SKIP MV of each list, the skip candidates are
+             * the last two of ih264e_get_search_candidates */
             i4_l0_skip_mv_idx = ps_me_ctxt->u4_num_candidates[PRED_L0] - 2;
             i4_l1_skip_mv_idx = ps_me_ctxt->u4_num_candidates[PRED_L1] - 2;
             ps_me_ctxt->as_mv_init_search[PRED_BI][0].i2_mvx = ps_me_ctxt->as_mv_init_search[PRED_L0][i4_l0_skip_mv_idx].i2_mvx << 2;
@@ -2039,6 +4388,12 @@ void ih264e_compute_me_multi_reflist(process_ctxt_t *ps_proc)
             ih264e_evaluate_bipred(ps_me_ctxt, ps_proc,
                                    &ps_me_ctxt->as_mb_part[PRED_BI]);
 
+            /* joint L0/L1 refinement of the bipred mv pair */
+            if (ps_codec->u4_enable_bipred_refine)
+            {
+                ih264e_refine_bipred(ps_proc, &ps_me_ctxt->as_mb_part[PRED_BI]);
+            }
+
             i4_max_reflist = PRED_BI;
         }
 
@@ -221,6 +221,12 @@ ih264e_skip_params_ft  ih264e_find_bskip_params_me;
  * @param[out] ps_pred_mv
  *  pointer to candidate predictors for the current block
  *
+ * @param[in] i4_ref_list
+ *  reference list of the prediction
+ *
+ * @param[in] i4_ref_idx
+ *  reference index of the current block in the reference list
+ *
  * @returns  The x & y components of the MV predictor.
  *
  * @remarks The code implements the logic as described in sec 8.4.1.3 in H264
@@ -230,7 +236,8 @@ ih264e_skip_params_ft  ih264e_find_bskip_params_me;
  *******************************************************************************
  */
 void ih264e_get_mv_predictor(enc_pu_t *ps_left_mb_pu, enc_pu_t *ps_top_row_pu,
-                             enc_pu_mv_t *ps_pred_mv, WORD32 i4_ref_list);
+                             enc_pu_mv_t *ps_pred_mv, WORD32 i4_ref_list,
+                             WORD32 i4_ref_idx);
 
 /**
  *******************************************************************************
@@ -270,6 +277,34 @@ ih264e_compute_me_ft  ih264e_compute_me_multi_reflist;
  */
 ih264e_compute_me_ft  ih264e_compute_me_single_reflist;
 
+/**
+ *******************************************************************************
+ *
+ * @brief Builds the downsampled luma planes of a picture for pre-enc ME
+ *
+ * @par Description:
+ *  Forms the 1/4 and 1/16 resolution luma planes of the input picture by
+ *  2x2 averaging and stores them in the MV bank of the picture.
+ *
+ * @param[in] ps_codec
+ *  Pointer to codec context
+ *
+ * @param[in] ps_inp_buf
+ *  Pointer to current input buffer
+ *
+ * @param[out] ps_mv_buf
+ *  MV bank of the current picture
+ *
+ * @returns  none
+ *
+ * @remarks none
+ *
+ *******************************************************************************
+ */
+void ih264e_build_me_pyramid(codec_t *ps_codec,
+                             inp_buf_t *ps_inp_buf,
+                             mv_buf_t *ps_mv_buf);
+
 /**
  *******************************************************************************
  *
@@ -340,6 +375,12 @@ void ih264e_mv_pred(process_ctxt_t *ps_proc, WORD32 i4_reflist);
  * @param[in] ps_proc
  *  Process context corresponding to the job
  *
+ * @param[in] i4_ref_list
+ *  reference list of the prediction
+ *
+ * @param[in] i4_ref_idx
+ *  reference index in the reference list
+ *
  * @returns  none
  *
  * @remarks none
@@ -348,6 +389,58 @@ void ih264e_mv_pred(process_ctxt_t *ps_proc, WORD32 i4_reflist);
  *
  *******************************************************************************
  */
-void ih264e_mv_pred_me(process_ctxt_t *ps_proc, WORD32 i4_ref_list);
+void ih264e_mv_pred_me(process_ctxt_t *ps_proc, WORD32 i4_ref_list,
+                       WORD32 i4_ref_idx);
+
+/**
+ *******************************************************************************
+ *
+ * @brief Returns the pu covering an 8x8 block of an mb
+ *
+ * @par Description:
+ *  The pus of an mb are stored in partition order in its mv bank slot. The
+ *  index of the pu covering the requested 8x8 block is derived from the
+ *  dimensions of the first pu of the mb.
+ *
+ * @param[in] ps_mb_pu
+ *  Pointer to the first pu of the mb
+ *
+ * @param[in] i4_blk_x
+ *  Horizontal index of the 8x8 block (0 or 1)
+ *
+ * @param[in] i4_blk_y
+ *  Vertical index of the 8x8 block (0 or 1)
+ *
+ * @returns  Pointer to the pu covering the block
+ *
+ * @remarks none
+ *
+ *******************************************************************************
+ */
+enc_pu_t *ih264e_get_8x8_blk_pu(enc_pu_t *ps_mb_pu,
+                                WORD32 i4_blk_x,
+                                WORD32 i4_blk_y);
+
+/**
+ *******************************************************************************
+ *
+ * @brief This function performs MV prediction of the sub mb partitions
+ *
+ * @par Description:
+ *  Computes the exact motion vector predictor of each partition of a 16x8,
+ *  8x16 or 8x8 P mb, including the directional predictions for 16x8 and 8x16
+ *
+ * @param[in] ps_proc
+ *  Process context corresponding to the job
+ *
+ * @returns  none
+ *
+ * @remarks The code implements the logic as described in sec 8.4.1.3 in H264
+ *   specification. Should be called after intra inter decision of the
+ *   neighbors is known
+ *
+ *******************************************************************************
+ */
+void ih264e_mv_pred_mb_part(process_ctxt_t *ps_proc);
 
 #endif /* IH264E_ME_H_ */
@@ -739,8 +739,11 @@ IH264E_ERROR_T ih264e_pack_header_data(process_ctxt_t *ps_proc)
 
         WORD16 *i2_mv_ptr;
 
-        /* mb type plus mode */
-        *pu1_ptr++ = u4_mb_type;
+        /* L0 ref idx */
+        UWORD32 u4_ref_idx = -1 - ps_proc->ps_pu->s_me_info[0].i1_ref_idx;
+
+        /* mb type plus ref idx */
+        *pu1_ptr++ = (u4_ref_idx << 4) + u4_mb_type;
 
         /* cbp */
         *pu1_ptr++ = ps_proc->u4_cbp;
@@ -757,6 +760,41 @@ IH264E_ERROR_T ih264e_pack_header_data(process_ctxt_t *ps_proc)
         /* end of mb layer */
         ps_proc->pv_mb_header_data = i2_mv_ptr;
     }
+    else if (u4_mb_type == P16x8 || u4_mb_type == P8x16 || u4_mb_type == P8x8)
+    {
+        /* pointer to mb header storage space */
+        UWORD8 *pu1_ptr = ps_proc->pv_mb_header_data;
+
+        WORD16 *i2_mv_ptr;
+
+        /* temp var */
+        UWORD32 i;
+
+        /* L0 ref idx, shared by the partitions */
+        UWORD32 u4_ref_idx = -1 - ps_proc->ps_pu->s_me_info[0].i1_ref_idx;
+
+        /* mb type plus ref idx */
+        *pu1_ptr++ = (u4_ref_idx << 4) + u4_mb_type;
+
+        /* cbp */
+        *pu1_ptr++ = ps_proc->u4_cbp;
+
+        /* mb qp delta */
+        *pu1_ptr++ = ps_proc->u4_mb_qp - ps_proc->u4_mb_qp_prev;
+
+        i2_mv_ptr = (WORD16 *)pu1_ptr;
+
+        /* mvd of each partition */
+        for (i = 0; i < ps_proc->u4_num_sub_partitions; i++)
+        {
+            *i2_mv_ptr++ = ps_proc->ps_pu[i].s_me_info[0].s_mv.i2_mvx - ps_proc->as_part_pred_mv[i].i2_mvx;
+
+            *i2_mv_ptr++ = ps_proc->ps_pu[i].s_me_info[0].s_mv.i2_mvy - ps_proc->as_part_pred_mv[i].i2_mvy;
+        }
+
+        /* end of mb layer */
+        ps_proc->pv_mb_header_data = i2_mv_ptr;
+    }
     else if (u4_mb_type == PSKIP)
     {
         /* pointer to mb header storage space */
@@ -939,6 +977,12 @@ WORD32 ih264e_update_proc_ctxt(process_ctxt_t *ps_proc)
         /*****************************************/
         /* mv */
         *ps_top_left_mb_pu = *ps_top_row_pu;
+
+        /* the top mb is partitioned, its bottom right block is the top left */
+        if (i4_mb_y > 0 && !ps_top_syn->u2_is_intra)
+        {
+            *ps_top_left_mb_pu = *ih264e_get_8x8_blk_pu(ps_proc->ps_top_row_pu_ME + i4_mb_x * ENC_MAX_PU_IN_MB, 1, 1);
+        }
     }
 
     /*************************************************/
@@ -986,7 +1030,8 @@ WORD32 ih264e_update_proc_ctxt(process_ctxt_t *ps_proc)
     else
     {
         /* mv */
-        *ps_left_mb_pu = *ps_top_row_pu = *(ps_proc->ps_pu);
+        *ps_left_mb_pu = *ih264e_get_8x8_blk_pu(ps_proc->ps_pu, 1, 0);
+        *ps_top_row_pu = *ih264e_get_8x8_blk_pu(ps_proc->ps_pu, 0, 1);
     }
 
     /*
@@ -1086,13 +1131,13 @@ WORD32 ih264e_update_proc_ctxt(process_ctxt_t *ps_proc)
     ps_proc->i4_mb_cost = INT_MAX;
     ps_proc->i4_mb_distortion = SHRT_MAX;
 
-    ps_proc->ps_pu += *ps_proc->pu4_mb_pu_cnt;
+    ps_proc->ps_pu += ENC_MAX_PU_IN_MB;
 
     ps_proc->pu4_mb_pu_cnt += 1;
 
     /* Update colocated pu */
     if (ps_proc->i4_slice_type == BSLICE)
-        ps_proc->ps_colpu += *(ps_proc->aps_mv_buf[1]->pu4_mb_pu_cnt +  (i4_mb_y * ps_proc->i4_wd_mbs) + i4_mb_x);
+        ps_proc->ps_colpu += ENC_MAX_PU_IN_MB;
 
     /* deblk ctxts */
     if (ps_proc->u4_disable_deblock_level != 1)
@@ -1371,12 +1416,10 @@ IH264E_ERROR_T ih264e_init_proc_ctxt(process_ctxt_t *ps_proc)
     /*********************************************************************/
 
     /* init mv buffer ptr */
-    ps_proc->ps_pu = ps_cur_mv_buf->ps_pic_pu + (i4_mb_y * ps_proc->i4_wd_mbs *
-                     ((MB_SIZE * MB_SIZE) / (ENC_MIN_PU_SIZE * ENC_MIN_PU_SIZE)));
+    ps_proc->ps_pu = ps_cur_mv_buf->ps_pic_pu + (i4_mb_y * ps_proc->i4_wd_mbs * ENC_MAX_PU_IN_MB);
 
     /* Init co-located mv buffer */
-    ps_proc->ps_colpu = ps_proc->aps_mv_buf[1]->ps_pic_pu + (i4_mb_y * ps_proc->i4_wd_mbs *
-                        ((MB_SIZE * MB_SIZE) / (ENC_MIN_PU_SIZE * ENC_MIN_PU_SIZE)));
+    ps_proc->ps_colpu = ps_proc->aps_mv_buf[1]->ps_pic_pu + (i4_mb_y * ps_proc->i4_wd_mbs * ENC_MAX_PU_IN_MB);
 
     if (i4_mb_y == 0)
     {
@@ -1384,8 +1427,7 @@ IH264E_ERROR_T ih264e_init_proc_ctxt(process_ctxt_t *ps_proc)
     }
     else
     {
-        ps_proc->ps_top_row_pu_ME = ps_cur_mv_buf->ps_pic_pu + ((i4_mb_y - 1) * ps_proc->i4_wd_mbs *
-                                    ((MB_SIZE * MB_SIZE) / (ENC_MIN_PU_SIZE * ENC_MIN_PU_SIZE)));
+        ps_proc->ps_top_row_pu_ME = ps_cur_mv_buf->ps_pic_pu + ((i4_mb_y - 1) * ps_proc->i4_wd_mbs * ENC_MAX_PU_IN_MB);
     }
 
     ps_proc->pu4_mb_pu_cnt = ps_cur_mv_buf->pu4_mb_pu_cnt + (i4_mb_y * ps_proc->i4_wd_mbs);
@@ -2038,6 +2080,7 @@ WORD32 ih264e_process(process_ctxt_t *ps_proc)
                     ps_proc->u4_min_sad = ps_proc->ps_nmb_info[u4_mb_index].u4_min_sad;
                     ps_proc->u4_min_sad_reached = ps_proc->ps_nmb_info[u4_mb_index].u4_min_sad_reached;
                     ps_proc->u4_mb_type = ps_proc->ps_nmb_info[u4_mb_index].u4_mb_type;
+                    ps_proc->u4_num_sub_partitions = *ps_proc->pu4_mb_pu_cnt;
 
                     /* get the best sub pel buffer */
                     ps_proc->pu1_best_subpel_buf = ps_proc->ps_nmb_info[u4_mb_index].pu1_best_sub_pel_buf;
@@ -2170,6 +2213,12 @@ WORD32 ih264e_process(process_ctxt_t *ps_proc)
         if (ps_proc->i4_slice_type != ISLICE)
         {
             ih264e_mv_pred(ps_proc, ps_proc->i4_slice_type);
+
+            /* mv pred of the sub mb partitions */
+            if (!is_intra && ps_proc->u4_num_sub_partitions > 1)
+            {
+                ih264e_mv_pred_mb_part(ps_proc);
+            }
         }
 
         /* Perform luma mb core coding */
@@ -2190,7 +2239,7 @@ WORD32 ih264e_process(process_ctxt_t *ps_proc)
                     ps_proc->u4_mb_type = (ps_proc->u4_cbp) ? BDIRECT : BSKIP;
                 }
             }
-            else if(!ps_proc->u4_cbp)
+            else if(!ps_proc->u4_cbp && ps_proc->u4_mb_type == P16x16)
             {
                 if (ih264e_find_pskip_params(ps_proc, PRED_L0))
                 {
@@ -480,6 +480,9 @@ typedef struct
     /** ME speed preset - Value between 0 (slowest) and 100 (fastest)      */
     UWORD32                                     u4_me_speed_preset;
 
+    /** Flag to enable/disable pre-enc (pyramid) motion estimation      */
+    UWORD32                                     u4_pre_enc_me;
+
     /** Flag to enable/disable half pel motion estimation               */
     UWORD32                                     u4_enable_hpel;
 
@@ -519,6 +522,12 @@ typedef struct
     /** IDR frame interval                                              */
     UWORD32                                     u4_idr_frm_interval;
 
+    /** Flag to enable/disable lookahead based adaptive B frame placement */
+    UWORD32                                     u4_enable_adaptive_bframes;
+
+    /** Frame type inserted at detected scene cuts (IV_NA_FRAME: disabled) */
+    IV_PICTURE_CODING_TYPE_T                    e_scene_cut_frm_type;
+
     /** Disable deblock level (0: Enable completely, 3: Disable completely */
     UWORD32                                     u4_disable_deblock_level;
 
@@ -639,6 +648,17 @@ typedef struct
      */
     UWORD16 *pu1_pic_slice_map;
 
+    /**
+     * Pointers to the 1/4 and 1/16 resolution luma planes of the picture,
+     * used by pre-enc ME
+     */
+    UWORD8 *apu1_pyr_luma[PYR_LEVELS_CNT];
+
+    /**
+     * Flag to indicate if the downsampled luma planes hold valid data
+     */
+    WORD32 i4_pyr_valid;
+
     /**
      * Absolute POC for the current MV Bank
      */
@@ -1080,6 +1100,11 @@ typedef struct
      */
      WORD32 i4_abs_pic_order_cnt;
 
+     /**
+      * Number of active L0 references of the current slice
+      */
+     WORD32 i4_num_ref_idx_l0_active;
+
      /**
       * mb skip run
       */
@@ -1257,12 +1282,12 @@ struct _proc_t
     /**
      * Ref pointer to current MB luma
      */
-    UWORD8 *apu1_ref_buf_luma[MAX_REF_PIC_CNT];
+    UWORD8 *apu1_ref_buf_luma[MAX_NUM_REFLIST];
 
     /**
      * Ref pointer to current MB chroma
      */
-    UWORD8 *apu1_ref_buf_chroma[MAX_REF_PIC_CNT];
+    UWORD8 *apu1_ref_buf_chroma[MAX_NUM_REFLIST];
 
     /**
      * pointer to luma plane of input buffer (base :: mb (0,0))
@@ -1277,7 +1302,7 @@ struct _proc_t
     /**
      * pointer to luma plane of ref buffer (base :: mb (0,0))
      */
-    UWORD8 *apu1_ref_buf_luma_base[MAX_REF_PIC_CNT];
+    UWORD8 *apu1_ref_buf_luma_base[MAX_NUM_REFLIST];
 
     /**
      * pointer to  chroma plane of input buffer (base :: mb (0,0))
@@ -1303,7 +1328,28 @@ struct _proc_t
     /**
      * pointer to  chroma plane of reconstructed buffer (base :: mb (0,0))
      */
-    UWORD8 *apu1_ref_buf_chroma_base[MAX_REF_PIC_CNT];
+    UWORD8 *apu1_ref_buf_chroma_base[MAX_NUM_REFLIST];
+
+    /**
+     * Number of active L0 references of the current slice
+     */
+    WORD32 i4_num_ref_idx_l0_active;
+
+    /**
+     * pointer to luma plane of each L0 reference (base :: mb (0,0)).
+     * Entry 0 is same as apu1_ref_buf_luma_base[PRED_L0]
+     */
+    UWORD8 *apu1_ref_l0_luma_base[MAX_REF_PIC_CNT];
+
+    /**
+     * pointer to chroma plane of each L0 reference (base :: mb (0,0))
+     */
+    UWORD8 *apu1_ref_l0_chroma_base[MAX_REF_PIC_CNT];
+
+    /**
+     * poc distance between current picture and each L0 reference
+     */
+    WORD32 ai4_ref_l0_poc_dist[MAX_REF_PIC_CNT];
 
     /**
      * Pointer to ME NMB info
@@ -1569,6 +1615,11 @@ struct _proc_t
      */
     enc_pu_mv_t *ps_pred_mv;
 
+    /**
+     * predicted motion vectors of the sub mb partitions of the current mb
+     */
+    mv_t as_part_pred_mv[ENC_MAX_PU_IN_MB];
+
     /**
      * top row mb syntax information base
      * In normal working scenarios, for a given context set,
@@ -1855,16 +1906,32 @@ struct _proc_t
       */
     WORD32 ai16_pred1[HP_BUFF_WD * HP_BUFF_HT];
 
+    /**
+     * Prediction buffers for the joint L0/L1 refinement of bipred
+     */
+    UWORD8 au1_bipred_buf[BIPRED_BUFF_CNT][HP_BUFF_WD * HP_BUFF_HT];
+
     /**
      * Reference picture for the current picture
      * TODO: Only 2 reference assumed currently
      */
-    pic_buf_t *aps_ref_pic[MAX_REF_PIC_CNT];
+    pic_buf_t *aps_ref_pic[MAX_NUM_REFLIST];
 
     /**
      * Reference MV buff for the current picture
      */
-    mv_buf_t *aps_mv_buf[MAX_REF_PIC_CNT];
+    mv_buf_t *aps_mv_buf[MAX_NUM_REFLIST];
+
+    /**
+     * Downsampled luma planes of the current picture, used by pre-enc ME
+     */
+    UWORD8 *apu1_pyr_src_luma[PYR_LEVELS_CNT];
+
+    /**
+     * Downsampled luma planes of the reference pictures, NULL when pre-enc
+     * ME is disabled or the planes of the reference are not available
+     */
+    UWORD8 *apu1_pyr_ref_luma[MAX_NUM_REFLIST][PYR_LEVELS_CNT];
 
     /**
      * frame info used by RC
@@ -1911,6 +1978,93 @@ struct _proc_t
 
 };
 
+/**
+ ******************************************************************************
+ *  @brief      Lookahead statistics of an input picture
+ ******************************************************************************
+ */
+typedef struct
+{
+    /**
+     * Id of the picture given to rate control, -1 if the entry is unused
+     */
+    WORD32 i4_pic_id;
+
+    /**
+     * Position of the picture in the order of arrival
+     */
+    WORD32 i4_seq_no;
+
+    /**
+     * 1/16 resolution luma plane of the picture
+     */
+    UWORD8 *pu1_luma;
+
+    /**
+     * Intra cost estimate of the picture
+     */
+    WORD32 i4_intra_cost;
+
+    /**
+     * Inter cost estimate of the picture from the previous input picture, -1
+     * if it is not estimated
+     */
+    WORD32 i4_inter_cost;
+
+    /**
+     * Flag to indicate a scene cut between the previous picture and this one
+     */
+    WORD32 i4_is_scene_cut;
+
+}lookahead_pic_t;
+
+/**
+ ******************************************************************************
+ *  @brief      Lookahead context
+ ******************************************************************************
+ */
+typedef struct
+{
+    /**
+     * Pictures in the lookahead, indexed by their position in arrival order
+     */
+    lookahead_pic_t as_pics[LOOKAHEAD_BUF_CNT];
+
+    /**
+     * Width and height of the 1/16 resolution planes
+     */
+    WORD32 i4_wd;
+    WORD32 i4_ht;
+
+    /**
+     * Number of pictures added to the lookahead
+     */
+    WORD32 i4_num_pics;
+
+    /**
+     * Largest pic id whose sub gop has been examined
+     */
+    WORD32 i4_last_decided_pic_id;
+
+    /**
+     * Pic id of the latest reference picture in encode order
+     */
+    WORD32 i4_last_ref_pic_id;
+
+    /**
+     * Running average of the inter cost of the pictures from their previous
+     * picture, in percent of their intra cost, -1 until the first estimate
+     */
+    WORD32 i4_avg_inter_pct;
+
+    /**
+     * Flag set at a scene cut until the inter cost falls back close to the
+     * running average. No scene cut is flagged while it is set
+     */
+    WORD32 i4_scene_cut_hold;
+
+}lookahead_ctxt_t;
+
 /**
  ******************************************************************************
  *  @brief      Rate control related variables
@@ -2106,6 +2260,21 @@ struct _codec_t
      */
     UWORD32 u4_inter_gate;
 
+    /**
+     * enable 16x8, 8x16 and 8x8 partitions in P mbs
+     */
+    UWORD32 u4_enable_mb_part;
+
+    /**
+     * enable the joint L0/L1 refinement of bipred in B mbs
+     */
+    UWORD32 u4_enable_bipred_refine;
+
+    /**
+     * maximum number of active L0 references of a P slice
+     */
+    UWORD32 u4_max_num_ref_l0_active;
+
     /**
      * Holds mem records passed during init.
      * This will be used to return the mem records during retrieve call
@@ -2547,6 +2716,12 @@ struct _codec_t
     pf_inter_pred_luma_bilinear  pf_inter_pred_luma_bilinear;
     ih264_inter_pred_chroma_ft  *pf_inter_pred_chroma;
 
+    /**
+     * Luma inter pred functions indexed by quarter pel position (dy << 2 | dx),
+     * used for motion compensation of sub mb partitions
+     */
+    ih264_inter_pred_luma_ft    *apf_inter_pred_luma[16];
+
     /**
      * fn ptrs for compute sad routines
      */
@@ -2632,6 +2807,11 @@ struct _codec_t
      */
     WORD32 i4_pending_idr_flag;
 
+    /**
+     * lookahead over the buffered input pictures
+     */
+    lookahead_ctxt_t s_lookahead;
+
     /*
     *Flag to indicate if we have recived the last input frame
     */
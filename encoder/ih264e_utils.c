@@ -111,6 +111,7 @@
 #include "ih264e_master.h"
 #include "irc_rate_control_api.h"
 #include "ime_statistics.h"
+#include "ih264e_lookahead.h"
 
 /*****************************************************************************/
 /* Function Definitions                                                      */
@@ -247,6 +248,12 @@ WORD32 ih264e_input_queue_update(codec_t *ps_codec,
     ps_inp_buf->pv_pic_info = ps_ive_ip->pv_pic_info;
     ps_inp_buf->u4_pic_info_type = ps_ive_ip->u4_pic_info_type;
 
+    /* estimate the costs of the picture for the lookahead */
+    if (ps_ive_ip->s_inp_buf.apv_bufs[0] != NULL)
+    {
+        ih264e_lookahead_add_pic(ps_codec, ps_inp_buf, ps_codec->i4_pic_cnt);
+    }
+
     /***************************************************************************
      * Now we should add the picture to RC stack here
      **************************************************************************/
@@ -290,6 +297,9 @@ WORD32 ih264e_input_queue_update(codec_t *ps_codec,
     /***************************************************************************
      * Get a new pic to encode
      **************************************************************************/
+    /* Restructure the sub gop starting with the next pic, if it is buffered */
+    ih264e_lookahead_decide_pic_types(ps_codec);
+
     /* Query the picture_type */
     e_pictype = ih264e_rc_get_picture_details(
                     ps_codec->s_rate_control.pps_rate_control_api, (WORD32 *)(&u4_pic_id),
@@ -320,6 +330,9 @@ WORD32 ih264e_input_queue_update(codec_t *ps_codec,
         ps_codec->i4_pending_idr_flag = 0;
     }
 
+    /* Code scene cuts as IDR if requested */
+    ih264e_lookahead_update_pic_type(ps_codec, (WORD32)u4_pic_id);
+
     /* Get current frame Qp */
     u1_frame_qp = (UWORD8)irc_get_frame_level_qp(
                     ps_codec->s_rate_control.pps_rate_control_api, e_pictype,
@@ -718,6 +731,7 @@ WORD32 ih264e_get_total_pic_buf_size(WORD32 pic_size,
 * @par Description:
 *  For given number of luma samples  one MV bank size is computed.
 *  Each MV bank includes pu_map and enc_pu_t for all the min PUs(4x4) in a picture
+*  and the downsampled luma planes of the picture used by pre-enc ME
 *
 * @param[in] num_luma_samples
 *  Max number of luma pixels in the frame
@@ -749,6 +763,10 @@ WORD32 ih264e_get_pic_mv_bank_size(WORD32 num_luma_samples)
     /* Size for storing enc_pu_t for each PU */
     mv_bank_size += ALIGN4(num_pu * sizeof(enc_pu_t));
 
+    /* Size for the 1/4 and 1/16 resolution luma planes used by pre-enc ME */
+    mv_bank_size += ALIGN4(num_luma_samples >> 2);
+    mv_bank_size += ALIGN4(num_luma_samples >> 4);
+
     return mv_bank_size;
 }
 
@@ -931,6 +949,14 @@ IH264E_ERROR_T ih264e_mv_buf_mgr_add_bufs(codec_t *ps_codec)
         ps_mv_buf->ps_pic_pu = (enc_pu_t *) (pu1_buf);
         pu1_buf += ALIGN4(num_pu * sizeof(enc_pu_t));
 
+        ps_mv_buf->apu1_pyr_luma[0] = pu1_buf;
+        pu1_buf += ALIGN4(num_luma_samples >> 2);
+
+        ps_mv_buf->apu1_pyr_luma[1] = pu1_buf;
+        pu1_buf += ALIGN4(num_luma_samples >> 4);
+
+        ps_mv_buf->i4_pyr_valid = 0;
+
         ret = ih264_buf_mgr_add((buf_mgr_t *) ps_codec->pv_mv_buf_mgr,
                                 ps_mv_buf, i);
 
@@ -1182,12 +1208,19 @@ IH264E_ERROR_T ih264e_codec_init(codec_t *ps_codec)
 
             /* sub pel off */
             ps_codec->s_cfg.u4_enable_hpel = 1;
+            ps_codec->s_cfg.u4_enable_qpel = 1;
 
             /* deblocking off */
             ps_codec->s_cfg.u4_disable_deblock_level = DISABLE_DEBLK_LEVEL_0;
 
             /* disabled intra inter gating in Inter slices */
             ps_codec->u4_inter_gate = 0;
+
+            /* 16x8, 8x16 and 8x8 partitions in P mbs */
+            ps_codec->u4_enable_mb_part = 1;
+
+            /* active L0 references of P slices */
+            ps_codec->u4_max_num_ref_l0_active = 1;
         }
         else if (ps_codec->s_cfg.u4_enc_speed_preset == IVE_NORMAL)
         {/* normal */
@@ -1200,12 +1233,19 @@ IH264E_ERROR_T ih264e_codec_init(codec_t *ps_codec)
 
             /* sub pel off */
             ps_codec->s_cfg.u4_enable_hpel = 1;
+            ps_codec->s_cfg.u4_enable_qpel = 1;
 
             /* deblocking off */
             ps_codec->s_cfg.u4_disable_deblock_level = DISABLE_DEBLK_LEVEL_0;
 
             /* disabled intra inter gating in Inter slices */
             ps_codec->u4_inter_gate = 0;
+
+            /* 16x8, 8x16 and 8x8 partitions in P mbs */
+            ps_codec->u4_enable_mb_part = 1;
+
+            /* active L0 references of P slices */
+            ps_codec->u4_max_num_ref_l0_active = 1;
         }
         else if (ps_codec->s_cfg.u4_enc_speed_preset == IVE_FAST)
          {/* normal */
@@ -1218,12 +1258,19 @@ IH264E_ERROR_T ih264e_codec_init(codec_t *ps_codec)
 
              /* sub pel off */
              ps_codec->s_cfg.u4_enable_hpel = 1;
+             ps_codec->s_cfg.u4_enable_qpel = 0;
 
              /* deblocking off */
              ps_codec->s_cfg.u4_disable_deblock_level = DISABLE_DEBLK_LEVEL_0;
 
              /* disabled intra inter gating in Inter slices */
              ps_codec->u4_inter_gate = 1;
+
+             /* 16x8, 8x16 and 8x8 partitions in P mbs */
+             ps_codec->u4_enable_mb_part = 0;
+
+             /* active L0 references of P slices */
+             ps_codec->u4_max_num_ref_l0_active = 1;
          }
         else if (ps_codec->s_cfg.u4_enc_speed_preset == IVE_HIGH_SPEED)
         {/* fast */
@@ -1236,12 +1283,19 @@ IH264E_ERROR_T ih264e_codec_init(codec_t *ps_codec)
 
             /* sub pel off */
             ps_codec->s_cfg.u4_enable_hpel = 0;
+            ps_codec->s_cfg.u4_enable_qpel = 0;
 
             /* deblocking off */
             ps_codec->s_cfg.u4_disable_deblock_level = DISABLE_DEBLK_LEVEL_4;
 
             /* disabled intra inter gating in Inter slices */
             ps_codec->u4_inter_gate = 0;
+
+            /* 16x8, 8x16 and 8x8 partitions in P mbs */
+            ps_codec->u4_enable_mb_part = 0;
+
+            /* active L0 references of P slices */
+            ps_codec->u4_max_num_ref_l0_active = 1;
         }
         else if (ps_codec->s_cfg.u4_enc_speed_preset == IVE_FASTEST)
         {/* fastest */
@@ -1253,12 +1307,19 @@ IH264E_ERROR_T ih264e_codec_init(codec_t *ps_codec)
 
             /* sub pel off */
             ps_codec->s_cfg.u4_enable_hpel = 0;
+            ps_codec->s_cfg.u4_enable_qpel = 0;
 
             /* deblocking off */
             ps_codec->s_cfg.u4_disable_deblock_level = DISABLE_DEBLK_LEVEL_4;
 
             /* disabled intra inter gating in Inter slices */
             ps_codec->u4_inter_gate = 1;
+
+            /* 16x8, 8x16 and 8x8 partitions in P mbs */
+            ps_codec->u4_enable_mb_part = 0;
+
+            /* active L0 references of P slices */
+            ps_codec->u4_max_num_ref_l0_active = 1;
         }
     }
 
@@ -1405,8 +1466,10 @@ IH264E_ERROR_T ih264e_pic_init(codec_t *ps_codec, inp_buf_t *ps_inp_buf)
     UWORD8 *pu1_cur_pic_luma, *pu1_cur_pic_chroma;
 
     /* ref buffer set */
-    pic_buf_t *aps_ref_pic[MAX_REF_PIC_CNT] = {NULL, NULL};
-    mv_buf_t *aps_mv_buf[MAX_REF_PIC_CNT] = {NULL, NULL};
+    pic_buf_t *aps_ref_pic[MAX_NUM_REFLIST] = {NULL, NULL};
+    mv_buf_t *aps_mv_buf[MAX_NUM_REFLIST] = {NULL, NULL};
+    pic_buf_t *aps_ref_l0_pic[MAX_REF_PIC_CNT] = {NULL};
+    WORD32 i4_num_ref_l0 = 1;
     WORD32 ref_set_id;
 
     /* pic time stamp */
@@ -1572,25 +1635,31 @@ IH264E_ERROR_T ih264e_pic_init(codec_t *ps_codec, inp_buf_t *ps_inp_buf)
      *      ps_codec->as_ref_set. Each picture in this will have a pic buffer and
      *      MV buffer that is marked appropriately as BUF_MGR_REF, BUF_MGR_IO or
      *      BUF_MGR_CODEC. Also the pic_cnt and poc will also be present.
-     *      Hence to find the ref pic we will loop through the list and find
-     *      2 pictures with maximum i4_pic_cnt .
+     *      Hence to find the ref pics we will loop through the list and sort
+     *      the pictures marked for reference in decreasing order of
+     *      i4_pic_cnt.
      *
      *      note that i4_pic_cnt == -1 is used to filter uninit ref pics.
-     *      Now since we only have max two ref pics, we will always find max 2
-     *      ref pics.
-
+     *      Only the latest max_num_ref_frames pics (sliding window) are retained
+     *      for reference. An IDR pic releases all of them. A P pic uses all
+     *      retained pics as its L0 list, a B pic uses the latest two pics
+     *      as its L0 and L1 references.
      *
      *  2) 3) Self explanatory
      ***************************************************************************/
     {
-        /* Search for buffs with maximum pic cnt */
+        /* ref pics sorted in decreasing order of pic cnt */
+        ref_set_t *aps_sorted_ref[MAX_DPB_SIZE + MAX_CTXT_SETS];
 
-        WORD32 max_pic_cnt[] = { -1, -1 };
+        /* number of pics marked for reference */
+        WORD32 i4_ref_cnt = 0;
 
-        mv_buf_t *ps_mv_buf_to_free[] = { NULL, NULL };
+        /* max number of reference frames signalled in sps */
+        WORD32 i4_max_num_ref_frames =
+                        (ps_codec->ps_sps_base + ps_codec->i4_sps_id)->u1_max_num_ref_frames;
 
         /* temp var */
-        WORD32 i, buf_status;
+        WORD32 i, j, buf_status;
 
         for (i = 0; i < ps_codec->i4_ref_buf_cnt; i++)
         {
@@ -1604,57 +1673,70 @@ IH264E_ERROR_T ih264e_pic_init(codec_t *ps_codec, inp_buf_t *ps_inp_buf)
             /* Ideally we should look for buffer status of MV BUFF also. But since
              * the correponding MV buffs also will be at the same state. It dosent
              * matter as of now. But the check will make the logic better */
-            if ((max_pic_cnt[0] < ps_codec->as_ref_set[i].i4_pic_cnt)
-                            && (buf_status & BUF_MGR_REF))
+            if (buf_status & BUF_MGR_REF)
             {
-                if (max_pic_cnt[1] < ps_codec->as_ref_set[i].i4_pic_cnt)
+                for (j = i4_ref_cnt; j > 0; j--)
                 {
-                    max_pic_cnt[0] = max_pic_cnt[1];
-                    aps_ref_pic[0] = aps_ref_pic[1];
-                    aps_mv_buf[0] = aps_mv_buf[1];
-
-                    ps_mv_buf_to_free[0] = ps_mv_buf_to_free[1];
+                    if (aps_sorted_ref[j - 1]->i4_pic_cnt > ps_codec->as_ref_set[i].i4_pic_cnt)
+                        break;
 
-                    max_pic_cnt[1] = ps_codec->as_ref_set[i].i4_pic_cnt;
-                    aps_ref_pic[1] = ps_codec->as_ref_set[i].ps_pic_buf;
-                    aps_mv_buf[1] = ps_codec->as_ref_set[i].ps_mv_buf;
-                    ps_mv_buf_to_free[1] = ps_codec->as_ref_set[i].ps_mv_buf;
-
-                }
-                else
-                {
-                    max_pic_cnt[0] = ps_codec->as_ref_set[i].i4_pic_cnt;
-                    aps_ref_pic[0] = ps_codec->as_ref_set[i].ps_pic_buf;
-                    aps_mv_buf[0] = ps_codec->as_ref_set[i].ps_mv_buf;
-                    ps_mv_buf_to_free[0] = ps_codec->as_ref_set[i].ps_mv_buf;
+                    aps_sorted_ref[j] = aps_sorted_ref[j - 1];
                 }
+                aps_sorted_ref[j] = &ps_codec->as_ref_set[i];
+                i4_ref_cnt++;
             }
         }
 
-        /*
-         * Now if the current picture is I or P, we discard the back ref pic and
-         * assign forward ref as backward ref
-         */
-        if (*pic_type != PIC_B)
+        /* an idr pic flushes the dpb */
+        if (*pic_type == PIC_IDR)
         {
-            if (ps_mv_buf_to_free[0])
-            {
-                /* release this frame from reference list */
-                ih264_buf_mgr_release(ps_codec->pv_mv_buf_mgr,
-                                      ps_mv_buf_to_free[0]->i4_buf_id,
-                                      BUF_MGR_REF);
+            i4_max_num_ref_frames = 0;
+        }
 
-                ih264_buf_mgr_release(ps_codec->pv_ref_buf_mgr,
-                                      aps_ref_pic[0]->i4_buf_id, BUF_MGR_REF);
-            }
+        /* release the pics that have slid out of the reference window */
+        for (i = i4_max_num_ref_frames; i < i4_ref_cnt; i++)
+        {
+            ih264_buf_mgr_release(ps_codec->pv_mv_buf_mgr,
+                                  aps_sorted_ref[i]->ps_mv_buf->i4_buf_id,
+                                  BUF_MGR_REF);
 
-            max_pic_cnt[0] = max_pic_cnt[1];
-            aps_ref_pic[0] = aps_ref_pic[1];
-            aps_mv_buf[0] = aps_mv_buf[1];
+            ih264_buf_mgr_release(ps_codec->pv_ref_buf_mgr,
+                                  aps_sorted_ref[i]->ps_pic_buf->i4_buf_id,
+                                  BUF_MGR_REF);
+        }
+        i4_ref_cnt = MIN(i4_ref_cnt, i4_max_num_ref_frames);
 
-            /* Dummy */
-            max_pic_cnt[1] = -1;
+        if (*pic_type == PIC_B)
+        {
+            /* back ref is the latest but one pic, forward ref is the latest */
+            if (i4_ref_cnt > 1)
+            {
+                aps_ref_pic[PRED_L0] = aps_sorted_ref[1]->ps_pic_buf;
+                aps_mv_buf[PRED_L0] = aps_sorted_ref[1]->ps_mv_buf;
+            }
+            if (i4_ref_cnt > 0)
+            {
+                aps_ref_pic[PRED_L1] = aps_sorted_ref[0]->ps_pic_buf;
+                aps_mv_buf[PRED_L1] = aps_sorted_ref[0]->ps_mv_buf;
+            }
+            i4_num_ref_l0 = 1;
+        }
+        else
+        {
+            /* L0 list of a P pic, latest pic first */
+            for (i = 0; i < i4_ref_cnt; i++)
+            {
+                aps_ref_l0_pic[i] = aps_sorted_ref[i]->ps_pic_buf;
+            }
+            i4_num_ref_l0 = CLIP3(1, (WORD32)ps_codec->u4_max_num_ref_l0_active, i4_ref_cnt);
+
+            if (i4_ref_cnt > 0)
+            {
+                aps_ref_pic[PRED_L0] = aps_ref_pic[PRED_L1] = aps_sorted_ref[0]->ps_pic_buf;
+                aps_mv_buf[PRED_L0] = aps_mv_buf[PRED_L1] = aps_sorted_ref[0]->ps_mv_buf;
+            }
         }
+        aps_ref_l0_pic[0] = aps_ref_pic[PRED_L0];
 
         /*
          * Mark all reference pic with unused buffers to be free
@@ -1717,6 +1799,13 @@ IH264E_ERROR_T ih264e_pic_init(codec_t *ps_codec, inp_buf_t *ps_inp_buf)
          */
         ps_mv_buf->i4_abs_poc = ps_codec->i4_abs_pic_order_cnt;
         ps_mv_buf->i4_buf_id = cur_mv_bank_buf_id;
+
+        /* build the downsampled luma planes of the current picture */
+        ps_mv_buf->i4_pyr_valid = 0;
+        if (ps_codec->s_cfg.u4_pre_enc_me)
+        {
+            ih264e_build_me_pyramid(ps_codec, ps_inp_buf, ps_mv_buf);
+        }
     }
 
     {
@@ -1967,22 +2056,64 @@ IH264E_ERROR_T ih264e_pic_init(codec_t *ps_codec, inp_buf_t *ps_inp_buf)
                 /*
                  * Else is dummy since for non B pic we does not need this
                  * But an assignment here will help in not having a segfault
-                 * when we calcualte colpic in P slices
+                 * when we calcualte colpic in P slices. The L0 mv bank of a
+                 * P pic is that of its first reference, it seeds the
+                 * temporal search candidates
                  */
-                ps_proc->aps_mv_buf[PRED_L0] = ps_mv_buf;
+                ps_proc->aps_mv_buf[PRED_L0] = aps_mv_buf[PRED_L0] ?
+                                aps_mv_buf[PRED_L0] : ps_mv_buf;
                 ps_proc->aps_mv_buf[PRED_L1] = ps_mv_buf;
             }
 
+            /* downsampled planes for pre-enc ME */
+            {
+                WORD32 k, l;
+
+                for (k = 0; k < MAX_NUM_REFLIST; k++)
+                {
+                    mv_buf_t *ps_ref_mv_buf = aps_mv_buf[k];
+                    WORD32 i4_pyr_avbl = ps_mv_buf->i4_pyr_valid
+                                    && (ps_codec->i4_slice_type != ISLICE)
+                                    && (ps_ref_mv_buf != NULL)
+                                    && ps_ref_mv_buf->i4_pyr_valid;
+
+                    for (l = 0; l < PYR_LEVELS_CNT; l++)
+                    {
+                        ps_proc->apu1_pyr_ref_luma[k][l] = i4_pyr_avbl ?
+                                        ps_ref_mv_buf->apu1_pyr_luma[l] : NULL;
+                    }
+                }
+
+                for (l = 0; l < PYR_LEVELS_CNT; l++)
+                {
+                    ps_proc->apu1_pyr_src_luma[l] = ps_mv_buf->apu1_pyr_luma[l];
+                }
+            }
+
             if ((*pic_type != PIC_IDR) && (*pic_type != PIC_I))
             {
+                WORD32 k;
+
                 /* temporal back an forward  ref pointer luma and chroma */
                 ps_proc->apu1_ref_buf_luma_base[PRED_L0] = aps_ref_pic[PRED_L0]->pu1_luma;
                 ps_proc->apu1_ref_buf_chroma_base[PRED_L0] = aps_ref_pic[PRED_L0]->pu1_chroma;
 
                 ps_proc->apu1_ref_buf_luma_base[PRED_L1] = aps_ref_pic[PRED_L1]->pu1_luma;
                 ps_proc->apu1_ref_buf_chroma_base[PRED_L1] = aps_ref_pic[PRED_L1]->pu1_chroma;
+
+                /* L0 list */
+                for (k = 0; k < i4_num_ref_l0; k++)
+                {
+                    ps_proc->apu1_ref_l0_luma_base[k] = aps_ref_l0_pic[k]->pu1_luma;
+                    ps_proc->apu1_ref_l0_chroma_base[k] = aps_ref_l0_pic[k]->pu1_chroma;
+                    ps_proc->ai4_ref_l0_poc_dist[k] = ps_codec->i4_poc
+                                    - aps_ref_l0_pic[k]->i4_abs_poc;
+                }
             }
 
+            /* number of active L0 refs */
+            ps_proc->i4_num_ref_idx_l0_active = i4_num_ref_l0;
+
             /* Structure for current input buffer */
             ps_proc->s_inp_buf = *ps_inp_buf;
 
@@ -2031,6 +2162,9 @@ IH264E_ERROR_T ih264e_pic_init(codec_t *ps_codec, inp_buf_t *ps_inp_buf)
                 /* Abs poc */
                 ps_entropy->i4_abs_pic_order_cnt = ps_proc->ps_codec->i4_poc;
 
+                /* number of active L0 refs */
+                ps_entropy->i4_num_ref_idx_l0_active = ps_proc->i4_num_ref_idx_l0_active;
+
                 /* initialize entropy map */
                 if (i == j)
                 {
@@ -2123,6 +2257,10 @@ IH264E_ERROR_T ih264e_pic_init(codec_t *ps_codec, inp_buf_t *ps_inp_buf)
                 /* half pel */
                 ps_me_ctxt->u4_enable_hpel = ps_codec->s_cfg.u4_enable_hpel;
 
+                /* quarter pel, refines the half pel mv */
+                ps_me_ctxt->u4_enable_qpel = ps_codec->s_cfg.u4_enable_hpel
+                                && ps_codec->s_cfg.u4_enable_qpel;
+
                 /* Diamond search Iteration Max Cnt */
                 ps_me_ctxt->u4_num_layers = u4_num_layers;
 
@@ -246,6 +246,314 @@ void ime_diamond_search_16x16(me_ctxt_t *ps_me_ctxt, WORD32 i4_reflist)
 }
 
 
+/**
+*******************************************************************************
+*
+* @brief Hexagon Search
+*
+* @par Description:
+*  This function first evaluates a small diamond about the initial mv and
+*  terminates if its center is the best point, so that static mbs cost no more
+*  than a diamond search. Otherwise it computes the sad at the six vertices of
+*  a hexagon of radius 2 centered at the current best mv. If a vertex has
+*  lesser cost than the center, the hexagon is moved to it and only the three
+*  vertices not shared with the previous hexagon are evaluated. Once the center
+*  is the best point (or the layers are exhausted), the mv is refined with a
+*  small diamond search.
+*
+* @param[in] ps_me_ctxt
+*  pointer to me context
+*
+* @param[in] i4_reflist
+*  reference list being searched
+*
+* @returns  mv pair & corresponding distortion and cost
+*
+* @remarks Hexagon vertices are visited clockwise starting from the left
+*
+*******************************************************************************
+*/
+void ime_hexagon_search_16x16(me_ctxt_t *ps_me_ctxt, WORD32 i4_reflist)
+{
+    /* hexagon vertices, moving to vertex i leaves i-1, i, i+1 unevaluated */
+    static const WORD8 ai1_hex_x[6] = { -2, -1, 1, 2, 1, -1 };
+    static const WORD8 ai1_hex_y[6] = { 0, -2, -2, 0, 2, 2 };
+
+    /* small diamond vertices in the order of pf_ime_compute_sad4_diamond */
+    static const WORD8 ai1_dia_x[4] = { -1, 1, 0, 0 };
+    static const WORD8 ai1_dia_y[4] = { 0, 0, -1, 1 };
+
+    /* MB partition info */
+    mb_part_ctxt *ps_mb_part = &ps_me_ctxt->as_mb_part[i4_reflist];
+
+    /* lagrange parameter */
+    UWORD32 u4_lambda_motion = ps_me_ctxt->u4_lambda_motion;
+
+    /* srch range*/
+    WORD32 i4_srch_range_n = ps_me_ctxt->i4_srch_range_n;
+    WORD32 i4_srch_range_s = ps_me_ctxt->i4_srch_range_s;
+    WORD32 i4_srch_range_e = ps_me_ctxt->i4_srch_range_e;
+    WORD32 i4_srch_range_w = ps_me_ctxt->i4_srch_range_w;
+
+    /* enabled fast sad computation */
+    UWORD32 u4_enable_fast_sad = ps_me_ctxt->u4_enable_fast_sad;
+
+    /* pointer to src macro block */
+    UWORD8 *pu1_curr_mb = ps_me_ctxt->pu1_src_buf_luma;
+    UWORD8 *pu1_ref_mb = ps_me_ctxt->apu1_ref_buf_luma[i4_reflist];
+
+    /* strides */
+    WORD32 i4_src_strd = ps_me_ctxt->i4_src_strd;
+    WORD32 i4_ref_strd = ps_me_ctxt->i4_rec_strd;
+
+    /* least cost */
+    WORD32 i4_cost_least = ps_mb_part->i4_mb_cost;
+
+    /* least sad */
+    WORD32 i4_distortion_least = ps_mb_part->i4_mb_distortion;
+
+    /* mv bits */
+    UWORD8 *pu1_mv_bits = ps_me_ctxt->pu1_mv_bits;
+
+    /* Hexagon search Iteration Max Cnt */
+    UWORD32 u4_num_layers = ps_me_ctxt->u4_num_layers;
+
+    /* mv pair */
+    WORD16 i2_mvx, i2_mvy;
+
+    /* temp var */
+    WORD32 i, i4_start, i4_cnt, i4_best;
+    WORD32 i4_sad, i4_cost;
+    WORD32 ai4_sad[4];
+    WORD16 i2_mv_u_x, i2_mv_u_y;
+    UWORD8 *pu1_ref;
+
+    /* mv with best sad during initial evaluation */
+    i2_mvx = ps_mb_part->s_mv_curr.i2_mvx;
+    i2_mvy = ps_mb_part->s_mv_curr.i2_mvy;
+
+    if ( (i2_mvx - 1 >= i4_srch_range_w) &&
+                    (i2_mvx + 1 <= i4_srch_range_e) &&
+                    (i2_mvy - 1 >= i4_srch_range_n) &&
+                    (i2_mvy + 1 <= i4_srch_range_s) )
+    {
+        pu1_ref = pu1_ref_mb + i2_mvx + (i2_mvy * i4_ref_strd);
+
+        ps_me_ctxt->pf_ime_compute_sad4_diamond(pu1_ref,
+                                                pu1_curr_mb,
+                                                i4_ref_strd,
+                                                i4_src_strd,
+                                                ai4_sad);
+
+        i4_best = -1;
+
+        for (i = 0; i < 4; i++)
+        {
+            DEBUG_SAD_HISTOGRAM_ADD(ai4_sad[i], 2);
+
+            i2_mv_u_x = i2_mvx + ai1_dia_x[i];
+            i2_mv_u_y = i2_mvy + ai1_dia_y[i];
+
+            /* compute cost */
+            i4_cost = ai4_sad[i] + u4_lambda_motion * ( pu1_mv_bits[ (i2_mv_u_x << 2) - ps_mb_part->s_mv_pred.i2_mvx]
+                                                        + pu1_mv_bits[(i2_mv_u_y << 2) - ps_mb_part->s_mv_pred.i2_mvy] );
+
+            if (i4_cost_least > i4_cost)
+            {
+                i4_cost_least = i4_cost;
+                i4_distortion_least = ai4_sad[i];
+                i4_best = i;
+            }
+        }
+
+        /* early exit for mbs that do not move */
+        if (i4_best < 0)
+        {
+            ps_mb_part->u4_exit = 1;
+            return;
+        }
+
+        i2_mvx += ai1_dia_x[i4_best];
+        i2_mvy += ai1_dia_y[i4_best];
+    }
+
+    /* first hexagon evaluates all six vertices */
+    i4_start = 0;
+    i4_cnt = 6;
+
+    while (u4_num_layers--)
+    {
+        i4_best = -1;
+
+        for (i = i4_start; i < i4_start + i4_cnt; i++)
+        {
+            WORD32 i4_idx = (i + 6) % 6;
+
+            i2_mv_u_x = i2_mvx + ai1_hex_x[i4_idx];
+            i2_mv_u_y = i2_mvy + ai1_hex_y[i4_idx];
+
+            if ( (i2_mv_u_x < i4_srch_range_w) ||
+                            (i2_mv_u_x > i4_srch_range_e) ||
+                            (i2_mv_u_y < i4_srch_range_n) ||
+                            (i2_mv_u_y > i4_srch_range_s) )
+            {
+                continue;
+            }
+
+            pu1_ref = pu1_ref_mb + i2_mv_u_x + (i2_mv_u_y * i4_ref_strd);
+
+            ps_me_ctxt->pf_ime_compute_sad_16x16[u4_enable_fast_sad](pu1_curr_mb, pu1_ref, i4_src_strd, i4_ref_strd, i4_cost_least, &i4_sad);
+
+            DEBUG_SAD_HISTOGRAM_ADD(i4_sad, 2);
+
+            /* compute cost */
+            i4_cost = i4_sad + u4_lambda_motion * ( pu1_mv_bits[ (i2_mv_u_x << 2) - ps_mb_part->s_mv_pred.i2_mvx]
+                                                    + pu1_mv_bits[(i2_mv_u_y << 2) - ps_mb_part->s_mv_pred.i2_mvy] );
+
+            if (i4_cost_least > i4_cost)
+            {
+                i4_cost_least = i4_cost;
+                i4_distortion_least = i4_sad;
+                i4_best = i4_idx;
+            }
+        }
+
+        if (i4_best < 0)
+        {
+            break;
+        }
+
+        i2_mvx += ai1_hex_x[i4_best];
+        i2_mvy += ai1_hex_y[i4_best];
+
+        /* only three vertices of the moved hexagon are new */
+        i4_start = i4_best - 1;
+        i4_cnt = 3;
+    }
+
+    if (i4_cost_least < ps_mb_part->i4_mb_cost)
+    {
+        ps_mb_part->i4_mb_cost = i4_cost_least;
+        ps_mb_part->i4_mb_distortion = i4_distortion_least;
+        ps_mb_part->s_mv_curr.i2_mvx = i2_mvx;
+        ps_mb_part->s_mv_curr.i2_mvy = i2_mvy;
+    }
+
+    /* refine about the hexagon center with a small diamond */
+    ime_diamond_search_16x16(ps_me_ctxt, i4_reflist);
+}
+
+
+/**
+*******************************************************************************
+*
+* @brief Full Search
+*
+* @par Description:
+*  This function computes the cost at every full pel position of the search
+*  window. Each row of the window is evaluated eight horizontally adjacent
+*  positions at a time so that the sad kernel loads every reference row once
+*  for all of them.
+*
+* @param[in] ps_me_ctxt
+*  pointer to me context
+*
+* @param[in] i4_reflist
+*  reference list being searched
+*
+* @returns  mv pair & corresponding distortion and cost
+*
+* @remarks The last call of a row may evaluate positions past the east edge
+* of the window, their sads are ignored
+*
+*******************************************************************************
+*/
+void ime_full_search_16x16(me_ctxt_t *ps_me_ctxt, WORD32 i4_reflist)
+{
+    /* MB partition info */
+    mb_part_ctxt *ps_mb_part = &ps_me_ctxt->as_mb_part[i4_reflist];
+
+    /* lagrange parameter */
+    UWORD32 u4_lambda_motion = ps_me_ctxt->u4_lambda_motion;
+
+    /* srch range*/
+    WORD32 i4_srch_range_n = ps_me_ctxt->i4_srch_range_n;
+    WORD32 i4_srch_range_s = ps_me_ctxt->i4_srch_range_s;
+    WORD32 i4_srch_range_e = ps_me_ctxt->i4_srch_range_e;
+    WORD32 i4_srch_range_w = ps_me_ctxt->i4_srch_range_w;
+
+    /* pointer to src macro block */
+    UWORD8 *pu1_curr_mb = ps_me_ctxt->pu1_src_buf_luma;
+    UWORD8 *pu1_ref_mb = ps_me_ctxt->apu1_ref_buf_luma[i4_reflist];
+
+    /* strides */
+    WORD32 i4_src_strd = ps_me_ctxt->i4_src_strd;
+    WORD32 i4_ref_strd = ps_me_ctxt->i4_rec_strd;
+
+    /* least cost */
+    WORD32 i4_cost_least = ps_mb_part->i4_mb_cost;
+
+    /* least sad */
+    WORD32 i4_distortion_least = ps_mb_part->i4_mb_distortion;
+
+    /* mv bits */
+    UWORD8 *pu1_mv_bits = ps_me_ctxt->pu1_mv_bits;
+
+    /* mv pair */
+    WORD16 i2_mvx = ps_mb_part->s_mv_curr.i2_mvx;
+    WORD16 i2_mvy = ps_mb_part->s_mv_curr.i2_mvy;
+
+    /* temp var */
+    WORD32 i4_x, i4_y, i, i4_num_pos;
+    WORD32 i4_mv_bits_y, i4_cost;
+    WORD32 ai4_sad[8];
+    UWORD8 *pu1_ref;
+
+    for (i4_y = i4_srch_range_n; i4_y <= i4_srch_range_s; i4_y++)
+    {
+        /* rate of the vertical component is common to the row */
+        i4_mv_bits_y = pu1_mv_bits[(i4_y << 2) - ps_mb_part->s_mv_pred.i2_mvy];
+
+        for (i4_x = i4_srch_range_w; i4_x <= i4_srch_range_e; i4_x += 8)
+        {
+            pu1_ref = pu1_ref_mb + i4_x + (i4_y * i4_ref_strd);
+
+            ps_me_ctxt->pf_ime_compute_sad8_horz(pu1_curr_mb, pu1_ref,
+                                                 i4_src_strd, i4_ref_strd,
+                                                 ai4_sad);
+
+            i4_num_pos = MIN(8, i4_srch_range_e - i4_x + 1);
+
+            for (i = 0; i < i4_num_pos; i++)
+            {
+                DEBUG_SAD_HISTOGRAM_ADD(ai4_sad[i], 2);
+
+                /* compute cost */
+                i4_cost = ai4_sad[i] + u4_lambda_motion * ( pu1_mv_bits[((i4_x + i) << 2) - ps_mb_part->s_mv_pred.i2_mvx]
+                                                            + i4_mv_bits_y );
+
+                if (i4_cost_least > i4_cost)
+                {
+                    i4_cost_least = i4_cost;
+                    i4_distortion_least = ai4_sad[i];
+
+                    i2_mvx = i4_x + i;
+                    i2_mvy = i4_y;
+                }
+            }
+        }
+    }
+
+    if (i4_cost_least < ps_mb_part->i4_mb_cost)
+    {
+        ps_mb_part->i4_mb_cost = i4_cost_least;
+        ps_mb_part->i4_mb_distortion = i4_distortion_least;
+        ps_mb_part->s_mv_curr.i2_mvx = i2_mvx;
+        ps_mb_part->s_mv_curr.i2_mvy = i2_mvy;
+    }
+}
+
+
 /**
 *******************************************************************************
 *
@@ -422,6 +730,12 @@ void ime_full_pel_motion_estimation_16x16
         case DMND_SRCH:
             ime_diamond_search_16x16(ps_me_ctxt, i4_ref_list);
             break;
+        case HEX_SRCH:
+            ime_hexagon_search_16x16(ps_me_ctxt, i4_ref_list);
+            break;
+        case FULL_SRCH:
+            ime_full_search_16x16(ps_me_ctxt, i4_ref_list);
+            break;
         default:
             assert(0);
             break;
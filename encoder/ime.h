@@ -100,6 +100,54 @@
  */
 extern void ime_diamond_search_16x16(me_ctxt_t *ps_me_ctxt, WORD32 i4_reflist);
 
+/**
+*******************************************************************************
+*
+* @brief Hexagon Search
+*
+* @par Description:
+*  This function computes the sad at the six vertices of a hexagon of radius 2
+*  centered at the current best mv and moves the hexagon towards the least
+*  cost vertex until the center is the best point. The result is refined with
+*  a small diamond search.
+*
+* @param[in] ps_me_ctxt
+*  pointer to me context
+*
+* @param[in] i4_reflist
+*  reference list being searched
+*
+* @returns  mv pair & corresponding distortion and cost
+*
+* @remarks none
+*
+*******************************************************************************
+ */
+extern void ime_hexagon_search_16x16(me_ctxt_t *ps_me_ctxt, WORD32 i4_reflist);
+
+/**
+*******************************************************************************
+*
+* @brief Full Search
+*
+* @par Description:
+*  This function computes the cost at every full pel position of the search
+*  window, eight horizontally adjacent positions at a time.
+*
+* @param[in] ps_me_ctxt
+*  pointer to me context
+*
+* @param[in] i4_reflist
+*  reference list being searched
+*
+* @returns  mv pair & corresponding distortion and cost
+*
+* @remarks none
+*
+*******************************************************************************
+ */
+extern void ime_full_search_16x16(me_ctxt_t *ps_me_ctxt, WORD32 i4_reflist);
+
 
 /**
 *******************************************************************************
@@ -56,6 +56,9 @@
 #define HEX_SRCH 75
 
 #define MAX_NUM_REFLIST 2
+
+/* Max number of candidates evaluated for the initial search position */
+#define MAX_NUM_INIT_SRCH_CANDS 10
 #define SUBPEL_BUFF_CNT 4
 
 #endif /*_IME_DEFS_H_*/
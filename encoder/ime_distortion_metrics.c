@@ -34,6 +34,7 @@
 *  - ime_calculate_sad4_prog()
 *  - ime_calculate_sad3_prog()
 *  - ime_calculate_sad2_prog()
+*  - ime_calculate_sad8_horz()
 *  - ime_compute_sad_16x16()
 *  - ime_compute_sad_16x16_fast()
 *  - ime_compute_sad_16x16_ea8()
@@ -421,6 +422,63 @@ void ime_calculate_sad2_prog(UWORD8 *pu1_ref1,
 
 }
 
+/**
+*******************************************************************************
+*
+* @brief compute sad
+*
+* @par Description: This function computes the sad of a 16x16 source block at
+* eight horizontally adjacent positions starting at the reference pointer.
+*
+* @param[in] pu1_src
+*  UWORD8 pointer to the source
+*
+* @param[in] pu1_ref
+*  UWORD8 pointer to the left most reference position
+*
+* @param[in] src_strd
+*  integer source stride
+*
+* @param[in] ref_strd
+*  integer reference stride
+*
+* @param[out] pi4_sad
+*  pointer to integer array evaluated sad, one per position
+*
+* @returns  sad at all evaluated positions
+*
+* @remarks  reads 23 bytes of every reference row
+*
+*******************************************************************************
+*/
+void ime_calculate_sad8_horz(UWORD8 *pu1_src,
+                             UWORD8 *pu1_ref,
+                             WORD32 src_strd,
+                             WORD32 ref_strd,
+                             WORD32 *pi4_sad)
+{
+    /* temp var */
+    WORD32 i, j, k;
+
+    memset(pi4_sad, 0, 8 * sizeof(WORD32));
+
+    for(i = 0; i < MB_SIZE; i++)
+    {
+        for(j = 0; j < MB_SIZE; j++)
+        {
+            WORD32 src = pu1_src[j];
+
+            for(k = 0; k < 8; k++)
+            {
+                pi4_sad[k] += ABS(src - pu1_ref[j + k]);
+            }
+        }
+
+        pu1_src += src_strd;
+        pu1_ref += ref_strd;
+    }
+}
+
 /**
 ******************************************************************************
 *
@@ -71,6 +71,12 @@ typedef void ime_compute_sad2_diamond(UWORD8 *pu1_ref1,
                                       WORD32 src_strd,
                                       WORD32 *pi4_sad);
 
+typedef void ime_compute_sad8_horz_ft(UWORD8 *pu1_src,
+                                     UWORD8 *pu1_ref,
+                                     WORD32 src_strd,
+                                     WORD32 ref_strd,
+                                     WORD32 *pi4_sad);
+
 typedef void ime_sub_pel_compute_sad_16x16_ft(UWORD8 *pu1_src,
                                               UWORD8 *pu1_ref_half_x,
                                               UWORD8 *pu1_ref_half_y,
@@ -124,6 +130,7 @@ ime_compute_sad_ft ime_compute_sad_4x4;
 ime_compute_sad4_diamond ime_calculate_sad4_prog;
 ime_compute_sad3_diamond ime_calculate_sad3_prog;
 ime_compute_sad2_diamond ime_calculate_sad2_prog;
+ime_compute_sad8_horz_ft ime_calculate_sad8_horz;
 ime_sub_pel_compute_sad_16x16_ft ime_sub_pel_compute_sad_16x16;
 ime_compute_sad_stat ime_compute_16x16_sad_stat;
 ime_compute_satqd_16x16_lumainter_ft ime_compute_satqd_16x16_lumainter;
@@ -138,8 +145,18 @@ ime_compute_sad_ft ime_compute_sad_16x8_sse42;
 ime_compute_sad_ft ime_compute_sad_16x16_ea8_sse42;
 ime_sub_pel_compute_sad_16x16_ft ime_sub_pel_compute_sad_16x16_sse42;
 ime_compute_sad4_diamond ime_calculate_sad4_prog_sse42;
+ime_compute_sad8_horz_ft ime_calculate_sad8_horz_sse42;
 ime_compute_satqd_16x16_lumainter_ft ime_compute_satqd_16x16_lumainter_sse42;
 
+/*AVX2 Declarations*/
+ime_compute_sad8_horz_ft ime_calculate_sad8_horz_avx2;
+
+/*AVX-512BW Declarations*/
+ime_compute_sad_ft ime_compute_sad_16x16_avx512;
+ime_sub_pel_compute_sad_16x16_ft ime_sub_pel_compute_sad_16x16_avx512;
+ime_compute_sad4_diamond ime_calculate_sad4_prog_avx512;
+ime_compute_sad3_diamond ime_calculate_sad3_prog_avx512;
+
 /* assembly */
 ime_compute_sad_ft ime_compute_sad_16x16_a9q;
 ime_compute_sad_ft ime_compute_sad_16x16_fast_a9q;
@@ -196,7 +196,7 @@ typedef struct
      * Motion vector predictors derived from neighboring
      * blocks for each of the six block partitions
      */
-    ime_mv_t as_mv_init_search[MAX_NUM_REFLIST + 1][6];
+    ime_mv_t as_mv_init_search[MAX_NUM_REFLIST + 1][MAX_NUM_INIT_SRCH_CANDS];
 
     /**
      * mv bits
@@ -233,6 +233,11 @@ typedef struct
      */
     UWORD32 u4_enable_hpel;
 
+    /**
+     * Flag to enable/disbale quarter pel motion estimation
+     */
+    UWORD32 u4_enable_qpel;
+
     /**
      * Diamond search Iteration Max Cnt
      */
@@ -268,9 +273,11 @@ typedef struct
      */
     ime_compute_sad_ft *pf_ime_compute_sad_16x16[2];
     ime_compute_sad_ft *pf_ime_compute_sad_16x8;
+    ime_compute_sad_ft *pf_ime_compute_sad_8x8;
     ime_compute_sad4_diamond *pf_ime_compute_sad4_diamond;
     ime_compute_sad3_diamond *pf_ime_compute_sad3_diamond;
     ime_compute_sad2_diamond *pf_ime_compute_sad2_diamond;
+    ime_compute_sad8_horz_ft *pf_ime_compute_sad8_horz;
     ime_sub_pel_compute_sad_16x16_ft *pf_ime_sub_pel_compute_sad_16x16;
 
     /*
@@ -1017,6 +1017,117 @@ void irc_get_pic_from_stack(pic_handling_t *ps_pic_handling,
     *pe_pic_type = s_pic_details.e_pic_type;
 }
 
+/*******************************************************************************
+ * @brief Returns the pics of the sub gop starting at the pic to be encoded next,
+ *        in encode order: the reference pic followed by the B_PICs preceding
+ *        it in display order. Returns the number of pics, 0 if the next pic is
+ *        not a reference pic
+ ******************************************************************************/
+WORD32 irc_get_subgop_from_stack(pic_handling_t *ps_pic_handling,
+                                 WORD32 *pi4_pic_id,
+                                 picture_type_e *pe_pic_type)
+{
+    WORD32 i4_stack_size = ps_pic_handling->i4_max_inter_frm_int + 1;
+    WORD32 i4_stack_count = ps_pic_handling->i4_stack_count;
+    WORD32 i4_num_pics, i;
+    pic_details_t *ps_pic_details;
+
+    if(i4_stack_count < 0)
+    {
+        return (0);
+    }
+
+    ps_pic_details = &ps_pic_handling->as_pic_stack[i4_stack_count];
+
+    if((ps_pic_details->e_pic_type != I_PIC)
+                    && (ps_pic_details->e_pic_type != P_PIC))
+    {
+        return (0);
+    }
+
+    pi4_pic_id[0] = ps_pic_details->i4_pic_id;
+    pe_pic_type[0] = ps_pic_details->e_pic_type;
+    i4_num_pics = 1;
+
+    /*
+     * The B_PICs follow in display order. Stale entries of an earlier sub gop
+     * end the run as their ids are not in increasing order
+     */
+    for(i = 1; i < i4_stack_size; i++)
+    {
+        ps_pic_details = &ps_pic_handling->as_pic_stack[(i4_stack_count + i)
+                        % i4_stack_size];
+
+        if((ps_pic_details->e_pic_type != B_PIC)
+                        || (ps_pic_details->i4_pic_id >= pi4_pic_id[0]))
+        {
+            break;
+        }
+
+        if((i4_num_pics > 1)
+                        && (ps_pic_details->i4_pic_id
+                                        <= pi4_pic_id[i4_num_pics - 1]))
+        {
+            break;
+        }
+
+        pi4_pic_id[i4_num_pics] = ps_pic_details->i4_pic_id;
+        pe_pic_type[i4_num_pics] = B_PIC;
+        i4_num_pics++;
+    }
+
+    return (i4_num_pics);
+}
+
+/*******************************************************************************
+ * @brief Reorders and retypes the pics of the sub gop starting at the pic to be
+ *        encoded next. pi4_pic_id has to be a permutation of the ids returned
+ *        by irc_get_subgop_from_stack(). The remaining frms in the gop are
+ *        updated so that the gop still ends after the same number of pics
+ ******************************************************************************/
+void irc_set_subgop_in_stack(pic_handling_t *ps_pic_handling,
+                             WORD32 i4_num_pics,
+                             WORD32 *pi4_pic_id,
+                             picture_type_e *pe_pic_type)
+{
+    WORD32 i4_stack_size = ps_pic_handling->i4_max_inter_frm_int + 1;
+    WORD32 i4_stack_count = ps_pic_handling->i4_stack_count;
+    pic_details_t as_pic_details[MAX_INTER_FRM_INT + 2];
+    WORD32 i, j;
+
+    for(i = 0; i < i4_num_pics; i++)
+    {
+        memcpy(&as_pic_details[i],
+               &ps_pic_handling->as_pic_stack[(i4_stack_count + i)
+                               % i4_stack_size],
+               sizeof(pic_details_t));
+    }
+
+    for(i = 0; i < i4_num_pics; i++)
+    {
+        pic_details_t *ps_pic_details = &ps_pic_handling->as_pic_stack[
+                        (i4_stack_count + i) % i4_stack_size];
+
+        for(j = 0; j < i4_num_pics; j++)
+        {
+            if(as_pic_details[j].i4_pic_id == pi4_pic_id[i])
+            {
+                break;
+            }
+        }
+
+        memcpy(ps_pic_details, &as_pic_details[j], sizeof(pic_details_t));
+
+        if((ps_pic_details->e_pic_type != pe_pic_type[i])
+                        && (ps_pic_handling->i4_rem_frms_in_gop[ps_pic_details->e_pic_type] > 0))
+        {
+            ps_pic_handling->i4_rem_frms_in_gop[ps_pic_details->e_pic_type]--;
+            ps_pic_handling->i4_rem_frms_in_gop[pe_pic_type[i]]++;
+        }
+        ps_pic_details->e_pic_type = pe_pic_type[i];
+    }
+}
+
 /*******************************************************************************
  * @brief Updates the picture handling state whenever there is changes in input
  *        parameter
@@ -50,6 +50,15 @@ void irc_get_pic_from_stack(pic_handling_handle ps_pic_handling,
                             WORD32 *pi4_pic_disp_order_no,
                             picture_type_e *pe_pic_type);
 
+WORD32 irc_get_subgop_from_stack(pic_handling_handle ps_pic_handling,
+                                 WORD32 *pi4_pic_id,
+                                 picture_type_e *pe_pic_type);
+
+void irc_set_subgop_in_stack(pic_handling_handle ps_pic_handling,
+                             WORD32 i4_num_pics,
+                             WORD32 *pi4_pic_id,
+                             picture_type_e *pe_pic_type);
+
 WORD32 irc_is_last_frame_in_gop(pic_handling_handle ps_pic_handling);
 
 void irc_flush_frame_from_pic_stack(pic_handling_handle ps_pic_handling);
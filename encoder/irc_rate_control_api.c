@@ -348,6 +348,31 @@ void irc_get_picture_details(rate_control_handle rate_control_api,
                            pi4_pic_disp_order_no, pe_pic_type);
 }
 
+/*******************************************************************************
+ Description   : Gets the pics of the sub gop starting at the pic to be
+                 encoded next, in encode order
+ ******************************************************************************/
+WORD32 irc_get_subgop_details(rate_control_handle rate_control_api,
+                              WORD32 *pi4_pic_id,
+                              picture_type_e *pe_pic_type)
+{
+    return (irc_get_subgop_from_stack(rate_control_api->ps_pic_handling,
+                                      pi4_pic_id, pe_pic_type));
+}
+
+/*******************************************************************************
+ Description   : Reorders and retypes the pics of the sub gop starting at the
+                 pic to be encoded next
+ ******************************************************************************/
+void irc_set_subgop_details(rate_control_handle rate_control_api,
+                            WORD32 i4_num_pics,
+                            WORD32 *pi4_pic_id,
+                            picture_type_e *pe_pic_type)
+{
+    irc_set_subgop_in_stack(rate_control_api->ps_pic_handling, i4_num_pics,
+                            pi4_pic_id, pe_pic_type);
+}
+
 /*******************************************************************************
  *  Description   : Gets the frame level qp for the given picture type
  ******************************************************************************/
@@ -72,6 +72,15 @@ void irc_get_picture_details(rate_control_handle rate_control_api,
                              WORD32 *pi4_pic_disp_order_no,
                              picture_type_e *pe_pic_type);
 
+WORD32 irc_get_subgop_details(rate_control_handle rate_control_api,
+                              WORD32 *pi4_pic_id,
+                              picture_type_e *pe_pic_type);
+
+void irc_set_subgop_details(rate_control_handle rate_control_api,
+                            WORD32 i4_num_pics,
+                            WORD32 *pi4_pic_id,
+                            picture_type_e *pe_pic_type);
+
 /* Gets the frame level Qp */
 UWORD8 irc_get_frame_level_qp(rate_control_handle rate_control_api,
                               picture_type_e pic_type,
@@ -174,7 +174,9 @@ typedef enum
     ARCH_X86_SSE42,
     ARCH_ARM_A53,
     ARCH_ARM_A57,
-    ARCH_ARM_V8_NEON
+    ARCH_ARM_V8_NEON,
+    ARCH_X86_AVX2,
+    ARCH_X86_AVX512
 }IV_ARCH_T;
 
 /** SOC Enumeration                               */
@@ -71,6 +71,7 @@
 #include "ih264_cabac_tables.h"
 #include "ih264_macros.h"
 #include "ih264_platform_macros.h"
+#include "ih264_cpu_features.h"
 #include "irc_cntrl_param.h"
 #include "irc_frame_info_collector.h"
 #include "ih264e_rate_control.h"
@@ -100,6 +101,27 @@
 void ih264e_init_function_ptr(void *pv_codec)
 {
     codec_t *ps_codec = (codec_t *)pv_codec;
+    IV_ARCH_T e_cpu_arch = ih264e_default_arch();
+
+    /* Requests beyond the capability of the processor, and non x86 requests */
+    /* are served by the best architecture the processor supports            */
+    switch(ps_codec->s_cfg.e_arch)
+    {
+        case ARCH_X86_GENERIC:
+            break;
+        case ARCH_X86_SSSE3:
+        case ARCH_X86_SSE42:
+        case ARCH_X86_AVX2:
+        case ARCH_X86_AVX512:
+            /* x86 architectures are enumerated in increasing capability */
+            if(ps_codec->s_cfg.e_arch > e_cpu_arch)
+                ps_codec->s_cfg.e_arch = e_cpu_arch;
+            break;
+        default:
+            ps_codec->s_cfg.e_arch = e_cpu_arch;
+            break;
+    }
+
     ih264e_init_function_ptr_generic(ps_codec);
     switch(ps_codec->s_cfg.e_arch)
     {
@@ -109,6 +131,17 @@ void ih264e_init_function_ptr(void *pv_codec)
         case ARCH_X86_SSSE3:
             ih264e_init_function_ptr_ssse3(ps_codec);
             break;
+        case ARCH_X86_AVX2:
+            ih264e_init_function_ptr_ssse3(ps_codec);
+            ih264e_init_function_ptr_sse42(ps_codec);
+            ih264e_init_function_ptr_avx2(ps_codec);
+            break;
+        case ARCH_X86_AVX512:
+            ih264e_init_function_ptr_ssse3(ps_codec);
+            ih264e_init_function_ptr_sse42(ps_codec);
+            ih264e_init_function_ptr_avx2(ps_codec);
+            ih264e_init_function_ptr_avx512(ps_codec);
+            break;
         case ARCH_X86_SSE42:
         default:
             ih264e_init_function_ptr_ssse3(ps_codec);
@@ -122,8 +155,8 @@ void ih264e_init_function_ptr(void *pv_codec)
 *
 * @brief Determine the architecture of the encoder executing environment
 *
-* @par Description: This routine returns the architecture of the enviro-
-* ment in which the current encoder is being tested
+* @par Description: This routine returns the best architecture supported by
+* the processor, as detected at run time
 *
 * @param[in] void
 *
@@ -136,7 +169,17 @@ void ih264e_init_function_ptr(void *pv_codec)
 */
 IV_ARCH_T ih264e_default_arch(void)
 {
-    return ARCH_X86_SSE42;
+    UWORD32 u4_features = ih264_get_cpu_features();
+
+    if(u4_features & IH264_CPU_AVX512BW)
+        return ARCH_X86_AVX512;
+    if(u4_features & IH264_CPU_AVX2)
+        return ARCH_X86_AVX2;
+    if(u4_features & IH264_CPU_SSE42)
+        return ARCH_X86_SSE42;
+    if(u4_features & IH264_CPU_SSSE3)
+        return ARCH_X86_SSSE3;
+    return ARCH_X86_GENERIC;
 }
 
 
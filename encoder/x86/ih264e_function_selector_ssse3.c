@@ -169,6 +169,23 @@ void ih264e_init_function_ptr_ssse3(codec_t *ps_codec)
     ps_codec->pf_inter_pred_luma_vert = ih264_inter_pred_luma_vert_ssse3;
     ps_codec->pf_inter_pred_chroma = ih264_inter_pred_chroma_ssse3;
 
+    ps_codec->apf_inter_pred_luma[0] = ih264_inter_pred_luma_copy_ssse3;
+    ps_codec->apf_inter_pred_luma[1] = ih264_inter_pred_luma_horz_qpel_ssse3;
+    ps_codec->apf_inter_pred_luma[2] = ih264_inter_pred_luma_horz_ssse3;
+    ps_codec->apf_inter_pred_luma[3] = ih264_inter_pred_luma_horz_qpel_ssse3;
+    ps_codec->apf_inter_pred_luma[4] = ih264_inter_pred_luma_vert_qpel_ssse3;
+    ps_codec->apf_inter_pred_luma[5] = ih264_inter_pred_luma_horz_qpel_vert_qpel_ssse3;
+    ps_codec->apf_inter_pred_luma[6] = ih264_inter_pred_luma_horz_hpel_vert_qpel_ssse3;
+    ps_codec->apf_inter_pred_luma[7] = ih264_inter_pred_luma_horz_qpel_vert_qpel_ssse3;
+    ps_codec->apf_inter_pred_luma[8] = ih264_inter_pred_luma_vert_ssse3;
+    ps_codec->apf_inter_pred_luma[9] = ih264_inter_pred_luma_horz_qpel_vert_hpel_ssse3;
+    ps_codec->apf_inter_pred_luma[10] = ih264_inter_pred_luma_horz_hpel_vert_hpel_ssse3;
+    ps_codec->apf_inter_pred_luma[11] = ih264_inter_pred_luma_horz_qpel_vert_hpel_ssse3;
+    ps_codec->apf_inter_pred_luma[12] = ih264_inter_pred_luma_vert_qpel_ssse3;
+    ps_codec->apf_inter_pred_luma[13] = ih264_inter_pred_luma_horz_qpel_vert_qpel_ssse3;
+    ps_codec->apf_inter_pred_luma[14] = ih264_inter_pred_luma_horz_hpel_vert_qpel_ssse3;
+    ps_codec->apf_inter_pred_luma[15] = ih264_inter_pred_luma_horz_qpel_vert_qpel_ssse3;
+
     /* memory handling operations */
     ps_codec->pf_mem_cpy_mul8 = ih264_memcpy_mul_8_ssse3;
     ps_codec->pf_mem_set_mul8 = ih264_memset_mul_8_ssse3;
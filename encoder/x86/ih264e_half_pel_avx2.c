@@ -0,0 +1,453 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+/**
+ *******************************************************************************
+ * @file
+ *  ih264e_half_pel_avx2.c
+ *
+ * @brief
+ *  Contains the x86 avx2 intrinsic function definitions for 6-tap horizontal
+ *  filter and cascaded 2D filter used in motion estimation in H264 encoder.
+ *
+ * @author
+ *  Ittiam
+ *
+ * @par List of Functions:
+ *  ih264e_sixtapfilter_horz_avx2
+ *  ih264e_sixtap_filter_2dvh_vert_avx2
+ *
+ * @remarks
+ *  None
+ *
+ *******************************************************************************
+ */
+
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+/* System include files */
+#include <stdio.h>
+#include <assert.h>
+#include <limits.h>
+#include <immintrin.h>
+
+/* User include files */
+#include "ih264_typedefs.h"
+#include "ithread.h"
+#include "ih264_platform_macros.h"
+#include "ih264_defs.h"
+#include "ih264e_half_pel.h"
+#include "ih264_macros.h"
+#include "ih264e_debug.h"
+#include "ih264_inter_pred_filters.h"
+#include "ih264_mem_fns.h"
+#include "ih264_padding.h"
+#include "ih264_intra_pred_filters.h"
+#include "ih264_deblk_edge_filters.h"
+
+
+/*****************************************************************************/
+/* Function Definitions                                                      */
+/*****************************************************************************/
+/*
+*******************************************************************************
+*
+* @brief
+*  Interprediction luma filter for horizontal input(Filter run for width = 17
+*  and height =16)
+*
+* @par Description:
+*  Applies a 6 tap horizontal filter .The output is  clipped to 8 bits sec.
+*  8.4.2.2.1 titled "Luma sample interpolation process". Two rows are filtered
+*  per iteration, one in each 128 bit lane.
+*
+* @param[in] pu1_src
+*  UWORD8 pointer to the source
+*
+* @param[out] pu1_dst
+*  UWORD8 pointer to the destination
+*
+* @param[in] src_strd
+*  integer source stride
+*
+* @param[in] dst_strd
+*  integer destination stride
+*
+* @returns
+*  None
+*
+* @remarks
+*  Output is bit exact with ih264e_sixtapfilter_horz
+*
+*******************************************************************************
+*/
+void ATTRIBUTE_AVX2 ih264e_sixtapfilter_horz_avx2(UWORD8 *pu1_src,
+                                                  UWORD8 *pu1_dst,
+                                                  WORD32 src_strd,
+                                                  WORD32 dst_strd)
+{
+    WORD32 ht;
+    WORD32 tmp;
+
+    __m256i src_r0_32x8b, src_r1_32x8b, src_r0_sht_32x8b, src_r1_sht_32x8b;
+    __m256i src_r0_t1_32x8b, src_r1_t1_32x8b;
+
+    __m256i res_r0_t1_16x16b, res_r0_t2_16x16b, res_r0_t3_16x16b;
+    __m256i res_r1_t1_16x16b, res_r1_t2_16x16b, res_r1_t3_16x16b;
+
+    __m256i coeff0_1_32x8b, coeff2_3_32x8b, coeff4_5_32x8b;
+    __m256i const_val16_16x16b;
+
+    ht = 16;
+    pu1_src -= 2; // the filter input starts from x[-2] (till x[3])
+
+    coeff0_1_32x8b = _mm256_set1_epi32(0xFB01FB01); //c0 c1 c0 c1 ...
+    coeff2_3_32x8b = _mm256_set1_epi32(0x14141414); //c2 c3 c2 c3 ...
+    coeff4_5_32x8b = _mm256_set1_epi32(0x01FB01FB); //c4 c5 c4 c5 ...
+                                                    //c0 = c5 = 1, c1 = c4 = -5, c2 = c3 = 20
+    const_val16_16x16b = _mm256_set1_epi16(16);
+
+    //Lane 0 holds row n and lane 1 holds row n + 1.
+    //Row  : a0 a1 a2 a3 a4 a5 a6 a7 a8 a9.....
+    //Row  :                         b0 b1 b2 b3 b4 b5 b6 b7 b8 b9.....
+    //b0 is same a8. Similarly other bn pixels are same as a(n+8) pixels.
+
+    do
+    {
+        src_r0_32x8b = _mm256_inserti128_si256(
+                        _mm256_castsi128_si256(_mm_loadu_si128((__m128i *)pu1_src)),
+                        _mm_loadu_si128((__m128i *)(pu1_src + src_strd)), 1);
+        src_r1_32x8b = _mm256_inserti128_si256(
+                        _mm256_castsi128_si256(_mm_loadu_si128((__m128i *)(pu1_src + 8))),
+                        _mm_loadu_si128((__m128i *)(pu1_src + src_strd + 8)), 1);
+
+        src_r0_sht_32x8b = _mm256_srli_si256(src_r0_32x8b, 1);                       //a1 a2 a3 a4 a5 a6 a7 a8 a9....a15 0
+        src_r1_sht_32x8b = _mm256_srli_si256(src_r1_32x8b, 1);                       //b1 b2 b3 b4 b5 b6 b7 b8 b9....b15 0
+
+        src_r0_t1_32x8b = _mm256_unpacklo_epi8(src_r0_32x8b, src_r0_sht_32x8b);      //a0 a1 a1 a2 a2 a3 a3 a4 a4 a5 a5 a6 a6 a7 a7 a8
+        src_r1_t1_32x8b = _mm256_unpacklo_epi8(src_r1_32x8b, src_r1_sht_32x8b);      //b0 b1 b1 b2 b2 b3 b3 b4 b4 b5 b5 b6 b6 b7 b7 b8
+
+        res_r0_t1_16x16b = _mm256_maddubs_epi16(src_r0_t1_32x8b, coeff0_1_32x8b);
+        res_r1_t1_16x16b = _mm256_maddubs_epi16(src_r1_t1_32x8b, coeff0_1_32x8b);
+
+        src_r0_32x8b = _mm256_srli_si256(src_r0_32x8b, 2);                           //a2 a3 a4 a5 a6 a7 a8 a9....a15 0 0
+        src_r1_32x8b = _mm256_srli_si256(src_r1_32x8b, 2);                           //b2 b3 b4 b5 b6 b7 b8 b9....b15 0 0
+
+        src_r0_sht_32x8b = _mm256_srli_si256(src_r0_sht_32x8b, 2);                   //a3 a4 a5 a6 a7 a8 a9....a15 0  0  0
+        src_r1_sht_32x8b = _mm256_srli_si256(src_r1_sht_32x8b, 2);                   //b3 b4 b5 b6 b7 b8 b9....b15 0  0  0
+
+        src_r0_t1_32x8b = _mm256_unpacklo_epi8(src_r0_32x8b, src_r0_sht_32x8b);      //a2 a3 a3 a4 a4 a5 a5 a6 a6 a7 a7 a8 a8 a9 a9 a10
+        src_r1_t1_32x8b = _mm256_unpacklo_epi8(src_r1_32x8b, src_r1_sht_32x8b);      //b2 b3 b3 b4 b4 b5 b5 b6 b6 b7 b7 b8 b8 b9 b9 b10
+
+        res_r0_t2_16x16b = _mm256_maddubs_epi16(src_r0_t1_32x8b, coeff2_3_32x8b);
+        res_r1_t2_16x16b = _mm256_maddubs_epi16(src_r1_t1_32x8b, coeff2_3_32x8b);
+
+        src_r0_32x8b = _mm256_srli_si256(src_r0_32x8b, 2);                           //a4 a5 a6 a7 a8 a9....a15 0  0  0  0
+        src_r1_32x8b = _mm256_srli_si256(src_r1_32x8b, 2);                           //b4 b5 b6 b7 b8 b9....b15 0  0  0  0
+
+        src_r0_sht_32x8b = _mm256_srli_si256(src_r0_sht_32x8b, 2);                   //a5 a6 a7 a8 a9....a15 0  0  0  0  0
+        src_r1_sht_32x8b = _mm256_srli_si256(src_r1_sht_32x8b, 2);                   //b5 b6 b7 b8 b9....b15 0  0  0  0  0
+
+        src_r0_t1_32x8b = _mm256_unpacklo_epi8(src_r0_32x8b, src_r0_sht_32x8b);      //a4 a5 a5 a6 a6 a7 a7 a8 a8 a9 a9 a10 a10 a11 a11 a12
+        src_r1_t1_32x8b = _mm256_unpacklo_epi8(src_r1_32x8b, src_r1_sht_32x8b);      //b4 b5 b5 b6 b6 b7 b7 b8 b8 b9 b9 b10 b10 b11 b11 b12
+
+        res_r0_t3_16x16b = _mm256_maddubs_epi16(src_r0_t1_32x8b, coeff4_5_32x8b);
+        res_r1_t3_16x16b = _mm256_maddubs_epi16(src_r1_t1_32x8b, coeff4_5_32x8b);
+
+        res_r0_t1_16x16b = _mm256_add_epi16(res_r0_t1_16x16b, res_r0_t2_16x16b);
+        res_r1_t1_16x16b = _mm256_add_epi16(res_r1_t1_16x16b, res_r1_t2_16x16b);
+        res_r0_t3_16x16b = _mm256_add_epi16(res_r0_t3_16x16b, const_val16_16x16b);
+        res_r1_t3_16x16b = _mm256_add_epi16(res_r1_t3_16x16b, const_val16_16x16b);
+        res_r0_t1_16x16b = _mm256_add_epi16(res_r0_t1_16x16b, res_r0_t3_16x16b);
+        res_r1_t1_16x16b = _mm256_add_epi16(res_r1_t1_16x16b, res_r1_t3_16x16b);
+
+        res_r0_t1_16x16b = _mm256_srai_epi16(res_r0_t1_16x16b, 5);                   //shifting right by 5 bits.
+        res_r1_t1_16x16b = _mm256_srai_epi16(res_r1_t1_16x16b, 5);
+
+        src_r0_32x8b = _mm256_packus_epi16(res_r0_t1_16x16b, res_r1_t1_16x16b);
+
+        _mm_storeu_si128((__m128i *)pu1_dst, _mm256_castsi256_si128(src_r0_32x8b));
+        _mm_storeu_si128((__m128i *)(pu1_dst + dst_strd), _mm256_extracti128_si256(src_r0_32x8b, 1));
+
+        tmp = ((pu1_src[18] + pu1_src[19]) << 2) - pu1_src[17] - pu1_src[20];
+        tmp = pu1_src[16] + pu1_src[21] + (tmp << 2) + tmp;
+        tmp = (tmp + 16) >> 5;
+        pu1_dst[16] = CLIP_U8(tmp);
+
+        pu1_src += src_strd;
+        pu1_dst += dst_strd;
+
+        tmp = ((pu1_src[18] + pu1_src[19]) << 2) - pu1_src[17] - pu1_src[20];
+        tmp = pu1_src[16] + pu1_src[21] + (tmp << 2) + tmp;
+        tmp = (tmp + 16) >> 5;
+        pu1_dst[16] = CLIP_U8(tmp);
+
+        ht -= 2;
+        pu1_src += src_strd;
+        pu1_dst += dst_strd;
+    }
+    while(ht > 0);
+}
+
+/*
+*******************************************************************************
+*
+* @brief
+*   This function implements a two stage cascaded six tap filter. It
+*    applies the six tap filter in the vertical direction on the
+*    predictor values, followed by applying the same filter in the
+*    horizontal direction on the output of the first stage. The six tap
+*    filtering operation is described in sec 8.4.2.2.1 titled "Luma sample
+*    interpolation process" (Filter run for width = 17 and height =17)
+*
+* @par Description:
+*    The function interpolates the predictors first in the vertical direction
+*    and then in the horizontal direction to output the (1/2,1/2). The output
+*    of the first stage of the filter is stored in the buffer pointed to by
+*    pi16_pred1(only in C) in 16 bit precision. In the vertical stage lane 0
+*    filters columns 0 - 15 and lane 1 columns 6 - 21 of a row, in the
+*    horizontal stage lane 0 produces outputs 0 - 7 and lane 1 outputs 8 - 15.
+*
+* @param[in] pu1_src
+*  UWORD8 pointer to the source
+*
+* @param[out] pu1_dst1
+*  UWORD8 pointer to the destination(Vertical filtered output)
+*
+* @param[out] pu1_dst2
+*  UWORD8 pointer to the destination(out put after applying horizontal filter
+*  to the intermediate vertical output)
+*
+* @param[in] src_strd
+*  integer source stride
+
+* @param[in] dst_strd
+*  integer destination stride of pu1_dst
+*
+* @param[in]pi16_pred1
+*  Pointer to 16bit intermediate buffer(used only in c)
+*
+* @param[in] pi16_pred1_strd
+*  integer destination stride of pi16_pred1
+*
+* @returns
+*  None
+*
+* @remarks
+*  Output is bit exact with ih264e_sixtap_filter_2dvh_vert
+*
+*******************************************************************************
+*/
+void ATTRIBUTE_AVX2 ih264e_sixtap_filter_2dvh_vert_avx2(UWORD8 *pu1_src,
+                                                        UWORD8 *pu1_dst1,
+                                                        UWORD8 *pu1_dst2,
+                                                        WORD32 src_strd,
+                                                        WORD32 dst_strd,
+                                                        WORD32 *pi4_pred1,
+                                                        WORD32 pred1_strd)
+{
+    WORD32 ht;
+    WORD16 *pi2_pred1;
+
+    ht = 17;
+    pi2_pred1 = (WORD16 *)pi4_pred1;
+    pred1_strd = pred1_strd << 1;
+
+    // Vertical 6-tap filter
+    {
+        __m256i src_r0_32x8b, src_r1_32x8b, src_r2_32x8b;
+        __m256i src_r3_32x8b, src_r4_32x8b, src_r5_32x8b;
+
+        __m256i src_r0r1_32x8b, src_r2r3_32x8b, src_r4r5_32x8b;
+
+        __m256i res_t1_16x16b, res_t2_16x16b, res_t3_16x16b;
+        __m256i coeff0_1_32x8b, coeff2_3_32x8b, coeff4_5_32x8b;
+
+        coeff0_1_32x8b = _mm256_set1_epi32(0xFB01FB01); //c0 c1 c0 c1 ...
+        coeff2_3_32x8b = _mm256_set1_epi32(0x14141414); //c2 c3 c2 c3 ...
+        coeff4_5_32x8b = _mm256_set1_epi32(0x01FB01FB); //c4 c5 c4 c5 ...
+                                                        //c0 = c5 = 1, c1 = c4 = -5, c2 = c3 = 20
+
+        pu1_src -= 2;
+        pu1_src -= src_strd << 1; // the filter input starts from x[-2] (till x[3])
+
+        // Loading first five rows to start first row processing.
+        // 22 values loaded in each row, 0 - 15 in lane 0 and 6 - 21 in lane 1.
+        src_r0_32x8b = _mm256_inserti128_si256(
+                            _mm256_castsi128_si256(_mm_loadu_si128((__m128i *)pu1_src)),
+                            _mm_loadu_si128((__m128i *)(pu1_src + 6)), 1);
+        pu1_src += src_strd;
+
+        src_r1_32x8b = _mm256_inserti128_si256(
+                            _mm256_castsi128_si256(_mm_loadu_si128((__m128i *)pu1_src)),
+                            _mm_loadu_si128((__m128i *)(pu1_src + 6)), 1);
+        pu1_src += src_strd;
+
+        src_r2_32x8b = _mm256_inserti128_si256(
+                            _mm256_castsi128_si256(_mm_loadu_si128((__m128i *)pu1_src)),
+                            _mm_loadu_si128((__m128i *)(pu1_src + 6)), 1);
+        pu1_src += src_strd;
+
+        src_r3_32x8b = _mm256_inserti128_si256(
+                            _mm256_castsi128_si256(_mm_loadu_si128((__m128i *)pu1_src)),
+                            _mm_loadu_si128((__m128i *)(pu1_src + 6)), 1);
+        pu1_src += src_strd;
+
+        src_r4_32x8b = _mm256_inserti128_si256(
+                            _mm256_castsi128_si256(_mm_loadu_si128((__m128i *)pu1_src)),
+                            _mm_loadu_si128((__m128i *)(pu1_src + 6)), 1);
+        pu1_src += src_strd;
+
+        do
+        {
+            src_r5_32x8b = _mm256_inserti128_si256(
+                                _mm256_castsi128_si256(_mm_loadu_si128((__m128i *)pu1_src)),
+                                _mm_loadu_si128((__m128i *)(pu1_src + 6)), 1);
+
+            /* columns 0 - 7 in lane 0, 6 - 13 (unused) in lane 1 */
+            src_r0r1_32x8b = _mm256_unpacklo_epi8(src_r0_32x8b, src_r1_32x8b);
+            src_r2r3_32x8b = _mm256_unpacklo_epi8(src_r2_32x8b, src_r3_32x8b);
+            src_r4r5_32x8b = _mm256_unpacklo_epi8(src_r4_32x8b, src_r5_32x8b);
+
+            res_t1_16x16b = _mm256_maddubs_epi16(src_r0r1_32x8b, coeff0_1_32x8b);
+            res_t2_16x16b = _mm256_maddubs_epi16(src_r2r3_32x8b, coeff2_3_32x8b);
+            res_t3_16x16b = _mm256_maddubs_epi16(src_r4r5_32x8b, coeff4_5_32x8b);
+
+            res_t1_16x16b = _mm256_add_epi16(res_t1_16x16b, res_t2_16x16b);
+            res_t1_16x16b = _mm256_add_epi16(res_t3_16x16b, res_t1_16x16b);
+
+            _mm_storeu_si128((__m128i *)pi2_pred1, _mm256_castsi256_si128(res_t1_16x16b));
+
+            /* columns 8 - 15 in lane 0, 14 - 21 in lane 1 */
+            src_r0r1_32x8b = _mm256_unpackhi_epi8(src_r0_32x8b, src_r1_32x8b);
+            src_r2r3_32x8b = _mm256_unpackhi_epi8(src_r2_32x8b, src_r3_32x8b);
+            src_r4r5_32x8b = _mm256_unpackhi_epi8(src_r4_32x8b, src_r5_32x8b);
+
+            res_t1_16x16b = _mm256_maddubs_epi16(src_r0r1_32x8b, coeff0_1_32x8b);
+            res_t2_16x16b = _mm256_maddubs_epi16(src_r2r3_32x8b, coeff2_3_32x8b);
+            res_t3_16x16b = _mm256_maddubs_epi16(src_r4r5_32x8b, coeff4_5_32x8b);
+
+            res_t1_16x16b = _mm256_add_epi16(res_t1_16x16b, res_t2_16x16b);
+            res_t1_16x16b = _mm256_add_epi16(res_t3_16x16b, res_t1_16x16b);
+
+            _mm_storeu_si128((__m128i *)(pi2_pred1 + 8), _mm256_castsi256_si128(res_t1_16x16b));
+            _mm_storeu_si128((__m128i *)(pi2_pred1 + 14), _mm256_extracti128_si256(res_t1_16x16b, 1));
+
+            src_r0_32x8b = src_r1_32x8b;
+            src_r1_32x8b = src_r2_32x8b;
+            src_r2_32x8b = src_r3_32x8b;
+            src_r3_32x8b = src_r4_32x8b;
+            src_r4_32x8b = src_r5_32x8b;
+
+            ht--;
+            pu1_src += src_strd;
+            pi2_pred1 += pred1_strd;
+        }
+        while(ht > 0);
+    }
+
+    ht = 17;
+    pi2_pred1 = (WORD16 *)pi4_pred1;
+
+    // Horizontal 6-tap filter
+    {
+        WORD32 temp;
+
+        __m256i src_r0_16x16b, src_r1_16x16b, src_r2_16x16b, src_r3_16x16b;
+        __m256i src_r4_16x16b, src_r5_16x16b;
+        __m256i src_r0r1_16x16b, src_r2r3_16x16b, src_r4r5_16x16b;
+        __m256i res_vert_16x16b, res_c_16x16b;
+
+        __m256i res_t0_8x32b, res_t1_8x32b, res_t2_8x32b, res_t3_8x32b;
+        __m128i res_16x8b;
+
+        __m256i coeff0_1_16x16b, coeff2_3_16x16b, coeff4_5_16x16b;
+        __m256i const_val512_8x32b, const_val16_16x16b;
+
+        coeff0_1_16x16b = _mm256_set1_epi32(0xFFFB0001); //c0 c1 c0 c1 ...
+        coeff2_3_16x16b = _mm256_set1_epi32(0x00140014); //c2 c3 c2 c3 ...
+        coeff4_5_16x16b = _mm256_set1_epi32(0x0001FFFB); //c4 c5 c4 c5 ...
+                                                         //c0 = c5 = 1, c1 = c4 = -5, c2 = c3 = 20
+        const_val512_8x32b = _mm256_set1_epi32(512);
+        const_val16_16x16b = _mm256_set1_epi16(16);
+
+        do
+        {
+            src_r0_16x16b = _mm256_loadu_si256((__m256i *)(pi2_pred1));
+            src_r1_16x16b = _mm256_loadu_si256((__m256i *)(pi2_pred1 + 1));
+            src_r2_16x16b = _mm256_loadu_si256((__m256i *)(pi2_pred1 + 2));
+            src_r3_16x16b = _mm256_loadu_si256((__m256i *)(pi2_pred1 + 3));
+            src_r4_16x16b = _mm256_loadu_si256((__m256i *)(pi2_pred1 + 4));
+            src_r5_16x16b = _mm256_loadu_si256((__m256i *)(pi2_pred1 + 5));
+
+            res_vert_16x16b = _mm256_add_epi16(src_r2_16x16b, const_val16_16x16b);
+            res_vert_16x16b = _mm256_srai_epi16(res_vert_16x16b, 5); //shifting right by 5 bits.
+
+            /* outputs 0 - 3 in lane 0, 8 - 11 in lane 1 */
+            src_r0r1_16x16b = _mm256_unpacklo_epi16(src_r0_16x16b, src_r1_16x16b);
+            src_r2r3_16x16b = _mm256_unpacklo_epi16(src_r2_16x16b, src_r3_16x16b);
+            src_r4r5_16x16b = _mm256_unpacklo_epi16(src_r4_16x16b, src_r5_16x16b);
+
+            res_t1_8x32b = _mm256_madd_epi16(src_r0r1_16x16b, coeff0_1_16x16b);
+            res_t2_8x32b = _mm256_madd_epi16(src_r2r3_16x16b, coeff2_3_16x16b);
+            res_t3_8x32b = _mm256_madd_epi16(src_r4r5_16x16b, coeff4_5_16x16b);
+
+            res_t1_8x32b = _mm256_add_epi32(res_t1_8x32b, res_t2_8x32b);
+            res_t3_8x32b = _mm256_add_epi32(res_t3_8x32b, const_val512_8x32b);
+            res_t1_8x32b = _mm256_add_epi32(res_t1_8x32b, res_t3_8x32b);
+            res_t0_8x32b = _mm256_srai_epi32(res_t1_8x32b, 10);
+
+            /* outputs 4 - 7 in lane 0, 12 - 15 in lane 1 */
+            src_r0r1_16x16b = _mm256_unpackhi_epi16(src_r0_16x16b, src_r1_16x16b);
+            src_r2r3_16x16b = _mm256_unpackhi_epi16(src_r2_16x16b, src_r3_16x16b);
+            src_r4r5_16x16b = _mm256_unpackhi_epi16(src_r4_16x16b, src_r5_16x16b);
+
+            res_t1_8x32b = _mm256_madd_epi16(src_r0r1_16x16b, coeff0_1_16x16b);
+            res_t2_8x32b = _mm256_madd_epi16(src_r2r3_16x16b, coeff2_3_16x16b);
+            res_t3_8x32b = _mm256_madd_epi16(src_r4r5_16x16b, coeff4_5_16x16b);
+
+            res_t1_8x32b = _mm256_add_epi32(res_t1_8x32b, res_t2_8x32b);
+            res_t3_8x32b = _mm256_add_epi32(res_t3_8x32b, const_val512_8x32b);
+            res_t1_8x32b = _mm256_add_epi32(res_t1_8x32b, res_t3_8x32b);
+            res_t1_8x32b = _mm256_srai_epi32(res_t1_8x32b, 10);
+
+            res_c_16x16b = _mm256_packs_epi32(res_t0_8x32b, res_t1_8x32b);
+
+            res_16x8b = _mm_packus_epi16(_mm256_castsi256_si128(res_vert_16x16b),
+                                         _mm256_extracti128_si256(res_vert_16x16b, 1));
+            _mm_storeu_si128((__m128i *)pu1_dst1, res_16x8b);
+            pu1_dst1[16] = CLIP_U8((pi2_pred1[18] + 16) >> 5);
+
+            res_16x8b = _mm_packus_epi16(_mm256_castsi256_si128(res_c_16x16b),
+                                         _mm256_extracti128_si256(res_c_16x16b, 1));
+            _mm_storeu_si128((__m128i *)pu1_dst2, res_16x8b);
+            temp = ((pi2_pred1[18] + pi2_pred1[19]) << 2) - pi2_pred1[17] - pi2_pred1[20];
+            temp = pi2_pred1[16] + pi2_pred1[21] + (temp << 2) + temp;
+            pu1_dst2[16] = CLIP_U8((temp + 512) >> 10);
+
+            ht--;
+            pi2_pred1 += pred1_strd;
+            pu1_dst1 += dst_strd;
+            pu1_dst2 += dst_strd;
+        }
+        while(ht > 0);
+    }
+}
@@ -97,6 +97,7 @@
 *
 *******************************************************************************
 */
+ATTRIBUTE_SSSE3
 void ih264e_sixtapfilter_horz_ssse3(UWORD8 *pu1_src,
                                     UWORD8 *pu1_dst,
                                     WORD32 src_strd,
@@ -243,6 +244,7 @@ void ih264e_sixtapfilter_horz_ssse3(UWORD8 *pu1_src,
 *
 *******************************************************************************
 */
+ATTRIBUTE_SSSE3
 void ih264e_sixtap_filter_2dvh_vert_ssse3(UWORD8 *pu1_src,
                                           UWORD8 *pu1_dst1,
                                           UWORD8 *pu1_dst2,
@@ -132,6 +132,7 @@
 *
 ******************************************************************************
 */
+ATTRIBUTE_SSSE3
 void ih264e_evaluate_intra16x16_modes_ssse3(UWORD8 *pu1_src,
                                             UWORD8 *pu1_ngbr_pels_i16,
                                             UWORD8 *pu1_dst,
@@ -470,6 +471,7 @@ void ih264e_evaluate_intra16x16_modes_ssse3(UWORD8 *pu1_src,
 *
 ******************************************************************************
 */
+ATTRIBUTE_SSSE3
 void ih264e_evaluate_intra_4x4_modes_ssse3(UWORD8 *pu1_src,
                                            UWORD8 *pu1_ngbr_pels,
                                            UWORD8 *pu1_dst,
@@ -821,6 +823,7 @@ void ih264e_evaluate_intra_4x4_modes_ssse3(UWORD8 *pu1_src,
 ******************************************************************************
 */
 
+ATTRIBUTE_SSSE3
 void ih264e_evaluate_intra_chroma_modes_ssse3(UWORD8 *pu1_src,
                                               UWORD8 *pu1_ngbr_pels,
                                               UWORD8 *pu1_dst,
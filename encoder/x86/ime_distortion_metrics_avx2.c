@@ -0,0 +1,135 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+
+/**
+******************************************************************************
+* @file ime_distortion_metrics_avx2.c
+*
+* @brief
+*  This file contains AVX2 definitions of routines that compute distortion
+*  between two macro/sub blocks of identical dimensions
+*
+* @author
+*  Ittiam
+*
+* @par List of Functions:
+*  - ime_calculate_sad8_horz_avx2()
+*
+* @remarks
+*  Each 256 bit register holds two consecutive rows so that one vmpsadbw
+*  matches a 4 pixel group of both rows against eight reference positions
+*
+*******************************************************************************
+*/
+
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+/* System include files */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* User include files */
+#include "ime_typedefs.h"
+#include "ime_defs.h"
+#include "ime_macros.h"
+#include "ime_statistics.h"
+#include "ime_platform_macros.h"
+#include "ime_distortion_metrics.h"
+#include <immintrin.h>
+
+/*****************************************************************************/
+/* Function Definitions                                                      */
+/*****************************************************************************/
+
+/**
+*******************************************************************************
+*
+* @brief compute sad
+*
+* @par Description: This function computes the sad of a 16x16 source block at
+* eight horizontally adjacent positions starting at the reference pointer.
+* Two reference rows are loaded at a time and vmpsadbw matches each 4 pixel
+* group of both source rows against all eight positions.
+*
+* @param[in] pu1_src
+*  UWORD8 pointer to the source
+*
+* @param[in] pu1_ref
+*  UWORD8 pointer to the left most reference position
+*
+* @param[in] src_strd
+*  integer source stride
+*
+* @param[in] ref_strd
+*  integer reference stride
+*
+* @param[out] pi4_sad
+*  pointer to integer array evaluated sad, one per position
+*
+* @returns  sad at all evaluated positions
+*
+* @remarks  reads 24 bytes of every reference row, sad of a row fits in 16 bits
+*
+*******************************************************************************
+*/
+void ATTRIBUTE_AVX2 ime_calculate_sad8_horz_avx2(UWORD8 *pu1_src,
+                                                 UWORD8 *pu1_ref,
+                                                 WORD32 src_strd,
+                                                 WORD32 ref_strd,
+                                                 WORD32 *pi4_sad)
+{
+    __m256i src, ref_lo, ref_hi;
+    __m256i sad_16x16b = _mm256_setzero_si256();
+    __m128i sad_8x16b;
+    WORD32 i;
+
+    for(i = 0; i < MB_SIZE; i += 2)
+    {
+        src = _mm256_inserti128_si256(
+                        _mm256_castsi128_si256(_mm_loadu_si128((__m128i *) (pu1_src))),
+                        _mm_loadu_si128((__m128i *) (pu1_src + src_strd)), 1);
+        ref_lo = _mm256_inserti128_si256(
+                        _mm256_castsi128_si256(_mm_loadu_si128((__m128i *) (pu1_ref))),
+                        _mm_loadu_si128((__m128i *) (pu1_ref + ref_strd)), 1);
+        ref_hi = _mm256_inserti128_si256(
+                        _mm256_castsi128_si256(_mm_loadu_si128((__m128i *) (pu1_ref + 8))),
+                        _mm_loadu_si128((__m128i *) (pu1_ref + ref_strd + 8)), 1);
+
+        /* same group selection in both lanes, bits 0-2 and 3-5 of imm */
+        /* source pixels 0-3, 4-7 against reference 0-10, 4-14 */
+        sad_16x16b = _mm256_add_epi16(sad_16x16b, _mm256_mpsadbw_epu8(ref_lo, src, 0));
+        sad_16x16b = _mm256_add_epi16(sad_16x16b, _mm256_mpsadbw_epu8(ref_lo, src, 45));
+        /* source pixels 8-11, 12-15 against reference 8-18, 12-22 */
+        sad_16x16b = _mm256_add_epi16(sad_16x16b, _mm256_mpsadbw_epu8(ref_hi, src, 18));
+        sad_16x16b = _mm256_add_epi16(sad_16x16b, _mm256_mpsadbw_epu8(ref_hi, src, 63));
+
+        pu1_src += 2 * src_strd;
+        pu1_ref += 2 * ref_strd;
+    }
+
+    /* add the sads of odd rows to those of even rows */
+    sad_8x16b = _mm_add_epi16(_mm256_castsi256_si128(sad_16x16b),
+                              _mm256_extracti128_si256(sad_16x16b, 1));
+
+    _mm256_storeu_si256((__m256i *) (pi4_sad), _mm256_cvtepu16_epi32(sad_8x16b));
+}
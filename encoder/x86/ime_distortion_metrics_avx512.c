@@ -0,0 +1,423 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+
+/**
+******************************************************************************
+* @file ime_distortion_metrics_avx512.c
+*
+* @brief
+*  This file contains AVX-512BW definitions of routines that compute
+*  distortion between two macro/sub blocks of identical dimensions
+*
+* @author
+*  Ittiam
+*
+* @par List of Functions:
+*  - ime_load_4x16_avx512()
+*  - ime_reduce_sad4_avx512()
+*  - ime_compute_sad_16x16_avx512()
+*  - ime_calculate_sad4_prog_avx512()
+*  - ime_calculate_sad3_prog_avx512()
+*  - ime_sub_pel_compute_sad_16x16_avx512()
+*
+* @remarks
+*  Each 512 bit register holds four 16 pixel rows. The candidate kernels
+*  place one row of four different candidate positions in a register so that
+*  a single vpsadbw evaluates all of them against the broadcast source row
+*
+*******************************************************************************
+*/
+
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+/* System include files */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* User include files */
+#include "ime_typedefs.h"
+#include "ime_defs.h"
+#include "ime_macros.h"
+#include "ime_statistics.h"
+#include "ime_platform_macros.h"
+#include "ime_distortion_metrics.h"
+#include <immintrin.h>
+
+/*****************************************************************************/
+/* Function Definitions                                                      */
+/*****************************************************************************/
+
+/**
+******************************************************************************
+*
+* @brief loads four 16 byte rows into one 512 bit register
+*
+* @param[in] pu1_0, pu1_1, pu1_2, pu1_3
+*  UWORD8 pointers to the rows, placed in lanes 0 to 3
+*
+* @returns  packed rows
+*
+* @remarks
+*
+******************************************************************************
+*/
+static __inline __m512i ATTRIBUTE_AVX512BW ime_load_4x16_avx512(UWORD8 *pu1_0,
+                                                               UWORD8 *pu1_1,
+                                                               UWORD8 *pu1_2,
+                                                               UWORD8 *pu1_3)
+{
+    __m512i res;
+
+    res = _mm512_castsi128_si512(_mm_loadu_si128((__m128i *) pu1_0));
+    res = _mm512_inserti32x4(res, _mm_loadu_si128((__m128i *) pu1_1), 1);
+    res = _mm512_inserti32x4(res, _mm_loadu_si128((__m128i *) pu1_2), 2);
+    res = _mm512_inserti32x4(res, _mm_loadu_si128((__m128i *) pu1_3), 3);
+
+    return res;
+}
+
+/**
+******************************************************************************
+*
+* @brief folds the two partial sads of every 128 bit lane
+*
+* @param[in] sad
+*  vpsadbw accumulator holding two partial sads per lane
+*
+* @param[out] pi4_sad
+*  sad of lanes 0 to 3
+*
+* @remarks
+*
+******************************************************************************
+*/
+static __inline void ATTRIBUTE_AVX512BW ime_reduce_sad4_avx512(__m512i sad,
+                                                              WORD32 *pi4_sad)
+{
+    __m128i sad_4x32b;
+
+    /* add upper partial sad of every lane to the lower one */
+    sad = _mm512_add_epi64(sad, _mm512_shuffle_epi32(sad, _MM_PERM_BADC));
+
+    /* gather the lower dword of every lane */
+    sad = _mm512_permutexvar_epi32(_mm512_set_epi32(0, 0, 0, 0, 0, 0, 0, 0,
+                                                    0, 0, 0, 0, 12, 8, 4, 0),
+                                   sad);
+    sad_4x32b = _mm512_castsi512_si128(sad);
+
+    _mm_storeu_si128((__m128i *) pi4_sad, sad_4x32b);
+}
+
+/**
+******************************************************************************
+*
+* @brief computes distortion (SAD) between 2 16x16 blocks
+*
+* @par   Description
+*   This functions computes SAD between 2 16x16 blocks. There is a provision
+*   for early exit if the up-to computed SAD exceeds maximum allowed SAD. To
+*   compute the distortion of the entire block set u4_max_sad to USHRT_MAX.
+*
+* @param[in] pu1_src
+*  UWORD8 pointer to the source
+*
+* @param[out] pu1_dst
+*  UWORD8 pointer to the destination
+*
+* @param[in] src_strd
+*  integer source stride
+*
+* @param[in] dst_strd
+*  integer destination stride
+*
+* @param[in] i4_max_sad
+*  integer maximum allowed distortion
+*
+* @param[out] pi4_mb_distortion
+*  integer evaluated sad
+*
+* @remarks
+*
+******************************************************************************
+*/
+void ATTRIBUTE_AVX512BW ime_compute_sad_16x16_avx512(UWORD8 *pu1_src,
+                                                     UWORD8 *pu1_est,
+                                                     WORD32 src_strd,
+                                                     WORD32 est_strd,
+                                                     WORD32 i4_max_sad,
+                                                     WORD32 *pi4_mb_distortion)
+{
+    __m512i src, est, sad;
+    WORD32 i, i4_sad;
+
+    sad = _mm512_setzero_si512();
+
+    for(i = 0; i < 4; i++)
+    {
+        src = ime_load_4x16_avx512(pu1_src, pu1_src + src_strd,
+                                   pu1_src + 2 * src_strd,
+                                   pu1_src + 3 * src_strd);
+        est = ime_load_4x16_avx512(pu1_est, pu1_est + est_strd,
+                                   pu1_est + 2 * est_strd,
+                                   pu1_est + 3 * est_strd);
+
+        sad = _mm512_add_epi64(sad, _mm512_sad_epu8(src, est));
+
+        /* early exit once the partial sad exceeds the allowed maximum */
+        i4_sad = (WORD32)_mm512_reduce_add_epi64(sad);
+        if(i4_max_sad < i4_sad)
+        {
+            *pi4_mb_distortion = i4_sad;
+            return;
+        }
+
+        pu1_src += 4 * src_strd;
+        pu1_est += 4 * est_strd;
+    }
+
+    *pi4_mb_distortion = i4_sad;
+
+    return;
+}
+
+/**
+*******************************************************************************
+*
+* @brief compute sad
+*
+* @par Description: This function computes the sad at vertices of diamond grid
+* centered at reference pointer and at unit distance from it.
+*
+* @param[in] pu1_ref
+*  UWORD8 pointer to the reference
+*
+* @param[out] pu1_src
+*  UWORD8 pointer to the source
+*
+* @param[in] ref_strd
+*  integer reference stride
+*
+* @param[in] src_strd
+*  integer source stride
+*
+* @param[out] pi4_sad
+*  pointer to integer array evaluated sad
+*
+* @returns  sad at all evaluated vertexes
+*
+* @remarks  none
+*
+*******************************************************************************
+*/
+void ATTRIBUTE_AVX512BW ime_calculate_sad4_prog_avx512(UWORD8 *pu1_ref,
+                                                       UWORD8 *pu1_src,
+                                                       WORD32 ref_strd,
+                                                       WORD32 src_strd,
+                                                       WORD32 *pi4_sad)
+{
+    /* reference ptrs at unit 1 distance in diamond pattern centered at pu1_ref */
+    UWORD8 *left_ptr    = pu1_ref - 1;
+    UWORD8 *right_ptr   = pu1_ref + 1;
+    UWORD8 *top_ptr     = pu1_ref - ref_strd;
+    UWORD8 *bot_ptr     = pu1_ref + ref_strd;
+
+    __m512i src, ref, sad;
+    WORD32 i;
+
+    sad = _mm512_setzero_si512();
+
+    for(i = 0; i < MB_SIZE; i++)
+    {
+        src = _mm512_broadcast_i32x4(_mm_loadu_si128((__m128i *) pu1_src));
+        ref = ime_load_4x16_avx512(left_ptr, right_ptr, top_ptr, bot_ptr);
+
+        sad = _mm512_add_epi64(sad, _mm512_sad_epu8(src, ref));
+
+        pu1_src += src_strd;
+        left_ptr += ref_strd;
+        right_ptr += ref_strd;
+        top_ptr += ref_strd;
+        bot_ptr += ref_strd;
+    }
+
+    ime_reduce_sad4_avx512(sad, pi4_sad);
+}
+
+/**
+*******************************************************************************
+*
+* @brief compute sad
+*
+* @par Description: This function computes the sad at vertices of diamond grid
+* centered at reference pointer and at unit distance from it.
+*
+* @param[in] pu1_ref1, pu1_ref2, pu1_ref3
+*  UWORD8 pointer to the reference
+*
+* @param[out] pu1_src
+*  UWORD8 pointer to the source
+*
+* @param[in] ref_strd
+*  integer reference stride
+*
+* @param[in] src_strd
+*  integer source stride
+*
+* @param[out] pi4_sad
+*  pointer to integer array evaluated sad
+*
+* @returns  sad at all evaluated vertexes
+*
+* @remarks  The fourth lane repeats the third candidate and is discarded
+*
+*******************************************************************************
+*/
+void ATTRIBUTE_AVX512BW ime_calculate_sad3_prog_avx512(UWORD8 *pu1_ref1,
+                                                       UWORD8 *pu1_ref2,
+                                                       UWORD8 *pu1_ref3,
+                                                       UWORD8 *pu1_src,
+                                                       WORD32 ref_strd,
+                                                       WORD32 src_strd,
+                                                       WORD32 *pi4_sad)
+{
+    __m512i src, ref, sad;
+    WORD32 ai4_sad[4];
+    WORD32 i;
+
+    sad = _mm512_setzero_si512();
+
+    for(i = 0; i < MB_SIZE; i++)
+    {
+        src = _mm512_broadcast_i32x4(_mm_loadu_si128((__m128i *) pu1_src));
+        ref = ime_load_4x16_avx512(pu1_ref1, pu1_ref2, pu1_ref3, pu1_ref3);
+
+        sad = _mm512_add_epi64(sad, _mm512_sad_epu8(src, ref));
+
+        pu1_src += src_strd;
+        pu1_ref1 += ref_strd;
+        pu1_ref2 += ref_strd;
+        pu1_ref3 += ref_strd;
+    }
+
+    ime_reduce_sad4_avx512(sad, ai4_sad);
+
+    pi4_sad[0] = ai4_sad[0];
+    pi4_sad[1] = ai4_sad[1];
+    pi4_sad[2] = ai4_sad[2];
+}
+
+/**
+******************************************************************************
+*
+* @brief computes distortion (SAD) at all subpel points about the src location
+*
+* @par Description
+*   This functions computes SAD at all points at a subpel distance from the
+*   current source location.
+*
+* @param[in] pu1_src
+*  UWORD8 pointer to the source
+*
+* @param[out] pu1_ref_half_x
+*  UWORD8 pointer to half pel buffer
+*
+* @param[out] pu1_ref_half_y
+*  UWORD8 pointer to half pel buffer
+*
+* @param[out] pu1_ref_half_xy
+*  UWORD8 pointer to half pel buffer
+*
+* @param[in] src_strd
+*  integer source stride
+*
+* @param[in] ref_strd
+*  integer ref stride
+*
+* @param[out] pi4_sad
+*  integer evaluated sad
+*  pi4_sad[0] - half x
+*  pi4_sad[1] - half x - 1
+*  pi4_sad[2] - half y
+*  pi4_sad[3] - half y - 1
+*  pi4_sad[4] - half xy
+*  pi4_sad[5] - half xy - 1
+*  pi4_sad[6] - half xy - strd
+*  pi4_sad[7] - half xy - 1 - strd
+*
+* @remarks
+*
+******************************************************************************
+*/
+void ATTRIBUTE_AVX512BW ime_sub_pel_compute_sad_16x16_avx512(UWORD8 *pu1_src,
+                                                             UWORD8 *pu1_ref_half_x,
+                                                             UWORD8 *pu1_ref_half_y,
+                                                             UWORD8 *pu1_ref_half_xy,
+                                                             WORD32 src_strd,
+                                                             WORD32 ref_strd,
+                                                             WORD32 *pi4_sad)
+{
+    UWORD8 *pu1_ref_half_x_left = pu1_ref_half_x - 1;
+    UWORD8 *pu1_ref_half_y_top = pu1_ref_half_y - ref_strd;
+    UWORD8 *pu1_ref_half_xy_left = pu1_ref_half_xy - 1;
+    UWORD8 *pu1_ref_half_xy_top = pu1_ref_half_xy - ref_strd;
+    UWORD8 *pu1_ref_half_xy_top_left = pu1_ref_half_xy - ref_strd - 1;
+
+    __m512i src, ref_half_x_y, ref_half_xy;
+    __m512i sad_half_x_y, sad_half_xy;
+    WORD32 i;
+
+    sad_half_x_y = _mm512_setzero_si512();
+    sad_half_xy = _mm512_setzero_si512();
+
+    for(i = 0; i < MB_SIZE; i++)
+    {
+        src = _mm512_broadcast_i32x4(_mm_loadu_si128((__m128i *) pu1_src));
+
+        ref_half_x_y = ime_load_4x16_avx512(pu1_ref_half_x,
+                                            pu1_ref_half_x_left,
+                                            pu1_ref_half_y,
+                                            pu1_ref_half_y_top);
+        ref_half_xy = ime_load_4x16_avx512(pu1_ref_half_xy,
+                                           pu1_ref_half_xy_left,
+                                           pu1_ref_half_xy_top,
+                                           pu1_ref_half_xy_top_left);
+
+        sad_half_x_y = _mm512_add_epi64(sad_half_x_y,
+                                        _mm512_sad_epu8(src, ref_half_x_y));
+        sad_half_xy = _mm512_add_epi64(sad_half_xy,
+                                       _mm512_sad_epu8(src, ref_half_xy));
+
+        pu1_src += src_strd;
+        pu1_ref_half_x += ref_strd;
+        pu1_ref_half_x_left += ref_strd;
+        pu1_ref_half_y += ref_strd;
+        pu1_ref_half_y_top += ref_strd;
+        pu1_ref_half_xy += ref_strd;
+        pu1_ref_half_xy_left += ref_strd;
+        pu1_ref_half_xy_top += ref_strd;
+        pu1_ref_half_xy_top_left += ref_strd;
+    }
+
+    ime_reduce_sad4_avx512(sad_half_x_y, &pi4_sad[0]);
+    ime_reduce_sad4_avx512(sad_half_xy, &pi4_sad[4]);
+}
@@ -35,6 +35,7 @@
 *  - ime_compute_sad_16x16_ea8_sse42()
 *  - ime_compute_sad_16x8_sse42()
 *  - ime_calculate_sad4_prog_sse42()
+*  - ime_calculate_sad8_horz_sse42()
 *  - ime_sub_pel_compute_sad_16x16_sse42()
 *  - ime_compute_satqd_16x16_lumainter_sse42()
 *
@@ -98,6 +99,7 @@
 *
 ******************************************************************************
 */
+ATTRIBUTE_SSE42
 void ime_compute_sad_16x16_sse42(UWORD8 *pu1_src,
                            UWORD8 *pu1_est,
                            WORD32 src_strd,
@@ -242,6 +244,7 @@ void ime_compute_sad_16x16_sse42(UWORD8 *pu1_src,
 *
 ******************************************************************************
 */
+ATTRIBUTE_SSE42
 void ime_compute_sad_16x8_sse42(UWORD8 *pu1_src,
                     UWORD8 *pu1_est,
                     WORD32 src_strd,
@@ -338,6 +341,7 @@ void ime_compute_sad_16x8_sse42(UWORD8 *pu1_src,
 *
 ******************************************************************************
 */
+ATTRIBUTE_SSE42
 void ime_compute_sad_16x16_ea8_sse42(UWORD8 *pu1_src,
                                UWORD8 *pu1_est,
                                WORD32 src_strd,
@@ -493,6 +497,7 @@ void ime_compute_sad_16x16_ea8_sse42(UWORD8 *pu1_src,
 *
 ******************************************************************************
 */
+ATTRIBUTE_SSE42
 void ime_compute_sad_16x16_fast_sse42(UWORD8 *pu1_src,
                                 UWORD8 *pu1_est,
                                 WORD32 src_strd,
@@ -594,6 +599,7 @@ void ime_compute_sad_16x16_fast_sse42(UWORD8 *pu1_src,
 *
 *******************************************************************************
 */
+ATTRIBUTE_SSE42
 void ime_calculate_sad4_prog_sse42(UWORD8 *pu1_ref,
                              UWORD8 *pu1_src,
                              WORD32 ref_strd,
@@ -985,6 +991,70 @@ void ime_calculate_sad4_prog_sse42(UWORD8 *pu1_ref,
     pi4_sad[3] = (val1 + val2);
 }
 
+/**
+*******************************************************************************
+*
+* @brief compute sad
+*
+* @par Description: This function computes the sad of a 16x16 source block at
+* eight horizontally adjacent positions starting at the reference pointer.
+* Every reference row is loaded once and mpsadbw matches each 4 pixel group of
+* the source row against all eight positions.
+*
+* @param[in] pu1_src
+*  UWORD8 pointer to the source
+*
+* @param[in] pu1_ref
+*  UWORD8 pointer to the left most reference position
+*
+* @param[in] src_strd
+*  integer source stride
+*
+* @param[in] ref_strd
+*  integer reference stride
+*
+* @param[out] pi4_sad
+*  pointer to integer array evaluated sad, one per position
+*
+* @returns  sad at all evaluated positions
+*
+* @remarks  reads 24 bytes of every reference row, sad of a row fits in 16 bits
+*
+*******************************************************************************
+*/
+ATTRIBUTE_SSE42
+void ime_calculate_sad8_horz_sse42(UWORD8 *pu1_src,
+                                   UWORD8 *pu1_ref,
+                                   WORD32 src_strd,
+                                   WORD32 ref_strd,
+                                   WORD32 *pi4_sad)
+{
+    __m128i src, ref_lo, ref_hi;
+    __m128i sad_8x16b = _mm_setzero_si128();
+    WORD32 i;
+
+    for(i = 0; i < MB_SIZE; i++)
+    {
+        src = _mm_loadu_si128((__m128i *) (pu1_src));
+        ref_lo = _mm_loadu_si128((__m128i *) (pu1_ref));
+        ref_hi = _mm_loadu_si128((__m128i *) (pu1_ref + 8));
+
+        /* source pixels 0-3, 4-7 against reference 0-10, 4-14 */
+        sad_8x16b = _mm_add_epi16(sad_8x16b, _mm_mpsadbw_epu8(ref_lo, src, 0));
+        sad_8x16b = _mm_add_epi16(sad_8x16b, _mm_mpsadbw_epu8(ref_lo, src, 5));
+        /* source pixels 8-11, 12-15 against reference 8-18, 12-22 */
+        sad_8x16b = _mm_add_epi16(sad_8x16b, _mm_mpsadbw_epu8(ref_hi, src, 2));
+        sad_8x16b = _mm_add_epi16(sad_8x16b, _mm_mpsadbw_epu8(ref_hi, src, 7));
+
+        pu1_src += src_strd;
+        pu1_ref += ref_strd;
+    }
+
+    _mm_storeu_si128((__m128i *) (pi4_sad), _mm_cvtepu16_epi32(sad_8x16b));
+    _mm_storeu_si128((__m128i *) (pi4_sad + 4),
+                     _mm_cvtepu16_epi32(_mm_srli_si128(sad_8x16b, 8)));
+}
+
 /**
 ******************************************************************************
 *
@@ -1027,6 +1097,7 @@ void ime_calculate_sad4_prog_sse42(UWORD8 *pu1_ref,
 *
 ******************************************************************************
 */
+ATTRIBUTE_SSE42
 void ime_sub_pel_compute_sad_16x16_sse42(UWORD8 *pu1_src,
                                    UWORD8 *pu1_ref_half_x,
                                    UWORD8 *pu1_ref_half_y,
@@ -1717,6 +1788,7 @@ void ime_sub_pel_compute_sad_16x16_sse42(UWORD8 *pu1_src,
 *
 ******************************************************************************
 */
+ATTRIBUTE_SSE42
 void ime_compute_satqd_16x16_lumainter_sse42(UWORD8 *pu1_src,
                                          UWORD8 *pu1_est,
                                          WORD32 src_strd,
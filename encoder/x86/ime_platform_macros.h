@@ -48,5 +48,17 @@
                 ABS(src[2]-est[2]) + \
                 ABS(src[3]-est[3])
 
+/* SSSE3 and SSE4.2 kernels are compiled per function so that only the */
+/* ISA specific sources require these extensions                       */
+#define ATTRIBUTE_SSSE3 __attribute__ ((target ("ssse3")))
+#define ATTRIBUTE_SSE42 __attribute__ ((target ("sse4.2")))
+
+/* AVX2 kernels are compiled per function so that the library as a whole */
+/* can still run on processors without AVX2 support                      */
+#define ATTRIBUTE_AVX2 __attribute__ ((target ("avx2")))
+
+/* AVX-512 kernels are compiled per function so that the library as a whole */
+/* can still run on processors without AVX-512 support                      */
+#define ATTRIBUTE_AVX512BW __attribute__ ((target ("avx512f,avx512bw")))
 
 #endif /* _IH264_PLATFORM_MACROS_H_ */
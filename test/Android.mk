@@ -4,5 +4,11 @@ include $(CLEAR_VARS)
 # encoder
 include $(LOCAL_PATH)/encoder.mk
 
+# encoder lookahead regression test
+include $(LOCAL_PATH)/lookahead.mk
+
 # decoder
 include $(LOCAL_PATH)/decoder.mk
+
+# decoder compact memory regression test
+include $(LOCAL_PATH)/compact_mem.mk
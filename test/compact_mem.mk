@@ -0,0 +1,8 @@
+LOCAL_PATH := $(call my-dir)
+include $(CLEAR_VARS)
+LOCAL_MODULE    := avcdec_compact_mem_test
+LOCAL_MODULE_TAGS := optional
+LOCAL_C_INCLUDES += $(LOCAL_PATH)/../decoder $(LOCAL_PATH)/../common
+LOCAL_SRC_FILES := compact_mem/main.c
+LOCAL_STATIC_LIBRARIES := libavcdec
+include $(BUILD_EXECUTABLE)
@@ -0,0 +1,733 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+
+/**
+*******************************************************************************
+* @file
+*  main.c
+*
+* @brief
+*  Regression test of the memory footprint of the decoder in compact memory
+*  mode
+*
+* @author
+*  ittiam
+*
+* @par List of Functions:
+*  - hash()
+*  - put_bits()
+*  - put_ue()
+*  - put_se()
+*  - put_trailing_bits()
+*  - put_nal()
+*  - gen_stream()
+*  - aligned_alloc_cb()
+*  - aligned_free_cb()
+*  - decode_stream()
+*  - main()
+*
+* @remarks
+*  A stream of I_PCM pictures is generated, once with and once without the
+*  bitstream restriction of the VUI. Each stream is decoded with and without
+*  compact memory mode, and the dynamic memory reported through
+*  IH264D_CMD_CTL_GET_MEM_FOOTPRINT is compared. Compact memory mode has to
+*  report less memory than the default mode, the stream signalling its DPB
+*  needs has to report less memory than the stream that leaves the DPB at the
+*  level limit, and every decoded picture has to match its PCM samples. The
+*  test prints PASS or FAIL and returns non zero on failure.
+*
+*******************************************************************************
+*/
+
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+/* System include files */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+
+/* User include files */
+#include "ih264_typedefs.h"
+#include "iv.h"
+#include "ivd.h"
+#include "ih264d.h"
+
+/*****************************************************************************/
+/* Constant Macros                                                           */
+/*****************************************************************************/
+
+#define TEST_WD             64
+#define TEST_HT             48
+#define TEST_NUM_PICS       4
+
+/** Size of the generated stream, enough for the PCM samples of all pictures */
+#define TEST_STREAM_SIZE    (TEST_NUM_PICS * TEST_WD * TEST_HT * 2 + 1024)
+
+/** I_PCM mb_type of an I slice */
+#define TEST_MB_TYPE_I_PCM  25
+
+/** Alignment of the memory handed to the decoder */
+#define TEST_MEM_ALIGN      128
+
+/*****************************************************************************/
+/* Structure Definitions                                                     */
+/*****************************************************************************/
+
+/** Bit writer of the stream generator */
+typedef struct
+{
+    /** Buffer the bits are written to */
+    UWORD8 *pu1_buf;
+
+    /** Number of bits written */
+    UWORD32 u4_num_bits;
+} bit_writer_t;
+
+/*****************************************************************************/
+/* Function Definitions                                                      */
+/*****************************************************************************/
+
+/**
+*******************************************************************************
+*
+* @brief Pseudo random sample of a position
+*
+* @param[in] u4_seed
+*  Seed selecting the picture and plane
+*
+* @param[in] i4_x
+*  Horizontal position
+*
+* @param[in] i4_y
+*  Vertical position
+*
+* @returns  sample in the range 16 to 235
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static UWORD8 hash(UWORD32 u4_seed, WORD32 i4_x, WORD32 i4_y)
+{
+    UWORD32 u4_val = ((UWORD32)i4_x * 73856093u) ^ ((UWORD32)i4_y * 19349663u)
+                    ^ (u4_seed * 83492791u);
+
+    u4_val ^= u4_val >> 13;
+    u4_val *= 0x5bd1e995u;
+    u4_val ^= u4_val >> 15;
+
+    return (UWORD8)(16 + u4_val % 220);
+}
+
+/**
+*******************************************************************************
+*
+* @brief Writes the low bits of a value, msb first
+*
+* @param[in] ps_bw
+*  Pointer to the bit writer
+*
+* @param[in] i4_num_bits
+*  Number of bits to write
+*
+* @param[in] u4_val
+*  Value to write
+*
+* @returns  none
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static void put_bits(bit_writer_t *ps_bw, WORD32 i4_num_bits, UWORD32 u4_val)
+{
+    WORD32 i;
+
+    for (i = i4_num_bits - 1; i >= 0; i--)
+    {
+        UWORD32 u4_byte = ps_bw->u4_num_bits >> 3;
+        UWORD32 u4_bit = 7 - (ps_bw->u4_num_bits & 7);
+
+        if (0 == (ps_bw->u4_num_bits & 7))
+            ps_bw->pu1_buf[u4_byte] = 0;
+
+        ps_bw->pu1_buf[u4_byte] |= ((u4_val >> i) & 1) << u4_bit;
+        ps_bw->u4_num_bits++;
+    }
+}
+
+/**
+*******************************************************************************
+*
+* @brief Writes an unsigned Exp-Golomb code
+*
+* @param[in] ps_bw
+*  Pointer to the bit writer
+*
+* @param[in] u4_val
+*  Value to write
+*
+* @returns  none
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static void put_ue(bit_writer_t *ps_bw, UWORD32 u4_val)
+{
+    WORD32 i4_len = 0;
+
+    u4_val++;
+    while ((u4_val >> i4_len) > 1)
+        i4_len++;
+
+    put_bits(ps_bw, i4_len, 0);
+    put_bits(ps_bw, i4_len + 1, u4_val);
+}
+
+/**
+*******************************************************************************
+*
+* @brief Writes a signed Exp-Golomb code
+*
+* @param[in] ps_bw
+*  Pointer to the bit writer
+*
+* @param[in] i4_val
+*  Value to write
+*
+* @returns  none
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static void put_se(bit_writer_t *ps_bw, WORD32 i4_val)
+{
+    put_ue(ps_bw, (i4_val > 0) ? (2 * i4_val - 1) : (-2 * i4_val));
+}
+
+/**
+*******************************************************************************
+*
+* @brief Writes the rbsp trailing bits
+*
+* @param[in] ps_bw
+*  Pointer to the bit writer
+*
+* @returns  none
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static void put_trailing_bits(bit_writer_t *ps_bw)
+{
+    put_bits(ps_bw, 1, 1);
+    while (ps_bw->u4_num_bits & 7)
+        put_bits(ps_bw, 1, 0);
+}
+
+/**
+*******************************************************************************
+*
+* @brief Writes a NAL unit with start code and emulation prevention
+*
+* @param[out] pu1_out
+*  Stream buffer
+*
+* @param[in] i4_nal_type
+*  NAL unit type
+*
+* @param[in] ps_bw
+*  Bit writer holding the rbsp
+*
+* @returns  number of bytes written
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static WORD32 put_nal(UWORD8 *pu1_out, WORD32 i4_nal_type, bit_writer_t *ps_bw)
+{
+    WORD32 i4_len = 0;
+    WORD32 i4_zeros = 0;
+    UWORD32 i;
+
+    pu1_out[i4_len++] = 0;
+    pu1_out[i4_len++] = 0;
+    pu1_out[i4_len++] = 0;
+    pu1_out[i4_len++] = 1;
+    pu1_out[i4_len++] = (3 << 5) | i4_nal_type;
+
+    for (i = 0; i < (ps_bw->u4_num_bits >> 3); i++)
+    {
+        UWORD8 u1_byte = ps_bw->pu1_buf[i];
+
+        if ((i4_zeros >= 2) && (u1_byte <= 3))
+        {
+            pu1_out[i4_len++] = 3;
+            i4_zeros = 0;
+        }
+        pu1_out[i4_len++] = u1_byte;
+        i4_zeros = (0 == u1_byte) ? (i4_zeros + 1) : 0;
+    }
+
+    return i4_len;
+}
+
+/**
+*******************************************************************************
+*
+* @brief Generates a baseline stream of IDR pictures of I_PCM macroblocks
+*
+* @param[out] pu1_stream
+*  Stream buffer of TEST_STREAM_SIZE bytes
+*
+* @param[in] u4_vui_restriction
+*  Flag to signal num_reorder_frames and max_dec_frame_buffering in the VUI
+*
+* @returns  size of the stream in bytes
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static WORD32 gen_stream(UWORD8 *pu1_stream, UWORD32 u4_vui_restriction)
+{
+    bit_writer_t s_bw;
+    UWORD8 *pu1_rbsp;
+    WORD32 i4_size = 0;
+    WORD32 i4_pic, i4_mb_x, i4_mb_y, x, y;
+
+    pu1_rbsp = malloc(TEST_STREAM_SIZE);
+    if (NULL == pu1_rbsp)
+    {
+        printf("Allocation failed\n");
+        exit(-1);
+    }
+    s_bw.pu1_buf = pu1_rbsp;
+
+    /* SPS: baseline, level 3.0, one reference frame, POC type 2 */
+    s_bw.u4_num_bits = 0;
+    put_bits(&s_bw, 8, 66);
+    put_bits(&s_bw, 8, 0);
+    put_bits(&s_bw, 8, 30);
+    put_ue(&s_bw, 0);
+    put_ue(&s_bw, 0);
+    put_ue(&s_bw, 2);
+    put_ue(&s_bw, 1);
+    put_bits(&s_bw, 1, 0);
+    put_ue(&s_bw, TEST_WD / 16 - 1);
+    put_ue(&s_bw, TEST_HT / 16 - 1);
+    put_bits(&s_bw, 1, 1);
+    put_bits(&s_bw, 1, 1);
+    put_bits(&s_bw, 1, 0);
+    put_bits(&s_bw, 1, u4_vui_restriction);
+    if (u4_vui_restriction)
+    {
+        /* no aspect ratio, overscan, signal type, chroma location, timing */
+        /* or hrd information, and no pic_struct                           */
+        put_bits(&s_bw, 8, 0);
+        put_bits(&s_bw, 1, 1);
+        put_bits(&s_bw, 1, 1);
+        put_ue(&s_bw, 2);
+        put_ue(&s_bw, 1);
+        put_ue(&s_bw, 16);
+        put_ue(&s_bw, 16);
+        /* num_reorder_frames and max_dec_frame_buffering */
+        put_ue(&s_bw, 0);
+        put_ue(&s_bw, 1);
+    }
+    put_trailing_bits(&s_bw);
+    i4_size += put_nal(pu1_stream + i4_size, 7, &s_bw);
+
+    /* PPS: CAVLC, deblocking control present */
+    s_bw.u4_num_bits = 0;
+    put_ue(&s_bw, 0);
+    put_ue(&s_bw, 0);
+    put_bits(&s_bw, 1, 0);
+    put_bits(&s_bw, 1, 0);
+    put_ue(&s_bw, 0);
+    put_ue(&s_bw, 0);
+    put_ue(&s_bw, 0);
+    put_bits(&s_bw, 1, 0);
+    put_bits(&s_bw, 2, 0);
+    put_se(&s_bw, 0);
+    put_se(&s_bw, 0);
+    put_se(&s_bw, 0);
+    put_bits(&s_bw, 1, 1);
+    put_bits(&s_bw, 1, 0);
+    put_bits(&s_bw, 1, 0);
+    put_trailing_bits(&s_bw);
+    i4_size += put_nal(pu1_stream + i4_size, 8, &s_bw);
+
+    for (i4_pic = 0; i4_pic < TEST_NUM_PICS; i4_pic++)
+    {
+        /* IDR slice header, deblocking disabled */
+        s_bw.u4_num_bits = 0;
+        put_ue(&s_bw, 0);
+        put_ue(&s_bw, 7);
+        put_ue(&s_bw, 0);
+        put_bits(&s_bw, 4, 0);
+        put_ue(&s_bw, i4_pic & 1);
+        put_bits(&s_bw, 1, 0);
+        put_bits(&s_bw, 1, 0);
+        put_se(&s_bw, 0);
+        put_ue(&s_bw, 1);
+
+        for (i4_mb_y = 0; i4_mb_y < TEST_HT / 16; i4_mb_y++)
+        {
+            for (i4_mb_x = 0; i4_mb_x < TEST_WD / 16; i4_mb_x++)
+            {
+                WORD32 i4_plane;
+
+                put_ue(&s_bw, TEST_MB_TYPE_I_PCM);
+                while (s_bw.u4_num_bits & 7)
+                    put_bits(&s_bw, 1, 0);
+
+                for (y = 0; y < 16; y++)
+                    for (x = 0; x < 16; x++)
+                        put_bits(&s_bw, 8, hash(3 * i4_pic, i4_mb_x * 16 + x,
+                                                i4_mb_y * 16 + y));
+
+                for (i4_plane = 1; i4_plane < 3; i4_plane++)
+                    for (y = 0; y < 8; y++)
+                        for (x = 0; x < 8; x++)
+                            put_bits(&s_bw, 8, hash(3 * i4_pic + i4_plane,
+                                                    i4_mb_x * 8 + x,
+                                                    i4_mb_y * 8 + y));
+            }
+        }
+        put_trailing_bits(&s_bw);
+        i4_size += put_nal(pu1_stream + i4_size, 5, &s_bw);
+    }
+
+    free(pu1_rbsp);
+
+    return i4_size;
+}
+
+/**
+*******************************************************************************
+*
+* @brief Aligned allocation callback of the decoder
+*
+* @param[in] pv_ctxt
+*  Memory context, unused
+*
+* @param[in] alignment
+*  Alignment requested by the decoder
+*
+* @param[in] i4_size
+*  Size of the allocation in bytes
+*
+* @returns  pointer to the memory, NULL on failure
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static void *aligned_alloc_cb(void *pv_ctxt, WORD32 alignment, WORD32 i4_size)
+{
+    void *pv_buf = NULL;
+
+    (void)pv_ctxt;
+    if (alignment < TEST_MEM_ALIGN)
+        alignment = TEST_MEM_ALIGN;
+
+    if (0 != posix_memalign(&pv_buf, alignment, i4_size))
+        return NULL;
+
+    return pv_buf;
+}
+
+/**
+*******************************************************************************
+*
+* @brief Free callback of the decoder
+*
+* @param[in] pv_ctxt
+*  Memory context, unused
+*
+* @param[in] pv_buf
+*  Memory to free
+*
+* @returns  none
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static void aligned_free_cb(void *pv_ctxt, void *pv_buf)
+{
+    (void)pv_ctxt;
+    free(pv_buf);
+}
+
+/**
+*******************************************************************************
+*
+* @brief Decodes a stream and checks the output against the PCM samples
+*
+* @param[in] pu1_stream
+*  Stream to decode
+*
+* @param[in] i4_stream_size
+*  Size of the stream in bytes
+*
+* @param[in] u4_compact_mem
+*  Flag to enable compact memory mode
+*
+* @param[out] pu4_dyn_mem_size
+*  Dynamic memory reported by the decoder
+*
+* @returns  number of errors
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static WORD32 decode_stream(UWORD8 *pu1_stream, WORD32 i4_stream_size,
+                            UWORD32 u4_compact_mem, UWORD32 *pu4_dyn_mem_size)
+{
+    ih264d_create_ip_t s_create_ip;
+    ih264d_create_op_t s_create_op;
+    ivd_ctl_set_config_ip_t s_ctl_ip;
+    ivd_ctl_set_config_op_t s_ctl_op;
+    ivd_video_decode_ip_t s_dec_ip;
+    ivd_video_decode_op_t s_dec_op;
+    ih264d_ctl_get_mem_footprint_ip_t s_mem_ip;
+    ih264d_ctl_get_mem_footprint_op_t s_mem_op;
+    ivd_ctl_flush_ip_t s_flush_ip;
+    ivd_ctl_flush_op_t s_flush_op;
+    ivd_delete_ip_t s_delete_ip;
+    ivd_delete_op_t s_delete_op;
+    iv_obj_t *ps_codec;
+    UWORD8 *pu1_out;
+    WORD32 i4_num_errors = 0;
+    WORD32 i4_num_out = 0;
+    WORD32 i4_flush = 0;
+    IV_API_CALL_STATUS_T e_ret;
+
+    pu1_out = malloc(TEST_WD * TEST_HT * 3 / 2);
+    if (NULL == pu1_out)
+    {
+        printf("Allocation failed\n");
+        exit(-1);
+    }
+
+    memset(&s_create_ip, 0, sizeof(s_create_ip));
+    memset(&s_create_op, 0, sizeof(s_create_op));
+    s_create_ip.s_ivd_create_ip_t.e_cmd = IVD_CMD_CREATE;
+    s_create_ip.s_ivd_create_ip_t.e_output_format = IV_YUV_420P;
+    s_create_ip.s_ivd_create_ip_t.pf_aligned_alloc = aligned_alloc_cb;
+    s_create_ip.s_ivd_create_ip_t.pf_aligned_free = aligned_free_cb;
+    s_create_ip.s_ivd_create_ip_t.u4_size = sizeof(ih264d_create_ip_t);
+    s_create_ip.u4_enable_compact_mem = u4_compact_mem;
+    s_create_op.s_ivd_create_op_t.u4_size = sizeof(ih264d_create_op_t);
+
+    e_ret = ih264d_api_function(NULL, &s_create_ip, &s_create_op);
+    if (IV_SUCCESS != e_ret)
+    {
+        printf("Create failed 0x%x\n", s_create_op.s_ivd_create_op_t.u4_error_code);
+        exit(-1);
+    }
+    ps_codec = (iv_obj_t *)s_create_op.s_ivd_create_op_t.pv_handle;
+    ps_codec->pv_fxns = (void *)ih264d_api_function;
+    ps_codec->u4_size = sizeof(iv_obj_t);
+
+    s_ctl_ip.u4_disp_wd = 0;
+    s_ctl_ip.e_frm_skip_mode = IVD_SKIP_NONE;
+    s_ctl_ip.e_frm_out_mode = IVD_DISPLAY_FRAME_OUT;
+    s_ctl_ip.e_vid_dec_mode = IVD_DECODE_FRAME;
+    s_ctl_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+    s_ctl_ip.e_sub_cmd = IVD_CMD_CTL_SETPARAMS;
+    s_ctl_ip.u4_size = sizeof(ivd_ctl_set_config_ip_t);
+    s_ctl_op.u4_size = sizeof(ivd_ctl_set_config_op_t);
+    ih264d_api_function(ps_codec, &s_ctl_ip, &s_ctl_op);
+
+    while ((i4_stream_size > 0) || i4_flush)
+    {
+        WORD32 x, y;
+
+        s_dec_ip.e_cmd = IVD_CMD_VIDEO_DECODE;
+        s_dec_ip.u4_ts = 0;
+        s_dec_ip.pv_stream_buffer = pu1_stream;
+        s_dec_ip.u4_num_Bytes = i4_stream_size;
+        s_dec_ip.u4_size = sizeof(ivd_video_decode_ip_t);
+        s_dec_ip.s_out_buffer.u4_num_bufs = 3;
+        s_dec_ip.s_out_buffer.pu1_bufs[0] = pu1_out;
+        s_dec_ip.s_out_buffer.pu1_bufs[1] = pu1_out + TEST_WD * TEST_HT;
+        s_dec_ip.s_out_buffer.pu1_bufs[2] = pu1_out + TEST_WD * TEST_HT * 5 / 4;
+        s_dec_ip.s_out_buffer.u4_min_out_buf_size[0] = TEST_WD * TEST_HT;
+        s_dec_ip.s_out_buffer.u4_min_out_buf_size[1] = TEST_WD * TEST_HT / 4;
+        s_dec_ip.s_out_buffer.u4_min_out_buf_size[2] = TEST_WD * TEST_HT / 4;
+        s_dec_op.u4_size = sizeof(ivd_video_decode_op_t);
+
+        e_ret = ih264d_api_function(ps_codec, &s_dec_ip, &s_dec_op);
+
+        if (!i4_flush)
+        {
+            pu1_stream += s_dec_op.u4_num_bytes_consumed;
+            i4_stream_size -= s_dec_op.u4_num_bytes_consumed;
+            if ((IV_SUCCESS != e_ret) || (0 == s_dec_op.u4_num_bytes_consumed))
+            {
+                printf("Decode failed 0x%x\n", s_dec_op.u4_error_code);
+                i4_num_errors++;
+                break;
+            }
+        }
+        else if (IV_SUCCESS != e_ret)
+        {
+            break;
+        }
+
+        if (s_dec_op.u4_output_present)
+        {
+            iv_yuv_buf_t *ps_disp = &s_dec_op.s_disp_frm_buf;
+            UWORD8 *apu1_plane[3];
+            UWORD32 au4_strd[3];
+            WORD32 i4_plane;
+
+            apu1_plane[0] = ps_disp->pv_y_buf;
+            apu1_plane[1] = ps_disp->pv_u_buf;
+            apu1_plane[2] = ps_disp->pv_v_buf;
+            au4_strd[0] = ps_disp->u4_y_strd;
+            au4_strd[1] = ps_disp->u4_u_strd;
+            au4_strd[2] = ps_disp->u4_v_strd;
+
+            for (i4_plane = 0; i4_plane < 3; i4_plane++)
+            {
+                WORD32 i4_shift = (i4_plane > 0);
+                WORD32 i4_mismatch = 0;
+
+                for (y = 0; y < (TEST_HT >> i4_shift); y++)
+                    for (x = 0; x < (TEST_WD >> i4_shift); x++)
+                        i4_mismatch |= apu1_plane[i4_plane][y * au4_strd[i4_plane] + x]
+                                        != hash(3 * i4_num_out + i4_plane, x, y);
+
+                if (i4_mismatch)
+                {
+                    printf("Picture %d, plane %d: output differs from the PCM samples\n",
+                           i4_num_out, i4_plane);
+                    i4_num_errors++;
+                }
+            }
+            i4_num_out++;
+        }
+
+        if ((i4_stream_size <= 0) && !i4_flush)
+        {
+            s_flush_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+            s_flush_ip.e_sub_cmd = IVD_CMD_CTL_FLUSH;
+            s_flush_ip.u4_size = sizeof(ivd_ctl_flush_ip_t);
+            s_flush_op.u4_size = sizeof(ivd_ctl_flush_op_t);
+            ih264d_api_function(ps_codec, &s_flush_ip, &s_flush_op);
+            i4_flush = 1;
+        }
+    }
+
+    if (TEST_NUM_PICS != i4_num_out)
+    {
+        printf("%d pictures decoded, expected %d\n", i4_num_out, TEST_NUM_PICS);
+        i4_num_errors++;
+    }
+
+    s_mem_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+    s_mem_ip.e_sub_cmd = (IVD_CONTROL_API_COMMAND_TYPE_T)IH264D_CMD_CTL_GET_MEM_FOOTPRINT;
+    s_mem_ip.u4_size = sizeof(ih264d_ctl_get_mem_footprint_ip_t);
+    s_mem_op.u4_size = sizeof(ih264d_ctl_get_mem_footprint_op_t);
+    e_ret = ih264d_api_function(ps_codec, &s_mem_ip, &s_mem_op);
+    if (IV_SUCCESS != e_ret)
+    {
+        printf("Memory footprint query failed\n");
+        i4_num_errors++;
+    }
+    *pu4_dyn_mem_size = s_mem_op.u4_dynamic_mem_size;
+
+    s_delete_ip.e_cmd = IVD_CMD_DELETE;
+    s_delete_ip.u4_size = sizeof(ivd_delete_ip_t);
+    s_delete_op.u4_size = sizeof(ivd_delete_op_t);
+    ih264d_api_function(ps_codec, &s_delete_ip, &s_delete_op);
+
+    free(pu1_out);
+
+    return i4_num_errors;
+}
+
+int main(int argc, char *argv[])
+{
+    UWORD8 *pu1_stream;
+    UWORD32 au4_dyn_mem_size[2][2];
+    WORD32 i4_num_errors = 0;
+    UWORD32 u4_vui, u4_compact_mem;
+
+    (void)argc;
+    (void)argv;
+
+    pu1_stream = malloc(TEST_STREAM_SIZE);
+    if (NULL == pu1_stream)
+    {
+        printf("Allocation failed\n");
+        exit(-1);
+    }
+
+    for (u4_vui = 0; u4_vui < 2; u4_vui++)
+    {
+        WORD32 i4_stream_size = gen_stream(pu1_stream, u4_vui);
+
+        for (u4_compact_mem = 0; u4_compact_mem < 2; u4_compact_mem++)
+        {
+            i4_num_errors += decode_stream(pu1_stream, i4_stream_size, u4_compact_mem,
+                                           &au4_dyn_mem_size[u4_vui][u4_compact_mem]);
+            printf("VUI restriction %d, compact memory %d: %u bytes\n", u4_vui,
+                   u4_compact_mem, au4_dyn_mem_size[u4_vui][u4_compact_mem]);
+        }
+
+        /* compact memory mode shrinks the per picture and per row buffers */
+        if (au4_dyn_mem_size[u4_vui][1] >= au4_dyn_mem_size[u4_vui][0])
+        {
+            printf("VUI restriction %d: compact memory mode does not save memory\n",
+                   u4_vui);
+            i4_num_errors++;
+        }
+    }
+
+    /*
+     * Without the bitstream restriction the pictures are held for the DPB size
+     * of the level. The restriction lets the decoder size the picture buffers
+     * and the MV bank from num_reorder_frames and num_ref_frames
+     */
+    if (au4_dyn_mem_size[1][1] >= au4_dyn_mem_size[0][1])
+    {
+        printf("The VUI restriction does not reduce the memory of compact mode\n");
+        i4_num_errors++;
+    }
+
+    free(pu1_stream);
+
+    printf("%s\n", i4_num_errors ? "FAIL" : "PASS");
+
+    return i4_num_errors ? -1 : 0;
+}
@@ -75,6 +75,7 @@
 #define ENABLE_DEGRADE 0
 #define MAX_DISP_BUFFERS    64
 #define EXTRA_DISP_BUFFERS  8
+#define MAX_BATCH_SIZE      16
 #define STRLENGTH 1000
 
 //#define TEST_FLUSH
@@ -199,6 +200,22 @@ typedef struct
     WORD32 i4_degrade_type;
     WORD32 i4_degrade_pics;
     UWORD32 u4_num_cores;
+    UWORD32 u4_compact_mem;
+    UWORD32 u4_fused_fmt_conv;
+    UWORD32 u4_disp_handles;
+    UWORD32 u4_pool_max_wd;
+    UWORD32 u4_pool_max_ht;
+    UWORD32 u4_seek_frame;
+    UWORD32 u4_batch_size;
+    UWORD32 u4_batch_num_done;
+    UWORD32 u4_batch_next;
+    ivd_out_bufdesc_t s_batch_out_bufs[MAX_BATCH_SIZE];
+    ih264d_video_decode_ip_t s_batch_decode_ip[MAX_BATCH_SIZE];
+    ih264d_video_decode_op_t s_batch_decode_op[MAX_BATCH_SIZE];
+    UWORD32 u4_csc_matrix;
+    UWORD32 u4_csc_full_range;
+    UWORD32 u4_scale_shift;
+    UWORD32 u4_scale_filter;
     UWORD32 disp_delay;
     WORD32 trace_enable;
     CHAR ac_trace_fname[STRLENGTH];
@@ -262,6 +279,17 @@ typedef enum
     NUM_CORES,
     DISABLE_DEBLOCK_LEVEL,
     SHARE_DISPLAY_BUF,
+    COMPACT_MEM,
+    FUSED_FMT_CONV,
+    DISP_HANDLES,
+    POOL_MAX_WD,
+    POOL_MAX_HT,
+    SEEK_FRAME,
+    BATCH_SIZE,
+    CSC_MATRIX,
+    CSC_FULL_RANGE,
+    SCALE_SHIFT,
+    SCALE_FILTER,
     LOOPBACK,
     DISPLAY,
     FULLSCREEN,
@@ -309,13 +337,35 @@ static const argument_t argument_mapping[] =
     { "--", "--save_chksum",            SAVE_CHKSUM,
           "Save Check sum file\n" },
     {"--",  "--chroma_format",          CHROMA_FORMAT,
-         "Output Chroma format Supported values YUV_420P, YUV_422ILE, RGB_565, YUV_420SP_UV, YUV_420SP_VU\n" },
+         "Output Chroma format Supported values YUV_420P, YUV_422P, YUV_422ILE, RGB_565, YUV_420SP_UV, YUV_420SP_VU\n" },
     { "-n", "--num_frames",             NUM_FRAMES,
          "Number of frames to be decoded\n" },
     { "--", "--num_cores",              NUM_CORES,
           "Number of cores to be used\n" },
     { "--", "--share_display_buf",      SHARE_DISPLAY_BUF,
           "Enable shared display buffer mode\n" },
+    { "--", "--compact_mem",            COMPACT_MEM,
+          "Enable compact memory mode (single thread, minimal buffering)\n" },
+    { "--", "--fused_fmt_conv",         FUSED_FMT_CONV,
+          "Convert output format while deblocking (outputs in decode order)\n" },
+    { "--", "--disp_handles",           DISP_HANDLES,
+          "Output 420SP_UV pictures in place, released after dumping\n" },
+    { "--", "--pool_max_wd",            POOL_MAX_WD,
+          "Width the buffer pool is sized for (0 disables the pool)\n" },
+    { "--", "--pool_max_ht",            POOL_MAX_HT,
+          "Height the buffer pool is sized for (0 disables the pool)\n" },
+    { "--", "--seek_frame",             SEEK_FRAME,
+          "Seek back to the start of the stream before this input frame (0 disables)\n" },
+    { "--", "--batch_size",             BATCH_SIZE,
+          "Number of access units decoded per decode batch call (1 disables)\n" },
+    { "--", "--csc_matrix",             CSC_MATRIX,
+          "YUV to RGB matrix for RGB outputs : 0 Default 1 BT.601 2 BT.709 3 From VUI\n" },
+    { "--", "--csc_full_range",         CSC_FULL_RANGE,
+          "YUV samples use full range for csc_matrix 1 and 2\n" },
+    { "--", "--scale_shift",            SCALE_SHIFT,
+          "Downscale output by 1 << scale_shift (0 to 3)\n" },
+    { "--", "--scale_filter",           SCALE_FILTER,
+          "Downscale filter : 0 Box 1 Bilinear\n" },
     {"--", "--disable_deblock_level", DISABLE_DEBLOCK_LEVEL,
          "Disable deblocking level : 0 to 4 - 0 Enable deblocking 4 Disable deblocking completely\n"},
     { "--", "--loopback",      LOOPBACK,
@@ -921,15 +971,21 @@ void dump_output(vid_dec_ctx_t *ps_app_ctx,
         u4_disp_id = u4_disp_frm_id;
     }
 
-    release_disp_frame(ps_app_ctx->cocodec_obj, u4_disp_id);
+    /* A display handle points into the decoder's own picture, it is */
+    /* released only once the picture has been written out           */
+    if(0 == ps_app_ctx->u4_disp_handles)
+        release_disp_frame(ps_app_ctx->cocodec_obj, u4_disp_id);
 
-    if(0 == file_save && 0 == chksum_save)
-        return;
-
-    if(NULL == s_dump_disp_frm_buf.pv_y_buf)
+    if((0 == file_save && 0 == chksum_save)
+                    || (NULL == s_dump_disp_frm_buf.pv_y_buf))
+    {
+        if(ps_app_ctx->u4_disp_handles)
+            release_disp_frame(ps_app_ctx->cocodec_obj, u4_disp_id);
         return;
+    }
 
-    if(ps_app_ctx->e_output_chroma_format == IV_YUV_420P)
+    if((ps_app_ctx->e_output_chroma_format == IV_YUV_420P)
+                    || (ps_app_ctx->e_output_chroma_format == IV_YUV_422P))
     {
 #if DUMP_SINGLE_BUF
         {
@@ -1051,6 +1107,8 @@ void dump_output(vid_dec_ctx_t *ps_app_ctx,
     fflush(ps_op_file);
     fflush(ps_op_chksum_file);
 
+    if(ps_app_ctx->u4_disp_handles)
+        release_disp_frame(ps_app_ctx->cocodec_obj, u4_disp_id);
 }
 
 
@@ -1191,6 +1249,8 @@ void parse_argument(vid_dec_ctx_t *ps_app_ctx, CHAR *argument, CHAR *value)
         case CHROMA_FORMAT:
             if((strcmp(value, "YUV_420P")) == 0)
                 ps_app_ctx->e_output_chroma_format = IV_YUV_420P;
+            else if((strcmp(value, "YUV_422P")) == 0)
+                ps_app_ctx->e_output_chroma_format = IV_YUV_422P;
             else if((strcmp(value, "YUV_422ILE")) == 0)
                 ps_app_ctx->e_output_chroma_format = IV_YUV_422ILE;
             else if((strcmp(value, "RGB_565")) == 0)
@@ -1224,6 +1284,39 @@ void parse_argument(vid_dec_ctx_t *ps_app_ctx, CHAR *argument, CHAR *value)
         case SHARE_DISPLAY_BUF:
             sscanf(value, "%d", &ps_app_ctx->u4_share_disp_buf);
             break;
+        case COMPACT_MEM:
+            sscanf(value, "%d", &ps_app_ctx->u4_compact_mem);
+            break;
+        case FUSED_FMT_CONV:
+            sscanf(value, "%d", &ps_app_ctx->u4_fused_fmt_conv);
+            break;
+        case DISP_HANDLES:
+            sscanf(value, "%d", &ps_app_ctx->u4_disp_handles);
+            break;
+        case POOL_MAX_WD:
+            sscanf(value, "%d", &ps_app_ctx->u4_pool_max_wd);
+            break;
+        case POOL_MAX_HT:
+            sscanf(value, "%d", &ps_app_ctx->u4_pool_max_ht);
+            break;
+        case SEEK_FRAME:
+            sscanf(value, "%d", &ps_app_ctx->u4_seek_frame);
+            break;
+        case BATCH_SIZE:
+            sscanf(value, "%d", &ps_app_ctx->u4_batch_size);
+            break;
+        case CSC_MATRIX:
+            sscanf(value, "%d", &ps_app_ctx->u4_csc_matrix);
+            break;
+        case CSC_FULL_RANGE:
+            sscanf(value, "%d", &ps_app_ctx->u4_csc_full_range);
+            break;
+        case SCALE_SHIFT:
+            sscanf(value, "%d", &ps_app_ctx->u4_scale_shift);
+            break;
+        case SCALE_FILTER:
+            sscanf(value, "%d", &ps_app_ctx->u4_scale_filter);
+            break;
         case LOOPBACK:
             sscanf(value, "%d", &ps_app_ctx->loopback);
             break;
@@ -1620,6 +1713,177 @@ void output_write_stall(CHAR *fname, UWORD32 cur_frm_idx)
     }
 }
 
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : get_complete_pictures                                    */
+/*                                                                           */
+/*  Description   : Finds the part of the bitstream buffer that only holds   */
+/*                  complete pictures. Unless the buffer ends the stream,    */
+/*                  the picture starting last may be cut by the end of the   */
+/*                  buffer and is left out. A picture starts at a slice NAL  */
+/*                  whose first_mb_in_slice is 0                             */
+/*                                                                           */
+/*  Inputs        : pu1_buf, u4_num_bytes, u4_end_of_stream                  */
+/*  Outputs       : pu4_num_pics - Number of pictures in the returned bytes  */
+/*  Returns       : Number of bytes holding complete pictures                */
+/*                                                                           */
+/*****************************************************************************/
+UWORD32 get_complete_pictures(UWORD8 *pu1_buf,
+                              UWORD32 u4_num_bytes,
+                              UWORD32 u4_end_of_stream,
+                              UWORD32 *pu4_num_pics)
+{
+    UWORD32 i, u4_last_pic_start = 0, u4_num_pics = 0;
+
+    for(i = 0; i + 4 < u4_num_bytes; i++)
+    {
+        if((0 == pu1_buf[i]) && (0 == pu1_buf[i + 1]) && (1 == pu1_buf[i + 2]))
+        {
+            UWORD8 u1_nal_type = pu1_buf[i + 3] & 0x1F;
+
+            if(((1 == u1_nal_type) || (5 == u1_nal_type)) && (pu1_buf[i + 4] & 0x80))
+            {
+                u4_last_pic_start = i;
+                u4_num_pics++;
+            }
+            i += 2;
+        }
+    }
+
+    if(u4_end_of_stream)
+    {
+        *pu4_num_pics = u4_num_pics;
+        return u4_num_bytes;
+    }
+
+    *pu4_num_pics = (u4_num_pics > 0) ? (u4_num_pics - 1) : 0;
+    return u4_last_pic_start;
+}
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Function Name : decode_batched                                           */
+/*                                                                           */
+/*  Description   : Replacement for the IVD_CMD_VIDEO_DECODE call that goes  */
+/*                  through IH264D_CMD_CTL_DECODE_BATCH. When no decoded     */
+/*                  access unit is pending, up to u4_batch_size access units */
+/*                  starting at the current bitstream buffer are decoded in  */
+/*                  one call, each into its own output buffer. Only complete */
+/*                  pictures of the buffer are chained. Every call then      */
+/*                  returns the output of the next pending access unit       */
+/*                                                                           */
+/*  Inputs        : codec_obj, ps_app_ctx, ps_video_decode_ip, u4_ip_buf_len */
+/*  Outputs       : ps_video_decode_op                                       */
+/*  Returns       : IV_SUCCESS / IV_FAIL as the single decode call would     */
+/*                                                                           */
+/*****************************************************************************/
+WORD32 decode_batched(iv_obj_t *codec_obj,
+                      vid_dec_ctx_t *ps_app_ctx,
+                      ivd_video_decode_ip_t *ps_video_decode_ip,
+                      ivd_video_decode_op_t *ps_video_decode_op,
+                      UWORD32 u4_ip_buf_len)
+{
+    ivd_video_decode_op_t *ps_op;
+    WORD32 ret;
+    UWORD32 i;
+
+    if(ps_app_ctx->u4_batch_next == ps_app_ctx->u4_batch_num_done)
+    {
+        ih264d_ctl_decode_batch_ip_t s_ctl_ip;
+        ih264d_ctl_decode_batch_op_t s_ctl_op;
+        UWORD32 u4_num_bytes, u4_num_pics, u4_num_au;
+
+        u4_num_bytes = get_complete_pictures(
+                        (UWORD8 *)ps_video_decode_ip->pv_stream_buffer,
+                        ps_video_decode_ip->u4_num_Bytes,
+                        ps_video_decode_ip->u4_num_Bytes < u4_ip_buf_len,
+                        &u4_num_pics);
+
+        u4_num_au = ps_app_ctx->u4_batch_size;
+        if(u4_num_au > u4_num_pics)
+            u4_num_au = u4_num_pics;
+        if((0 == u4_num_au) || (0 == u4_num_bytes))
+        {
+            u4_num_au = 1;
+            u4_num_bytes = ps_video_decode_ip->u4_num_Bytes;
+        }
+
+        for(i = 0; i < u4_num_au; i++)
+        {
+            ivd_video_decode_ip_t *ps_ip =
+                            &ps_app_ctx->s_batch_decode_ip[i].s_ivd_video_decode_ip_t;
+            ivd_out_bufdesc_t *ps_out = &ps_app_ctx->s_batch_out_bufs[i];
+
+            /* Output buffers are allocated on first use, sized as the
+             * application's own output buffer */
+            if(NULL == ps_out->pu1_bufs[0])
+            {
+                ivd_out_bufdesc_t *ps_ref = &ps_video_decode_ip->s_out_buffer;
+                UWORD32 outlen = 0, j;
+
+                for(j = 0; j < ps_ref->u4_num_bufs; j++)
+                    outlen += ps_ref->u4_min_out_buf_size[j];
+
+                *ps_out = *ps_ref;
+                ps_out->pu1_bufs[0] = (UWORD8 *)malloc(outlen);
+                if(NULL == ps_out->pu1_bufs[0])
+                {
+                    CHAR ac_error_str[STRLENGTH];
+                    sprintf(ac_error_str,
+                            "\nAllocation failure for batch output buffer of i4_size %d",
+                            outlen);
+                    codec_exit(ac_error_str);
+                }
+                for(j = 1; j < ps_ref->u4_num_bufs; j++)
+                    ps_out->pu1_bufs[j] = ps_out->pu1_bufs[j - 1]
+                                    + ps_ref->u4_min_out_buf_size[j - 1];
+            }
+
+            /* The first entry decodes the current buffer, the others
+             * continue from where the previous entry stopped */
+            *ps_ip = *ps_video_decode_ip;
+            ps_ip->u4_ts = ps_video_decode_ip->u4_ts + i;
+            ps_ip->s_out_buffer = *ps_out;
+            ps_ip->u4_num_Bytes = u4_num_bytes;
+            if(i > 0)
+            {
+                ps_ip->pv_stream_buffer = NULL;
+                ps_ip->u4_num_Bytes = 0;
+            }
+
+            ps_app_ctx->s_batch_decode_op[i].s_ivd_video_decode_op_t.u4_size =
+                            sizeof(ivd_video_decode_op_t);
+        }
+
+        s_ctl_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+        s_ctl_ip.e_sub_cmd = (IVD_CONTROL_API_COMMAND_TYPE_T)IH264D_CMD_CTL_DECODE_BATCH;
+        s_ctl_ip.u4_size = sizeof(ih264d_ctl_decode_batch_ip_t);
+        s_ctl_ip.u4_num_au = u4_num_au;
+        s_ctl_ip.ps_decode_ip = ps_app_ctx->s_batch_decode_ip;
+        s_ctl_ip.ps_decode_op = ps_app_ctx->s_batch_decode_op;
+        s_ctl_op.u4_size = sizeof(ih264d_ctl_decode_batch_op_t);
+
+        ret = ivd_api_function((iv_obj_t *)codec_obj, (void *)&s_ctl_ip,
+                                   (void *)&s_ctl_op);
+
+        ps_app_ctx->u4_batch_num_done = s_ctl_op.u4_num_au_done;
+        ps_app_ctx->u4_batch_next = 0;
+
+        if(0 == s_ctl_op.u4_num_au_done)
+        {
+            memset(ps_video_decode_op, 0, sizeof(ivd_video_decode_op_t));
+            ps_video_decode_op->u4_size = sizeof(ivd_video_decode_op_t);
+            ps_video_decode_op->u4_error_code = s_ctl_op.u4_error_code;
+            return ret;
+        }
+    }
+
+    ps_op = &ps_app_ctx->s_batch_decode_op[ps_app_ctx->u4_batch_next++].s_ivd_video_decode_op_t;
+    *ps_video_decode_op = *ps_op;
+
+    return (0 == ps_op->u4_error_code) ? IV_SUCCESS : IV_FAIL;
+}
+
 void flush_output(iv_obj_t *codec_obj,
                   vid_dec_ctx_t *ps_app_ctx,
                   ivd_out_bufdesc_t *ps_out_buf,
@@ -1887,6 +2151,20 @@ int main(WORD32 argc, CHAR *argv[])
 #endif
     s_app_ctx.u4_share_disp_buf = DEFAULT_SHARE_DISPLAY_BUF;
     s_app_ctx.u4_num_cores = DEFAULT_NUM_CORES;
+    s_app_ctx.u4_compact_mem = 0;
+    s_app_ctx.u4_fused_fmt_conv = 0;
+    s_app_ctx.u4_disp_handles = 0;
+    s_app_ctx.u4_pool_max_wd = 0;
+    s_app_ctx.u4_pool_max_ht = 0;
+    s_app_ctx.u4_seek_frame = 0;
+    s_app_ctx.u4_batch_size = 1;
+    s_app_ctx.u4_batch_num_done = 0;
+    s_app_ctx.u4_batch_next = 0;
+    memset(s_app_ctx.s_batch_out_bufs, 0, sizeof(s_app_ctx.s_batch_out_bufs));
+    s_app_ctx.u4_csc_matrix = IH264D_CSC_DEFAULT;
+    s_app_ctx.u4_csc_full_range = 0;
+    s_app_ctx.u4_scale_shift = 0;
+    s_app_ctx.u4_scale_filter = IH264D_SCALE_FILTER_BOX;
     s_app_ctx.i4_degrade_type = 0;
     s_app_ctx.i4_degrade_pics = 0;
     s_app_ctx.e_arch = ARCH_ARM_A9Q;
@@ -2020,6 +2298,18 @@ int main(WORD32 argc, CHAR *argv[])
         s_app_ctx.u4_share_disp_buf = 0;
         s_app_ctx.e_output_chroma_format = s_app_ctx.get_color_fmt();
     }
+
+    /* Batched decode needs its own output buffer per access unit and several
+     * access units in the bitstream buffer */
+    if(s_app_ctx.u4_share_disp_buf || s_app_ctx.display ||
+       s_app_ctx.u4_disp_handles || s_app_ctx.u4_piclen_flag ||
+       s_app_ctx.u4_seek_frame || (0 == s_app_ctx.u4_batch_size))
+    {
+        s_app_ctx.u4_batch_size = 1;
+    }
+    if(s_app_ctx.u4_batch_size > MAX_BATCH_SIZE)
+        s_app_ctx.u4_batch_size = MAX_BATCH_SIZE;
+
     if(strcmp(s_app_ctx.ac_ip_fname, "\0") == 0)
     {
         printf("\nNo input file given for decoding\n");
@@ -2125,6 +2415,11 @@ int main(WORD32 argc, CHAR *argv[])
             s_create_ip.s_ivd_create_ip_t.pf_aligned_free = ih264a_aligned_free;
             s_create_ip.s_ivd_create_ip_t.pv_mem_ctxt = NULL;
             s_create_ip.s_ivd_create_ip_t.u4_size = sizeof(ih264d_create_ip_t);
+            s_create_ip.u4_enable_compact_mem = s_app_ctx.u4_compact_mem;
+            s_create_ip.u4_enable_fused_fmt_conv = s_app_ctx.u4_fused_fmt_conv;
+            s_create_ip.u4_enable_disp_handles = s_app_ctx.u4_disp_handles;
+            s_create_ip.u4_buf_pool_max_wd = s_app_ctx.u4_pool_max_wd;
+            s_create_ip.u4_buf_pool_max_ht = s_app_ctx.u4_pool_max_ht;
             s_create_op.s_ivd_create_op_t.u4_size = sizeof(ih264d_create_op_t);
 
 
@@ -2203,6 +2498,54 @@ int main(WORD32 argc, CHAR *argv[])
 
     }
 
+    /*************************************************************************/
+    /* set YUV to RGB conversion                                             */
+    /*************************************************************************/
+    {
+        ih264d_ctl_set_color_conv_ip_t s_ctl_set_color_conv_ip;
+        ih264d_ctl_set_color_conv_op_t s_ctl_set_color_conv_op;
+
+        s_ctl_set_color_conv_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+        s_ctl_set_color_conv_ip.e_sub_cmd =
+                        (IVD_CONTROL_API_COMMAND_TYPE_T)IH264D_CMD_CTL_SET_COLOR_CONV;
+        s_ctl_set_color_conv_ip.u4_csc_matrix = s_app_ctx.u4_csc_matrix;
+        s_ctl_set_color_conv_ip.u4_full_range = s_app_ctx.u4_csc_full_range;
+        s_ctl_set_color_conv_ip.u4_size = sizeof(ih264d_ctl_set_color_conv_ip_t);
+        s_ctl_set_color_conv_op.u4_size = sizeof(ih264d_ctl_set_color_conv_op_t);
+
+        ret = ivd_api_function((iv_obj_t*)codec_obj, (void *)&s_ctl_set_color_conv_ip,
+                                   (void *)&s_ctl_set_color_conv_op);
+        if(ret != IV_SUCCESS)
+        {
+            sprintf(ac_error_str, "\nError in setting color conversion");
+            codec_exit(ac_error_str);
+        }
+    }
+
+    /*************************************************************************/
+    /* set output downscaling                                                */
+    /*************************************************************************/
+    {
+        ih264d_ctl_set_output_scale_ip_t s_ctl_set_output_scale_ip;
+        ih264d_ctl_set_output_scale_op_t s_ctl_set_output_scale_op;
+
+        s_ctl_set_output_scale_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+        s_ctl_set_output_scale_ip.e_sub_cmd =
+                        (IVD_CONTROL_API_COMMAND_TYPE_T)IH264D_CMD_CTL_SET_OUTPUT_SCALE;
+        s_ctl_set_output_scale_ip.u4_scale_shift = s_app_ctx.u4_scale_shift;
+        s_ctl_set_output_scale_ip.u4_scale_filter = s_app_ctx.u4_scale_filter;
+        s_ctl_set_output_scale_ip.u4_size = sizeof(ih264d_ctl_set_output_scale_ip_t);
+        s_ctl_set_output_scale_op.u4_size = sizeof(ih264d_ctl_set_output_scale_op_t);
+
+        ret = ivd_api_function((iv_obj_t*)codec_obj, (void *)&s_ctl_set_output_scale_ip,
+                                   (void *)&s_ctl_set_output_scale_op);
+        if(ret != IV_SUCCESS)
+        {
+            sprintf(ac_error_str, "\nError in setting output scale");
+            codec_exit(ac_error_str);
+        }
+    }
+
     /*************************************************************************/
     /* set processsor                                                        */
     /*************************************************************************/
@@ -2392,6 +2735,13 @@ int main(WORD32 argc, CHAR *argv[])
                         s_ctl_op.u4_min_out_buf_size[2] = ADAPTIVE_MAX_WD * ADAPTIVE_MAX_HT >> 2;
                         break;
                     }
+                    case IV_YUV_422P:
+                    {
+                        s_ctl_op.u4_min_out_buf_size[0] = ADAPTIVE_MAX_WD * ADAPTIVE_MAX_HT;
+                        s_ctl_op.u4_min_out_buf_size[1] = ADAPTIVE_MAX_WD * ADAPTIVE_MAX_HT >> 1;
+                        s_ctl_op.u4_min_out_buf_size[2] = ADAPTIVE_MAX_WD * ADAPTIVE_MAX_HT >> 1;
+                        break;
+                    }
                     case IV_YUV_420SP_UV:
                     case IV_YUV_420SP_VU:
                     {
@@ -2623,7 +2973,10 @@ int main(WORD32 argc, CHAR *argv[])
             s_ctl_ip.u4_disp_wd = s_app_ctx.get_stride();
         s_ctl_ip.e_frm_skip_mode = IVD_SKIP_NONE;
 
-        s_ctl_ip.e_frm_out_mode = IVD_DISPLAY_FRAME_OUT;
+        /* Fused conversion needs the decoded picture to be output by the
+         * same call */
+        s_ctl_ip.e_frm_out_mode = s_app_ctx.u4_fused_fmt_conv ?
+                        IVD_DECODE_FRAME_OUT : IVD_DISPLAY_FRAME_OUT;
         s_ctl_ip.e_vid_dec_mode = IVD_DECODE_FRAME;
         s_ctl_ip.e_cmd = IVD_CMD_VIDEO_CTL;
         s_ctl_ip.e_sub_cmd = IVD_CMD_CTL_SETPARAMS;
@@ -2688,6 +3041,24 @@ int main(WORD32 argc, CHAR *argv[])
 
         }
 #endif
+        if(s_app_ctx.u4_seek_frame && (u4_ip_frm_ts == s_app_ctx.u4_seek_frame))
+        {
+            ih264d_ctl_seek_ip_t s_ctl_ip;
+            ih264d_ctl_seek_op_t s_ctl_op;
+
+            s_ctl_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+            s_ctl_ip.e_sub_cmd = (IVD_CONTROL_API_COMMAND_TYPE_T)IH264D_CMD_CTL_SEEK;
+            s_ctl_ip.u4_size = sizeof(ih264d_ctl_seek_ip_t);
+            s_ctl_op.u4_size = sizeof(ih264d_ctl_seek_op_t);
+            ret = ivd_api_function((iv_obj_t *)codec_obj, (void *)&s_ctl_ip,
+                                       (void *)&s_ctl_op);
+
+            if(ret != IV_SUCCESS)
+            {
+                printf("Error in seeking\n");
+            }
+            file_pos = 0;
+        }
         if(u4_num_disp_bufs_with_dec < s_app_ctx.num_disp_buf)
         {
             release_disp_frame(codec_obj, u4_num_disp_bufs_with_dec);
@@ -2848,8 +3219,12 @@ int main(WORD32 argc, CHAR *argv[])
 
             GETTIME(&s_start_timer);
 
-            ret = ivd_api_function((iv_obj_t *)codec_obj, (void *)&s_video_decode_ip,
-                                       (void *)&s_video_decode_op);
+            if(s_app_ctx.u4_batch_size > 1)
+                ret = decode_batched(codec_obj, &s_app_ctx, &s_video_decode_ip,
+                                     &s_video_decode_op, u4_ip_buf_len);
+            else
+                ret = ivd_api_function((iv_obj_t *)codec_obj, (void *)&s_video_decode_ip,
+                                           (void *)&s_video_decode_op);
 
 
             GETTIME(&s_end_timer);
@@ -3079,6 +3454,29 @@ int main(WORD32 argc, CHAR *argv[])
         else
             printf("FPS achieved                    : %-3.2f\n", 1000000/avg);
     }
+
+    {
+        ih264d_ctl_get_mem_footprint_ip_t s_ctl_get_mem_footprint_ip;
+        ih264d_ctl_get_mem_footprint_op_t s_ctl_get_mem_footprint_op;
+
+        s_ctl_get_mem_footprint_ip.e_cmd = IVD_CMD_VIDEO_CTL;
+        s_ctl_get_mem_footprint_ip.e_sub_cmd =
+                        (IVD_CONTROL_API_COMMAND_TYPE_T)IH264D_CMD_CTL_GET_MEM_FOOTPRINT;
+        s_ctl_get_mem_footprint_ip.u4_size =
+                        sizeof(ih264d_ctl_get_mem_footprint_ip_t);
+        s_ctl_get_mem_footprint_op.u4_size =
+                        sizeof(ih264d_ctl_get_mem_footprint_op_t);
+
+        ret = ivd_api_function((iv_obj_t *)codec_obj, (void *)&s_ctl_get_mem_footprint_ip,
+                               (void *)&s_ctl_get_mem_footprint_op);
+        if(IV_SUCCESS == ret)
+        {
+            printf("Static memory (bytes)           : %-10d\n",
+                   s_ctl_get_mem_footprint_op.u4_static_mem_size);
+            printf("Dynamic memory (bytes)          : %-10d\n",
+                   s_ctl_get_mem_footprint_op.u4_dynamic_mem_size);
+        }
+    }
 #endif
     /***********************************************************************/
     /*   Clear the decoder, close all the files, free all the memory       */
@@ -3138,6 +3536,11 @@ int main(WORD32 argc, CHAR *argv[])
         free(s_app_ctx.s_disp_buffers[i].pu1_bufs[0]);
     }
 
+    for(i = 0; i < MAX_BATCH_SIZE; i++)
+    {
+        free(s_app_ctx.s_batch_out_bufs[i].pu1_bufs[0]);
+    }
+
     free(ps_out_buf);
     free(pu1_bs_buf);
 
@@ -235,6 +235,7 @@ typedef struct
     UWORD32 u4_num_cores;
     UWORD32 u4_pre_enc_me;
     UWORD32 u4_pre_enc_ipe;
+    UWORD32 u4_max_ref_cnt;
     CHAR ac_ip_fname[STRLENGTH];
     CHAR ac_op_fname[STRLENGTH];
     CHAR ac_recon_fname[STRLENGTH];
@@ -287,6 +288,8 @@ typedef struct
     UWORD32 u4_idr_interval;
     UWORD32 u4_b_frames;
     UWORD32 u4_num_bframes;
+    UWORD32 u4_adaptive_bframes;
+    UWORD32 u4_scene_cut;
     UWORD32 u4_disable_deblk_level;
     UWORD32 u4_hpel;
     UWORD32 u4_qpel;
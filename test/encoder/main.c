@@ -99,6 +99,7 @@ typedef enum
     SOC,
     NUMCORES,
     PRE_ENC_ME,
+    NUM_REF,
     PRE_ENC_IPE,
     HPEL,
     QPEL,
@@ -108,6 +109,8 @@ typedef enum
     IDR_INTERVAL,
     B_FRMS,
     NUM_B_FRMS,
+    ADAPTIVE_B_FRMS,
+    SCENE_CUT,
     DISABLE_DBLK,
     PROFILE,
     FAST_SAD,
@@ -157,6 +160,8 @@ static const argument_t argument_mapping[] =
                 { "--", "--i_interval", I_INTERVAL,  "Intra frame interval \n" },
                 { "--", "--idr_interval", IDR_INTERVAL,  "IDR frame interval \n" },
                 { "--", "--bframes", NUM_B_FRMS, "Maximum number of consecutive B frames \n" },
+                { "--", "--adaptive_bframes", ADAPTIVE_B_FRMS, "Flag to enable/disable lookahead based B frame placement \n" },
+                { "--", "--scene_cut", SCENE_CUT, "Frame type at scene cuts 0 (no detection), 1 (I) or 2 (IDR) \n" },
                 { "--", "--speed", ENC_SPEED, "Encoder speed preset 0 (slowest) and 100 (fastest)\n" },
                 { "--", "--me_speed", ME_SPEED, "Encoder speed preset 0 (slowest) and 100 (fastest)\n" },
                 { "--", "--fast_sad", FAST_SAD, " Flag for faster sad execution\n" },
@@ -169,6 +174,7 @@ static const argument_t argument_mapping[] =
                 { "--", "--search_range_y", SRCH_RNG_Y,     "Search range for Y \n" },
                 { "--", "--psnr", PSNR, "Enable PSNR computation (Disable while benchmarking performance) \n" },
                 { "--", "--pre_enc_me", PRE_ENC_ME, "Flag to enable/disable Pre Enc Motion Estimation\n" },
+                { "--", "--num_ref", NUM_REF, "Maximum number of reference frames, P frames search up to 4 of them with CONFIG speed\n" },
                 { "--", "--pre_enc_ipe", PRE_ENC_IPE, "Flag to enable/disable Pre Enc Intra prediction Estimation\n" },
                 { "-n", "--num_cores", NUMCORES, "Number of cores to be used\n" },
                 { "--", "--adaptive_intra_refresh", AIR ,"Adaptive Intra Refresh enable/disable\n"},
@@ -178,7 +184,7 @@ static const argument_t argument_mapping[] =
                 { "--", "--max_wd",      MAX_WD,                "Maximum width (Default: 1920) \n" },
                 { "--", "--max_ht",      MAX_HT,                "Maximum height (Default: 1088)\n" },
                 { "--", "--max_level",   MAX_LEVEL,             "Maximum Level (Default: 50)\n" },
-                { "--", "--arch", ARCH, "Set Architecture. Supported values  ARM_NONEON, ARM_A9Q, ARM_A7, ARM_A5, ARM_NEONINTR, X86_GENERIC, X86_SSSE3, X86_SSE4 \n" },
+                { "--", "--arch", ARCH, "Set Architecture. Supported values  ARM_NONEON, ARM_A9Q, ARM_A7, ARM_A5, ARM_NEONINTR, X86_GENERIC, X86_SSSE3, X86_SSE42, X86_AVX2, X86_AVX512 \n" },
                 { "--", "--soc", SOC, "Set SOC. Supported values  GENERIC, HISI_37X \n" },
                 { "--", "--chksum",            CHKSUM_FILE,              "Save Check sum file for recon data\n" },
                 { "--", "--chksum_enable",          CHKSUM_ENABLE,               "Recon MD5 Checksum file\n"},
@@ -686,6 +692,10 @@ void parse_argument(app_ctxt_t *ps_app_ctxt, CHAR *argument, CHAR *value)
               ps_app_ctxt->e_arch = ARCH_X86_SSSE3;
           else if((strcmp(value, "X86_SSE42")) == 0)
               ps_app_ctxt->e_arch = ARCH_X86_SSE42;
+          else if((strcmp(value, "X86_AVX2")) == 0)
+              ps_app_ctxt->e_arch = ARCH_X86_AVX2;
+          else if((strcmp(value, "X86_AVX512")) == 0)
+              ps_app_ctxt->e_arch = ARCH_X86_AVX512;
           else if((strcmp(value, "ARM_A53")) == 0)
               ps_app_ctxt->e_arch = ARCH_ARM_A53;
           else if((strcmp(value, "ARM_A57")) == 0)
@@ -722,6 +732,10 @@ void parse_argument(app_ctxt_t *ps_app_ctxt, CHAR *argument, CHAR *value)
         sscanf(value, "%d", &ps_app_ctxt->u4_pre_enc_me);
         break;
 
+      case NUM_REF:
+        sscanf(value, "%d", &ps_app_ctxt->u4_max_ref_cnt);
+        break;
+
       case PRE_ENC_IPE:
         sscanf(value, "%d", &ps_app_ctxt->u4_pre_enc_ipe);
         break;
@@ -754,6 +768,14 @@ void parse_argument(app_ctxt_t *ps_app_ctxt, CHAR *argument, CHAR *value)
         sscanf(value, "%d", &ps_app_ctxt->u4_num_bframes);
         break;
 
+      case ADAPTIVE_B_FRMS:
+        sscanf(value, "%d", &ps_app_ctxt->u4_adaptive_bframes);
+        break;
+
+      case SCENE_CUT:
+        sscanf(value, "%d", &ps_app_ctxt->u4_scene_cut);
+        break;
+
       case DISABLE_DEBLOCK_LEVEL:
         sscanf(value, "%d", &ps_app_ctxt->u4_disable_deblk_level);
         break;
@@ -930,6 +952,7 @@ void init_default_params(app_ctxt_t *ps_app_ctxt)
     ps_app_ctxt->u4_num_cores            = DEFAULT_NUM_CORES;
     ps_app_ctxt->u4_pre_enc_me           = 0;
     ps_app_ctxt->u4_pre_enc_ipe          = 0;
+    ps_app_ctxt->u4_max_ref_cnt          = DEFAULT_MAX_REF_FRM;
     ps_app_ctxt->ac_ip_fname[0]          = '\0';
     ps_app_ctxt->ac_op_fname[0]          = '\0';
     ps_app_ctxt->ac_recon_fname[0]       = '\0';
@@ -976,6 +999,8 @@ void init_default_params(app_ctxt_t *ps_app_ctxt)
     ps_app_ctxt->u4_srch_rng_y           = DEFAULT_SRCH_RNG_Y;
     ps_app_ctxt->u4_i_interval           = DEFAULT_I_INTERVAL;
     ps_app_ctxt->u4_idr_interval         = DEFAULT_IDR_INTERVAL;
+    ps_app_ctxt->u4_adaptive_bframes     = 0;
+    ps_app_ctxt->u4_scene_cut            = 0;
     ps_app_ctxt->u4_disable_deblk_level  = DEFAULT_DISABLE_DEBLK_LEVEL;
     ps_app_ctxt->u4_hpel                 = DEFAULT_HPEL;
     ps_app_ctxt->u4_qpel                 = DEFAULT_QPEL;
@@ -1310,6 +1335,7 @@ void set_me_params(app_ctxt_t *ps_app_ctxt,
     s_me_params_ip.s_ive_ip.u4_enable_fast_sad = ps_app_ctxt->u4_enable_fast_sad;
     s_me_params_ip.s_ive_ip.u4_enable_alt_ref = ps_app_ctxt->u4_enable_alt_ref;
 
+    s_me_params_ip.s_ive_ip.u4_pre_enc_me  =   ps_app_ctxt->u4_pre_enc_me;
     s_me_params_ip.s_ive_ip.u4_enable_hpel  =   ps_app_ctxt->u4_hpel;
     s_me_params_ip.s_ive_ip.u4_enable_qpel  =   ps_app_ctxt->u4_qpel;
     s_me_params_ip.s_ive_ip.u4_me_speed_preset  =   ps_app_ctxt->u4_me_speed;
@@ -1350,6 +1376,11 @@ void set_gop_params(app_ctxt_t *ps_app_ctxt,
     s_gop_params_ip.s_ive_ip.u4_i_frm_interval = ps_app_ctxt->u4_i_interval;
     s_gop_params_ip.s_ive_ip.u4_idr_frm_interval = ps_app_ctxt->u4_idr_interval;
 
+    s_gop_params_ip.u4_enable_adaptive_bframes = ps_app_ctxt->u4_adaptive_bframes;
+    s_gop_params_ip.e_scene_cut_frm_type = (ps_app_ctxt->u4_scene_cut == 2) ?
+                    IV_IDR_FRAME : (ps_app_ctxt->u4_scene_cut == 1) ?
+                    IV_I_FRAME : IV_NA_FRAME;
+
     s_gop_params_ip.s_ive_ip.u4_timestamp_high = u4_timestamp_high;
     s_gop_params_ip.s_ive_ip.u4_timestamp_low = u4_timestamp_low;
 
@@ -2226,7 +2257,7 @@ int main(int argc, char *argv[])
         s_fill_mem_rec_ip.s_ive_ip.u4_max_ht = s_app_ctxt.u4_max_ht;
         s_fill_mem_rec_ip.s_ive_ip.u4_max_level = s_app_ctxt.u4_max_level;
         s_fill_mem_rec_ip.s_ive_ip.e_color_format = DEFAULT_INP_COLOR_FMT;
-        s_fill_mem_rec_ip.s_ive_ip.u4_max_ref_cnt = DEFAULT_MAX_REF_FRM;
+        s_fill_mem_rec_ip.s_ive_ip.u4_max_ref_cnt = s_app_ctxt.u4_max_ref_cnt;
         s_fill_mem_rec_ip.s_ive_ip.u4_max_reorder_cnt = DEFAULT_MAX_REORDER_FRM;
         s_fill_mem_rec_ip.s_ive_ip.u4_max_srch_rng_x = DEFAULT_MAX_SRCH_RANGE_X;
         s_fill_mem_rec_ip.s_ive_ip.u4_max_srch_rng_y = DEFAULT_MAX_SRCH_RANGE_Y;
@@ -2288,7 +2319,7 @@ int main(int argc, char *argv[])
         s_init_ip.s_ive_ip.ps_mem_rec = s_app_ctxt.ps_mem_rec;
         s_init_ip.s_ive_ip.u4_max_wd = s_app_ctxt.u4_max_wd;
         s_init_ip.s_ive_ip.u4_max_ht = s_app_ctxt.u4_max_ht;
-        s_init_ip.s_ive_ip.u4_max_ref_cnt = DEFAULT_MAX_REF_FRM;
+        s_init_ip.s_ive_ip.u4_max_ref_cnt = s_app_ctxt.u4_max_ref_cnt;
         s_init_ip.s_ive_ip.u4_max_reorder_cnt = DEFAULT_MAX_REORDER_FRM;
         s_init_ip.s_ive_ip.u4_max_level = s_app_ctxt.u4_max_level;
         s_init_ip.s_ive_ip.e_inp_color_fmt = s_app_ctxt.e_inp_color_fmt;
@@ -0,0 +1,12 @@
+LOCAL_PATH := $(call my-dir)
+
+include $(CLEAR_VARS)
+
+LOCAL_MODULE    := avcenc_lookahead_test
+LOCAL_MODULE_TAGS := optional
+
+LOCAL_C_INCLUDES += $(LOCAL_PATH)/../encoder $(LOCAL_PATH)/../common
+LOCAL_SRC_FILES := lookahead/main.c
+LOCAL_STATIC_LIBRARIES := libavcenc
+
+include $(BUILD_EXECUTABLE)
@@ -0,0 +1,452 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2015 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *****************************************************************************
+ * Originally developed and contributed by Ittiam Systems Pvt. Ltd, Bangalore
+*/
+
+/**
+*******************************************************************************
+* @file
+*  main.c
+*
+* @brief
+*  Regression test of the scene cut detection and the adaptive B frame
+*  decision of the encoder lookahead
+*
+* @author
+*  ittiam
+*
+* @par List of Functions:
+*  - hash()
+*  - gen_pic()
+*  - create_codec()
+*  - free_codec()
+*  - run_scene_cut_test()
+*  - run_bframe_test()
+*  - main()
+*
+* @remarks
+*  A noisy textured pan is fed to the lookahead picture by picture. No picture
+*  of the pan may be flagged as a scene cut, and the switch to a second pan of
+*  different content has to be flagged exactly once. A run of B pictures of a
+*  slow pan has to be kept whole, and the run of a fast pan has to be ended
+*  by a P picture early. The test prints PASS or FAIL and returns non zero on
+*  failure.
+*
+*******************************************************************************
+*/
+
+/*****************************************************************************/
+/* File Includes                                                             */
+/*****************************************************************************/
+
+/* System include files */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+
+/* User include files */
+#include "ih264_typedefs.h"
+#include "iv2.h"
+#include "ive2.h"
+#include "ih264e.h"
+#include "ithread.h"
+#include "ih264_defs.h"
+#include "ih264_size_defs.h"
+#include "ime_distortion_metrics.h"
+#include "ime_defs.h"
+#include "ime_structs.h"
+#include "ih264_error.h"
+#include "ih264_structs.h"
+#include "ih264_trans_quant_itrans_iquant.h"
+#include "ih264_inter_pred_filters.h"
+#include "ih264_mem_fns.h"
+#include "ih264_padding.h"
+#include "ih264_intra_pred_filters.h"
+#include "ih264_deblk_edge_filters.h"
+#include "ih264_cabac_tables.h"
+#include "ih264_macros.h"
+#include "ih264e_defs.h"
+#include "ih264e_error.h"
+#include "ih264e_bitstream.h"
+#include "irc_cntrl_param.h"
+#include "irc_frame_info_collector.h"
+#include "ih264e_rate_control.h"
+#include "ih264e_cabac_structs.h"
+#include "ih264e_structs.h"
+#include "ih264e_lookahead.h"
+
+/*****************************************************************************/
+/* Constant Macros                                                           */
+/*****************************************************************************/
+
+#define TEST_WD             352
+#define TEST_HT             288
+
+/** Number of pictures of the test, and the first picture of the second pan */
+#define TEST_NUM_PICS       60
+#define TEST_CUT_PIC        30
+
+/** Length of the run of B pictures of the adaptive B frame test */
+#define TEST_NUM_BFRAMES    3
+
+/** Texture grain of the adaptive B frame test, 8x8 pels */
+#define TEST_BFRAME_GRAIN   3
+
+/** Speed of the fast pan and the B pictures it keeps before the first P */
+#define TEST_FAST_PAN_SPEED     4
+#define TEST_FAST_PAN_NUM_BPICS 1
+
+/*****************************************************************************/
+/* Function Definitions                                                      */
+/*****************************************************************************/
+
+/**
+*******************************************************************************
+*
+* @brief Pseudo random value of a position
+*
+* @param[in] u4_seed
+*  Seed selecting the pattern
+*
+* @param[in] i4_x
+*  Horizontal position
+*
+* @param[in] i4_y
+*  Vertical position
+*
+* @returns  pseudo random value
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static UWORD32 hash(UWORD32 u4_seed, WORD32 i4_x, WORD32 i4_y)
+{
+    UWORD32 u4_val = ((UWORD32)i4_x * 73856093u) ^ ((UWORD32)i4_y * 19349663u)
+                    ^ (u4_seed * 83492791u);
+
+    u4_val ^= u4_val >> 13;
+    u4_val *= 0x5bd1e995u;
+    u4_val ^= u4_val >> 15;
+
+    return u4_val;
+}
+
+/**
+*******************************************************************************
+*
+* @brief Generates the luma of a picture of a pan
+*
+* @par Description:
+*  The scene is a smooth pattern with strong fine grained texture, moving by
+*  3.5 pels horizontally and 1.5 pels vertically per picture times the speed,
+*  with temporal noise on top. The brightness and the pattern differ between
+*  scenes
+*
+* @param[out] pu1_luma
+*  Luma plane of stride TEST_WD
+*
+* @param[in] i4_scene
+*  Scene of the picture
+*
+* @param[in] i4_pic
+*  Position of the picture in the pan
+*
+* @param[in] i4_speed
+*  Speed of the pan
+*
+* @param[in] i4_grain
+*  Size of the grains of the texture, as a power of 2
+*
+* @returns  none
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static void gen_pic(UWORD8 *pu1_luma, WORD32 i4_scene, WORD32 i4_pic,
+                    WORD32 i4_speed, WORD32 i4_grain)
+{
+    WORD32 i4_off_x = (7 * i4_speed * i4_pic) >> 1;
+    WORD32 i4_off_y = (3 * i4_speed * i4_pic) >> 1;
+    double d_freq = 0.11 + 0.05 * i4_scene;
+    WORD32 i4_mean = 96 + 64 * i4_scene;
+    WORD32 x, y;
+
+    for (y = 0; y < TEST_HT; y++)
+    {
+        for (x = 0; x < TEST_WD; x++)
+        {
+            WORD32 i4_pos_x = x + i4_off_x;
+            WORD32 i4_pos_y = y + i4_off_y;
+            WORD32 i4_val;
+
+            i4_val = i4_mean + (WORD32)(32 * sin(i4_pos_x * d_freq)
+                                           * cos(i4_pos_y * d_freq * 0.7));
+            i4_val += (WORD32)(hash(i4_scene + 1, i4_pos_x >> i4_grain,
+                                    i4_pos_y >> i4_grain) % 160) - 80;
+            i4_val += (WORD32)(hash(1000 + i4_pic, x, y) % 48) - 24;
+
+            pu1_luma[y * TEST_WD + x] = CLIP3(0, 255, i4_val);
+        }
+    }
+}
+
+/**
+*******************************************************************************
+*
+* @brief Creates a codec context holding just the lookahead
+*
+* @param[in] e_scene_cut_frm_type
+*  Frame type at scene cuts
+*
+* @param[in] u4_adaptive_bframes
+*  Flag to enable adaptive B frames
+*
+* @returns  Pointer to the codec context
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static codec_t *create_codec(IV_PICTURE_CODING_TYPE_T e_scene_cut_frm_type,
+                             UWORD32 u4_adaptive_bframes)
+{
+    codec_t *ps_codec;
+    UWORD8 *pu1_planes;
+    WORD32 i4_plane_size = (TEST_WD >> 2) * (TEST_HT >> 2);
+    WORD32 i;
+
+    ps_codec = calloc(1, sizeof(codec_t));
+    pu1_planes = malloc(LOOKAHEAD_BUF_CNT * i4_plane_size);
+    if ((NULL == ps_codec) || (NULL == pu1_planes))
+    {
+        printf("Allocation failed\n");
+        exit(-1);
+    }
+
+    ps_codec->s_cfg.i4_wd_mbs = TEST_WD / MB_SIZE;
+    ps_codec->s_cfg.i4_ht_mbs = TEST_HT / MB_SIZE;
+    ps_codec->s_cfg.u4_disp_wd = TEST_WD;
+    ps_codec->s_cfg.u4_disp_ht = TEST_HT;
+    ps_codec->s_cfg.e_inp_color_fmt = IV_YUV_420P;
+    ps_codec->s_cfg.u4_num_bframes = TEST_NUM_BFRAMES;
+    ps_codec->s_cfg.u4_enable_adaptive_bframes = u4_adaptive_bframes;
+    ps_codec->s_cfg.e_scene_cut_frm_type = e_scene_cut_frm_type;
+
+    for (i = 0; i < LOOKAHEAD_BUF_CNT; i++)
+    {
+        ps_codec->s_lookahead.as_pics[i].pu1_luma = pu1_planes + i * i4_plane_size;
+    }
+    ih264e_lookahead_init(ps_codec);
+
+    return ps_codec;
+}
+
+/**
+*******************************************************************************
+*
+* @brief Frees a codec context of create_codec()
+*
+* @param[in] ps_codec
+*  Pointer to the codec context
+*
+* @returns  none
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static void free_codec(codec_t *ps_codec)
+{
+    free(ps_codec->s_lookahead.as_pics[0].pu1_luma);
+    free(ps_codec);
+}
+
+/**
+*******************************************************************************
+*
+* @brief Feeds the pans to the lookahead and checks the scene cut flags
+*
+* @param[in] e_scene_cut_frm_type
+*  Frame type at scene cuts
+*
+* @param[in] u4_adaptive_bframes
+*  Flag to enable adaptive B frames
+*
+* @returns  number of pictures flagged wrongly
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static WORD32 run_scene_cut_test(IV_PICTURE_CODING_TYPE_T e_scene_cut_frm_type,
+                                 UWORD32 u4_adaptive_bframes)
+{
+    codec_t *ps_codec = create_codec(e_scene_cut_frm_type, u4_adaptive_bframes);
+    inp_buf_t s_inp_buf;
+    UWORD8 *pu1_luma;
+    WORD32 i4_num_errors = 0;
+    WORD32 i;
+
+    pu1_luma = malloc(TEST_WD * TEST_HT);
+    if (NULL == pu1_luma)
+    {
+        printf("Allocation failed\n");
+        exit(-1);
+    }
+
+    memset(&s_inp_buf, 0, sizeof(s_inp_buf));
+    s_inp_buf.s_raw_buf.apv_bufs[0] = pu1_luma;
+    s_inp_buf.s_raw_buf.au4_strd[0] = TEST_WD;
+
+    for (i = 0; i < TEST_NUM_PICS; i++)
+    {
+        lookahead_pic_t *ps_pic;
+        WORD32 i4_exp_cut;
+
+        if (i < TEST_CUT_PIC)
+        {
+            gen_pic(pu1_luma, 0, i, 1, 0);
+        }
+        else
+        {
+            gen_pic(pu1_luma, 1, i - TEST_CUT_PIC, 1, 0);
+        }
+
+        ih264e_lookahead_add_pic(ps_codec, &s_inp_buf, i);
+
+        ps_pic = &ps_codec->s_lookahead.as_pics[i % LOOKAHEAD_BUF_CNT];
+        i4_exp_cut = (e_scene_cut_frm_type != IV_NA_FRAME) && (i == TEST_CUT_PIC);
+
+        if (ps_pic->i4_is_scene_cut != i4_exp_cut)
+        {
+            printf("Picture %d: scene cut %d, expected %d\n", i,
+                   ps_pic->i4_is_scene_cut, i4_exp_cut);
+            i4_num_errors++;
+        }
+    }
+
+    free(pu1_luma);
+    free_codec(ps_codec);
+
+    return i4_num_errors;
+}
+
+/**
+*******************************************************************************
+*
+* @brief Feeds a sub gop of a pan to the lookahead and checks the B pictures
+* kept by the adaptive B frame decision
+*
+* @par Description:
+*  The reference before the run, TEST_NUM_BFRAMES B pictures and the P anchor
+*  are added to the lookahead, and the run is decided as in
+*  ih264e_lookahead_decide_pic_types()
+*
+* @param[in] i4_speed
+*  Speed of the pan
+*
+* @param[in] i4_exp_num_bpics
+*  Expected number of B pictures before the first P of the run
+*
+* @returns  1 if the decision is not as expected, else 0
+*
+* @remarks none
+*
+*******************************************************************************
+*/
+static WORD32 run_bframe_test(WORD32 i4_speed, WORD32 i4_exp_num_bpics)
+{
+    codec_t *ps_codec = create_codec(IV_NA_FRAME, 1);
+    lookahead_pic_t *aps_pics[TEST_NUM_BFRAMES + 2];
+    picture_type_e ae_pic_type[TEST_NUM_BFRAMES + 2];
+    inp_buf_t s_inp_buf;
+    UWORD8 *pu1_luma;
+    WORD32 i4_num_bpics;
+    WORD32 i;
+
+    pu1_luma = malloc(TEST_WD * TEST_HT);
+    if (NULL == pu1_luma)
+    {
+        printf("Allocation failed\n");
+        exit(-1);
+    }
+
+    memset(&s_inp_buf, 0, sizeof(s_inp_buf));
+    s_inp_buf.s_raw_buf.apv_bufs[0] = pu1_luma;
+    s_inp_buf.s_raw_buf.au4_strd[0] = TEST_WD;
+
+    for (i = 0; i < TEST_NUM_BFRAMES + 2; i++)
+    {
+        gen_pic(pu1_luma, 0, i, i4_speed, TEST_BFRAME_GRAIN);
+        ih264e_lookahead_add_pic(ps_codec, &s_inp_buf, i);
+
+        aps_pics[i] = &ps_codec->s_lookahead.as_pics[i];
+        ae_pic_type[i] = B_PIC;
+    }
+    ae_pic_type[0] = P_PIC;
+    ae_pic_type[TEST_NUM_BFRAMES + 1] = P_PIC;
+
+    ih264e_lookahead_place_b_pics(&ps_codec->s_lookahead, aps_pics, ae_pic_type,
+                                  TEST_NUM_BFRAMES + 1);
+
+    for (i4_num_bpics = 0; i4_num_bpics < TEST_NUM_BFRAMES; i4_num_bpics++)
+    {
+        if (ae_pic_type[i4_num_bpics + 1] != B_PIC)
+            break;
+    }
+
+    if (i4_num_bpics != i4_exp_num_bpics)
+    {
+        printf("Pan speed %d: %d B pictures before the first P, expected %d\n",
+               i4_speed, i4_num_bpics, i4_exp_num_bpics);
+    }
+
+    free(pu1_luma);
+    free_codec(ps_codec);
+
+    return (i4_num_bpics != i4_exp_num_bpics);
+}
+
+int main(int argc, char *argv[])
+{
+    WORD32 i4_num_errors = 0;
+
+    (void)argc;
+    (void)argv;
+
+    /* no cut in a noisy pan, the change of scene is a cut */
+    i4_num_errors += run_scene_cut_test(IV_I_FRAME, 0);
+    i4_num_errors += run_scene_cut_test(IV_IDR_FRAME, 1);
+    i4_num_errors += run_scene_cut_test(IV_NA_FRAME, 1);
+
+    /*
+     * A pan that the reference predicts across the whole run keeps all the B
+     * pictures. Once the motion across the run leaves the search range, the
+     * run is ended early
+     */
+    i4_num_errors += run_bframe_test(1, TEST_NUM_BFRAMES);
+    i4_num_errors += run_bframe_test(TEST_FAST_PAN_SPEED, TEST_FAST_PAN_NUM_BPICS);
+
+    printf("%s\n", i4_num_errors ? "FAIL" : "PASS");
+
+    return i4_num_errors ? -1 : 0;
+}